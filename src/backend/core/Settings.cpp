@@ -52,5 +52,6 @@ KConfigGroup settingsGeneral() {
 }
 
 SETUP_SETTING(DockPosBehaviour, DockPosBehaviour, int, settingsGeneral(), DockReopenPositionAfterClose, DockPosBehaviour::AboveLastActive)
+SETUP_SETTING(UndoMemoryBudget, int, int, settingsGeneral(), UndoMemoryBudget, 1024)
 
 } // namespace Settings
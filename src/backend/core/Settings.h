@@ -17,6 +17,7 @@ bool sync();
 
 enum class DockPosBehaviour { OriginalPos, AboveLastActive };
 SETUP_SETTING2(DockPosBehaviour, DockPosBehaviour)
+SETUP_SETTING2(UndoMemoryBudget, int) // in MiB
 }
 
 #endif // SETTINGS_H
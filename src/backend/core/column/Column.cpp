@@ -41,6 +41,7 @@
 
 #include <array>
 #include <functional>
+#include <iterator>
 
 /**
  * \class Column
@@ -342,6 +343,123 @@ void Column::setSuppressDataChangedSignal(bool b) {
 	m_suppressDataChangedSignal = b;
 }
 
+namespace {
+template<typename T>
+bool isContainerType(AbstractColumn::ColumnMode);
+template<>
+bool isContainerType<double>(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::Double;
+}
+template<>
+bool isContainerType<int>(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::Integer;
+}
+template<>
+bool isContainerType<qint64>(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::BigInt;
+}
+template<>
+bool isContainerType<QString>(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::Text;
+}
+template<>
+bool isContainerType<QDateTime>(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::DateTime || mode == AbstractColumn::ColumnMode::Month || mode == AbstractColumn::ColumnMode::Day;
+}
+
+double toDouble(double value) {
+	return value;
+}
+double toDouble(int value) {
+	return value;
+}
+double toDouble(qint64 value) {
+	return value;
+}
+double toDouble(const QDateTime& value) {
+	return value.toMSecsSinceEpoch();
+}
+
+/*!
+ * determines the extreme value of the valid and unmasked values in the rows [\c first, \c last] block by block,
+ * \c better(a, b) returns \c true if \c a is more extreme than \c b. NaN values are skipped.
+ */
+template<typename T, typename Compare>
+double extremeValue(const Column* column, const ColumnPrivate* d, int first, int last, double init, Compare better) {
+	double result = init;
+	d->forEachChunk<T>(first, last - first + 1, [&](const T* values, int count, int firstRow) {
+		for (int i = 0; i < count; ++i) {
+			const int row = firstRow + i;
+			if (!column->isValid(row) || column->isMasked(row))
+				continue;
+
+			const double value = toDouble(values[i]);
+			if (better(value, result))
+				result = value;
+		}
+	});
+	return result;
+}
+}
+
+/*!
+ * returns a read-only snapshot of the column data together with the data version at the time of the call.
+ * The snapshot shares the data buffer with the column (implicit sharing), taking it is cheap. Modifications
+ * of the column after the snapshot was taken detach the column from the shared buffer so the snapshot
+ * stays unchanged and can be safely processed in another thread. Access the data in the snapshot only
+ * via the const functions of QVector to not trigger a deep copy.
+ *
+ * The snapshot has to be taken in the thread the column lives in. An empty snapshot is returned
+ * if \c T doesn't match the data type of the column mode.
+ *
+ * \note Writes done directly via data() are only isolated from the snapshot if they go through the non-const
+ * functions of QVector (which detach). Raw pointers into the buffer obtained before the snapshot was taken
+ * (e.g. QVector::data() kept by the import filters) write into the shared buffer. Such writes also don't change
+ * the data version until setChanged() is called.
+ */
+template<typename T>
+Column::Snapshot<T> Column::snapshot() const {
+	Snapshot<T> s;
+	if (!isContainerType<T>(d->columnMode()))
+		return s;
+
+	s.version = d->version();
+	if (d->chunkedStorage() || d->outOfCoreStorage()) {
+		// copy the values instead of returning to the contiguous storage in the memory
+		s.data.reserve(rowCount());
+		d->forEachChunk<T>(0, rowCount(), [&s](const T* values, int count, int) {
+			std::copy(values, values + count, std::back_inserter(s.data));
+		});
+		return s;
+	}
+
+	const auto* data = static_cast<QVector<T>*>(d->data());
+	if (data)
+		s.data = *data;
+	return s;
+}
+
+template Column::Snapshot<double> Column::snapshot<double>() const;
+template Column::Snapshot<int> Column::snapshot<int>() const;
+template Column::Snapshot<qint64> Column::snapshot<qint64>() const;
+template Column::Snapshot<QString> Column::snapshot<QString>() const;
+template Column::Snapshot<QDateTime> Column::snapshot<QDateTime>() const;
+
+/*!
+ * returns the current version of the column data, the version is incremented on every modification.
+ */
+quint64 Column::dataVersion() const {
+	return d->version();
+}
+
+/*!
+ * returns \c true if the data was not modified since the snapshot with the version \p version was taken.
+ * Can be called from any thread.
+ */
+bool Column::isSnapshotCurrent(quint64 version) const {
+	return d->version() == version;
+}
+
 void Column::addUsedInPlots(QVector<CartesianPlot*>& plots) {
 	const Project* project = this->project();
 
@@ -806,6 +924,18 @@ void Column::replaceBigInt(int first, const QVector<qint64>& new_values) {
 		exec(new ColumnReplaceCmd<qint64>(d, first, new_values));
 }
 
+/**
+ * \brief Rearrange the rows, row \c i gets the value of the row \c permutation[i]
+ *
+ * Only the permutation is kept for undo. Rows behind the permuted rows are not changed.
+ */
+void Column::permuteRows(const QVector<int>& permutation) {
+	if (isLoading())
+		d->permuteRows(permutation, false);
+	else
+		exec(new ColumnPermuteRowsCmd(d, permutation));
+}
+
 void Column::addValueLabel(qint64 value, const QString& label) {
 	d->addValueLabel(value, label);
 	project()->setChanged(true);
@@ -817,6 +947,7 @@ void Column::addValueLabel(qint64 value, const QString& label) {
  * \see AbstractColumn::properties
  */
 AbstractColumn::Properties Column::properties() const {
+	d->updateCachedValues();
 	if (!d->available.properties)
 		d->updateProperties();
 
@@ -824,8 +955,28 @@ AbstractColumn::Properties Column::properties() const {
 }
 
 const Column::ColumnStatistics& Column::statistics() const {
+	d->updateCachedValues();
 	if (!d->available.statistics)
 		d->calculateStatistics();
+	else
+		PERFTRACE_COUNTER("column statistics cache hits", 1);
+
+	return d->statistics;
+}
+
+/*!
+ * returns the statistics without the measures based on the order of the values (median, quartiles, percentiles, mode,
+ * mean and median deviations and entropy), these are NaN unless they were determined by statistics() before.
+ * For numeric columns the remaining measures are determined in one pass and extended with the appended rows only,
+ * use this function instead of statistics() if only the size, the means, the variance, the skewness or the kurtosis are needed.
+ */
+const Column::ColumnStatistics& Column::momentStatistics() const {
+	if (!isNumeric())
+		return statistics();
+
+	d->updateCachedValues();
+	if (!d->available.moments)
+		d->calculateMoments();
 
 	return d->statistics;
 }
@@ -840,6 +991,67 @@ void* Column::data() const {
 	return d->data();
 }
 
+/*!
+ * returns \c true if the values are stored in blocks instead of one contiguous vector, see setChunkedStorage().
+ */
+bool Column::chunkedStorage() const {
+	return d->chunkedStorage();
+}
+
+/*!
+ * stores the values in blocks of a fixed size (\c chunked is \c true) instead of one contiguous vector.
+ * With the chunked storage appending rows doesn't move the values already stored and inserting or removing rows
+ * only moves the values in the affected blocks, this is used for the columns of live data sources.
+ * The chunked storage is transparent for the functions accessing single values and for dataChunks().
+ * data() and the functions working on the whole vector return to the contiguous storage.
+ */
+void Column::setChunkedStorage(bool chunked) {
+	d->setChunkedStorage(chunked);
+}
+
+/*!
+ * returns the contiguous parts of the rows [\c first, \c first + \c count) for writing the values directly,
+ * one part with the contiguous storage and one part per affected block with the chunked storage.
+ * The rows have to exist, like for data() the changes have to be propagated with setChanged().
+ */
+QVector<Column::DataChunk> Column::dataChunks(int first, int count) {
+	return d->dataChunks(first, count);
+}
+
+/*!
+ * returns \c true if the values are stored in a memory mapped file instead of the memory, see setOutOfCoreStorage().
+ */
+bool Column::outOfCoreStorage() const {
+	return d->outOfCoreStorage();
+}
+
+/*!
+ * stores the values in a memory mapped file in the cache directory (\c outOfCore is \c true) instead of the memory,
+ * only supported for the numeric column modes (double, integer and big integer). Returns \c false if the values
+ * can't be stored in a file. Like the chunked storage, the out-of-core storage is transparent for the functions
+ * accessing single values and for dataChunks(), the statistics are determined streaming over the file.
+ * data() and the functions working on the whole vector return to the storage in the memory.
+ */
+bool Column::setOutOfCoreStorage(bool outOfCore) {
+	return d->setOutOfCoreStorage(outOfCore);
+}
+
+/*!
+ * returns the store holding the values with the out-of-core storage, \c nullptr otherwise.
+ * The row count of the store is 64-bit, the rows beyond INT_MAX are only accessible via the store.
+ */
+ColumnStore* Column::store() const {
+	return d->store();
+}
+
+/*!
+ * replaces the values with the values in \c store, e.g. after an import wrote the values directly into the store.
+ * The column takes the ownership of the store, the mode of the store has to match the column mode.
+ */
+void Column::setStore(ColumnStore* store) {
+	d->setStore(store);
+}
+
 /*!
  * return \c true if the column has numeric values, \c false otherwise.
  */
@@ -992,6 +1204,17 @@ void Column::setChanged() {
 	invalidateProperties();
 }
 
+/*!
+ * same as setChanged() for the case where only the rows starting at \c firstRow were changed, e.g. new rows were appended.
+ * The cached minimum, maximum and properties of the rows before are kept and updated with the new rows only.
+ */
+void Column::setChanged(int firstRow) {
+	if (!m_suppressDataChangedSignal)
+		Q_EMIT dataChanged(this);
+
+	d->invalidate(firstRow);
+}
+
 bool Column::valueLabelsInitialized() const {
 	return d->valueLabelsInitialized();
 }
@@ -1240,20 +1463,23 @@ void Column::save(QXmlStreamWriter* writer) const {
 	int i;
 	switch (columnMode()) {
 	case ColumnMode::Double: {
-		const char* data = reinterpret_cast<const char*>(static_cast<QVector<double>*>(d->data())->constData());
-		size_t size = d->rowCount() * sizeof(double);
+		const auto values = snapshot<double>().data; // doesn't change the chunked or out-of-core storage
+		const char* data = reinterpret_cast<const char*>(values.constData());
+		size_t size = values.size() * sizeof(double);
 		writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
 		break;
 	}
 	case ColumnMode::Integer: {
-		const char* data = reinterpret_cast<const char*>(static_cast<QVector<int>*>(d->data())->constData());
-		size_t size = d->rowCount() * sizeof(int);
+		const auto values = snapshot<int>().data; // doesn't change the chunked or out-of-core storage
+		const char* data = reinterpret_cast<const char*>(values.constData());
+		size_t size = values.size() * sizeof(int);
 		writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
 		break;
 	}
 	case ColumnMode::BigInt: {
-		const char* data = reinterpret_cast<const char*>(static_cast<QVector<qint64>*>(d->data())->constData());
-		size_t size = d->rowCount() * sizeof(qint64);
+		const auto values = snapshot<qint64>().data; // doesn't change the chunked or out-of-core storage
+		const char* data = reinterpret_cast<const char*>(values.constData());
+		size_t size = values.size() * sizeof(qint64);
 		writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
 		break;
 	}
@@ -1777,6 +2003,7 @@ void Column::handleFormatChange() {
  * for \c count < 0, the minimum of the last \p count elements is returned.
  */
 double Column::minimum(int count) const {
+	d->updateCachedValues();
 	if (count == 0 && d->available.min)
 		return d->statistics.minimum;
 	else {
@@ -1807,6 +2034,8 @@ double Column::minimum(int startIndex, int endIndex) const {
 	if (rowCount() == 0)
 		return min;
 
+	d->updateCachedValues();
+
 	if (startIndex > endIndex && startIndex >= 0 && endIndex >= 0)
 		std::swap(startIndex, endIndex);
 
@@ -1824,63 +2053,24 @@ double Column::minimum(int startIndex, int endIndex) const {
 	if (property == Properties::No || property == Properties::NonMonotonic) {
 		// skipping values is only in Properties::No needed, because
 		// when there are invalid values the property must be Properties::No
+		const auto less = [](double a, double b) {
+			return a < b;
+		};
 		switch (mode) {
-		case ColumnMode::Double: {
-			auto* vec = static_cast<QVector<double>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const double val = vec->at(row);
-				if (std::isnan(val))
-					continue;
-
-				if (val < min)
-					min = val;
-			}
+		case ColumnMode::Double:
+			min = extremeValue<double>(this, d, startIndex, endIndex, min, less);
 			break;
-		}
-		case ColumnMode::Integer: {
-			auto* vec = static_cast<QVector<int>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const int val = vec->at(row);
-
-				if (val < min)
-					min = val;
-			}
+		case ColumnMode::Integer:
+			min = extremeValue<int>(this, d, startIndex, endIndex, min, less);
 			break;
-		}
-		case ColumnMode::BigInt: {
-			auto* vec = static_cast<QVector<qint64>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const qint64 val = vec->at(row);
-
-				if (val < min)
-					min = val;
-			}
+		case ColumnMode::BigInt:
+			min = extremeValue<qint64>(this, d, startIndex, endIndex, min, less);
 			break;
-		}
 		case ColumnMode::Text:
 			break;
-		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
-
-				if (val < min)
-					min = val;
-			}
+		case ColumnMode::DateTime:
+			min = extremeValue<QDateTime>(this, d, startIndex, endIndex, min, less);
 			break;
-		}
 		case ColumnMode::Day:
 		case ColumnMode::Month:
 			break;
@@ -1928,6 +2118,7 @@ double Column::maximum(int count) const {
 #ifdef PERFTRACE_AUTOSCALE
 	PERFTRACE(name() + QLatin1String(Q_FUNC_INFO));
 #endif
+	d->updateCachedValues();
 	if (count == 0 && d->available.max)
 		return d->statistics.maximum;
 	else {
@@ -1954,6 +2145,8 @@ double Column::maximum(int startIndex, int endIndex) const {
 	if (rowCount() == 0)
 		return max;
 
+	d->updateCachedValues();
+
 	if (startIndex > endIndex && startIndex >= 0 && endIndex >= 0)
 		std::swap(startIndex, endIndex);
 
@@ -1969,59 +2162,24 @@ double Column::maximum(int startIndex, int endIndex) const {
 	ColumnMode mode = columnMode();
 	Properties property = properties();
 	if (property == Properties::No || property == Properties::NonMonotonic) {
+		const auto greater = [](double a, double b) {
+			return a > b;
+		};
 		switch (mode) {
-		case ColumnMode::Double: {
-			auto* vec = static_cast<QVector<double>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const double val = vec->at(row);
-				if (std::isnan(val))
-					continue;
-
-				if (val > max)
-					max = val;
-			}
+		case ColumnMode::Double:
+			max = extremeValue<double>(this, d, startIndex, endIndex, max, greater);
 			break;
-		}
-		case ColumnMode::Integer: {
-			auto* vec = static_cast<QVector<int>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const int val = vec->at(row);
-
-				if (val > max)
-					max = val;
-			}
+		case ColumnMode::Integer:
+			max = extremeValue<int>(this, d, startIndex, endIndex, max, greater);
 			break;
-		}
-		case ColumnMode::BigInt: {
-			auto* vec = static_cast<QVector<qint64>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const qint64 val = vec->at(row);
-
-				if (val > max)
-					max = val;
-			}
+		case ColumnMode::BigInt:
+			max = extremeValue<qint64>(this, d, startIndex, endIndex, max, greater);
 			break;
-		}
 		case ColumnMode::Text:
 			break;
-		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
-			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
-
-				if (val > max)
-					max = val;
-			}
+		case ColumnMode::DateTime:
+			max = extremeValue<QDateTime>(this, d, startIndex, endIndex, max, greater);
 			break;
-		}
 		case ColumnMode::Day:
 		case ColumnMode::Month:
 			break;
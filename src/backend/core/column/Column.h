@@ -16,6 +16,7 @@
 
 class AbstractSimpleFilter;
 class CartesianPlot;
+class ColumnStore;
 class ColumnStringIO;
 class QAction;
 class QActionGroup;
@@ -134,8 +135,26 @@ public:
 	void clearFormulas() override;
 
 	const AbstractColumn::ColumnStatistics& statistics() const;
+	const AbstractColumn::ColumnStatistics& momentStatistics() const;
 	void* data() const;
 	void setData(void*);
+
+	// Chunked storage
+	struct DataChunk {
+		void* values; // pointer to the first value, the type of the values corresponds to the column mode like for data()
+		int size{0};
+		int firstRow{0};
+	};
+	bool chunkedStorage() const;
+	void setChunkedStorage(bool);
+	QVector<DataChunk> dataChunks(int first, int count);
+
+	// Out-of-core storage
+	bool outOfCoreStorage() const;
+	bool setOutOfCoreStorage(bool);
+	ColumnStore* store() const;
+	void setStore(ColumnStore*);
+
 	bool hasValues() const;
 	bool valueLabelsInitialized() const;
 	double valueLabelsMinimum() const;
@@ -180,6 +199,8 @@ public:
 	void setBigInts(const QVector<qint64>&);
 	void replaceBigInt(int, const QVector<qint64>&) override;
 
+	void permuteRows(const QVector<int>& permutation);
+
 	double maximum(int count = 0) const override;
 	double maximum(int startIndex, int endIndex) const override;
 	double minimum(int count = 0) const override;
@@ -192,8 +213,20 @@ public:
 	bool indicesMinMax(double v1, double v2, int& start, int& end) const override;
 
 	void setChanged();
+	void setChanged(int firstRow);
 	void setSuppressDataChangedSignal(const bool);
 
+	// Data snapshots
+	template<typename T>
+	struct Snapshot {
+		QVector<T> data; // shares the buffer with the column until the column is modified
+		quint64 version{0};
+	};
+	template<typename T>
+	Snapshot<T> snapshot() const;
+	quint64 dataVersion() const;
+	bool isSnapshotCurrent(quint64 version) const;
+
 	void addUsedInPlots(QVector<CartesianPlot*>&);
 
 	// Value Labels
@@ -0,0 +1,283 @@
+/*
+	File                 : ColumnBlocks.h
+	Project              : LabPlot
+	Description          : Chunked storage of the values of a Column
+	--------------------------------------------------------------------
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef COLUMNBLOCKS_H
+#define COLUMNBLOCKS_H
+
+#include <QVector>
+
+#include <algorithm>
+#include <vector>
+
+/*!
+	\class ColumnBlocks
+	\brief Stores the values of a column with values of type \c T in blocks of at most \c BlockSize values.
+
+	The block index holds the first row of every block and a row is found with a binary search in it.
+	Appending fills the last block and starts new blocks once it's full, the values already stored are never moved.
+	Inserting and removing rows in the middle of the column only moves the values of the affected blocks,
+	a full block is split instead of moving the values behind it.
+
+	The values are accessed either row by row via at() and ref() or block by block via chunks()
+	which is intended for the kernels processing many values at once.
+
+	\ingroup backend
+*/
+template<typename T>
+class ColumnBlocks {
+public:
+	static constexpr int BlockSize = 16384;
+
+	//! contiguous part of the column, \c size values starting at the row \c firstRow
+	template<typename V>
+	struct Chunk {
+		V* values;
+		int size;
+		int firstRow;
+	};
+
+	//! iterates over the contiguous parts of the rows [first, last) of the column
+	template<typename V, typename Blocks>
+	class ChunkIterator {
+	public:
+		ChunkIterator(Blocks& blocks, int block, int row, int last)
+			: m_blocks(blocks)
+			, m_block(block)
+			, m_row(row)
+			, m_last(last) {
+		}
+
+		Chunk<V> operator*() const {
+			const int offset = m_row - m_blocks.m_firstRows.at(m_block);
+			const int size = std::min((int)m_blocks.m_blocks.at(m_block).size() - offset, m_last - m_row);
+			return {m_blocks.m_blocks[m_block].data() + offset, size, m_row};
+		}
+		ChunkIterator& operator++() {
+			++m_block;
+			m_row = (m_block < (int)m_blocks.m_blocks.size()) ? std::min(m_blocks.m_firstRows.at(m_block), m_last) : m_last;
+			return *this;
+		}
+		bool operator!=(const ChunkIterator& other) const {
+			return m_row != other.m_row;
+		}
+
+	private:
+		Blocks& m_blocks;
+		int m_block;
+		int m_row;
+		int m_last;
+	};
+
+	template<typename V, typename Blocks>
+	class ChunkRange {
+	public:
+		ChunkRange(Blocks& blocks, int first, int count)
+			: m_blocks(blocks)
+			, m_first(first)
+			, m_last(first + std::max(count, 0)) {
+		}
+		ChunkIterator<V, Blocks> begin() const {
+			return {m_blocks, (m_first < m_last) ? m_blocks.blockIndex(m_first) : 0, m_first, m_last};
+		}
+		ChunkIterator<V, Blocks> end() const {
+			return {m_blocks, 0, m_last, m_last};
+		}
+
+	private:
+		Blocks& m_blocks;
+		int m_first;
+		int m_last;
+	};
+
+	ColumnBlocks() = default;
+	explicit ColumnBlocks(const QVector<T>& values) {
+		append(values.constData(), values.size());
+	}
+
+	int size() const {
+		return m_size;
+	}
+	int blockCount() const {
+		return (int)m_blocks.size();
+	}
+
+	const T& at(int row) const {
+		const int block = blockIndex(row);
+		return m_blocks.at(block).at(row - m_firstRows.at(block));
+	}
+	T& ref(int row) {
+		const int block = blockIndex(row);
+		return m_blocks[block][row - m_firstRows.at(block)];
+	}
+	//! the value in the row \c row or \c defaultValue if the row doesn't exist, like QVector::value()
+	T value(int row, const T& defaultValue = T()) const {
+		if (row < 0 || row >= m_size)
+			return defaultValue;
+		return at(row);
+	}
+
+	//! the contiguous parts of the rows [first, first + count)
+	ChunkRange<const T, const ColumnBlocks> chunks(int first, int count) const {
+		return {*this, first, count};
+	}
+	ChunkRange<T, ColumnBlocks> chunks(int first, int count) {
+		return {*this, first, count};
+	}
+
+	QVector<T> toVector() const {
+		QVector<T> values;
+		values.reserve(m_size);
+		for (const auto& block : m_blocks)
+			for (const auto& value : block)
+				values << value;
+		return values;
+	}
+
+	void append(const T* values, int count) {
+		while (count > 0) {
+			if (m_blocks.empty() || (int)m_blocks.back().size() == BlockSize)
+				newBlock((int)m_blocks.size(), m_size);
+
+			auto& block = m_blocks.back();
+			const int n = std::min(count, BlockSize - (int)block.size());
+			block.insert(block.end(), values, values + n);
+			m_size += n;
+			values += n;
+			count -= n;
+		}
+	}
+	void append(int count, const T& value) {
+		while (count > 0) {
+			if (m_blocks.empty() || (int)m_blocks.back().size() == BlockSize)
+				newBlock((int)m_blocks.size(), m_size);
+
+			auto& block = m_blocks.back();
+			const int n = std::min(count, BlockSize - (int)block.size());
+			block.insert(block.end(), n, value);
+			m_size += n;
+			count -= n;
+		}
+	}
+
+	//! inserts \c count rows with the value \c value before the row \c before
+	void insert(int before, int count, const T& value) {
+		if (count <= 0)
+			return;
+		if (before >= m_size) {
+			append(count, value);
+			return;
+		}
+
+		const int firstBlock = blockIndex(before);
+		const int offset = before - m_firstRows.at(firstBlock);
+		auto& values = m_blocks[firstBlock];
+		if ((int)values.size() + count <= BlockSize) // enough space left in the block
+			values.insert(values.begin() + offset, count, value);
+		else {
+			// split the block, the values behind the new rows are moved into a new block
+			std::vector<T> tail(std::make_move_iterator(values.begin() + offset), std::make_move_iterator(values.end()));
+			values.erase(values.begin() + offset, values.end());
+
+			int n = std::min(count, BlockSize - offset);
+			values.insert(values.end(), n, value);
+			int block = firstBlock;
+			for (int remaining = count - n; remaining > 0; remaining -= n) {
+				n = std::min(remaining, BlockSize);
+				newBlock(++block, 0).assign(n, value);
+			}
+			m_blocks.insert(m_blocks.begin() + block + 1, std::move(tail));
+			m_firstRows.insert(m_firstRows.begin() + block + 1, 0);
+		}
+
+		m_size += count;
+		updateFirstRows(firstBlock);
+	}
+
+	//! removes the rows [first, first + count)
+	void remove(int first, int count) {
+		count = std::min(count, m_size - first);
+		if (count <= 0)
+			return;
+
+		const int firstBlock = blockIndex(first);
+		int block = firstBlock;
+		int offset = first - m_firstRows.at(block);
+		for (int remaining = count; remaining > 0; offset = 0) {
+			auto& values = m_blocks[block];
+			const int n = std::min(remaining, (int)values.size() - offset);
+			values.erase(values.begin() + offset, values.begin() + offset + n);
+			remaining -= n;
+			if (values.empty()) {
+				m_blocks.erase(m_blocks.begin() + block);
+				m_firstRows.erase(m_firstRows.begin() + block);
+			} else
+				++block;
+		}
+		m_size -= count;
+
+		// merge the blocks around the removed rows if they fit into one block
+		mergeWithNext(firstBlock);
+		mergeWithNext(firstBlock - 1);
+		updateFirstRows(std::max(firstBlock - 1, 0));
+	}
+
+	void resize(int size, const T& value = T()) {
+		if (size > m_size)
+			append(size - m_size, value);
+		else if (size < m_size)
+			remove(size, m_size - size);
+	}
+
+	//! sets the rows [first, first + count) to \c values, the rows have to exist
+	void replace(int first, const T* values, int count) {
+		for (auto chunk : chunks(first, count)) {
+			std::copy(values, values + chunk.size, chunk.values);
+			values += chunk.size;
+		}
+	}
+
+private:
+	//! the block containing the row \c row
+	int blockIndex(int row) const {
+		return (int)(std::upper_bound(m_firstRows.cbegin(), m_firstRows.cend(), row) - m_firstRows.cbegin()) - 1;
+	}
+
+	std::vector<T>& newBlock(int block, int firstRow) {
+		std::vector<T> values;
+		values.reserve(BlockSize);
+		m_blocks.insert(m_blocks.begin() + block, std::move(values));
+		m_firstRows.insert(m_firstRows.begin() + block, firstRow);
+		return m_blocks[block];
+	}
+
+	void mergeWithNext(int block) {
+		if (block < 0 || block + 1 >= (int)m_blocks.size() || m_blocks.at(block).size() + m_blocks.at(block + 1).size() > (size_t)BlockSize)
+			return;
+
+		auto& values = m_blocks[block];
+		auto& next = m_blocks[block + 1];
+		values.insert(values.end(), std::make_move_iterator(next.begin()), std::make_move_iterator(next.end()));
+		m_blocks.erase(m_blocks.begin() + block + 1);
+		m_firstRows.erase(m_firstRows.begin() + block + 1);
+	}
+
+	// determines the first rows of the blocks starting at the block \c block, only the block index is updated
+	void updateFirstRows(int block) {
+		int row = (block > 0) ? m_firstRows.at(block - 1) + (int)m_blocks.at(block - 1).size() : 0;
+		for (int i = block; i < (int)m_blocks.size(); ++i) {
+			m_firstRows[i] = row;
+			row += (int)m_blocks.at(i).size();
+		}
+	}
+
+	std::vector<std::vector<T>> m_blocks;
+	std::vector<int> m_firstRows; //!< block index, first row of every block
+	int m_size{0};
+};
+
+#endif
@@ -24,6 +24,9 @@
 
 #include "functions.h"
 
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
 #include <array>
 #include <unordered_map>
 
@@ -161,6 +164,238 @@ int indexForValueCommon(const T* obj,
 	}
 	return -1;
 }
+
+/*!
+ * rearranges the first permutation.size() values of \c data, the values are moved in parallel chunks for large data.
+ */
+template<typename T>
+void permuteValues(QVector<T>& data, const QVector<int>& permutation, bool inverse) {
+	const int count = permutation.size();
+	QVector<T> result(data.size());
+	T* in = data.data();
+	T* out = result.data();
+	const int* perm = permutation.constData();
+
+	auto move = [in, out, perm, inverse](int first, int last) {
+		if (inverse) {
+			for (int i = first; i < last; ++i)
+				out[perm[i]] = std::move(in[i]);
+		} else {
+			for (int i = first; i < last; ++i)
+				out[i] = std::move(in[perm[i]]);
+		}
+	};
+
+	const int chunkSize = 65536;
+	const int chunks = std::min(QThread::idealThreadCount(), count / chunkSize);
+	if (chunks > 1) {
+		QVector<QPair<int, int>> ranges;
+		for (int i = 0; i < chunks; ++i)
+			ranges << qMakePair(static_cast<int>(static_cast<qint64>(count) * i / chunks), static_cast<int>(static_cast<qint64>(count) * (i + 1) / chunks));
+		QtConcurrent::blockingMap(ranges, [&move](const QPair<int, int>& range) {
+			move(range.first, range.second);
+		});
+	} else
+		move(0, count);
+
+	// rows behind the permuted rows are not changed
+	for (int i = count; i < data.size(); ++i)
+		out[i] = std::move(in[i]);
+
+	data.swap(result);
+}
+
+/*!
+ * converts all values of \c source with \c convert, large columns are converted in parallel chunks.
+ * The loops work on the plain arrays so that the numeric conversions can be vectorized by the compiler.
+ */
+template<typename S, typename T, typename Converter>
+QVector<T>* convertValues(const QVector<S>& source, Converter convert) {
+	const int count = source.size();
+	auto* target = new QVector<T>(count);
+	const S* in = source.constData();
+	T* out = target->data();
+
+	auto run = [in, out, &convert](int first, int last) {
+		for (int i = first; i < last; ++i)
+			out[i] = convert(in[i]);
+	};
+
+	// text is parsed in parallel already for smaller columns since the parsing is much slower than the numeric conversions
+	const int chunkSize = std::is_same<S, QString>::value ? 8192 : 1048576;
+	const int chunks = std::min(QThread::idealThreadCount(), count / chunkSize);
+	if (chunks > 1) {
+		QVector<QPair<int, int>> ranges;
+		for (int i = 0; i < chunks; ++i)
+			ranges << qMakePair(static_cast<int>(static_cast<qint64>(count) * i / chunks), static_cast<int>(static_cast<qint64>(count) * (i + 1) / chunks));
+		QtConcurrent::blockingMap(ranges, [&run](const QPair<int, int>& range) {
+			run(range.first, range.second);
+		});
+	} else
+		run(0, count);
+
+	return target;
+}
+
+/*!
+ * converts the data container \c data of a column from mode \c from to mode \c to in one pass
+ * with the same results as the conversion filters in core/datatypes, except for Double to BigInt:
+ * the rounded values are kept as 64-bit integers, Double2BigIntFilter truncates them to int.
+ * Returns the new data container or \c nullptr if there is no bulk conversion for these modes
+ * and the conversion filters have to be used.
+ */
+void* convertData(const void* data, AbstractColumn::ColumnMode from, AbstractColumn::ColumnMode to) {
+	switch (from) {
+	case AbstractColumn::ColumnMode::Double: {
+		const auto& values = *static_cast<const QVector<double>*>(data);
+		switch (to) {
+		case AbstractColumn::ColumnMode::Integer: // Double2IntegerFilter
+			return convertValues<double, int>(values, [](double value) {
+				return std::isnan(value) ? 0 : (int)round(value);
+			});
+		case AbstractColumn::ColumnMode::BigInt: // Double2BigIntFilter without the truncation to int
+			return convertValues<double, qint64>(values, [](double value) {
+				return std::isnan(value) ? 0 : (qint64)round(value);
+			});
+		case AbstractColumn::ColumnMode::Double:
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		const auto& values = *static_cast<const QVector<int>*>(data);
+		switch (to) {
+		case AbstractColumn::ColumnMode::Double: // Integer2DoubleFilter
+			return convertValues<int, double>(values, [](int value) {
+				return static_cast<double>(value);
+			});
+		case AbstractColumn::ColumnMode::BigInt: // Integer2BigIntFilter
+			return convertValues<int, qint64>(values, [](int value) {
+				return static_cast<qint64>(value);
+			});
+		case AbstractColumn::ColumnMode::Integer:
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const auto& values = *static_cast<const QVector<qint64>*>(data);
+		switch (to) {
+		case AbstractColumn::ColumnMode::Double: // BigInt2DoubleFilter
+			return convertValues<qint64, double>(values, [](qint64 value) {
+				return static_cast<double>(value);
+			});
+		case AbstractColumn::ColumnMode::Integer: // BigInt2IntegerFilter
+			return convertValues<qint64, int>(values, [](qint64 value) {
+				return static_cast<int>(value);
+			});
+		case AbstractColumn::ColumnMode::DateTime: { // BigInt2DateTimeFilter
+			const auto start = QDateTime::fromSecsSinceEpoch(0, Qt::UTC);
+			return convertValues<qint64, QDateTime>(values, [&start](qint64 value) {
+				return start.addMSecs(value);
+			});
+		}
+		case AbstractColumn::ColumnMode::BigInt:
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		// the default locale is used by the conversion filters, see setColumnMode()
+		const auto& values = *static_cast<const QVector<QString>*>(data);
+		const QLocale locale;
+		switch (to) {
+		case AbstractColumn::ColumnMode::Double: // String2DoubleFilter
+			return convertValues<QString, double>(values, [&locale](const QString& value) {
+				bool valid;
+				const double result = locale.toDouble(value, &valid);
+				return valid ? result : NAN;
+			});
+		case AbstractColumn::ColumnMode::Integer: // String2IntegerFilter
+			return convertValues<QString, int>(values, [&locale](const QString& value) {
+				bool valid;
+				const int result = locale.toInt(value, &valid);
+				return valid ? result : 0;
+			});
+		case AbstractColumn::ColumnMode::BigInt: // String2BigIntFilter
+			return convertValues<QString, qint64>(values, [&locale](const QString& value) {
+				bool valid;
+				const qint64 result = locale.toLongLong(value, &valid);
+				return valid ? result : 0;
+			});
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::DateTime: {
+		const auto& values = *static_cast<const QVector<QDateTime>*>(data);
+		switch (to) {
+		case AbstractColumn::ColumnMode::BigInt: // DateTime2BigIntFilter
+			return convertValues<QDateTime, qint64>(values, [](const QDateTime& value) {
+				return value.isValid() ? value.toMSecsSinceEpoch() : 0;
+			});
+		case AbstractColumn::ColumnMode::Double:
+		case AbstractColumn::ColumnMode::Integer:
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	return nullptr;
+}
+
+/*!
+ * copies the \c count numeric values of \c source starting at the row \c sourceStart into the rows starting at \c destStart of \c store,
+ * the values are written to the mapped pages without loading the whole column into the memory.
+ */
+template<typename Source>
+void copyToStore(ColumnStore* store, const Source* source, int sourceStart, int destStart, int count) {
+	if (destStart + count > store->rowCount())
+		store->resize(destStart + count);
+
+	switch (store->mode()) {
+	case AbstractColumn::ColumnMode::Double:
+		for (int i = 0; i < count; ++i)
+			store->setValue<double>(destStart + i, source->valueAt(sourceStart + i));
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		for (int i = 0; i < count; ++i)
+			store->setValue<int>(destStart + i, source->integerAt(sourceStart + i));
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		for (int i = 0; i < count; ++i)
+			store->setValue<qint64>(destStart + i, source->bigIntAt(sourceStart + i));
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
 } // anonymous namespace
 
 void ColumnPrivate::ValueLabels::setMode(AbstractColumn::ColumnMode mode) {
@@ -877,6 +1112,32 @@ ColumnPrivate::~ColumnPrivate() {
 }
 
 void ColumnPrivate::deleteData() {
+	delete m_store;
+	m_store = nullptr;
+
+	if (m_blocks) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			delete static_cast<ColumnBlocks<double>*>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			delete static_cast<ColumnBlocks<int>*>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			delete static_cast<ColumnBlocks<qint64>*>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			delete static_cast<ColumnBlocks<QString>*>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			delete static_cast<ColumnBlocks<QDateTime>*>(m_blocks);
+			break;
+		}
+		m_blocks = nullptr;
+	}
+
 	if (!m_data)
 		return;
 
@@ -919,6 +1180,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 	if (mode == m_columnMode)
 		return;
 
+	setContiguousStorage(); // the values are converted in the vector
 	void* old_data = m_data;
 	// remark: the deletion of the old data will be done in the dtor of a command
 
@@ -928,6 +1190,12 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 
 	Q_EMIT m_owner->modeAboutToChange(m_owner);
 
+	// convert the numeric data and text to numbers in one pass over the data.
+	// The data container is reset here so that no temporary copy of the data is created for the conversion filter below.
+	void* converted = m_data ? convertData(m_data, m_columnMode, mode) : nullptr;
+	if (converted)
+		m_data = nullptr;
+
 	// determine the conversion filter and allocate the new data vector
 	switch (m_columnMode) { // old mode
 	case AbstractColumn::ColumnMode::Double: {
@@ -1288,6 +1556,12 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 		copy(filter->output(0));
 		DEBUG(" DONE")
 		delete temp_col;
+	} else if (converted) {
+		Q_EMIT m_owner->dataAboutToChange(m_owner);
+		m_data = converted;
+		invalidate();
+		if (!m_owner->m_suppressDataChangedSignal)
+			Q_EMIT m_owner->dataChanged(m_owner);
 	}
 
 	if (filter_is_temporary)
@@ -1326,6 +1600,7 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 	m_columnMode = mode;
 	setLabelsMode(mode);
 	m_data = data;
+	invalidate();
 
 	m_inputFilter = in_filter;
 	m_outputFilter = out_filter;
@@ -1382,6 +1657,7 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
 	int num_rows = other->rowCount();
 	// 	DEBUG(Q_FUNC_INFO << ", rows " << num_rows);
 
+	setContiguousStorage(); // the values are copied into the vector
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
 
@@ -1451,6 +1727,16 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 	if (num_rows == 0)
 		return true;
 
+	if (m_store) { // e.g. when undoing the removal of rows, keep the values in the file
+		Q_EMIT m_owner->dataAboutToChange(m_owner);
+		copyToStore(m_store, source, source_start, dest_start, num_rows);
+		invalidate();
+		if (!m_owner->m_suppressDataChangedSignal)
+			Q_EMIT m_owner->dataChanged(m_owner);
+		return true;
+	}
+
+	setContiguousStorage(); // the values are copied into the vector
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
@@ -1512,6 +1798,7 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
 		return false;
 	int num_rows = other->rowCount();
 
+	setContiguousStorage(); // the values are copied into the vector
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
 
@@ -1576,6 +1863,16 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	if (num_rows == 0)
 		return true;
 
+	if (m_store) { // e.g. when undoing the removal of rows, keep the values in the file
+		Q_EMIT m_owner->dataAboutToChange(m_owner);
+		copyToStore(m_store, source, source_start, dest_start, num_rows);
+		invalidate();
+		if (!m_owner->m_suppressDataChangedSignal)
+			Q_EMIT m_owner->dataChanged(m_owner);
+		return true;
+	}
+
+	setContiguousStorage(); // the values are copied into the vector
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
@@ -1631,6 +1928,26 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
  * This returns the size of the column container
  */
 int ColumnPrivate::rowCount() const {
+	if (m_store) // the rows beyond INT_MAX are only accessible via store()
+		return (int)std::min(m_store->rowCount(), qint64(INT_MAX));
+
+	if (m_blocks) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			return static_cast<ColumnBlocks<double>*>(m_blocks)->size();
+		case AbstractColumn::ColumnMode::Integer:
+			return static_cast<ColumnBlocks<int>*>(m_blocks)->size();
+		case AbstractColumn::ColumnMode::BigInt:
+			return static_cast<ColumnBlocks<qint64>*>(m_blocks)->size();
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			return static_cast<ColumnBlocks<QDateTime>*>(m_blocks)->size();
+		case AbstractColumn::ColumnMode::Text:
+			return static_cast<ColumnBlocks<QString>*>(m_blocks)->size();
+		}
+	}
+
 	if (!m_data)
 		return m_rowCount;
 
@@ -1653,46 +1970,38 @@ int ColumnPrivate::rowCount() const {
 }
 
 int ColumnPrivate::rowCount(double min, double max) const {
-	if (!m_data)
+	if (!m_data && !m_blocks && !m_store)
 		return m_rowCount;
 
 	int counter = 0;
-	switch (m_columnMode) {
-	case AbstractColumn::ColumnMode::Double: {
-		const auto* data = static_cast<QVector<double>*>(m_data);
-		for (const auto& d : *data) {
-			if (d >= min && d <= max)
+	const auto count = [&counter, min, max](const auto* values, int size, int) {
+		for (int i = 0; i < size; ++i) {
+			const double value = values[i];
+			if (value >= min && value <= max)
 				counter++;
 		}
+	};
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		forEachChunk<double>(0, rowCount(), count);
 		break;
-	}
-	case AbstractColumn::ColumnMode::Integer: {
-		const auto* data = static_cast<QVector<int>*>(m_data);
-		for (const auto& d : *data) {
-			if (d >= min && d <= max)
-				counter++;
-		}
+	case AbstractColumn::ColumnMode::Integer:
+		forEachChunk<int>(0, rowCount(), count);
 		break;
-	}
-	case AbstractColumn::ColumnMode::BigInt: {
-		const auto* data = static_cast<QVector<qint64>*>(m_data);
-		for (const auto& d : *data) {
-			if (d >= min && d <= max)
-				counter++;
-		}
+	case AbstractColumn::ColumnMode::BigInt:
+		forEachChunk<qint64>(0, rowCount(), count);
 		break;
-	}
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day: {
-		const auto* data = static_cast<QVector<QDateTime>*>(m_data);
-		for (const auto& d : *data) {
-			const auto value = d.toMSecsSinceEpoch();
-			if (value >= min && value <= max)
-				counter++;
-		}
+	case AbstractColumn::ColumnMode::Day:
+		forEachChunk<QDateTime>(0, rowCount(), [&counter, min, max](const QDateTime* values, int size, int) {
+			for (int i = 0; i < size; ++i) {
+				const auto value = values[i].toMSecsSinceEpoch();
+				if (value >= min && value <= max)
+					counter++;
+			}
+		});
 		break;
-	}
 	case AbstractColumn::ColumnMode::Text:
 		break;
 	}
@@ -1737,6 +2046,36 @@ void ColumnPrivate::resizeTo(int new_size) {
 	// 	DEBUG("ColumnPrivate::resizeTo() " << old_size << " -> " << new_size);
 	const int new_rows = new_size - old_size;
 
+	if (m_store) {
+		m_store->resize(new_size);
+		invalidate(std::min(old_size, new_size));
+		return;
+	}
+
+	if (m_blocks) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			static_cast<ColumnBlocks<double>*>(m_blocks)->resize(new_size, NAN);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			static_cast<ColumnBlocks<int>*>(m_blocks)->resize(new_size, 0);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			static_cast<ColumnBlocks<qint64>*>(m_blocks)->resize(new_size, 0);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			static_cast<ColumnBlocks<QString>*>(m_blocks)->resize(new_size);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			static_cast<ColumnBlocks<QDateTime>*>(m_blocks)->resize(new_size);
+			break;
+		}
+		invalidate(std::min(old_size, new_size));
+		return;
+	}
+
 	if (!m_data) {
 		m_rowCount += new_rows;
 		return;
@@ -1748,7 +2087,7 @@ void ColumnPrivate::resizeTo(int new_size) {
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, NAN);
 		else
-			data->remove(old_size - 1 + new_rows, -new_rows);
+			data->remove(new_size, -new_rows);
 		break;
 	}
 	case AbstractColumn::ColumnMode::Integer: {
@@ -1756,7 +2095,7 @@ void ColumnPrivate::resizeTo(int new_size) {
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, 0);
 		else
-			data->remove(old_size - 1 + new_rows, -new_rows);
+			data->remove(new_size, -new_rows);
 		break;
 	}
 	case AbstractColumn::ColumnMode::BigInt: {
@@ -1764,7 +2103,7 @@ void ColumnPrivate::resizeTo(int new_size) {
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, 0);
 		else
-			data->remove(old_size - 1 + new_rows, -new_rows);
+			data->remove(new_size, -new_rows);
 		break;
 	}
 	case AbstractColumn::ColumnMode::Text: {
@@ -1772,7 +2111,7 @@ void ColumnPrivate::resizeTo(int new_size) {
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, QString());
 		else
-			data->remove(old_size - 1 + new_rows, -new_rows);
+			data->remove(new_size, -new_rows);
 		break;
 	}
 	case AbstractColumn::ColumnMode::DateTime:
@@ -1782,12 +2121,12 @@ void ColumnPrivate::resizeTo(int new_size) {
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, QDateTime());
 		else
-			data->remove(old_size - 1 + new_rows, -new_rows);
+			data->remove(new_size, -new_rows);
 		break;
 	}
 	}
 
-	invalidate();
+	invalidate(std::min(old_size, new_size));
 }
 
 /**
@@ -1799,12 +2138,34 @@ void ColumnPrivate::insertRows(int before, int count) {
 
 	m_formulas.insertRows(before, count);
 
-	if (!m_data) {
+	if (!m_data && !m_blocks && !m_store) {
 		m_rowCount += count;
 		return;
 	}
 
-	if (before <= rowCount()) {
+	if (before <= rowCount() && m_store)
+		m_store->insert(before, count);
+	else if (before <= rowCount() && m_blocks) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			static_cast<ColumnBlocks<double>*>(m_blocks)->insert(before, count, NAN);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			static_cast<ColumnBlocks<int>*>(m_blocks)->insert(before, count, 0);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			static_cast<ColumnBlocks<qint64>*>(m_blocks)->insert(before, count, 0);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			static_cast<ColumnBlocks<QDateTime>*>(m_blocks)->insert(before, count, QDateTime());
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			static_cast<ColumnBlocks<QString>*>(m_blocks)->insert(before, count, QString());
+			break;
+		}
+	} else if (before <= rowCount()) {
 		switch (m_columnMode) {
 		case AbstractColumn::ColumnMode::Double:
 			static_cast<QVector<double>*>(m_data)->insert(before, count, NAN);
@@ -1818,17 +2179,15 @@ void ColumnPrivate::insertRows(int before, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->insert(before, QDateTime());
+			static_cast<QVector<QDateTime>*>(m_data)->insert(before, count, QDateTime());
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QString>*>(m_data)->insert(before, QString());
+			static_cast<QVector<QString>*>(m_data)->insert(before, count, QString());
 			break;
 		}
 	}
 
-	invalidate();
+	invalidate(before);
 }
 
 /**
@@ -1845,6 +2204,36 @@ void ColumnPrivate::removeRows(int first, int count) {
 		if (first + count > rowCount())
 			corrected_count = rowCount() - first;
 
+		if (m_store) {
+			m_store->remove(first, corrected_count);
+			invalidate();
+			return;
+		}
+
+		if (m_blocks) {
+			switch (m_columnMode) {
+			case AbstractColumn::ColumnMode::Double:
+				static_cast<ColumnBlocks<double>*>(m_blocks)->remove(first, corrected_count);
+				break;
+			case AbstractColumn::ColumnMode::Integer:
+				static_cast<ColumnBlocks<int>*>(m_blocks)->remove(first, corrected_count);
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				static_cast<ColumnBlocks<qint64>*>(m_blocks)->remove(first, corrected_count);
+				break;
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				static_cast<ColumnBlocks<QDateTime>*>(m_blocks)->remove(first, corrected_count);
+				break;
+			case AbstractColumn::ColumnMode::Text:
+				static_cast<ColumnBlocks<QString>*>(m_blocks)->remove(first, corrected_count);
+				break;
+			}
+			invalidate();
+			return;
+		}
+
 		if (!m_data) {
 			m_rowCount -= corrected_count;
 			return;
@@ -1863,12 +2252,10 @@ void ColumnPrivate::removeRows(int first, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->removeAt(first);
+			static_cast<QVector<QDateTime>*>(m_data)->remove(first, corrected_count);
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QString>*>(m_data)->removeAt(first);
+			static_cast<QVector<QString>*>(m_data)->remove(first, corrected_count);
 			break;
 		}
 	}
@@ -1937,12 +2324,277 @@ void ColumnPrivate::setData(void* data) {
  * \brief Return the data pointer
  */
 void* ColumnPrivate::data() const {
+	// the callers expect the contiguous vector
+	const_cast<ColumnPrivate*>(this)->setContiguousStorage();
 	if (!m_data)
 		const_cast<ColumnPrivate*>(this)->initDataContainer();
 
 	return m_data;
 }
 
+bool ColumnPrivate::chunkedStorage() const {
+	return m_blocks != nullptr;
+}
+
+namespace {
+template<typename T>
+void* toBlocks(void* data) {
+	auto* vector = static_cast<QVector<T>*>(data);
+	auto* blocks = new ColumnBlocks<T>(*vector);
+	delete vector;
+	return blocks;
+}
+
+template<typename T>
+void* toVector(void* data) {
+	auto* blocks = static_cast<ColumnBlocks<T>*>(data);
+	auto* vector = new QVector<T>(blocks->toVector());
+	delete blocks;
+	return vector;
+}
+
+template<typename T>
+QVector<Column::DataChunk> chunksOf(void* data, void* blocks, int first, int count) {
+	QVector<Column::DataChunk> chunks;
+	if (blocks) {
+		for (auto chunk : static_cast<ColumnBlocks<T>*>(blocks)->chunks(first, count))
+			chunks << Column::DataChunk{chunk.values, chunk.size, chunk.firstRow};
+	} else if (count > 0)
+		chunks << Column::DataChunk{static_cast<QVector<T>*>(data)->data() + first, count, first};
+	return chunks;
+}
+
+template<typename T>
+QVector<Column::DataChunk> pagesOf(ColumnStore* store, int first, int count) {
+	QVector<Column::DataChunk> chunks;
+	store->forEachPage<T>(first, count, [&chunks](T* values, int size, qint64 firstRow) {
+		chunks << Column::DataChunk{values, size, (int)firstRow};
+	});
+	return chunks;
+}
+
+template<typename T>
+void* storeToVector(const ColumnStore* store) {
+	auto* vector = new QVector<T>((int)std::min(store->rowCount(), qint64(INT_MAX)));
+	store->read(0, vector->data(), vector->size());
+	return vector;
+}
+}
+
+/*!
+ * switches between the contiguous vector and the blocks, see Column::setChunkedStorage().
+ * The values are not changed.
+ */
+void ColumnPrivate::setChunkedStorage(bool chunked) {
+	if (chunked == chunkedStorage() || m_store) // the values in the store are not moved when appending either
+		return;
+
+	if (chunked) {
+		if (!m_data && !initDataContainer())
+			return; // failed to allocate memory
+
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			m_blocks = toBlocks<double>(m_data);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			m_blocks = toBlocks<int>(m_data);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			m_blocks = toBlocks<qint64>(m_data);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			m_blocks = toBlocks<QString>(m_data);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			m_blocks = toBlocks<QDateTime>(m_data);
+			break;
+		}
+		m_data = nullptr;
+	} else {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			m_data = toVector<double>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			m_data = toVector<int>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			m_data = toVector<qint64>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			m_data = toVector<QString>(m_blocks);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			m_data = toVector<QDateTime>(m_blocks);
+			break;
+		}
+		m_blocks = nullptr;
+	}
+}
+
+/*!
+ * returns the contiguous parts of the rows [\c first, \c first + \c count), see Column::dataChunks().
+ */
+QVector<Column::DataChunk> ColumnPrivate::dataChunks(int first, int count) {
+	if (!m_data && !m_blocks && !m_store && !initDataContainer())
+		return {};
+
+	count = std::min(count, rowCount() - first);
+	if (m_store) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			return pagesOf<double>(m_store, first, count);
+		case AbstractColumn::ColumnMode::Integer:
+			return pagesOf<int>(m_store, first, count);
+		case AbstractColumn::ColumnMode::BigInt:
+			return pagesOf<qint64>(m_store, first, count);
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			return {};
+		}
+	}
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		return chunksOf<double>(m_data, m_blocks, first, count);
+	case AbstractColumn::ColumnMode::Integer:
+		return chunksOf<int>(m_data, m_blocks, first, count);
+	case AbstractColumn::ColumnMode::BigInt:
+		return chunksOf<qint64>(m_data, m_blocks, first, count);
+	case AbstractColumn::ColumnMode::Text:
+		return chunksOf<QString>(m_data, m_blocks, first, count);
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		return chunksOf<QDateTime>(m_data, m_blocks, first, count);
+	}
+
+	return {};
+}
+
+bool ColumnPrivate::outOfCoreStorage() const {
+	return m_store != nullptr;
+}
+
+/*!
+ * switches between the vector in the memory and the memory mapped ColumnStore, see Column::setOutOfCoreStorage().
+ * Returns \c false if the column mode is not supported or the store couldn't be created.
+ */
+bool ColumnPrivate::setOutOfCoreStorage(bool outOfCore) {
+	if (outOfCore == outOfCoreStorage())
+		return true;
+
+	if (!outOfCore) {
+		void* data = nullptr;
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			data = storeToVector<double>(m_store);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			data = storeToVector<int>(m_store);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			data = storeToVector<qint64>(m_store);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+		deleteData();
+		m_data = data;
+		return true;
+	}
+
+	if (!ColumnStore::isSupported(m_columnMode))
+		return false;
+
+	setChunkedStorage(false);
+	auto* store = new ColumnStore(m_columnMode);
+	const int rows = rowCount();
+	if (!store->resize(rows, !m_data)) { // the rows are initialized if the column is not allocated yet
+		delete store;
+		return false;
+	}
+
+	if (m_data) {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double:
+			store->write(0, static_cast<QVector<double>*>(m_data)->constData(), rows);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			store->write(0, static_cast<QVector<int>*>(m_data)->constData(), rows);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			store->write(0, static_cast<QVector<qint64>*>(m_data)->constData(), rows);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+
+	deleteData();
+	m_store = store;
+	return true;
+}
+
+ColumnStore* ColumnPrivate::store() const {
+	return m_store;
+}
+
+/*!
+ * replaces the values of the column with the values in \c store, the column takes the ownership of the store.
+ * The mode of the store has to match the column mode.
+ */
+void ColumnPrivate::setStore(ColumnStore* store) {
+	if (!store)
+		return;
+	if (store->mode() != m_columnMode) {
+		delete store;
+		return;
+	}
+
+	Q_EMIT m_owner->dataAboutToChange(m_owner);
+	deleteData();
+	m_store = store;
+	invalidate();
+	if (!m_owner->m_suppressDataChangedSignal)
+		Q_EMIT m_owner->dataChanged(m_owner);
+}
+
+/*!
+ * replaces the store of a column with the out-of-core storage with \c store without deleting the current store,
+ * used by the undo commands. The caller takes the ownership of the returned store.
+ */
+ColumnStore* ColumnPrivate::replaceStore(ColumnStore* store) {
+	Q_EMIT m_owner->dataAboutToChange(m_owner);
+	auto* oldStore = m_store;
+	m_store = store;
+	invalidate();
+	if (!m_owner->m_suppressDataChangedSignal)
+		Q_EMIT m_owner->dataChanged(m_owner);
+	return oldStore;
+}
+
+/*!
+ * returns to the contiguous vector from the chunked or the out-of-core storage, used by the functions working on the whole vector.
+ */
+void ColumnPrivate::setContiguousStorage() {
+	setOutOfCoreStorage(false);
+	setChunkedStorage(false);
+}
+
 /**
  * \brief Return the input filter (for string -> data type conversion)
  */
@@ -2171,16 +2823,16 @@ struct PayloadColumn : public Payload {
 	}
 
 // Constant functions, which return always the same value independet of the row index
-COLUMN_FUNCTION(Size, statistics().size)
+COLUMN_FUNCTION(Size, momentStatistics().size)
 COLUMN_FUNCTION(Min, minimum())
 COLUMN_FUNCTION(Max, maximum())
-COLUMN_FUNCTION(Mean, statistics().arithmeticMean)
+COLUMN_FUNCTION(Mean, momentStatistics().arithmeticMean)
 COLUMN_FUNCTION(Median, statistics().median)
-COLUMN_FUNCTION(Stdev, statistics().standardDeviation)
-COLUMN_FUNCTION(Var, statistics().variance)
-COLUMN_FUNCTION(Gm, statistics().geometricMean)
-COLUMN_FUNCTION(Hm, statistics().harmonicMean)
-COLUMN_FUNCTION(Chm, statistics().contraharmonicMean)
+COLUMN_FUNCTION(Stdev, momentStatistics().standardDeviation)
+COLUMN_FUNCTION(Var, momentStatistics().variance)
+COLUMN_FUNCTION(Gm, momentStatistics().geometricMean)
+COLUMN_FUNCTION(Hm, momentStatistics().harmonicMean)
+COLUMN_FUNCTION(Chm, momentStatistics().contraharmonicMean)
 COLUMN_FUNCTION(StatisticsMode, statistics().mode)
 COLUMN_FUNCTION(Quartile1, statistics().firstQuartile)
 COLUMN_FUNCTION(Quartile3, statistics().thirdQuartile)
@@ -2195,8 +2847,8 @@ COLUMN_FUNCTION(Trimean, statistics().trimean)
 COLUMN_FUNCTION(Meandev, statistics().meanDeviation)
 COLUMN_FUNCTION(Meandevmedian, statistics().meanDeviationAroundMedian)
 COLUMN_FUNCTION(Mediandev, statistics().medianDeviation)
-COLUMN_FUNCTION(Skew, statistics().skewness)
-COLUMN_FUNCTION(Kurt, statistics().kurtosis)
+COLUMN_FUNCTION(Skew, momentStatistics().skewness)
+COLUMN_FUNCTION(Kurt, momentStatistics().kurtosis)
 COLUMN_FUNCTION(Entropy, statistics().entropy)
 
 double columnQuantile(double p, const char* variable, const std::weak_ptr<Payload> payload) {
@@ -2494,9 +3146,9 @@ void ColumnPrivate::replaceValues(int first, const QVector<QString>& new_values)
  * Use this only when columnMode() is Text
  */
 QString ColumnPrivate::textAt(int row) const {
-	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::Text)
+	if (m_columnMode != AbstractColumn::ColumnMode::Text)
 		return {};
-	return static_cast<QVector<QString>*>(m_data)->value(row);
+	return valueAtPrivate<QString>(row);
 }
 
 /**
@@ -2505,7 +3157,7 @@ QString ColumnPrivate::textAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QDate ColumnPrivate::dateAt(int row) const {
-	if (!m_data
+	if ((!m_data && !m_blocks)
 		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 			&& m_columnMode != AbstractColumn::ColumnMode::Day))
 		return QDate{};
@@ -2518,7 +3170,7 @@ QDate ColumnPrivate::dateAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QTime ColumnPrivate::timeAt(int row) const {
-	if (!m_data
+	if ((!m_data && !m_blocks)
 		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 			&& m_columnMode != AbstractColumn::ColumnMode::Day))
 		return QTime{};
@@ -2531,18 +3183,14 @@ QTime ColumnPrivate::timeAt(int row) const {
  * Use this only when columnMode() is DateTime, Month or Day
  */
 QDateTime ColumnPrivate::dateTimeAt(int row) const {
-	if (!m_data
-		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
-			&& m_columnMode != AbstractColumn::ColumnMode::Day))
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
+		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return QDateTime();
-	return static_cast<QVector<QDateTime>*>(m_data)->value(row);
+	return valueAtPrivate<QDateTime>(row);
 }
 
 double ColumnPrivate::doubleAt(int index) const {
-	if (!m_data)
-		return NAN;
-
-	return static_cast<QVector<double>*>(m_data)->value(index, NAN);
+	return valueAtPrivate<double>(index, NAN);
 }
 
 /**
@@ -2551,18 +3199,18 @@ double ColumnPrivate::doubleAt(int index) const {
  * For cases where the integer value is needed without any implicit conversions, \sa integerAt() has to be used.
  */
 double ColumnPrivate::valueAt(int index) const {
-	if (!m_data)
+	if (!m_data && !m_blocks && !m_store)
 		return NAN;
 
 	switch (m_columnMode) {
 	case AbstractColumn::ColumnMode::Double:
-		return static_cast<QVector<double>*>(m_data)->value(index, NAN);
+		return valueAtPrivate<double>(index, NAN);
 	case AbstractColumn::ColumnMode::Integer:
-		return static_cast<QVector<int>*>(m_data)->value(index, 0);
+		return valueAtPrivate<int>(index, 0);
 	case AbstractColumn::ColumnMode::BigInt:
-		return static_cast<QVector<qint64>*>(m_data)->value(index, 0);
+		return valueAtPrivate<qint64>(index, 0);
 	case AbstractColumn::ColumnMode::DateTime:
-		return static_cast<QVector<QDateTime>*>(m_data)->value(index).toMSecsSinceEpoch();
+		return valueAtPrivate<QDateTime>(index).toMSecsSinceEpoch();
 	case AbstractColumn::ColumnMode::Month: // Fall through
 	case AbstractColumn::ColumnMode::Day: // Fall through
 	case AbstractColumn::ColumnMode::Text: // Fall through
@@ -2575,22 +3223,90 @@ double ColumnPrivate::valueAt(int index) const {
  * \brief Return the int value in row 'row'
  */
 int ColumnPrivate::integerAt(int row) const {
-	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::Integer)
+	if (m_columnMode != AbstractColumn::ColumnMode::Integer)
 		return 0;
-	return static_cast<QVector<int>*>(m_data)->value(row, 0);
+	return valueAtPrivate<int>(row, 0);
 }
 
 /**
  * \brief Return the bigint value in row 'row'
  */
 qint64 ColumnPrivate::bigIntAt(int row) const {
-	if (!m_data || m_columnMode != AbstractColumn::ColumnMode::BigInt)
+	if (m_columnMode != AbstractColumn::ColumnMode::BigInt)
 		return 0;
-	return static_cast<QVector<qint64>*>(m_data)->value(row, 0);
+	return valueAtPrivate<qint64>(row, 0);
 }
 
 void ColumnPrivate::invalidate() {
 	available.setUnavailable();
+	++m_version;
+}
+
+/*!
+ * invalidates the cached values after the rows starting at \c firstRow were changed, the rows before are unchanged.
+ * This is the case when new rows were appended, e.g. by a live data source. The cached minimum, maximum, properties and moments
+ * of the rows before \c firstRow are kept and only the new rows are taken into account in updateCachedValues().
+ */
+void ColumnPrivate::invalidate(int firstRow) {
+	if (firstRow <= 0 || firstRow < m_cachedRowCount) {
+		invalidate();
+		return;
+	}
+
+	// the measures based on the order of the values (median, mode, etc.) need all values and are calculated again on the next request
+	available.statistics = false;
+	available.hasValues = false;
+	available.dictionary = false;
+	++m_version;
+}
+
+/*!
+ * updates the cached minimum, maximum, properties and moments with the rows appended since they were determined.
+ * Has to be called before the cached values are used.
+ */
+void ColumnPrivate::updateCachedValues() {
+	const int rows = rowCount();
+	const int firstRow = m_cachedRowCount;
+	m_cachedRowCount = rows;
+	if (firstRow == rows || !(available.min || available.max || available.properties || available.moments))
+		return;
+
+	if (firstRow == 0 || firstRow > rows) {
+		// rows were removed or there were no rows before, determine the values for all rows again
+		available.min = false;
+		available.max = false;
+		available.properties = false;
+		available.moments = false;
+		return;
+	}
+
+	if (available.moments) {
+		// extend the count, the sums and the moments with the new values, the measures based on the order
+		// of the values (median, quantiles, mode, etc.) are determined again in calculateStatistics() on request
+		addRunningStatistics(firstRow, rows - firstRow);
+		const double minimum = statistics.minimum;
+		const double maximum = statistics.maximum;
+		statistics = AbstractColumn::ColumnStatistics();
+		m_runningStatistics.fill(statistics);
+		statistics.minimum = minimum;
+		statistics.maximum = maximum;
+	}
+
+	// the properties are updated first, they're used when determining the minimum and maximum of the new rows
+	if (available.properties)
+		updateProperties(firstRow);
+	if (available.min)
+		statistics.minimum = std::min(statistics.minimum, m_owner->minimum(firstRow, rows - 1));
+	if (available.max)
+		statistics.maximum = std::max(statistics.maximum, m_owner->maximum(firstRow, rows - 1));
+}
+
+/*!
+ * returns the current version of the data. The version is incremented on every modification
+ * and can be used to check whether a snapshot of the data is still up to date.
+ */
+quint64 ColumnPrivate::version() const {
+	return m_version;
 }
 
 /**
@@ -2644,22 +3360,24 @@ const QMap<QString, int>& ColumnPrivate::frequencies() const {
 void ColumnPrivate::initDictionary() {
 	m_dictionary.clear();
 	m_dictionaryFrequencies.clear();
-	if (!m_data || columnMode() != AbstractColumn::ColumnMode::Text)
+	if ((!m_data && !m_blocks) || columnMode() != AbstractColumn::ColumnMode::Text)
 		return;
 
-	auto data = static_cast<QVector<QString>*>(m_data);
-	for (auto& value : *data) {
-		if (value.isEmpty())
-			continue;
+	forEachChunk<QString>(0, rowCount(), [this](const QString* values, int count, int) {
+		for (int i = 0; i < count; ++i) {
+			const auto& value = values[i];
+			if (value.isEmpty())
+				continue;
 
-		if (!m_dictionary.contains(value))
-			m_dictionary << value;
+			if (!m_dictionary.contains(value))
+				m_dictionary << value;
 
-		if (m_dictionaryFrequencies.constFind(value) == m_dictionaryFrequencies.constEnd())
-			m_dictionaryFrequencies[value] = 1;
-		else
-			m_dictionaryFrequencies[value]++;
-	}
+			if (m_dictionaryFrequencies.constFind(value) == m_dictionaryFrequencies.constEnd())
+				m_dictionaryFrequencies[value] = 1;
+			else
+				m_dictionaryFrequencies[value]++;
+		}
+	});
 
 	available.dictionary = true;
 }
@@ -2674,11 +3392,8 @@ void ColumnPrivate::setDateAt(int row, QDate new_value) {
 		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	if (!m_data)
-		initDataContainer();
-
-	if (!m_data) // failed to allocate memory
-		return;
+	if (!m_data && !m_blocks && !initDataContainer())
+		return; // failed to allocate memory
 
 	setDateTimeAt(row, QDateTime(new_value, timeAt(row)));
 }
@@ -2693,11 +3408,8 @@ void ColumnPrivate::setTimeAt(int row, QTime new_value) {
 		&& m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	if (!m_data)
-		initDataContainer();
-
-	if (!m_data) // failed to allocate memory
-		return;
+	if (!m_data && !m_blocks && !initDataContainer())
+		return; // failed to allocate memory
 
 	setDateTimeAt(row, QDateTime(dateAt(row), new_value));
 }
@@ -2753,28 +3465,7 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 	if (m_columnMode != AbstractColumn::ColumnMode::Double)
 		return;
 
-	if (!m_data) {
-		const bool resize = (first >= 0);
-		if (!initDataContainer(resize))
-			return; // failed to allocate memory
-	}
-
-	invalidate();
-
-	Q_EMIT m_owner->dataAboutToChange(m_owner);
-	if (first < 0)
-		*static_cast<QVector<double>*>(m_data) = new_values;
-	else {
-		const int num_rows = new_values.size();
-		resizeTo(first + num_rows);
-
-		double* ptr = static_cast<QVector<double>*>(m_data)->data();
-		for (int i = 0; i < num_rows; ++i)
-			ptr[first + i] = new_values.at(i);
-	}
-
-	if (!m_owner->m_suppressDataChangedSignal)
-		Q_EMIT m_owner->dataChanged(m_owner);
+	replaceValuePrivate<double>(first, new_values);
 }
 
 void ColumnPrivate::addValueLabel(const QString& value, const QString& label) {
@@ -2849,12 +3540,58 @@ void ColumnPrivate::replaceBigInt(int first, const QVector<qint64>& new_values)
 	replaceValuePrivate<qint64>(first, new_values);
 }
 
+/*!
+ * rearranges the first permutation.size() rows so that row \c i contains the value of the row \c permutation[i].
+ * With \c inverse the value of row \c i is moved to the row \c permutation[i] instead, which undoes the permutation.
+ * The column is extended if it has less rows than the permutation and resized to \c rowCount afterwards if \c rowCount is not negative.
+ */
+void ColumnPrivate::permuteRows(const QVector<int>& permutation, bool inverse, int rowCount) {
+	setContiguousStorage(); // the values are permuted in the vector
+	if (!m_data)
+		return;
+
+	invalidate();
+
+	Q_EMIT m_owner->dataAboutToChange(m_owner);
+
+	if (this->rowCount() < permutation.size())
+		resizeTo(permutation.size());
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		permuteValues(*static_cast<QVector<double>*>(m_data), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		permuteValues(*static_cast<QVector<int>*>(m_data), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		permuteValues(*static_cast<QVector<qint64>*>(m_data), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		permuteValues(*static_cast<QVector<QString>*>(m_data), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		permuteValues(*static_cast<QVector<QDateTime>*>(m_data), permutation, inverse);
+		break;
+	}
+
+	if (rowCount >= 0)
+		resizeTo(rowCount);
+
+	if (!m_owner->m_suppressDataChangedSignal)
+		Q_EMIT m_owner->dataChanged(m_owner);
+}
+
 /*!
  * Updates the properties. Will be called, when data in the column changed.
  * The properties will be used to speed up some algorithms.
  * See where variable properties will be used.
+ * For \c firstRow > 1 the current properties are valid for the rows before \c firstRow
+ * and only the rows starting at \c firstRow are checked.
  */
-void ColumnPrivate::updateProperties() {
+void ColumnPrivate::updateProperties(int firstRow) {
 	// DEBUG(Q_FUNC_INFO);
 
 	// TODO: for double Properties::Constant will never be used. Use an epsilon (difference smaller than epsilon is zero)
@@ -2865,34 +3602,58 @@ void ColumnPrivate::updateProperties() {
 		return;
 	}
 
+	int monotonic_decreasing = -1;
+	int monotonic_increasing = -1;
+
+	// continue with the properties of the rows before firstRow
+	if (firstRow > 1) {
+		switch (properties) {
+		case AbstractColumn::Properties::No:
+		case AbstractColumn::Properties::NonMonotonic:
+			// new rows don't change this
+			available.properties = true;
+			return;
+		case AbstractColumn::Properties::Constant:
+			monotonic_decreasing = 1;
+			monotonic_increasing = 1;
+			break;
+		case AbstractColumn::Properties::MonotonicIncreasing:
+			monotonic_decreasing = 0;
+			monotonic_increasing = 1;
+			break;
+		case AbstractColumn::Properties::MonotonicDecreasing:
+			monotonic_decreasing = 1;
+			monotonic_increasing = 0;
+			break;
+		}
+	} else
+		firstRow = 1;
+
 	double prevValue = NAN;
 	int prevValueInt = 0;
 	qint64 prevValueBigInt = 0;
 	qint64 prevValueDatetime = 0;
 
 	if (m_columnMode == AbstractColumn::ColumnMode::Integer)
-		prevValueInt = integerAt(0);
+		prevValueInt = integerAt(firstRow - 1);
 	else if (m_columnMode == AbstractColumn::ColumnMode::BigInt)
-		prevValueBigInt = bigIntAt(0);
+		prevValueBigInt = bigIntAt(firstRow - 1);
 	else if (m_columnMode == AbstractColumn::ColumnMode::Double)
-		prevValue = valueAt(0);
+		prevValue = valueAt(firstRow - 1);
 	else if (m_columnMode == AbstractColumn::ColumnMode::DateTime || m_columnMode == AbstractColumn::ColumnMode::Month
 			 || m_columnMode == AbstractColumn::ColumnMode::Day)
-		prevValueDatetime = dateTimeAt(0).toMSecsSinceEpoch();
+		prevValueDatetime = dateTimeAt(firstRow - 1).toMSecsSinceEpoch();
 	else {
 		properties = AbstractColumn::Properties::No;
 		available.properties = true;
 		return;
 	}
 
-	int monotonic_decreasing = -1;
-	int monotonic_increasing = -1;
-
 	double value;
 	int valueInt;
 	qint64 valueBigInt;
 	qint64 valueDateTime;
-	for (int row = 1; row < rows; row++) {
+	for (int row = firstRow; row < rows; row++) {
 		if (!m_owner->isValid(row) || m_owner->isMasked(row)) {
 			// if there is one invalid or masked value, the property is No, because
 			// otherwise it's difficult to find the correct index in indexForValue().
@@ -3048,26 +3809,31 @@ void ColumnPrivate::replaceFormulas(const IntervalAttribute<QString>& formulas)
 
 void ColumnPrivate::calculateStatistics() {
 	PERFTRACE(QStringLiteral("calculate column statistics"));
-	statistics = AbstractColumn::ColumnStatistics();
-
 	if (m_owner->columnMode() == AbstractColumn::ColumnMode::Text) {
+		statistics = AbstractColumn::ColumnStatistics();
 		calculateTextStatistics();
 		return;
 	}
 
 	if (!m_owner->isNumeric()) {
+		statistics = AbstractColumn::ColumnStatistics();
 		calculateDateTimeStatistics();
 		return;
 	}
 
-	// ######  location measures  #######
-	int rowValuesSize = rowCount();
-	double columnSum = 0.0;
-	double columnProduct = 1.0;
-	double columnSumNeg = 0.0;
-	double columnSumSquare = 0.0;
-	statistics.minimum = INFINITY;
-	statistics.maximum = -INFINITY;
+	// the measures determined in one pass are only calculated again if rows were changed, not if rows were appended
+	if (!available.moments)
+		calculateMoments();
+
+	if (m_store) {
+		// the measures based on the sorted values (median, quartiles, mode, etc.) would need all values in the memory
+		// and are not determined for the out-of-core storage
+		available.statistics = true;
+		return;
+	}
+
+	// ######  measures based on the order and the frequencies of the values  #######
+	const int rowValuesSize = rowCount();
 	std::unordered_map<double, int> frequencyOfValues;
 	QVector<double> rowData;
 	rowData.reserve(rowValuesSize);
@@ -3077,14 +3843,6 @@ void ColumnPrivate::calculateStatistics() {
 		if (std::isnan(val) || m_owner->isMasked(row))
 			continue;
 
-		if (val < statistics.minimum)
-			statistics.minimum = val;
-		if (val > statistics.maximum)
-			statistics.maximum = val;
-		columnSum += val;
-		columnSumNeg += (1.0 / val); // will be Inf when val == 0
-		columnSumSquare += val * val;
-		columnProduct *= val;
 		if (frequencyOfValues.find(val) != frequencyOfValues.end())
 			frequencyOfValues.operator[](val)++;
 		else
@@ -3096,37 +3854,12 @@ void ColumnPrivate::calculateStatistics() {
 
 	if (notNanCount == 0) {
 		available.statistics = true;
-		available.min = true;
-		available.max = true;
 		return;
 	}
 
 	if (rowData.size() < rowValuesSize)
 		rowData.squeeze();
 
-	statistics.size = notNanCount;
-	statistics.arithmeticMean = columnSum / notNanCount;
-
-	// geometric mean
-	if (statistics.minimum <= -100.) // invalid
-		statistics.geometricMean = NAN;
-	else if (statistics.minimum < 0) { // interpret as percentage (/100) and add 1
-		columnProduct = 1.; // recalculate
-		for (auto val : rowData)
-			columnProduct *= val / 100. + 1.;
-		// n-th root and convert back to percentage changes
-		statistics.geometricMean = 100. * (std::pow(columnProduct, 1.0 / notNanCount) - 1.);
-	} else if (statistics.minimum == 0) { // replace zero values with 1
-		columnProduct = 1.; // recalculate
-		for (auto val : rowData)
-			columnProduct *= (val == 0.) ? 1. : val;
-		statistics.geometricMean = std::pow(columnProduct, 1.0 / notNanCount);
-	} else
-		statistics.geometricMean = std::pow(columnProduct, 1.0 / notNanCount);
-
-	statistics.harmonicMean = notNanCount / columnSumNeg;
-	statistics.contraharmonicMean = columnSumSquare / columnSum;
-
 	// calculate the mode, the most frequent value in the data set
 	int maxFreq = 0;
 	double mode = NAN;
@@ -3164,48 +3897,29 @@ void ColumnPrivate::calculateStatistics() {
 	statistics.iqr = statistics.thirdQuartile - statistics.firstQuartile;
 	statistics.trimean = (statistics.firstQuartile + 2. * statistics.median + statistics.thirdQuartile) / 4.;
 
-	// ######  dispersion and shape measures  #######
-	statistics.variance = 0.;
+	// ######  dispersion measures around the mean and the median  #######
 	statistics.meanDeviation = 0.;
 	statistics.meanDeviationAroundMedian = 0.;
-	double centralMoment_r3 = 0.;
-	double centralMoment_r4 = 0.;
 	QVector<double> absoluteMedianList;
 	absoluteMedianList.reserve(notNanCount);
 	absoluteMedianList.resize(notNanCount);
 
 	for (size_t row = 0; row < notNanCount; ++row) {
 		double val = rowData.value(row);
-		statistics.variance += gsl_pow_2(val - statistics.arithmeticMean);
 		statistics.meanDeviation += std::abs(val - statistics.arithmeticMean);
 
 		absoluteMedianList[row] = std::abs(val - statistics.median);
 		statistics.meanDeviationAroundMedian += absoluteMedianList[row];
-
-		centralMoment_r3 += gsl_pow_3(val - statistics.arithmeticMean);
-		centralMoment_r4 += gsl_pow_4(val - statistics.arithmeticMean);
 	}
 
-	double centralMoment_r2 = statistics.variance / notNanCount;
-
 	// normalize
-	statistics.variance = (notNanCount != 1) ? statistics.variance / (notNanCount - 1) : NAN;
 	statistics.meanDeviationAroundMedian = statistics.meanDeviationAroundMedian / notNanCount;
 	statistics.meanDeviation = statistics.meanDeviation / notNanCount;
 
-	// standard deviation
-	statistics.standardDeviation = std::sqrt(statistics.variance);
-
 	//"median absolute deviation" - the median of the absolute deviations from the data's median.
 	std::sort(absoluteMedianList.begin(), absoluteMedianList.end());
 	statistics.medianDeviation = gsl_stats_quantile_from_sorted_data(absoluteMedianList.data(), 1, notNanCount, 0.50);
 
-	// skewness and kurtosis
-	centralMoment_r3 /= notNanCount;
-	centralMoment_r4 /= notNanCount;
-	statistics.skewness = centralMoment_r3 / gsl_pow_3(std::sqrt(centralMoment_r2));
-	statistics.kurtosis = centralMoment_r4 / gsl_pow_2(centralMoment_r2);
-
 	// entropy
 	double entropy = 0.;
 	for (const auto& v : frequencyOfValues) {
@@ -3216,10 +3930,59 @@ void ColumnPrivate::calculateStatistics() {
 	statistics.entropy = -entropy;
 
 	available.statistics = true;
+}
+
+/*!
+ * determines the measures of the numeric values that don't need the order of the values (size, minimum, maximum, means,
+ * variance, standard deviation, skewness and kurtosis) in one pass, the other measures in \c statistics are reset.
+ * The measures are extended with appended rows in updateCachedValues() afterwards.
+ */
+void ColumnPrivate::calculateMoments() {
+	PERFTRACE(QStringLiteral("calculate column moments"));
+	m_runningStatistics = RunningStatistics();
+	if (m_store && m_owner->maskedIntervals().isEmpty())
+		m_runningStatistics = m_store->statistics(); // all rows, also the rows beyond INT_MAX
+	else
+		addRunningStatistics(0, rowCount());
+
+	statistics = AbstractColumn::ColumnStatistics();
+	m_runningStatistics.fill(statistics);
+	available.moments = true;
 	available.min = true;
 	available.max = true;
 }
 
+/*!
+ * adds the numeric values of the \c count rows starting at \c first to the running statistics, masked rows are skipped.
+ */
+void ColumnPrivate::addRunningStatistics(int first, int count) {
+	const bool masked = !m_owner->maskedIntervals().isEmpty();
+	const auto add = [this, masked](const auto* values, int size, int firstRow) {
+		for (int i = 0; i < size; ++i) {
+			if (masked && m_owner->isMasked(firstRow + i))
+				continue;
+			m_runningStatistics.add(values[i]);
+		}
+	};
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		forEachChunk<double>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		forEachChunk<int>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		forEachChunk<qint64>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
+
 void ColumnPrivate::calculateTextStatistics() {
 	if (!available.dictionary)
 		initDictionary();
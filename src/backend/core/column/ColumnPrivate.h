@@ -14,12 +14,18 @@
 
 #include "backend/core/AbstractColumn.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnBlocks.h"
+#include "backend/core/column/ColumnStore.h"
+#include "backend/core/column/RunningStatistics.h"
 #include "backend/lib/IntervalAttribute.h"
 
+#include <QAtomicInteger>
 #include <QMap>
 
 class Column;
 class ColumnSetGlobalFormulaCmd;
+template<typename T>
+class ColumnValuesDelta;
 
 class ColumnPrivate : public QObject {
 	Q_OBJECT
@@ -60,6 +66,30 @@ public:
 	void setData(void*);
 	void* data() const;
 	void deleteData();
+	bool chunkedStorage() const;
+	void setChunkedStorage(bool);
+	QVector<Column::DataChunk> dataChunks(int first, int count);
+	bool outOfCoreStorage() const;
+	bool setOutOfCoreStorage(bool);
+	ColumnStore* store() const;
+	void setStore(ColumnStore*);
+	ColumnStore* replaceStore(ColumnStore*);
+
+	// calls \c function(const T* values, int count, int firstRow) for the contiguous parts of the rows [first, first + count).
+	// Never call this function with a type that doesn't match the column mode.
+	template<typename T, typename Function>
+	void forEachChunk(int first, int count, Function function) const {
+		if (!m_data && !m_blocks && !m_store)
+			const_cast<ColumnPrivate*>(this)->initDataContainer();
+
+		if (m_store)
+			static_cast<const ColumnStore*>(m_store)->forEachPage<T>(first, count, function);
+		else if (m_blocks) {
+			for (const auto& chunk : static_cast<const ColumnBlocks<T>*>(m_blocks)->chunks(first, count))
+				function(chunk.values, chunk.size, chunk.firstRow);
+		} else if (m_data && count > 0)
+			function(static_cast<const QVector<T>*>(m_data)->constData() + first, count, first);
+	}
 	bool valueLabelsInitialized() const;
 	void removeValueLabel(const QString&);
 	void setLabelsMode(Column::ColumnMode mode);
@@ -130,9 +160,52 @@ public:
 	void replaceValues(int first, const QVector<qint64>&);
 	void replaceBigInt(int first, const QVector<qint64>&);
 
-	void updateProperties();
+	// exchanges the values stored in the delta with the values of the column, used to undo and redo changes.
+	// Never call this function with a type that doesn't match the column mode.
+	template<typename T>
+	void applyValuesDelta(ColumnValuesDelta<T>& delta) {
+		if (!m_data && !m_blocks && !m_store)
+			return;
+
+		invalidate();
+
+		Q_EMIT m_owner->dataAboutToChange(m_owner);
+		if (m_store) {
+			ColumnStore::Values<T> values(*m_store);
+			delta.apply(values);
+		} else if (m_blocks)
+			delta.apply(*static_cast<ColumnBlocks<T>*>(m_blocks));
+		else
+			delta.apply(*static_cast<QVector<T>*>(m_data));
+		if (!m_owner->m_suppressDataChangedSignal)
+			Q_EMIT m_owner->dataChanged(m_owner);
+	}
+
+	// records the values that will be changed when the rows starting at \c first are replaced with \c newValues in \c delta.
+	// Never call this function with a type that doesn't match the column mode.
+	template<typename T>
+	bool recordValuesDelta(ColumnValuesDelta<T>& delta, int first, const QVector<T>& newValues) {
+		if (!m_data && !m_blocks && !m_store && !initDataContainer())
+			return false; // failed to allocate memory
+
+		if (m_store)
+			delta.record(ColumnStore::Values<T>(*m_store), first, newValues);
+		else if (m_blocks)
+			delta.record(*static_cast<ColumnBlocks<T>*>(m_blocks), first, newValues);
+		else
+			delta.record(*static_cast<QVector<T>*>(m_data), first, newValues);
+		return true;
+	}
+
+	void permuteRows(const QVector<int>& permutation, bool inverse, int rowCount = -1);
+
+	void updateProperties(int firstRow = 1);
 	void calculateStatistics();
+	void calculateMoments();
 	void invalidate();
+	void invalidate(int firstRow);
+	void updateCachedValues();
+	quint64 version() const;
 	void finalizeLoad();
 
 	struct CachedValuesAvailable {
@@ -143,8 +216,12 @@ public:
 			hasValues = false;
 			dictionary = false;
 			properties = false;
+			moments = false;
 		}
 		bool statistics{false}; // is 'statistics' already available or needs to be (re-)calculated?
+		// are the measures determined in one pass (size, means, variance, skewness, kurtosis) available in 'statistics'?
+		// They're extended with appended rows while the measures based on the order of the values are calculated on request only
+		bool moments{false};
 		// are minMax already calculated or needs to be (re-)calculated?
 		// It is separated from statistics, because these are important values
 		// which are quite often needed, but if the curve is monoton a faster algorithm is
@@ -252,7 +329,12 @@ public:
 private:
 	AbstractColumn::ColumnMode m_columnMode; // type of column data
 	void* m_data{nullptr}; // pointer to the data container (QVector<T>)
+	void* m_blocks{nullptr}; // pointer to the chunked data container (ColumnBlocks<T>) used instead of m_data, see setChunkedStorage()
+	ColumnStore* m_store{nullptr}; // memory mapped data container used instead of m_data, see setOutOfCoreStorage()
+	QAtomicInteger<quint64> m_version{0}; // incremented on every modification of the data, see invalidate()
 	int m_rowCount{0};
+	int m_cachedRowCount{0}; // number of rows the cached minimum, maximum and properties were determined for, see updateCachedValues()
+	RunningStatistics m_runningStatistics; // one pass statistics of the numeric values of the cached rows, valid if available.moments
 	QVector<QString> m_dictionary; // dictionary for string columns
 	QMap<QString, int> m_dictionaryFrequencies; // dictionary for elements frequencies in string columns
 
@@ -271,24 +353,44 @@ private:
 	void initDictionary();
 	void calculateTextStatistics();
 	void calculateDateTimeStatistics();
+	void addRunningStatistics(int first, int count);
+	void setContiguousStorage();
 	void connectFormulaColumn(const AbstractColumn*);
 
+	// Never call this function directly, because it does no
+	// mode checking.
+	template<typename T>
+	T valueAtPrivate(int row, const T& defaultValue = T()) const {
+		if (m_store)
+			return (row >= 0 && row < m_store->rowCount()) ? m_store->value<T>(row) : defaultValue;
+		if (m_blocks)
+			return static_cast<ColumnBlocks<T>*>(m_blocks)->value(row, defaultValue);
+		if (m_data)
+			return static_cast<QVector<T>*>(m_data)->value(row, defaultValue);
+		return defaultValue;
+	}
+
 	// Never call this function directly, because it does no
 	// mode checking.
 	template<typename T>
 	void setValueAtPrivate(int row, const T& new_value) {
-		if (!m_data) {
+		if (!m_data && !m_blocks && !m_store) {
 			if (!initDataContainer())
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		invalidate(row); // only the row is changed, keep the cached values when it's appended
 
 		Q_EMIT m_owner->dataAboutToChange(m_owner);
 		if (row >= rowCount())
 			resizeTo(row + 1);
 
-		static_cast<QVector<T>*>(m_data)->replace(row, new_value);
+		if (m_store)
+			m_store->setValue<T>(row, new_value);
+		else if (m_blocks)
+			static_cast<ColumnBlocks<T>*>(m_blocks)->ref(row) = new_value;
+		else
+			static_cast<QVector<T>*>(m_data)->replace(row, new_value);
 		if (!m_owner->m_suppressDataChangedSignal)
 			Q_EMIT m_owner->dataChanged(m_owner);
 	}
@@ -297,17 +399,31 @@ private:
 	// mode checking.
 	template<typename T>
 	void replaceValuePrivate(int first, const QVector<T>& new_values) {
-		if (!m_data) {
+		if (!m_data && !m_blocks && !m_store) {
 			const bool resize = (first >= 0);
 			if (!initDataContainer(resize))
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		invalidate(first); // the rows before first are not changed, all rows are replaced if first is negative
 
 		Q_EMIT m_owner->dataAboutToChange(m_owner);
 
-		if (first < 0)
+		if (m_store) {
+			if (first < 0)
+				m_store->resize(new_values.size(), false);
+			else
+				resizeTo(first + new_values.size());
+			m_store->write(std::max(first, 0), new_values.constData(), new_values.size());
+		} else if (m_blocks) {
+			auto* blocks = static_cast<ColumnBlocks<T>*>(m_blocks);
+			if (first < 0)
+				*blocks = ColumnBlocks<T>(new_values);
+			else {
+				resizeTo(first + new_values.size());
+				blocks->replace(first, new_values.constData(), new_values.size());
+			}
+		} else if (first < 0)
 			*static_cast<QVector<T>*>(m_data) = new_values;
 		else {
 			const int num_rows = new_values.size();
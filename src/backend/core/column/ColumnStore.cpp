@@ -0,0 +1,268 @@
+/*
+	File                 : ColumnStore.cpp
+	Project              : LabPlot
+	Description          : Memory mapped storage of the values of a numeric column
+	--------------------------------------------------------------------
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/core/column/ColumnStore.h"
+#include "backend/lib/macros.h"
+
+#include <QDir>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+
+#include <cmath>
+#include <cstring>
+
+ColumnStore::ColumnStore(AbstractColumn::ColumnMode mode)
+	: m_mode(mode) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		m_valueSize = sizeof(double);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		m_valueSize = sizeof(int);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		m_valueSize = sizeof(qint64);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		m_valueSize = 0;
+		return; // not supported
+	}
+
+	// the files are created in the cache directory, the temporary directory is used if there is no cache directory
+	QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	if (dir.isEmpty() || !QDir().mkpath(dir + QLatin1String("/columns")))
+		dir = QDir::tempPath();
+	else
+		dir += QLatin1String("/columns");
+
+	m_file.reset(new QTemporaryFile(dir + QLatin1String("/XXXXXX.column")));
+	if (!m_file->open()) {
+		DEBUG(Q_FUNC_INFO << ", failed to create the file " << STDSTRING(m_file->fileTemplate()))
+		m_file.reset();
+	}
+}
+
+ColumnStore::~ColumnStore() {
+	unmapPages(0);
+}
+
+/*!
+ * returns \c true if the values of a column with the mode \c mode can be stored in a ColumnStore.
+ */
+bool ColumnStore::isSupported(AbstractColumn::ColumnMode mode) {
+	return mode == AbstractColumn::ColumnMode::Double || mode == AbstractColumn::ColumnMode::Integer || mode == AbstractColumn::ColumnMode::BigInt;
+}
+
+/*!
+ * returns \c false if the mode is not supported or the file couldn't be created.
+ */
+bool ColumnStore::isValid() const {
+	return m_file != nullptr;
+}
+
+AbstractColumn::ColumnMode ColumnStore::mode() const {
+	return m_mode;
+}
+
+QString ColumnStore::fileName() const {
+	return m_file ? m_file->fileName() : QString();
+}
+
+qint64 ColumnStore::rowCount() const {
+	return m_rowCount;
+}
+
+/*!
+ * sets the number of rows to \c rows. The new rows are set to NaN (double) or 0 (integer and big integer)
+ * if \c initialize is \c true, otherwise the values of the new rows are undefined and have to be written by the caller.
+ * Returns \c false if the file couldn't be resized.
+ */
+bool ColumnStore::resize(qint64 rows, bool initialize) {
+	if (rows < 0 || !isValid())
+		return false;
+
+	const qint64 oldRows = m_rowCount;
+	if (rows > oldRows && !reserve(rows))
+		return false;
+
+	m_rowCount = rows;
+	if (rows > oldRows && initialize)
+		fill(oldRows, rows - oldRows);
+	else if (rows < oldRows) {
+		// release the pages not used anymore
+		const qint64 pages = (rows + PageRows - 1) / PageRows;
+		unmapPages(pages);
+		m_file->resize(pages * PageRows * m_valueSize);
+	}
+
+	return true;
+}
+
+/*!
+ * inserts \c count rows before the row \c before, the new rows are set to NaN (double) or 0 (integer and big integer).
+ * Only the values behind \c before are moved.
+ */
+bool ColumnStore::insert(qint64 before, qint64 count) {
+	if (count <= 0 || before < 0)
+		return count == 0;
+	if (before >= m_rowCount)
+		return resize(m_rowCount + count);
+
+	const qint64 rows = m_rowCount;
+	if (!resize(rows + count, false))
+		return false;
+
+	move(before, before + count, rows - before);
+	fill(before, count);
+	return true;
+}
+
+/*!
+ * removes the rows [\c first, \c first + \c count).
+ */
+bool ColumnStore::remove(qint64 first, qint64 count) {
+	count = std::min(count, m_rowCount - first);
+	if (count <= 0 || first < 0)
+		return false;
+
+	move(first + count, first, m_rowCount - first - count);
+	return resize(m_rowCount - count);
+}
+
+/*!
+ * determines the statistics of the \c count values starting at the row \c first (all rows if \c count is negative)
+ * streaming over the pages, NaN values are ignored.
+ */
+RunningStatistics ColumnStore::statistics(qint64 first, qint64 count) const {
+	if (count < 0)
+		count = m_rowCount - first;
+
+	RunningStatistics result;
+	const auto add = [&result](const auto* values, int size, qint64) {
+		for (int i = 0; i < size; ++i)
+			result.add(values[i]);
+	};
+	switch (m_mode) {
+	case AbstractColumn::ColumnMode::Double:
+		forEachPage<double>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		forEachPage<int>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		forEachPage<qint64>(first, count, add);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	return result;
+}
+
+/*!
+ * returns the page with the index \c index, the page is mapped when it's accessed for the first time.
+ */
+uchar* ColumnStore::page(qint64 index) const {
+	QMutexLocker locker(&m_mutex);
+	auto& page = m_pages[index];
+	if (!page) {
+		const qint64 pageSize = PageRows * m_valueSize;
+		page = m_file->map(index * pageSize, pageSize);
+		if (!page)
+			qFatal("ColumnStore: failed to map page %lld of %s", index, qPrintable(m_file->fileName()));
+	}
+	return page;
+}
+
+/*!
+ * resizes the file so that it contains at least \c rows rows, the file always consists of complete pages.
+ */
+bool ColumnStore::reserve(qint64 rows) {
+	const qint64 pages = (rows + PageRows - 1) / PageRows;
+	if (pages > (qint64)m_pages.size()) {
+		if (!m_file->resize(pages * PageRows * m_valueSize)) {
+			DEBUG(Q_FUNC_INFO << ", failed to resize the file " << STDSTRING(m_file->fileName()))
+			return false;
+		}
+		m_pages.resize(pages, nullptr);
+	}
+	return true;
+}
+
+/*!
+ * unmaps the pages starting at the page \c first and removes them from the page list.
+ */
+void ColumnStore::unmapPages(qint64 first) {
+	for (qint64 i = first; i < (qint64)m_pages.size(); ++i) {
+		if (m_pages.at(i))
+			m_file->unmap(m_pages.at(i));
+	}
+	if (first < (qint64)m_pages.size())
+		m_pages.resize(first);
+}
+
+/*!
+ * sets the rows [\c first, \c first + \c count) to NaN (double) or 0 (integer and big integer).
+ */
+void ColumnStore::fill(qint64 first, qint64 count) {
+	switch (m_mode) {
+	case AbstractColumn::ColumnMode::Double:
+		forEachPage<double>(first, count, [](double* values, int size, qint64) {
+			std::fill(values, values + size, NAN);
+		});
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		forEachPage<int>(first, count, [](int* values, int size, qint64) {
+			std::fill(values, values + size, 0);
+		});
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		forEachPage<qint64>(first, count, [](qint64* values, int size, qint64) {
+			std::fill(values, values + size, 0);
+		});
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
+
+/*!
+ * moves the \c count values starting at the row \c from to the rows starting at \c to, the ranges may overlap.
+ * The values are moved in parts not crossing the page boundaries, starting with the last values if they're moved to higher rows.
+ */
+void ColumnStore::move(qint64 from, qint64 to, qint64 count) {
+	if (from == to)
+		return;
+
+	if (to > from) {
+		for (qint64 end = count; end > 0;) {
+			// the last values of the remaining ones, limited by the page boundaries of the source and the target
+			const qint64 fromOffset = (from + end - 1) % PageRows + 1;
+			const qint64 toOffset = (to + end - 1) % PageRows + 1;
+			const qint64 size = std::min({end, fromOffset, toOffset});
+			end -= size;
+			std::memmove(address(to + end), address(from + end), size * m_valueSize);
+		}
+	} else {
+		for (qint64 start = 0; start < count;) {
+			const qint64 size = std::min({count - start, PageRows - (from + start) % PageRows, PageRows - (to + start) % PageRows});
+			std::memmove(address(to + start), address(from + start), size * m_valueSize);
+			start += size;
+		}
+	}
+}
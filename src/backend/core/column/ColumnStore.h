@@ -0,0 +1,159 @@
+/*
+	File                 : ColumnStore.h
+	Project              : LabPlot
+	Description          : Memory mapped storage of the values of a numeric column
+	--------------------------------------------------------------------
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef COLUMNSTORE_H
+#define COLUMNSTORE_H
+
+#include "backend/core/AbstractColumn.h"
+#include "backend/core/column/RunningStatistics.h"
+
+#include <QMutex>
+#include <QVector>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class QTemporaryFile;
+
+/*!
+	\class ColumnStore
+	\brief Stores the values of a numeric column (double, integer or big integer) in a memory mapped file.
+
+	The values are stored in a temporary file in the cache directory which is removed together with the store.
+	The file is mapped page by page, a page holds \c PageRows values and is only mapped when it's accessed for
+	the first time. The operating system loads the mapped pages on demand and writes them back to the file
+	if the memory is needed otherwise, so the store can hold more values than fit into the memory.
+
+	The row count is 64-bit and not limited to the maximal number of rows of a Column.
+	The values are accessed either row by row via value() and setValue() or page by page via forEachPage()
+	which is intended for reading and writing many values at once, e.g. in the imports and when determining the statistics.
+
+	The pages are only unmapped when the store shrinks or is deleted, the pointers to the values stay valid until then.
+	Reading from several threads is possible, changing the size of the store is not.
+
+	\ingroup backend
+*/
+class ColumnStore {
+public:
+	static constexpr qint64 PageRows = 1 << 20;
+
+	explicit ColumnStore(AbstractColumn::ColumnMode);
+	~ColumnStore();
+
+	static bool isSupported(AbstractColumn::ColumnMode);
+
+	bool isValid() const;
+	AbstractColumn::ColumnMode mode() const;
+	QString fileName() const;
+	qint64 rowCount() const;
+
+	bool resize(qint64 rows, bool initialize = true);
+	bool insert(qint64 before, qint64 count);
+	bool remove(qint64 first, qint64 count);
+
+	template<typename T>
+	T value(qint64 row) const {
+		Q_ASSERT((int)sizeof(T) == m_valueSize);
+		return *reinterpret_cast<const T*>(address(row));
+	}
+	template<typename T>
+	T& ref(qint64 row) {
+		Q_ASSERT((int)sizeof(T) == m_valueSize);
+		return *reinterpret_cast<T*>(address(row));
+	}
+	template<typename T>
+	void setValue(qint64 row, T value) {
+		ref<T>(row) = value;
+	}
+
+	//! copies \c count values starting at \c values into the rows starting at \c first, the rows have to exist
+	template<typename T>
+	void write(qint64 first, const T* values, qint64 count) {
+		forEachPage<T>(first, count, [&values](T* pageValues, int size, qint64) {
+			std::copy(values, values + size, pageValues);
+			values += size;
+		});
+	}
+	//! copies the \c count values starting at the row \c first to \c values
+	template<typename T>
+	void read(qint64 first, T* values, qint64 count) const {
+		forEachPage<T>(first, count, [&values](const T* pageValues, int size, qint64) {
+			std::copy(pageValues, pageValues + size, values);
+			values += size;
+		});
+	}
+
+	/*!
+	 * calls \c function(T* values, int count, qint64 firstRow) for the parts of the rows [first, first + count) in the mapped pages.
+	 * Never call this function with a type that doesn't match the mode.
+	 */
+	template<typename T, typename Function>
+	void forEachPage(qint64 first, qint64 count, Function function) {
+		Q_ASSERT((int)sizeof(T) == m_valueSize);
+		for (qint64 row = first, last = first + std::min(count, m_rowCount - first); row < last;) {
+			const int size = (int)std::min(PageRows - row % PageRows, last - row);
+			function(reinterpret_cast<T*>(address(row)), size, row);
+			row += size;
+		}
+	}
+	template<typename T, typename Function>
+	void forEachPage(qint64 first, qint64 count, Function function) const {
+		Q_ASSERT((int)sizeof(T) == m_valueSize);
+		for (qint64 row = first, last = first + std::min(count, m_rowCount - first); row < last;) {
+			const int size = (int)std::min(PageRows - row % PageRows, last - row);
+			function(reinterpret_cast<const T*>(address(row)), size, row);
+			row += size;
+		}
+	}
+
+	RunningStatistics statistics(qint64 first = 0, qint64 count = -1) const;
+
+	//! typed view of the store with the interface of QVector used by ColumnValuesDelta
+	template<typename T>
+	class Values {
+	public:
+		explicit Values(ColumnStore& store)
+			: m_store(store) {
+		}
+		int size() const {
+			return (int)std::min(m_store.rowCount(), qint64(INT_MAX));
+		}
+		T at(int row) const {
+			return m_store.value<T>(row);
+		}
+		T& ref(int row) {
+			return m_store.ref<T>(row);
+		}
+		void resize(int size) {
+			m_store.resize(size);
+		}
+
+	private:
+		ColumnStore& m_store;
+	};
+
+private:
+	uchar* address(qint64 row) const {
+		return page(row / PageRows) + (row % PageRows) * m_valueSize;
+	}
+	uchar* page(qint64 index) const;
+	bool reserve(qint64 rows);
+	void unmapPages(qint64 first);
+	void fill(qint64 first, qint64 count);
+	void move(qint64 from, qint64 to, qint64 count);
+
+	AbstractColumn::ColumnMode m_mode;
+	int m_valueSize;
+	std::unique_ptr<QTemporaryFile> m_file;
+	qint64 m_rowCount{0};
+	mutable std::vector<uchar*> m_pages; // mapped pages, nullptr if not mapped yet
+	mutable QMutex m_mutex; // guards the mapping of the pages
+};
+
+#endif
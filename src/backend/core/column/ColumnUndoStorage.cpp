@@ -0,0 +1,159 @@
+/*
+	File                 : ColumnUndoStorage.cpp
+	Project              : LabPlot
+	Description          : Compact storage of the undo data of column commands
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ColumnUndoStorage.h"
+#include "backend/core/Settings.h"
+#include "backend/lib/macros.h"
+
+#include <QTemporaryFile>
+
+/*!
+ * \class ColumnUndoStorage
+ * \brief Memory budget for the undo data of the column commands.
+ *
+ * The budget is read from the settings ("UndoMemoryBudget" in MiB) and can be changed with setMemoryBudget().
+ * A negative budget disables the spilling.
+ */
+ColumnUndoStorage& ColumnUndoStorage::instance() {
+	static ColumnUndoStorage storage;
+	return storage;
+}
+
+ColumnUndoStorage::ColumnUndoStorage()
+	: m_memoryBudget(static_cast<qint64>(Settings::readUndoMemoryBudget()) * 1024 * 1024) {
+}
+
+void ColumnUndoStorage::setMemoryBudget(qint64 bytes) {
+	m_memoryBudget = bytes;
+	evict();
+}
+
+qint64 ColumnUndoStorage::memoryBudget() const {
+	return m_memoryBudget;
+}
+
+/*!
+ * returns the memory currently used by the undo data that was not spilled.
+ */
+qint64 ColumnUndoStorage::memoryUsage() const {
+	return m_memoryUsage;
+}
+
+void ColumnUndoStorage::add(ColumnUndoData* data) {
+	m_data.push_back(data);
+}
+
+void ColumnUndoStorage::remove(ColumnUndoData* data) {
+	m_data.remove(data);
+	m_memoryUsage -= data->m_memorySize;
+}
+
+/*!
+ * sets the memory size of \c data and marks it as the most recently used undo data.
+ */
+void ColumnUndoStorage::update(ColumnUndoData* data, qint64 size) {
+	m_memoryUsage += size - data->m_memorySize;
+	data->m_memorySize = size;
+	m_data.remove(data);
+	m_data.push_back(data);
+}
+
+/*!
+ * spills the least recently used undo data until the memory usage is within the budget.
+ */
+void ColumnUndoStorage::evict() {
+	if (m_memoryBudget < 0)
+		return;
+
+	for (auto* data : m_data) {
+		if (m_memoryUsage <= m_memoryBudget)
+			break;
+		if (data->m_memorySize > 0 && !data->isSpilled())
+			data->spill();
+	}
+}
+
+/*!
+ * \class ColumnUndoData
+ * \brief Base class for the undo data registered in ColumnUndoStorage.
+ *
+ * Derived classes call updated() after their data was changed and load() before they access it.
+ */
+ColumnUndoData::ColumnUndoData() {
+	ColumnUndoStorage::instance().add(this);
+}
+
+ColumnUndoData::~ColumnUndoData() {
+	ColumnUndoStorage::instance().remove(this);
+}
+
+/*!
+ * returns the memory used by the data, 0 if the data was spilled.
+ */
+qint64 ColumnUndoData::memorySize() const {
+	return m_memorySize;
+}
+
+bool ColumnUndoData::isSpilled() const {
+	return m_file != nullptr;
+}
+
+/*!
+ * updates the memory usage after the data was changed and spills the least recently used data if the budget is exceeded.
+ */
+void ColumnUndoData::updated() {
+	auto& storage = ColumnUndoStorage::instance();
+	storage.update(this, dataSize());
+	storage.evict();
+}
+
+/*!
+ * loads the spilled data back into memory.
+ */
+void ColumnUndoData::load() {
+	if (!m_file)
+		return;
+
+	m_file->seek(0);
+	const auto bytes = qUncompress(m_file->readAll());
+	QDataStream in(bytes);
+	read(in);
+	m_file.reset();
+
+	// the data is used now and must not be spilled before updated() is called
+	ColumnUndoStorage::instance().update(this, dataSize());
+}
+
+/*!
+ * writes the compressed data to a temporary file and releases the memory.
+ * returns \c false if the data couldn't be written, the data is kept in memory in this case.
+ */
+bool ColumnUndoData::spill() {
+	QByteArray bytes;
+	{
+		QDataStream out(&bytes, QIODevice::WriteOnly);
+		write(out);
+	}
+
+	auto file = std::make_unique<QTemporaryFile>();
+	const auto compressed = qCompress(bytes, 1);
+	bytes.clear();
+	if (!file->open() || file->write(compressed) != compressed.size()) {
+		WARN(Q_FUNC_INFO << ", failed to write the undo data to a temporary file")
+		return false;
+	}
+
+	release();
+	m_file = std::move(file);
+
+	// called while iterating over the registered data in evict(), the order is not changed
+	ColumnUndoStorage::instance().m_memoryUsage -= m_memorySize;
+	m_memorySize = 0;
+	return true;
+}
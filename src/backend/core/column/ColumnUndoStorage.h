@@ -0,0 +1,235 @@
+/*
+	File                 : ColumnUndoStorage.h
+	Project              : LabPlot
+	Description          : Compact storage of the undo data of column commands
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef COLUMNUNDOSTORAGE_H
+#define COLUMNUNDOSTORAGE_H
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <type_traits>
+
+class ColumnUndoData;
+class QTemporaryFile;
+
+/*!
+ * Keeps track of the memory used by the undo data of the column commands.
+ * If the memory budget is exceeded, the least recently used undo data is spilled
+ * to compressed temporary files and loaded back when the command is undone or redone.
+ */
+class ColumnUndoStorage {
+public:
+	static ColumnUndoStorage& instance();
+
+	void setMemoryBudget(qint64 bytes);
+	qint64 memoryBudget() const;
+	qint64 memoryUsage() const;
+
+private:
+	ColumnUndoStorage();
+
+	void add(ColumnUndoData*);
+	void remove(ColumnUndoData*);
+	void update(ColumnUndoData*, qint64 size);
+	void evict();
+
+	std::list<ColumnUndoData*> m_data; // least recently used first
+	qint64 m_memoryBudget;
+	qint64 m_memoryUsage{0};
+
+	friend class ColumnUndoData;
+};
+
+/*!
+ * Base class for the undo data registered in ColumnUndoStorage.
+ */
+class ColumnUndoData {
+public:
+	virtual ~ColumnUndoData();
+
+	qint64 memorySize() const;
+	bool isSpilled() const;
+
+protected:
+	ColumnUndoData();
+
+	void updated();
+	void load();
+
+	virtual qint64 dataSize() const = 0;
+	virtual void write(QDataStream&) const = 0;
+	virtual void read(QDataStream&) = 0;
+	virtual void release() = 0;
+
+private:
+	bool spill();
+
+	std::unique_ptr<QTemporaryFile> m_file; // spilled data
+	qint64 m_memorySize{0};
+
+	friend class ColumnUndoStorage;
+};
+
+/*!
+ * The values of a column that differ between the state before and after a command,
+ * stored as runs of consecutive rows together with the row count.
+ * apply() exchanges the stored values with the values in the column, the same delta
+ * is used to undo and to redo the change.
+ */
+template<typename T>
+class ColumnValuesDelta : public ColumnUndoData {
+public:
+	/*!
+	 * records the values in \c data (QVector<T>, ColumnBlocks<T> or ColumnStore::Values<T>) that will be changed when the rows starting at \c first
+	 * (all rows if \c first is negative) are replaced with \c newValues.
+	 */
+	template<typename Data>
+	void record(const Data& data, int first, const QVector<T>& newValues) {
+		m_runs.clear();
+		m_values.clear();
+		m_rowCount = data.size();
+
+		const int start = std::max(first, 0);
+		const int newCount = start + newValues.size();
+		const int end = std::min(m_rowCount, newCount);
+		for (int row = start; row < end; ++row) {
+			if (!equal(data.at(row), newValues.at(row - start)))
+				add(row, data.at(row));
+		}
+
+		// rows removed by the change
+		for (int row = newCount; row < m_rowCount; ++row)
+			add(row, data.at(row));
+
+		updated();
+	}
+
+	/*!
+	 * exchanges the stored values with the values in \c data (QVector<T>, ColumnBlocks<T> or ColumnStore::Values<T>) and restores the stored row count.
+	 */
+	template<typename Data>
+	void apply(Data& data) {
+		load();
+
+		const int rowCount = data.size();
+		if (m_rowCount > rowCount)
+			data.resize(m_rowCount);
+
+		int index = 0;
+		for (const auto& run : qAsConst(m_runs)) {
+			for (int row = run.first; row < run.first + run.count; ++row)
+				std::swap(valueRef(data, row), m_values[index++]);
+		}
+
+		if (m_rowCount < rowCount) {
+			// rows removed by the change
+			for (int row = m_rowCount; row < rowCount; ++row)
+				add(row, data.at(row));
+			data.resize(m_rowCount);
+		} else {
+			// rows added by the change don't need to be stored
+			while (!m_runs.isEmpty() && m_runs.constLast().first + m_runs.constLast().count > rowCount) {
+				auto& run = m_runs.last();
+				const int removed = std::min(run.count, run.first + run.count - rowCount);
+				m_values.resize(m_values.size() - removed);
+				run.count -= removed;
+				if (run.count == 0)
+					m_runs.removeLast();
+			}
+		}
+
+		m_rowCount = rowCount;
+		updated();
+	}
+
+	int changedRows() const {
+		return m_values.size();
+	}
+
+protected:
+	qint64 dataSize() const override {
+		qint64 size = m_runs.size() * sizeof(Run) + m_values.size() * sizeof(T);
+		if constexpr (std::is_same_v<T, QString>) {
+			for (const auto& value : m_values)
+				size += value.size() * sizeof(QChar);
+		}
+		return size;
+	}
+
+	void write(QDataStream& out) const override {
+		out << static_cast<qint32>(m_runs.size());
+		for (const auto& run : m_runs)
+			out << run.first << run.count;
+		out << m_values;
+	}
+
+	void read(QDataStream& in) override {
+		qint32 count;
+		in >> count;
+		m_runs.resize(count);
+		for (auto& run : m_runs)
+			in >> run.first >> run.count;
+		in >> m_values;
+	}
+
+	void release() override {
+		m_runs = QVector<Run>();
+		m_values = QVector<T>();
+	}
+
+private:
+	struct Run {
+		int first;
+		int count;
+	};
+
+	void add(int row, const T& value) {
+		if (!m_runs.isEmpty() && m_runs.constLast().first + m_runs.constLast().count == row)
+			++m_runs.last().count;
+		else
+			m_runs.append({row, 1});
+		m_values.append(value);
+	}
+
+	static T& valueRef(QVector<T>& data, int row) {
+		return data.data()[row];
+	}
+	// ColumnBlocks<T> and ColumnStore::Values<T>
+	template<typename Data>
+	static T& valueRef(Data& data, int row) {
+		return data.ref(row);
+	}
+
+	static bool equal(double a, double b) {
+		return (a == b && std::signbit(a) == std::signbit(b)) || (std::isnan(a) && std::isnan(b));
+	}
+	static bool equal(int a, int b) {
+		return a == b;
+	}
+	static bool equal(qint64 a, qint64 b) {
+		return a == b;
+	}
+	static bool equal(const QString& a, const QString& b) {
+		return a == b && a.isNull() == b.isNull();
+	}
+	static bool equal(const QDateTime& a, const QDateTime& b) {
+		return a == b && a.timeSpec() == b.timeSpec();
+	}
+
+	QVector<Run> m_runs; // changed rows
+	QVector<T> m_values; // values of the changed rows
+	int m_rowCount{0};
+};
+
+#endif // COLUMNUNDOSTORAGE_H
@@ -0,0 +1,128 @@
+/*
+	File                 : RunningStatistics.h
+	Project              : LabPlot
+	Description          : Statistics of a column determined in one pass over the values
+	--------------------------------------------------------------------
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef RUNNINGSTATISTICS_H
+#define RUNNINGSTATISTICS_H
+
+#include "backend/core/AbstractColumn.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/*!
+	\class RunningStatistics
+	\brief Determines the statistical measures of a column that don't need the sorted values in one pass over the values.
+
+	The values are added one after the other with add(), the count, the minimum and the maximum, the sums
+	for the means and the central moments up to the fourth order are updated with every value
+	(Welford's algorithm extended to the higher moments). This allows to stream over columns that don't fit
+	into the memory and to take appended values into account without going over the previous values again.
+
+	The measures based on the order of the values (median, quartiles, percentiles, mode, etc.) are not determined.
+
+	\ingroup backend
+*/
+class RunningStatistics {
+public:
+	void add(double value) {
+		if (std::isnan(value))
+			return;
+
+		if (value < m_minimum)
+			m_minimum = value;
+		if (value > m_maximum)
+			m_maximum = value;
+		m_sum += value;
+		m_sumInverse += 1. / value; // will be Inf when value == 0
+		m_sumSquare += value * value;
+		if (value > 0.)
+			m_sumLog += std::log(value); // zero values are replaced with 1 for the geometric mean
+		m_sumLogPercent += std::log1p(value / 100.); // NaN for values <= -100, the geometric mean is invalid then
+
+		const double n1 = m_count;
+		++m_count;
+		const double n = m_count;
+		const double delta = value - m_mean;
+		const double deltaN = delta / n;
+		const double deltaN2 = deltaN * deltaN;
+		const double term = delta * deltaN * n1;
+		m_mean += deltaN;
+		m_m4 += term * deltaN2 * (n * n - 3. * n + 3.) + 6. * deltaN2 * m_m2 - 4. * deltaN * m_m3;
+		m_m3 += term * deltaN * (n - 2.) - 3. * deltaN * m_m2;
+		m_m2 += term;
+	}
+
+	qint64 count() const {
+		return m_count;
+	}
+	double minimum() const {
+		return m_minimum;
+	}
+	double maximum() const {
+		return m_maximum;
+	}
+	double sum() const {
+		return m_sum;
+	}
+	double mean() const {
+		return (m_count > 0) ? m_mean : NAN;
+	}
+	//! sample variance
+	double variance() const {
+		return (m_count > 1) ? m_m2 / (m_count - 1) : NAN;
+	}
+
+	/*!
+	 * sets the size (limited to INT_MAX), the minimum, the maximum, the means, the variance, the standard deviation,
+	 * the skewness and the kurtosis in \c statistics, the other measures are not changed.
+	 */
+	void fill(AbstractColumn::ColumnStatistics& statistics) const {
+		statistics.size = (int)std::min(m_count, qint64(INT_MAX));
+		statistics.minimum = m_minimum;
+		statistics.maximum = m_maximum;
+		if (m_count == 0)
+			return;
+
+		const double n = m_count;
+		statistics.arithmeticMean = m_mean;
+
+		if (m_minimum <= -100.) // invalid
+			statistics.geometricMean = NAN;
+		else if (m_minimum < 0.) // interpret as percentage (/100) and add 1, n-th root and convert back to percentage changes
+			statistics.geometricMean = 100. * (std::exp(m_sumLogPercent / n) - 1.);
+		else
+			statistics.geometricMean = std::exp(m_sumLog / n);
+
+		statistics.harmonicMean = n / m_sumInverse;
+		statistics.contraharmonicMean = m_sumSquare / m_sum;
+
+		statistics.variance = variance();
+		statistics.standardDeviation = std::sqrt(statistics.variance);
+
+		const double centralMoment_r2 = m_m2 / n;
+		statistics.skewness = (m_m3 / n) / std::pow(std::sqrt(centralMoment_r2), 3);
+		statistics.kurtosis = (m_m4 / n) / (centralMoment_r2 * centralMoment_r2);
+	}
+
+private:
+	qint64 m_count{0};
+	double m_minimum{INFINITY};
+	double m_maximum{-INFINITY};
+	double m_sum{0.};
+	double m_sumInverse{0.};
+	double m_sumSquare{0.};
+	double m_sumLog{0.};
+	double m_sumLogPercent{0.};
+	double m_mean{0.};
+	double m_m2{0.}; // sums of the powers of the differences to the mean (central moments times count)
+	double m_m3{0.};
+	double m_m4{0.};
+};
+
+#endif
@@ -177,6 +177,93 @@ void ColumnSetModeCmd::undo() {
 	m_undone = true;
 }
 
+// returns the values of the rows [first, first + count) of \c src
+template<typename T>
+static QVector<T> columnValues(const AbstractColumn* src, int first, int count) {
+	QVector<T> values;
+	values.reserve(count);
+	for (int row = first; row < first + count; ++row) {
+		if constexpr (std::is_same_v<T, double>)
+			values << src->valueAt(row);
+		else if constexpr (std::is_same_v<T, int>)
+			values << src->integerAt(row);
+		else if constexpr (std::is_same_v<T, qint64>)
+			values << src->bigIntAt(row);
+		else if constexpr (std::is_same_v<T, QString>)
+			values << src->textAt(row);
+		else
+			values << src->dateTimeAt(row);
+	}
+	return values;
+}
+
+// copies the rows [srcStart, srcStart + count) of \c src into \c col starting at \c destStart
+// and returns the delta with the changed values, all rows are copied if \c destStart is negative
+template<typename T>
+static ColumnUndoData* copyValues(ColumnPrivate* col, const AbstractColumn* src, int srcStart, int destStart, int count) {
+	const auto* data = static_cast<QVector<T>*>(col->data());
+	const QVector<T> oldValues = data ? *data : QVector<T>();
+	auto values = columnValues<T>(src, srcStart, count);
+
+	// keep the rows behind the copied rows, replaceValues() removes them
+	if (destStart >= 0 && destStart + count < oldValues.size())
+		values << oldValues.mid(destStart + count);
+
+	auto* delta = new ColumnValuesDelta<T>();
+	delta->record(oldValues, destStart, values);
+	col->replaceValues(destStart, values);
+	return delta;
+}
+
+// copies the values of \c src into \c col, see copyValues()
+static ColumnUndoData* copyValues(ColumnPrivate* col, const AbstractColumn* src, int srcStart, int destStart, int count) {
+	if (src->columnMode() != col->columnMode())
+		return nullptr;
+
+	switch (col->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		return copyValues<double>(col, src, srcStart, destStart, count);
+	case AbstractColumn::ColumnMode::Integer:
+		return copyValues<int>(col, src, srcStart, destStart, count);
+	case AbstractColumn::ColumnMode::BigInt:
+		return copyValues<qint64>(col, src, srcStart, destStart, count);
+	case AbstractColumn::ColumnMode::Text:
+		return copyValues<QString>(col, src, srcStart, destStart, count);
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		return copyValues<QDateTime>(col, src, srcStart, destStart, count);
+	}
+
+	return nullptr;
+}
+
+// exchanges the values stored in \c delta with the values of \c col
+static void applyValuesDelta(ColumnPrivate* col, ColumnUndoData* delta) {
+	if (!delta)
+		return;
+
+	switch (col->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		col->applyValuesDelta(*static_cast<ColumnValuesDelta<double>*>(delta));
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		col->applyValuesDelta(*static_cast<ColumnValuesDelta<int>*>(delta));
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		col->applyValuesDelta(*static_cast<ColumnValuesDelta<qint64>*>(delta));
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		col->applyValuesDelta(*static_cast<ColumnValuesDelta<QString>*>(delta));
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		col->applyValuesDelta(*static_cast<ColumnValuesDelta<QDateTime>*>(delta));
+		break;
+	}
+}
+
 /** ***************************************************************************
  * \class ColumnFullCopyCmd
  * \brief Copy a complete column
@@ -189,21 +276,12 @@ void ColumnSetModeCmd::undo() {
 
 /**
  * \var ColumnFullCopyCmd::m_src
- * \brief The column to copy
+ * \brief The column to copy, only read when the command is executed the first time
  */
 
 /**
- * \var ColumnFullCopyCmd::m_backup
- * \brief A backup column
- */
-
-/**
- * \var ColumnFullCopyCmd::m_backup_owner
- * \brief A dummy owner for the backup column
- *
- * This is needed because a ColumnPrivate must have an owner. We want access
- * to the ColumnPrivate object to access its data pointer for fast data
- * replacement without too much copying.
+ * \var ColumnFullCopyCmd::m_delta
+ * \brief The changed values, exchanged with the values of the column on undo and redo
  */
 
 /**
@@ -216,39 +294,21 @@ ColumnFullCopyCmd::ColumnFullCopyCmd(ColumnPrivate* col, const AbstractColumn* s
 	setText(i18n("%1: change cell values", col->name()));
 }
 
-/**
- * \brief Dtor
- */
-ColumnFullCopyCmd::~ColumnFullCopyCmd() {
-	delete m_backup;
-	delete m_backup_owner;
-}
-
 /**
  * \brief Execute the command
  */
 void ColumnFullCopyCmd::redo() {
-	if (m_backup == nullptr) {
-		m_backup_owner = new Column(QStringLiteral("temp"), m_src->columnMode());
-		m_backup = new ColumnPrivate(m_backup_owner, m_src->columnMode());
-		m_backup->copy(m_col);
-		m_col->copy(m_src);
-	} else {
-		// swap data of orig. column and backup
-		void* data_temp = m_col->data();
-		m_col->replaceData(m_backup->data());
-		m_backup->replaceData(data_temp);
-	}
+	if (m_delta)
+		applyValuesDelta(m_col, m_delta.get());
+	else // only the values that are changed are kept for undo
+		m_delta.reset(copyValues(m_col, m_src, 0, -1, m_src->rowCount()));
 }
 
 /**
  * \brief Undo the command
  */
 void ColumnFullCopyCmd::undo() {
-	// swap data of orig. column and backup
-	void* data_temp = m_col->data();
-	m_col->replaceData(m_backup->data());
-	m_backup->replaceData(data_temp);
+	applyValuesDelta(m_col, m_delta.get());
 }
 
 /** ***************************************************************************
@@ -263,35 +323,7 @@ void ColumnFullCopyCmd::undo() {
 
 /**
  * \var ColumnPartialCopyCmd::m_src
- * \brief The column to copy
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_col_backup
- * \brief A backup of the original column
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_src_backup
- * \brief A backup of the source column
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_col_backup_owner
- * \brief A dummy owner for the backup column
- *
- * This is needed because a ColumnPrivate must have an owner and
- * we must have a ColumnPrivate object as backup.
- * Using a Column object as backup would lead to an infinite loop.
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_src_backup_owner
- * \brief A dummy owner for the source backup column
- *
- * This is needed because a ColumnPrivate must have an owner and
- * we must have a ColumnPrivate object as backup.
- * Using a Column object as backup would lead to an infinite loop.
+ * \brief The column to copy, only read when the command is executed the first time
  */
 
 /**
@@ -310,8 +342,8 @@ void ColumnFullCopyCmd::undo() {
  */
 
 /**
- * \var ColumnPartialCopyCmd::m_old_row_count
- * \brief Previous number of rows in the destination column
+ * \var ColumnPartialCopyCmd::m_delta
+ * \brief The changed values, exchanged with the values of the column on undo and redo
  */
 
 /**
@@ -327,40 +359,21 @@ ColumnPartialCopyCmd::ColumnPartialCopyCmd(ColumnPrivate* col, const AbstractCol
 	setText(i18n("%1: change cell values", col->name()));
 }
 
-/**
- * \brief Dtor
- */
-ColumnPartialCopyCmd::~ColumnPartialCopyCmd() {
-	delete m_src_backup;
-	delete m_col_backup;
-	delete m_src_backup_owner;
-	delete m_col_backup_owner;
-}
-
 /**
  * \brief Execute the command
  */
 void ColumnPartialCopyCmd::redo() {
-	if (m_src_backup == nullptr) {
-		// copy the relevant rows of source and destination column into backup columns
-		m_src_backup_owner = new Column(QStringLiteral("temp"), m_col->columnMode());
-		m_src_backup = new ColumnPrivate(m_src_backup_owner, m_col->columnMode());
-		m_src_backup->copy(m_src, m_src_start, 0, m_num_rows);
-		m_col_backup_owner = new Column(QStringLiteral("temp"), m_col->columnMode());
-		m_col_backup = new ColumnPrivate(m_col_backup_owner, m_col->columnMode());
-		m_col_backup->copy(m_col, m_dest_start, 0, m_num_rows);
-		m_old_row_count = m_col->rowCount();
-	}
-	m_col->copy(m_src_backup, 0, m_dest_start, m_num_rows);
+	if (m_delta)
+		applyValuesDelta(m_col, m_delta.get());
+	else if (m_num_rows > 0) // only the values that are changed are kept for undo
+		m_delta.reset(copyValues(m_col, m_src, m_src_start, m_dest_start, m_num_rows));
 }
 
 /**
  * \brief Undo the command
  */
 void ColumnPartialCopyCmd::undo() {
-	m_col->copy(m_col_backup, 0, m_dest_start, m_num_rows);
-	m_col->resizeTo(m_old_row_count);
-	m_col->replaceData(m_col->data());
+	applyValuesDelta(m_col, m_delta.get());
 }
 
 /** ***************************************************************************
@@ -584,6 +597,11 @@ ColumnClearCmd::ColumnClearCmd(ColumnPrivate* col, QUndoCommand* parent)
  * \brief Dtor
  */
 ColumnClearCmd::~ColumnClearCmd() {
+	if (m_empty_store || m_store) {
+		delete (m_undone ? m_empty_store : m_store);
+		return;
+	}
+
 	if (m_undone) {
 		if (!m_empty_data)
 			return;
@@ -635,6 +653,20 @@ ColumnClearCmd::~ColumnClearCmd() {
  * \brief Execute the command
  */
 void ColumnClearCmd::redo() {
+	// the values of a column with the out-of-core storage are replaced with an empty store, they are not loaded into the memory
+	if (!m_empty_data && !m_empty_store && m_col->outOfCoreStorage()) {
+		auto* store = new ColumnStore(m_col->columnMode());
+		if (store->resize(m_col->store()->rowCount()))
+			m_empty_store = store;
+		else
+			delete store;
+	}
+	if (m_empty_store) {
+		m_store = m_col->replaceStore(m_empty_store);
+		m_undone = false;
+		return;
+	}
+
 	if (!m_empty_data) {
 		const int rowCount = m_col->rowCount();
 		switch (m_col->columnMode()) {
@@ -682,6 +714,12 @@ void ColumnClearCmd::redo() {
  * \brief Undo the command
  */
 void ColumnClearCmd::undo() {
+	if (m_empty_store) {
+		m_col->replaceStore(m_store);
+		m_undone = true;
+		return;
+	}
+
 	m_col->replaceData(m_data);
 	m_undone = true;
 }
@@ -834,3 +872,49 @@ void ColumnClearFormulasCmd::redo() {
 void ColumnClearFormulasCmd::undo() {
 	m_col->replaceFormulas(m_formulas);
 }
+
+/** ***************************************************************************
+ * \class ColumnPermuteRowsCmd
+ * \brief Rearrange the rows of a column according to a permutation
+ ** ***************************************************************************/
+
+/**
+ * \var ColumnPermuteRowsCmd::m_col
+ * \brief The private column data to modify
+ */
+
+/**
+ * \var ColumnPermuteRowsCmd::m_permutation
+ * \brief The permutation, row i gets the value of the row m_permutation[i].
+ * The permutation is the only undo data, it is shared by the commands for all columns sorted together.
+ */
+
+/**
+ * \var ColumnPermuteRowsCmd::m_rowCount
+ * \brief The number of rows before the permutation
+ */
+
+/**
+ * \brief Ctor
+ */
+ColumnPermuteRowsCmd::ColumnPermuteRowsCmd(ColumnPrivate* col, const QVector<int>& permutation, QUndoCommand* parent)
+	: QUndoCommand(parent)
+	, m_col(col)
+	, m_permutation(permutation) {
+	setText(i18n("%1: sort rows", col->name()));
+}
+
+/**
+ * \brief Execute the command
+ */
+void ColumnPermuteRowsCmd::redo() {
+	m_rowCount = m_col->rowCount();
+	m_col->permuteRows(m_permutation, false);
+}
+
+/**
+ * \brief Undo the command
+ */
+void ColumnPermuteRowsCmd::undo() {
+	m_col->permuteRows(m_permutation, true, m_rowCount);
+}
@@ -14,6 +14,7 @@
 
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/core/column/ColumnUndoStorage.h"
 #include "backend/lib/IntervalAttribute.h"
 
 #include <KLocalizedString>
@@ -48,7 +49,6 @@ private:
 class ColumnFullCopyCmd : public QUndoCommand {
 public:
 	explicit ColumnFullCopyCmd(ColumnPrivate* col, const AbstractColumn* src, QUndoCommand* parent = nullptr);
-	~ColumnFullCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
@@ -56,14 +56,12 @@ public:
 private:
 	ColumnPrivate* m_col;
 	const AbstractColumn* m_src;
-	ColumnPrivate* m_backup{nullptr};
-	Column* m_backup_owner{nullptr};
+	std::unique_ptr<ColumnUndoData> m_delta;
 };
 
 class ColumnPartialCopyCmd : public QUndoCommand {
 public:
 	explicit ColumnPartialCopyCmd(ColumnPrivate* col, const AbstractColumn* src, int src_start, int dest_start, int num_rows, QUndoCommand* parent = nullptr);
-	~ColumnPartialCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
@@ -71,14 +69,10 @@ public:
 private:
 	ColumnPrivate* m_col;
 	const AbstractColumn* m_src;
-	ColumnPrivate* m_col_backup{nullptr};
-	ColumnPrivate* m_src_backup{nullptr};
-	Column* m_col_backup_owner{nullptr};
-	Column* m_src_backup_owner{nullptr};
 	int m_src_start;
 	int m_dest_start;
 	int m_num_rows;
-	int m_old_row_count{0};
+	std::unique_ptr<ColumnUndoData> m_delta;
 };
 
 class ColumnInsertRowsCmd : public QUndoCommand {
@@ -138,6 +132,8 @@ private:
 	ColumnPrivate* m_col;
 	void* m_data{nullptr};
 	void* m_empty_data{nullptr};
+	ColumnStore* m_store{nullptr}; // the values of a column with the out-of-core storage
+	ColumnStore* m_empty_store{nullptr};
 	bool m_undone{false};
 };
 
@@ -198,6 +194,19 @@ private:
 	bool m_copied{false};
 };
 
+class ColumnPermuteRowsCmd : public QUndoCommand {
+public:
+	explicit ColumnPermuteRowsCmd(ColumnPrivate* col, const QVector<int>& permutation, QUndoCommand* parent = nullptr);
+
+	void redo() override;
+	void undo() override;
+
+private:
+	ColumnPrivate* m_col;
+	QVector<int> m_permutation;
+	int m_rowCount{0};
+};
+
 template<typename T>
 class ColumnSetCmd : public QUndoCommand {
 public:
@@ -250,33 +259,23 @@ template<typename T>
 class ColumnReplaceCmd : public QUndoCommand {
 public:
 	/**
-	 * \var ColumnReplaceTextsCmd::m_col
+	 * \var ColumnReplaceCmd::m_col
 	 * \brief The private column data to modify
 	 */
 
 	/**
-	 * \var ColumnReplaceTextsCmd::m_first
-	 * \brief The first row to replace
-	 */
-
-	/**
-	 * \var ColumnReplaceTextsCmd::m_new_values
-	 * \brief The new values
+	 * \var ColumnReplaceCmd::m_first
+	 * \brief The first row to replace, all rows are replaced if negative
 	 */
 
 	/**
-	 * \var ColumnReplaceTextsCmd::m_old_values
-	 * \brief The old values
+	 * \var ColumnReplaceCmd::m_new_values
+	 * \brief The new values, only kept until the command was executed
 	 */
 
 	/**
-	 * \var ColumnReplaceTextsCmd::m_copied
-	 * \brief Status flag
-	 */
-
-	/**
-	 * \var ColumnReplaceTextsCmd::m_row_count
-	 * \brief The old number of rows
+	 * \var ColumnReplaceCmd::m_delta
+	 * \brief The changed values, exchanged with the values of the column on undo and redo
 	 */
 	explicit ColumnReplaceCmd(ColumnPrivate* col, int first, const QVector<T>& new_values, QUndoCommand* parent = nullptr)
 		: QUndoCommand(parent)
@@ -290,37 +289,29 @@ public:
 	}
 
 	void redo() override {
-		auto* data = m_col->data();
-		if (!data)
+		if (m_executed) {
+			m_col->applyValuesDelta(m_delta);
 			return;
+		}
 
-		if (m_first < 0)
-			m_old_values = *static_cast<QVector<T>*>(data);
-		else
-			m_old_values = static_cast<QVector<T>*>(data)->mid(m_first, m_new_values.count());
-
+		// only the values that are changed are kept for undo
+		if (!m_col->recordValuesDelta(m_delta, m_first, m_new_values))
+			return;
 		m_col->replaceValues(m_first, m_new_values);
 		m_new_values.clear(); // delete values, because otherwise we use a lot of ram even if we don't need it
+		m_executed = true;
 	}
 	void undo() override {
-		auto* data = m_col->data();
-		if (!data)
-			return;
-
-		if (m_first < 0)
-			m_new_values = *static_cast<QVector<T>*>(data);
-		else
-			m_new_values = static_cast<QVector<T>*>(data)->mid(m_first, m_old_values.count());
-
-		m_col->replaceValues(m_first, m_old_values);
-		m_old_values.clear();
+		if (m_executed)
+			m_col->applyValuesDelta(m_delta);
 	}
 
 private:
 	ColumnPrivate* m_col;
 	int m_first;
 	QVector<T> m_new_values;
-	QVector<T> m_old_values;
+	ColumnValuesDelta<T> m_delta;
+	bool m_executed{false};
 };
 
 #endif
@@ -0,0 +1,339 @@
+/*
+	File                 : BatchImport.cpp
+	Project              : LabPlot
+	Description          : concurrent import of multiple files of the same layout
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "BatchImport.h"
+#include "backend/core/Workbook.h"
+#include "backend/core/column/Column.h"
+#include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <KLocalizedString>
+#include <QAtomicInt>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+/*!
+	\class BatchImport
+	\brief Imports multiple files of the same layout.
+
+	The files are parsed concurrently, each one with its own filter created by the filter factory
+	provided in the constructor. The parsed data is then either appended to one spreadsheet in a single
+	resize or imported into one spreadsheet per file in a workbook.
+
+	\ingroup datasources
+*/
+
+// typed values of one column of a parsed file
+struct BatchImportColumn {
+	QString name;
+	AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};
+	QString dateTimeFormat;
+	QVector<double> doubles;
+	QVector<int> integers;
+	QVector<qint64> bigInts;
+	QVector<QString> texts;
+	QVector<QDateTime> dateTimes;
+};
+
+struct BatchImportFile {
+	QString fileName;
+	int rows{0};
+	std::vector<BatchImportColumn> columns;
+	QStringList errors;
+};
+
+namespace {
+/*!
+ * moves the values of \c source into the data container \c target of a column starting at row \c offset.
+ */
+template<typename T>
+void moveValues(QVector<T>& source, void* target, int offset) {
+	auto* vector = static_cast<QVector<T>*>(target);
+	if (offset == 0 && vector->size() == source.size())
+		vector->swap(source);
+	else
+		std::move(source.begin(), source.end(), vector->begin() + offset);
+	source.clear();
+}
+
+void moveColumn(BatchImportColumn& column, void* target, int offset) {
+	switch (column.mode) {
+	case AbstractColumn::ColumnMode::Double:
+		moveValues(column.doubles, target, offset);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		moveValues(column.integers, target, offset);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		moveValues(column.bigInts, target, offset);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		moveValues(column.texts, target, offset);
+		break;
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::DateTime:
+		moveValues(column.dateTimes, target, offset);
+		break;
+	}
+}
+
+/*!
+ * parses one file with its own filter into a spreadsheet living in the worker thread
+ * and takes the data of its columns.
+ */
+class ParseFileTask : public QRunnable {
+public:
+	ParseFileTask(const BatchImport* import, const BatchImport::FilterFactory& factory, BatchImportFile& file, QAtomicInt& parsed, int count)
+		: m_import(import)
+		, m_factory(factory)
+		, m_file(file)
+		, m_parsed(parsed)
+		, m_count(count) {
+	}
+
+	void run() override {
+		std::unique_ptr<AbstractFileFilter> filter(m_factory());
+		if (filter) {
+			Spreadsheet spreadsheet(QStringLiteral("batch"), true);
+			filter->readDataFromFile(m_file.fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+			m_file.errors = filter->lastErrors();
+			m_file.rows = spreadsheet.rowCount();
+
+			const auto& columns = spreadsheet.children<Column>();
+			for (auto* column : columns) {
+				BatchImportColumn data;
+				data.name = column->name();
+				data.mode = column->columnMode();
+				switch (data.mode) {
+				case AbstractColumn::ColumnMode::Double:
+					data.doubles.swap(*static_cast<QVector<double>*>(column->data()));
+					data.doubles.resize(m_file.rows);
+					break;
+				case AbstractColumn::ColumnMode::Integer:
+					data.integers.swap(*static_cast<QVector<int>*>(column->data()));
+					data.integers.resize(m_file.rows);
+					break;
+				case AbstractColumn::ColumnMode::BigInt:
+					data.bigInts.swap(*static_cast<QVector<qint64>*>(column->data()));
+					data.bigInts.resize(m_file.rows);
+					break;
+				case AbstractColumn::ColumnMode::Text:
+					data.texts.swap(*static_cast<QVector<QString>*>(column->data()));
+					data.texts.resize(m_file.rows);
+					break;
+				case AbstractColumn::ColumnMode::Month:
+				case AbstractColumn::ColumnMode::Day:
+				case AbstractColumn::ColumnMode::DateTime:
+					data.dateTimeFormat = static_cast<DateTime2StringFilter*>(column->outputFilter())->format();
+					data.dateTimes.swap(*static_cast<QVector<QDateTime>*>(column->data()));
+					data.dateTimes.resize(m_file.rows);
+					break;
+				}
+				m_file.columns.push_back(std::move(data));
+			}
+		}
+
+		if (m_file.columns.empty())
+			m_file.errors << i18n("No data imported from '%1'.", m_file.fileName);
+
+		// 90% for the parsing, the remaining 10% for moving the data into the target
+		Q_EMIT m_import->completed(90 * (m_parsed.fetchAndAddOrdered(1) + 1) / m_count);
+	}
+
+private:
+	const BatchImport* m_import;
+	const BatchImport::FilterFactory& m_factory;
+	BatchImportFile& m_file;
+	QAtomicInt& m_parsed;
+	const int m_count;
+};
+} // namespace
+
+/*!
+ * \c factory creates a new filter with the import settings for each file, it's called in the worker threads.
+ */
+BatchImport::BatchImport(FilterFactory factory)
+	: m_filterFactory(std::move(factory)) {
+}
+
+BatchImport::~BatchImport() = default;
+
+/*!
+ * sets the maximal number of files parsed at the same time, \c 0 uses the number of CPU cores.
+ */
+void BatchImport::setMaxThreadCount(int count) {
+	m_maxThreadCount = count;
+}
+
+int BatchImport::maxThreadCount() const {
+	return m_maxThreadCount;
+}
+
+QStringList BatchImport::lastErrors() const {
+	return m_lastErrors;
+}
+
+/*!
+ * parses the files \c fileNames concurrently.
+ */
+std::vector<BatchImportFile> BatchImport::parse(const QStringList& fileNames) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	m_lastErrors.clear();
+	const int count = fileNames.size();
+	std::vector<BatchImportFile> files(count);
+	QAtomicInt parsed;
+
+	QThreadPool pool;
+	if (m_maxThreadCount > 0)
+		pool.setMaxThreadCount(m_maxThreadCount);
+	for (int i = 0; i < count; ++i) {
+		files[i].fileName = fileNames.at(i);
+		pool.start(new ParseFileTask(this, m_filterFactory, files[i], parsed, count));
+	}
+
+	// wait in an event loop until all files were parsed, so the progress signals emitted
+	// in the worker threads are delivered to the receivers in this thread in the meantime
+	QEventLoop loop;
+	QFutureWatcher<void> watcher;
+	connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+	watcher.setFuture(QtConcurrent::run([&pool]() {
+		pool.waitForDone();
+	}));
+	loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+	for (const auto& file : files)
+		m_lastErrors << file.errors;
+
+	return files;
+}
+
+/*!
+ * imports the files \c fileNames into \c spreadsheet. The rows of all files having the same columns
+ * as the first file are put one after another and the spreadsheet is resized only once.
+ * Returns \c false if no data was imported.
+ */
+bool BatchImport::importToSpreadsheet(const QStringList& fileNames, Spreadsheet* spreadsheet, AbstractFileFilter::ImportMode mode) {
+	DEBUG(Q_FUNC_INFO << ", files = " << fileNames.size() << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, mode))
+	auto files = parse(fileNames);
+
+	// the first file with data defines the columns, the files with other columns are skipped
+	const BatchImportFile* first = nullptr;
+	int rows = 0;
+	std::vector<BatchImportFile*> matchingFiles;
+	for (auto& file : files) {
+		if (file.columns.empty())
+			continue;
+
+		if (!first)
+			first = &file;
+		else {
+			bool matching = (file.columns.size() == first->columns.size());
+			for (size_t i = 0; matching && i < file.columns.size(); ++i)
+				matching = (file.columns.at(i).mode == first->columns.at(i).mode);
+
+			if (!matching) {
+				m_lastErrors << i18n("The columns of '%1' don't match the columns of '%2'.", file.fileName, first->fileName);
+				continue;
+			}
+		}
+
+		rows += file.rows;
+		matchingFiles.push_back(&file);
+	}
+
+	if (!first)
+		return false;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QLatin1String(", moving data"));
+	const int cols = (int)first->columns.size();
+	QStringList names;
+	QVector<AbstractColumn::ColumnMode> modes;
+	QString dateTimeFormat;
+	for (const auto& column : first->columns) {
+		names << column.name;
+		modes << column.mode;
+		if (dateTimeFormat.isEmpty())
+			dateTimeFormat = column.dateTimeFormat;
+	}
+
+	std::vector<void*> dataContainer;
+	const int columnOffset = spreadsheet->prepareImport(dataContainer, mode, rows, cols, names, modes);
+	if (columnOffset == -1)
+		return false;
+
+	int offset = 0;
+	for (auto* file : matchingFiles) {
+		for (int i = 0; i < cols; ++i)
+			moveColumn(file->columns[i], dataContainer[i], offset);
+		offset += file->rows;
+	}
+
+	spreadsheet->finalizeImport(columnOffset, 1, cols, dateTimeFormat, mode);
+	Q_EMIT completed(100);
+
+	return true;
+}
+
+/*!
+ * imports every file of \c fileNames into a new spreadsheet in \c workbook.
+ * The new spreadsheets are added in one undo step.
+ * Returns \c false if no data was imported.
+ */
+bool BatchImport::importToWorkbook(const QStringList& fileNames, Workbook* workbook) {
+	DEBUG(Q_FUNC_INFO << ", files = " << fileNames.size())
+	auto files = parse(fileNames);
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QLatin1String(", moving data"));
+	bool imported = false;
+	for (auto& file : files) {
+		if (file.columns.empty())
+			continue;
+
+		if (!imported) {
+			workbook->beginMacro(i18n("%1: import of %2 files", workbook->name(), fileNames.size()));
+			imported = true;
+		}
+
+		const int cols = (int)file.columns.size();
+		QStringList names;
+		QVector<AbstractColumn::ColumnMode> modes;
+		QString dateTimeFormat;
+		for (const auto& column : file.columns) {
+			names << column.name;
+			modes << column.mode;
+			if (dateTimeFormat.isEmpty())
+				dateTimeFormat = column.dateTimeFormat;
+		}
+
+		auto* spreadsheet = new Spreadsheet(QFileInfo(file.fileName).completeBaseName());
+		std::vector<void*> dataContainer;
+		const auto mode = AbstractFileFilter::ImportMode::Replace;
+		const int columnOffset = spreadsheet->prepareImport(dataContainer, mode, file.rows, cols, names, modes);
+		for (int i = 0; i < cols; ++i)
+			moveColumn(file.columns[i], dataContainer[i], 0);
+		spreadsheet->finalizeImport(columnOffset, 1, cols, dateTimeFormat, mode);
+
+		workbook->addChild(spreadsheet);
+	}
+
+	if (imported)
+		workbook->endMacro();
+	Q_EMIT completed(100);
+
+	return imported;
+}
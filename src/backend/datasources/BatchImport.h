@@ -0,0 +1,48 @@
+/*
+	File                 : BatchImport.h
+	Project              : LabPlot
+	Description          : concurrent import of multiple files of the same layout
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef BATCHIMPORT_H
+#define BATCHIMPORT_H
+
+#include "backend/datasources/filters/AbstractFileFilter.h"
+
+#include <functional>
+#include <vector>
+
+class Spreadsheet;
+class Workbook;
+struct BatchImportFile;
+
+class BatchImport : public QObject {
+	Q_OBJECT
+
+public:
+	using FilterFactory = std::function<AbstractFileFilter*()>;
+
+	explicit BatchImport(FilterFactory);
+	~BatchImport() override;
+
+	void setMaxThreadCount(int);
+	int maxThreadCount() const;
+
+	bool importToSpreadsheet(const QStringList& fileNames, Spreadsheet*, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	bool importToWorkbook(const QStringList& fileNames, Workbook*);
+	QStringList lastErrors() const;
+
+private:
+	std::vector<BatchImportFile> parse(const QStringList& fileNames);
+
+	FilterFactory m_filterFactory;
+	int m_maxThreadCount{0};
+	QStringList m_lastErrors;
+
+Q_SIGNALS:
+	void completed(int) const; //!< int ranging from 0 to 100 notifies about the status of the import
+};
+
+#endif
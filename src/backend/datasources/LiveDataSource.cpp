@@ -15,9 +15,13 @@
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/HDF5Filter.h"
+#include "backend/datasources/filters/NetCDFFilter.h"
 #include "backend/datasources/filters/ROOTFilter.h"
+#include "backend/datasources/filters/SQLFilter.h"
 #include "backend/datasources/filters/SpiceFilter.h"
 #include "backend/lib/XmlStreamReader.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "commonfrontend/spreadsheet/SpreadsheetView.h"
 #include "kdefrontend/spreadsheet/PlotDataDialog.h"
 
@@ -191,6 +195,94 @@ AbstractFileFilter* LiveDataSource::filter() const {
 	return m_filter;
 }
 
+/*!
+ * helper for the filters reading data sets growing in their first dimension incrementally (HDF5, NetCDF, SQL).
+ * Determines the rows [\c from, \c extent) of the data set to be read according to the reading type and the sample size
+ * and prepares the columns for them: the row count is increased if all values are kept, the oldest values
+ * are removed if only the last N values are kept. The columns use the chunked storage so that neither appending
+ * nor removing the oldest rows moves the other values, the new values are written via Column::dataChunks().
+ * \c first is set to the first row in the data set and \c count to the number of rows to be read.
+ * Returns the row in the columns where the new values have to be written to.
+ */
+int LiveDataSource::prepareLiveRows(qint64 from, qint64 extent, qint64& first, int& count) {
+	qint64 newRows = extent - from;
+	first = from;
+	switch (m_readingType) {
+	case ReadingType::ContinuousFixed:
+		newRows = std::min(newRows, (qint64)m_sampleSize);
+		break;
+	case ReadingType::FromEnd:
+		if (newRows > m_sampleSize) {
+			first = extent - m_sampleSize;
+			newRows = m_sampleSize;
+		}
+		break;
+	case ReadingType::TillEnd:
+	case ReadingType::WholeFile:
+		break;
+	}
+
+	// skip the rows not fitting into the window of the last N values
+	if (m_keepNValues > 0 && newRows > m_keepNValues) {
+		first += newRows - m_keepNValues;
+		newRows = m_keepNValues;
+	}
+	count = (int)newRows;
+
+	// columns in a file data source don't have any manual changes.
+	// make the columns undo unaware and suppress the "data changed" signal,
+	// the changes are propagated in finalizeLiveRows() once the new data was read.
+	setUndoAware(false);
+	const auto& columns = children<Column>();
+	for (auto* column : columns) {
+		column->setUndoAware(false);
+		column->setSuppressDataChangedSignal(true);
+		column->setChunkedStorage(true);
+	}
+
+	const int rows = rowCount();
+	if (m_keepNValues == 0 || rows + count <= m_keepNValues) {
+		setRowCount(rows + count);
+		m_firstLiveRow = rows;
+		return rows;
+	}
+
+	// fixed size: remove the oldest values, only the first blocks of the columns are affected
+	const int shift = rows + count - m_keepNValues;
+	m_firstLiveRow = 0;
+	removeRows(0, shift);
+	setRowCount(m_keepNValues);
+
+	return m_keepNValues - count;
+}
+
+/*!
+ * notifies all columns and the plots using them about the new values written after \c prepareLiveRows().
+ */
+void LiveDataSource::finalizeLiveRows() {
+	const auto& columns = children<Column>();
+
+	// determine the dependent plots
+	QVector<CartesianPlot*> plots;
+	for (auto* column : columns)
+		column->addUsedInPlots(plots);
+
+	// suppress retransform in the dependent plots
+	for (auto* plot : plots)
+		plot->setSuppressRetransform(true);
+
+	// the values before the new rows are unchanged if the rows were appended,
+	// the cached properties of the columns are updated with the new values only in this case
+	for (auto* column : columns)
+		column->setChanged(m_firstLiveRow);
+
+	// retransform the dependent plots
+	for (auto* plot : plots) {
+		plot->setSuppressRetransform(false);
+		plot->dataChanged(-1, -1);
+	}
+}
+
 /*!
  * \brief Sets the serial port's baud rate
  * \param baudrate
@@ -411,6 +503,9 @@ QIcon LiveDataSource::icon() const {
 	case AbstractFileFilter::FileType::ROOT:
 		icon = QIcon::fromTheme(QStringLiteral("application-x-root"));
 		break;
+	case AbstractFileFilter::FileType::SQL:
+		icon = QIcon::fromTheme(QStringLiteral("network-server-database"));
+		break;
 	// TODO: missing icons
 	case AbstractFileFilter::FileType::Spice:
 	case AbstractFileFilter::FileType::HDF5:
@@ -560,6 +655,7 @@ void LiveDataSource::read() {
 #endif
 			break;
 		case SourceType::MQTT:
+		case SourceType::Database:
 			break;
 		}
 		m_prepared = true;
@@ -587,17 +683,32 @@ void LiveDataSource::read() {
 			// only re-reading of the whole file is supported
 			m_filter->readDataFromFile(m_fileName, this);
 			break;
+		case AbstractFileFilter::FileType::HDF5:
+			// the data set is read incrementally, m_bytesRead holds the number of rows read so far
+			if (m_readingType == LiveDataSource::ReadingType::WholeFile)
+				m_filter->readDataFromFile(m_fileName, this);
+			else
+				m_bytesRead = static_cast<HDF5Filter*>(m_filter)->readFromLiveFile(m_fileName, this, m_bytesRead);
+			DEBUG("Rows read in total: " << m_bytesRead);
+			break;
+		case AbstractFileFilter::FileType::NETCDF:
+			// the variable is read incrementally, m_bytesRead holds the number of records read so far
+			if (m_readingType == LiveDataSource::ReadingType::WholeFile)
+				m_filter->readDataFromFile(m_fileName, this);
+			else
+				m_bytesRead = static_cast<NetCDFFilter*>(m_filter)->readFromLiveFile(m_fileName, this, m_bytesRead);
+			DEBUG("Records read in total: " << m_bytesRead);
+			break;
 		// TODO: other types not implemented yet
 		case AbstractFileFilter::FileType::XLSX:
 		case AbstractFileFilter::FileType::Ods:
 		case AbstractFileFilter::FileType::Image:
-		case AbstractFileFilter::FileType::HDF5:
 		case AbstractFileFilter::FileType::VECTOR_BLF:
-		case AbstractFileFilter::FileType::NETCDF:
 		case AbstractFileFilter::FileType::FITS:
 		case AbstractFileFilter::FileType::JSON:
 		case AbstractFileFilter::FileType::READSTAT:
 		case AbstractFileFilter::FileType::MATIO:
+		case AbstractFileFilter::FileType::SQL:
 			break;
 		}
 		break;
@@ -634,6 +745,12 @@ void LiveDataSource::read() {
 		break;
 	case SourceType::MQTT:
 		break;
+	case SourceType::Database:
+		// only the rows added since the last read are read, m_bytesRead holds the number of rows read so far
+		if (m_fileType == AbstractFileFilter::FileType::SQL)
+			m_bytesRead = static_cast<SQLFilter*>(m_filter)->readFromLiveDatabase(this, m_bytesRead);
+		DEBUG("Rows read in total: " << m_bytesRead);
+		break;
 	}
 
 	m_reading = false;
@@ -785,6 +902,9 @@ void LiveDataSource::save(QXmlStreamWriter* writer) const {
 		break;
 	case SourceType::MQTT:
 		break;
+	case SourceType::Database:
+		writer->writeAttribute(QStringLiteral("fileType"), QString::number(static_cast<int>(m_fileType)));
+		break;
 	}
 
 	writer->writeAttribute(QStringLiteral("updateType"), QString::number(static_cast<int>(m_updateType)));
@@ -934,6 +1054,8 @@ bool LiveDataSource::load(XmlStreamReader* reader, bool preview) {
 				break;
 			case SourceType::LocalSocket:
 				break;
+			case SourceType::Database:
+				break;
 			}
 
 		} else if (reader->name() == QLatin1String("asciiFilter")) {
@@ -948,6 +1070,18 @@ bool LiveDataSource::load(XmlStreamReader* reader, bool preview) {
 			setFilter(new SpiceFilter);
 			if (!m_filter->load(reader))
 				return false;
+		} else if (reader->name() == QLatin1String("hdfFilter")) {
+			setFilter(new HDF5Filter);
+			if (!m_filter->load(reader))
+				return false;
+		} else if (reader->name() == QLatin1String("netcdfFilter")) {
+			setFilter(new NetCDFFilter);
+			if (!m_filter->load(reader))
+				return false;
+		} else if (reader->name() == SQLFilter::xmlElementName) {
+			setFilter(new SQLFilter);
+			if (!m_filter->load(reader))
+				return false;
 		} else if (reader->name() == QLatin1String("column")) {
 			Column* column = new Column(QString(), AbstractColumn::ColumnMode::Text);
 			if (!column->load(reader, preview)) {
@@ -42,7 +42,8 @@ public:
 		NetworkUDPSocket, // UDP socket
 		LocalSocket, // local socket
 		SerialPort, // serial port
-		MQTT
+		MQTT,
+		Database // SQL database, polled for new rows
 	};
 
 	enum class UpdateType {
@@ -123,6 +124,9 @@ public:
 	void setFilter(AbstractFileFilter*);
 	AbstractFileFilter* filter() const;
 
+	int prepareLiveRows(qint64 from, qint64 extent, qint64& first, int& count);
+	void finalizeLiveRows();
+
 	QIcon icon() const override;
 	QMenu* createContextMenu() override;
 	QWidget* view() const override;
@@ -158,6 +162,7 @@ private:
 	int m_baudRate{9600};
 
 	qint64 m_bytesRead{0};
+	int m_firstLiveRow{0}; // first row changed in prepareLiveRows()
 
 	AbstractFileFilter* m_filter{nullptr};
 
@@ -10,16 +10,24 @@
 */
 
 #include "backend/datasources/filters/AbstractFileFilter.h"
+#include "backend/core/column/Column.h"
+#include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/datasources/filters/SpiceFilter.h"
 #include "backend/datasources/filters/VectorBLFFilter.h"
 #include "backend/lib/macros.h"
+#include "backend/matrix/Matrix.h"
+#include "backend/matrix/MatrixBuffer.h"
 
 #include <KLocalizedString>
 #include <QDateTime>
+#include <QEventLoop>
+#include <QFutureWatcher>
 #include <QImageReader>
 #include <QLocale>
 #include <QProcess>
 #include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
 
 bool AbstractFileFilter::isNan(const QString& s) {
 	const static QStringList nanStrings{QStringLiteral("NA"),
@@ -254,3 +262,152 @@ QString AbstractFileFilter::convertFromNumberToColumn(int n) {
 
 	return QLatin1String(str);
 }
+
+// copies the columns of the matrix buffer \c data into \c columns
+template<typename T>
+static void matrixColumns(const void* data, QVector<QVector<T>>& columns) {
+	const auto* buffer = static_cast<const MatrixBuffer<T>*>(data);
+	for (int col = 0; col < buffer->columnCount(); ++col)
+		columns << buffer->column(col, 0, buffer->rowCount() - 1);
+}
+
+/*!
+ * collects the data of all columns of the spreadsheet or of the numeric matrix \c dataSource for the export,
+ * the text and date/time columns are skipped if \c numericOnly is \c true. The data of the columns is taken via
+ * Column::snapshot(), i.e. without copying the values, and the columns of the matrix are copied, so it can be written
+ * in a separate thread while the data source is changed in the main thread.
+ * Has to be called in the thread of \c dataSource.
+ */
+AbstractFileFilter::ExportData AbstractFileFilter::exportData(AbstractDataSource* dataSource, bool numericOnly) {
+	ExportData data;
+	data.name = dataSource->name();
+	if (auto* matrix = dynamic_cast<Matrix*>(dataSource)) {
+		const auto mode = matrix->mode();
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			matrixColumns(matrix->data(), data.doubles);
+			for (const auto& column : qAsConst(data.doubles))
+				data.vectors << column.constData();
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			matrixColumns(matrix->data(), data.integers);
+			for (const auto& column : qAsConst(data.integers))
+				data.vectors << column.constData();
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			matrixColumns(matrix->data(), data.bigInts);
+			for (const auto& column : qAsConst(data.bigInts))
+				data.vectors << column.constData();
+			break;
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			return data;
+		}
+
+		data.rows = matrix->rowCount();
+		data.modes.fill(mode, data.vectors.size());
+		data.rowCounts.fill(data.rows, data.vectors.size());
+		for (int i = 0; i < data.vectors.size(); ++i) {
+			data.names << QString::number(i + 1);
+			data.formats << QString();
+		}
+	} else if (auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource)) {
+		data.rows = spreadsheet->rowCount();
+		for (const auto* column : spreadsheet->children<Column>()) {
+			const auto mode = column->columnMode();
+			QString format;
+			switch (mode) {
+			case AbstractColumn::ColumnMode::Double:
+				data.doubles << column->snapshot<double>().data;
+				data.vectors << data.doubles.constLast().constData();
+				break;
+			case AbstractColumn::ColumnMode::Integer:
+				data.integers << column->snapshot<int>().data;
+				data.vectors << data.integers.constLast().constData();
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				data.bigInts << column->snapshot<qint64>().data;
+				data.vectors << data.bigInts.constLast().constData();
+				break;
+			case AbstractColumn::ColumnMode::Text:
+				if (numericOnly) {
+					DEBUG(Q_FUNC_INFO << ", skipping the non-numeric column " << STDSTRING(column->name()))
+					continue;
+				}
+				data.texts << column->snapshot<QString>().data;
+				data.vectors << data.texts.constLast().constData();
+				break;
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				if (numericOnly) {
+					DEBUG(Q_FUNC_INFO << ", skipping the non-numeric column " << STDSTRING(column->name()))
+					continue;
+				}
+				data.dateTimes << column->snapshot<QDateTime>().data;
+				data.vectors << data.dateTimes.constLast().constData();
+				format = static_cast<DateTime2StringFilter*>(column->outputFilter())->format();
+				break;
+			}
+
+			data.modes << mode;
+			data.names << column->name();
+			data.formats << format;
+			data.rowCounts << column->rowCount();
+			data.rows = std::min(data.rows, column->rowCount());
+		}
+	}
+
+	return data;
+}
+
+/*!
+ * writes the content of \c dataSource to the file \c fileName in a separate thread.
+ * The data is collected in the calling thread before, the worker only uses this copy of the data.
+ * The events of the calling thread, except the user input, are processed until the data is written
+ * so the GUI stays responsive and can show the progress reported with completed(). Live data sources
+ * are paused during the export.
+ * The filters not reimplementing writeExportData() write the data with write() in the calling thread.
+ * Errors are available via lastErrors() afterwards.
+ */
+void AbstractFileFilter::writeInBackground(const QString& fileName, AbstractDataSource* dataSource) {
+	auto* liveDataSource = dynamic_cast<LiveDataSource*>(dataSource);
+	const bool pause = liveDataSource && !liveDataSource->isPaused();
+	if (pause)
+		liveDataSource->pauseReading();
+
+	const auto data = exportData(dataSource, exportsNumericDataOnly());
+	QEventLoop loop;
+	QFutureWatcher<bool> watcher;
+	connect(&watcher, &QFutureWatcher<bool>::finished, &loop, &QEventLoop::quit);
+	watcher.setFuture(QtConcurrent::run([this, &fileName, &data]() {
+		return writeExportData(fileName, data);
+	}));
+	loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+	if (!watcher.result())
+		write(fileName, dataSource);
+
+	if (pause)
+		liveDataSource->continueReading();
+}
+
+/*!
+ * writes the data \c data collected with exportData() to the file \c fileName.
+ * Called in a separate thread in writeInBackground(), the filters supporting this reimplement this function.
+ * Returns \c false if the filter doesn't support it, the errors of supported writes are reported in lastErrors().
+ */
+bool AbstractFileFilter::writeExportData(const QString& /*fileName*/, const ExportData& /*data*/) {
+	DEBUG(Q_FUNC_INFO << ", writing in a separate thread not supported by the filter " << ENUM_TO_STRING(AbstractFileFilter, FileType, m_type))
+	return false;
+}
+
+/*!
+ * returns \c true if the filter only writes the numeric columns in writeExportData(),
+ * the text and date/time columns are not collected for the export then.
+ */
+bool AbstractFileFilter::exportsNumericDataOnly() const {
+	return true;
+}
@@ -13,6 +13,7 @@
 #define ABSTRACTFILEFILTER_H
 
 #include "backend/core/AbstractColumn.h"
+#include <QDateTime>
 #include <QLocale>
 #include <QObject>
 #include <memory> // smart pointer
@@ -28,7 +29,7 @@ class AbstractFileFilter : public QObject {
 	Q_ENUMS(ImportMode)
 
 public:
-	enum class FileType { Ascii, Binary, XLSX, Ods, Image, HDF5, NETCDF, FITS, JSON, ROOT, Spice, READSTAT, MATIO, VECTOR_BLF };
+	enum class FileType { Ascii, Binary, XLSX, Ods, Image, HDF5, NETCDF, FITS, JSON, ROOT, Spice, READSTAT, MATIO, VECTOR_BLF, SQL };
 	enum class ImportMode { Append, Prepend, Replace };
 
 	explicit AbstractFileFilter(FileType type)
@@ -45,8 +46,27 @@ public:
 	static QStringList fileTypes();
 	static QString convertFromNumberToColumn(int n);
 
+	// data of a spreadsheet or a matrix to be exported, see exportData()
+	struct ExportData {
+		QString name; // name of the data source
+		int rows{0}; // number of rows available in all columns
+		QVector<const void*> vectors; // data of the columns, owned by the copies below
+		QVector<AbstractColumn::ColumnMode> modes;
+		QStringList names;
+		QVector<int> rowCounts; // number of values in the columns
+		QStringList formats; // formats of the date/time columns, empty for the other columns
+		// implicitly shared copies of the column data, not affected by later changes of the columns
+		QVector<QVector<double>> doubles;
+		QVector<QVector<int>> integers;
+		QVector<QVector<qint64>> bigInts;
+		QVector<QVector<QString>> texts;
+		QVector<QVector<QDateTime>> dateTimes;
+	};
+	static ExportData exportData(AbstractDataSource*, bool numericOnly = true);
+
 	virtual void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, ImportMode = ImportMode::Replace) = 0;
 	virtual void write(const QString& fileName, AbstractDataSource*) = 0;
+	void writeInBackground(const QString& fileName, AbstractDataSource*);
 
 	virtual QStringList lastErrors();
 
@@ -62,6 +82,9 @@ Q_SIGNALS:
 	void completed(int) const; //!< int ranging from 0 to 100 notifies about the status of a read/write process
 
 protected:
+	virtual bool writeExportData(const QString& fileName, const ExportData&);
+	virtual bool exportsNumericDataOnly() const;
+
 	const FileType m_type;
 };
 
@@ -756,6 +756,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 			QDEBUG(Q_FUNC_INFO << ", column names = " << columnNames);
 			break;
 		case LiveDataSource::SourceType::MQTT:
+		case LiveDataSource::SourceType::Database:
 			break;
 		}
 
@@ -866,6 +867,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 					newData[newDataIdx++] = QString::fromUtf8(device.read(device.bytesAvailable()));
 					break;
 				case LiveDataSource::SourceType::MQTT:
+				case LiveDataSource::SourceType::Database:
 					break;
 				}
 			} else { // ReadingType::TillEnd
@@ -885,6 +887,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 					newData.push_back(QString::fromUtf8(device.read(device.bytesAvailable())));
 					break;
 				case LiveDataSource::SourceType::MQTT:
+				case LiveDataSource::SourceType::Database:
 					break;
 				}
 			}
@@ -1134,6 +1137,9 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 		}
 	}
 
+	// the rows before currentRow are unchanged if all values are kept, the values are shifted otherwise
+	const int firstChangedRow = (keepNValues == 0) ? currentRow : 0;
+
 	// from the last row we read the new data in the spreadsheet
 	DEBUG(Q_FUNC_INFO << ", reading from line " << currentRow << " till end line " << newLinesTillEnd);
 	DEBUG(Q_FUNC_INFO << ", lines to read:" << linesToRead << ", actual rows:" << m_actualRows << ", actual cols:" << m_actualCols);
@@ -1255,7 +1261,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 			plot->setSuppressRetransform(true);
 
 		for (int n = 0; n < m_actualCols; ++n)
-			spreadsheet->column(n)->setChanged();
+			spreadsheet->column(n)->setChanged(firstChangedRow);
 
 		// retransform the dependent plots
 		for (auto* plot : plots) {
@@ -1273,6 +1279,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 	reads the content of device \c device to the data source \c dataSource. Uses the settings defined in the data source.
 */
 void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 	DEBUG(Q_FUNC_INFO << ", dataSource = " << dataSource << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, importMode) << ", lines = " << lines);
 	DEBUG(Q_FUNC_INFO << ", start row: " << startRow)
 
@@ -1461,6 +1468,7 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 #endif
 
 	DEBUG(Q_FUNC_INFO << ", Read " << currentRow << " lines");
+	PERFTRACE_COUNTER("ASCII rows parsed", currentRow);
 
 	// we might have skipped empty lines above. shrink the spreadsheet if the number of read lines (=currentRow)
 	// is smaller than the initial size of the spreadsheet (=m_actualRows).
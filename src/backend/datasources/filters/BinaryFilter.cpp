@@ -9,22 +9,31 @@
 */
 #include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnStore.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/BinaryFilterPrivate.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KCompressionDevice>
 #include <KLocalizedString>
 #include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
 #include <QtEndian>
 #include <array>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <numeric>
 
 #define IMPORT_DATA(DATATYPE, TARGETTYPE)                                                                                                                      \
 	{                                                                                                                                                          \
 		DATATYPE value;                                                                                                                                        \
 		for (int n = startColumn; n < m_actualCols; ++n) {                                                                                                     \
-			for (size_t l = 0; l < std::min(readLines, mNumberLines); l++) {                                                                                   \
+			for (size_t l = 0; l < readLines; l++) {                                                                                                           \
 				const size_t lineNumber = l * lineBytes;                                                                                                       \
 				const size_t index = lineNumber + (n - startColumn) * typeSize;                                                                                \
 				if (byteOrder == QDataStream::BigEndian)                                                                                                       \
@@ -37,6 +46,63 @@
 		}                                                                                                                                                      \
 	}
 
+namespace {
+// converts \c count values of the type \c S with the distance of \c stride bytes in \c binary to \c values
+template<typename S, typename T>
+void readBinaryValues(const char* binary, int count, int stride, QDataStream::ByteOrder byteOrder, T* values) {
+	for (int i = 0; i < count; ++i) {
+		const char* value = binary + qint64(i) * stride;
+		values[i] = (byteOrder == QDataStream::BigEndian) ? qFromBigEndian<S>(value) : qFromLittleEndian<S>(value);
+	}
+}
+
+// converts the \c count values of a column in \c binary and writes them to the rows starting at \c row in \c store page by page
+template<typename S, typename T>
+void readBinaryColumn(ColumnStore* store, qint64 row, qint64 count, const char* binary, int stride, QDataStream::ByteOrder byteOrder) {
+	store->forEachPage<T>(row, count, [=](T* values, int size, qint64 firstRow) {
+		readBinaryValues<S>(binary + (firstRow - row) * stride, size, stride, byteOrder, values);
+	});
+}
+
+// converts \c count values of \c data to the type \c T and writes them with the distance of \c stride bytes to \c binary
+template<typename T, typename S>
+void writeBinaryValues(const S* data, int count, char* binary, int stride, QDataStream::ByteOrder byteOrder) {
+	for (int i = 0; i < count; ++i) {
+		T value;
+		if constexpr (std::is_integral<T>::value) // NAN and INF can't be represented as an integer
+			value = std::isfinite(static_cast<double>(data[i])) ? static_cast<T>(data[i]) : 0;
+		else
+			value = static_cast<T>(data[i]);
+
+		if (byteOrder == QDataStream::BigEndian)
+			qToBigEndian<T>(value, binary + i * stride);
+		else
+			qToLittleEndian<T>(value, binary + i * stride);
+	}
+}
+
+// writes the values [first, first + count) of the vector \c data with the mode \c mode as values of type \c T to \c binary
+template<typename T>
+void writeBinaryVector(const void* data, AbstractColumn::ColumnMode mode, int first, int count, char* binary, int stride, QDataStream::ByteOrder byteOrder) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		writeBinaryValues<T>(static_cast<const double*>(data) + first, count, binary, stride, byteOrder);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		writeBinaryValues<T>(static_cast<const int*>(data) + first, count, binary, stride, byteOrder);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		writeBinaryValues<T>(static_cast<const qint64*>(data) + first, count, binary, stride, byteOrder);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
+}
+
 /*!
 \class BinaryFilter
 \brief Manages the import/export of data organized as columns (vectors) from/to a binary file.
@@ -72,8 +138,16 @@ QVector<QStringList> BinaryFilter::preview(const QString& fileName, int lines) {
 writes the content of the data source \c dataSource to the file \c fileName.
 */
 void BinaryFilter::write(const QString& fileName, AbstractDataSource* dataSource) {
-	d->write(fileName, dataSource);
-	// 	emit()
+	d->write(fileName, exportData(dataSource));
+}
+
+bool BinaryFilter::writeExportData(const QString& fileName, const ExportData& data) {
+	d->write(fileName, data);
+	return true;
+}
+
+QStringList BinaryFilter::lastErrors() {
+	return d->errors;
 }
 
 /*!
@@ -104,17 +178,27 @@ size_t BinaryFilter::rowNumber(const QString& fileName, const size_t vectors, co
 	if (!device.open(QIODevice::ReadOnly))
 		return 0;
 
+	const size_t rowBytes = BinaryFilter::dataSize(type) * vectors;
+	if (rowBytes == 0)
+		return 0;
+
+	// the size of uncompressed files is known, a started last row is counted as a row
+	if (device.compressionType() == KCompressionDevice::None)
+		return std::min((static_cast<size_t>(QFileInfo(fileName).size()) + rowBytes - 1) / rowBytes, maxRows);
+
 	// size() and bytesAvailable() return 0 and data may be compressed. Need to read the file once
-	size_t rows = 0;
+	size_t bytes = 0;
+	QByteArray buffer(1 << 20, Qt::Uninitialized);
 	while (!device.atEnd()) {
-		if (rows >= maxRows) // stop when maxRows available
-			return rows;
-		// one row
-		device.read(BinaryFilter::dataSize(type) * vectors);
-		rows++;
+		const qint64 readBytes = device.read(buffer.data(), buffer.size());
+		if (readBytes <= 0)
+			break;
+		bytes += readBytes;
+		if (bytes / rowBytes >= maxRows) // stop when maxRows available
+			return maxRows;
 	}
 
-	return rows;
+	return (bytes + rowBytes - 1) / rowBytes;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -179,6 +263,18 @@ void BinaryFilter::setCreateIndexEnabled(bool b) {
 	d->createIndexEnabled = b;
 }
 
+/*!
+ * imports the values into memory mapped files in the cache directory instead of the memory (see Column::setOutOfCoreStorage()),
+ * the number of rows is not limited then. Only used when importing into a spreadsheet.
+ */
+void BinaryFilter::setOutOfCoreEnabled(bool b) {
+	d->outOfCoreEnabled = b;
+}
+
+bool BinaryFilter::isOutOfCoreEnabled() const {
+	return d->outOfCoreEnabled;
+}
+
 void BinaryFilter::setAutoModeEnabled(bool b) {
 	d->autoModeEnabled = b;
 }
@@ -208,10 +304,36 @@ BinaryFilterPrivate::BinaryFilterPrivate(BinaryFilter* owner)
 */
 void BinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	DEBUG(Q_FUNC_INFO);
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 
 	KCompressionDevice device(fileName);
-	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType);
+	if (device.compressionType() == KCompressionDevice::None) {
+		// uncompressed files are mapped into memory and the values are read from the mapped pages
+		// without copying them into a buffer first. Only the pages of the selected rows are loaded.
+		QFile file(fileName);
+		const qint64 size = file.size();
+		uchar* mapped = (size > 0 && file.open(QIODevice::ReadOnly)) ? file.map(0, size) : nullptr;
+		if (mapped) {
+			const qint64 rowBytes = BinaryFilter::dataSize(dataType) * vectors;
+			numRows = (rowBytes > 0) ? (size + rowBytes - 1) / rowBytes : 0;
+			if (prepareRange()) {
+				dataSource->clear();
+				return;
+			}
 
+			qint64 position = startOffset();
+			importData(dataSource, importMode, -1, [mapped, size, &position](qint64 maxBytes, qint64& readBytes) {
+				readBytes = std::max(qint64(0), std::min(maxBytes, size - position));
+				const char* data = reinterpret_cast<const char*>(mapped) + std::min(position, size);
+				position += readBytes;
+				return data;
+			});
+			file.unmap(mapped);
+			return;
+		}
+	}
+
+	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType);
 	if (!device.open(QIODevice::ReadOnly)) {
 		DEBUG("	could not open file " << STDSTRING(fileName));
 		return;
@@ -227,33 +349,41 @@ int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
 
 	in.setByteOrder(byteOrder);
 
-	// catch case that skipStartBytes or startRow is bigger than file
-	if (skipStartBytes >= BinaryFilter::dataSize(dataType) * vectors * numRows || startRow > (int)numRows)
+	if (prepareRange())
 		return 1;
 
-	// skip bytes at start
-	for (size_t i = 0; i < skipStartBytes; ++i) {
-		qint8 tmp;
-		in >> tmp;
-	}
+	// skip bytes at start and until start row
+	in.device()->skip(startOffset());
 
-	// skip until start row
-	for (size_t i = 0; i < (startRow - 1) * vectors; ++i) {
-		for (int j = 0; j < BinaryFilter::dataSize(dataType); ++j) {
-			qint8 tmp;
-			in >> tmp;
-		}
-	}
+	return 0;
+}
 
-	// set range of rows
-	if (endRow == -1)
-		m_actualRows = (int)numRows - startRow + 1;
-	else if (endRow > (int)numRows - startRow + 1)
-		m_actualRows = (int)numRows;
-	else
-		m_actualRows = endRow - startRow + 1;
+/*!
+ * determines the rows and columns to read from the number of rows \c numRows in the file.
+ * returns 1 if the selected data is empty and 0 otherwise.
+ * The selected rows beyond INT_MAX, the maximal number of rows of a column, are reported in \c errors.
+ */
+int BinaryFilterPrivate::prepareRange() {
+	errors.clear();
+
+	// catch case that skipStartBytes or startRow is bigger than file
+	if (skipStartBytes >= BinaryFilter::dataSize(dataType) * vectors * numRows || startRow > (int)std::min(numRows, size_t(INT_MAX)))
+		return 1;
+
+	// set range of rows, the number of rows of a column is limited to INT_MAX
+	const int rows = (int)std::min(numRows, size_t(INT_MAX));
+	if (endRow == -1) {
+		m_actualRows = rows - startRow + 1;
+		m_storeRows = qint64(numRows) - startRow + 1;
+	} else {
+		m_actualRows = std::min(endRow, rows) - startRow + 1;
+		m_storeRows = m_actualRows;
+	}
 	m_actualCols = (int)vectors;
 
+	if (endRow == -1 && numRows > size_t(INT_MAX) && !outOfCoreEnabled)
+		errors << i18n("The file contains %1 rows, only the rows up to %2 can be imported.", QString::number(numRows), QString::number(INT_MAX));
+
 	DEBUG("numRows = " << numRows);
 	DEBUG("endRow = " << endRow);
 	DEBUG("actual rows = " << m_actualRows);
@@ -262,6 +392,13 @@ int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
 	return 0;
 }
 
+/*!
+ * returns the position of the start row in the file.
+ */
+qint64 BinaryFilterPrivate::startOffset() const {
+	return skipStartBytes + qint64(startRow - 1) * vectors * BinaryFilter::dataSize(dataType);
+}
+
 /*!
 	reads \c lines lines of the device \c device and return as string for preview.
 */
@@ -400,6 +537,22 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 		return;
 	}
 
+	QByteArray buffer;
+	importData(dataSource, importMode, lines, [&device, &buffer](qint64 maxBytes, qint64& readBytes) {
+		buffer = device.read(maxBytes);
+		readBytes = buffer.size();
+		return buffer.constData();
+	});
+}
+
+/*!
+ * reads the values of the selected rows into the data source \c dataSource.
+ * \c read provides the next chunk of at most \c maxBytes bytes of the file and sets the number of provided bytes.
+ */
+void BinaryFilterPrivate::importData(AbstractDataSource* dataSource,
+									 AbstractFileFilter::ImportMode importMode,
+									 int lines,
+									 const std::function<const char*(qint64 maxBytes, qint64& readBytes)>& read) {
 	if (createIndexEnabled)
 		m_actualCols++;
 
@@ -435,6 +588,12 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 		columnModes[0] = AbstractColumn::ColumnMode::Integer;
 	}
 
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (outOfCoreEnabled && spreadsheet) {
+		importToStores(spreadsheet, importMode, lines, vectorNames, read);
+		return;
+	}
+
 	std::vector<void*> dataContainer;
 	int columnOffset = dataSource->prepareImport(dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes);
 
@@ -459,14 +618,15 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 	// chunk to read at once
 	const size_t mNumberLines = 100000; // see SpiceReader::mNumberLines
 	const int typeSize = BinaryFilter::dataSize(dataType);
-	const int lineBytes = m_actualCols * typeSize;
+	const int lineBytes = (m_actualCols - startColumn) * typeSize; // the index column is not in the file
 
 	// DEBUG("lines/mNumberLines = " << lines << "/" << mNumberLines << " -> " << lines/mNumberLines + 1)
 	for (size_t i = 0; i <= lines / mNumberLines; ++i) {
 		// DEBUG("reading chunk " << i + 1);
-		const QByteArray ba = device.read(mNumberLines * lineBytes);
-		const char* binary = ba.data();
-		const size_t readLines = (int)(ba.length() / lineBytes);
+		const size_t chunkLines = std::min(mNumberLines, lines - i * mNumberLines); // don't read beyond the end row
+		qint64 readBytes = 0;
+		const char* binary = read(chunkLines * lineBytes, readBytes);
+		const size_t readLines = readBytes / lineBytes;
 		// DEBUG("Read lines " << readLines)
 		switch (dataType) {
 		case BinaryFilter::DataType::INT8:
@@ -515,10 +675,189 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 }
 
 /*!
-	writes the content of \c dataSource to the file \c fileName.
+ * reads the values of the selected rows into memory mapped column stores (see ColumnStore) of the columns of \c spreadsheet,
+ * the values are written to the mapped pages directly and the number of rows is not limited to INT_MAX.
+ * At most \c lines lines are read if \c lines is not -1, \c read provides the chunks of the file like in importData().
+ */
+void BinaryFilterPrivate::importToStores(Spreadsheet* spreadsheet,
+										 AbstractFileFilter::ImportMode importMode,
+										 qint64 lines,
+										 const QStringList& vectorNames,
+										 const std::function<const char*(qint64 maxBytes, qint64& readBytes)>& read) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	if (lines != -1)
+		m_storeRows = std::min(m_storeRows, lines);
+	const int startColumn = createIndexEnabled ? 1 : 0;
+	if (createIndexEnabled)
+		columnModes[0] = AbstractColumn::ColumnMode::BigInt; // the index can exceed INT_MAX
+
+	std::vector<std::unique_ptr<ColumnStore>> stores;
+	for (int n = 0; n < m_actualCols; ++n) {
+		std::unique_ptr<ColumnStore> store(new ColumnStore(columnModes.at(n)));
+		if (!store->resize(m_storeRows, false)) {
+			errors << i18n("Failed to create the file for the values in the cache directory.");
+			return;
+		}
+		stores.push_back(std::move(store));
+	}
+
+	std::vector<void*> dataContainer;
+	const int columnOffset = spreadsheet->prepareImport(dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes, false);
+	if (columnOffset == -1)
+		return;
+	DEBUG(Q_FUNC_INFO << ", reading " << m_storeRows << " lines");
+
+	if (createIndexEnabled)
+		stores.at(0)->forEachPage<qint64>(0, m_storeRows, [](qint64* values, int size, qint64 firstRow) {
+			std::iota(values, values + size, firstRow + 1);
+		});
+
+	// chunk to read at once
+	const qint64 mNumberLines = 100000; // see importData()
+	const int typeSize = BinaryFilter::dataSize(dataType);
+	const int lineBytes = (m_actualCols - startColumn) * typeSize; // the index column is not in the file
+	int progress = 0;
+	qint64 row = 0;
+	while (row < m_storeRows) {
+		qint64 readBytes = 0;
+		const char* binary = read(std::min(mNumberLines, m_storeRows - row) * lineBytes, readBytes);
+		const qint64 readLines = readBytes / lineBytes;
+		if (readLines == 0)
+			break;
+
+		for (int n = startColumn; n < m_actualCols; ++n) {
+			auto* store = stores.at(n).get();
+			const char* values = binary + (n - startColumn) * typeSize;
+			switch (dataType) {
+			case BinaryFilter::DataType::INT8:
+				readBinaryColumn<qint8, int>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT16:
+				readBinaryColumn<qint16, int>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT32:
+				readBinaryColumn<qint32, int>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT64:
+				readBinaryColumn<qint64, qint64>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT8:
+				readBinaryColumn<quint8, int>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT16:
+				readBinaryColumn<quint16, int>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT32:
+				readBinaryColumn<quint32, qint64>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT64:
+				readBinaryColumn<quint64, double>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::REAL32:
+				readBinaryColumn<float, double>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::REAL64:
+				readBinaryColumn<double, double>(store, row, readLines, values, lineBytes, byteOrder);
+				break;
+			}
+		}
+		row += readLines;
+
+		// update the progress bar only in 1% steps
+		if (100 * row / m_storeRows > progress) {
+			progress = 100 * row / m_storeRows;
+			Q_EMIT q->completed(progress);
+			QApplication::processEvents(QEventLoop::AllEvents, 0);
+		}
+	}
+
+	for (int n = 0; n < m_actualCols; ++n) {
+		auto* store = stores.at(n).release();
+		if (row < m_storeRows) // the file ended before the end row
+			store->resize(row);
+		spreadsheet->column(columnOffset + n)->setStore(store);
+	}
+
+	spreadsheet->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
+}
+
+/*!
+	writes the numeric columns \c data of a spreadsheet or a matrix to the file \c fileName.
+	The values are written row by row (as expected by readDataFromDevice()) using the data type and the byte order of the filter.
 */
-void BinaryFilterPrivate::write(const QString& /*fileName*/, AbstractDataSource* /*dataSource*/) {
-	// TODO: writing binary files not supported yet
+void BinaryFilterPrivate::write(const QString& fileName, const AbstractFileFilter::ExportData& data) {
+	const auto& vectors = data.vectors;
+	const auto& modes = data.modes;
+	const int rows = data.rows;
+	const int cols = vectors.size();
+	DEBUG(Q_FUNC_INFO << ", rows/cols = " << rows << "/" << cols)
+	errors.clear();
+	if (rows == 0 || cols == 0)
+		return;
+
+	const int typeSize = BinaryFilter::dataSize(dataType);
+	if (qint64(cols) * typeSize > INT_MAX) {
+		errors << i18n("The rows of the data are too wide to be written.");
+		return;
+	}
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		errors << i18n("Failed to open the file '%1' for writing.", fileName) + QStringLiteral("\n") + file.errorString();
+		return;
+	}
+
+	// convert and write the data in chunks of at most 100000 rows (see readDataFromDevice())
+	// and at most 64 MiB, the size of the buffer has to fit into an int for wide tables too
+	const int lineBytes = cols * typeSize;
+	const int chunkRows = std::max(1, std::min(100000, 64 * 1024 * 1024 / lineBytes));
+	QByteArray ba;
+	for (int first = 0; first < rows; first += chunkRows) {
+		const int count = std::min(chunkRows, rows - first);
+		ba.resize(count * lineBytes); // at most 64 MiB or one line
+		for (int n = 0; n < cols; ++n) {
+			char* binary = ba.data() + n * typeSize;
+			switch (dataType) {
+			case BinaryFilter::DataType::INT8:
+				writeBinaryVector<qint8>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT16:
+				writeBinaryVector<qint16>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT32:
+				writeBinaryVector<qint32>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::INT64:
+				writeBinaryVector<qint64>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT8:
+				writeBinaryVector<quint8>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT16:
+				writeBinaryVector<quint16>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT32:
+				writeBinaryVector<quint32>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::UINT64:
+				writeBinaryVector<quint64>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::REAL32:
+				writeBinaryVector<float>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			case BinaryFilter::DataType::REAL64:
+				writeBinaryVector<double>(vectors.at(n), modes.at(n), first, count, binary, lineBytes, byteOrder);
+				break;
+			}
+		}
+
+		if (file.write(ba) != ba.size()) {
+			errors << i18n("Failed to write to the file '%1'.", fileName) + QStringLiteral("\n") + file.errorString();
+			return;
+		}
+
+		Q_EMIT q->completed(static_cast<int>(100. * (first + count) / rows));
+	}
 }
 
 // ##############################################################################
@@ -539,6 +878,7 @@ void BinaryFilter::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("skipStartBytes"), QString::number(d->skipStartBytes));
 	writer->writeAttribute(QStringLiteral("skipBytes"), QString::number(d->skipBytes));
 	writer->writeAttribute(QStringLiteral("createIndex"), QString::number(d->createIndexEnabled));
+	writer->writeAttribute(QStringLiteral("outOfCore"), QString::number(d->outOfCoreEnabled));
 	writer->writeEndElement();
 }
 
@@ -603,5 +943,10 @@ bool BinaryFilter::load(XmlStreamReader* reader) {
 	else
 		d->createIndexEnabled = str.toInt();
 
+	// not available in older projects
+	str = attribs.value(QStringLiteral("outOfCore")).toString();
+	if (!str.isEmpty())
+		d->outOfCoreEnabled = str.toInt();
+
 	return true;
 }
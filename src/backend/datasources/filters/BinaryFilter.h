@@ -38,6 +38,7 @@ public:
 	void readDataFromFile(const QString& fileName, AbstractDataSource*, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace) override;
 	void write(const QString& fileName, AbstractDataSource*) override;
 	QVector<QStringList> preview(const QString& fileName, int lines);
+	QStringList lastErrors() override;
 
 	void setVectors(const size_t);
 	size_t vectors() const;
@@ -55,6 +56,8 @@ public:
 	void setSkipBytes(const size_t);
 	size_t skipBytes() const;
 	void setCreateIndexEnabled(const bool);
+	void setOutOfCoreEnabled(const bool);
+	bool isOutOfCoreEnabled() const;
 
 	void setAutoModeEnabled(const bool);
 	bool isAutoModeEnabled() const;
@@ -62,6 +65,9 @@ public:
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*) override;
 
+protected:
+	bool writeExportData(const QString& fileName, const ExportData&) override;
+
 private:
 	std::unique_ptr<BinaryFilterPrivate> const d;
 	friend class BinaryFilterPrivate;
@@ -12,20 +12,34 @@
 
 #include <QVector>
 
+#include <functional>
+
 class AbstractDataSource;
 class AbstractColumn;
+class Spreadsheet;
 
 class BinaryFilterPrivate {
 public:
 	explicit BinaryFilterPrivate(BinaryFilter*);
 
 	int prepareStreamToRead(QDataStream&);
+	int prepareRange();
+	qint64 startOffset() const;
 	void readDataFromDevice(QIODevice& device,
 							AbstractDataSource* = nullptr,
 							AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 							int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
-	void write(const QString& fileName, AbstractDataSource*);
+	void importData(AbstractDataSource*,
+					AbstractFileFilter::ImportMode,
+					int lines,
+					const std::function<const char*(qint64 maxBytes, qint64& readBytes)>& read);
+	void importToStores(Spreadsheet*,
+						AbstractFileFilter::ImportMode,
+						qint64 lines,
+						const QStringList& vectorNames,
+						const std::function<const char*(qint64 maxBytes, qint64& readBytes)>& read);
+	void write(const QString& fileName, const AbstractFileFilter::ExportData&);
 	QVector<QStringList> preview(const QString& fileName, int lines);
 
 	const BinaryFilter* q;
@@ -41,11 +55,14 @@ public:
 	size_t skipStartBytes{0}; // bytes to skip at start
 	size_t skipBytes{0}; // bytes to skip after each value
 	bool createIndexEnabled{false}; // if create index column
+	bool outOfCoreEnabled{false}; // if the values are imported into memory mapped column stores, see ColumnStore
 
 	bool autoModeEnabled{true};
+	QStringList errors;
 
 private:
 	int m_actualRows{0};
+	qint64 m_storeRows{0}; // number of rows to read into the column stores, not limited to INT_MAX
 	int m_actualCols{0};
 };
 
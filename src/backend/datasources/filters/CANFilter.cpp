@@ -235,20 +235,21 @@ QVector<QStringList> CANFilterPrivate::preview(const QString& fileName, int line
 			if (!data_ptr)
 				continue;
 
+			// with separate time columns the columns have different lengths
 			switch (m_DataContainer.columnMode(c)) {
 			case AbstractColumn::ColumnMode::BigInt: {
-				const auto v = *static_cast<const QVector<qint64>*>(data_ptr);
-				l.append(QString::number(v.at(i)));
+				const auto* v = static_cast<const QVector<qint64>*>(data_ptr);
+				l.append(i < v->size() ? QString::number(v->at(i)) : QString());
 				break;
 			}
 			case AbstractColumn::ColumnMode::Integer: {
-				const auto v = *static_cast<const QVector<qint32>*>(data_ptr);
-				l.append(QString::number(v.at(i)));
+				const auto* v = static_cast<const QVector<qint32>*>(data_ptr);
+				l.append(i < v->size() ? QString::number(v->at(i)) : QString());
 				break;
 			}
 			case AbstractColumn::ColumnMode::Double: {
-				const auto v = *static_cast<const QVector<double>*>(data_ptr);
-				l.append(QString::number(v.at(i)));
+				const auto* v = static_cast<const QVector<double>*>(data_ptr);
+				l.append(i < v->size() ? QString::number(v->at(i)) : QString());
 				break;
 			}
 			// TODO: other cases
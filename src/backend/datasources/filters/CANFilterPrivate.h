@@ -81,6 +81,11 @@ protected:
 			static_cast<QVector<T>*>(m_dataContainer.at(indexDataContainer))->operator[](indexData) = value;
 		}
 
+		template<class T>
+		void append(int indexDataContainer, T value) {
+			static_cast<QVector<T>*>(m_dataContainer.at(indexDataContainer))->append(value);
+		}
+
 		template<class T>
 		T data(int indexDataContainer, int indexData) {
 			return static_cast<QVector<T>*>(m_dataContainer.at(indexDataContainer))->at(indexData);
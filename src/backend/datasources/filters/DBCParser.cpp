@@ -2,7 +2,6 @@
 
 #include <cmath>
 
-#include <QHash>
 #include <QStringList>
 
 DbcParser::ParseStatus DbcParser::isValid() {
@@ -49,59 +48,122 @@ DbcParser::ParseStatus DbcParser::parseMessage(const uint32_t id, const std::vec
 }
 
 /*!
- * \brief numberSignals
- * Determines the number of signals
- * \param ids Vector with all id's found in a log file
- * \return
+ * \brief compileMessage
+ * Compiles the decoder of the message with id \p id and appends the names and the value descriptions
+ * of its signals to \p out
+ * \return Success if the message is available in the dbc file and all signals can be decoded
  */
-void DbcParser::getSignals(const QVector<uint32_t> ids, PrefixType p, SuffixType s, QHash<uint32_t, int>& idIndex, Signals& out) const {
-	out.signal_names.clear();
-	out.value_descriptions.clear();
+DbcParser::ParseStatus DbcParser::compileMessage(uint32_t id, PrefixType p, SuffixType s, MessageDecoder& decoder, Signals& out) const {
+	decoder = MessageDecoder();
 #ifdef HAVE_DBC_PARSER
-	for (const auto id : ids) {
-		for (const auto& message : m_parser.get_messages()) {
-			if (message.id() == id) {
-				idIndex.insert(id, out.value_descriptions.size());
-				for (const auto& signal_ : message.getSignals()) {
-					std::string signal_name;
-					switch (p) {
-					case PrefixType::Message:
-						signal_name += message.name() + "_";
-						break;
-					case PrefixType::None:
-						break;
-					}
-
-					signal_name += signal_.name;
-
-					switch (s) {
-					case SuffixType::None:
-						break;
-					case SuffixType::Unit:
-						signal_name += "_" + signal_.unit;
-						break;
-					case SuffixType::UnitIfAvailable:
-						if (signal_.unit.size() != 0)
-							signal_name += "_" + signal_.unit;
-						break;
-					}
-					out.signal_names.append(QString::fromStdString(signal_name));
-					std::vector<ValueDescriptions> vd;
-					vd.reserve(signal_.svDescriptions.size());
-					for (const auto& svdescription : signal_.svDescriptions) {
-						vd.push_back({svdescription.value, QString::fromStdString(svdescription.description)});
-					}
-					out.value_descriptions.push_back({vd});
-				}
+	if (m_parseFileStatus != ParseStatus::Success) {
+		decoder.status = m_parseFileStatus;
+		return decoder.status;
+	}
+
+	for (const auto& message : m_parser.get_messages()) {
+		if (message.id() != id)
+			continue;
+
+		decoder.name = QString::fromStdString(message.name());
+		decoder.status = ParseStatus::Success;
+		for (const auto& signal_ : message.getSignals()) {
+			std::string signal_name;
+			switch (p) {
+			case PrefixType::Message:
+				signal_name += message.name() + "_";
+				break;
+			case PrefixType::None:
+				break;
+			}
+
+			signal_name += signal_.name;
+
+			switch (s) {
+			case SuffixType::None:
+				break;
+			case SuffixType::Unit:
+				signal_name += "_" + signal_.unit;
+				break;
+			case SuffixType::UnitIfAvailable:
+				if (signal_.unit.size() != 0)
+					signal_name += "_" + signal_.unit;
 				break;
 			}
+			out.signal_names.append(QString::fromStdString(signal_name));
+			std::vector<ValueDescriptions> vd;
+			vd.reserve(signal_.svDescriptions.size());
+			for (const auto& svdescription : signal_.svDescriptions) {
+				vd.push_back({svdescription.value, QString::fromStdString(svdescription.description)});
+			}
+			out.value_descriptions.push_back({vd});
+
+			SignalDecoder sd;
+			sd.size = signal_.size;
+			sd.mask = (sd.size >= 64) ? ~uint64_t(0) : (uint64_t(1) << sd.size) - 1;
+			sd.bigEndian = signal_.is_bigendian;
+			sd.isSigned = signal_.is_signed;
+			sd.factor = signal_.factor;
+			sd.offset = signal_.offset;
+
+			// position of the least significant bit in the 64 bit raw value of the message
+			uint32_t end;
+			if (sd.bigEndian) {
+				// the start bit of big endian (motorola) signals is the most significant bit
+				const uint32_t start = 8 * (signal_.start_bit / 8) + (7 - (signal_.start_bit % 8));
+				end = start + sd.size;
+				sd.shift = (end <= 64) ? 64 - end : 0;
+			} else {
+				end = signal_.start_bit + sd.size;
+				sd.shift = signal_.start_bit;
+			}
+			if (sd.size == 0 || end > 64)
+				decoder.status = ParseStatus::ErrorInvalidConversion;
+
+			decoder.signalDecoders.push_back(sd);
 		}
+		break;
 	}
 #else
-	Q_UNUSED(ids)
+	Q_UNUSED(id)
 	Q_UNUSED(p)
 	Q_UNUSED(s)
-	Q_UNUSED(idIndex)
 	Q_UNUSED(out)
+	decoder.status = ParseStatus::ErrorDBCParserUnsupported;
 #endif
+	return decoder.status;
+}
+
+/*!
+ * \brief decode
+ * Decodes the signals of the message \p data and writes the values to \p out
+ * \param out must provide space for signalDecoders.size() values
+ * \return
+ */
+DbcParser::ParseStatus DbcParser::MessageDecoder::decode(const std::vector<uint8_t>& data, double* out) const {
+	if (status != ParseStatus::Success)
+		return status;
+
+	const size_t size = data.size();
+	if (size > 8)
+		return ParseStatus::ErrorMessageToLong;
+
+	uint64_t rawLittleEndian = 0;
+	uint64_t rawBigEndian = 0;
+	for (size_t i = 0; i < size; i++) {
+		rawLittleEndian |= uint64_t(data[i]) << (8 * i);
+		rawBigEndian |= uint64_t(data[i]) << (56 - 8 * i);
+	}
+
+	for (const auto& sd : signalDecoders) {
+		uint64_t v = ((sd.bigEndian ? rawBigEndian : rawLittleEndian) >> sd.shift) & sd.mask;
+		if (sd.isSigned) {
+			// two's complement, extend the sign bit
+			if (sd.size < 64 && (v >> (sd.size - 1)) & 1)
+				v |= ~sd.mask;
+			*out++ = static_cast<int64_t>(v) * sd.factor + sd.offset;
+		} else
+			*out++ = v * sd.factor + sd.offset;
+	}
+	return ParseStatus::Success;
 }
@@ -49,13 +49,42 @@ public:
 		Unit // always _<Unit> even if Unit is empty
 	};
 
+	struct SignalDecoder {
+		uint32_t shift; // shift of the raw message value to get the signal in the least significant bits
+		uint64_t mask;
+		uint32_t size; // size of the signal in bits
+		bool bigEndian;
+		bool isSigned;
+		double factor;
+		double offset;
+	};
+
+	/*!
+	 * \brief The MessageDecoder struct
+	 * Decoding plan of a message compiled from the dbc description. The bit positions and masks
+	 * of all signals are determined once, decoding a message only requires shifting and masking.
+	 */
+	struct MessageDecoder {
+		QString name;
+		std::vector<SignalDecoder> signalDecoders;
+		ParseStatus status{ParseStatus::ErrorUnknownID};
+
+		/*!
+		 * \brief decode
+		 * Decodes the signals of the message \p data and writes the values to \p out
+		 * \param out must provide space for signalDecoders.size() values
+		 * \return
+		 */
+		ParseStatus decode(const std::vector<uint8_t>& data, double* out) const;
+	};
+
 	/*!
-	 * \brief numberSignals
-	 * Determines the number of signals
-	 * \param ids Vector with all id's found in a log file
-	 * \return
+	 * \brief compileMessage
+	 * Compiles the decoder of the message with id \p id and appends the names and the value descriptions
+	 * of its signals to \p out
+	 * \return Success if the message is available in the dbc file and all signals can be decoded
 	 */
-	void getSignals(const QVector<uint32_t> ids, PrefixType p, SuffixType s, QHash<uint32_t, int>& idIndex, Signals& out) const;
+	ParseStatus compileMessage(uint32_t id, PrefixType p, SuffixType s, MessageDecoder& decoder, Signals& out) const;
 
 private:
 	DbcParser::ParseStatus m_parseFileStatus{DbcParser::ParseStatus::ErrorDBCParserUnsupported};
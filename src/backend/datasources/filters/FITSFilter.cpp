@@ -16,6 +16,7 @@
 #include "backend/core/datatypes/Double2StringFilter.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/matrix/Matrix.h"
+#include "backend/matrix/MatrixBuffer.h"
 #include "backend/matrix/MatrixModel.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "commonfrontend/matrix/MatrixView.h"
@@ -24,6 +25,8 @@
 #include <QFile>
 #include <QMultiMap>
 
+#include <cmath>
+
 /*! \class FITSFilter
  * \brief Manages the import/export of data from/to a FITS file.
  * \since 2.2.0
@@ -239,6 +242,191 @@ FITSFilterPrivate::FITSFilterPrivate(FITSFilter* owner)
 	: q(owner) {
 }
 
+#ifdef HAVE_FITS
+namespace {
+// column of an ASCII or binary table
+struct TableColumn {
+	int index{0}; // column number in the table
+	int type{0}; // equivalent CFITSIO data type
+	long repeat{1};
+	long width{0}; // max. number of characters of a value
+	bool variableLength{false};
+	AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};
+	void* data{nullptr}; // data container of the target column
+};
+
+/*!
+ * column mode used for the values of \c column, only the genuine string and the non-numeric columns are imported as text.
+ */
+AbstractColumn::ColumnMode tableColumnMode(const TableColumn& column, int hduType) {
+	switch (column.type) {
+	case TBYTE:
+	case TSBYTE:
+	case TSHORT:
+	case TUSHORT:
+	case TINT:
+		return AbstractColumn::ColumnMode::Integer;
+	case TLONG:
+		// 32 bit integers in binary tables, integers of arbitrary width in ASCII tables
+		if (hduType == BINARY_TBL || column.width < 10)
+			return AbstractColumn::ColumnMode::Integer;
+		return AbstractColumn::ColumnMode::BigInt;
+	case TUINT:
+	case TULONG:
+	case TLONGLONG:
+		return AbstractColumn::ColumnMode::BigInt;
+	case TFLOAT:
+	case TDOUBLE:
+	case TULONGLONG:
+		return AbstractColumn::ColumnMode::Double;
+	default: // TSTRING, TLOGICAL, TBIT, TCOMPLEX, TDBLCOMPLEX
+		return AbstractColumn::ColumnMode::Text;
+	}
+}
+
+template<typename T>
+void resizeVector(void* data, long rows, bool replace) {
+	auto* vector = static_cast<QVector<T>*>(data);
+	if (replace)
+		vector->clear();
+	if (vector->size() < rows)
+		vector->resize(rows);
+}
+
+/*!
+ * resizes the data container of \c column so the values of \c rows rows can be written to it directly.
+ */
+void resizeContainer(const TableColumn& column, long rows, bool replace) {
+	switch (column.mode) {
+	case AbstractColumn::ColumnMode::Double:
+		resizeVector<double>(column.data, rows, replace);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		resizeVector<int>(column.data, rows, replace);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		resizeVector<qint64>(column.data, rows, replace);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		resizeVector<QString>(column.data, rows, replace);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
+
+/*!
+ * reads the first element of the cells of \c column in the rows \c firstRow ... \c firstRow + \c rows - 1
+ * as \c fitsType into \c out. Undefined values are set to \c nullValue.
+ */
+template<typename T>
+bool readValues(fitsfile* file, int fitsType, const TableColumn& column, long firstRow, long rows, T nullValue, T* out, int* status) {
+	if (column.variableLength) {
+		for (long i = 0; i < rows; ++i) {
+			if (fits_read_col(file, fitsType, column.index, firstRow + i, 1, 1, &nullValue, out + i, nullptr, status))
+				return false;
+		}
+		return true;
+	}
+
+	if (column.repeat == 1)
+		return !fits_read_col(file, fitsType, column.index, firstRow, 1, rows, &nullValue, out, nullptr, status);
+
+	// vector column, the elements of consecutive rows are read in one block
+	std::vector<T> buffer(rows * column.repeat);
+	if (fits_read_col(file, fitsType, column.index, firstRow, 1, rows * column.repeat, &nullValue, buffer.data(), nullptr, status))
+		return false;
+	for (long i = 0; i < rows; ++i)
+		out[i] = buffer[i * column.repeat];
+	return true;
+}
+
+bool readStrings(fitsfile* file, const TableColumn& column, long firstRow, long rows, QString* out, int* status) {
+	// number of strings in a cell of a binary table, only the first one is used
+	long elements = 1;
+	if (column.type == TSTRING) {
+		if (!column.variableLength && column.repeat > column.width && column.width > 0)
+			elements = column.repeat / column.width;
+	} else if (!column.variableLength)
+		elements = column.repeat;
+
+	const long width = std::max(column.width, static_cast<long>(FLEN_VALUE)) + 1;
+	const long count = column.variableLength ? 1 : rows * elements;
+	std::vector<char> buffer(count * width);
+	std::vector<char*> strings(count);
+	for (long i = 0; i < count; ++i)
+		strings[i] = buffer.data() + i * width;
+
+	for (long i = 0; i < rows; ++i) {
+		if (column.variableLength || i == 0) {
+			const long first = column.variableLength ? firstRow + i : firstRow;
+			if (fits_read_col_str(file, column.index, first, 1, count, nullptr, strings.data(), nullptr, status))
+				return false;
+		}
+
+		const char* value = column.variableLength ? strings[0] : strings[i * elements];
+		const QString str = QString::fromLatin1(value).simplified();
+		out[i] = str.isEmpty() ? QStringLiteral("NULL") : str;
+	}
+	return true;
+}
+
+/*!
+ * reads the block of \c rows rows starting at \c firstRow of \c column into its data container at \c offset.
+ */
+bool readBlock(fitsfile* file, const TableColumn& column, long firstRow, long rows, long offset, int* status) {
+	switch (column.mode) {
+	case AbstractColumn::ColumnMode::Double:
+		return readValues<double>(file, TDOUBLE, column, firstRow, rows, NAN, static_cast<QVector<double>*>(column.data)->data() + offset, status);
+	case AbstractColumn::ColumnMode::Integer:
+		return readValues<int>(file, TINT, column, firstRow, rows, 0, static_cast<QVector<int>*>(column.data)->data() + offset, status);
+	case AbstractColumn::ColumnMode::BigInt:
+		return readValues<LONGLONG>(file,
+									TLONGLONG,
+									column,
+									firstRow,
+									rows,
+									0,
+									reinterpret_cast<LONGLONG*>(static_cast<QVector<qint64>*>(column.data)->data() + offset),
+									status);
+	case AbstractColumn::ColumnMode::Text:
+		return readStrings(file, column, firstRow, rows, static_cast<QVector<QString>*>(column.data)->data() + offset, status);
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+	return true;
+}
+
+/*!
+ * reads the rows \c firstRow ... \c firstRow + \c rows - 1 of the table \c columns directly into the data containers
+ * of the columns. The values are read column by column with their native type in blocks of rows fitting into the CFITSIO buffers.
+ * Returns the CFITSIO status of the first failed read, 0 on success.
+ */
+int readTableColumns(fitsfile* file, const QVector<TableColumn>& columns, long firstRow, long rows) {
+	int status = 0;
+	if (columns.isEmpty() || rows <= 0)
+		return status;
+
+	long blockRows = 0;
+	if (fits_get_rowsize(file, &blockRows, &status))
+		return status;
+	blockRows = std::max(blockRows, 1L);
+
+	for (const auto& column : columns) {
+		for (long offset = 0; offset < rows; offset += blockRows) {
+			if (!readBlock(file, column, firstRow + offset, std::min(blockRows, rows - offset), offset, &status))
+				return status;
+		}
+	}
+	return status;
+}
+} // namespace
+#endif
+
 /*!
  * \brief Read the current header data unit from file \a filename in data source \a dataSource in \a importMode import mode
  * \param fileName the name of the file to be read
@@ -413,9 +601,7 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 
 		if (endRow != -1)
 			lines = endRow;
-		QVector<QVector<QString>*> stringDataPointers;
 		std::vector<void*> numericDataPointers;
-		QList<bool> columnNumericTypes;
 
 		int startCol = 0;
 		if (startColumn != 1)
@@ -424,62 +610,44 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 		if (startRow != 1)
 			startRrow = startRow;
 
-		columnNumericTypes.reserve(actualCols);
-		int datatype;
 		int c = 1;
 		if (startColumn != 1) {
 			if (startColumn != 0)
 				c = startColumn;
 		}
+		QVector<TableColumn> tableColumns;
+		tableColumns.reserve(actualCols - c + 1);
 		QList<int> matrixNumericColumnIndices;
 		for (; c <= actualCols; ++c) {
-			fits_get_coltype(m_fitsFile, c, &datatype, nullptr, nullptr, &status);
-
-			switch (datatype) {
-			case TSTRING:
-				columnNumericTypes.append(false);
-				break;
-			case TSHORT:
-				columnNumericTypes.append(true);
-				break;
-			case TLONG:
-				columnNumericTypes.append(true);
-				break;
-			case TFLOAT:
-				columnNumericTypes.append(true);
-				break;
-			case TDOUBLE:
-				columnNumericTypes.append(true);
-				break;
-			case TLOGICAL:
-				columnNumericTypes.append(false);
-				break;
-			case TBIT:
-				columnNumericTypes.append(true);
-				break;
-			case TBYTE:
-				columnNumericTypes.append(true);
-				break;
-			case TCOMPLEX:
-				columnNumericTypes.append(true);
-				break;
-			default:
-				columnNumericTypes.append(false);
-				break;
-			}
-			if ((datatype != TSTRING) && (datatype != TLOGICAL))
+			TableColumn column;
+			column.index = c;
+			// the equivalent type takes the scaling (TSCALn, TZEROn) of integer columns into account
+			fits_get_eqcoltype(m_fitsFile, c, &column.type, &column.repeat, &column.width, &status);
+			column.variableLength = (column.type < 0);
+			column.type = std::abs(column.type);
+			column.mode = tableColumnMode(column, chduType);
+			int displayWidth = 0;
+			fits_get_col_display_width(m_fitsFile, c, &displayWidth, &status);
+			column.width = std::max(column.width, static_cast<long>(displayWidth));
+			tableColumns << column;
+
+			if (column.mode != AbstractColumn::ColumnMode::Text)
 				matrixNumericColumnIndices.append(c);
 		}
 
+		int row = 1;
+		if (startRow != 1) {
+			if (startRow != 0)
+				row = startRow;
+		}
+		const long rowCount = std::max(0, lines - row + 1);
+
 		if (!dataSource)
 			*okToMatrix = matrixNumericColumnIndices.isEmpty() ? false : true;
 		else {
 			DEBUG("HAS DataSource");
 			auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
 			if (spreadsheet) {
-				numericDataPointers.reserve(actualCols - startCol);
-
-				stringDataPointers.reserve(actualCols - startCol);
 				spreadsheet->setUndoAware(false);
 				columnOffset = spreadsheet->resize(importMode, columnNames, actualCols - startCol);
 
@@ -491,82 +659,48 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 						spreadsheet->setRowCount(lines - startRrow);
 				}
 				DEBUG("Reading columns ...");
-				for (int n = 0; n < actualCols - startCol; ++n) {
-					if (columnNumericTypes.at(n)) {
-						spreadsheet->column(columnOffset + n)->setColumnMode(AbstractColumn::ColumnMode::Double);
-						auto* datap = static_cast<QVector<double>*>(spreadsheet->column(columnOffset + n)->data());
-						numericDataPointers.push_back(datap);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							datap->clear();
-					} else {
-						spreadsheet->column(columnOffset + n)->setColumnMode(AbstractColumn::ColumnMode::Text);
-						auto* list = static_cast<QVector<QString>*>(spreadsheet->column(columnOffset + n)->data());
-						stringDataPointers.push_back(list);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							list->clear();
-					}
+				for (int n = 0; n < tableColumns.size(); ++n) {
+					auto& tableColumn = tableColumns[n];
+					auto* column = spreadsheet->column(columnOffset + n);
+					column->setColumnMode(tableColumn.mode);
+					tableColumn.data = column->data();
+					resizeContainer(tableColumn, rowCount, importMode == AbstractFileFilter::ImportMode::Replace);
 				}
-				DEBUG("	... DONE");
-				stringDataPointers.squeeze();
 			} else {
 				numericDataPointers.reserve(matrixNumericColumnIndices.size());
 
 				columnOffset = dataSource->prepareImport(numericDataPointers, importMode, lines - startRrow, matrixNumericColumnIndices.size());
-			}
-		}
 
-		int row = 1;
-		if (startRow != 1) {
-			if (startRow != 0)
-				row = startRow;
-		}
+				// only the numeric columns are imported into the matrix, the values are read as double
+				QVector<TableColumn> matrixColumns;
+				for (auto& tableColumn : tableColumns) {
+					if (!matrixNumericColumnIndices.contains(tableColumn.index))
+						continue;
+					tableColumn.mode = AbstractColumn::ColumnMode::Double;
+					tableColumn.data = numericDataPointers.at(matrixColumns.size());
+					resizeContainer(tableColumn, rowCount, importMode == AbstractFileFilter::ImportMode::Replace);
+					matrixColumns << tableColumn;
+				}
+				tableColumns = matrixColumns;
+				actualCols = matrixNumericColumnIndices.last();
+			}
 
-		int coll = 1;
-		if (startColumn != 1) {
-			if (startColumn != 0)
-				coll = startColumn;
-		}
-		bool isMatrix = false;
-		if (dynamic_cast<Matrix*>(dataSource)) {
-			isMatrix = true;
-			coll = matrixNumericColumnIndices.first();
-			actualCols = matrixNumericColumnIndices.last();
-			if (importMode == AbstractFileFilter::ImportMode::Replace) {
-				for (auto* col : numericDataPointers)
-					static_cast<QVector<double>*>(col)->clear();
+			status = readTableColumns(m_fitsFile, tableColumns, row, rowCount);
+			if (status) {
+				printError(status);
+				status = 0;
 			}
 		}
 
-		char array[FLEN_VALUE];
-		char* tmpArr[1] = {array};
-		for (; row <= lines; ++row) {
-			int numericixd = 0;
-			int stringidx = 0;
-			QStringList line;
-			line.reserve(actualCols - coll);
-			for (int col = coll; col <= actualCols; ++col) {
-				if (isMatrix) {
-					if (!matrixNumericColumnIndices.contains(col))
-						continue;
-				}
-				if (fits_read_col_str(m_fitsFile, col, row, 1, 1, nullptr, tmpArr, nullptr, &status))
-					printError(status);
-				if (dataSource) {
-					QString str = QString::fromLatin1(array);
-					if (str.isEmpty()) {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(0);
-						else
-							stringDataPointers[stringidx++]->append(QLatin1String("NULL"));
-					} else {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(str.toDouble());
-						else {
-							if (!stringDataPointers.isEmpty())
-								stringDataPointers[stringidx++]->operator<<(str.simplified());
-						}
-					}
-				} else {
+		if (!dataSource) {
+			char array[FLEN_VALUE];
+			char* tmpArr[1] = {array};
+			for (; row <= lines; ++row) {
+				QStringList line;
+				line.reserve(tableColumns.size());
+				for (const auto& column : qAsConst(tableColumns)) {
+					if (fits_read_col_str(m_fitsFile, column.index, row, 1, 1, nullptr, tmpArr, nullptr, &status))
+						printError(status);
 					QString tmpColstr = QString::fromLatin1(array);
 					tmpColstr = tmpColstr.simplified();
 					if (tmpColstr.isEmpty())
@@ -574,9 +708,8 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 					else
 						line << tmpColstr;
 				}
-			}
-			if (!dataSource)
 				dataStrings << line;
+			}
 		}
 
 		if (dataSource)
@@ -638,11 +771,11 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 			}
 			const long nelem = naxes[0] * naxes[1];
 			double* const array = new double[nelem];
-			const QVector<QVector<double>>* const data = static_cast<QVector<QVector<double>>*>(matrix->data());
+			const auto* const data = static_cast<const MatrixBuffer<double>*>(matrix->data());
 
 			for (int col = 0; col < naxes[0]; ++col)
 				for (int row = 0; row < naxes[1]; ++row)
-					array[row * naxes[0] + col] = data->at(row).at(col);
+					array[row * naxes[0] + col] = data->at(row, col);
 
 			if (fits_write_img(m_fitsFile, TDOUBLE, 1, nelem, array, &status)) {
 				printError(status);
@@ -662,7 +795,7 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 			tform.resize(tfields);
 			tform.squeeze();
 			// TODO: mode
-			const QVector<QVector<double>>* const matrixData = static_cast<QVector<QVector<double>>*>(matrix->data());
+			const auto* const matrixData = static_cast<const MatrixBuffer<double>*>(matrix->data());
 			const MatrixModel* matrixModel = static_cast<MatrixView*>(matrix->view())->model();
 			const int precision = matrix->precision();
 			for (int i = 0; i < tfields; ++i) {
@@ -710,9 +843,8 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 
 			double* columnNumeric = new double[nrows];
 			for (int col = 1; col <= tfields; ++col) {
-				const QVector<double>& column = matrixData->at(col - 1);
-				for (int r = 0; r < column.size(); ++r)
-					columnNumeric[r] = column.at(r);
+				for (int r = 0; r < nrows; ++r)
+					columnNumeric[r] = matrixData->at(r, col - 1);
 
 				fits_write_col(m_fitsFile, TDOUBLE, col, 1, 1, nrows, columnNumeric, &status);
 				if (status) {
@@ -22,20 +22,17 @@
 
 #include <KLocalizedString>
 #include <QFile>
+#include <QMutex>
 #include <QProcess>
 #include <QStandardPaths>
 #include <QTreeWidgetItem>
 
 ///////////// macros ///////////////////////////////////////////////
-// type - data type
+// type - data type (preview only, data is read directly into the container otherwise)
 #define HDF5_READ_1D(type)                                                                                                                                     \
 	{                                                                                                                                                          \
-		for (int i = startRow - 1; i < std::min(endRow, lines + startRow - 1); ++i) {                                                                          \
-			if (dataContainer)                                                                                                                                 \
-				(*static_cast<QVector<type>*>(dataContainer))[i - startRow + 1] = data[i];                                                                     \
-			else /* for preview */                                                                                                                             \
-				dataString << QString::number(static_cast<type>(data[i]));                                                                                     \
-		}                                                                                                                                                      \
+		for (size_t i = 0; i < data.size(); ++i)                                                                                                               \
+			dataString << QString::number(static_cast<type>(data[i]));                                                                                         \
 	}
 // type - data type, ctype - container type
 #define HDF5_READ_VLEN_1D(type, ctype)                                                                                                                         \
@@ -57,21 +54,28 @@
 // type - data type
 #define HDF5_READ_2D(type)                                                                                                                                     \
 	{                                                                                                                                                          \
-		for (int i = startRow - 1; i < std::min(endRow, lines + startRow - 1); ++i) {                                                                          \
-			QStringList line;                                                                                                                                  \
-			line.reserve(endColumn - startColumn + 1);                                                                                                         \
-			for (int j = startColumn - 1; j < endColumn; ++j) {                                                                                                \
-				if (dataPointer[0])                                                                                                                            \
-					(*static_cast<QVector<type>*>(dataPointer[j - startColumn + 1]))[i - startRow + 1] = data[i][j];                                           \
-				else                                                                                                                                           \
-					line << QString::number(static_cast<type>(data[i][j]));                                                                                    \
+		for (hsize_t i = 0; i < count[0]; ++i) {                                                                                                               \
+			if (dataPointer[0]) {                                                                                                                              \
+				for (hsize_t j = 0; j < count[1]; ++j)                                                                                                         \
+					(*static_cast<QVector<type>*>(dataPointer[j]))[i] = data[i * count[1] + j];                                                                \
+			} else {                                                                                                                                           \
+				QStringList line;                                                                                                                              \
+				line.reserve(count[1]);                                                                                                                        \
+				for (hsize_t j = 0; j < count[1]; ++j)                                                                                                         \
+					line << QString::number(static_cast<type>(data[i * count[1] + j]));                                                                        \
+				dataStrings << line;                                                                                                                           \
 			}                                                                                                                                                  \
-			dataStrings << line;                                                                                                                               \
 		}                                                                                                                                                      \
 	}
 
 //////////////////////////////////////////////////////////////////////
 
+// the HDF5 library is not necessarily built thread-safe and the export is done in a separate thread,
+// serialize the reading and writing of the data
+static QMutex hdf5Mutex;
+
+//////////////////////////////////////////////////////////////////////
+
 /*!
 	\class HDF5Filter
 	\brief Manages the import/export of data from/to a HDF5 file.
@@ -97,6 +101,7 @@ int HDF5Filter::parse(const QString& fileName, QTreeWidgetItem* rootItem) {
 */
 QVector<QStringList>
 HDF5Filter::readCurrentDataSet(const QString& fileName, AbstractDataSource* dataSource, bool& ok, AbstractFileFilter::ImportMode importMode, int lines) {
+	QMutexLocker locker(&hdf5Mutex);
 	return d->readCurrentDataSet(fileName, dataSource, ok, importMode, lines);
 }
 
@@ -104,14 +109,37 @@ HDF5Filter::readCurrentDataSet(const QString& fileName, AbstractDataSource* data
   reads the content of the file \c fileName to the data source \c dataSource.
 */
 void HDF5Filter::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode mode) {
+	QMutexLocker locker(&hdf5Mutex);
 	d->readDataFromFile(fileName, dataSource, mode);
 }
 
+/*!
+  reads the rows of the current data set that were added to the file \c fileName since the last read
+  to the live data source \c dataSource. \c from is the number of rows read so far.
+  Returns the number of rows read in total.
+*/
+qint64 HDF5Filter::readFromLiveFile(const QString& fileName, AbstractDataSource* dataSource, qint64 from) {
+	QMutexLocker locker(&hdf5Mutex);
+	return d->readFromLiveFile(fileName, dataSource, from);
+}
+
 /*!
 writes the content of the data source \c dataSource to the file \c fileName.
 */
 void HDF5Filter::write(const QString& fileName, AbstractDataSource* dataSource) {
-	d->write(fileName, dataSource);
+	const auto data = exportData(dataSource);
+	QMutexLocker locker(&hdf5Mutex);
+	d->write(fileName, data);
+}
+
+bool HDF5Filter::writeExportData(const QString& fileName, const ExportData& data) {
+	QMutexLocker locker(&hdf5Mutex);
+	d->write(fileName, data);
+	return true;
+}
+
+QStringList HDF5Filter::lastErrors() {
+	return d->errors;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -157,6 +185,17 @@ int HDF5Filter::endColumn() const {
 	return d->endColumn;
 }
 
+/*!
+  sets the deflate compression level (0 - 9) used when writing data sets, 0 disables the compression.
+*/
+void HDF5Filter::setCompressionLevel(const int level) {
+	d->compressionLevel = level;
+}
+
+int HDF5Filter::compressionLevel() const {
+	return d->compressionLevel;
+}
+
 QString HDF5Filter::fileInfoString(const QString& fileName) {
 	DEBUG(Q_FUNC_INFO);
 	QString info;
@@ -393,6 +432,25 @@ void HDF5FilterPrivate::handleError(int err, const QString& function, const QStr
 #endif
 }
 
+/*!
+ * opens the file \c fileName for reading. Files currently written in SWMR mode (single writer, multiple readers)
+ * can only be opened for SWMR reading, this is tried if opening the file the usual way fails.
+ */
+hid_t HDF5FilterPrivate::openHDF5File(const QString& fileName) {
+	hid_t file;
+	H5E_BEGIN_TRY {
+		file = H5Fopen(qPrintable(fileName), H5F_ACC_RDONLY, H5P_DEFAULT);
+	}
+	H5E_END_TRY;
+#ifdef H5F_ACC_SWMR_READ
+	if (file < 0)
+		file = H5Fopen(qPrintable(fileName), H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, H5P_DEFAULT);
+#endif
+	handleError((int)file, QStringLiteral("H5Fopen"), fileName);
+
+	return file;
+}
+
 QString HDF5FilterPrivate::translateHDF5Order(H5T_order_t o) {
 	QString order;
 	switch (o) {
@@ -546,31 +604,124 @@ QStringList HDF5FilterPrivate::readHDF5Compound(hid_t tid) {
 	return dataString;
 }
 
+/*!
+ * selects \c count[0] rows starting at row \c offset[0] (and \c count[1] columns starting at column \c offset[1] for rank 2 data)
+ * in the file space of \c dataset. Returns the file space and sets \c memspace to a matching contiguous memory space.
+ * Both have to be closed by the caller.
+ */
+hid_t HDF5FilterPrivate::selectHDF5Hyperslab(hid_t dataset, const hsize_t* offset, const hsize_t* count, hid_t& memspace) {
+	hid_t filespace = H5Dget_space(dataset);
+	handleError((int)filespace, QStringLiteral("H5Dget_space"));
+	const int rank = std::min(H5Sget_simple_extent_ndims(filespace), 2);
+	handleError(rank, QStringLiteral("H5Sget_simple_extent_ndims"));
+
+	m_status = H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+	handleError(m_status, QStringLiteral("H5Sselect_hyperslab"));
+	memspace = H5Screate_simple(rank, count, nullptr);
+	handleError((int)memspace, QStringLiteral("H5Screate_simple"));
+
+	return filespace;
+}
+
+/*!
+ * returns \c true if the integer type \c dtype is imported into a BigInt column:
+ * 64bit integers and unsigned 32bit integers whose values don't fit into int.
+ */
+bool HDF5FilterPrivate::isBigIntHDF5Type(hid_t dtype) {
+	if (H5Tget_class(dtype) != H5T_INTEGER)
+		return false;
+
+	const size_t size = H5Tget_size(dtype);
+	return size == 8 || (size == 4 && H5Tget_sign(dtype) == H5T_SGN_NONE);
+}
+
+/*!
+ * returns the memory type of the column container used for data of type \c dtype:
+ * 64bit and unsigned 32bit integers are imported as BigInt, other integers as Integer and everything else as Double.
+ * For compound types (with one member) a compound type with the converted member is returned
+ * that has to be closed by the caller.
+ */
+hid_t HDF5FilterPrivate::containerHDF5Type(hid_t dtype) {
+	switch (H5Tget_class(dtype)) {
+	case H5T_INTEGER:
+		if (isBigIntHDF5Type(dtype))
+			return H5T_NATIVE_LLONG;
+		return H5T_NATIVE_INT;
+	case H5T_COMPOUND: {
+		char* name = H5Tget_member_name(dtype, 0);
+		hid_t ctype = H5Tcreate(H5T_COMPOUND, sizeof(double));
+		handleError((int)ctype, QStringLiteral("H5Tcreate"));
+		m_status = H5Tinsert(ctype, name, 0, H5T_NATIVE_DOUBLE);
+		handleError(m_status, QStringLiteral("H5Tinsert"));
+		H5free_memory(name);
+		return ctype;
+	}
+	case H5T_FLOAT:
+	case H5T_TIME:
+	case H5T_STRING:
+	case H5T_BITFIELD:
+	case H5T_OPAQUE:
+	case H5T_REFERENCE:
+	case H5T_ENUM:
+	case H5T_VLEN:
+	case H5T_ARRAY:
+	case H5T_NO_CLASS:
+	case H5T_NCLASSES:
+		break;
+	}
+
+	return H5T_NATIVE_DOUBLE;
+}
+
 template<typename T>
 QStringList HDF5FilterPrivate::readHDF5Data1D(hid_t dataset, hid_t dtype, int rows, int lines, void* dataContainer) {
 	DEBUG(Q_FUNC_INFO << ", rows = " << rows << ", lines = " << lines);
-	QStringList dataString;
-
-	// we read all rows of data
-	T* data = new T[rows];
-
-	m_status = H5Dread(dataset, dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-	handleError(m_status, QStringLiteral("H5Dread"));
 	DEBUG(Q_FUNC_INFO << ", startRow = " << startRow << ", endRow = " << endRow);
 	DEBUG(Q_FUNC_INFO << ", dataContainer = " << dataContainer);
+	QStringList dataString;
 
-	H5T_class_t dclass = H5Tget_class(dtype);
-	handleError((int)dclass, QStringLiteral("H5Dget_class"));
-	if (dclass == H5T_INTEGER) {
-		if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG) || H5Tequal(dtype, H5T_STD_U64LE)
-			|| H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG)) {
-			HDF5_READ_1D(qint64);
+	// only read the selected rows
+	const int lastRow = std::min({endRow, lines + startRow - 1, rows});
+	if (lastRow < startRow)
+		return dataString;
+	const hsize_t offset[1] = {(hsize_t)startRow - 1};
+	const hsize_t count[1] = {(hsize_t)(lastRow - startRow + 1)};
+	hid_t memspace;
+	hid_t filespace = selectHDF5Hyperslab(dataset, offset, count, memspace);
+
+	if (dataContainer) {
+		// read directly into the column data, the conversion to the container type is done by the library
+		const hid_t ctype = containerHDF5Type(dtype);
+		void* buffer;
+		if (ctype == H5T_NATIVE_LLONG)
+			buffer = static_cast<QVector<qint64>*>(dataContainer)->data();
+		else if (ctype == H5T_NATIVE_INT)
+			buffer = static_cast<QVector<int>*>(dataContainer)->data();
+		else
+			buffer = static_cast<QVector<double>*>(dataContainer)->data();
+
+		m_status = H5Dread(dataset, ctype, memspace, filespace, H5P_DEFAULT, buffer);
+		handleError(m_status, QStringLiteral("H5Dread"));
+		if (H5Tget_class(ctype) == H5T_COMPOUND)
+			H5Tclose(ctype);
+	} else { // preview
+		std::vector<T> data(count[0]);
+		m_status = H5Dread(dataset, dtype, memspace, filespace, H5P_DEFAULT, data.data());
+		handleError(m_status, QStringLiteral("H5Dread"));
+
+		H5T_class_t dclass = H5Tget_class(dtype);
+		handleError((int)dclass, QStringLiteral("H5Dget_class"));
+		if (dclass == H5T_INTEGER) {
+			if (isBigIntHDF5Type(dtype)) {
+				HDF5_READ_1D(qint64);
+			} else
+				HDF5_READ_1D(int);
 		} else
-			HDF5_READ_1D(int);
-	} else
-		HDF5_READ_1D(double);
+			HDF5_READ_1D(double);
+	}
 
-	delete[] data;
+	H5Sclose(memspace);
+	H5Sclose(filespace);
 
 	return dataString;
 }
@@ -582,9 +733,12 @@ QStringList HDF5FilterPrivate::readHDF5CompoundData1D(hid_t dataset, hid_t tid,
 	handleError(members, QStringLiteral("H5Tget_nmembers"));
 	// DEBUG(" # members = " << members);
 
+	// number of selected rows
+	const int previewRows = std::max(std::min({endRow, lines + startRow - 1, rows}) - startRow + 1, 0);
+
 	QStringList dataString;
 	if (preview) {
-		for (int i = 0; i < std::min(rows, lines); ++i)
+		for (int i = 0; i < previewRows; ++i)
 			dataString << QStringLiteral("(");
 		dataContainer.resize(members); // avoid "index out of range" for preview
 	}
@@ -662,7 +816,7 @@ QStringList HDF5FilterPrivate::readHDF5CompoundData1D(hid_t dataset, hid_t tid,
 				for (int row = startRow - 1; row < std::min(endRow, lines + startRow - 1); ++row)
 					static_cast<QVector<double>*>(dataContainer[m])->operator[](row - startRow + 1) = 0;
 			} else {
-				for (int i = 0; i < std::min(rows, lines); ++i)
+				for (int i = 0; i < previewRows; ++i)
 					mdataString << QStringLiteral("_");
 			}
 			H5T_class_t mclass = H5Tget_member_class(tid, m);
@@ -671,7 +825,7 @@ QStringList HDF5FilterPrivate::readHDF5CompoundData1D(hid_t dataset, hid_t tid,
 		}
 
 		if (preview) {
-			for (int i = 0; i < std::min(rows, lines); ++i) {
+			for (int i = 0; i < previewRows; ++i) {
 				dataString[i] += mdataString[i];
 				if (m < members - 1)
 					dataString[i] += QLatin1String(",");
@@ -682,7 +836,7 @@ QStringList HDF5FilterPrivate::readHDF5CompoundData1D(hid_t dataset, hid_t tid,
 	}
 
 	if (preview) {
-		for (int i = 0; i < std::min(rows, lines); ++i)
+		for (int i = 0; i < previewRows; ++i)
 			dataString[i] += QLatin1String(")");
 	}
 
@@ -694,32 +848,32 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5Data2D(hid_t dataset, hid_t dtyp
 	DEBUG(Q_FUNC_INFO << ", rows = " << rows << ", cols = " << cols << ", lines = " << lines);
 	QVector<QStringList> dataStrings;
 
-	if (rows == 0 || cols == 0)
+	// only read the selected block of rows and columns
+	const int lastRow = std::min({endRow, lines + startRow - 1, rows});
+	const int lastColumn = std::min(endColumn, cols);
+	if (lastRow < startRow || lastColumn < startColumn)
 		return dataStrings;
+	const hsize_t offset[2] = {(hsize_t)startRow - 1, (hsize_t)startColumn - 1};
+	const hsize_t count[2] = {(hsize_t)(lastRow - startRow + 1), (hsize_t)(lastColumn - startColumn + 1)};
+	hid_t memspace;
+	hid_t filespace = selectHDF5Hyperslab(dataset, offset, count, memspace);
 
-	// read all data
-	T** data = (T**)malloc(rows * sizeof(T*));
-	data[0] = (T*)malloc(cols * rows * sizeof(T));
-	for (int i = 1; i < rows; ++i)
-		data[i] = data[0] + i * cols;
-
-	m_status = H5Dread(dataset, dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0][0]);
+	std::vector<T> data(count[0] * count[1]);
+	m_status = H5Dread(dataset, dtype, memspace, filespace, H5P_DEFAULT, data.data());
 	handleError(m_status, QStringLiteral("H5Dread"));
+	H5Sclose(memspace);
+	H5Sclose(filespace);
 
 	H5T_class_t dclass = H5Tget_class(dtype);
 	handleError((int)dclass, QStringLiteral("H5Dget_class"));
 	if (dclass == H5T_INTEGER) {
-		if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG) || H5Tequal(dtype, H5T_STD_U64LE)
-			|| H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG)) {
+		if (isBigIntHDF5Type(dtype)) {
 			HDF5_READ_2D(qint64);
 		} else
 			HDF5_READ_2D(int);
 	} else
 		HDF5_READ_2D(double);
 
-	free(data[0]);
-	free(data);
-
 	// QDEBUG(dataStrings);
 	return dataStrings;
 }
@@ -731,10 +885,14 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5CompoundData2D(hid_t dataset, hi
 	handleError(members, QStringLiteral("H5Tget_nmembers"));
 	DEBUG(" # members =" << members);
 
+	// size of the selected block
+	const int previewRows = std::max(std::min({endRow, lines + startRow - 1, rows}) - startRow + 1, 0);
+	const int previewCols = std::max(std::min(endColumn, cols) - startColumn + 1, 0);
+
 	QVector<QStringList> dataStrings;
-	for (int i = 0; i < std::min(rows, lines); ++i) {
+	for (int i = 0; i < previewRows; ++i) {
 		QStringList lineStrings;
-		for (int j = 0; j < cols; ++j)
+		for (int j = 0; j < previewCols; ++j)
 			lineStrings << QStringLiteral("(");
 		dataStrings << lineStrings;
 	}
@@ -811,9 +969,9 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5CompoundData2D(hid_t dataset, hi
 		else if (H5Tequal(mtype, H5T_NATIVE_LDOUBLE))
 			mdataStrings = readHDF5Data2D<long double>(dataset, ctype, rows, cols, lines, dummy);
 		else {
-			for (int i = 0; i < std::min(rows, lines); ++i) {
+			for (int i = 0; i < previewRows; ++i) {
 				QStringList lineString;
-				for (int j = 0; j < cols; ++j)
+				for (int j = 0; j < previewCols; ++j)
 					lineString << QStringLiteral("_");
 				mdataStrings << lineString;
 			}
@@ -826,8 +984,8 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5CompoundData2D(hid_t dataset, hi
 		m_status = H5Tclose(ctype);
 		handleError(m_status, QStringLiteral("H5Tclose"));
 
-		for (int i = 0; i < std::min(rows, lines); i++) {
-			for (int j = 0; j < cols; j++) {
+		for (int i = 0; i < previewRows; i++) {
+			for (int j = 0; j < previewCols; j++) {
 				dataStrings[i][j] += mdataStrings[i][j];
 				if (m < members - 1)
 					dataStrings[i][j] += QStringLiteral(",");
@@ -835,8 +993,8 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5CompoundData2D(hid_t dataset, hi
 		}
 	}
 
-	for (int i = 0; i < std::min(rows, lines); ++i) {
-		for (int j = 0; j < cols; ++j)
+	for (int i = 0; i < previewRows; ++i) {
+		for (int j = 0; j < previewCols; ++j)
 			dataStrings[i][j] += QStringLiteral(")");
 	}
 
@@ -1517,8 +1675,7 @@ HDF5FilterPrivate::readCurrentDataSet(const QString& fileName, AbstractDataSourc
 	DEBUG(Q_FUNC_INFO << ", current data set = " << STDSTRING(currentDataSetName));
 
 #ifdef HAVE_HDF5
-	hid_t file = H5Fopen(qPrintable(fileName), H5F_ACC_RDONLY, H5P_DEFAULT);
-	handleError((int)file, QStringLiteral("H5Fopen"), fileName);
+	hid_t file = openHDF5File(fileName);
 	hid_t dataset = H5Dopen2(file, qPrintable(currentDataSetName), H5P_DEFAULT);
 	handleError((int)file, QStringLiteral("H5Dopen2"), currentDataSetName);
 
@@ -1612,8 +1769,7 @@ HDF5FilterPrivate::readCurrentDataSet(const QString& fileName, AbstractDataSourc
 			for (auto& mode : columnModes)
 				mode = AbstractColumn::ColumnMode::Text;
 		else if (dclass == H5T_INTEGER) {
-			if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG) || H5Tequal(dtype, H5T_STD_U64LE)
-				|| H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG))
+			if (isBigIntHDF5Type(dtype))
 				for (auto& mode : columnModes)
 					mode = AbstractColumn::ColumnMode::BigInt;
 			else
@@ -1632,29 +1788,41 @@ HDF5FilterPrivate::readCurrentDataSet(const QString& fileName, AbstractDataSourc
 		switch (dclass) {
 		case H5T_STRING: {
 			DEBUG("rank 1 H5T_STRING");
+			// only read the selected rows
+			const int lastRow = std::min({endRow, lines + startRow - 1, rows});
+			const hsize_t offset[1] = {(hsize_t)startRow - 1};
+			const hsize_t count[1] = {(hsize_t)std::max(lastRow - startRow + 1, 0)};
+			if (count[0] == 0) // empty range, nothing to read
+				break;
+
 			hid_t memtype = H5Tcopy(H5T_C_S1);
 			handleError((int)memtype, QStringLiteral("H5Tcopy"));
 
-			char** data = (char**)malloc(rows * sizeof(char*));
+			hid_t memspace;
+			hid_t filespace = selectHDF5Hyperslab(dataset, offset, count, memspace);
+
+			char** data = (char**)malloc(count[0] * sizeof(char*));
 
 			if (H5Tis_variable_str(dtype)) {
 				m_status = H5Tset_size(memtype, H5T_VARIABLE);
 				handleError((int)memtype, QStringLiteral("H5Tset_size"));
-				m_status = H5Dread(dataset, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+				m_status = H5Dread(dataset, memtype, memspace, filespace, H5P_DEFAULT, data);
 				handleError(m_status, QStringLiteral("H5Dread"));
 			} else {
-				data[0] = (char*)malloc(rows * typeSize * sizeof(char));
-				for (int i = 1; i < rows; ++i)
+				data[0] = (char*)malloc(count[0] * typeSize * sizeof(char));
+				for (hsize_t i = 1; i < count[0]; ++i)
 					data[i] = data[0] + i * typeSize;
 
 				m_status = H5Tset_size(memtype, typeSize);
 				handleError((int)memtype, QStringLiteral("H5Tset_size"));
 
-				m_status = H5Dread(dataset, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, data[0]);
+				m_status = H5Dread(dataset, memtype, memspace, filespace, H5P_DEFAULT, data[0]);
 				handleError(m_status, QStringLiteral("H5Dread"));
 			}
+			H5Sclose(memspace);
+			H5Sclose(filespace);
 
-			for (int i = startRow - 1; i < std::min(endRow, lines + startRow - 1); ++i)
+			for (hsize_t i = 0; i < count[0]; ++i)
 				dataString << QLatin1String(data[i]);
 
 			free(data);
@@ -1919,8 +2087,7 @@ HDF5FilterPrivate::readCurrentDataSet(const QString& fileName, AbstractDataSourc
 			for (auto& mode : columnModes)
 				mode = AbstractColumn::ColumnMode::Text;
 		else if (dclass == H5T_INTEGER) {
-			if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG) || H5Tequal(dtype, H5T_STD_U64LE)
-				|| H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG))
+			if (isBigIntHDF5Type(dtype))
 				for (auto& mode : columnModes)
 					mode = AbstractColumn::ColumnMode::BigInt;
 			else
@@ -2131,10 +2298,217 @@ void HDF5FilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 }
 
 /*!
-	writes the content of \c dataSource to the file \c fileName.
+	reads the rows of the current data set added since the last read to the live data source \c dataSource.
+	Numeric data sets of rank 1 and 2 growing in the first dimension are read incrementally, i.e. only
+	the new rows [\c from, current extent) are read directly into the columns. All other data sets,
+	the very first read and data sets that got smaller than \c from (e.g. the file was replaced)
+	are imported completely. Returns the number of rows read in total.
 */
-void HDF5FilterPrivate::write(const QString& /*fileName*/, AbstractDataSource* /*dataSource*/) {
-	// TODO: writing HDF5 not implemented yet
+qint64 HDF5FilterPrivate::readFromLiveFile(const QString& fileName, AbstractDataSource* dataSource, qint64 from) {
+	DEBUG(Q_FUNC_INFO << ", from = " << from);
+	auto* source = dynamic_cast<LiveDataSource*>(dataSource);
+	if (!source || currentDataSetName.isEmpty())
+		return from;
+
+#ifdef HAVE_HDF5
+	hid_t file = openHDF5File(fileName);
+	if (file < 0)
+		return from;
+	hid_t dataset = H5Dopen2(file, qPrintable(currentDataSetName), H5P_DEFAULT);
+	handleError((int)dataset, QStringLiteral("H5Dopen2"), currentDataSetName);
+	if (dataset < 0) {
+		H5Fclose(file);
+		return from;
+	}
+
+	hid_t dtype = H5Dget_type(dataset);
+	handleError((int)dtype, QStringLiteral("H5Dget_type"));
+	const H5T_class_t dclass = H5Tget_class(dtype);
+	H5Tclose(dtype);
+	hid_t dataspace = H5Dget_space(dataset);
+	handleError((int)dataspace, QStringLiteral("H5Dget_space"));
+	const int rank = H5Sget_simple_extent_ndims(dataspace);
+	hsize_t dims[2] = {0, 0};
+	if (rank == 1 || rank == 2) {
+		m_status = H5Sget_simple_extent_dims(dataspace, dims, nullptr);
+		handleError(m_status, QStringLiteral("H5Sget_simple_extent_dims"));
+	}
+	H5Sclose(dataspace);
+	const auto extent = (qint64)dims[0];
+	DEBUG(Q_FUNC_INFO << ", current extent = " << extent)
+
+	const bool incremental = (rank == 1 || rank == 2) && (dclass == H5T_INTEGER || dclass == H5T_FLOAT);
+	if (from == 0 || extent < from || !incremental || source->columnCount() == 0) {
+		H5Dclose(dataset);
+		H5Fclose(file);
+
+		// initial import of the data set, only the last N values if a fixed number of values is kept.
+		// the row range set by the user is restored afterwards, it's saved in the project
+		const int userStartRow = startRow;
+		const int userEndRow = endRow;
+		const int keepNValues = source->keepNValues();
+		if (incremental && keepNValues > 0)
+			startRow = std::max(startRow, (int)extent - keepNValues + 1);
+		endRow = -1; // read until the current end of the data set
+		bool ok = true;
+		readCurrentDataSet(fileName, dataSource, ok);
+		startRow = userStartRow;
+		endRow = userEndRow;
+		return extent;
+	}
+
+	if (extent > from) {
+		qint64 first;
+		int count;
+		const int row = source->prepareLiveRows(from, extent, first, count);
+		DEBUG(Q_FUNC_INFO << ", reading " << count << " rows starting at row " << first)
+
+		// read the new rows of every column directly into the column data, block by block
+		const auto& columns = source->children<Column>();
+		for (int c = 0; c < columns.size(); ++c) {
+			auto* column = columns.at(c);
+			hid_t mtype;
+			switch (column->columnMode()) {
+			case AbstractColumn::ColumnMode::Integer:
+				mtype = H5T_NATIVE_INT;
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				mtype = H5T_NATIVE_LLONG;
+				break;
+			case AbstractColumn::ColumnMode::Double:
+				mtype = H5T_NATIVE_DOUBLE;
+				break;
+			case AbstractColumn::ColumnMode::Text:
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				continue;
+			}
+
+			for (const auto& chunk : column->dataChunks(row, count)) {
+				const hsize_t offset[2] = {(hsize_t)(first + chunk.firstRow - row), (hsize_t)(startColumn - 1 + c)};
+				const hsize_t counts[2] = {(hsize_t)chunk.size, 1};
+				hid_t memspace;
+				hid_t filespace = selectHDF5Hyperslab(dataset, offset, counts, memspace);
+				m_status = H5Dread(dataset, mtype, memspace, filespace, H5P_DEFAULT, chunk.values);
+				handleError(m_status, QStringLiteral("H5Dread"));
+				H5Sclose(memspace);
+				H5Sclose(filespace);
+			}
+		}
+
+		source->finalizeLiveRows();
+		from = first + count;
+	}
+
+	H5Dclose(dataset);
+	H5Fclose(file);
+#else
+	Q_UNUSED(fileName)
+#endif
+
+	return from;
+}
+
+/*!
+	writes the numeric columns \c data of a spreadsheet or a matrix as a two-dimensional data set
+	named after the data source to the file \c fileName. The data is written column by column directly from
+	the column data into a chunked data set that is deflate compressed if a compression level is set.
+*/
+void HDF5FilterPrivate::write(const QString& fileName, const AbstractFileFilter::ExportData& data) {
+	errors.clear();
+#ifdef HAVE_HDF5
+	const auto& vectors = data.vectors;
+	const auto& modes = data.modes;
+	const int rows = data.rows;
+	const int cols = vectors.size();
+	DEBUG(Q_FUNC_INFO << ", rows/cols = " << rows << "/" << cols << ", compression level = " << compressionLevel)
+	if (rows == 0 || cols == 0)
+		return;
+
+	// type of the data set: double if there is any double column, the largest integer type otherwise
+	hid_t ftype = H5T_STD_I32LE;
+	if (modes.contains(AbstractColumn::ColumnMode::Double))
+		ftype = H5T_IEEE_F64LE;
+	else if (modes.contains(AbstractColumn::ColumnMode::BigInt))
+		ftype = H5T_STD_I64LE;
+
+	hid_t file = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	handleError((int)file, QStringLiteral("H5Fcreate"), fileName);
+	if (file < 0) {
+		errors << i18n("Failed to create the HDF5 file '%1'.", fileName);
+		return;
+	}
+
+	const hsize_t dims[2] = {(hsize_t)rows, (hsize_t)cols};
+	hid_t dataspace = H5Screate_simple(2, dims, nullptr);
+	handleError((int)dataspace, QStringLiteral("H5Screate_simple"));
+
+	// chunks of consecutive rows of one column matching the column-wise writing below
+	hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+	const hsize_t chunk[2] = {std::min((hsize_t)rows, (hsize_t)65536), 1};
+	m_status = H5Pset_chunk(plist, 2, chunk);
+	handleError(m_status, QStringLiteral("H5Pset_chunk"));
+	if (compressionLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+		m_status = H5Pset_shuffle(plist);
+		handleError(m_status, QStringLiteral("H5Pset_shuffle"));
+		m_status = H5Pset_deflate(plist, std::min(compressionLevel, 9));
+		handleError(m_status, QStringLiteral("H5Pset_deflate"));
+	}
+
+	QString name = data.name;
+	name.replace(QLatin1Char('/'), QLatin1Char('_'));
+	hid_t dataset = H5Dcreate2(file, qPrintable(name), ftype, dataspace, H5P_DEFAULT, plist, H5P_DEFAULT);
+	handleError((int)dataset, QStringLiteral("H5Dcreate2"), name);
+	if (dataset < 0)
+		errors << i18n("Failed to create the data set '%1'.", name);
+	else {
+		const hsize_t count[2] = {(hsize_t)rows, 1};
+		hid_t memspace = H5Screate_simple(1, count, nullptr);
+		handleError((int)memspace, QStringLiteral("H5Screate_simple"));
+		for (int c = 0; c < cols; ++c) {
+			const hsize_t offset[2] = {0, (hsize_t)c};
+			m_status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+			handleError(m_status, QStringLiteral("H5Sselect_hyperslab"));
+
+			// the library converts the values of the column to the type of the data set
+			hid_t mtype = H5T_NATIVE_DOUBLE;
+			switch (modes.at(c)) {
+			case AbstractColumn::ColumnMode::Integer:
+				mtype = H5T_NATIVE_INT;
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				mtype = H5T_NATIVE_LLONG;
+				break;
+			case AbstractColumn::ColumnMode::Double:
+			case AbstractColumn::ColumnMode::Text:
+			case AbstractColumn::ColumnMode::DateTime:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::Day:
+				break;
+			}
+			m_status = H5Dwrite(dataset, mtype, memspace, dataspace, H5P_DEFAULT, vectors.at(c));
+			handleError(m_status, QStringLiteral("H5Dwrite"));
+			if (m_status < 0) {
+				errors << i18n("Failed to write the column '%1' to the data set '%2'.", data.names.at(c), name);
+				break;
+			}
+
+			Q_EMIT q->completed(static_cast<int>(100. * (c + 1) / cols));
+		}
+		H5Sclose(memspace);
+		H5Dclose(dataset);
+	}
+
+	H5Pclose(plist);
+	H5Sclose(dataspace);
+	if (H5Fclose(file) < 0)
+		errors << i18n("Failed to write the HDF5 file '%1'.", fileName);
+#else
+	Q_UNUSED(fileName)
+	Q_UNUSED(data)
+	errors << i18n("HDF5 support is not available.");
+#endif
 }
 
 // ##############################################################################
@@ -2146,12 +2520,52 @@ void HDF5FilterPrivate::write(const QString& /*fileName*/, AbstractDataSource* /
  */
 void HDF5Filter::save(QXmlStreamWriter* writer) const {
 	writer->writeStartElement(QStringLiteral("hdfFilter"));
+	writer->writeAttribute(QStringLiteral("dataSet"), d->currentDataSetName);
+	writer->writeAttribute(QStringLiteral("startRow"), QString::number(d->startRow));
+	writer->writeAttribute(QStringLiteral("endRow"), QString::number(d->endRow));
+	writer->writeAttribute(QStringLiteral("startColumn"), QString::number(d->startColumn));
+	writer->writeAttribute(QStringLiteral("endColumn"), QString::number(d->endColumn));
 	writer->writeEndElement();
 }
 
 /*!
   Loads from XML.
 */
-bool HDF5Filter::load(XmlStreamReader*) {
+bool HDF5Filter::load(XmlStreamReader* reader) {
+	QString attributeWarning = i18n("Attribute '%1' missing or empty, default value is used");
+	QXmlStreamAttributes attribs = reader->attributes();
+
+	// projects created with older versions don't have any attributes
+	if (attribs.isEmpty())
+		return true;
+
+	d->currentDataSetName = attribs.value(QStringLiteral("dataSet")).toString();
+	if (d->currentDataSetName.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("dataSet")));
+
+	QString str = attribs.value(QStringLiteral("startRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startRow")));
+	else
+		d->startRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("endRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endRow")));
+	else
+		d->endRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("startColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startColumn")));
+	else
+		d->startColumn = str.toInt();
+
+	str = attribs.value(QStringLiteral("endColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endColumn")));
+	else
+		d->endColumn = str.toInt();
+
 	return true;
 }
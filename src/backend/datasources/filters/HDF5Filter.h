@@ -32,7 +32,9 @@ public:
 											bool& ok,
 											AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 											int lines = -1);
+	qint64 readFromLiveFile(const QString& fileName, AbstractDataSource*, qint64 from = 0);
 	void write(const QString& fileName, AbstractDataSource*) override;
+	QStringList lastErrors() override;
 
 	void setCurrentDataSetName(const QString&);
 	const QString currentDataSetName() const;
@@ -45,10 +47,15 @@ public:
 	int startColumn() const;
 	void setEndColumn(const int);
 	int endColumn() const;
+	void setCompressionLevel(const int);
+	int compressionLevel() const;
 
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*) override;
 
+protected:
+	bool writeExportData(const QString& fileName, const ExportData&) override;
+
 private:
 	std::unique_ptr<HDF5FilterPrivate> const d;
 	friend class HDF5FilterPrivate;
@@ -27,12 +27,13 @@ public:
 
 	int parse(const QString& fileName, QTreeWidgetItem* rootItem);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	qint64 readFromLiveFile(const QString& fileName, AbstractDataSource*, qint64 from);
 	QVector<QStringList> readCurrentDataSet(const QString& fileName,
 											AbstractDataSource*,
 											bool& ok,
 											AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 											int lines = -1);
-	void write(const QString& fileName, AbstractDataSource*);
+	void write(const QString& fileName, const AbstractFileFilter::ExportData&);
 
 	const HDF5Filter* q;
 
@@ -41,6 +42,8 @@ public:
 	int endRow{-1};
 	int startColumn{1};
 	int endColumn{-1};
+	int compressionLevel{0}; // deflate compression level used for the export (0 - no compression)
+	QStringList errors; // errors of the last export
 
 private:
 #ifdef HAVE_HDF5
@@ -51,10 +54,14 @@ private:
 	QList<unsigned long> m_multiLinkList; // used to find hard links
 
 #ifdef HAVE_HDF5
+	hid_t openHDF5File(const QString& fileName);
 	QString translateHDF5Order(H5T_order_t);
 	QString translateHDF5Type(hid_t);
 	QString translateHDF5Class(H5T_class_t);
 	AbstractColumn::ColumnMode translateHDF5TypeToMode(hid_t);
+	hid_t selectHDF5Hyperslab(hid_t dataset, const hsize_t* offset, const hsize_t* count, hid_t& memspace);
+	static bool isBigIntHDF5Type(hid_t dtype);
+	hid_t containerHDF5Type(hid_t dtype);
 	QStringList readHDF5Compound(hid_t tid);
 	template<typename T>
 	QStringList readHDF5Data1D(hid_t dataset, hid_t type, int rows, int lines, void* dataPointer = nullptr);
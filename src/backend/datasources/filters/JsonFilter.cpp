@@ -13,6 +13,7 @@
 #include "backend/core/column/Column.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/JsonFilterPrivate.h"
+#include "backend/datasources/filters/JsonReader.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -25,9 +26,14 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QTemporaryFile>
 
 #include <cmath>
 
+namespace {
+const int schemaRows = 100; // number of rows used to determine the column modes when importing
+}
+
 /*!
 \class JsonFilter
 \brief Manages the import/export of data from/to a file formatted using JSON.
@@ -191,24 +197,27 @@ QString JsonFilter::fileInfoString(const QString& fileName) {
 	if (device.atEnd() && !device.isSequential())
 		return i18n("Empty file");
 
-	QJsonParseError err;
-	QJsonDocument doc = QJsonDocument::fromJson(device.readAll(), &err);
-
-	if (err.error != QJsonParseError::NoError || doc.isEmpty())
-		return i18n("Parse error: %1 at offset %2", err.errorString(), err.offset);
-
-	QString info;
-	info += i18n("Valid JSON document");
+	// the records are only scanned, not parsed
+	JsonReader reader(device);
+	int count = 0;
+	if (reader.open()) {
+		while (reader.readNext())
+			++count;
+	}
 
-	// TODO: get number of object, etc.
-	// if (prepareDocumentToRead(doc) != 0)
-	//	return info;
+	if (reader.hasError())
+		return i18n("Parse error: %1", reader.errorString());
 
-	// reset to start of file
-	if (!device.isSequential())
-		device.seek(0);
+	switch (reader.format()) {
+	case JsonReader::Format::Array:
+		return i18n("Valid JSON document") + QStringLiteral("<br>") + i18n("Array with %1 elements", count);
+	case JsonReader::Format::Object:
+		return i18n("Valid JSON document") + QStringLiteral("<br>") + i18n("Object with %1 members", count);
+	case JsonReader::Format::Lines:
+		return i18n("Newline delimited JSON") + QStringLiteral("<br>") + i18n("%1 records", count);
+	}
 
-	return info;
+	return {};
 }
 
 // #####################################################################
@@ -221,7 +230,7 @@ JsonFilterPrivate::JsonFilterPrivate(JsonFilter* owner)
 /*!
 returns 1 if row is invalid and 0 otherwise.
 */
-int JsonFilterPrivate::checkRow(QJsonValueRef value, int& countCols) {
+int JsonFilterPrivate::checkRow(const QJsonValue& value, int& countCols) {
 	switch (rowType) {
 	// TODO: implement other value types
 	case QJsonValue::Array: {
@@ -235,7 +244,9 @@ int JsonFilterPrivate::checkRow(QJsonValueRef value, int& countCols) {
 		QJsonObject row = value.toObject();
 		if (row.isEmpty())
 			return 1;
-		countCols = (countCols == -1 || countCols > row.count()) ? row.count() : countCols;
+		// the columns are given by the members of the first row, the members of the other rows are looked up by their names
+		if (countCols == -1)
+			countCols = row.count();
 		break;
 	}
 	case QJsonValue::Double:
@@ -250,8 +261,9 @@ int JsonFilterPrivate::checkRow(QJsonValueRef value, int& countCols) {
 
 /*!
 returns -1 if a parse error has occurred, 1 if the current row type not supported and 0 otherwise.
+The mode of a column is determined by the first value in \c rows that is not null.
 */
-int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& rowName) {
+int JsonFilterPrivate::parseColumnModes(const QVector<QJsonValue>& rows, const QString& rowName) {
 	columnModes.clear();
 	vectorNames.clear();
 
@@ -275,19 +287,18 @@ int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& ro
 			vectorNames << i18n("name");
 	}
 
+	if (rows.isEmpty())
+		return 1;
+
 	// determine the column modes and names
 	for (int i = startColumn - 1; i < endColumn; ++i) {
-		QJsonValue columnValue;
 		switch (rowType) {
-		case QJsonValue::Array: {
-			columnValue = *(row.toArray().begin() + i);
+		case QJsonValue::Array:
 			vectorNames << i18n("Column %1", QString::number(i + 1));
 			break;
-		}
 		case QJsonValue::Object: {
-			QString key = row.toObject().keys().at(i);
-			vectorNames << key;
-			columnValue = row.toObject().value(key);
+			const auto object = rows.constFirst().toObject();
+			vectorNames << (object.constBegin() + i).key();
 			break;
 		}
 		// TODO: implement other value types
@@ -299,6 +310,19 @@ int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& ro
 			return 1;
 		}
 
+		QJsonValue columnValue;
+		for (const auto& row : rows) {
+			if (rowType == QJsonValue::Array) {
+				const auto array = row.toArray();
+				if (i < array.count())
+					columnValue = array.at(i);
+			} else
+				columnValue = row.toObject().value(vectorNames.constLast());
+
+			if (!columnValue.isNull() && !columnValue.isUndefined())
+				break;
+		}
+
 		switch (columnValue.type()) {
 		case QJsonValue::Double:
 			columnModes << AbstractColumn::ColumnMode::Double;
@@ -306,11 +330,13 @@ int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& ro
 		case QJsonValue::String:
 			columnModes << AbstractFileFilter::columnMode(columnValue.toString(), dateTimeFormat, numberFormat);
 			break;
+		case QJsonValue::Null:
+		case QJsonValue::Undefined: // no values in the first rows
+			columnModes << AbstractColumn::ColumnMode::Double;
+			break;
 		case QJsonValue::Array:
 		case QJsonValue::Object:
 		case QJsonValue::Bool:
-		case QJsonValue::Null:
-		case QJsonValue::Undefined:
 			return -1;
 		}
 	}
@@ -342,23 +368,22 @@ void JsonFilterPrivate::setEmptyValue(int column, int row) {
 }
 
 void JsonFilterPrivate::setValueFromString(int column, int row, const QString& valueString) {
-	QLocale locale(numberFormat);
 	switch (columnModes.at(column)) {
 	case AbstractColumn::ColumnMode::Double: {
 		bool isNumber;
-		const double value = locale.toDouble(valueString, &isNumber);
+		const double value = m_locale.toDouble(valueString, &isNumber);
 		static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : nanValue;
 		break;
 	}
 	case AbstractColumn::ColumnMode::Integer: {
 		bool isNumber;
-		const int value = locale.toInt(valueString, &isNumber);
+		const int value = m_locale.toInt(valueString, &isNumber);
 		static_cast<QVector<int>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
 		break;
 	}
 	case AbstractColumn::ColumnMode::BigInt: {
 		bool isNumber;
-		const qint64 value = locale.toLongLong(valueString, &isNumber);
+		const qint64 value = m_locale.toLongLong(valueString, &isNumber);
 		static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
 		break;
 	}
@@ -376,6 +401,130 @@ void JsonFilterPrivate::setValueFromString(int column, int row, const QString& v
 	}
 }
 
+/*!
+writes the values of the JSON row \c value with the name \c rowName to the row \c row of the data containers.
+*/
+void JsonFilterPrivate::importRow(int row, const QJsonValue& value, const QString& rowName) {
+	if (createIndexEnabled)
+		static_cast<QVector<int>*>(m_dataContainer[0])->operator[](row) = row + 1;
+
+	if (importObjectNames && containerType == JsonFilter::DataContainerType::Object)
+		setValueFromString((int)createIndexEnabled, row, rowName);
+
+	QJsonArray array;
+	QJsonObject object;
+	int count = 0;
+	switch (rowType) {
+	case QJsonValue::Array:
+		array = value.toArray();
+		count = array.count();
+		break;
+	case QJsonValue::Object:
+		object = value.toObject();
+		break;
+	// TODO: implement other value types
+	case QJsonValue::Double:
+	case QJsonValue::String:
+	case QJsonValue::Bool:
+	case QJsonValue::Null:
+	case QJsonValue::Undefined:
+		break;
+	}
+
+	const int colOffset = (int)createIndexEnabled + (int)importObjectNames;
+	for (int n = 0; n < m_actualCols - colOffset; ++n) {
+		const int column = colOffset + n;
+		const int index = n + startColumn - 1;
+
+		// rows after the first rows used to determine the structure can be shorter or have other members
+		QJsonValue columnValue;
+		if (rowType == QJsonValue::Array) {
+			if (index < count)
+				columnValue = array.at(index);
+		} else
+			columnValue = object.value(vectorNames.at(column));
+
+		switch (columnValue.type()) {
+		case QJsonValue::Double:
+			if (columnModes.at(column) == AbstractColumn::ColumnMode::Double)
+				static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = columnValue.toDouble();
+			else
+				setEmptyValue(column, row);
+			break;
+		case QJsonValue::String:
+			setValueFromString(column, row, columnValue.toString());
+			break;
+		case QJsonValue::Array:
+		case QJsonValue::Object:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			setEmptyValue(column, row);
+			break;
+		}
+	}
+}
+
+/*!
+returns the preview strings of the JSON row \c value with the name \c rowName.
+*/
+QStringList JsonFilterPrivate::previewRow(int row, const QJsonValue& value, const QString& rowName) const {
+	QStringList lineString;
+	if (createIndexEnabled)
+		lineString += QString::number(row + 1);
+	if (importObjectNames)
+		lineString += rowName;
+
+	const auto array = value.toArray();
+	const auto object = value.toObject();
+	const int colOffset = (int)createIndexEnabled + (int)importObjectNames;
+	for (int n = startColumn - 1; n < endColumn; ++n) {
+		QJsonValue columnValue;
+		switch (rowType) {
+		case QJsonValue::Object:
+			columnValue = object.value(vectorNames.at(colOffset + n - startColumn + 1));
+			break;
+		case QJsonValue::Array:
+			if (n < array.count())
+				columnValue = array.at(n);
+			break;
+		// TODO: implement other value types
+		case QJsonValue::Double:
+		case QJsonValue::String:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			break;
+		}
+
+		switch (columnValue.type()) {
+		case QJsonValue::Double:
+			lineString += QString::number(columnValue.toDouble(), 'g', 16);
+			break;
+		case QJsonValue::String:
+			lineString += columnValue.toString();
+			break;
+		case QJsonValue::Array:
+		case QJsonValue::Object:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			lineString += QString();
+			break;
+		}
+	}
+
+	return lineString;
+}
+
+/*!
+returns \c true if the data can be read record by record without building the full JSON document,
+i.e. if no part of the document was selected in the document model.
+*/
+bool JsonFilterPrivate::streamingEnabled() const {
+	return modelRows.size() <= 1;
+}
+
 /*!
 returns -1 if the device couldn't be opened, 1 if the current read position in the device is at the end
 */
@@ -388,6 +537,10 @@ int JsonFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 	if (device.atEnd() && !device.isSequential()) // empty file
 		return 1;
 
+	// the records are parsed one by one in prepareStreamToRead() and importData()
+	if (streamingEnabled())
+		return 0;
+
 	QJsonParseError err;
 	m_doc = QJsonDocument::fromJson(device.readAll(), &err);
 
@@ -408,11 +561,12 @@ int JsonFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 bool JsonFilterPrivate::prepareDocumentToRead() {
 	PERFTRACE(QStringLiteral("Prepare the JSON document to read"));
 
+	QJsonDocument preparedDoc;
 	if (modelRows.isEmpty())
-		m_preparedDoc = m_doc;
+		preparedDoc = m_doc;
 	else {
 		if (modelRows.size() == 1)
-			m_preparedDoc = m_doc; // root element selected, use the full document
+			preparedDoc = m_doc; // root element selected, use the full document
 		else {
 			// when running tests there is no ImportFileWidget and JsonOptionsWidget available
 			// where the model is created and also passed to JsonFilter. So, we need to create
@@ -426,14 +580,14 @@ bool JsonFilterPrivate::prepareDocumentToRead() {
 			for (auto& it : modelRows)
 				index = model->index(it, 0, index);
 
-			m_preparedDoc = model->genJsonByIndex(index);
+			preparedDoc = model->genJsonByIndex(index);
 		}
 	}
 
-	if (!m_preparedDoc.isEmpty()) {
-		if (m_preparedDoc.isArray())
+	if (!preparedDoc.isEmpty()) {
+		if (preparedDoc.isArray())
 			containerType = JsonFilter::DataContainerType::Array;
-		else if (m_preparedDoc.isObject())
+		else if (preparedDoc.isObject())
 			containerType = JsonFilter::DataContainerType::Object;
 		else
 			return false;
@@ -442,53 +596,134 @@ bool JsonFilterPrivate::prepareDocumentToRead() {
 
 	int countRows = 0;
 	int countCols = -1;
-	QJsonValue firstRow;
-	QString firstRowName;
+	m_rows.clear();
+	m_rowNames.clear();
 	importObjectNames = (importObjectNames && (rowType == QJsonValue::Object));
 
 	switch (containerType) {
 	case JsonFilter::DataContainerType::Array: {
-		QJsonArray arr = m_preparedDoc.array();
+		QJsonArray arr = preparedDoc.array();
 		int count = arr.count();
 
 		if (count < startRow)
 			return false;
 
 		int endRowOffset = (endRow == -1 || endRow > count) ? count : endRow;
-		firstRow = *(arr.begin() + (startRow - 1));
 		for (QJsonArray::iterator it = arr.begin() + (startRow - 1); it != arr.begin() + endRowOffset; ++it) {
 			if (checkRow(*it, countCols) != 0)
 				return false;
+			m_rows << *it;
+			m_rowNames << QString();
 			countRows++;
 		}
 		break;
 	}
 	case JsonFilter::DataContainerType::Object: {
-		QJsonObject obj = m_preparedDoc.object();
+		QJsonObject obj = preparedDoc.object();
 
 		if (obj.count() < startRow)
 			return false;
 
 		int startRowOffset = startRow - 1;
 		int endRowOffset = (endRow == -1 || endRow > obj.count()) ? obj.count() : endRow;
-		firstRow = *(obj.begin() + startRowOffset);
-		firstRowName = (obj.begin() + startRowOffset).key();
 		for (QJsonObject::iterator it = obj.begin() + startRowOffset; it != obj.begin() + endRowOffset; ++it) {
 			if (checkRow(*it, countCols) != 0)
 				return false;
+			m_rows << *it;
+			m_rowNames << it.key();
 			countRows++;
 		}
 		break;
 	}
+	case JsonFilter::DataContainerType::Lines: // not available in documents
+		return false;
+	}
+
+	if (endColumn == -1 || endColumn > countCols)
+		endColumn = countCols;
+
+	m_actualRows = countRows;
+	m_actualCols = endColumn - startColumn + 1 + createIndexEnabled + importObjectNames;
+
+	if (parseColumnModes(m_rows, m_rowNames.constFirst()) != 0)
+		return false;
+
+	DEBUG("start/end column: = " << startColumn << ' ' << endColumn);
+	DEBUG("start/end rows = " << startRow << ' ' << endRow);
+	DEBUG("actual cols/rows = " << m_actualCols << ' ' << m_actualRows);
+
+	return true;
+}
+
+/*!
+	determines the structure of the data read by \c reader, the number of columns and the column modes
+	from the first rows, and counts the rows to be read (at most \c lines rows if \c lines is not -1).
+	The first rows are kept in \c m_rows, all read rows if \c lines is not -1.
+	returns \c true if successful, \c false otherwise.
+*/
+bool JsonFilterPrivate::prepareStreamToRead(JsonReader& reader, int lines) {
+	PERFTRACE(QStringLiteral("Prepare the JSON data to read"));
+
+	if (!reader.open()) {
+		DEBUG(Q_FUNC_INFO << ", ERROR: " << STDSTRING(reader.errorString()));
+		return false;
+	}
+
+	switch (reader.format()) {
+	case JsonReader::Format::Array:
+		containerType = JsonFilter::DataContainerType::Array;
+		break;
+	case JsonReader::Format::Object:
+		containerType = JsonFilter::DataContainerType::Object;
+		break;
+	case JsonReader::Format::Lines:
+		containerType = JsonFilter::DataContainerType::Lines;
+		break;
+	}
+
+	importObjectNames = (importObjectNames && (rowType == QJsonValue::Object));
+
+	if (reader.skip(startRow - 1) < startRow - 1)
+		return false;
+
+	int maxRows = (endRow == -1) ? -1 : endRow - startRow + 1;
+	if (lines != -1 && (maxRows == -1 || lines < maxRows))
+		maxRows = lines;
+
+	int countRows = 0;
+	int countCols = -1;
+	m_rows.clear();
+	m_rowNames.clear();
+	QJsonValue row;
+	QString rowName;
+	while (maxRows == -1 || countRows < maxRows) {
+		if (lines != -1 || countRows < schemaRows) {
+			if (!reader.readNext(&row, &rowName))
+				break;
+			if (checkRow(row, countCols) != 0)
+				return false;
+			m_rows << row;
+			m_rowNames << rowName;
+		} else if (!reader.readNext()) // the remaining rows are only counted
+			break;
+		++countRows;
 	}
 
+	if (reader.hasError()) {
+		DEBUG(Q_FUNC_INFO << ", ERROR: " << STDSTRING(reader.errorString()));
+		return false;
+	}
+
+	if (countRows == 0)
+		return false;
+
 	if (endColumn == -1 || endColumn > countCols)
 		endColumn = countCols;
 
 	m_actualRows = countRows;
 	m_actualCols = endColumn - startColumn + 1 + createIndexEnabled + importObjectNames;
 
-	if (parseColumnModes(firstRow, firstRowName) != 0)
+	if (parseColumnModes(m_rows, m_rowNames.constFirst()) != 0)
 		return false;
 
 	DEBUG("start/end column: = " << startColumn << ' ' << endColumn);
@@ -510,6 +745,51 @@ void JsonFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 reads the content of device \c device to the data source \c dataSource. Uses the settings defined in the data source.
 */
 void JsonFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
+	Q_UNUSED(lines)
+
+	if (streamingEnabled()) {
+		const int deviceError = prepareDeviceToRead(device);
+		if (deviceError != 0) {
+			DEBUG("Device error = " << deviceError);
+			return;
+		}
+
+		// the data is read twice, to determine its structure and number of rows first and to import the values then.
+		// sequential devices can't be rewound, their data is copied chunk by chunk into a temporary file.
+		QTemporaryFile file;
+		QIODevice* input = &device;
+		if (device.isSequential()) {
+			if (!file.open()) {
+				DEBUG(Q_FUNC_INFO << ", ERROR: couldn't create a temporary file");
+				return;
+			}
+			QByteArray chunk;
+			while (!(chunk = device.read(1024 * 1024)).isEmpty()) {
+				if (file.write(chunk) != chunk.size()) {
+					DEBUG(Q_FUNC_INFO << ", ERROR: couldn't write to the temporary file");
+					return;
+				}
+			}
+			file.seek(0);
+			input = &file;
+		}
+
+		JsonReader reader(*input);
+		if (!prepareStreamToRead(reader, -1))
+			return;
+
+		// continue after the first rows that were already read
+		JsonReader dataReader(*input);
+		if (m_rows.size() < m_actualRows) {
+			const int skipRows = startRow - 1 + m_rows.size();
+			if (!input->seek(0) || !dataReader.open() || dataReader.skip(skipRows) < skipRows)
+				return;
+		}
+
+		importData(m_rows.size() < m_actualRows ? &dataReader : nullptr, dataSource, importMode);
+		return;
+	}
+
 	if (!m_prepared) {
 		const int deviceError = prepareDeviceToRead(device);
 		if (deviceError != 0) {
@@ -521,88 +801,39 @@ void JsonFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource
 	}
 
 	if (prepareDocumentToRead())
-		importData(dataSource, importMode, lines);
+		importData(nullptr, dataSource, importMode);
 }
 
 /*!
-import the content of document \c m_preparedDoc to the data source \c dataSource. Uses the settings defined in the data source.
+import the rows in \c m_rows and the remaining rows read by \c reader to the data source \c dataSource.
+Uses the settings defined in the data source.
 */
-void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
+void JsonFilterPrivate::importData(JsonReader* reader, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes);
-	int rowOffset = startRow - 1;
-	int colOffset = (int)createIndexEnabled + (int)importObjectNames;
+	m_locale = QLocale(numberFormat);
 	DEBUG("reading " << m_actualRows << " lines");
 	DEBUG("reading " << m_actualCols << " columns");
 
 	int progressIndex = 0;
-	const float progressInterval = 0.01 * lines; // update on every 1% only
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-	const auto& object = m_preparedDoc.object();
-	const auto& objectIterator = object.begin();
+	const float progressInterval = 0.01 * m_actualRows; // update on every 1% only
 
+	QJsonValue row;
+	QString rowName;
 	for (int i = 0; i < m_actualRows; ++i) {
-		if (createIndexEnabled)
-			static_cast<QVector<int>*>(m_dataContainer[0])->operator[](i) = i + 1;
-
-		QJsonValue row;
-		switch (containerType) {
-		case JsonFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
-			break;
-		case JsonFilter::DataContainerType::Object:
-			if (importObjectNames) {
-				const QString& rowName = (objectIterator + rowOffset + i).key();
-				setValueFromString((int)createIndexEnabled, i, rowName);
-			}
-			row = *(objectIterator + rowOffset + i);
+		if (i < m_rows.size())
+			importRow(i, m_rows.at(i), m_rowNames.at(i));
+		else if (reader && reader->readNext(&row, &rowName))
+			importRow(i, row, rowName);
+		else {
+			DEBUG(Q_FUNC_INFO << ", ERROR: only " << i << " rows read");
 			break;
 		}
 
-		for (int n = 0; n < m_actualCols - colOffset; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n + startColumn - 1);
-				break;
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n + startColumn - 1);
-				break;
-			// TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
-
-			switch (value.type()) {
-			case QJsonValue::Double:
-				if (columnModes[colOffset + n] == AbstractColumn::ColumnMode::Double)
-					static_cast<QVector<double>*>(m_dataContainer[colOffset + n])->operator[](i) = value.toDouble();
-				else
-					setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			case QJsonValue::String:
-				setValueFromString(colOffset + n, i, value.toString());
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			}
-		}
-
 		// ask to update the progress bar only if we have more than 1000 lines
 		// only in 1% steps
 		progressIndex++;
 		if (m_actualRows > 1000 && progressIndex > progressInterval) {
-			double value = 100. * i / lines;
+			double value = 100. * i / m_actualRows;
 			Q_EMIT q->completed(static_cast<int>(value));
 			progressIndex = 0;
 			QApplication::processEvents(QEventLoop::AllEvents, 0);
@@ -636,6 +867,21 @@ QVector<QStringList> JsonFilterPrivate::preview(const QString& fileName, int lin
 generates the preview for device \c device.
 */
 QVector<QStringList> JsonFilterPrivate::preview(QIODevice& device, int lines) {
+	if (streamingEnabled()) {
+		const int deviceError = prepareDeviceToRead(device);
+		if (deviceError != 0) {
+			DEBUG("Device error = " << deviceError);
+			return {};
+		}
+
+		// only the rows shown in the preview are read
+		JsonReader reader(device);
+		if (prepareStreamToRead(reader, lines))
+			return preview(lines);
+
+		return {};
+	}
+
 	if (!m_prepared) {
 		const int deviceError = prepareDeviceToRead(device);
 		if (deviceError != 0) {
@@ -651,73 +897,16 @@ QVector<QStringList> JsonFilterPrivate::preview(QIODevice& device, int lines) {
 }
 
 /*!
-generates the preview for document \c m_preparedDoc.
+generates the preview for the rows in \c m_rows.
 */
 QVector<QStringList> JsonFilterPrivate::preview(int lines) {
 	QVector<QStringList> dataStrings;
-	const int rowOffset = startRow - 1;
-	DEBUG("	Generating preview for " << std::min(lines, m_actualRows) << " lines");
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-	const auto& object = m_preparedDoc.object();
-	const auto& objectIterator = object.begin();
-
-	for (int i = 0; i < std::min(lines, m_actualRows); ++i) {
-		QString rowName;
-		QJsonValue row;
-		switch (containerType) {
-		case JsonFilter::DataContainerType::Object:
-			rowName = (objectIterator + rowOffset + i).key();
-			row = *(objectIterator + rowOffset + i);
-			break;
-		case JsonFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
-			break;
-		}
+	const int count = std::min(lines, (int)m_rows.size());
+	DEBUG("	Generating preview for " << count << " lines");
 
-		QStringList lineString;
-		if (createIndexEnabled)
-			lineString += QString::number(i + 1);
-		if (importObjectNames)
-			lineString += rowName;
-
-		for (int n = startColumn - 1; n < endColumn; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n);
-				break;
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n);
-				break;
-			// TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
+	for (int i = 0; i < count; ++i)
+		dataStrings << previewRow(i, m_rows.at(i), m_rowNames.at(i));
 
-			switch (value.type()) {
-			case QJsonValue::Double:
-				lineString += QString::number(value.toDouble(), 'g', 16);
-				break;
-			case QJsonValue::String:
-				lineString += value.toString();
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				lineString += QString();
-				break;
-			}
-		}
-		dataStrings << lineString;
-	}
 	return dataStrings;
 }
 
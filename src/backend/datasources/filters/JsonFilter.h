@@ -25,7 +25,7 @@ class JsonFilter : public AbstractFileFilter {
 	Q_OBJECT
 
 public:
-	enum class DataContainerType { Array, Object };
+	enum class DataContainerType { Array, Object, Lines }; // Lines: newline delimited JSON
 
 	JsonFilter();
 	~JsonFilter() override;
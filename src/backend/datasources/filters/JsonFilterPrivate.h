@@ -16,21 +16,24 @@
 class QJsonDocument;
 class AbstractDataSource;
 class AbstractColumn;
+class JsonReader;
 
 class JsonFilterPrivate {
 public:
 	explicit JsonFilterPrivate(JsonFilter* owner);
 
-	int checkRow(QJsonValueRef value, int& countCols);
-	int parseColumnModes(const QJsonValue& row, const QString& rowName = QString());
+	int checkRow(const QJsonValue& value, int& countCols);
+	int parseColumnModes(const QVector<QJsonValue>& rows, const QString& rowName = QString());
 	void setEmptyValue(int column, int row);
 	void setValueFromString(int column, int row, const QString& value);
+	void importRow(int row, const QJsonValue& value, const QString& rowName);
+	QStringList previewRow(int row, const QJsonValue& value, const QString& rowName) const;
 
 	int prepareDeviceToRead(QIODevice&);
 	void
 	readDataFromDevice(QIODevice&, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
-	void importData(AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
+	void importData(JsonReader*, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
@@ -63,10 +66,14 @@ private:
 	int m_prepared{false};
 	int m_columnOffset{0}; // indexes the "start column" in the datasource. Data will be imported starting from this column.
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers (columns).
-	QJsonDocument m_doc; // original and full JSON document
-	QJsonDocument m_preparedDoc; // selected part of the full JSON document, the part that needs to be imported
+	QLocale m_locale; // locale of the numbers in the imported strings
+	QJsonDocument m_doc; // original and full JSON document, only used if a part of it is selected in the model
+	QVector<QJsonValue> m_rows; // rows of the selected part of the document or the first rows of the streamed data
+	QStringList m_rowNames; // object names of the rows in m_rows
 
 	bool prepareDocumentToRead();
+	bool prepareStreamToRead(JsonReader&, int lines);
+	bool streamingEnabled() const;
 };
 
 #endif
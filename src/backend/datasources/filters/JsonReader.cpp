@@ -0,0 +1,279 @@
+/*
+	File                 : JsonReader.cpp
+	Project              : LabPlot
+	Description          : Streaming reader for the records of JSON data
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "JsonReader.h"
+
+#include <KLocalizedString>
+
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+const qint64 chunkSize = 1024 * 1024;
+
+bool isWhitespace(char c) {
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+}
+
+JsonReader::JsonReader(QIODevice& device)
+	: m_device(device) {
+}
+
+/*!
+ * reads the first chunk of the data and determines the format.
+ * The data is newline delimited JSON if the first line contains a complete JSON value followed by further values.
+ * Returns \c false if the data is empty or doesn't start with an array or an object.
+ */
+bool JsonReader::open() {
+	m_buffer = m_device.read(chunkSize);
+	m_pos = 0;
+	m_offset = 0;
+	m_firstRecord = true;
+	m_atEnd = false;
+	m_error.clear();
+
+	if (!skipWhitespace())
+		return setError(i18n("Empty document"));
+
+	const char first = m_buffer.at(m_pos);
+	if (first != '[' && first != '{')
+		return setError(i18n("Array or object expected"));
+
+	const int newline = m_buffer.indexOf('\n', m_pos);
+	if (newline != -1) {
+		int next = newline + 1;
+		while (next < m_buffer.size() && isWhitespace(m_buffer.at(next)))
+			++next;
+
+		if (next < m_buffer.size()) {
+			QJsonParseError err;
+			QJsonDocument::fromJson(m_buffer.mid(m_pos, newline - m_pos), &err);
+			if (err.error == QJsonParseError::NoError) {
+				m_format = Format::Lines;
+				return true;
+			}
+		}
+	}
+
+	m_format = (first == '[') ? Format::Array : Format::Object;
+	++m_pos; // the records follow the opening bracket
+	return true;
+}
+
+JsonReader::Format JsonReader::format() const {
+	return m_format;
+}
+
+/*!
+ * reads the next record into \c value and, for objects, its name into \c key.
+ * If \c value and \c key are not provided, the record is skipped without parsing it.
+ * Returns \c false at the end of the data or if the data couldn't be parsed.
+ */
+bool JsonReader::readNext(QJsonValue* value, QString* key) {
+	if (m_atEnd || hasError())
+		return false;
+
+	if (!skipWhitespace()) {
+		m_atEnd = true;
+		if (m_format == Format::Lines)
+			return false;
+		return setError(i18n("Unexpected end of data"));
+	}
+
+	if (m_format != Format::Lines) {
+		const char c = m_buffer.at(m_pos);
+		if (c == (m_format == Format::Array ? ']' : '}')) {
+			++m_pos;
+			m_atEnd = true;
+			return false;
+		}
+
+		if (!m_firstRecord) {
+			if (c != ',')
+				return setError(i18n("Missing separator"));
+			++m_pos;
+		}
+	}
+	m_firstRecord = false;
+
+	if (m_format == Format::Object) {
+		QByteArray keyBytes;
+		if (!skipWhitespace() || m_buffer.at(m_pos) != '"')
+			return setError(i18n("Object member name expected"));
+		if (!scanValue(key ? &keyBytes : nullptr))
+			return false;
+		if (!skipWhitespace() || m_buffer.at(m_pos) != ':')
+			return setError(i18n("Missing name separator"));
+		++m_pos;
+
+		if (key) {
+			QJsonValue keyValue;
+			if (!parseValue(keyBytes, keyValue))
+				return false;
+			*key = keyValue.toString();
+		}
+	}
+
+	QByteArray bytes;
+	if (!scanValue(value ? &bytes : nullptr))
+		return false;
+
+	if (value)
+		return parseValue(bytes, *value);
+
+	return true;
+}
+
+/*!
+ * skips the next \c count records, returns the number of skipped records.
+ */
+int JsonReader::skip(int count) {
+	int skipped = 0;
+	while (skipped < count && readNext())
+		++skipped;
+	return skipped;
+}
+
+bool JsonReader::hasError() const {
+	return !m_error.isEmpty();
+}
+
+QString JsonReader::errorString() const {
+	return m_error;
+}
+
+// ##############################################################################
+// ############################ private ########################################
+// ##############################################################################
+
+/*!
+ * reads the next chunk if the current one was consumed. The consumed part of a value being scanned is kept.
+ * Returns \c false at the end of the data.
+ */
+bool JsonReader::fill() {
+	if (m_pos < m_buffer.size())
+		return true;
+
+	if (m_bytes)
+		m_bytes->append(m_buffer.constData() + m_bytesStart, m_buffer.size() - m_bytesStart);
+
+	m_offset += m_buffer.size();
+	m_buffer = m_device.read(chunkSize);
+	m_pos = 0;
+	m_bytesStart = 0;
+	return !m_buffer.isEmpty();
+}
+
+bool JsonReader::skipWhitespace() {
+	while (fill()) {
+		if (!isWhitespace(m_buffer.at(m_pos)))
+			return true;
+		++m_pos;
+	}
+	return false;
+}
+
+/*!
+ * determines the end of the value at the current position by tracking strings and nested arrays and objects
+ * and appends its bytes to \c bytes, if provided.
+ */
+bool JsonReader::scanValue(QByteArray* bytes) {
+	if (!skipWhitespace())
+		return setError(i18n("Unexpected end of data"));
+
+	m_bytes = bytes;
+	m_bytesStart = m_pos;
+	const qint64 start = m_offset + m_pos;
+
+	int depth = 0;
+	bool inString = false;
+	bool escaped = false;
+	bool complete = false;
+	while (fill()) {
+		const char c = m_buffer.at(m_pos);
+		if (inString) {
+			if (escaped)
+				escaped = false;
+			else if (c == '\\')
+				escaped = true;
+			else if (c == '"') {
+				inString = false;
+				if (depth == 0) {
+					++m_pos;
+					complete = true;
+					break;
+				}
+			}
+		} else if (c == '"')
+			inString = true;
+		else if (c == '[' || c == '{')
+			++depth;
+		else if (c == ']' || c == '}') {
+			if (depth == 0) { // end of a number or literal inside of the top-level container
+				complete = true;
+				break;
+			}
+			if (--depth == 0) {
+				++m_pos;
+				complete = true;
+				break;
+			}
+		} else if (depth == 0 && (c == ',' || c == ':' || isWhitespace(c))) {
+			complete = true;
+			break;
+		}
+		++m_pos;
+	}
+
+	if (bytes)
+		bytes->append(m_buffer.constData() + m_bytesStart, m_pos - m_bytesStart);
+	m_bytes = nullptr;
+
+	// numbers and literals at the end of newline delimited JSON are complete, too
+	if (!complete && (depth > 0 || inString))
+		return setError(i18n("Unexpected end of data"));
+
+	if (m_offset + m_pos == start)
+		return setError(i18n("Value expected"));
+
+	return true;
+}
+
+/*!
+ * parses the bytes of a single value. Numbers, strings and literals are wrapped into an array
+ * since QJsonDocument only parses arrays and objects.
+ */
+bool JsonReader::parseValue(const QByteArray& bytes, QJsonValue& value) {
+	QJsonParseError err;
+	const char first = bytes.at(0);
+	if (first == '[' || first == '{') {
+		const auto document = QJsonDocument::fromJson(bytes, &err);
+		if (document.isArray())
+			value = document.array();
+		else
+			value = document.object();
+	} else {
+		QByteArray array;
+		array.reserve(bytes.size() + 2);
+		array.append('[').append(bytes).append(']');
+		value = QJsonDocument::fromJson(array, &err).array().at(0);
+	}
+
+	if (err.error != QJsonParseError::NoError)
+		return setError(i18n("%1 at offset %2", err.errorString(), m_offset + m_pos - bytes.size() + err.offset));
+
+	return true;
+}
+
+bool JsonReader::setError(const QString& error) {
+	m_error = error;
+	return false;
+}
@@ -0,0 +1,57 @@
+/*
+	File                 : JsonReader.h
+	Project              : LabPlot
+	Description          : Streaming reader for the records of JSON data
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+
+class QIODevice;
+
+/*!
+ * Reads the records of JSON data sequentially from a device without building the whole document in memory.
+ * The records are the elements of the top-level array, the members of the top-level object or,
+ * for newline delimited JSON, the values of the single lines.
+ * Only the bytes of the current record are kept, each record is parsed separately.
+ */
+class JsonReader {
+public:
+	enum class Format { Array, Object, Lines };
+
+	explicit JsonReader(QIODevice&);
+
+	bool open();
+	Format format() const;
+	bool readNext(QJsonValue* value = nullptr, QString* key = nullptr);
+	int skip(int count);
+
+	bool hasError() const;
+	QString errorString() const;
+
+private:
+	bool fill();
+	bool skipWhitespace();
+	bool scanValue(QByteArray* bytes);
+	bool parseValue(const QByteArray& bytes, QJsonValue& value);
+	bool setError(const QString&);
+
+	QIODevice& m_device;
+	QByteArray m_buffer; // currently read chunk of the data
+	int m_pos{0}; // read position in the current chunk
+	qint64 m_offset{0}; // offset of the current chunk in the data
+	QByteArray* m_bytes{nullptr}; // bytes of the value being scanned
+	int m_bytesStart{0}; // start of the scanned value in the current chunk
+	Format m_format{Format::Array};
+	bool m_firstRecord{true};
+	bool m_atEnd{false};
+	QString m_error;
+};
+
+#endif // JSONREADER_H
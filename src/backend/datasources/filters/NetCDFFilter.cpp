@@ -10,6 +10,7 @@
 #include "NetCDFFilter.h"
 #include "NetCDFFilterPrivate.h"
 #include "backend/core/column/Column.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/macros.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -150,6 +151,15 @@ void NetCDFFilter::readDataFromFile(const QString& fileName, AbstractDataSource*
 	d->readDataFromFile(fileName, dataSource, mode);
 }
 
+/*!
+  reads the records of the current variable that were added to the file \c fileName since the last read
+  to the live data source \c dataSource. \c from is the number of records read so far.
+  Returns the number of records read in total.
+*/
+qint64 NetCDFFilter::readFromLiveFile(const QString& fileName, AbstractDataSource* dataSource, qint64 from) {
+	return d->readFromLiveFile(fileName, dataSource, from);
+}
+
 /*!
 writes the content of the data source \c dataSource to the file \c fileName.
 */
@@ -1098,6 +1108,114 @@ QVector<QStringList> NetCDFFilterPrivate::readDataFromFile(const QString& fileNa
 	return readCurrentVar(fileName, dataSource, mode);
 }
 
+/*!
+	reads the records of the current variable added since the last read to the live data source \c dataSource.
+	Numeric variables of rank 1 and 2 growing along their first (record) dimension are read incrementally, i.e. only
+	the new records [\c from, current length) are read directly into the columns. All other variables,
+	the very first read and variables that got shorter than \c from (e.g. the file was replaced)
+	are imported completely. Returns the number of records read in total.
+*/
+qint64 NetCDFFilterPrivate::readFromLiveFile(const QString& fileName, AbstractDataSource* dataSource, qint64 from) {
+	DEBUG(Q_FUNC_INFO << ", from = " << from);
+	auto* source = dynamic_cast<LiveDataSource*>(dataSource);
+	if (!source || currentVarName.isEmpty())
+		return from;
+
+#ifdef HAVE_NETCDF
+	int ncid;
+	m_status = nc_open(qPrintable(fileName), NC_NOWRITE, &ncid);
+	handleError(m_status, QStringLiteral("nc_open"));
+	if (m_status != NC_NOERR)
+		return from;
+
+	int varid;
+	m_status = nc_inq_varid(ncid, qPrintable(currentVarName), &varid);
+	handleError(m_status, QStringLiteral("nc_inq_varid"));
+	int ndims = 0;
+	nc_type type = NC_NAT;
+	if (m_status == NC_NOERR) {
+		m_status = nc_inq_varndims(ncid, varid, &ndims);
+		handleError(m_status, QStringLiteral("nc_inq_varndims"));
+		m_status = nc_inq_vartype(ncid, varid, &type);
+		handleError(m_status, QStringLiteral("nc_inq_type"));
+	}
+
+	size_t extent = 0;
+	if (ndims == 1 || ndims == 2) {
+		int dimids[2];
+		m_status = nc_inq_vardimid(ncid, varid, dimids);
+		handleError(m_status, QStringLiteral("nc_inq_vardimid"));
+		m_status = nc_inq_dimlen(ncid, dimids[0], &extent);
+		handleError(m_status, QStringLiteral("nc_inq_dimlen"));
+	}
+	DEBUG(Q_FUNC_INFO << ", current number of records = " << extent)
+
+	const bool incremental = (ndims == 1 || ndims == 2) && type != NC_NAT && type != NC_CHAR && type != NC_STRING;
+	if (from == 0 || (qint64)extent < from || !incremental || source->columnCount() == 0) {
+		ncclose(ncid);
+
+		// initial import of the variable, only the last N values if a fixed number of values is kept.
+		// the row range set by the user is restored afterwards, it's saved in the project
+		const int userStartRow = startRow;
+		const int userEndRow = endRow;
+		const int keepNValues = source->keepNValues();
+		if (incremental && keepNValues > 0)
+			startRow = std::max(startRow, (int)extent - keepNValues + 1);
+		endRow = -1; // read until the current end of the record dimension
+		readCurrentVar(fileName, dataSource);
+		startRow = userStartRow;
+		endRow = userEndRow;
+		return (qint64)extent;
+	}
+
+	if ((qint64)extent > from) {
+		qint64 first;
+		int count;
+		const int row = source->prepareLiveRows(from, (qint64)extent, first, count);
+		DEBUG(Q_FUNC_INFO << ", reading " << count << " records starting at record " << first)
+
+		// read the new records of every column directly into the column data block by block, the library converts to the column type
+		const auto& columns = source->children<Column>();
+		for (int c = 0; c < columns.size(); ++c) {
+			auto* column = columns.at(c);
+			for (const auto& chunk : column->dataChunks(row, count)) {
+				const size_t start[2] = {(size_t)(first + chunk.firstRow - row), (size_t)(startColumn - 1 + c)};
+				const size_t counts[2] = {(size_t)chunk.size, 1};
+				switch (column->columnMode()) {
+				case AbstractColumn::ColumnMode::Integer:
+					m_status = nc_get_vara_int(ncid, varid, start, counts, static_cast<int*>(chunk.values));
+					handleError(m_status, QStringLiteral("nc_get_vara_int"));
+					break;
+				case AbstractColumn::ColumnMode::BigInt:
+					m_status = nc_get_vara_longlong(ncid, varid, start, counts, static_cast<qint64*>(chunk.values));
+					handleError(m_status, QStringLiteral("nc_get_vara_longlong"));
+					break;
+				case AbstractColumn::ColumnMode::Double:
+					m_status = nc_get_vara_double(ncid, varid, start, counts, static_cast<double*>(chunk.values));
+					handleError(m_status, QStringLiteral("nc_get_vara_double"));
+					break;
+				case AbstractColumn::ColumnMode::Text:
+				case AbstractColumn::ColumnMode::DateTime:
+				case AbstractColumn::ColumnMode::Month:
+				case AbstractColumn::ColumnMode::Day:
+					break;
+				}
+			}
+		}
+
+		source->finalizeLiveRows();
+		from = first + count;
+	}
+
+	m_status = ncclose(ncid);
+	handleError(m_status, QStringLiteral("nc_close"));
+#else
+	Q_UNUSED(fileName)
+#endif
+
+	return from;
+}
+
 /*!
 	writes the content of \c dataSource to the file \c fileName.
 */
@@ -1114,12 +1232,52 @@ void NetCDFFilterPrivate::write(const QString& /*fileName*/, AbstractDataSource*
  */
 void NetCDFFilter::save(QXmlStreamWriter* writer) const {
 	writer->writeStartElement(QStringLiteral("netcdfFilter"));
+	writer->writeAttribute(QStringLiteral("variable"), d->currentVarName);
+	writer->writeAttribute(QStringLiteral("startRow"), QString::number(d->startRow));
+	writer->writeAttribute(QStringLiteral("endRow"), QString::number(d->endRow));
+	writer->writeAttribute(QStringLiteral("startColumn"), QString::number(d->startColumn));
+	writer->writeAttribute(QStringLiteral("endColumn"), QString::number(d->endColumn));
 	writer->writeEndElement();
 }
 
 /*!
   Loads from XML.
 */
-bool NetCDFFilter::load(XmlStreamReader*) {
+bool NetCDFFilter::load(XmlStreamReader* reader) {
+	QString attributeWarning = i18n("Attribute '%1' missing or empty, default value is used");
+	QXmlStreamAttributes attribs = reader->attributes();
+
+	// projects created with older versions don't have any attributes
+	if (attribs.isEmpty())
+		return true;
+
+	d->currentVarName = attribs.value(QStringLiteral("variable")).toString();
+	if (d->currentVarName.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("variable")));
+
+	QString str = attribs.value(QStringLiteral("startRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startRow")));
+	else
+		d->startRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("endRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endRow")));
+	else
+		d->endRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("startColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startColumn")));
+	else
+		d->startColumn = str.toInt();
+
+	str = attribs.value(QStringLiteral("endColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endColumn")));
+	else
+		d->endColumn = str.toInt();
+
 	return true;
 }
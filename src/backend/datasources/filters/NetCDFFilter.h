@@ -32,6 +32,7 @@ public:
 										AbstractDataSource* = nullptr,
 										AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 										int lines = -1);
+	qint64 readFromLiveFile(const QString& fileName, AbstractDataSource*, qint64 from = 0);
 	void write(const QString& fileName, AbstractDataSource*) override;
 
 	void setCurrentVarName(const QString&);
@@ -28,6 +28,7 @@ public:
 										AbstractDataSource* = nullptr,
 										AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 										int lines = -1);
+	qint64 readFromLiveFile(const QString& fileName, AbstractDataSource*, qint64 from);
 	void write(const QString& fileName, AbstractDataSource*);
 #ifdef HAVE_NETCDF
 	static void handleError(int status, const QString& function);
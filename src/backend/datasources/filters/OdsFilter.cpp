@@ -11,22 +11,13 @@
 #include "backend/core/column/Column.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/OdsFilterPrivate.h"
+#include "backend/datasources/filters/OdsReader.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
 #include <QTreeWidgetItem>
 
-#ifdef HAVE_ORCUS
-#include <orcus/orcus_ods.hpp>
-#include <orcus/spreadsheet/factory.hpp>
-#include <orcus/spreadsheet/sheet.hpp>
-
-#include <ixion/model_context.hpp>
-
-using namespace orcus;
-#endif
-
 // TODO:
 // * export data when Orcus support is stable
 // * datetime support?
@@ -40,30 +31,30 @@ OdsFilter::~OdsFilter() {
 
 QString OdsFilter::fileInfoString(const QString& fileName) {
 #ifdef HAVE_ORCUS
-	spreadsheet::range_size_t ss{1048576, 16384};
-	spreadsheet::document doc{ss};
-	spreadsheet::import_factory factory{doc};
-	orcus_ods loader(&factory);
-
-	loader.read_file(fileName.toStdString());
-
-	const size_t nrSheets = doc.get_sheet_count();
-	auto dt = doc.get_origin_date();
+	OdsReader reader(fileName);
+	if (!reader.open())
+		return {};
+
+	QStringList sheets;
+	while (reader.nextSheet()) {
+		OdsReader::Range r;
+		reader.readSheet([&r](int row, int col, const OdsReader::Cell&) {
+			r.add(row, col);
+			return true;
+		});
+
+		QString sheet = reader.sheetName();
+		if (r.isValid())
+			sheet += QStringLiteral(" (") + QString::number(r.last.row - r.first.row + 1) + QStringLiteral(" x ")
+				+ QString::number(r.last.column - r.first.column + 1) + QStringLiteral(")");
+		else
+			sheet += QStringLiteral(" (0 x 0)");
+		sheets << sheet;
+	}
 
-	QString info(i18n("Sheet count: %1", QString::number(nrSheets)));
+	QString info(i18n("Sheet count: %1", QString::number(sheets.size())));
 	info += QStringLiteral("<br>");
-
-	for (size_t i = 0; i < nrSheets; ++i) {
-		auto name = doc.get_sheet_name(i);
-		info += QString::fromStdString(std::string(name));
-		const auto* s = doc.get_sheet(i);
-		auto r = s->get_data_range();
-
-		info += QStringLiteral(" (") + QString::number(r.last.row - r.first.row + 1) + QStringLiteral(" x ")
-			+ QString::number(r.last.column - r.first.column + 1) + QStringLiteral(")");
-		if (i < nrSheets - 1)
-			info += QStringLiteral(", ");
-	}
+	info += sheets.join(QStringLiteral(", "));
 	info += QStringLiteral("<br>");
 
 	return info;
@@ -231,30 +222,30 @@ void OdsFilterPrivate::readCurrentSheet(const QString& fileName, AbstractDataSou
 		return;
 
 #ifdef HAVE_ORCUS
-	DEBUG(Q_FUNC_INFO << ", sheet count = " << m_document.get_sheet_count())
-	if (m_document.get_sheet_count() == 0) { // not loaded yet
-		DEBUG(Q_FUNC_INFO << ", loading file " << fileName.toStdString())
-		m_document.clear();
-		spreadsheet::import_factory factory{m_document};
-		orcus_ods loader(&factory);
-
-		loader.read_file(fileName.toStdString());
-	}
-
-	// get sheet index from name and read data into dataSource
-	auto* sheet = m_document.get_sheet(currentSheetName.toStdString());
-	if (!sheet) {
-		DEBUG(Q_FUNC_INFO << ", sheet not found: " << currentSheetName.toStdString())
+	// first pass: determine the data range of the sheet and keep the rows needed
+	// for the column names and modes (first rows of the data or of the selected range)
+	OdsReader reader(fileName);
+	OdsReader::Range ranges;
+	QHash<int, QHash<int, OdsReader::Cell>> rowCells;
+	const bool ok = reader.readSheet(currentSheetName, [&](int row, int col, const OdsReader::Cell& cell) {
+		ranges.add(row, col);
+		const int offset = row - ranges.first.row;
+		if (offset <= 1 || offset == startRow - 1 || offset == startRow)
+			rowCells[row].insert(col, cell);
+		return true;
+	});
+	if (!ok) {
+		DEBUG(Q_FUNC_INFO << ", sheet not found or invalid: " << currentSheetName.toStdString())
 		return;
 	}
-
-	const auto sheetIndex = sheet->get_index();
-	if (sheetIndex == ixion::invalid_sheet) {
-		DEBUG(Q_FUNC_INFO << ", invalid sheet")
+	if (!ranges.isValid()) {
+		DEBUG(Q_FUNC_INFO << ", no data in sheet")
 		return;
 	}
+	const auto cellAt = [&rowCells](int row, int col) {
+		return rowCells.value(row).value(col);
+	};
 
-	auto ranges = sheet->get_data_range();
 	DEBUG(Q_FUNC_INFO << ", data range: col " << ranges.first.column << ".." << ranges.last.column << ", row " << ranges.first.row << ".." << ranges.last.row)
 	if (firstRowAsColumnNames) // skip first row
 		ranges.first.row++;
@@ -283,41 +274,17 @@ void OdsFilterPrivate::readCurrentSheet(const QString& fileName, AbstractDataSou
 	columnModes.resize(actualCols);
 
 	// set column modes (only for spreadsheet, matrix uses default: Double)
-	const auto& model = m_document.get_model_context();
 	if (dynamic_cast<Spreadsheet*>(dataSource)) {
 		for (size_t col = 0; col < actualCols; col++) {
 			// check start row
-			ixion::abs_address_t pos(sheetIndex, ranges.first.row + startRow - 1, ranges.first.column + startColumn - 1 + col);
-
-			auto type = model.get_celltype(pos);
-			switch (type) {
-			case ixion::celltype_t::string:
+			const auto cell = cellAt(ranges.first.row + startRow - 1, ranges.first.column + startColumn - 1 + col);
+			switch (cell.type) {
+			case OdsReader::CellType::String: // also string results of formulas
 				columnModes[col] = AbstractColumn::ColumnMode::Text;
 				break;
-			case ixion::celltype_t::numeric: // numeric values are always double (can't detect if integer)
-				// default: Double
-				break;
-			case ixion::celltype_t::formula: {
-				auto formula = model.get_formula_result(pos);
-				switch (formula.get_type()) { // conside formula type
-				case ixion::formula_result::result_type::value:
-					columnModes[col] = AbstractColumn::ColumnMode::Double;
-					break;
-				case ixion::formula_result::result_type::string:
-					columnModes[col] = AbstractColumn::ColumnMode::Text;
-					break;
-				case ixion::formula_result::result_type::error:
-				// TODO: not available in ixion 0.17 ?
-				// case ixion::formula_result::result_type::boolean:
-				case ixion::formula_result::result_type::matrix:
-					DEBUG(Q_FUNC_INFO << ", formula type not supported yet.")
-					break;
-				}
-				break;
-			}
-			case ixion::celltype_t::boolean:
-			case ixion::celltype_t::empty:
-			case ixion::celltype_t::unknown: // default: Double
+			case OdsReader::CellType::Numeric: // numeric values are always double (can't detect if integer)
+			case OdsReader::CellType::Other:
+			case OdsReader::CellType::Empty: // default: Double
 				break;
 			}
 		}
@@ -326,47 +293,17 @@ void OdsFilterPrivate::readCurrentSheet(const QString& fileName, AbstractDataSou
 	QStringList vectorNames;
 	if (firstRowAsColumnNames) {
 		for (size_t col = 0; col < actualCols; col++) {
-			ixion::abs_address_t pos(sheetIndex, ranges.first.row - 1 + startRow - 1, ranges.first.column + startColumn - 1 + col);
-
-			auto type = model.get_celltype(pos);
-			switch (type) {
-			case ixion::celltype_t::string: {
-				auto value = model.get_string_value(pos);
-				vectorNames << QString::fromStdString(std::string(value));
+			const auto cell = cellAt(ranges.first.row - 1 + startRow - 1, ranges.first.column + startColumn - 1 + col);
+			switch (cell.type) {
+			case OdsReader::CellType::String:
+				vectorNames << cell.text;
 				break;
-			}
-			case ixion::celltype_t::numeric: {
-				double value = model.get_numeric_value(pos);
-				vectorNames << QLocale().toString(value);
+			case OdsReader::CellType::Numeric:
+				vectorNames << QLocale().toString(cell.value);
 				break;
-			}
-			case ixion::celltype_t::formula: {
-				auto formula = model.get_formula_result(pos);
-				switch (formula.get_type()) {
-				case ixion::formula_result::result_type::value: {
-					auto value = formula.get_value();
-					vectorNames << QLocale().toString(value);
-					break;
-				}
-				case ixion::formula_result::result_type::string:
-					vectorNames << QString::fromStdString(formula.get_string());
-					break;
-				case ixion::formula_result::result_type::error:
-				// TODO: not available in ixion 0.17 ?
-				// case ixion::formula_result::result_type::boolean:
-				case ixion::formula_result::result_type::matrix:
-					vectorNames << AbstractFileFilter::convertFromNumberToColumn(ranges.first.column + startColumn - 1 + col);
-					;
-					break;
-				}
-				// TODO
-				break;
-			}
-			case ixion::celltype_t::empty:
-			case ixion::celltype_t::unknown:
-			case ixion::celltype_t::boolean:
+			case OdsReader::CellType::Other:
+			case OdsReader::CellType::Empty:
 				vectorNames << AbstractFileFilter::convertFromNumberToColumn(ranges.first.column + startColumn - 1 + col);
-				;
 			}
 		}
 	} else {
@@ -380,69 +317,41 @@ void OdsFilterPrivate::readCurrentSheet(const QString& fileName, AbstractDataSou
 	int columnOffset = dataSource->prepareImport(dataContainer, importMode, actualRows, actualCols, vectorNames, columnModes);
 	DEBUG(Q_FUNC_INFO << ", column offset = " << columnOffset)
 
-	// import data
-	for (size_t row = 0; row < actualRows; row++) {
-		for (size_t col = 0; col < actualCols; col++) {
-			ixion::abs_address_t pos(sheetIndex, ranges.first.row + row + startRow - 1, ranges.first.column + col + startColumn - 1);
-
-			auto type = model.get_celltype(pos);
-			switch (type) {
-			case ixion::celltype_t::numeric: {
-				double value = model.get_numeric_value(pos);
-				// column mode may be non-numeric
-				if (columnModes.at(col) == AbstractColumn::ColumnMode::Double)
-					(*static_cast<QVector<double>*>(dataContainer[col]))[row] = value;
-				else if (columnModes.at(col) == AbstractColumn::ColumnMode::Text)
-					(*static_cast<QVector<QString>*>(dataContainer[col]))[row] = QLocale().toString(value);
-				break;
-			}
-			case ixion::celltype_t::formula: {
-				// read formula result. We can't handle formulas yet (?)
-				auto formula = model.get_formula_result(pos);
-				switch (formula.get_type()) {
-				case ixion::formula_result::result_type::value: {
-					DEBUG(Q_FUNC_INFO << ", value formula found")
-					auto value = formula.get_value();
-					// text column may have value-type formula
-					if (columnModes.at(col) == AbstractColumn::ColumnMode::Double)
-						(*static_cast<QVector<double>*>(dataContainer[col]))[row] = value;
-					else if (columnModes.at(col) == AbstractColumn::ColumnMode::Text)
-						(*static_cast<QVector<QString>*>(dataContainer[col]))[row] = QLocale().toString(value);
-					break;
-				}
-				case ixion::formula_result::result_type::string:
-					DEBUG(Q_FUNC_INFO << ", string formula found")
-					// column mode may be numeric
-					if (columnModes.at(col) == AbstractColumn::ColumnMode::Double)
-						(*static_cast<QVector<double>*>(dataContainer[col]))[row] = formula.get_value();
-					else if (columnModes.at(col) == AbstractColumn::ColumnMode::Text)
-						(*static_cast<QVector<QString>*>(dataContainer[col]))[row] = QString::fromStdString(formula.get_string());
-					break;
-				case ixion::formula_result::result_type::error:
-				// TODO: not available in ixion 0.17 ?
-				// case ixion::formula_result::result_type::boolean:
-				case ixion::formula_result::result_type::matrix:
-					DEBUG(Q_FUNC_INFO << ", formula type not supported yet.")
-					break;
-				}
-				break;
-			}
-			case ixion::celltype_t::string: {
-				// column mode may be numeric
-				if (columnModes.at(col) == AbstractColumn::ColumnMode::Double)
-					(*static_cast<QVector<double>*>(dataContainer[col]))[row] = model.get_numeric_value(pos);
-				else if (columnModes.at(col) == AbstractColumn::ColumnMode::Text)
-					(*static_cast<QVector<QString>*>(dataContainer[col]))[row] = QString::fromStdString(std::string(model.get_string_value(pos)));
-				break;
-			}
-			case ixion::celltype_t::empty: // nothing to do
-				break;
-			case ixion::celltype_t::unknown:
-			case ixion::celltype_t::boolean:
-				DEBUG(Q_FUNC_INFO << ", cell type unknown or boolean not supported yet.")
-			}
+	// second pass: import data, reading stops after the last row
+	const int firstDataRow = ranges.first.row + startRow - 1;
+	const int lastDataRow = firstDataRow + (int)actualRows - 1;
+	const int firstDataColumn = ranges.first.column + startColumn - 1;
+	const int lastDataColumn = firstDataColumn + (int)actualCols - 1;
+	reader.readSheet(currentSheetName, [&](int row, int col, const OdsReader::Cell& cell) {
+		if (row > lastDataRow)
+			return false;
+		if (row < firstDataRow || col < firstDataColumn || col > lastDataColumn)
+			return true;
+
+		const int r = row - firstDataRow;
+		const int c = col - firstDataColumn;
+		switch (cell.type) {
+		case OdsReader::CellType::Numeric: // also value results of formulas
+			// column mode may be non-numeric
+			if (columnModes.at(c) == AbstractColumn::ColumnMode::Double)
+				(*static_cast<QVector<double>*>(dataContainer[c]))[r] = cell.value;
+			else if (columnModes.at(c) == AbstractColumn::ColumnMode::Text)
+				(*static_cast<QVector<QString>*>(dataContainer[c]))[r] = QLocale().toString(cell.value);
+			break;
+		case OdsReader::CellType::String:
+			// column mode may be numeric
+			if (columnModes.at(c) == AbstractColumn::ColumnMode::Double)
+				(*static_cast<QVector<double>*>(dataContainer[c]))[r] = 0.;
+			else if (columnModes.at(c) == AbstractColumn::ColumnMode::Text)
+				(*static_cast<QVector<QString>*>(dataContainer[c]))[r] = cell.text;
+			break;
+		case OdsReader::CellType::Empty: // nothing to do
+			break;
+		case OdsReader::CellType::Other:
+			DEBUG(Q_FUNC_INFO << ", cell type boolean not supported yet.")
 		}
-	}
+		return true;
+	});
 
 	dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), importMode);
 #else
@@ -455,20 +364,27 @@ void OdsFilterPrivate::readCurrentSheet(const QString& fileName, AbstractDataSou
 QVector<QStringList> OdsFilterPrivate::preview(const QString& sheetName, int lines) {
 	QVector<QStringList> dataString;
 #ifdef HAVE_ORCUS
-	// get sheet index by name and read lines of data into dataString
-	const auto* sheet = m_document.get_sheet(sheetName.toStdString());
-	if (!sheet) {
+	// read the sheet until the last row to preview and determine the data range from the rows read so far
+	OdsReader reader(m_fileName);
+	OdsReader::Range ranges;
+	QHash<int, QHash<int, OdsReader::Cell>> rowCells;
+	const bool ok = reader.readSheet(sheetName, [&](int row, int col, const OdsReader::Cell& cell) {
+		if (ranges.isValid() && row > ranges.first.row + std::max(startRow - 1, 0) + lines)
+			return false;
+
+		ranges.add(row, col);
+		const int offset = row - ranges.first.row;
+		if (offset <= lines || (offset >= startRow - 1 && offset <= startRow - 1 + lines))
+			rowCells[row].insert(col, cell);
+		return true;
+	});
+	if (!ok) {
 		DEBUG(Q_FUNC_INFO << ", sheet not found: " << sheetName.toStdString())
 		return dataString;
 	}
-
-	const auto sheetIndex = sheet->get_index();
-	if (sheetIndex == ixion::invalid_sheet) {
-		DEBUG(Q_FUNC_INFO << ", invalid sheet index " << sheetIndex)
+	if (!ranges.isValid())
 		return dataString;
-	}
 
-	const auto ranges = sheet->get_data_range();
 	DEBUG(Q_FUNC_INFO << ", data range: col " << ranges.first.column << ".." << ranges.last.column << ", row " << ranges.first.row << ".." << ranges.last.row)
 
 	const int maxCols = 100;
@@ -480,54 +396,25 @@ QVector<QStringList> OdsFilterPrivate::preview(const QString& sheetName, int lin
 	firstColumn = actualStartCol;
 	const int actualEndCol = (endColumn == -1 ? ranges.last.column : std::min(ranges.last.column, ranges.first.column + endColumn - 1));
 
-	const auto& model = m_document.get_model_context();
-	for (ixion::row_t row = actualStartRow; row <= std::min(actualEndRow, actualStartRow + lines); row++) {
+	for (int row = actualStartRow; row <= std::min(actualEndRow, actualStartRow + lines); row++) {
 		DEBUG(Q_FUNC_INFO << ", row " << row)
+		const auto& cells = rowCells.value(row);
 		QStringList line;
-		for (ixion::col_t col = actualStartCol; col <= std::min(actualEndCol, actualStartCol + maxCols); col++) {
-			ixion::abs_address_t pos(sheetIndex, row, col);
-
-			auto type = model.get_celltype(pos);
-			switch (type) {
-			case ixion::celltype_t::string: {
-				auto value = model.get_string_value(pos);
-				DEBUG(Q_FUNC_INFO << " " << value)
-				line << QString::fromStdString(std::string(value));
-				break;
-			}
-			case ixion::celltype_t::numeric: {
-				double value = model.get_numeric_value(pos);
-				DEBUG(Q_FUNC_INFO << " " << value)
-				line << QLocale().toString(value);
+		for (int col = actualStartCol; col <= std::min(actualEndCol, actualStartCol + maxCols); col++) {
+			const auto cell = cells.value(col);
+			switch (cell.type) {
+			case OdsReader::CellType::String:
+				line << cell.text;
 				break;
-			}
-			case ixion::celltype_t::formula: {
-				// read formula result. We can't handle formulas yet (?)
-				auto formula = model.get_formula_result(pos);
-				switch (formula.get_type()) {
-				case ixion::formula_result::result_type::value:
-					line << QLocale().toString(formula.get_value());
-					break;
-				case ixion::formula_result::result_type::string:
-					line << QString::fromStdString(formula.get_string());
-					break;
-				case ixion::formula_result::result_type::error:
-				// TODO: not available in ixion 0.17 ?
-				// case ixion::formula_result::result_type::boolean:
-				case ixion::formula_result::result_type::matrix:
-					line << QString();
-					DEBUG(Q_FUNC_INFO << ", formula type error, boolean or matrix not implemented yet.")
-					break;
-				}
+			case OdsReader::CellType::Numeric:
+				line << QLocale().toString(cell.value);
 				break;
-			}
-			case ixion::celltype_t::empty:
+			case OdsReader::CellType::Empty:
 				line << QString();
 				break;
-			case ixion::celltype_t::unknown:
-			case ixion::celltype_t::boolean:
+			case OdsReader::CellType::Other:
 				line << QString();
-				DEBUG(Q_FUNC_INFO << ", cell type unknown or boolean not implemented yet.")
+				DEBUG(Q_FUNC_INFO << ", cell type boolean not implemented yet.")
 				break;
 			}
 		}
@@ -544,23 +431,22 @@ QVector<QStringList> OdsFilterPrivate::preview(const QString& sheetName, int lin
 void OdsFilterPrivate::parse(const QString& fileName, QTreeWidgetItem* parentItem) {
 	DEBUG(Q_FUNC_INFO)
 #ifdef HAVE_ORCUS
-	m_document.clear();
-	spreadsheet::import_factory factory{m_document};
-	orcus_ods loader(&factory);
-
-	loader.read_file(fileName.toStdString());
+	m_fileName = fileName;
 
 	auto* fileNameItem = new QTreeWidgetItem(QStringList() << fileName);
 	parentItem->addChild(fileNameItem);
 
-	const size_t nrSheets = m_document.get_sheet_count();
-	for (size_t i = 0; i < nrSheets; i++) {
-		auto name = m_document.get_sheet_name(i);
+	// only the sheet names are read, the content of the sheets is skipped
+	OdsReader reader(fileName);
+	if (!reader.open())
+		return;
 
-		auto* sheetItem = new QTreeWidgetItem(QStringList() << QString::fromStdString(std::string(name)));
+	while (reader.nextSheet()) {
+		auto* sheetItem = new QTreeWidgetItem(QStringList() << reader.sheetName());
 		sheetItem->setIcon(0, QIcon::fromTheme(QStringLiteral("folder")));
 
 		fileNameItem->addChild(sheetItem);
+		reader.skipSheet();
 	}
 #else
 	Q_UNUSED(fileName)
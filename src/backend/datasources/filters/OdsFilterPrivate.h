@@ -12,10 +12,6 @@
 
 #include "backend/datasources/filters/AbstractFileFilter.h"
 
-#ifdef HAVE_ORCUS
-#include <orcus/spreadsheet/document.hpp>
-#endif
-
 class OdsFilter;
 class QTreeWidgetItem;
 
@@ -39,10 +35,7 @@ public:
 	int firstColumn{1}; // actual start column (including range)
 
 private:
-#ifdef HAVE_ORCUS
-	orcus::spreadsheet::range_size_t m_ss{1048576, 16384};
-	orcus::spreadsheet::document m_document{m_ss};
-#endif
+	QString m_fileName; // file of the last parse(), used for the preview
 };
 
 #endif
@@ -0,0 +1,288 @@
+/*
+	File                 : OdsReader.cpp
+	Project              : LabPlot
+	Description          : Streaming reader for the cells of ODS spreadsheets
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "OdsReader.h"
+#include "backend/lib/macros.h"
+
+#include <KZip>
+
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QXmlStreamReader>
+
+namespace {
+const QString officeNS = QStringLiteral("urn:oasis:names:tc:opendocument:xmlns:office:1.0");
+const QString tableNS = QStringLiteral("urn:oasis:names:tc:opendocument:xmlns:table:1.0");
+const QString textNS = QStringLiteral("urn:oasis:names:tc:opendocument:xmlns:text:1.0");
+
+// date value as days since 1899-12-30 (the default null date of ODS documents)
+double dateValue(const QString& value) {
+	QDateTime dt = QDateTime::fromString(value, Qt::ISODate);
+	if (!dt.isValid())
+		dt = QDateTime(QDate::fromString(value, Qt::ISODate), QTime(0, 0));
+	if (!dt.isValid())
+		return 0.;
+
+	return QDate(1899, 12, 30).daysTo(dt.date()) + dt.time().msecsSinceStartOfDay() / 86400000.;
+}
+
+// time value (ISO 8601 duration like "PT12H30M05S") in days
+double timeValue(const QString& value) {
+	static const QRegularExpression re(QStringLiteral("^(-)?P(?:(\\d+)D)?(?:T(?:(\\d+)H)?(?:(\\d+)M)?(?:([\\d.]+)S)?)?$"));
+	const auto match = re.match(value);
+	if (!match.hasMatch())
+		return 0.;
+
+	const double days = match.captured(2).toDouble() + match.captured(3).toDouble() / 24. + match.captured(4).toDouble() / 1440.
+		+ match.captured(5).toDouble() / 86400.;
+	return match.capturedLength(1) ? -days : days;
+}
+}
+
+bool OdsReader::Range::isValid() const {
+	return first.row >= 0 && first.column >= 0;
+}
+
+void OdsReader::Range::add(int row, int column) {
+	if (!isValid()) {
+		first = {row, column};
+		last = {row, column};
+		return;
+	}
+
+	first.row = std::min(first.row, row);
+	first.column = std::min(first.column, column);
+	last.row = std::max(last.row, row);
+	last.column = std::max(last.column, column);
+}
+
+OdsReader::OdsReader(const QString& fileName)
+	: m_fileName(fileName) {
+}
+
+OdsReader::~OdsReader() = default;
+
+/*!
+ * opens the file and starts reading content.xml from the beginning. The content is decompressed while reading.
+ */
+bool OdsReader::open() {
+	m_reader.reset();
+	m_device.reset();
+	m_sheetName.clear();
+
+	if (!m_zip) {
+		m_zip = std::make_unique<KZip>(m_fileName);
+		if (!m_zip->open(QIODevice::ReadOnly)) {
+			DEBUG(Q_FUNC_INFO << ", ERROR: failed to open " << STDSTRING(m_fileName))
+			m_zip.reset();
+			return false;
+		}
+	}
+
+	const auto* entry = m_zip->directory()->entry(QStringLiteral("content.xml"));
+	if (!entry || !entry->isFile()) {
+		DEBUG(Q_FUNC_INFO << ", ERROR: no content in " << STDSTRING(m_fileName))
+		return false;
+	}
+
+	m_device.reset(static_cast<const KArchiveFile*>(entry)->createDevice());
+	if (!m_device)
+		return false;
+
+	m_reader = std::make_unique<QXmlStreamReader>(m_device.get());
+	return true;
+}
+
+/*!
+ * advances to the next sheet, returns \c false if there are no more sheets.
+ */
+bool OdsReader::nextSheet() {
+	if (!m_reader)
+		return false;
+
+	while (!m_reader->atEnd()) {
+		if (m_reader->readNext() == QXmlStreamReader::StartElement && m_reader->name() == QLatin1String("table") && m_reader->namespaceUri() == tableNS) {
+			m_sheetName = m_reader->attributes().value(tableNS, QLatin1String("name")).toString();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+QString OdsReader::sheetName() const {
+	return m_sheetName;
+}
+
+/*!
+ * passes the non-empty cells of the current sheet to \c visitor.
+ * Returns \c false if the content couldn't be parsed.
+ */
+bool OdsReader::readSheet(const CellVisitor& visitor) {
+	if (!m_reader)
+		return false;
+
+	int row = 0;
+	int depth = 1; // inside of the table element
+	QVector<QPair<int, Cell>> cells;
+	while (!m_reader->atEnd()) {
+		const auto token = m_reader->readNext();
+		if (token == QXmlStreamReader::EndElement) {
+			if (--depth == 0) // end of the sheet
+				return true;
+			continue;
+		}
+		if (token != QXmlStreamReader::StartElement)
+			continue;
+
+		if (m_reader->name() == QLatin1String("table-row") && m_reader->namespaceUri() == tableNS) {
+			const int repeated = std::max(1, m_reader->attributes().value(tableNS, QLatin1String("number-rows-repeated")).toInt());
+			readRow(cells);
+			// empty rows (usually repeated up to the end of the sheet) are only counted
+			for (int i = 0; i < repeated && !cells.isEmpty(); ++i) {
+				for (const auto& cell : qAsConst(cells)) {
+					if (!visitor(row + i, cell.first, cell.second))
+						return true;
+				}
+			}
+			row += repeated;
+		} else // column definitions, header rows, row groups etc.
+			++depth;
+	}
+
+	if (m_reader->hasError()) {
+		DEBUG(Q_FUNC_INFO << ", ERROR: " << STDSTRING(m_reader->errorString()))
+		return false;
+	}
+
+	return true;
+}
+
+void OdsReader::skipSheet() {
+	if (m_reader)
+		m_reader->skipCurrentElement();
+}
+
+/*!
+ * passes the non-empty cells of the sheet \c sheetName to \c visitor.
+ * Returns \c false if the sheet doesn't exist or couldn't be read.
+ */
+bool OdsReader::readSheet(const QString& sheetName, const CellVisitor& visitor) {
+	if (!open())
+		return false;
+
+	while (nextSheet()) {
+		if (m_sheetName == sheetName)
+			return readSheet(visitor);
+		skipSheet();
+	}
+
+	DEBUG(Q_FUNC_INFO << ", sheet not found: " << STDSTRING(sheetName))
+	return false;
+}
+
+// ##############################################################################
+// ############################ private ########################################
+// ##############################################################################
+
+/*!
+ * reads the non-empty cells of the current row together with their column indices, repeated cells are expanded.
+ */
+void OdsReader::readRow(QVector<QPair<int, Cell>>& cells) {
+	cells.clear();
+	int column = 0;
+	Cell cell;
+	while (m_reader->readNextStartElement()) {
+		if (m_reader->namespaceUri() == tableNS
+			&& (m_reader->name() == QLatin1String("table-cell") || m_reader->name() == QLatin1String("covered-table-cell"))) {
+			const int repeated = std::max(1, m_reader->attributes().value(tableNS, QLatin1String("number-columns-repeated")).toInt());
+			readCell(cell);
+			if (cell.type != CellType::Empty) {
+				for (int i = 0; i < repeated; ++i)
+					cells << qMakePair(column + i, cell);
+			}
+			column += repeated;
+		} else
+			m_reader->skipCurrentElement();
+	}
+}
+
+/*!
+ * reads the value of the cell at the current start element.
+ */
+void OdsReader::readCell(Cell& cell) {
+	const auto attributes = m_reader->attributes();
+	const auto valueType = attributes.value(officeNS, QLatin1String("value-type"));
+
+	cell = Cell();
+	bool hasText = false;
+	if (valueType == QLatin1String("float") || valueType == QLatin1String("percentage") || valueType == QLatin1String("currency")) {
+		cell.type = CellType::Numeric;
+		cell.value = attributes.value(officeNS, QLatin1String("value")).toDouble();
+	} else if (valueType == QLatin1String("date")) {
+		cell.type = CellType::Numeric;
+		cell.value = dateValue(attributes.value(officeNS, QLatin1String("date-value")).toString());
+	} else if (valueType == QLatin1String("time")) {
+		cell.type = CellType::Numeric;
+		cell.value = timeValue(attributes.value(officeNS, QLatin1String("time-value")).toString());
+	} else if (valueType == QLatin1String("string")) {
+		cell.type = CellType::String;
+		if (attributes.hasAttribute(officeNS, QLatin1String("string-value"))) {
+			cell.text = attributes.value(officeNS, QLatin1String("string-value")).toString();
+			hasText = true;
+		}
+	} else if (valueType == QLatin1String("boolean")) // not supported yet
+		cell.type = CellType::Other;
+
+	// the text of string cells is given in the paragraphs, annotations etc. are skipped
+	bool firstParagraph = true;
+	while (m_reader->readNextStartElement()) {
+		if (cell.type == CellType::String && !hasText && m_reader->name() == QLatin1String("p") && m_reader->namespaceUri() == textNS) {
+			if (!firstParagraph)
+				cell.text += QLatin1Char('\n');
+			cell.text += readParagraph();
+			firstParagraph = false;
+		} else
+			m_reader->skipCurrentElement();
+	}
+}
+
+/*!
+ * returns the text of the paragraph at the current start element including the text of nested spans.
+ */
+QString OdsReader::readParagraph() {
+	QString text;
+	int depth = 0;
+	while (!m_reader->atEnd()) {
+		const auto token = m_reader->readNext();
+		if (token == QXmlStreamReader::Characters)
+			text += m_reader->text();
+		else if (token == QXmlStreamReader::EndElement) {
+			if (depth-- == 0)
+				break;
+		} else if (token == QXmlStreamReader::StartElement) {
+			const auto name = m_reader->name();
+			if (m_reader->namespaceUri() == textNS && name == QLatin1String("s")) { // spaces
+				const int count = m_reader->attributes().value(textNS, QLatin1String("c")).toInt();
+				text += QString(std::max(1, count), QLatin1Char(' '));
+				m_reader->skipCurrentElement();
+			} else if (m_reader->namespaceUri() == textNS && name == QLatin1String("tab")) {
+				text += QLatin1Char('\t');
+				m_reader->skipCurrentElement();
+			} else if (m_reader->namespaceUri() == textNS && name == QLatin1String("line-break")) {
+				text += QLatin1Char('\n');
+				m_reader->skipCurrentElement();
+			} else if (name == QLatin1String("note") || name == QLatin1String("annotation"))
+				m_reader->skipCurrentElement();
+			else // span, link etc.
+				++depth;
+		}
+	}
+
+	return text;
+}
@@ -0,0 +1,76 @@
+/*
+	File                 : OdsReader.h
+	Project              : LabPlot
+	Description          : Streaming reader for the cells of ODS spreadsheets
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef ODSREADER_H
+#define ODSREADER_H
+
+#include <QString>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+class KZip;
+class QIODevice;
+class QXmlStreamReader;
+
+/*!
+ * Reads the sheets of an ODS file sequentially from content.xml without loading the whole document.
+ * Repeated rows and cells are expanded, only the non-empty cells are passed on.
+ * Cells with formulas provide the result calculated when the document was saved.
+ */
+class OdsReader {
+public:
+	enum class CellType { Empty, Numeric, String, Other };
+
+	struct Cell {
+		CellType type{CellType::Empty};
+		double value{0.}; // float, percentage, currency, date (days since 1899-12-30) and time (days) values
+		QString text;
+	};
+
+	// bounding box of the non-empty cells (0-based)
+	struct Range {
+		struct Address {
+			int row{-1};
+			int column{-1};
+		};
+		Address first;
+		Address last;
+
+		bool isValid() const;
+		void add(int row, int column);
+	};
+
+	// called for the non-empty cells in row-major order, return false to stop reading
+	using CellVisitor = std::function<bool(int row, int column, const Cell&)>;
+
+	explicit OdsReader(const QString& fileName);
+	~OdsReader();
+
+	bool open();
+	bool nextSheet();
+	QString sheetName() const;
+	bool readSheet(const CellVisitor&);
+	void skipSheet();
+
+	bool readSheet(const QString& sheetName, const CellVisitor&);
+
+private:
+	void readRow(QVector<QPair<int, Cell>>& cells);
+	void readCell(Cell&);
+	QString readParagraph();
+
+	const QString m_fileName;
+	std::unique_ptr<KZip> m_zip;
+	std::unique_ptr<QIODevice> m_device;
+	std::unique_ptr<QXmlStreamReader> m_reader;
+	QString m_sheetName;
+};
+
+#endif // ODSREADER_H
@@ -19,9 +19,14 @@
 
 #include <QFileInfo>
 #include <QStack>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtEndian>
 
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <numeric>
 
 #ifdef HAVE_ZIP
 #include <lz4.h>
@@ -271,17 +276,8 @@ void ROOTFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 		DEBUG("first/last = " << first << " " << last << ", nentries = " << nentries)
 
 		QStringList headers;
-		for (const auto& l : columns) {
-			QString lastelement = l.back();
-			bool isArray = false;
-			if (lastelement.at(0) == QLatin1Char('[') && lastelement.at(lastelement.size() - 1) == QLatin1Char(']')) {
-				lastelement.mid(1, lastelement.length() - 2).toUInt(&isArray);
-			}
-			if (!isArray || l.count() == 2)
-				headers << l.join(isArray ? QString() : QLatin1String(":"));
-			else
-				headers << l.first() + QLatin1Char(':') + l.at(1) + l.back();
-		}
+		for (const auto& l : columns)
+			headers << treeColumnName(l);
 
 		std::vector<void*> dataContainer;
 		const int columnOffset = dataSource->prepareImport(dataContainer,
@@ -291,26 +287,13 @@ void ROOTFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 														   headers,
 														   QVector<AbstractColumn::ColumnMode>(columns.size(), AbstractColumn::ColumnMode::Double));
 
-		int c = 0;
-		for (const auto& l : columns) {
-			// DEBUG("column " << c)
-			unsigned int element = 0;
-			QString lastelement = l.back(), leaf = l.front();
-			bool isArray = false;
-			if (lastelement.at(0) == QLatin1Char('[') && lastelement.at(lastelement.size() - 1) == QLatin1Char(']')) {
-				element = lastelement.mid(1, lastelement.length() - 2).toUInt(&isArray);
-				if (!isArray)
-					element = 0;
-				if (l.count() > 2)
-					leaf = l.at(1);
-			} else if (l.count() > 1)
-				leaf = l.at(1);
-
-			QVector<double>& container = *static_cast<QVector<double>*>(dataContainer[c++]);
-			auto data = readTree(pos, l.first(), leaf, (int)element, last);
-			// QDEBUG("DATA = " << data)
+		// all leaves are read in one pass through the tree
+		const auto data = readTree(pos, columns, last);
+		for (int c = 0; c < columns.size(); ++c) {
+			QVector<double>& container = *static_cast<QVector<double>*>(dataContainer[c]);
+			const auto& values = data[c];
 			for (int i = first; i <= last; ++i)
-				container[i - first] = data[i];
+				container[i - first] = i < static_cast<int>(values.size()) ? values[i] : NAN;
 		}
 
 		dataSource->finalizeImport(columnOffset, 0, columns.size() - 1, QString(), importMode);
@@ -439,27 +422,13 @@ QVector<QStringList> ROOTFilterPrivate::previewCurrentObject(const QString& file
 		QVector<QStringList> preview(std::max(last - first + 2, 1));
 		DEBUG("	reading " << preview.size() - 1 << " lines");
 
-		// read data leaf by leaf and set headers
-		for (const auto& l : columns) {
-			unsigned int element = 0;
-			QString lastelement = l.back(), leaf = l.front();
-			bool isArray = false;
-			if (lastelement.at(0) == QLatin1Char('[') && lastelement.at(lastelement.size() - 1) == QLatin1Char(']')) {
-				element = lastelement.mid(1, lastelement.length() - 2).toUInt(&isArray);
-				if (!isArray)
-					element = 0;
-				if (l.count() > 2)
-					leaf = l.at(1);
-			} else if (l.count() > 1)
-				leaf = l.at(1);
-
-			auto data = readTree(pos, l.first(), leaf, (int)element, last);
+		// read data and set headers
+		const auto data = readTree(pos, columns, last);
+		for (int c = 0; c < columns.size(); ++c) {
+			const auto& values = data[c];
 			for (int i = first; i <= last; ++i)
-				preview[i - first] << QString::number(data[i]);
-			if (!isArray || l.count() == 2)
-				preview.last() << l.join(isArray ? QString() : QLatin1String(":"));
-			else
-				preview.last() << l.first() + QLatin1Char(':') + l.at(1) + l.back();
+				preview[i - first] << (i < static_cast<int>(values.size()) ? QString::number(values[i]) : QString());
+			preview.last() << treeColumnName(columns.at(c));
 		}
 
 		return preview;
@@ -509,9 +478,37 @@ std::vector<ROOTData::BinPars> ROOTFilterPrivate::readHistogram(quint64 pos) {
 	return currentROOTData->readHistogram(pos);
 }
 
-std::vector<double> ROOTFilterPrivate::readTree(quint64 pos, const QString& branchName, const QString& leafName, int element, int last) {
-	// QDEBUG("branch/leaf name =" << branchName << " " << leafName << ", element/last =" << element << " " << last)
-	return currentROOTData->listEntries<double>(pos, branchName.toStdString(), leafName.toStdString(), element, last + 1);
+std::vector<std::vector<double>> ROOTFilterPrivate::readTree(quint64 pos, const QVector<QStringList>& columns, int last) {
+	std::vector<ROOTData::LeafSelection> leaves;
+	leaves.reserve(columns.size());
+	for (const auto& l : columns) {
+		unsigned int element = 0;
+		QString lastelement = l.back(), leaf = l.front();
+		bool isArray = false;
+		if (lastelement.at(0) == QLatin1Char('[') && lastelement.at(lastelement.size() - 1) == QLatin1Char(']')) {
+			element = lastelement.mid(1, lastelement.length() - 2).toUInt(&isArray);
+			if (!isArray)
+				element = 0;
+			if (l.count() > 2)
+				leaf = l.at(1);
+		} else if (l.count() > 1)
+			leaf = l.at(1);
+
+		leaves.push_back({l.first().toStdString(), leaf.toStdString(), element});
+	}
+
+	return currentROOTData->listEntries<double>(pos, leaves, last + 1);
+}
+
+QString ROOTFilterPrivate::treeColumnName(const QStringList& column) {
+	const QString& lastelement = column.back();
+	bool isArray = false;
+	if (lastelement.at(0) == QLatin1Char('[') && lastelement.at(lastelement.size() - 1) == QLatin1Char(']'))
+		lastelement.mid(1, lastelement.length() - 2).toUInt(&isArray);
+
+	if (!isArray || column.count() == 2)
+		return column.join(isArray ? QString() : QLatin1String(":"));
+	return column.first() + QLatin1Char(':') + column.at(1) + column.back();
 }
 
 /******************** ROOTData implementation ************************/
@@ -550,6 +547,41 @@ U readcast(char*& s) {
 	return static_cast<U>(read<T>(s));
 }
 
+/// Unsigned integer type of the given size
+template<size_t N>
+struct UnsignedType;
+template<>
+struct UnsignedType<1> {
+	using type = quint8;
+};
+template<>
+struct UnsignedType<2> {
+	using type = quint16;
+};
+template<>
+struct UnsignedType<4> {
+	using type = quint32;
+};
+template<>
+struct UnsignedType<8> {
+	using type = quint64;
+};
+
+/// Read count values with a distance of stride bytes from buffer and cast them to U
+template<class T, class U>
+void readcastArray(const char* s, size_t count, size_t stride, U* values) {
+	// the byte order of the whole buffer is swapped in a tight loop the compiler can vectorize
+	using Bits = typename UnsignedType<sizeof(T)>::type;
+	for (size_t i = 0; i < count; ++i, s += stride) {
+		Bits bits;
+		std::memcpy(&bits, s, sizeof(T));
+		bits = qFromBigEndian(bits);
+		T val;
+		std::memcpy(&val, &bits, sizeof(T));
+		values[i] = static_cast<U>(val);
+	}
+}
+
 /// Get version of ROOT object, obtain number of bytes in object
 short Version(char*& buffer, size_t& count) {
 	// root/io/io/src/TBufferFile.cxx -> ReadVersion
@@ -1051,9 +1083,8 @@ std::vector<ROOTData::LeafInfo> ROOTData::listLeaves(long int pos) const {
 }
 
 template<class T>
-std::vector<T>
-ROOTData::listEntries(long int pos, const std::string& branchname, const std::string& leafname, const size_t element, const size_t nentries) const {
-	std::vector<T> entries;
+std::vector<std::vector<T>> ROOTData::listEntries(long int pos, const std::vector<LeafSelection>& leaves, const size_t nentries) const {
+	std::vector<std::vector<T>> entries(leaves.size());
 
 	auto it = treekeys.find(pos);
 	if (it == treekeys.end())
@@ -1074,9 +1105,21 @@ ROOTData::listEntries(long int pos, const std::string& branchname, const std::st
 		Version(buf); // TNtuple(D)
 	Version(buf); // TTree
 	advanceTo(buf, streamerTTree, std::string(), "fEntries", counts);
-	entries.reserve(std::min(static_cast<size_t>(read<long int>(buf)), nentries)); // reserve space (maximum for number of entries)
+	const size_t maxentries = std::min(static_cast<size_t>(read<long int>(buf)), nentries);
+	for (auto& e : entries)
+		e.reserve(maxentries); // reserve space (maximum for number of entries)
 	advanceTo(buf, streamerTTree, "fEntries", "fBranches", counts);
 
+	// position of the requested leaves inside the entries of a branch
+	struct LeafLayout {
+		size_t index; // index in leaves
+		int offset;
+		int size;
+		int content;
+		bool sign;
+		ContentType type;
+	};
+
 	// read the list of branches
 	Version(buf); // TObjArray
 	SkipObject(buf);
@@ -1098,6 +1141,16 @@ ROOTData::listEntries(long int pos, const std::string& branchname, const std::st
 			const std::string currentbranch = String(buf);
 			String(buf);
 
+			std::vector<LeafLayout> layouts;
+			for (size_t l = 0; l < leaves.size(); ++l) {
+				if (leaves[l].branch == currentbranch)
+					layouts.push_back({l, 0, 0, 0, false, ContentType::Invalid});
+			}
+			if (layouts.empty()) {
+				buf = nbuf;
+				continue;
+			}
+
 			advanceTo(buf, streamerTBranch, "TNamed", "fWriteBasket", counts);
 			int fWriteBasket = read<int>(buf);
 			// TODO add reading of nested branches (fBranches)
@@ -1109,48 +1162,58 @@ ROOTData::listEntries(long int pos, const std::string& branchname, const std::st
 			String(buf);
 			const size_t nleaves = read<int>(buf);
 			const size_t lowb = read<int>(buf);
-			int leafoffset = 0, leafcount = 0, leafcontent = 0, leafsize = 0;
-			bool leafsign = false;
-			ContentType leaftype = ContentType::Invalid;
+			int leafcount = 0;
 			for (size_t i = 0; i < nleaves; ++i) {
 				std::string clname = readObject(buf, buf0, tags);
 				Version(buf, count); // TLeaf(D/F/L/I/S/B/O/C/Element)
 				char* nbuf = buf + count;
-				if (currentbranch == branchname) {
-					if (i >= lowb && clname.size() >= 5 && clname.compare(0, 5, "TLeaf") == 0) {
-						Version(buf); // TLeaf
-						Version(buf); // TNamed
-						SkipObject(buf);
-						const bool istheleaf = (clname.size() == 6 && leafname == String(buf));
-						String(buf);
-						const int len = read<int>(buf);
-						const int size = read<int>(buf);
-						if (istheleaf) {
-							leafoffset = leafcount;
-							leafsize = size;
-							leaftype = leafType(clname.back());
-						}
-						leafcount += len * size;
-						if (istheleaf) {
-							leafcontent = leafcount - leafoffset;
-							buf += 1;
-							leafsign = !read<bool>(buf);
+				if (i >= lowb && clname.size() >= 5 && clname.compare(0, 5, "TLeaf") == 0) {
+					Version(buf); // TLeaf
+					Version(buf); // TNamed
+					SkipObject(buf);
+					std::string name;
+					if (clname.size() == 6)
+						name = String(buf);
+					String(buf);
+					const int len = read<int>(buf);
+					const int size = read<int>(buf);
+					const int leafoffset = leafcount;
+					leafcount += len * size;
+					bool leafsign = false;
+					if (!name.empty()) {
+						buf += 1;
+						leafsign = !read<bool>(buf);
+					}
+					for (auto& layout : layouts) {
+						if (!name.empty() && leaves[layout.index].leaf == name) {
+							layout.offset = leafoffset;
+							layout.size = size;
+							layout.content = leafcount - leafoffset;
+							layout.sign = leafsign;
+							layout.type = leafType(clname.back());
 						}
 					}
 				}
 
 				buf = nbuf;
 			}
-			if (leafcontent == 0) {
+
+			// skip the leaves that were not found and the elements not available
+			for (auto l = layouts.begin(); l != layouts.end();) {
+				const auto& selection = leaves[l->index];
+				if (l->content == 0)
+					l = layouts.erase(l);
+				else if (static_cast<int>(selection.element) * l->size >= l->content) {
+					DEBUG("ROOTData: " << selection.leaf.c_str() << " only contains " << l->content / l->size << " elements.");
+					l = layouts.erase(l);
+				} else
+					++l;
+			}
+			if (layouts.empty()) {
 				buf = nbuf;
 				continue;
 			}
 
-			if (static_cast<int>(element) * leafsize >= leafcontent) {
-				DEBUG("ROOTData: " << leafname.c_str() << " only contains " << leafcontent / leafsize << " elements.");
-				break;
-			}
-
 			advanceTo(buf, streamerTBranch, "fLeaves", "fBaskets", counts);
 			// fBaskets (probably empty)
 			Version(buf, count); // TObjArray
@@ -1165,24 +1228,54 @@ ROOTData::listEntries(long int pos, const std::string& branchname, const std::st
 			}
 			// rewind to the end of fBaskets and look for the fBasketSeek array
 			advanceTo(buf = basketsbuf, streamerTBranch, "fBaskets", "fBasketSeek", counts);
-			auto readf = readType<T>(leaftype, leafsign);
+			std::vector<const KeyBuffer*> baskets;
 			for (int i = 0; i < fWriteBasket; ++i) {
 				long int pos = read<long int>(buf);
 				auto it = basketkeys.find(pos);
-				if (it != basketkeys.end()) {
-					std::string basketbuffer = data(it->second);
-					if (!basketbuffer.empty()) {
-						char* bbuf = &basketbuffer[0];
-						char* const bufend = bbuf + basketbuffer.size();
-						while (bbuf + leafcount <= bufend && entries.size() < nentries) {
-							bbuf += leafoffset + leafsize * element;
-							entries.emplace_back(readf(bbuf));
-							bbuf += leafcount - leafsize * (element + 1) - leafoffset;
-						}
-					}
-				} else {
+				if (it != basketkeys.end())
+					baskets.push_back(&it->second);
+				else
 					DEBUG("ROOTData: fBasketSeek(" << i << "): " << pos << " (not available)")
+			}
+
+			std::vector<ArrayReader<T>> readers;
+			for (const auto& layout : layouts)
+				readers.push_back(readArrayType<T>(layout.type, layout.sign));
+
+			// the baskets are read sequentially and decompressed in parallel in batches of a few baskets per thread
+			const size_t batchSize = 4 * std::max(QThread::idealThreadCount(), 1);
+			for (size_t b = 0; b < baskets.size(); b += batchSize) {
+				const size_t n = std::min(batchSize, baskets.size() - b);
+				std::vector<std::string> basketbuffers(n);
+				for (size_t k = 0; k < n; ++k)
+					basketbuffers[k] = rawData(*baskets[b + k], is);
+
+				QVector<int> indices(static_cast<int>(n));
+				std::iota(indices.begin(), indices.end(), 0);
+				QtConcurrent::blockingMap(indices, [this, &baskets, &basketbuffers, b](int k) {
+					basketbuffers[k] = decompress(*baskets[b + k], basketbuffers[k]);
+				});
+
+				bool complete = true;
+				for (const auto& basketbuffer : basketbuffers) {
+					if (basketbuffer.empty() || leafcount == 0)
+						continue;
+
+					// number of complete entries in the basket
+					const size_t basketentries = basketbuffer.size() / leafcount;
+					for (size_t l = 0; l < layouts.size(); ++l) {
+						const auto& layout = layouts[l];
+						auto& values = entries[layout.index];
+						const size_t count = std::min(basketentries, nentries - values.size());
+						const size_t old = values.size();
+						values.resize(old + count);
+						readers[l](basketbuffer.data() + layout.offset + layout.size * leaves[layout.index].element, count, leafcount, values.data() + old);
+					}
 				}
+				for (const auto& layout : layouts)
+					complete = complete && entries[layout.index].size() >= nentries;
+				if (complete)
+					break;
 			}
 		}
 
@@ -1261,32 +1354,64 @@ T (*ROOTData::readType(ROOTData::ContentType type, bool sign) const)
 	return readcast<char, T>;
 }
 
+template<class T>
+ROOTData::ArrayReader<T> ROOTData::readArrayType(ROOTData::ContentType type, bool sign) const {
+	switch (type) {
+	case ContentType::Double:
+		return readcastArray<double, T>;
+	case ContentType::Float:
+		return readcastArray<float, T>;
+	case ContentType::Long:
+		return sign ? readcastArray<qint64, T> : readcastArray<quint64, T>;
+	case ContentType::Int:
+		return sign ? readcastArray<qint32, T> : readcastArray<quint32, T>;
+	case ContentType::Short:
+		return sign ? readcastArray<qint16, T> : readcastArray<quint16, T>;
+	case ContentType::Byte:
+		return sign ? readcastArray<qint8, T> : readcastArray<quint8, T>;
+	case ContentType::Bool:
+		return readcastArray<bool, T>;
+	case ContentType::CString:
+	case ContentType::Tree:
+	case ContentType::NTuple:
+	case ContentType::Basket:
+	case ContentType::Streamer:
+	case ContentType::Invalid:
+		break;
+	}
+	return readcastArray<char, T>;
+}
+
 std::string ROOTData::data(const ROOTData::KeyBuffer& buffer) const {
 	std::ifstream is(filename, std::ifstream::binary);
 	return data(buffer, is);
 }
 
 std::string ROOTData::data(const ROOTData::KeyBuffer& buffer, std::ifstream& is) const {
-	std::string data(buffer.count, 0);
+	return decompress(buffer, rawData(buffer, is));
+}
+
+std::string ROOTData::rawData(const ROOTData::KeyBuffer& buffer, std::ifstream& is) const {
+	std::string raw(buffer.compression == KeyBuffer::CompressionType::none ? buffer.count : buffer.compressed_count, 0);
 	is.seekg(buffer.start);
-	if (buffer.compression == KeyBuffer::CompressionType::none) {
-		is.read(&data[0], buffer.count);
-		return data;
+	is.read(&raw[0], raw.size());
+	return raw;
+}
+
+std::string ROOTData::decompress(const ROOTData::KeyBuffer& buffer, const std::string& raw) const {
+	if (buffer.compression == KeyBuffer::CompressionType::none)
+		return raw;
 #ifdef HAVE_ZIP
-	} else if (buffer.compression == KeyBuffer::CompressionType::zlib) {
-		std::string cdata(buffer.compressed_count, 0);
-		is.read(&cdata[0], buffer.compressed_count);
+	std::string data(buffer.count, 0);
+	if (buffer.compression == KeyBuffer::CompressionType::zlib) {
 		uLongf luncomp = (uLongf)buffer.count;
-		if (uncompress((Bytef*)data.data(), &luncomp, (Bytef*)cdata.data(), (uLong)cdata.size()) == Z_OK && data.size() == luncomp)
+		if (uncompress((Bytef*)data.data(), &luncomp, (Bytef*)raw.data(), (uLong)raw.size()) == Z_OK && data.size() == luncomp)
 			return data;
 	} else {
-		std::string cdata(buffer.compressed_count, 0);
-		is.read(&cdata[0], buffer.compressed_count);
-		if (LZ4_decompress_safe(cdata.data(), const_cast<char*>(data.data()), (int)buffer.compressed_count, (int)buffer.count)
-			== static_cast<int>(buffer.count))
+		if (LZ4_decompress_safe(raw.data(), const_cast<char*>(data.data()), (int)buffer.compressed_count, (int)buffer.count) == static_cast<int>(buffer.count))
 			return data;
-#endif
 	}
+#endif
 
 	return {};
 }
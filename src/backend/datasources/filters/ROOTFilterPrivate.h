@@ -109,6 +109,26 @@ public:
 	 */
 	std::vector<LeafInfo> listLeaves(long int pos) const;
 
+	/// Leaf to be read from a tree
+	struct LeafSelection {
+		std::string branch;
+		std::string leaf;
+		size_t element; ///< Index, if leaf is an array
+	};
+
+	/**
+	 * @brief Get entries of several leaves
+	 *
+	 * The tree is parsed once and every basket of the branches is decompressed once,
+	 * also if several leaves of the same branch are read. The baskets are decompressed in parallel.
+	 *
+	 * @param[in] pos Position of the tree inside the file
+	 * @param[in] leaves Leaves to be read
+	 * @param[in] nentries Maximum number of entries to be read
+	 * @return Entries of the leaves in the order of @p leaves, empty for leaves not found in the tree
+	 */
+	template<typename T>
+	std::vector<std::vector<T>> listEntries(long int pos, const std::vector<LeafSelection>& leaves, size_t nentries = std::numeric_limits<size_t>::max()) const;
 	/**
 	 * @brief Get entries of a leaf
 	 *
@@ -123,7 +143,9 @@ public:
 							   const std::string& branchname,
 							   const std::string& leafname,
 							   size_t element = 0,
-							   size_t nentries = std::numeric_limits<size_t>::max()) const;
+							   size_t nentries = std::numeric_limits<size_t>::max()) const {
+		return std::move(listEntries<T>(pos, {LeafSelection{branchname, leafname, element}}, nentries).front());
+	}
 	/**
 	 * @brief Get entries of a leaf with the same name as its branch
 	 *
@@ -212,6 +234,12 @@ private:
 	template<class T>
 	T (*readType(ContentType type, bool sign = true) const)
 	(char*&);
+	/// Function to read an array of values with a fixed distance in bytes from a buffer
+	template<class T>
+	using ArrayReader = void (*)(const char* buffer, size_t count, size_t stride, T* values);
+	/// Get function to read an array of the specified type
+	template<class T>
+	ArrayReader<T> readArrayType(ContentType type, bool sign = true) const;
 
 	/// Get the number of bins contained in a histogram
 	void readNBins(KeyBuffer& buffer);
@@ -221,6 +249,10 @@ private:
 	std::string data(const KeyBuffer& buffer) const;
 	/// Get buffer from file content at histogram position, uses already opened stream
 	std::string data(const KeyBuffer& buffer, std::ifstream& is) const;
+	/// Read the (compressed) content of the buffer from an already opened stream
+	std::string rawData(const KeyBuffer& buffer, std::ifstream& is) const;
+	/// Decompress the content of the buffer read with rawData()
+	std::string decompress(const KeyBuffer& buffer, const std::string& raw) const;
 	/// Load streamer information
 	void readStreamerInfo(const KeyBuffer& buffer);
 	/**
@@ -307,8 +339,10 @@ private:
 	bool setFile(const QString& fileName);
 	/// Calls ReadHistogram from ROOTData
 	std::vector<ROOTData::BinPars> readHistogram(quint64 pos);
-	/// Calls listEntries from ROOTData
-	std::vector<double> readTree(quint64 pos, const QString& branchName, const QString& leafName, int element, int last);
+	/// Calls listEntries from ROOTData for all columns
+	std::vector<std::vector<double>> readTree(quint64 pos, const QVector<QStringList>& columns, int last);
+	/// Header of a tree column
+	static QString treeColumnName(const QStringList& column);
 
 	/// Information about currently set ROOT file
 	struct {
@@ -11,12 +11,15 @@
 #include "backend/core/column/Column.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
 #include <QDateTime>
 #include <QFile>
 
+#include <algorithm>
+
 ///////////// macros ///////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////
@@ -184,183 +187,214 @@ QString ReadStatFilter::fileInfoString(const QString& fileName) {
 // ################### Private implementation ##########################
 // #####################################################################
 
-// static members (needed by C callbacks)
-int ReadStatFilterPrivate::m_varCount = 0;
-int ReadStatFilterPrivate::m_rowCount = 0;
-QStringList ReadStatFilterPrivate::varNames;
-QVector<AbstractColumn::ColumnMode> ReadStatFilterPrivate::columnModes;
-QStringList ReadStatFilterPrivate::m_lineString;
-QVector<QStringList> ReadStatFilterPrivate::dataStrings;
-std::vector<void*> ReadStatFilterPrivate::m_dataContainer;
-QStringList ReadStatFilterPrivate::m_notes;
-QVector<QString> ReadStatFilterPrivate::m_valueLabels;
-QMap<QString, LabelSet> ReadStatFilterPrivate::m_labelSets;
-int ReadStatFilterPrivate::startRow{1}, ReadStatFilterPrivate::endRow{-1};
-int ReadStatFilterPrivate::startColumn{1}, ReadStatFilterPrivate::endColumn{-1};
+namespace {
+/*!
+ * sets \c value in row \c row of the buffer \c values. Rows not provided by the parser are set to \c empty.
+ */
+template<typename T>
+void setBufferValue(QVector<T>& values, int row, const T& value, const T& empty) {
+	if (row == values.size()) // rows are provided in order
+		values << value;
+	else if (row < values.size())
+		values[row] = value;
+	else {
+		values.insert(values.size(), row - values.size(), empty);
+		values << value;
+	}
+}
+
+/*!
+ * moves \c values into the data container \c data of a column, the values are copied
+ * if the column has more rows than values, i.e. when appending to a larger spreadsheet.
+ */
+template<typename T>
+void moveValues(QVector<T>& values, void* data) {
+	auto* vector = static_cast<QVector<T>*>(data);
+	if (vector->size() == values.size())
+		vector->swap(values);
+	else
+		std::copy_n(values.constBegin(), std::min(values.size(), vector->size()), vector->begin());
+}
+} // namespace
+
+ReadStatFilterPrivate::ReadStatFilterPrivate(ReadStatFilter*) {
+}
+
+bool ReadStatFilterPrivate::isSelectedColumn(int col) const {
+	return col >= startColumn - 1 && (endColumn == -1 || col <= endColumn - 1);
+}
 
 #ifdef HAVE_READSTAT
 // callbacks
-int ReadStatFilterPrivate::getMetaData(readstat_metadata_t* metadata, void*) {
+int ReadStatFilterPrivate::getMetaData(readstat_metadata_t* metadata, void* ptr) {
 	DEBUG(Q_FUNC_INFO)
-	m_varCount = readstat_get_var_count(metadata);
-	m_rowCount = readstat_get_row_count(metadata);
-	m_valueLabels.resize(m_varCount);
+	auto* d = static_cast<ReadStatFilterPrivate*>(ptr);
+	d->m_varCount = readstat_get_var_count(metadata);
+	d->m_rowCount = readstat_get_row_count(metadata);
 
 	return READSTAT_HANDLER_OK;
 }
-int ReadStatFilterPrivate::getVarName(int /*index*/, readstat_variable_t* variable, const char* val_labels, void*) {
-	// DEBUG(Q_FUNC_INFO)
-
+int ReadStatFilterPrivate::getVarName(int /*index*/, readstat_variable_t* variable, const char* val_labels, void* ptr) {
 	// only on column from startColumn to endColumn
+	auto* d = static_cast<ReadStatFilterPrivate*>(ptr);
 	const int col = readstat_variable_get_index(variable);
-	if (col < startColumn - 1 || (endColumn != -1 && col > endColumn - 1)) {
-		// DEBUG(Q_FUNC_INFO << ", out of range row/col "<< index << " / " << col)
+	if (!d->isSelectedColumn(col))
 		return READSTAT_HANDLER_OK;
-	}
 
 	if (val_labels) {
 		DEBUG(Q_FUNC_INFO << ", val_labels of col " << col << " : " << val_labels)
-		m_valueLabels[col] = QLatin1String(val_labels);
-		varNames << QLatin1String(readstat_variable_get_name(variable)) + QStringLiteral(" : ") + QLatin1String(val_labels);
-	} else
-		varNames << QLatin1String(readstat_variable_get_name(variable));
-
-	return READSTAT_HANDLER_OK;
-}
-int ReadStatFilterPrivate::getColumnModes(int row, readstat_variable_t* variable, readstat_value_t value, void*) {
-	if (row >= m_rowCount) // more rows found than meta data said it has (like -1)
-		m_rowCount = row + 1;
-
-	const int col = readstat_variable_get_index(variable);
-	if (row >= startRow || col < startColumn - 1 || (endColumn != -1 && col > endColumn - 1)) // run only on first row and selected cols
-		return READSTAT_HANDLER_OK;
+		d->m_valueLabels << QLatin1String(val_labels);
+		d->varNames << QLatin1String(readstat_variable_get_name(variable)) + QStringLiteral(" : ") + QLatin1String(val_labels);
+	} else {
+		d->m_valueLabels << QString();
+		d->varNames << QLatin1String(readstat_variable_get_name(variable));
+	}
 
-	// column modes
-	switch (value.type) {
+	// column mode from the type of the variable
+	auto mode = AbstractColumn::ColumnMode::Double;
+	switch (readstat_variable_get_type(variable)) {
 	case READSTAT_TYPE_INT8:
 	case READSTAT_TYPE_INT16:
 	case READSTAT_TYPE_INT32:
-		columnModes << AbstractColumn::ColumnMode::Integer;
+		mode = AbstractColumn::ColumnMode::Integer;
 		break;
 	case READSTAT_TYPE_FLOAT:
 	case READSTAT_TYPE_DOUBLE:
-		columnModes << AbstractColumn::ColumnMode::Double;
+		mode = AbstractColumn::ColumnMode::Double;
 		break;
 	case READSTAT_TYPE_STRING:
 	case READSTAT_TYPE_STRING_REF:
-		columnModes << AbstractColumn::ColumnMode::Text;
+		mode = AbstractColumn::ColumnMode::Text;
 	}
+	d->columnModes << mode;
+
+	ColumnBuffer buffer;
+	buffer.mode = mode;
+	if (d->m_rowCount > 0) { // the row count is -1 if not provided by the file
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			buffer.doubles.reserve(d->m_rowCount);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			buffer.integers.reserve(d->m_rowCount);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			buffer.texts.reserve(d->m_rowCount);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+	d->m_buffers.push_back(std::move(buffer));
 
 	return READSTAT_HANDLER_OK;
 }
-int ReadStatFilterPrivate::getValuesPreview(int row, readstat_variable_t* variable, readstat_value_t value, void* ptr) {
-	// DEBUG(Q_FUNC_INFO << ", start/end row =" << startRow << "/" << endRow)
-
-	// read only from start to end row/column
+int ReadStatFilterPrivate::getValuesPreview(int /*row*/, readstat_variable_t* variable, readstat_value_t value, void* ptr) {
+	// the rows before the start row and after the preview lines are skipped by the parser
+	auto* d = static_cast<ReadStatFilterPrivate*>(ptr);
 	const int col = readstat_variable_get_index(variable);
-	if (row < startRow - 1 || (endRow != -1 && row > endRow - 1) || col < startColumn - 1 || (endColumn != -1 && col > endColumn - 1)) {
-		// DEBUG(Q_FUNC_INFO << ", out of range row/col "<< row << " / " << col)
+	if (!d->isSelectedColumn(col))
 		return READSTAT_HANDLER_OK;
-	}
-
-	if (row == startRow - 1)
-		getColumnModes(row, variable, value, ptr);
 
 	// read values into m_lineString and finally into dataStrings
-	if (col == startColumn - 1)
-		m_lineString.clear();
+	if (col == d->startColumn - 1)
+		d->m_lineString.clear();
 
 	if (value.is_system_missing) {
-		m_lineString << QString();
+		d->m_lineString << QString();
 	} else {
 		switch (value.type) {
 		case READSTAT_TYPE_INT8:
-			m_lineString << QString::number(readstat_int8_value(value));
+			d->m_lineString << QString::number(readstat_int8_value(value));
 			break;
 		case READSTAT_TYPE_INT16:
-			m_lineString << QString::number(readstat_int16_value(value));
+			d->m_lineString << QString::number(readstat_int16_value(value));
 			break;
 		case READSTAT_TYPE_INT32:
-			m_lineString << QString::number(readstat_int32_value(value));
+			d->m_lineString << QString::number(readstat_int32_value(value));
 			break;
 		case READSTAT_TYPE_FLOAT:
-			m_lineString << QString::number(readstat_float_value(value));
+			d->m_lineString << QString::number(readstat_float_value(value));
 			break;
 		case READSTAT_TYPE_DOUBLE:
-			m_lineString << QString::number(readstat_double_value(value));
+			d->m_lineString << QString::number(readstat_double_value(value));
 			break;
 		case READSTAT_TYPE_STRING:
 		case READSTAT_TYPE_STRING_REF:
-			m_lineString << QLatin1String(readstat_string_value(value));
+			d->m_lineString << QLatin1String(readstat_string_value(value));
 		}
 	}
 
-	if (col == m_varCount - 1 || (endColumn != -1 && col == endColumn - 1)) {
-		// QDEBUG(Q_FUNC_INFO << ", data line = " << m_lineString)
-		dataStrings << m_lineString;
+	if (col == d->m_varCount - 1 || (d->endColumn != -1 && col == d->endColumn - 1)) {
+		d->dataStrings << d->m_lineString;
 	}
 
 	return READSTAT_HANDLER_OK;
 }
-int ReadStatFilterPrivate::getValues(int row, readstat_variable_t* variable, readstat_value_t value, void*) {
-	// only read from start to end row/col
+int ReadStatFilterPrivate::getValues(int row, readstat_variable_t* variable, readstat_value_t value, void* ptr) {
+	// the rows outside of the row range are skipped by the parser, the row is relative to the start row
+	auto* d = static_cast<ReadStatFilterPrivate*>(ptr);
 	const int col = readstat_variable_get_index(variable);
-	if (row < startRow - 1 || (endRow != -1 && row > endRow - 1) || col < startColumn - 1 || (endColumn != -1 && col > endColumn - 1)) {
-		// DEBUG(Q_FUNC_INFO << ", out of range row/col "<< row << " / " << col)
+	if (!d->isSelectedColumn(col))
 		return READSTAT_HANDLER_OK;
-	}
-	const int rowIndex = row - startRow + 1;
-	const int colIndex = col - startColumn + 1;
-
-	// DEBUG(Q_FUNC_INFO << ", row/col = " << row << " / " << col << ", row/col index = " << rowIndex << " / " << colIndex)
 
-	// import data
-	if (value.is_system_missing) { // empty
-		if (value.type == READSTAT_TYPE_FLOAT || value.type == READSTAT_TYPE_DOUBLE) {
-			QVector<double>& container = *static_cast<QVector<double>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = NAN;
-		}
-	} else {
-		switch (value.type) {
-		case READSTAT_TYPE_INT8: {
-			QVector<int>& container = *static_cast<QVector<int>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = readstat_int8_value(value);
-			break;
-		}
-		case READSTAT_TYPE_INT16: {
-			QVector<int>& container = *static_cast<QVector<int>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = readstat_int16_value(value);
-			break;
-		}
-		case READSTAT_TYPE_INT32: {
-			QVector<int>& container = *static_cast<QVector<int>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = readstat_int32_value(value);
-			break;
-		}
-		case READSTAT_TYPE_FLOAT: {
-			QVector<double>& container = *static_cast<QVector<double>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = readstat_float_value(value);
-			break;
-		}
-		case READSTAT_TYPE_DOUBLE: {
-			QVector<double>& container = *static_cast<QVector<double>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = readstat_double_value(value);
-			break;
-		}
-		case READSTAT_TYPE_STRING:
-		case READSTAT_TYPE_STRING_REF: {
-			QVector<QString>& container = *static_cast<QVector<QString>*>(m_dataContainer[colIndex]);
-			container[rowIndex] = QLatin1String(readstat_string_value(value));
+	auto& buffer = d->m_buffers[col - d->startColumn + 1];
+	switch (buffer.mode) {
+	case AbstractColumn::ColumnMode::Double: {
+		double v = NAN;
+		if (!value.is_system_missing) {
+			if (value.type == READSTAT_TYPE_FLOAT)
+				v = readstat_float_value(value);
+			else
+				v = readstat_double_value(value);
 		}
+		setBufferValue(buffer.doubles, row, v, (double)NAN);
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		int v = 0;
+		if (!value.is_system_missing) {
+			switch (value.type) {
+			case READSTAT_TYPE_INT8:
+				v = readstat_int8_value(value);
+				break;
+			case READSTAT_TYPE_INT16:
+				v = readstat_int16_value(value);
+				break;
+			case READSTAT_TYPE_INT32:
+				v = readstat_int32_value(value);
+				break;
+			case READSTAT_TYPE_FLOAT: // not used for integer variables
+			case READSTAT_TYPE_DOUBLE:
+			case READSTAT_TYPE_STRING:
+			case READSTAT_TYPE_STRING_REF:
+				break;
+			}
 		}
+		setBufferValue(buffer.integers, row, v, 0);
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		const QString v = value.is_system_missing ? QString() : QString(QLatin1String(readstat_string_value(value)));
+		setBufferValue(buffer.texts, row, v, QString());
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: // not used by readstat
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
 	}
 
 	return READSTAT_HANDLER_OK;
 }
-int ReadStatFilterPrivate::getNotes(int index, const char* note, void*) {
+int ReadStatFilterPrivate::getNotes(int index, const char* note, void* ptr) {
 	Q_UNUSED(index)
 	DEBUG(Q_FUNC_INFO << " note " << index << ": " << note)
-	m_notes << QLatin1String(note);
+	static_cast<ReadStatFilterPrivate*>(ptr)->m_notes << QLatin1String(note);
 
 	return READSTAT_HANDLER_OK;
 }
@@ -372,81 +406,88 @@ int ReadStatFilterPrivate::getFWeights(readstat_variable_t* /*var*/, void*) {
 	return READSTAT_HANDLER_OK;
 }
 // value labels are read in getVarName() and assigned here
-int ReadStatFilterPrivate::getValueLabels(const char* val_label, readstat_value_t value, const char* label, void*) {
+int ReadStatFilterPrivate::getValueLabels(const char* val_label, readstat_value_t value, const char* label, void* ptr) {
 	// see https://github.com/tidyverse/haven/blob/master/src/DfReader.cpp
 	DEBUG(Q_FUNC_INFO << ", value label = " << val_label << " label = " << label << ", type = " << value.type)
 
-	LabelSet& labelSet = m_labelSets[QLatin1String(val_label)];
+	LabelSet& labelSet = static_cast<ReadStatFilterPrivate*>(ptr)->m_labelSets[QLatin1String(val_label)];
 	switch (value.type) {
 	case READSTAT_TYPE_STRING:
 	case READSTAT_TYPE_STRING_REF:
-		// DEBUG(Q_FUNC_INFO << ", string value label")
 		labelSet.add(QLatin1String(readstat_string_value(value)), QLatin1String(label));
 		break;
 	case READSTAT_TYPE_INT8:
-		// DEBUG(Q_FUNC_INFO << ", int8 value label")
 		labelSet.add(readstat_int8_value(value), QLatin1String(label));
 		break;
 	case READSTAT_TYPE_INT16:
-		// DEBUG(Q_FUNC_INFO << ", int16 value label")
 		labelSet.add(readstat_int16_value(value), QLatin1String(label));
 		break;
 	case READSTAT_TYPE_INT32:
-		// DEBUG(Q_FUNC_INFO << ", int32 value label")
 		labelSet.add(readstat_int32_value(value), QLatin1String(label));
 		break;
 	case READSTAT_TYPE_FLOAT:
-		// DEBUG(Q_FUNC_INFO << ", float value label")
 		labelSet.add(readstat_float_value(value), QLatin1String(label));
 		break;
 	case READSTAT_TYPE_DOUBLE:
-		// DEBUG(Q_FUNC_INFO << ", double value label")
 		labelSet.add(readstat_double_value(value), QLatin1String(label));
 		break;
 	}
 
 	return READSTAT_HANDLER_OK;
 }
-#endif
-
-ReadStatFilterPrivate::ReadStatFilterPrivate(ReadStatFilter*) {
-}
 
-#ifdef HAVE_READSTAT
 /*!
- * parse the file with name fileName
+ * parses the file \c fileName in one pass, the meta data, the variables and the values of the rows in the row range,
+ * or of \c previewLines rows starting at the start row for the \c preview, are provided to the callbacks.
+ * The state of the parser is kept in this instance so several files can be parsed at the same time.
  */
-readstat_error_t ReadStatFilterPrivate::parse(const QString& fileName, bool preview, bool prepare) {
+readstat_error_t ReadStatFilterPrivate::parse(const QString& fileName, bool preview, int previewLines) {
 	DEBUG(Q_FUNC_INFO << ", file " << STDSTRING(fileName) << ", start/end row: " << startRow << "/" << endRow)
+	m_varCount = 0;
+	m_rowCount = 0;
+	m_buffers.clear();
+	m_valueLabels.clear();
 	m_labelSets.clear();
+	m_notes.clear();
+	varNames.clear();
+	columnModes.clear();
+	dataStrings.clear();
 
 	readstat_parser_t* parser = readstat_parser_init();
 	readstat_set_metadata_handler(parser, &getMetaData); // metadata
 	readstat_set_variable_handler(parser, &getVarName); // header
 	if (preview) // get data and save into dataStrings
 		readstat_set_value_handler(parser, &getValuesPreview);
-	else if (prepare) // only read column modes
-		readstat_set_value_handler(parser, &getColumnModes);
-	else { // get and save data into data container
+	else { // get and save data into the column buffers
 		readstat_set_value_handler(parser, &getValues);
 		readstat_set_note_handler(parser, &getNotes);
 	}
 	readstat_set_fweight_handler(parser, &getFWeights);
 	readstat_set_value_label_handler(parser, &getValueLabels);
 
+	// let the parser skip the rows outside of the row range instead of reading all rows of large files
+	if (startRow > 1)
+		readstat_set_row_offset(parser, startRow - 1);
+	int rowLimit = (endRow == -1) ? 0 : endRow - startRow + 1;
+	if (preview && (rowLimit == 0 || rowLimit > previewLines))
+		rowLimit = previewLines;
+	if (rowLimit > 0)
+		readstat_set_row_limit(parser, rowLimit);
+
+	const QByteArray name = fileName.toLocal8Bit();
 	readstat_error_t error = READSTAT_OK;
 	if (fileName.endsWith(QLatin1String(".dta")))
-		error = readstat_parse_dta(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_dta(parser, name.constData(), this);
 	else if (fileName.endsWith(QLatin1String(".sav")) || fileName.endsWith(QLatin1String(".zsav")))
-		error = readstat_parse_sav(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_sav(parser, name.constData(), this);
 	else if (fileName.endsWith(QLatin1String(".por")))
-		error = readstat_parse_por(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_por(parser, name.constData(), this);
 	else if (fileName.endsWith(QLatin1String(".sas7bdat")))
-		error = readstat_parse_sas7bdat(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_sas7bdat(parser, name.constData(), this);
 	else if (fileName.endsWith(QLatin1String(".sas7bcat")))
-		error = readstat_parse_sas7bcat(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_sas7bcat(parser, name.constData(), this);
 	else if (fileName.endsWith(QLatin1String(".xpt")) || fileName.endsWith(QLatin1String(".xpt5")) || fileName.endsWith(QLatin1String(".xpt8")))
-		error = readstat_parse_xport(parser, qPrintable(fileName), nullptr);
+		error = readstat_parse_xport(parser, name.constData(), this);
 	else {
 		DEBUG(Q_FUNC_INFO << ", ERROR: Unknown file extension")
 	}
@@ -460,16 +501,8 @@ readstat_error_t ReadStatFilterPrivate::parse(const QString& fileName, bool prev
  * generates the preview for the file \c fileName reading the provided number of \c lines.
  */
 QVector<QStringList> ReadStatFilterPrivate::preview(const QString& fileName, int lines) {
-	// set max. number of lines to preview by setting endRow
-	if (endRow == -1 || endRow > startRow + lines - 1)
-		endRow = startRow + lines - 1;
-
-	varNames.clear();
-	columnModes.clear();
-	dataStrings.clear();
-
 #ifdef HAVE_READSTAT
-	readstat_error_t error = parse(fileName, true); // lines?
+	readstat_error_t error = parse(fileName, true, lines);
 
 	if (error == READSTAT_OK) {
 		DEBUG(Q_FUNC_INFO << ", var count = " << m_varCount)
@@ -482,6 +515,7 @@ QVector<QStringList> ReadStatFilterPrivate::preview(const QString& fileName, int
 	}
 #else
 	Q_UNUSED(fileName)
+	Q_UNUSED(lines)
 #endif
 
 	return dataStrings;
@@ -495,85 +529,92 @@ void ReadStatFilterPrivate::readDataFromFile(const QString& fileName, AbstractDa
 	DEBUG(Q_FUNC_INFO << ", fileName = \'" << STDSTRING(fileName) << "\', dataSource = " << dataSource
 					  << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, mode));
 
-	varNames.clear();
-	columnModes.clear();
-	dataStrings.clear();
-	m_valueLabels.clear();
-	m_notes.clear();
-
 #ifdef HAVE_READSTAT
-	DEBUG(Q_FUNC_INFO << ", Parsing meta data ...")
-	// parse meta data and column modes only
-	readstat_error_t error = parse(fileName, false, true);
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	// parse the meta data, the variables and the values into the column buffers
+	readstat_error_t error = parse(fileName);
 	if (error != READSTAT_OK) {
-		DEBUG(Q_FUNC_INFO << ", ERROR preparsing file " << STDSTRING(fileName))
+		DEBUG(Q_FUNC_INFO << ", ERROR parsing file " << STDSTRING(fileName))
 		return;
 	}
 
+	const int actualCols = (int)m_buffers.size();
+	int actualRows = 0;
+	for (const auto& buffer : m_buffers)
+		actualRows = std::max(actualRows, (int)std::max({buffer.doubles.size(), buffer.integers.size(), buffer.texts.size()}));
 	DEBUG(Q_FUNC_INFO << ", found " << m_varCount << " cols, " << m_rowCount << " rows")
-
-	// prepare data container
-	const int actualEndRow = (endRow == -1 || endRow > m_rowCount) ? m_rowCount : endRow;
-	const int actualRows = actualEndRow - startRow + 1;
-	const int actualEndColumn = (endColumn == -1 || endColumn > m_varCount) ? m_varCount : endColumn;
-	const int actualCols = actualEndColumn - startColumn + 1;
 	DEBUG(Q_FUNC_INFO << ", actual cols/rows = " << actualCols << " / " << actualRows)
-	const int columnOffset = dataSource->prepareImport(m_dataContainer, mode, actualRows, actualCols, varNames, columnModes);
-
-	error = parse(fileName);
-	if (error != READSTAT_OK) {
-		DEBUG(Q_FUNC_INFO << ", ERROR parsing file " << STDSTRING(fileName))
+	if (!dataSource || actualCols == 0)
 		return;
+
+	// move the buffers into the columns
+	std::vector<void*> dataContainer;
+	const int columnOffset = dataSource->prepareImport(dataContainer, mode, actualRows, actualCols, varNames, columnModes);
+	for (int i = 0; i < actualCols; ++i) {
+		auto& buffer = m_buffers[i];
+		switch (buffer.mode) {
+		case AbstractColumn::ColumnMode::Double:
+			buffer.doubles.resize(actualRows); // missing rows at the end of the column
+			moveValues(buffer.doubles, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			buffer.integers.resize(actualRows);
+			moveValues(buffer.integers, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			buffer.texts.resize(actualRows);
+			moveValues(buffer.texts, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
 	}
+	m_buffers.clear();
 
-	DEBUG(Q_FUNC_INFO << ", column offset = " << columnOffset << " start/end column = " << startColumn << " / " << actualEndColumn)
-	dataSource->finalizeImport(columnOffset, startColumn, actualEndColumn, QString(), mode);
+	DEBUG(Q_FUNC_INFO << ", column offset = " << columnOffset << " columns = " << actualCols)
+	dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), mode);
 
 	// value labels
-	for (const auto& label : m_valueLabels)
-		if (label.size() > 0)
-			QDEBUG(Q_FUNC_INFO << ", label " << label << ", label values = " << m_labelSets[label].labels())
-
-	QVector<Column*> columnList = dataSource->children<Column>();
-	for (int i = 0; i < columnList.size(); i++) {
-		auto* column = columnList.at(i);
-		const QString label = m_valueLabels.at(i);
-		if (column && label.size() > 0) {
-			const auto columnMode = columnModes.at(i);
-			const auto valueLabels = m_labelSets[label].labels();
-			switch (columnMode) {
-			case AbstractColumn::ColumnMode::Text:
-				for (int j = 0; j < valueLabels.size(); j++) {
-					DEBUG(Q_FUNC_INFO << ", column " << i << ": add string value label: " << STDSTRING(m_labelSets[label].valueString(j)) << " = "
-									  << STDSTRING(valueLabels.at(j)))
-					column->addValueLabel(m_labelSets[label].valueString(j), valueLabels.at(j));
-				}
-				break;
-			case AbstractColumn::ColumnMode::Double:
-				for (int j = 0; j < valueLabels.size(); j++) {
-					DEBUG(Q_FUNC_INFO << ", column " << i << ": add double value label: " << m_labelSets[label].valueDouble(j) << " = "
-									  << STDSTRING(valueLabels.at(j)))
-					column->addValueLabel(m_labelSets[label].valueDouble(j), valueLabels.at(j));
-				}
-				break;
-			case AbstractColumn::ColumnMode::Integer:
-			case AbstractColumn::ColumnMode::BigInt:
-				for (int j = 0; j < valueLabels.size(); j++) {
-					DEBUG(Q_FUNC_INFO << ", column " << i << ": add integer value label: " << m_labelSets[label].valueInt(j) << " = "
-									  << STDSTRING(valueLabels.at(j)))
-					column->addValueLabel(m_labelSets[label].valueInt(j), valueLabels.at(j));
-				}
-				break;
-			case AbstractColumn::ColumnMode::Month:
-			case AbstractColumn::ColumnMode::Day:
-			case AbstractColumn::ColumnMode::DateTime:
-				// not support by readstat
-				break;
-			}
+	const auto& columnList = dataSource->children<Column>();
+	for (int i = 0; i < actualCols && columnOffset + i < columnList.size(); i++) {
+		auto* column = columnList.at(columnOffset + i);
+		const QString& label = m_valueLabels.at(i);
+		if (label.isEmpty())
+			continue;
+
+		const auto& labelSet = m_labelSets[label];
+		QDEBUG(Q_FUNC_INFO << ", label " << label << ", label values = " << labelSet.labels())
+		const auto valueLabels = labelSet.labels();
+		switch (columnModes.at(i)) {
+		case AbstractColumn::ColumnMode::Text:
+			for (int j = 0; j < valueLabels.size(); j++)
+				column->addValueLabel(labelSet.valueString(j), valueLabels.at(j));
+			break;
+		case AbstractColumn::ColumnMode::Double:
+			for (int j = 0; j < valueLabels.size(); j++)
+				column->addValueLabel(labelSet.valueDouble(j), valueLabels.at(j));
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+		case AbstractColumn::ColumnMode::BigInt:
+			for (int j = 0; j < valueLabels.size(); j++)
+				column->addValueLabel(labelSet.valueInt(j), valueLabels.at(j));
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::DateTime:
+			// not support by readstat
+			break;
 		}
 	}
 
 	dataSource->setComment(m_notes.join(QLatin1Char('\n')));
+#else
+	Q_UNUSED(fileName)
+	Q_UNUSED(dataSource)
+	Q_UNUSED(mode)
 #endif
 }
 
@@ -80,39 +80,48 @@ class ReadStatFilterPrivate {
 public:
 	explicit ReadStatFilterPrivate(ReadStatFilter*);
 
+	// typed values of one column, filled in the value handler and moved into the column after parsing
+	struct ColumnBuffer {
+		AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};
+		QVector<double> doubles;
+		QVector<int> integers;
+		QVector<QString> texts;
+	};
+
 #ifdef HAVE_READSTAT
-	// callbacks (get*)
+	// callbacks (get*), the filter instance is passed as the user context
 	static int getMetaData(readstat_metadata_t*, void*);
 	static int getVarName(int index, readstat_variable_t*, const char* val_labels, void*);
-	static int getColumnModes(int row, readstat_variable_t*, readstat_value_t, void*);
 	static int getValuesPreview(int row, readstat_variable_t*, readstat_value_t, void*);
 	static int getValues(int row, readstat_variable_t*, readstat_value_t, void*);
 	static int getNotes(int index, const char* note, void*);
 	static int getFWeights(readstat_variable_t*, void*);
 	static int getValueLabels(const char* val_labels, readstat_value_t, const char* label, void*);
-	readstat_error_t parse(const QString& fileName, bool preview = false, bool prepare = false);
+	readstat_error_t parse(const QString& fileName, bool preview = false, int previewLines = 0);
 #endif
 	QVector<QStringList> preview(const QString& fileName, int lines);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	void write(const QString& fileName, AbstractDataSource*);
 
-	static QStringList varNames;
-	static QVector<AbstractColumn::ColumnMode> columnModes;
-	static QVector<QStringList> dataStrings;
+	QStringList varNames;
+	QVector<AbstractColumn::ColumnMode> columnModes;
+	QVector<QStringList> dataStrings;
 
-	static int startRow;
-	static int endRow;
-	static int startColumn;
-	static int endColumn;
+	int startRow{1};
+	int endRow{-1};
+	int startColumn{1};
+	int endColumn{-1};
 
 private:
-	static int m_varCount; // nr of cols (vars)
-	static int m_rowCount; // nr of rows
-	static QStringList m_lineString;
-	static std::vector<void*> m_dataContainer;
-	static QStringList m_notes;
-	static QVector<QString> m_valueLabels;
-	static QMap<QString, LabelSet> m_labelSets;
+	bool isSelectedColumn(int col) const;
+
+	int m_varCount{0}; // nr of cols (vars)
+	int m_rowCount{0}; // nr of rows as provided in the meta data, used to reserve the buffers
+	QStringList m_lineString;
+	std::vector<ColumnBuffer> m_buffers; // buffers of the selected columns
+	QStringList m_notes;
+	QVector<QString> m_valueLabels; // names of the value label sets of the selected columns
+	QMap<QString, LabelSet> m_labelSets;
 };
 
 #endif
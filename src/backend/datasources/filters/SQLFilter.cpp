@@ -0,0 +1,1095 @@
+/*
+	File                 : SQLFilter.cpp
+	Project              : LabPlot
+	Description          : SQL database I/O-filter
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/datasources/filters/SQLFilter.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/LiveDataSource.h"
+#include "backend/datasources/filters/SQLFilterPrivate.h"
+#include "backend/lib/XmlStreamReader.h"
+#include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+#include <QFile>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlField>
+#include <QSqlIndex>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*!
+\class SQLFilter
+\brief Reads a table or the result of a query from a SQL database.
+
+The result set is read with forward-only queries and converted in batches into typed buffers,
+one per column, that are moved into the columns at the end. The numeric and date/time values
+are taken as provided by the driver, strings are only parsed if the column mode was determined
+from the values. The range of rows is selected on the server with LIMIT/OFFSET or the
+equivalent syntax of the driver. If a key column is set, the rows are ordered by the key and read
+in pages of \c batchSize rows, every page continuing after the key of the last read row (keyset pagination).
+The same is used in live data sources to read the rows added since the last read.
+
+Spreadsheets and matrices are written into a new table of a SQLite database with prepared multi-row INSERT statements
+and typed values, the transaction is committed every \c commitInterval rows. writeInBackground() writes them in a separate thread.
+
+\ingroup datasources
+*/
+
+const QString SQLFilter::xmlElementName = QStringLiteral("sqlFilter");
+
+SQLFilter::SQLFilter()
+	: AbstractFileFilter(FileType::SQL)
+	, d(new SQLFilterPrivate(this)) {
+}
+
+SQLFilter::~SQLFilter() = default;
+
+/*!
+ * returns the path of the config file with the settings of the database connections.
+ */
+QString SQLFilter::connectionsConfigPath() {
+	return QStandardPaths::standardLocations(QStandardPaths::AppDataLocation).constFirst() + QStringLiteral("sql_connections");
+}
+
+/*!
+  reads the table or the result of the query from the SQLite database file \c fileName into \c dataSource.
+*/
+void SQLFilter::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	d->errors.clear();
+	if (!QFile::exists(fileName)) {
+		d->errors << i18n("Couldn't find the database file '%1'.", fileName);
+		return;
+	}
+
+	const QString name = QStringLiteral("LabPlot_SQLFilter_File_%1").arg(reinterpret_cast<quintptr>(this));
+	{
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), name);
+		db.setDatabaseName(fileName);
+		if (db.open()) {
+			d->readDataFromDatabase(db, dataSource, importMode);
+			db.close();
+		} else
+			d->errors << i18n("Failed to open the database file '%1'.", fileName) + QStringLiteral("\n\n") + db.lastError().databaseText();
+	}
+	QSqlDatabase::removeDatabase(name);
+}
+
+/*!
+  reads the table or the result of the query from the opened database \c db into \c dataSource.
+*/
+void SQLFilter::readDataFromDatabase(const QSqlDatabase& db, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	d->readDataFromDatabase(db, dataSource, importMode);
+}
+
+/*!
+  reads the rows added to the database of the connection \c connection since the last read to the live data source \c dataSource.
+  Returns the number of rows read in total.
+*/
+qint64 SQLFilter::readFromLiveDatabase(AbstractDataSource* dataSource, qint64 from) {
+	return d->readFromLiveDatabase(dataSource, from);
+}
+
+/*!
+  writes the rows [\c startRow, \c endRow] of the spreadsheet or matrix \c dataSource into a new table of the SQLite database \c fileName.
+  The table is named after the data source if no table name was set.
+*/
+void SQLFilter::write(const QString& fileName, AbstractDataSource* dataSource) {
+	d->write(fileName, exportData(dataSource, false));
+}
+
+bool SQLFilter::writeExportData(const QString& fileName, const ExportData& data) {
+	d->write(fileName, data);
+	return true;
+}
+
+bool SQLFilter::exportsNumericDataOnly() const {
+	return false;
+}
+
+QStringList SQLFilter::lastErrors() {
+	return d->errors;
+}
+
+/*!
+  returns the names of all columns in the result set of the last read.
+*/
+QStringList SQLFilter::vectorNames() const {
+	return d->vectorNames;
+}
+
+/*!
+  returns the modes of all columns in the result set of the last read.
+*/
+QVector<AbstractColumn::ColumnMode> SQLFilter::columnModes() const {
+	return d->columnModes;
+}
+
+/*!
+  sets the modes of all columns in the result set. The modes are determined from
+  the types of the fields and from the values in the first row if not set.
+*/
+void SQLFilter::setColumnModes(const QVector<AbstractColumn::ColumnMode>& modes) {
+	d->columnModes = modes;
+}
+
+/*!
+  sets the name of the connection in the connections config used by live data sources.
+*/
+void SQLFilter::setConnection(const QString& connection) {
+	if (connection == d->connection)
+		return;
+
+	d->closeDatabase();
+	d->connection = connection;
+}
+
+QString SQLFilter::connection() const {
+	return d->connection;
+}
+
+void SQLFilter::setTable(const QString& table) {
+	d->table = table;
+}
+
+QString SQLFilter::table() const {
+	return d->table;
+}
+
+/*!
+  sets the custom query to be read instead of the table.
+*/
+void SQLFilter::setQuery(const QString& query) {
+	d->query = query;
+}
+
+QString SQLFilter::query() const {
+	return d->query;
+}
+
+/*!
+  sets the column with increasing values, like an auto-incremented id or a time stamp,
+  used to read the rows ordered and in pages and to determine the new rows in live data sources.
+*/
+void SQLFilter::setKeyColumn(const QString& column) {
+	d->keyColumn = column;
+}
+
+QString SQLFilter::keyColumn() const {
+	return d->keyColumn;
+}
+
+/*!
+  sets the number of rows fetched and converted at once and the size of the pages read with a key column.
+*/
+void SQLFilter::setBatchSize(int size) {
+	d->batchSize = std::max(size, 1);
+}
+
+int SQLFilter::batchSize() const {
+	return d->batchSize;
+}
+
+/*!
+  sets the number of rows written in one transaction when exporting to a database.
+*/
+void SQLFilter::setCommitInterval(int rows) {
+	d->commitInterval = std::max(rows, 1);
+}
+
+int SQLFilter::commitInterval() const {
+	return d->commitInterval;
+}
+
+void SQLFilter::setDateTimeFormat(const QString& format) {
+	d->dateTimeFormat = format;
+}
+
+QString SQLFilter::dateTimeFormat() const {
+	return d->dateTimeFormat;
+}
+
+/*!
+  sets the number format used to convert the numbers provided by the database as strings.
+*/
+void SQLFilter::setNumberFormat(QLocale::Language lang) {
+	d->numberFormat = lang;
+}
+
+QLocale::Language SQLFilter::numberFormat() const {
+	return d->numberFormat;
+}
+
+void SQLFilter::setStartRow(int row) {
+	d->startRow = row;
+}
+
+int SQLFilter::startRow() const {
+	return d->startRow;
+}
+
+void SQLFilter::setEndRow(int row) {
+	d->endRow = row;
+}
+
+int SQLFilter::endRow() const {
+	return d->endRow;
+}
+
+void SQLFilter::setStartColumn(int column) {
+	d->startColumn = column;
+}
+
+int SQLFilter::startColumn() const {
+	return d->startColumn;
+}
+
+void SQLFilter::setEndColumn(int column) {
+	d->endColumn = column;
+}
+
+int SQLFilter::endColumn() const {
+	return d->endColumn;
+}
+
+// #####################################################################
+// ################### Private implementation ##########################
+// #####################################################################
+namespace {
+/*!
+ * determines the column mode from the type of the field \c field or, if the values are provided as strings
+ * or the type is not known, from the value \c value of the field in the first row.
+ */
+AbstractColumn::ColumnMode columnMode(const QSqlField& field, const QVariant& value, QString& dateTimeFormat, const QLocale& locale) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	const int type = field.metaType().id();
+#else
+	const int type = field.type();
+#endif
+	switch (type) {
+	case QMetaType::Bool:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Int:
+		return AbstractColumn::ColumnMode::Integer;
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+		return AbstractColumn::ColumnMode::BigInt;
+	case QMetaType::Float:
+	case QMetaType::Double:
+		return AbstractColumn::ColumnMode::Double;
+	case QMetaType::QDate:
+	case QMetaType::QTime:
+	case QMetaType::QDateTime:
+		return AbstractColumn::ColumnMode::DateTime;
+	default:
+		break;
+	}
+
+	return AbstractFileFilter::columnMode(value.toString(), dateTimeFormat, locale);
+}
+
+/*!
+ * moves \c values into the data container \c data of a column.
+ * The values are copied only if the column has more rows than values, i.e. when appending to a larger spreadsheet.
+ */
+template<typename T>
+void moveValues(QVector<T>& values, void* data) {
+	auto* vector = static_cast<QVector<T>*>(data);
+	if (vector->size() == values.size())
+		vector->swap(values);
+	else
+		std::copy_n(values.constBegin(), std::min(values.size(), vector->size()), vector->begin());
+}
+
+/*!
+ * copies \c count values starting at \c first to the column \c column starting at \c row, block by block.
+ */
+template<typename T>
+void copyValues(const QVector<T>& values, qint64 first, int count, Column* column, int row) {
+	auto source = values.constBegin() + first;
+	for (const auto& chunk : column->dataChunks(row, count)) {
+		std::copy_n(source, chunk.size, static_cast<T*>(chunk.values));
+		source += chunk.size;
+	}
+}
+
+/*!
+ * binds the values of the rows [\c firstRow, \c firstRow + \c count) of the \c size values \c data of the column \c col
+ * to the parameters of the multi-row INSERT statement \c query. Rows beyond the end of the column are bound as NULL.
+ */
+template<typename T, typename Converter>
+void bindValues(QSqlQuery& query, const void* data, int size, int col, int cols, int firstRow, int count, Converter toVariant) {
+	const auto* values = static_cast<const T*>(data);
+	int index = col;
+	for (int row = firstRow; row < firstRow + count; ++row, index += cols)
+		query.bindValue(index, row < size ? toVariant(values[row]) : QVariant());
+}
+} // namespace
+
+SQLFilterPrivate::SQLFilterPrivate(SQLFilter* owner)
+	: q(owner)
+	, m_databaseName(QStringLiteral("LabPlot_SQLFilter_%1").arg(reinterpret_cast<quintptr>(owner))) {
+}
+
+SQLFilterPrivate::~SQLFilterPrivate() {
+	closeDatabase();
+}
+
+/*!
+ * reads the table or the result of the custom query from the database \c db into \c dataSource.
+ * Returns the number of read rows.
+ */
+int SQLFilterPrivate::readDataFromDatabase(const QSqlDatabase& db, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	errors.clear();
+	if (!dataSource)
+		return 0;
+
+	if (table.isEmpty() && query.isEmpty()) {
+		errors << i18n("No table or query to read the data from.");
+		return 0;
+	}
+
+	// rows to read, the first row is 1
+	const qint64 offset = std::max(startRow, 1) - 1;
+	const qint64 limit = (endRow == -1) ? -1 : std::max(endRow - offset, (qint64)0);
+	DEBUG(Q_FUNC_INFO << ", offset = " << offset << ", limit = " << limit)
+
+	std::vector<ColumnBuffer> buffers;
+	lastKey = QVariant();
+	const int rows = fetchAll(db, buffers, offset, limit);
+	if (rows <= 0 || buffers.empty())
+		return 0;
+
+	const int cols = (int)buffers.size();
+	QStringList names;
+	QVector<AbstractColumn::ColumnMode> modes;
+	for (int i = 0; i < cols; ++i) {
+		names << vectorNames.at(m_firstColumn + i);
+		modes << buffers.at(i).mode;
+	}
+
+	std::vector<void*> dataContainer;
+	const int columnOffset = dataSource->prepareImport(dataContainer, importMode, rows, cols, names, modes);
+
+	for (int i = 0; i < cols; ++i) {
+		auto& buffer = buffers[i];
+		switch (buffer.mode) {
+		case AbstractColumn::ColumnMode::Double:
+			moveValues(buffer.doubles, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			moveValues(buffer.integers, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			moveValues(buffer.bigInts, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			moveValues(buffer.texts, dataContainer[i]);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			moveValues(buffer.dateTimes, dataContainer[i]);
+			break;
+		}
+	}
+
+	dataSource->finalizeImport(columnOffset, 1, cols, dateTimeFormat, importMode);
+	DEBUG(Q_FUNC_INFO << ", read " << rows << " rows and " << cols << " columns")
+	return rows;
+}
+
+/*!
+ * reads the rows added since the last read to the live data source \c dataSource.
+ * With a key column the rows with a key larger than the key of the last read row are read,
+ * otherwise the rows after the \c from rows read so far. The very first read imports all rows.
+ * Returns the number of rows read in total.
+ */
+qint64 SQLFilterPrivate::readFromLiveDatabase(AbstractDataSource* dataSource, qint64 from) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	auto* source = dynamic_cast<LiveDataSource*>(dataSource);
+	if (!source)
+		return from;
+
+	errors.clear();
+	auto db = database();
+	if (!db.isOpen())
+		return from;
+
+	if (from == 0 || source->columnCount() == 0) {
+		// read until the current end of the table, the end row set by the user is kept
+		const int userEndRow = endRow;
+		endRow = -1;
+		const int rows = readDataFromDatabase(db, dataSource, AbstractFileFilter::ImportMode::Replace);
+		endRow = userEndRow;
+		return rows;
+	}
+
+	// without a key column the new rows are the rows after the rows read so far in the order of the primary key
+	if (keyColumn.isEmpty() && primaryKey(db).isEmpty()) {
+		errors << i18n("The new rows can't be determined, select a key column or read a table with a primary key.");
+		return from;
+	}
+
+	const qint64 offset = keyColumn.isEmpty() ? std::max(startRow, 1) - 1 + from : 0;
+	const qint64 limit = (source->readingType() == LiveDataSource::ReadingType::ContinuousFixed) ? source->sampleSize() : -1;
+	std::vector<ColumnBuffer> buffers;
+	const int rows = fetchAll(db, buffers, offset, limit);
+	if (rows <= 0)
+		return from;
+
+	qint64 first;
+	int count;
+	const int row = source->prepareLiveRows(0, rows, first, count);
+	DEBUG(Q_FUNC_INFO << ", " << rows << " new rows, using " << count << " rows starting at row " << first)
+
+	// write the new values directly into the columns
+	const auto& columns = source->children<Column>();
+	const int cols = std::min((int)columns.size(), (int)buffers.size());
+	for (int c = 0; c < cols; ++c) {
+		auto* column = columns.at(c);
+		auto& buffer = buffers[c];
+		if (column->columnMode() == AbstractColumn::ColumnMode::BigInt && buffer.mode == AbstractColumn::ColumnMode::Integer) {
+			// the new values fit into integers, the column contains larger values read before
+			for (int v : qAsConst(buffer.integers))
+				buffer.bigInts << v;
+			buffer.mode = AbstractColumn::ColumnMode::BigInt;
+		} else if (column->columnMode() != buffer.mode) {
+			// the column mode was changed after the last read or the new values are too large for an integer column
+			column->setColumnMode(buffer.mode);
+			if (column->columnMode() != buffer.mode) {
+				errors << i18n("The new values of the column '%1' couldn't be converted to the mode of the column.", column->name());
+				continue;
+			}
+		}
+
+		switch (buffer.mode) {
+		case AbstractColumn::ColumnMode::Double:
+			copyValues(buffer.doubles, first, count, column, row);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			copyValues(buffer.integers, first, count, column, row);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			copyValues(buffer.bigInts, first, count, column, row);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			copyValues(buffer.texts, first, count, column, row);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			copyValues(buffer.dateTimes, first, count, column, row);
+			break;
+		}
+	}
+
+	source->finalizeLiveRows();
+	return from + rows;
+}
+
+/*!
+ * writes the rows [\c startRow, \c endRow] of the data \c data collected with exportData() into a new table of the SQLite database \c fileName.
+ * Returns the number of written rows or -1 on errors.
+ */
+int SQLFilterPrivate::write(const QString& fileName, const AbstractFileFilter::ExportData& data) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	errors.clear();
+	const int cols = data.vectors.size();
+	if (cols == 0)
+		return 0;
+
+	// shorter columns are filled with NULL values
+	const int dataRows = *std::max_element(data.rowCounts.cbegin(), data.rowCounts.cend());
+	const int firstRow = std::max(startRow, 1) - 1;
+	const int lastRow = (endRow == -1 || endRow > dataRows) ? dataRows : endRow;
+	const int rows = std::max(lastRow - firstRow, 0);
+
+	const QString name = QStringLiteral("LabPlot_SQLFilter_Write_%1").arg(reinterpret_cast<quintptr>(q));
+	int written = -1;
+	{
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), name);
+		db.setDatabaseName(fileName);
+		if (db.open()) {
+			written = writeTable(db, table.isEmpty() ? data.name : table, data, firstRow, rows);
+			db.close();
+		} else
+			errors << i18n("Couldn't create the SQLite database '%1'.", fileName) + QStringLiteral("\n\n") + db.lastError().databaseText();
+	}
+	QSqlDatabase::removeDatabase(name);
+
+	return written;
+}
+
+/*!
+ * creates the table \c tableName with REAL, INTEGER and TEXT columns according to the modes of the columns in \c data in the
+ * database \c db and inserts \c rows rows starting at \c firstRow. The rows are inserted with prepared multi-row INSERT
+ * statements with bound typed values, the transaction is committed every \c commitInterval rows.
+ * Returns the number of written rows or -1 on errors.
+ */
+int SQLFilterPrivate::writeTable(QSqlDatabase& db, const QString& tableName, const AbstractFileFilter::ExportData& data, int firstRow, int rows) {
+	const auto* driver = db.driver();
+	const QString escapedName = driver->escapeIdentifier(tableName, QSqlDriver::TableName);
+	const int cols = data.vectors.size();
+
+	// create the table
+	QString statement = QStringLiteral("CREATE TABLE ") + escapedName + QStringLiteral(" (");
+	for (int i = 0; i < cols; ++i) {
+		if (i != 0)
+			statement += QStringLiteral(", ");
+		statement += driver->escapeIdentifier(data.names.at(i), QSqlDriver::FieldName) + QLatin1Char(' ');
+
+		switch (data.modes.at(i)) {
+		case AbstractColumn::ColumnMode::Double:
+			statement += QLatin1String("REAL");
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+		case AbstractColumn::ColumnMode::BigInt:
+			statement += QLatin1String("INTEGER");
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::Text: // date/time values are written as text
+			statement += QLatin1String("TEXT");
+			break;
+		}
+	}
+	statement += QLatin1Char(')');
+
+	QSqlQuery sqlQuery(db);
+	if (!sqlQuery.exec(statement)) {
+		errors << i18n("Failed to create the table '%1'.", tableName) + QStringLiteral("\n") + sqlQuery.lastError().databaseText();
+		return -1;
+	}
+
+	// INSERT statement for \c count rows, one parameter per value.
+	// older versions of SQLite allow at most 999 parameters in one statement.
+	const int statementRows = std::max(999 / cols, 1);
+	const QString rowValues = QLatin1Char('(') + QStringLiteral("?, ").repeated(cols - 1) + QStringLiteral("?)");
+	auto insertStatement = [&](int count) {
+		QString insert = QStringLiteral("INSERT INTO ") + escapedName + QStringLiteral(" VALUES ") + rowValues;
+		insert.reserve(insert.size() + (count - 1) * (rowValues.size() + 2));
+		for (int i = 1; i < count; ++i)
+			insert += QStringLiteral(", ") + rowValues;
+		return insert;
+	};
+
+	QSqlQuery insertQuery(db);
+	if (rows >= statementRows && !insertQuery.prepare(insertStatement(statementRows))) {
+		errors << i18n("Failed to insert values into the table '%1'.", tableName) + QStringLiteral("\n") + insertQuery.lastError().databaseText();
+		return -1;
+	}
+	QSqlQuery remainderQuery(db); // statement for the last rows not filling a complete statement
+
+	db.transaction();
+	int row = 0;
+	int uncommitted = 0;
+	int progress = 0;
+	while (row < rows) {
+		const int count = std::min(statementRows, rows - row);
+		if (count != statementRows)
+			remainderQuery.prepare(insertStatement(count));
+		auto& query = (count == statementRows) ? insertQuery : remainderQuery;
+
+		bindRows(query, data, firstRow + row, count);
+		if (!query.exec()) {
+			errors << i18n("Failed to insert values into the table '%1'.", tableName) + QStringLiteral("\n") + query.lastError().databaseText();
+			db.rollback();
+			return -1;
+		}
+		row += count;
+
+		uncommitted += count;
+		if (uncommitted >= commitInterval) {
+			db.commit();
+			db.transaction();
+			uncommitted = 0;
+		}
+
+		// update the progress in 1% steps only
+		const int value = static_cast<int>(100. * row / rows);
+		if (value > progress) {
+			progress = value;
+			Q_EMIT q->completed(progress);
+		}
+	}
+	db.commit();
+
+	PERFTRACE_COUNTER("SQL rows written", rows);
+	return rows;
+}
+
+/*!
+ * binds the values of \c count rows of the columns in \c data starting at \c firstRow to the parameters of the multi-row INSERT statement \c query.
+ * NaN values are written as NULL, date/time values as text in the format of the column.
+ */
+void SQLFilterPrivate::bindRows(QSqlQuery& query, const AbstractFileFilter::ExportData& data, int firstRow, int count) const {
+	const int cols = data.vectors.size();
+	for (int col = 0; col < cols; ++col) {
+		const auto* values = data.vectors.at(col);
+		const int size = data.rowCounts.at(col);
+		switch (data.modes.at(col)) {
+		case AbstractColumn::ColumnMode::Double:
+			bindValues<double>(query, values, size, col, cols, firstRow, count, [](double value) {
+				return std::isnan(value) ? QVariant() : QVariant(value);
+			});
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			bindValues<int>(query, values, size, col, cols, firstRow, count, [](int value) {
+				return QVariant(value);
+			});
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			bindValues<qint64>(query, values, size, col, cols, firstRow, count, [](qint64 value) {
+				return QVariant(value);
+			});
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			bindValues<QString>(query, values, size, col, cols, firstRow, count, [](const QString& value) {
+				return QVariant(value);
+			});
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day: {
+			const QString& format = data.formats.at(col);
+			bindValues<QDateTime>(query, values, size, col, cols, firstRow, count, [&format](const QDateTime& value) {
+				return value.isValid() ? QVariant(value.toString(format)) : QVariant();
+			});
+			break;
+		}
+		}
+	}
+}
+
+/*!
+ * returns the database of the connection \c connection in the connections config.
+ * The database is opened on first use and kept open for the next reads.
+ */
+QSqlDatabase SQLFilterPrivate::database() {
+	if (QSqlDatabase::contains(m_databaseName)) {
+		auto db = QSqlDatabase::database(m_databaseName); // re-opens the database if it was closed
+		if (!db.isOpen())
+			errors << i18n("Failed to connect to the database '%1'.", connection) + QStringLiteral("\n\n") + db.lastError().databaseText();
+		return db;
+	}
+
+	KConfig config(SQLFilter::connectionsConfigPath(), KConfig::SimpleConfig);
+	if (connection.isEmpty() || !config.hasGroup(connection)) {
+		errors << i18n("The database connection '%1' doesn't exist.", connection);
+		return {};
+	}
+
+	KConfigGroup group = config.group(connection);
+	const QString& driver = group.readEntry("Driver");
+	auto db = QSqlDatabase::addDatabase(driver, m_databaseName);
+	if (driver.startsWith(QLatin1String("QSQLITE")))
+		db.setDatabaseName(group.readEntry("DatabaseName"));
+	else if (driver.startsWith(QLatin1String("QODBC"))) {
+		if (group.readEntry("CustomConnectionEnabled", false))
+			db.setDatabaseName(group.readEntry("CustomConnectionString"));
+		else
+			db.setDatabaseName(group.readEntry("DatabaseName"));
+	} else {
+		db.setDatabaseName(group.readEntry("DatabaseName"));
+		db.setHostName(group.readEntry("HostName"));
+		db.setPort(group.readEntry("Port", 0));
+		db.setUserName(group.readEntry("UserName"));
+		db.setPassword(group.readEntry("Password"));
+	}
+
+	if (!db.open())
+		errors << i18n("Failed to connect to the database '%1'.", connection) + QStringLiteral("\n\n") + db.lastError().databaseText();
+
+	return db;
+}
+
+void SQLFilterPrivate::closeDatabase() {
+	if (!QSqlDatabase::contains(m_databaseName))
+		return;
+
+	QSqlDatabase::database(m_databaseName, false).close();
+	QSqlDatabase::removeDatabase(m_databaseName);
+}
+
+/*!
+ * returns the statement selecting the rows [\c offset, \c offset + \c limit) of the table or of the custom query,
+ * all rows after \c offset if \c limit is -1. With \c keyset the rows are ordered by the key column and only
+ * the rows after the last read key are selected. \c serverSideRange is set to \c false if the range
+ * couldn't be added to the statement for the current driver and has to be applied when fetching the rows.
+ */
+QString SQLFilterPrivate::selectStatement(const QSqlDatabase& db, bool keyset, qint64 offset, qint64 limit, bool& serverSideRange) const {
+	serverSideRange = true;
+	const auto* driver = db.driver();
+
+	QString source;
+	if (query.isEmpty())
+		source = driver->isIdentifierEscaped(table, QSqlDriver::TableName) ? table : driver->escapeIdentifier(table, QSqlDriver::TableName);
+	else {
+		// the custom query is used as a sub-query, a trailing semicolon is not allowed there
+		QString statement = query.trimmed();
+		while (statement.endsWith(QLatin1Char(';')))
+			statement.chop(1);
+
+		if (!keyset && offset == 0 && limit == -1)
+			return statement;
+
+		source = QLatin1Char('(') + statement + QStringLiteral(") labplot_query");
+	}
+
+	QString statement = QStringLiteral("SELECT * FROM ") + source;
+	if (keyset) {
+		const QString key = driver->isIdentifierEscaped(keyColumn, QSqlDriver::FieldName) ? keyColumn : driver->escapeIdentifier(keyColumn, QSqlDriver::FieldName);
+		if (lastKey.isValid())
+			statement += QStringLiteral(" WHERE ") + key + QStringLiteral(" > ?");
+		statement += QStringLiteral(" ORDER BY ") + key;
+	} else if (offset != 0 || limit != -1) {
+		// the range selects well-defined rows only if the rows are ordered
+		const QString& key = primaryKey(db);
+		if (!key.isEmpty())
+			statement += QStringLiteral(" ORDER BY ") + key;
+	}
+
+	if (offset == 0 && limit == -1)
+		return statement;
+
+	const QString& driverName = db.driverName();
+	if (driverName.startsWith(QLatin1String("QSQLITE"))) // LIMIT -1 selects all rows
+		statement += QStringLiteral(" LIMIT %1 OFFSET %2").arg(limit).arg(offset);
+	else if (driverName.startsWith(QLatin1String("QMYSQL"))) // MySQL requires a limit together with the offset
+		statement += QStringLiteral(" LIMIT %1, %2").arg(offset).arg(limit == -1 ? QStringLiteral("18446744073709551615") : QString::number(limit));
+	else if (driverName == QLatin1String("QPSQL")) {
+		if (limit != -1)
+			statement += QStringLiteral(" LIMIT %1").arg(limit);
+		if (offset > 0)
+			statement += QStringLiteral(" OFFSET %1").arg(offset);
+	} else if (driverName == QLatin1String("QOCI") || driverName == QLatin1String("QDB2") || driverName == QLatin1String("QIBASE")) {
+		statement += QStringLiteral(" OFFSET %1 ROWS").arg(offset);
+		if (limit != -1)
+			statement += QStringLiteral(" FETCH NEXT %1 ROWS ONLY").arg(limit);
+	} else // for ODBC the DBMS is not known and it's not clear what syntax to use
+		serverSideRange = false;
+
+	return statement;
+}
+
+/*!
+ * returns the comma separated columns of the primary key of the table, an empty string
+ * if the table has no primary key or if a custom query is read.
+ */
+QString SQLFilterPrivate::primaryKey(const QSqlDatabase& db) const {
+	if (!query.isEmpty())
+		return {};
+
+	const auto* driver = db.driver();
+	const auto& index = db.primaryIndex(table);
+	QStringList columns;
+	for (int i = 0; i < index.count(); ++i) {
+		const QString& name = index.fieldName(i);
+		columns << (driver->isIdentifierEscaped(name, QSqlDriver::FieldName) ? name : driver->escapeIdentifier(name, QSqlDriver::FieldName));
+	}
+
+	return columns.join(QStringLiteral(", "));
+}
+
+/*!
+ * prepares and executes the forward-only query \c sqlQuery for \c statement.
+ */
+bool SQLFilterPrivate::execute(QSqlQuery& sqlQuery, const QString& statement, bool keyset) {
+	DEBUG(Q_FUNC_INFO << ", " << STDSTRING(statement))
+	// the result set is read once from the beginning to the end, no navigation back and forth and no caching of the rows is needed
+	sqlQuery.setForwardOnly(true);
+	// numeric values are provided as double and not as string
+	sqlQuery.setNumericalPrecisionPolicy(QSql::LowPrecisionDouble);
+
+	if (!sqlQuery.prepare(statement)) {
+		errors << i18n("Failed to execute the query") + QStringLiteral("\n") + sqlQuery.lastError().databaseText();
+		return false;
+	}
+
+	if (keyset && lastKey.isValid())
+		sqlQuery.addBindValue(lastKey);
+
+	if (!sqlQuery.exec() || !sqlQuery.isActive()) {
+		errors << i18n("Failed to execute the query") + QStringLiteral("\n") + sqlQuery.lastError().databaseText();
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * determines the names and modes of the columns of the executed query \c sqlQuery positioned on the first row,
+ * the columns to be read and the position of the key column.
+ */
+void SQLFilterPrivate::initColumns(const QSqlQuery& sqlQuery) {
+	const auto& record = sqlQuery.record();
+	const int count = record.count();
+	m_firstColumn = std::max(startColumn, 1) - 1;
+	m_lastColumn = (endColumn == -1 || endColumn > count) ? count - 1 : endColumn - 1;
+	m_keyIndex = keyColumn.isEmpty() ? -1 : record.indexOf(keyColumn);
+
+	vectorNames.clear();
+	for (int i = 0; i < count; ++i)
+		vectorNames << record.fieldName(i);
+
+	// the modes provided by the caller are used if they fit to the result set
+	if (columnModes.size() == count)
+		return;
+
+	columnModes.clear();
+	const QLocale locale(numberFormat);
+	for (int i = 0; i < count; ++i)
+		columnModes << columnMode(record.field(i), sqlQuery.isValid() ? sqlQuery.value(i) : QVariant(), dateTimeFormat, locale);
+}
+
+/*!
+ * appends the values of at most \c count rows of the executed query \c sqlQuery, starting at its current row, to \c buffers.
+ * Returns the number of appended rows.
+ */
+int SQLFilterPrivate::fetch(QSqlQuery& sqlQuery, std::vector<ColumnBuffer>& buffers, int count) {
+	const QLocale locale(numberFormat);
+	int rows = 0;
+	while (rows < count && sqlQuery.isValid()) {
+		for (int col = m_firstColumn; col <= m_lastColumn; ++col)
+			appendValue(buffers[col - m_firstColumn], sqlQuery.value(col), locale);
+		if (m_keyIndex != -1)
+			lastKey = sqlQuery.value(m_keyIndex);
+
+		++rows;
+		sqlQuery.next();
+	}
+
+	PERFTRACE_COUNTER("SQL rows fetched", rows);
+	return rows;
+}
+
+/*!
+ * reads the rows [\c offset, \c offset + \c limit) of the result set into \c buffers, all rows after \c offset if \c limit is -1.
+ * With a key column the rows are read in pages of \c batchSize rows, one query per page continuing after the key
+ * of the last read row. Otherwise one forward-only query is used and its rows are fetched in batches of \c batchSize rows.
+ * Returns the number of read rows or -1 on errors.
+ */
+int SQLFilterPrivate::fetchAll(const QSqlDatabase& db, std::vector<ColumnBuffer>& buffers, qint64 offset, qint64 limit) {
+	const bool keyset = !keyColumn.isEmpty();
+	qint64 rows = 0;
+	qint64 total = limit; // total number of rows used for the progress, -1 if not known
+	bool firstPage = true;
+	while (limit == -1 || rows < limit) {
+		qint64 pageLimit = (limit == -1) ? -1 : limit - rows;
+		if (keyset)
+			pageLimit = (pageLimit == -1) ? batchSize : std::min(pageLimit, (qint64)batchSize);
+		const qint64 pageOffset = firstPage ? offset : 0;
+
+		bool serverSideRange;
+		QSqlQuery sqlQuery(db);
+		if (!execute(sqlQuery, selectStatement(db, keyset, pageOffset, pageLimit, serverSideRange), keyset))
+			return -1;
+		sqlQuery.next(); // go to the first row
+
+		if (firstPage) {
+			initColumns(sqlQuery);
+			if (keyset && m_keyIndex == -1) {
+				errors << i18n("The key column '%1' is not available in the result set.", keyColumn);
+				return -1;
+			}
+
+			const int cols = std::max(m_lastColumn - m_firstColumn + 1, 0);
+			buffers.resize(cols);
+			for (int i = 0; i < cols; ++i)
+				buffers[i].mode = columnModes.at(m_firstColumn + i);
+
+			// the size of the result set is only provided by some drivers
+			if (total == -1 && !keyset && serverSideRange && db.driver()->hasFeature(QSqlDriver::QuerySize))
+				total = sqlQuery.size();
+			firstPage = false;
+		}
+
+		// skip the rows before the offset if the range couldn't be selected in the query
+		if (!serverSideRange) {
+			for (qint64 i = 0; i < pageOffset && sqlQuery.isValid(); ++i)
+				sqlQuery.next();
+		}
+
+		qint64 pageRows = 0;
+		while (pageLimit == -1 || pageRows < pageLimit) {
+			const int count = (pageLimit == -1) ? batchSize : (int)std::min((qint64)batchSize, pageLimit - pageRows);
+			const int fetched = fetch(sqlQuery, buffers, count);
+			pageRows += fetched;
+			if (total > 0)
+				Q_EMIT q->completed(static_cast<int>(100 * (rows + pageRows) / total));
+			if (fetched < count)
+				break;
+		}
+		rows += pageRows;
+
+		// all rows were read with one query or the last page was read
+		if (!keyset || pageRows < pageLimit)
+			break;
+	}
+
+	return (int)rows;
+}
+
+/*!
+ * appends \c value to \c buffer. The numeric and date/time values are converted directly, strings are
+ * only parsed if the column mode was determined from the values and the driver provides strings.
+ */
+void SQLFilterPrivate::appendValue(ColumnBuffer& buffer, const QVariant& value, const QLocale& locale) const {
+	const bool string = (value.userType() == QMetaType::QString);
+	switch (buffer.mode) {
+	case AbstractColumn::ColumnMode::Double: {
+		if (value.isNull())
+			buffer.doubles << NAN;
+		else if (string) {
+			bool ok;
+			const double d = locale.toDouble(value.toString(), &ok);
+			buffer.doubles << (ok ? d : NAN);
+		} else
+			buffer.doubles << value.toDouble();
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		// drivers like QSQLITE report 64-bit integer columns as int, the column is changed to BigInt
+		// when the first value not fitting into int is read
+		qint64 i;
+		if (string) {
+			bool ok;
+			i = locale.toLongLong(value.toString(), &ok);
+			if (!ok)
+				i = 0;
+		} else
+			i = value.toLongLong();
+
+		if (i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max())
+			buffer.integers << static_cast<int>(i);
+		else {
+			buffer.bigInts.reserve(buffer.integers.size() + 1);
+			for (int v : qAsConst(buffer.integers))
+				buffer.bigInts << v;
+			buffer.bigInts << i;
+			buffer.integers.clear();
+			buffer.integers.squeeze();
+			buffer.mode = AbstractColumn::ColumnMode::BigInt;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		if (string) {
+			bool ok;
+			const qint64 i = locale.toLongLong(value.toString(), &ok);
+			buffer.bigInts << (ok ? i : 0);
+		} else
+			buffer.bigInts << value.toLongLong();
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text:
+		buffer.texts << value.toString();
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		if (string)
+			buffer.dateTimes << QDateTime::fromString(value.toString(), dateTimeFormat);
+		else
+			buffer.dateTimes << value.toDateTime();
+		break;
+	}
+}
+
+// ##############################################################################
+// ##################  Serialization/Deserialization  ###########################
+// ##############################################################################
+/*!
+  Saves as XML.
+ */
+void SQLFilter::save(QXmlStreamWriter* writer) const {
+	writer->writeStartElement(xmlElementName);
+	writer->writeAttribute(QStringLiteral("connection"), d->connection);
+	writer->writeAttribute(QStringLiteral("table"), d->table);
+	writer->writeAttribute(QStringLiteral("query"), d->query);
+	writer->writeAttribute(QStringLiteral("keyColumn"), d->keyColumn);
+	writer->writeAttribute(QStringLiteral("batchSize"), QString::number(d->batchSize));
+	writer->writeAttribute(QStringLiteral("dateTimeFormat"), d->dateTimeFormat);
+	writer->writeAttribute(QStringLiteral("numberFormat"), QString::number(static_cast<int>(d->numberFormat)));
+	writer->writeAttribute(QStringLiteral("startRow"), QString::number(d->startRow));
+	writer->writeAttribute(QStringLiteral("endRow"), QString::number(d->endRow));
+	writer->writeAttribute(QStringLiteral("startColumn"), QString::number(d->startColumn));
+	writer->writeAttribute(QStringLiteral("endColumn"), QString::number(d->endColumn));
+	writer->writeEndElement();
+}
+
+/*!
+  Loads from XML.
+*/
+bool SQLFilter::load(XmlStreamReader* reader) {
+	QString attributeWarning = i18n("Attribute '%1' missing or empty, default value is used");
+	QXmlStreamAttributes attribs = reader->attributes();
+
+	d->connection = attribs.value(QStringLiteral("connection")).toString();
+	if (d->connection.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("connection")));
+
+	d->table = attribs.value(QStringLiteral("table")).toString();
+	d->query = attribs.value(QStringLiteral("query")).toString();
+	d->keyColumn = attribs.value(QStringLiteral("keyColumn")).toString();
+	d->dateTimeFormat = attribs.value(QStringLiteral("dateTimeFormat")).toString();
+
+	QString str = attribs.value(QStringLiteral("batchSize")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("batchSize")));
+	else
+		d->batchSize = std::max(str.toInt(), 1);
+
+	str = attribs.value(QStringLiteral("numberFormat")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("numberFormat")));
+	else
+		d->numberFormat = static_cast<QLocale::Language>(str.toInt());
+
+	str = attribs.value(QStringLiteral("startRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startRow")));
+	else
+		d->startRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("endRow")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endRow")));
+	else
+		d->endRow = str.toInt();
+
+	str = attribs.value(QStringLiteral("startColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("startColumn")));
+	else
+		d->startColumn = str.toInt();
+
+	str = attribs.value(QStringLiteral("endColumn")).toString();
+	if (str.isEmpty())
+		reader->raiseWarning(attributeWarning.arg(QStringLiteral("endColumn")));
+	else
+		d->endColumn = str.toInt();
+
+	return true;
+}
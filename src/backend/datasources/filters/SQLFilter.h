@@ -0,0 +1,78 @@
+/*
+	File                 : SQLFilter.h
+	Project              : LabPlot
+	Description          : SQL database I/O-filter
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef SQLFILTER_H
+#define SQLFILTER_H
+
+#include "backend/datasources/filters/AbstractFileFilter.h"
+
+
+class SQLFilterPrivate;
+class QSqlDatabase;
+
+class SQLFilter : public AbstractFileFilter {
+	Q_OBJECT
+
+public:
+	SQLFilter();
+	~SQLFilter() override;
+
+	static QString connectionsConfigPath();
+
+	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, ImportMode = ImportMode::Replace) override;
+	void readDataFromDatabase(const QSqlDatabase&, AbstractDataSource*, ImportMode = ImportMode::Replace);
+	qint64 readFromLiveDatabase(AbstractDataSource*, qint64 from = 0);
+	void write(const QString& fileName, AbstractDataSource*) override;
+	QStringList lastErrors() override;
+
+	QStringList vectorNames() const;
+	QVector<AbstractColumn::ColumnMode> columnModes() const;
+	void setColumnModes(const QVector<AbstractColumn::ColumnMode>&);
+
+	void setConnection(const QString&);
+	QString connection() const;
+	void setTable(const QString&);
+	QString table() const;
+	void setQuery(const QString&);
+	QString query() const;
+	void setKeyColumn(const QString&);
+	QString keyColumn() const;
+	void setBatchSize(int);
+	int batchSize() const;
+	void setCommitInterval(int);
+	int commitInterval() const;
+
+	void setDateTimeFormat(const QString&);
+	QString dateTimeFormat() const;
+	void setNumberFormat(QLocale::Language);
+	QLocale::Language numberFormat() const;
+
+	void setStartRow(int);
+	int startRow() const;
+	void setEndRow(int);
+	int endRow() const;
+	void setStartColumn(int);
+	int startColumn() const;
+	void setEndColumn(int);
+	int endColumn() const;
+
+	void save(QXmlStreamWriter*) const override;
+	bool load(XmlStreamReader*) override;
+
+	static const QString xmlElementName;
+
+protected:
+	bool writeExportData(const QString& fileName, const ExportData&) override;
+	bool exportsNumericDataOnly() const override;
+
+private:
+	std::unique_ptr<SQLFilterPrivate> const d;
+	friend class SQLFilterPrivate;
+};
+
+#endif
@@ -0,0 +1,80 @@
+/*
+	File                 : SQLFilterPrivate.h
+	Project              : LabPlot
+	Description          : Private implementation class for SQLFilter.
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef SQLFILTERPRIVATE_H
+#define SQLFILTERPRIVATE_H
+
+#include "SQLFilter.h"
+
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QVariant>
+
+class Column;
+class QSqlQuery;
+class QSqlRecord;
+
+class SQLFilterPrivate {
+public:
+	explicit SQLFilterPrivate(SQLFilter*);
+	~SQLFilterPrivate();
+
+	// typed values of one column, filled while fetching the result set and moved into the column afterwards
+	struct ColumnBuffer {
+		AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};
+		QVector<double> doubles;
+		QVector<int> integers;
+		QVector<qint64> bigInts;
+		QVector<QString> texts;
+		QVector<QDateTime> dateTimes;
+	};
+
+	int readDataFromDatabase(const QSqlDatabase&, AbstractDataSource*, AbstractFileFilter::ImportMode);
+	qint64 readFromLiveDatabase(AbstractDataSource*, qint64 from);
+	int write(const QString& fileName, const AbstractFileFilter::ExportData&);
+	void closeDatabase();
+
+	const SQLFilter* q;
+
+	QString connection; // name of the connection in the connections config, used by live data sources
+	QString table;
+	QString query; // custom query, used instead of the table if not empty
+	QString keyColumn; // column with increasing values used for the keyset pagination
+	int batchSize{100000};
+	int commitInterval{100000}; // number of rows written in one transaction
+	QString dateTimeFormat;
+	QLocale::Language numberFormat{QLocale::C};
+	int startRow{1};
+	int endRow{-1};
+	int startColumn{1};
+	int endColumn{-1};
+
+	QStringList vectorNames; // names of all columns in the result set
+	QVector<AbstractColumn::ColumnMode> columnModes; // modes of all columns in the result set
+	QVariant lastKey; // value of the key column in the last read row
+	QStringList errors;
+
+private:
+	QSqlDatabase database();
+	QString selectStatement(const QSqlDatabase&, bool keyset, qint64 offset, qint64 limit, bool& serverSideRange) const;
+	QString primaryKey(const QSqlDatabase&) const;
+	bool execute(QSqlQuery&, const QString& statement, bool keyset);
+	void initColumns(const QSqlQuery&);
+	int fetch(QSqlQuery&, std::vector<ColumnBuffer>&, int count);
+	int fetchAll(const QSqlDatabase&, std::vector<ColumnBuffer>&, qint64 offset, qint64 limit);
+	void appendValue(ColumnBuffer&, const QVariant&, const QLocale&) const;
+	int writeTable(QSqlDatabase&, const QString& tableName, const AbstractFileFilter::ExportData&, int firstRow, int rows);
+	void bindRows(QSqlQuery&, const AbstractFileFilter::ExportData&, int firstRow, int count) const;
+
+	int m_firstColumn{0}; // first and last column of the result set to be read
+	int m_lastColumn{-1};
+	int m_keyIndex{-1}; // index of the key column in the result set
+	QString m_databaseName; // name of the Qt database connection opened for live data sources
+};
+
+#endif
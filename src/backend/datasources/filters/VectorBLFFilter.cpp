@@ -19,6 +19,10 @@
 #include "backend/lib/trace.h"
 
 #include <KLocalizedString>
+#include <QHash>
+
+#include <algorithm>
+#include <memory>
 
 #ifdef HAVE_VECTOR_BLF
 #include <Vector/BLF/Exceptions.h>
@@ -163,8 +167,67 @@ bool getTime(const Vector::BLF::ObjectHeaderBase* ohb, uint64_t& timestamp) {
 	}
 	return true;
 }
+
+/*!
+ * reads the next CAN message from \p file. Other objects are skipped.
+ * Returns \c nullptr at the end of the file, the caller takes the ownership of the message.
+ */
+Vector::BLF::CanMessage2* readCANMessage(Vector::BLF::File& file) {
+	while (file.good()) {
+		Vector::BLF::ObjectHeaderBase* ohb = nullptr;
+		try {
+			ohb = file.read();
+		} catch (std::runtime_error& e) {
+			DEBUG("Exception: " << e.what() << std::endl);
+		}
+		if (ohb == nullptr)
+			return nullptr;
+
+		if (ohb->objectType == Vector::BLF::ObjectType::CAN_MESSAGE2)
+			return reinterpret_cast<Vector::BLF::CanMessage2*>(ohb);
+		delete ohb;
+	}
+	return nullptr;
+}
 #endif
 
+/*!
+ * appends the time \p timestamp to the time column with the index \p index of the data container
+ */
+void VectorBLFFilterPrivate::appendTime(int index, uint64_t timestamp, bool timeInNS) {
+	if (convertTimeToSeconds) {
+		double timestamp_seconds;
+		if (timeInNS)
+			timestamp_seconds = (double)timestamp / pow(10, 9); // TimeOneNans
+		else
+			timestamp_seconds = (double)timestamp / pow(10, 5); // TimeTenMics
+		m_DataContainer.append<double>(index, timestamp_seconds);
+	} else
+		m_DataContainer.append<qint64>(index, timestamp);
+}
+
+/*!
+ * appends a new time column to the data container
+ */
+void VectorBLFFilterPrivate::appendTimeColumn() {
+	if (convertTimeToSeconds)
+		m_DataContainer.appendVector<double>(new QVector<double>(), AbstractColumn::ColumnMode::Double);
+	else
+		m_DataContainer.appendVector<qint64>(new QVector<qint64>(), AbstractColumn::ColumnMode::BigInt); // BigInt is qint64 and not quint64!
+}
+
+QString VectorBLFFilterPrivate::timeColumnName(bool timeInNS) const {
+	if (convertTimeToSeconds)
+		return i18n("Time_s");
+	else if (timeInNS)
+		return i18n("Time_ns");
+	return i18n("Time_10µs");
+}
+
+/*!
+ * reads all CAN messages in a single pass. The decoders of the messages are compiled once when the message id appears
+ * the first time and the decoded values are written directly into the columns. All signals share a common time column.
+ */
 int VectorBLFFilterPrivate::readDataFromFileCommonTime(const QString& fileName, int lines) {
 	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 
@@ -185,179 +248,73 @@ int VectorBLFFilterPrivate::readDataFromFileCommonTime(const QString& fileName,
 		return m_parseState.readLines;
 
 	m_DataContainer.clear();
+	m_signals = DbcParser::Signals();
 
 #ifdef HAVE_VECTOR_BLF
 	Vector::BLF::File file;
 	file.open(fileName.toLocal8Bit().data());
 
-	// 1. Reading in messages
-	QVector<const Vector::BLF::ObjectHeaderBase*> v;
-	Vector::BLF::ObjectHeaderBase* ohb = nullptr;
-	QVector<uint32_t> ids;
-	int message_counter = 0;
-	{
-		PERFTRACE(QLatin1String(Q_FUNC_INFO) + QLatin1String("Parsing BLF file"));
-		while (file.good() && ((lines >= 0 && message_counter < lines) || lines < 0)) {
-			try {
-				ohb = file.read();
-			} catch (std::runtime_error& e) { DEBUG("Exception: " << e.what() << std::endl); }
-			if (ohb == nullptr)
-				break;
-
-			if (ohb->objectType != Vector::BLF::ObjectType::CAN_MESSAGE2)
-				continue;
-
-			int id;
-			if (ohb->objectType == Vector::BLF::ObjectType::CAN_MESSAGE2) {
-				const auto message = reinterpret_cast<Vector::BLF::CanMessage2*>(ohb);
-				id = message->id;
-			} else
-				return 0;
-
-			v.append(ohb);
-			if (!ids.contains(id))
-				ids.append(id);
-			message_counter++;
-		}
-	}
-
-	// 2. Create vector names
-	QHash<uint32_t, int> idIndexTable;
-	m_dbcParser.getSignals(ids, DbcParser::PrefixType::None, DbcParser::SuffixType::Unit, idIndexTable, m_signals);
+	struct Message {
+		int firstSignal; // index of the first signal of the message in values
+		DbcParser::MessageDecoder decoder;
+	};
+	QHash<uint32_t, Message> messages;
+	std::vector<double> values; // current values of all signals
+	QVector<QVector<double>*> signalColumns;
 
-	// 3. allocate memory
-	if (convertTimeToSeconds) {
-		auto* vector = new QVector<double>();
-		vector->resize(message_counter);
-		m_DataContainer.appendVector<double>(vector, AbstractColumn::ColumnMode::Double);
-	} else {
-		auto* vector = new QVector<qint64>();
-		vector->resize(message_counter);
-		m_DataContainer.appendVector<qint64>(vector, AbstractColumn::ColumnMode::BigInt); // BigInt is qint64 and not quint64!
-	}
-	for (int i = 0; i < m_signals.signal_names.length(); i++) {
-		auto* vector = new QVector<double>();
-		vector->resize(message_counter);
-		m_DataContainer.appendVector(vector, AbstractColumn::ColumnMode::Double);
-	}
+	appendTimeColumn();
 
-	// 4. fill datacontainer
+	int message_counter = 0;
 	int message_index = 0;
 	bool timeInNS = true;
-	if (timeHandlingMode == CANFilter::TimeHandling::ConcatNAN) {
-		for (const auto ohb : v) {
-			uint32_t id;
-			std::vector<double> values;
-			DbcParser::ParseStatus status;
-			if (ohb->objectType == Vector::BLF::ObjectType::CAN_MESSAGE2) {
-				const auto message = reinterpret_cast<const Vector::BLF::CanMessage2*>(ohb);
-				id = message->id;
-				status = m_dbcParser.parseMessage(message->id, message->data, values);
-			} else
-				return 0;
-
-			if (status != DbcParser::ParseStatus::Success) {
-				// id is not available in the dbc file, so it is not possible to decode
-				DEBUG("Unable to decode message: " << id << ": " << (int)status);
-				errors.append({DBCParserParseStatusToVectorBLFStatus(status), id});
-				continue;
-			}
-
-			uint64_t timestamp;
-			timeInNS = getTime(ohb, timestamp);
-			if (convertTimeToSeconds) {
-				double timestamp_seconds;
-				if (timeInNS)
-					timestamp_seconds = (double)timestamp / pow(10, 9); // TimeOneNans
-				else
-					timestamp_seconds = (double)timestamp / pow(10, 5); // TimeTenMics
-
-				m_DataContainer.setData<double>(0, message_index, timestamp_seconds);
-			} else
-				m_DataContainer.setData<qint64>(0, message_index, timestamp);
-
-			const size_t startIndex = idIndexTable.value(id) + 1; // +1 because of time
-			for (size_t i = 1; i < startIndex; i++) {
-				m_DataContainer.setData<double>(i, message_index, std::nan("0"));
-			}
-			for (size_t i = startIndex; i < startIndex + values.size(); i++) {
-				m_DataContainer.setData<double>(i, message_index, values.at(i - startIndex));
-			}
-			for (size_t i = startIndex + values.size(); i < m_DataContainer.size(); i++) {
-				m_DataContainer.setData<double>(i, message_index, std::nan("0"));
+	while ((lines >= 0 && message_counter < lines) || lines < 0) {
+		std::unique_ptr<Vector::BLF::CanMessage2> message(readCANMessage(file));
+		if (!message)
+			break;
+		message_counter++;
+
+		const uint32_t id = message->id;
+		auto it = messages.find(id);
+		if (it == messages.end()) {
+			// first message with this id, add the columns for its signals.
+			// The rows read so far don't contain any values for these signals
+			Message m;
+			m.firstSignal = values.size();
+			m_dbcParser.compileMessage(id, DbcParser::PrefixType::None, DbcParser::SuffixType::Unit, m.decoder, m_signals);
+			for (size_t i = 0; i < m.decoder.signalDecoders.size(); i++) {
+				auto* vector = new QVector<double>(message_index, std::nan("0"));
+				m_DataContainer.appendVector(vector, AbstractColumn::ColumnMode::Double);
+				signalColumns.append(vector);
 			}
-			message_index++;
+			values.resize(values.size() + m.decoder.signalDecoders.size(), std::nan("0"));
+			it = messages.insert(id, m);
 		}
-	} else {
-		bool firstMessageValid = false;
-		for (const auto ohb : v) {
-			uint32_t id;
-			std::vector<double> values;
-			DbcParser::ParseStatus status;
-			if (ohb->objectType == Vector::BLF::ObjectType::CAN_MESSAGE2) {
-				const auto message = reinterpret_cast<const Vector::BLF::CanMessage2*>(ohb);
-				id = message->id;
-				status = m_dbcParser.parseMessage(message->id, message->data, values);
-			} else
-				return 0;
-
-			if (status != DbcParser::ParseStatus::Success) {
-				// id is not available in the dbc file, so it is not possible to decode
-				errors.append({DBCParserParseStatusToVectorBLFStatus(status), id});
-				continue;
-			}
 
-			uint64_t timestamp;
-			timeInNS = getTime(ohb, timestamp);
-			if (convertTimeToSeconds) {
-				double timestamp_seconds;
-				if (timeInNS)
-					timestamp_seconds = (double)timestamp / pow(10, 9); // TimeOneNans
-				else
-					timestamp_seconds = (double)timestamp / pow(10, 5); // TimeTenMics
-
-				m_DataContainer.setData<double>(0, message_index, timestamp_seconds);
-			} else
-				m_DataContainer.setData<qint64>(0, message_index, timestamp);
-
-			const std::vector<double>::size_type startIndex = idIndexTable.value(id) + 1; // +1 because of time
-			if (firstMessageValid) {
-				for (std::vector<double>::size_type i = 1; i < startIndex; i++) {
-					const auto prevValue = m_DataContainer.data<double>(i, message_index - 1);
-					m_DataContainer.setData<double>(i, message_index, prevValue);
-				}
-				for (std::vector<double>::size_type i = startIndex; i < startIndex + values.size(); i++) {
-					m_DataContainer.setData<double>(i, message_index, values.at(i - startIndex));
-				}
-				for (std::vector<double>::size_type i = startIndex + values.size(); i < m_DataContainer.size(); i++) {
-					const auto prevValue = m_DataContainer.data<double>(i, message_index - 1);
-					m_DataContainer.setData<double>(i, message_index, prevValue);
-				}
-			} else {
-				for (std::vector<double>::size_type i = 1; i < startIndex; i++)
-					m_DataContainer.setData<double>(i, message_index, std::nan("0"));
-				for (std::vector<double>::size_type i = startIndex; i < startIndex + values.size(); i++)
-					m_DataContainer.setData<double>(i, message_index, values.at(i - startIndex));
-				for (std::vector<double>::size_type i = startIndex + values.size(); i < m_DataContainer.size(); i++)
-					m_DataContainer.setData<double>(i, message_index, std::nan("0"));
-				firstMessageValid = true;
-			}
-			message_index++;
+		const auto& m = it.value();
+		const auto decodeStatus = m.decoder.decode(message->data, values.data() + m.firstSignal);
+		if (decodeStatus != DbcParser::ParseStatus::Success) {
+			// id is not available in the dbc file, so it is not possible to decode
+			DEBUG("Unable to decode message: " << id << ": " << (int)decodeStatus);
+			errors.append({DBCParserParseStatusToVectorBLFStatus(decodeStatus), id});
+			continue;
 		}
+
+		uint64_t timestamp;
+		timeInNS = getTime(message.get(), timestamp);
+		appendTime(0, timestamp, timeInNS);
+		for (int i = 0; i < signalColumns.size(); i++)
+			signalColumns[i]->append(values[i]);
+
+		// in ConcatPrevious mode the values are kept until they are updated by the next message with the same id
+		if (timeHandlingMode == CANFilter::TimeHandling::ConcatNAN)
+			std::fill_n(values.begin() + m.firstSignal, m.decoder.signalDecoders.size(), std::nan("0"));
+		message_index++;
 	}
 
-	// 5. add Time column to vector Names
-	if (convertTimeToSeconds)
-		m_signals.signal_names.prepend(i18n("Time_s")); // Must be done after allocating memory
-	else if (timeInNS)
-		m_signals.signal_names.prepend(i18n("Time_ns")); // Must be done after allocating memory
-	else
-		m_signals.signal_names.prepend(i18n("Time_10µs")); // Must be done after allocating memory
+	// add Time column to vector Names
+	m_signals.signal_names.prepend(timeColumnName(timeInNS));
 	m_signals.value_descriptions.insert(m_signals.value_descriptions.begin(), std::vector<DbcParser::ValueDescriptions>()); // Time does not have any labels
 
-	for (const auto& message : v)
-		delete message;
-
 	if (!m_DataContainer.resize(message_index))
 		return 0;
 
@@ -369,8 +326,129 @@ int VectorBLFFilterPrivate::readDataFromFileCommonTime(const QString& fileName,
 #endif // HAVE_VECTOR_BLF
 }
 
-int VectorBLFFilterPrivate::readDataFromFileSeparateTime(const QString& /*fileName*/, int /*lines*/) {
-	return 0; // Not implemented yet
+/*!
+ * reads all CAN messages in a single pass. Every message id gets its own time column followed by the columns
+ * of its signals, so only the rows of the messages containing the signals are stored.
+ * The columns of the messages with less rows are padded with NaN (with 0 for the time columns in nanoseconds,
+ * BigInt has no NaN), the number of rows of the longest column is returned.
+ */
+int VectorBLFFilterPrivate::readDataFromFileSeparateTime(const QString& fileName, int lines) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+
+	errors.clear();
+
+	if (!isValid(fileName)) {
+		errors.append({ParseStatus::ErrorInvalidFile, 0});
+		return 0;
+	}
+
+	const auto status = m_dbcParser.isValid();
+	if (status != DbcParser::ParseStatus::Success) {
+		errors.append({DBCParserParseStatusToVectorBLFStatus(status), 0});
+		return 0;
+	}
+
+	if (m_parseState.ready && m_parseState.requestedLines == lines)
+		return m_parseState.readLines;
+
+	m_DataContainer.clear();
+	m_signals = DbcParser::Signals();
+
+#ifdef HAVE_VECTOR_BLF
+	Vector::BLF::File file;
+	file.open(fileName.toLocal8Bit().data());
+
+	struct Message {
+		int timeColumn; // index of the time column of the message in the data container
+		int rows{0};
+		DbcParser::MessageDecoder decoder;
+		DbcParser::Signals signalInfos;
+	};
+	QHash<uint32_t, Message> messages;
+	QVector<uint32_t> ids; // message ids in the order of appearance
+	std::vector<double> values; // decoded values of the current message
+
+	int message_counter = 0;
+	int maxRows = 0;
+	bool timeInNS = true;
+	while ((lines >= 0 && message_counter < lines) || lines < 0) {
+		std::unique_ptr<Vector::BLF::CanMessage2> message(readCANMessage(file));
+		if (!message)
+			break;
+		message_counter++;
+
+		const uint32_t id = message->id;
+		auto it = messages.find(id);
+		if (it == messages.end()) {
+			Message m;
+			m.timeColumn = m_DataContainer.size();
+			m_dbcParser.compileMessage(id, DbcParser::PrefixType::Message, DbcParser::SuffixType::Unit, m.decoder, m.signalInfos);
+			if (m.decoder.status == DbcParser::ParseStatus::Success) {
+				appendTimeColumn();
+				for (size_t i = 0; i < m.decoder.signalDecoders.size(); i++)
+					m_DataContainer.appendVector(new QVector<double>(), AbstractColumn::ColumnMode::Double);
+				ids.append(id);
+			}
+			it = messages.insert(id, m);
+		}
+
+		auto& m = it.value();
+		values.resize(m.decoder.signalDecoders.size());
+		const auto decodeStatus = m.decoder.decode(message->data, values.data());
+		if (decodeStatus != DbcParser::ParseStatus::Success) {
+			// id is not available in the dbc file, so it is not possible to decode
+			DEBUG("Unable to decode message: " << id << ": " << (int)decodeStatus);
+			errors.append({DBCParserParseStatusToVectorBLFStatus(decodeStatus), id});
+			continue;
+		}
+
+		uint64_t timestamp;
+		timeInNS = getTime(message.get(), timestamp);
+		appendTime(m.timeColumn, timestamp, timeInNS);
+		for (size_t i = 0; i < values.size(); i++)
+			m_DataContainer.append<double>(m.timeColumn + 1 + i, values.at(i));
+		m.rows++;
+		maxRows = std::max(maxRows, m.rows);
+	}
+
+	// pad the columns of all messages to the same length
+	for (const auto id : ids) {
+		const auto& m = messages.value(id);
+		if (m.rows == maxRows)
+			continue;
+
+		const int missingRows = maxRows - m.rows;
+		const auto& vectors = m_DataContainer.dataContainer();
+		if (m_DataContainer.columnMode(m.timeColumn) == AbstractColumn::ColumnMode::Double) {
+			auto* time = static_cast<QVector<double>*>(vectors.at(m.timeColumn));
+			time->insert(time->end(), missingRows, std::nan("0"));
+		} else {
+			auto* time = static_cast<QVector<qint64>*>(vectors.at(m.timeColumn));
+			time->insert(time->end(), missingRows, 0);
+		}
+		for (size_t i = 0; i < m.decoder.signalDecoders.size(); i++) {
+			auto* vector = static_cast<QVector<double>*>(vectors.at(m.timeColumn + 1 + i));
+			vector->insert(vector->end(), missingRows, std::nan("0"));
+		}
+	}
+
+	// vector names and value labels in the order of the columns
+	for (const auto id : ids) {
+		const auto& m = messages.value(id);
+		m_signals.signal_names.append(m.decoder.name + QLatin1Char('_') + timeColumnName(timeInNS));
+		m_signals.signal_names.append(m.signalInfos.signal_names);
+		m_signals.value_descriptions.push_back(std::vector<DbcParser::ValueDescriptions>()); // Time does not have any labels
+		m_signals.value_descriptions.insert(m_signals.value_descriptions.end(), m.signalInfos.value_descriptions.begin(), m.signalInfos.value_descriptions.end());
+	}
+
+	// Use message_counter here, because it will be used as reference for caching
+	m_parseState = ParseState(message_counter, maxRows);
+	return maxRows;
+#else
+	Q_UNUSED(fileName)
+	Q_UNUSED(lines)
+	return 0;
+#endif // HAVE_VECTOR_BLF
 }
 
 // ##############################################################################
@@ -48,6 +48,10 @@ private:
 	virtual int readDataFromFileCommonTime(const QString& fileName, int lines = -1) override;
 	virtual int readDataFromFileSeparateTime(const QString& fileName, int lines = -1) override;
 
+	void appendTimeColumn();
+	void appendTime(int index, uint64_t timestamp, bool timeInNS);
+	QString timeColumnName(bool timeInNS) const;
+
 #ifdef HAVE_VECTOR_BLF
 	const VectorBLFFilter* q;
 #endif
@@ -12,12 +12,36 @@
 #include "backend/core/column/Column.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/XLSXFilterPrivate.h"
+#include "backend/datasources/filters/XLSXReader.h"
 #include "backend/matrix/Matrix.h"
+#include "backend/matrix/MatrixBuffer.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
 #include <QTreeWidgetItem>
 
+namespace {
+// text of a cell as used for column names and text columns
+QString cellText(const XLSXReader& reader, const XLSXReader::Cell& cell) {
+	switch (cell.type) {
+	case XLSXReader::CellType::Number:
+		return QString::number(cell.value, 'g', QLocale::FloatingPointShortest);
+	case XLSXReader::CellType::Date: {
+		const auto dt = reader.dateTime(cell);
+		return (dt.time() == QTime(0, 0)) ? dt.date().toString(Qt::ISODate) : dt.toString(Qt::ISODate);
+	}
+	case XLSXReader::CellType::Boolean:
+		return cell.value ? QStringLiteral("true") : QStringLiteral("false");
+	case XLSXReader::CellType::String:
+	case XLSXReader::CellType::Error:
+		return cell.text;
+	case XLSXReader::CellType::Empty:
+		break;
+	}
+	return {};
+}
+}
+
 XLSXFilter::XLSXFilter()
 	: AbstractFileFilter(FileType::XLSX)
 	, d(new XLSXFilterPrivate(this)) {
@@ -341,14 +365,13 @@ void XLSXFilterPrivate::write(const QString& fileName, AbstractDataSource* dataS
 	} else if (auto* const matrix = dynamic_cast<Matrix*>(dataSource)) {
 		const int columns = matrix->columnCount();
 		const int rows = matrix->rowCount();
-		const QVector<QVector<double>>* const data = static_cast<QVector<QVector<double>>*>(matrix->data());
+		const auto* const data = static_cast<const MatrixBuffer<double>*>(matrix->data());
 
 		for (int col = 0; col < columns; ++col) {
 			const int actualCol = startCol + col;
-			const auto& column = data->at(col);
 			for (int row = 0; row < rows; ++row) {
 				const int actualRow = startRow + row;
-				const auto& val = column.at(row);
+				const auto& val = data->at(row, col);
 
 				if (!m_document->write(actualRow, actualCol, val)) {
 					// failed to write
@@ -369,13 +392,9 @@ void XLSXFilterPrivate::write(const QString& fileName, AbstractDataSource* dataS
 void XLSXFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	DEBUG(Q_FUNC_INFO)
 #ifdef HAVE_QXLSX
-	if (!m_document || fileName.compare(m_fileName)) {
-		delete m_document;
-		m_document = new QXlsx::Document(fileName);
-		m_fileName = fileName;
-	}
-
-	if (m_document->selectSheet(currentSheet)) {
+	// stream the selected sheet instead of loading the whole document
+	XLSXReader reader(fileName);
+	if (reader.openSheet(currentSheet)) {
 		if (endRow != -1) {
 			int lastRow = currentRange.firstRow() + endRow - 1;
 			if (lastRow <= currentRange.lastRow())
@@ -400,7 +419,7 @@ void XLSXFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 				currentRange.setFirstColumn(firstCol);
 		}
 
-		readDataRegion(currentRange, dataSource, importMode);
+		readDataRegion(reader, currentRange, dataSource, importMode);
 	} else {
 		DEBUG(Q_FUNC_INFO << ", INVALID sheet")
 	}
@@ -413,7 +432,14 @@ void XLSXFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSo
 }
 
 #ifdef HAVE_QXLSX
-void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+/*!
+ * reads the cells of \c region into \c dataSource. The column types are determined in a first pass over the region,
+ * the values are written into the pre-sized columns in a second one.
+ */
+void XLSXFilterPrivate::readDataRegion(XLSXReader& reader,
+									   const QXlsx::CellRange& region,
+									   AbstractDataSource* dataSource,
+									   AbstractFileFilter::ImportMode importMode) {
 	DEBUG(Q_FUNC_INFO << ", col/row range = " << region.firstColumn() << " .. " << region.lastColumn() << ", " << region.firstRow() << " .. "
 					  << region.lastRow() << ". first row as column names = " << firstRowAsColumnNames)
 
@@ -424,23 +450,23 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 	bool isDateOnly = true;
 
 	if (auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource)) {
-		std::vector<void*> numericDataPointers;
-		QVector<QVector<QDateTime>*> datetimeDataPointers;
-		QVector<QVector<QString>*> stringDataPointers;
-		QList<QXlsx::Cell::CellType> columnNumericTypes;
 		QStringList columnNames;
-		if (firstRowAsColumnNames)
+		if (firstRowAsColumnNames) {
 			regionToRead.setFirstRow(region.firstRow() + 1);
-
-		// determine column type (numeric or not)
-		for (int col = regionToRead.firstColumn(); col <= regionToRead.lastColumn(); ++col) {
-			columnNumericTypes.push_back(columnTypeInRange(col, regionToRead));
-			if (firstRowAsColumnNames)
-				columnNames.push_back(m_document->read(regionToRead.firstRow() - 1, col).toString());
-			else
+			for (int i = 0; i < colCount; ++i)
+				columnNames << QString();
+			reader.readRegion(region.firstRow(), region.firstRow(), region.firstColumn(), region.lastColumn(), [&](int, int col, const XLSXReader::Cell& cell) {
+				columnNames[col - region.firstColumn()] = cellText(reader, cell);
+				return true;
+			});
+		} else {
+			for (int col = regionToRead.firstColumn(); col <= regionToRead.lastColumn(); ++col)
 				columnNames.push_back(AbstractFileFilter::convertFromNumberToColumn(col));
 		}
 
+		// determine column types (numeric, datetime or text)
+		const auto columnTypes = columnTypesInRange(reader, regionToRead);
+
 		spreadsheet->setUndoAware(false);
 		columnOffset = spreadsheet->resize(importMode, columnNames, colCount);
 
@@ -452,55 +478,61 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 				spreadsheet->setRowCount(rowCount);
 		}
 
+		// pre-size the columns, the data of the region is appended to the current data of the columns
+		const int rows = regionToRead.rowCount();
+		std::vector<void*> dataContainer(colCount);
+		QVector<int> rowOffsets(colCount);
 		for (int n = 0; n < colCount; ++n) {
 			auto* col = spreadsheet->column(columnOffset + n);
-			if (columnNumericTypes.at(n) == QXlsx::Cell::CellType::NumberType) {
+			if (columnTypes.at(n) == QXlsx::Cell::CellType::NumberType) {
 				col->setColumnMode(AbstractColumn::ColumnMode::Double);
 				auto* data = static_cast<QVector<double>*>(col->data());
-				numericDataPointers.push_back(data);
 				if (importMode == AbstractFileFilter::ImportMode::Replace)
 					data->clear();
-			} else if (columnNumericTypes.at(n) == QXlsx::Cell::CellType::DateType) {
+				rowOffsets[n] = data->size();
+				data->resize(rowOffsets.at(n) + rows);
+				dataContainer[n] = data;
+			} else if (columnTypes.at(n) == QXlsx::Cell::CellType::DateType) {
 				col->setColumnMode(AbstractColumn::ColumnMode::DateTime);
 				auto* data = static_cast<QVector<QDateTime>*>(col->data());
-				datetimeDataPointers.push_back(data);
 				if (importMode == AbstractFileFilter::ImportMode::Replace)
 					data->clear();
+				rowOffsets[n] = data->size();
+				data->resize(rowOffsets.at(n) + rows);
+				dataContainer[n] = data;
 			} else {
 				col->setColumnMode(AbstractColumn::ColumnMode::Text);
 				auto* data = static_cast<QVector<QString>*>(col->data());
-				stringDataPointers.push_back(data);
 				if (importMode == AbstractFileFilter::ImportMode::Replace)
 					data->clear();
+				rowOffsets[n] = data->size();
+				data->resize(rowOffsets.at(n) + rows);
+				dataContainer[n] = data;
 			}
 		}
 
-		for (int row = regionToRead.firstRow(); row <= regionToRead.lastRow(); ++row) {
-			int j = 0;
-			unsigned int numericidx = 0;
-			int datetimeidx = 0;
-			int stringidx = 0;
-			for (int col = regionToRead.firstColumn(); col <= regionToRead.lastColumn(); ++col) {
-				const auto val = m_document->read(row, col);
-				if (columnNumericTypes.at(j) == QXlsx::Cell::CellType::NumberType) {
-					if (numericidx < numericDataPointers.size())
-						static_cast<QVector<double>*>(numericDataPointers[numericidx++])->push_back(val.toDouble());
-				} else if (columnNumericTypes.at(j) == QXlsx::Cell::CellType::DateType) {
-					// QDEBUG("DATETIME:" << m_document->read(row, col).toDateTime())
-					if (datetimeidx < datetimeDataPointers.size()) {
-						if (val.toDateTime().time() != QTime(0, 0))
-							isDateOnly = false;
-						static_cast<QVector<QDateTime>*>(datetimeDataPointers[datetimeidx++])->push_back(val.toDateTime());
-					}
-				} else {
-					if (!stringDataPointers.isEmpty() && stringidx < stringDataPointers.size()) {
-						const auto s = val.toString();
-						stringDataPointers[stringidx++]->operator<<(s);
-					}
-				}
-				++j;
-			}
-		}
+		// empty cells keep the default values (0, invalid datetime, empty text)
+		reader.readRegion(regionToRead.firstRow(),
+						  regionToRead.lastRow(),
+						  regionToRead.firstColumn(),
+						  regionToRead.lastColumn(),
+						  [&](int row, int col, const XLSXReader::Cell& cell) {
+							  const int n = col - regionToRead.firstColumn();
+							  const int index = rowOffsets.at(n) + row - regionToRead.firstRow();
+							  if (columnTypes.at(n) == QXlsx::Cell::CellType::NumberType) {
+								  if (cell.type == XLSXReader::CellType::Number || cell.type == XLSXReader::CellType::Boolean)
+									  (*static_cast<QVector<double>*>(dataContainer[n]))[index] = cell.value;
+							  } else if (columnTypes.at(n) == QXlsx::Cell::CellType::DateType) {
+								  if (cell.type == XLSXReader::CellType::Date) {
+									  const auto dt = reader.dateTime(cell);
+									  if (dt.time() != QTime(0, 0))
+										  isDateOnly = false;
+									  (*static_cast<QVector<QDateTime>*>(dataContainer[n]))[index] = dt;
+								  }
+							  } else
+								  (*static_cast<QVector<QString>*>(dataContainer[n]))[index] = cellText(reader, cell);
+							  return true;
+						  });
 	} else if (dynamic_cast<Matrix*>(dataSource)) {
 		QVector<AbstractColumn::ColumnMode> columnModes;
 		QStringList vectorNames;
@@ -510,13 +542,18 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 		dataContainer.reserve(colCount);
 		columnOffset = dataSource->prepareImport(dataContainer, importMode, rowCount, colCount, vectorNames, columnModes);
 
-		int i = 0;
-		for (int row = region.firstRow(); row <= region.lastRow(); ++row) {
-			int j = 0;
-			for (int col = region.firstColumn(); col <= region.lastColumn(); ++col)
-				static_cast<QVector<double>*>(dataContainer[j++])->operator[](i) = m_document->read(row, col).toDouble();
-			++i;
+		for (auto* data : dataContainer) {
+			auto* vector = static_cast<QVector<double>*>(data);
+			std::fill(vector->begin(), vector->end(), 0.);
 		}
+
+		reader.readRegion(region.firstRow(), region.lastRow(), region.firstColumn(), region.lastColumn(), [&](int row, int col, const XLSXReader::Cell& cell) {
+			double value = cell.value; // number, boolean or serial date number
+			if (cell.type == XLSXReader::CellType::String || cell.type == XLSXReader::CellType::Error)
+				value = cell.text.toDouble();
+			(*static_cast<QVector<double>*>(dataContainer[col - region.firstColumn()]))[row - region.firstRow()] = value;
+			return true;
+		});
 	}
 
 	QLatin1String datetimeFormat;
@@ -618,77 +655,87 @@ QVector<QStringList> XLSXFilterPrivate::previewForDataRegion(const QString& shee
 	DEBUG(Q_FUNC_INFO << ", sheet name = " << STDSTRING(sheetName))
 	QVector<QStringList> infoString;
 
-	if (!m_document) {
-		delete m_document;
-		m_document = new QXlsx::Document(m_fileName);
-	}
+	// only the rows shown in the preview are read from the sheet
+	XLSXReader reader(m_fileName);
+	if (reader.openSheet(sheetName) && region.isValid()) { // valid sheet name and region
+		DEBUG(Q_FUNC_INFO << ", region first/last row = " << region.firstRow() << " " << region.lastRow())
+		DEBUG(Q_FUNC_INFO << ", region first/last column = " << region.firstColumn() << " " << region.lastColumn())
+		DEBUG(Q_FUNC_INFO << ", start/end row = " << startRow << " " << endRow)
+		DEBUG(Q_FUNC_INFO << ", start/end col = " << startColumn << " " << endColumn)
+
+		int rows = region.lastRow() - region.firstRow() + 1;
+		if (startRow > rows) // if startRow is bigger than available rows -> show all
+			startRow = 1;
+		if (endRow == -1 || endRow < startRow || endRow > rows)
+			endRow = rows;
+		int cols = region.lastColumn() - region.firstColumn() + 1;
+		if (startColumn > cols) // if startColumn is bigger than available columns -> show all
+			startColumn = 1;
+		if (endColumn == -1 || endColumn < startColumn || endColumn > cols)
+			endColumn = cols;
+		firstColumn = startColumn;
+
+		const int maxCols = 100;
+		rows = std::min(lines, endRow);
+		cols = std::min(maxCols, endColumn);
+		const int firstRow = region.firstRow() + startRow - 1;
+		const int firstCol = region.firstColumn() + startColumn - 1;
+		const int lastRow = region.firstRow() + rows - 1;
+		const int lastCol = region.firstColumn() + cols - 1;
+		if (lastRow < firstRow || lastCol < firstCol)
+			return infoString;
+
+		for (int row = firstRow; row <= lastRow; ++row) {
+			QStringList line;
+			for (int col = firstCol; col <= lastCol; ++col)
+				line << QString();
+			infoString << line;
+		}
 
-	if (m_document->selectSheet(sheetName) && region.isValid()) { // valid sheet name and region
-		if (okToMatrix && dataRangeCanBeExportedToMatrix(region))
-			*okToMatrix = true;
-
-		const auto& documentRegion = m_document->dimension();
-		if (region.lastRow() <= documentRegion.lastRow() && region.lastColumn() <= documentRegion.lastColumn()) {
-			DEBUG(Q_FUNC_INFO << ", region first/last row = " << region.firstRow() << " " << region.lastRow())
-			DEBUG(Q_FUNC_INFO << ", region first/last column = " << region.firstColumn() << " " << region.lastColumn())
-			DEBUG(Q_FUNC_INFO << ", start/end row = " << startRow << " " << endRow)
-			DEBUG(Q_FUNC_INFO << ", start/end col = " << startColumn << " " << endColumn)
-
-			int rows = region.lastRow() - region.firstRow() + 1;
-			if (startRow > rows) // if startRow is bigger than available rows -> show all
-				startRow = 1;
-			if (endRow == -1 || endRow < startRow || endRow > rows)
-				endRow = rows;
-			int cols = region.lastColumn() - region.firstColumn() + 1;
-			if (startColumn > cols) // if startColumn is bigger than available columns -> show all
-				startColumn = 1;
-			if (endColumn == -1 || endColumn < startColumn || endColumn > cols)
-				endColumn = cols;
-			firstColumn = startColumn;
-
-			const int maxCols = 100;
-			rows = std::min(lines, endRow);
-			cols = std::min(maxCols, endColumn);
-			for (int row = region.firstRow() + startRow - 1; row < region.firstRow() + rows; ++row) {
-				QStringList line;
-				for (int col = region.firstColumn() + startColumn - 1; col < region.firstColumn() + cols; ++col) {
-					// see https://github.com/QtExcel/QXlsx/wiki for read() vs. cellAt()->value()
-					const auto val = m_document->read(row, col);
-					if (val.isValid())
-						QDEBUG("value =" << val)
-					// Excel: double is always QString
-					// OO: can always convert to Double
-
-					// correctly read values and show with locale
-					if (val.type() == QVariant::Double)
-						line << QLocale().toString(val.toDouble());
-					else if (val.type() == QVariant::String) {
-						QString valueString = val.toString();
-
-						bool ok; // check if double value
-						double value = valueString.toDouble(&ok);
-						if (ok)
-							line << QLocale().toString(value);
-						else
-							line << valueString;
-					} else if (val.canConvert(QMetaType::QDateTime)) {
-						QDateTime dt = val.toDateTime();
-						// TODO: use certain date/datetime format?
-						if (dt.time() == QTime(0, 0)) // just a date
-							line << val.toDate().toString();
-						else
-							line << dt.toString();
-					} else if (val.canConvert(QMetaType::QTime)) {
-						QTime t = val.toTime();
-						// TODO: use certain time format?
-						line << t.toString();
-					} else {
-						QString valueString = val.toString();
-						line << valueString;
-					}
-				}
-				infoString << line;
+		bool numeric = true;
+		reader.readRegion(firstRow, lastRow, firstCol, lastCol, [&](int row, int col, const XLSXReader::Cell& cell) {
+			// correctly read values and show with locale
+			QString value;
+			switch (cell.type) {
+			case XLSXReader::CellType::Number:
+				value = QLocale().toString(cell.value);
+				break;
+			case XLSXReader::CellType::String: {
+				bool ok; // check if double value
+				const double d = cell.text.toDouble(&ok);
+				value = ok ? QLocale().toString(d) : cell.text;
+				numeric = false;
+				break;
 			}
+			case XLSXReader::CellType::Date: {
+				// TODO: use certain date/datetime format?
+				const auto dt = reader.dateTime(cell);
+				if (cell.text.isEmpty() && cell.value < 1) // just a time
+					value = dt.time().toString();
+				else if (dt.time() == QTime(0, 0)) // just a date
+					value = dt.date().toString();
+				else
+					value = dt.toString();
+				numeric = false;
+				break;
+			}
+			case XLSXReader::CellType::Boolean:
+			case XLSXReader::CellType::Error:
+			case XLSXReader::CellType::Empty:
+				value = cellText(reader, cell);
+				numeric = false;
+				break;
+			}
+			infoString[row - firstRow][col - firstCol] = value;
+			return true;
+		});
+
+		// check the whole region if the document is available, the previewed cells otherwise
+		if (okToMatrix) {
+			if (m_document && m_document->selectSheet(sheetName))
+				numeric = dataRangeCanBeExportedToMatrix(region);
+			if (numeric)
+				*okToMatrix = true;
 		}
 	}
 
@@ -774,37 +821,44 @@ QXlsx::CellRange XLSXFilterPrivate::dimension() const {
 #endif
 
 #ifdef HAVE_QXLSX
-QXlsx::Cell::CellType XLSXFilterPrivate::columnTypeInRange(const int column, const QXlsx::CellRange& range) const {
-	bool numeric = false, datetime = false;
-	if (column >= range.firstColumn() && column <= range.lastColumn()) {
-		for (int row = range.firstRow(); row <= range.lastRow(); ++row) {
-			const auto* cell = m_document->cellAt(row, column);
-			if (!cell)
-				continue;
-
-			// QDEBUG(" cell type =" << cell->cellType())
-			if (cell->cellType() == QXlsx::Cell::CellType::StringType)
-				return QXlsx::Cell::CellType::StringType;
-			if (cell->cellType() == QXlsx::Cell::CellType::NumberType)
-				numeric = true;
-			else if (cell->cellType() == QXlsx::Cell::CellType::DateType) // switch to date if date cell
-				datetime = true;
-			else if (cell->cellType() == QXlsx::Cell::CellType::CustomType) {
-				bool ok = false;
-				cell->value().toDouble(&ok);
-				if (ok)
-					numeric = true;
-				else
-					return QXlsx::Cell::CellType::StringType;
-			}
+/*!
+ * determines the types of the columns in \c range by streaming over its cells:
+ * text if any cell is a text, numeric or datetime if all non-empty cells are numbers or dates respectively, text otherwise.
+ */
+QVector<QXlsx::Cell::CellType> XLSXFilterPrivate::columnTypesInRange(XLSXReader& reader, const QXlsx::CellRange& range) const {
+	const int colCount = range.columnCount();
+	QVector<bool> numeric(colCount), datetime(colCount), text(colCount);
+	reader.readRegion(range.firstRow(), range.lastRow(), range.firstColumn(), range.lastColumn(), [&](int, int col, const XLSXReader::Cell& cell) {
+		const int n = col - range.firstColumn();
+		switch (cell.type) {
+		case XLSXReader::CellType::Number:
+			numeric[n] = true;
+			break;
+		case XLSXReader::CellType::Date:
+			datetime[n] = true;
+			break;
+		case XLSXReader::CellType::String:
+			text[n] = true;
+			break;
+		case XLSXReader::CellType::Boolean:
+		case XLSXReader::CellType::Error:
+		case XLSXReader::CellType::Empty:
+			break;
 		}
+		return true;
+	});
+
+	QVector<QXlsx::Cell::CellType> types(colCount, QXlsx::Cell::CellType::StringType);
+	for (int n = 0; n < colCount; ++n) {
+		if (text.at(n))
+			continue;
+		if (numeric.at(n) && !datetime.at(n))
+			types[n] = QXlsx::Cell::CellType::NumberType;
+		else if (datetime.at(n) && !numeric.at(n))
+			types[n] = QXlsx::Cell::CellType::DateType;
+		// numeric and datetime or empty: text
 	}
-	if (numeric && !datetime)
-		return QXlsx::Cell::CellType::NumberType;
-	if (datetime && !numeric)
-		return QXlsx::Cell::CellType::DateType;
 
-	// numeric and datetime
-	return QXlsx::Cell::CellType::StringType;
+	return types;
 }
 #endif
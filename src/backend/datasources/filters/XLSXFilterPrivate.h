@@ -13,6 +13,7 @@
 #include "backend/datasources/filters/AbstractFileFilter.h"
 
 class XLSXFilter;
+class XLSXReader;
 class QTreeWidgetItem;
 
 class XLSXFilterPrivate {
@@ -27,12 +28,12 @@ public:
 	QStringList sheets() const;
 
 #ifdef HAVE_QXLSX
-	void readDataRegion(const QXlsx::CellRange& region, AbstractDataSource*, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	void readDataRegion(XLSXReader&, const QXlsx::CellRange& region, AbstractDataSource*, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	QVector<QXlsx::CellRange> dataRegions(const QString& fileName, const QString& sheetName);
 	QVector<QStringList> previewForDataRegion(const QString& sheet, const QXlsx::CellRange& region, bool* okToMatrix, int lines);
 	QXlsx::CellRange cellContainedInRegions(const QXlsx::CellReference& cell, const QVector<QXlsx::CellRange>& regions) const;
 	bool dataRangeCanBeExportedToMatrix(const QXlsx::CellRange& range) const;
-	QXlsx::Cell::CellType columnTypeInRange(const int column, const QXlsx::CellRange& range) const;
+	QVector<QXlsx::Cell::CellType> columnTypesInRange(XLSXReader&, const QXlsx::CellRange& range) const;
 
 	QXlsx::CellRange dimension() const;
 #endif
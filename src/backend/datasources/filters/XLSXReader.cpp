@@ -0,0 +1,434 @@
+/*
+	File                 : XLSXReader.cpp
+	Project              : LabPlot
+	Description          : Streaming reader for the cells of XLSX worksheets
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "XLSXReader.h"
+#include "backend/lib/macros.h"
+
+#include <KZip>
+
+#include <QDir>
+#include <QXmlStreamReader>
+
+#include <cmath>
+
+namespace {
+// attribute values are QStringRef in Qt5 and QStringView in Qt6
+template<typename String>
+bool parseBoolean(const String& value) {
+	return (value == QLatin1String("1") || value == QLatin1String("true"));
+}
+
+// built-in number formats representing date and time values
+bool isBuiltinDateTimeFormat(int id) {
+	return (id >= 14 && id <= 22) || (id >= 27 && id <= 36) || (id >= 45 && id <= 47) || (id >= 50 && id <= 58);
+}
+
+// same heuristics as used by QXlsx for custom number formats: only the first section is relevant
+bool isDateTimeFormat(const QString& formatCode) {
+	for (int i = 0; i < formatCode.length(); ++i) {
+		switch (formatCode.at(i).unicode()) {
+		case '[':
+			// [h], [m], [s] are valid format for time
+			if (i < formatCode.length() - 2 && formatCode.at(i + 2) == QLatin1Char(']')) {
+				const QChar c = formatCode.at(i + 1).toLower();
+				if (c == QLatin1Char('h') || c == QLatin1Char('m') || c == QLatin1Char('s'))
+					return true;
+				i += 2;
+			} else { // condition or color
+				while (i < formatCode.length() && formatCode.at(i) != QLatin1Char(']'))
+					++i;
+			}
+			break;
+		case '"': // quoted text
+			while (i < formatCode.length() - 1 && formatCode.at(++i) != QLatin1Char('"'))
+				;
+			break;
+		case '\\': // escaped character
+			if (i < formatCode.length() - 1)
+				++i;
+			break;
+		case '#':
+		case ';':
+			return false;
+		case 'D':
+		case 'd':
+		case 'Y':
+		case 'y':
+		case 'H':
+		case 'h':
+		case 'S':
+		case 's':
+		case 'M':
+		case 'm':
+			return true;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
+// column number (1-based) of a cell reference like "AB12"
+template<typename String>
+int columnFromReference(const String& ref) {
+	int column = 0;
+	for (const auto c : ref) {
+		if (c < QLatin1Char('A') || c > QLatin1Char('Z'))
+			break;
+		column = column * 26 + (c.unicode() - 'A' + 1);
+	}
+	return column;
+}
+
+// plain text of a shared or inline string, runs are concatenated, phonetic hints are ignored
+QString readRichText(QXmlStreamReader& reader) {
+	QString text;
+	while (reader.readNextStartElement()) {
+		if (reader.name() == QLatin1String("t"))
+			text += reader.readElementText();
+		else if (reader.name() == QLatin1String("r")) {
+			while (reader.readNextStartElement()) {
+				if (reader.name() == QLatin1String("t"))
+					text += reader.readElementText();
+				else
+					reader.skipCurrentElement();
+			}
+		} else
+			reader.skipCurrentElement();
+	}
+	return text;
+}
+}
+
+XLSXReader::XLSXReader(const QString& fileName)
+	: m_fileName(fileName) {
+}
+
+XLSXReader::~XLSXReader() = default;
+
+/*!
+ * selects the sheet \c sheetName to be read with \c readRegion().
+ * Returns \c false if the file can't be opened or doesn't contain the sheet.
+ */
+bool XLSXReader::openSheet(const QString& sheetName) {
+	if (!m_packageRead && !readPackage())
+		return false;
+
+	m_sheetPath = m_sheetPaths.value(sheetName);
+	if (m_sheetPath.isEmpty()) {
+		DEBUG(Q_FUNC_INFO << ", sheet not found: " << STDSTRING(sheetName))
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * reads the cells in the rows \c firstRow .. \c lastRow and columns \c firstColumn .. \c lastColumn (1-based)
+ * of the opened sheet and passes the non-empty ones to \c visitor. Reading stops after the last row of the region.
+ */
+bool XLSXReader::readRegion(int firstRow, int lastRow, int firstColumn, int lastColumn, const CellVisitor& visitor) {
+	auto dev = device(m_sheetPath);
+	if (!dev)
+		return false;
+
+	QXmlStreamReader reader(dev.get());
+	bool inSheetData = false;
+	int row = 0, column = 0;
+	Cell cell;
+	while (!reader.atEnd()) {
+		const auto token = reader.readNext();
+		if (token == QXmlStreamReader::EndElement && reader.name() == QLatin1String("sheetData"))
+			break;
+		if (token != QXmlStreamReader::StartElement)
+			continue;
+
+		if (reader.name() == QLatin1String("sheetData")) {
+			inSheetData = true;
+			continue;
+		}
+		if (!inSheetData)
+			continue;
+
+		const auto attributes = reader.attributes();
+		if (reader.name() == QLatin1String("row")) {
+			const auto r = attributes.value(QLatin1String("r"));
+			row = r.isEmpty() ? row + 1 : r.toInt();
+			column = 0;
+			if (row > lastRow) // the rows are sorted
+				break;
+			if (row < firstRow)
+				reader.skipCurrentElement();
+		} else if (reader.name() == QLatin1String("c")) {
+			const auto r = attributes.value(QLatin1String("r"));
+			column = r.isEmpty() ? column + 1 : columnFromReference(r);
+			if (column < firstColumn || column > lastColumn) {
+				reader.skipCurrentElement();
+				continue;
+			}
+
+			readCell(reader, cell);
+			if (cell.type != CellType::Empty && !visitor(row, column, cell))
+				break;
+		}
+	}
+
+	if (reader.hasError()) {
+		DEBUG(Q_FUNC_INFO << ", ERROR reading " << STDSTRING(m_sheetPath) << ": " << STDSTRING(reader.errorString()))
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * converts the serial date number of a date cell to the date and time it represents.
+ */
+QDateTime XLSXReader::dateTime(const Cell& cell) const {
+	if (!cell.text.isEmpty()) // ISO 8601 date of cells with type "d"
+		return QDateTime::fromString(cell.text, Qt::ISODate);
+
+	double value = cell.value;
+	if (!m_date1904 && value > 60) // Excel considers 1900 as a leap year
+		value -= 1;
+
+	double days;
+	const double fraction = std::modf(value, &days);
+	QDate date = (m_date1904 ? QDate(1904, 1, 1) : QDate(1899, 12, 31)).addDays(static_cast<qint64>(days));
+	// compose date and time instead of adding milliseconds to avoid the shift on daylight saving days
+	auto msecs = std::llround(fraction * 86400000.);
+	if (msecs >= 86400000) {
+		date = date.addDays(1);
+		msecs -= 86400000;
+	}
+
+	return {date, QTime::fromMSecsSinceStartOfDay(static_cast<int>(msecs))};
+}
+
+// ##############################################################################
+// ############################ private ########################################
+// ##############################################################################
+
+/*!
+ * reads the workbook (sheet names, date system) and the cell styles. The worksheets themselves are only read on demand.
+ */
+bool XLSXReader::readPackage() {
+	m_packageRead = true;
+	m_zip = std::make_unique<KZip>(m_fileName);
+	if (!m_zip->open(QIODevice::ReadOnly)) {
+		DEBUG(Q_FUNC_INFO << ", ERROR: failed to open " << STDSTRING(m_fileName))
+		return false;
+	}
+
+	QString workbookPath = QStringLiteral("xl/workbook.xml");
+	for (const auto& rel : relationships(QString())) {
+		if (rel.type.endsWith(QLatin1String("/officeDocument"))) {
+			workbookPath = rel.target;
+			break;
+		}
+	}
+
+	QHash<QString, QString> sheetIds; // relationship id -> sheet name
+	{
+		auto dev = device(workbookPath);
+		if (!dev)
+			return false;
+
+		QXmlStreamReader reader(dev.get());
+		while (!reader.atEnd()) {
+			if (reader.readNext() != QXmlStreamReader::StartElement)
+				continue;
+
+			const auto attributes = reader.attributes();
+			if (reader.name() == QLatin1String("workbookPr"))
+				m_date1904 = parseBoolean(attributes.value(QLatin1String("date1904")));
+			else if (reader.name() == QLatin1String("sheet")) {
+				// r:id, the namespace of the relationships differs between transitional and strict documents
+				for (const auto& attribute : attributes) {
+					if (attribute.name() == QLatin1String("id") && !attribute.namespaceUri().isEmpty())
+						sheetIds.insert(attribute.value().toString(), attributes.value(QLatin1String("name")).toString());
+				}
+			}
+		}
+	}
+
+	for (const auto& rel : relationships(workbookPath)) {
+		if (rel.type.endsWith(QLatin1String("/worksheet"))) {
+			const auto it = sheetIds.constFind(rel.id);
+			if (it != sheetIds.constEnd())
+				m_sheetPaths.insert(it.value(), rel.target);
+		} else if (rel.type.endsWith(QLatin1String("/styles")))
+			m_stylesPath = rel.target;
+		else if (rel.type.endsWith(QLatin1String("/sharedStrings")))
+			m_sharedStringsPath = rel.target;
+	}
+
+	readStyles();
+
+	return true;
+}
+
+/*!
+ * determines the cell styles (cellXfs) that apply a date or time number format.
+ */
+void XLSXReader::readStyles() {
+	auto dev = device(m_stylesPath);
+	if (!dev)
+		return;
+
+	QHash<int, QString> customFormats;
+	bool inCellXfs = false;
+	QXmlStreamReader reader(dev.get());
+	while (!reader.atEnd()) {
+		const auto token = reader.readNext();
+		if (token == QXmlStreamReader::EndElement && reader.name() == QLatin1String("cellXfs"))
+			break;
+		if (token != QXmlStreamReader::StartElement)
+			continue;
+
+		const auto attributes = reader.attributes();
+		if (reader.name() == QLatin1String("numFmt"))
+			customFormats.insert(attributes.value(QLatin1String("numFmtId")).toInt(), attributes.value(QLatin1String("formatCode")).toString());
+		else if (reader.name() == QLatin1String("cellXfs"))
+			inCellXfs = true;
+		else if (inCellXfs && reader.name() == QLatin1String("xf")) {
+			bool date = false;
+			// the number format is only used if it's applied
+			if (parseBoolean(attributes.value(QLatin1String("applyNumberFormat")))) {
+				const int id = attributes.value(QLatin1String("numFmtId")).toInt();
+				const auto it = customFormats.constFind(id);
+				date = (it != customFormats.constEnd()) ? isDateTimeFormat(it.value()) : isBuiltinDateTimeFormat(id);
+			}
+			m_dateStyles << date;
+		}
+	}
+}
+
+void XLSXReader::readSharedStrings() {
+	m_sharedStringsRead = true;
+	auto dev = device(m_sharedStringsPath);
+	if (!dev)
+		return;
+
+	QXmlStreamReader reader(dev.get());
+	while (!reader.atEnd()) {
+		if (reader.readNext() != QXmlStreamReader::StartElement)
+			continue;
+
+		if (reader.name() == QLatin1String("sst"))
+			m_sharedStrings.reserve(reader.attributes().value(QLatin1String("uniqueCount")).toInt());
+		else if (reader.name() == QLatin1String("si"))
+			m_sharedStrings << readRichText(reader);
+	}
+}
+
+/*!
+ * returns the device to read the file \c path in the archive from, the content is decompressed while reading.
+ */
+std::unique_ptr<QIODevice> XLSXReader::device(const QString& path) const {
+	if (!m_zip || path.isEmpty())
+		return {};
+
+	const auto* entry = m_zip->directory()->entry(path);
+	if (!entry || !entry->isFile()) {
+		DEBUG(Q_FUNC_INFO << ", file not found in the archive: " << STDSTRING(path))
+		return {};
+	}
+
+	return std::unique_ptr<QIODevice>(static_cast<const KArchiveFile*>(entry)->createDevice());
+}
+
+/*!
+ * reads the relationships of the part \c sourcePath (of the package if empty) with the targets resolved to paths in the archive.
+ */
+QVector<XLSXReader::Relationship> XLSXReader::relationships(const QString& sourcePath) const {
+	QVector<Relationship> rels;
+
+	const int index = sourcePath.lastIndexOf(QLatin1Char('/'));
+	const QString dir = sourcePath.left(index + 1);
+	auto dev = device(dir + QLatin1String("_rels/") + sourcePath.mid(index + 1) + QLatin1String(".rels"));
+	if (!dev)
+		return rels;
+
+	QXmlStreamReader reader(dev.get());
+	while (!reader.atEnd()) {
+		if (reader.readNext() != QXmlStreamReader::StartElement || reader.name() != QLatin1String("Relationship"))
+			continue;
+
+		const auto attributes = reader.attributes();
+		if (attributes.value(QLatin1String("TargetMode")) == QLatin1String("External"))
+			continue;
+
+		Relationship rel;
+		rel.id = attributes.value(QLatin1String("Id")).toString();
+		rel.type = attributes.value(QLatin1String("Type")).toString();
+		const auto target = attributes.value(QLatin1String("Target")).toString();
+		if (target.startsWith(QLatin1Char('/')))
+			rel.target = target.mid(1);
+		else
+			rel.target = QDir::cleanPath(dir + target);
+		rels << rel;
+	}
+
+	return rels;
+}
+
+/*!
+ * reads the cell at the current start element \c c into \c cell. Formulas are not evaluated, their cached results are used.
+ */
+void XLSXReader::readCell(QXmlStreamReader& reader, Cell& cell) {
+	const auto attributes = reader.attributes();
+	const auto type = attributes.value(QLatin1String("t"));
+	const int style = attributes.value(QLatin1String("s")).toInt();
+
+	cell = Cell();
+	QString value;
+	bool hasValue = false;
+	while (reader.readNextStartElement()) {
+		if (reader.name() == QLatin1String("v")) {
+			value = reader.readElementText();
+			hasValue = true;
+		} else if (reader.name() == QLatin1String("is")) { // inline string
+			value = readRichText(reader);
+			hasValue = true;
+		} else // formula, extensions
+			reader.skipCurrentElement();
+	}
+
+	if (!hasValue)
+		return;
+
+	if (type == QLatin1String("s")) {
+		if (!m_sharedStringsRead)
+			readSharedStrings();
+		cell.type = CellType::String;
+		cell.text = m_sharedStrings.value(value.toInt());
+	} else if (type == QLatin1String("inlineStr") || type == QLatin1String("str")) {
+		cell.type = CellType::String;
+		cell.text = value;
+	} else if (type == QLatin1String("b")) {
+		cell.type = CellType::Boolean;
+		cell.value = value.toInt();
+	} else if (type == QLatin1String("e")) {
+		cell.type = CellType::Error;
+		cell.text = value;
+	} else if (type == QLatin1String("d")) {
+		cell.type = CellType::Date;
+		cell.text = value;
+	} else { // number ("n" or no type)
+		bool ok;
+		cell.value = value.toDouble(&ok);
+		if (!ok) {
+			cell.type = CellType::String;
+			cell.text = value;
+		} else if (cell.value >= 0 && style >= 0 && style < m_dateStyles.size() && m_dateStyles.at(style))
+			cell.type = CellType::Date;
+		else
+			cell.type = CellType::Number;
+	}
+}
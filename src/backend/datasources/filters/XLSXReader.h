@@ -0,0 +1,77 @@
+/*
+	File                 : XLSXReader.h
+	Project              : LabPlot
+	Description          : Streaming reader for the cells of XLSX worksheets
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef XLSXREADER_H
+#define XLSXREADER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+#include <memory>
+
+class KZip;
+class QIODevice;
+class QXmlStreamReader;
+
+/*!
+ * Reads the cells of one worksheet of a XLSX file sequentially from the zip archive
+ * without building the whole document in memory. Only the rows of the requested region
+ * are decoded, shared strings are loaded when the first cell references them.
+ */
+class XLSXReader {
+public:
+	enum class CellType { Empty, Number, Date, String, Boolean, Error };
+
+	struct Cell {
+		CellType type{CellType::Empty};
+		double value{0.}; // numeric value, serial date number or boolean
+		QString text; // string value, error text or ISO date of inline dates
+	};
+
+	// called for the non-empty cells of the region in row-major order, return false to stop reading
+	using CellVisitor = std::function<bool(int row, int column, const Cell&)>;
+
+	explicit XLSXReader(const QString& fileName);
+	~XLSXReader();
+
+	bool openSheet(const QString& sheetName);
+	bool readRegion(int firstRow, int lastRow, int firstColumn, int lastColumn, const CellVisitor&);
+
+	QDateTime dateTime(const Cell&) const;
+
+private:
+	struct Relationship {
+		QString id;
+		QString type;
+		QString target; // path of the target inside of the archive
+	};
+
+	bool readPackage();
+	void readStyles();
+	void readSharedStrings();
+	std::unique_ptr<QIODevice> device(const QString& path) const;
+	QVector<Relationship> relationships(const QString& sourcePath) const;
+	void readCell(QXmlStreamReader&, Cell&);
+
+	const QString m_fileName;
+	std::unique_ptr<KZip> m_zip;
+	bool m_packageRead{false};
+	QString m_stylesPath;
+	QString m_sharedStringsPath;
+	QHash<QString, QString> m_sheetPaths; // sheet name -> path of the worksheet
+	QString m_sheetPath; // path of the opened worksheet
+	QVector<bool> m_dateStyles; // date format of the cell styles (cellXfs)
+	QStringList m_sharedStrings;
+	bool m_sharedStringsRead{false};
+	bool m_date1904{false};
+};
+
+#endif // XLSXREADER_H
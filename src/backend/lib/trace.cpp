@@ -0,0 +1,219 @@
+/*
+	File                 : trace.cpp
+	Project              : LabPlot
+	Description          : Function and macros related to performance and debugging tracing
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+
+#include <iomanip>
+
+std::atomic<bool> Trace::s_enabled{false};
+
+namespace {
+const int maxBufferedEvents = 65536; // the buffered events are written to the trace file when this number is reached
+struct Event {
+	QString name;
+	char phase; // 'X' - complete event (scope), 'C' - counter
+	int thread;
+	qint64 start; // ns
+	qint64 value; // duration in ns for scopes, value for counters
+};
+
+struct TraceData {
+	QMutex mutex;
+	QString fileName;
+	QFile file;
+	bool firstEvent{true}; // no event was written to the file yet
+	std::chrono::steady_clock::time_point start;
+	QVector<Event> events; // events not written to the file yet
+	QHash<QString, qint64> counters;
+	QHash<int, QString> threadNames;
+	std::atomic<int> threadCount{0};
+};
+
+TraceData& traceData() {
+	static TraceData data;
+	return data;
+}
+
+thread_local int threadDepth = 0;
+
+// small id of the current thread, the name of the thread is registered on first use
+int threadId() {
+	thread_local int id = 0;
+	if (id == 0) {
+		auto& data = traceData();
+		id = ++data.threadCount;
+
+		QString name;
+		auto* thread = QThread::currentThread();
+		if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+			name = QStringLiteral("main");
+		else if (thread && !thread->objectName().isEmpty())
+			name = thread->objectName();
+		else
+			name = QStringLiteral("thread %1").arg(id);
+
+		QMutexLocker locker(&data.mutex);
+		data.threadNames[id] = name;
+	}
+	return id;
+}
+
+QJsonObject toJson(const Event& event) {
+	QJsonObject object;
+	object[QLatin1String("name")] = event.name;
+	object[QLatin1String("ph")] = QString(QLatin1Char(event.phase));
+	object[QLatin1String("pid")] = static_cast<qint64>(QCoreApplication::applicationPid());
+	object[QLatin1String("tid")] = event.thread;
+	object[QLatin1String("ts")] = event.start / 1000.; // µs
+	if (event.phase == 'X')
+		object[QLatin1String("dur")] = event.value / 1000.;
+	else {
+		QJsonObject args;
+		args[event.name] = event.value;
+		object[QLatin1String("args")] = args;
+	}
+	return object;
+}
+
+void writeEvent(TraceData& data, const QJsonObject& object) {
+	if (!data.firstEvent)
+		data.file.write(",\n");
+	data.firstEvent = false;
+	data.file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+}
+
+// writes the buffered events to the trace file, the mutex has to be locked
+void flushEvents(TraceData& data) {
+	for (const auto& event : qAsConst(data.events))
+		writeEvent(data, toJson(event));
+	data.events.clear();
+}
+
+// buffers the event, the mutex has to be locked
+void addEvent(TraceData& data, const Event& event) {
+	if (!data.file.isOpen()) // the tracing was stopped in the meantime
+		return;
+
+	data.events << event;
+	if (data.events.size() >= maxBufferedEvents)
+		flushEvents(data);
+}
+} // namespace
+
+/*!
+ * starts the tracing. The recorded events are written to \c fileName, the scopes are printed to stdout
+ * if no file name is provided. The events are buffered and written to the file in blocks of limited size
+ * during the tracing, the remaining ones when the tracing is stopped.
+ */
+void Trace::start(const QString& fileName) {
+	auto& data = traceData();
+	{
+		QMutexLocker locker(&data.mutex);
+		data.fileName = fileName;
+		data.start = std::chrono::steady_clock::now();
+		data.events.clear();
+		data.counters.clear();
+
+		if (!fileName.isEmpty()) {
+			data.file.setFileName(fileName);
+			if (!data.file.open(QIODevice::WriteOnly)) {
+				WARN("Failed to write the trace to " << STDSTRING(fileName))
+				return;
+			}
+			data.file.write("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+			data.firstEvent = true;
+		}
+	}
+	s_enabled = true;
+}
+
+/*!
+ * stops the tracing and writes the remaining events to the file provided in \c start().
+ */
+void Trace::stop() {
+	if (!s_enabled)
+		return;
+	s_enabled = false;
+
+	auto& data = traceData();
+	QMutexLocker locker(&data.mutex);
+	if (data.fileName.isEmpty())
+		return;
+
+	flushEvents(data);
+	for (auto it = data.threadNames.constBegin(); it != data.threadNames.constEnd(); ++it) {
+		QJsonObject args;
+		args[QLatin1String("name")] = it.value();
+		QJsonObject object;
+		object[QLatin1String("name")] = QLatin1String("thread_name");
+		object[QLatin1String("ph")] = QLatin1String("M");
+		object[QLatin1String("pid")] = static_cast<qint64>(QCoreApplication::applicationPid());
+		object[QLatin1String("tid")] = it.key();
+		object[QLatin1String("args")] = args;
+		writeEvent(data, object);
+	}
+	data.file.write("\n]}\n");
+	data.file.close();
+	WARN("Trace written to " << STDSTRING(data.fileName))
+
+	data.events.squeeze();
+}
+
+qint64 Trace::now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceData().start).count();
+}
+
+void Trace::enter() {
+	++threadDepth;
+}
+
+/*!
+ * records the scope \c name that was entered at \c start.
+ */
+void Trace::leave(const QString& name, qint64 start) {
+	const qint64 duration = now() - start;
+	--threadDepth;
+	if (!s_enabled)
+		return;
+
+	auto& data = traceData();
+	const int thread = threadId();
+	QMutexLocker locker(&data.mutex);
+	if (data.fileName.isEmpty())
+		std::cout << std::string(2 * threadDepth, ' ') << '[' << thread << "] " << STDSTRING(name) << ": " << std::fixed << std::setprecision(3)
+				  << duration / 1.e6 << " ms" << std::defaultfloat << std::endl;
+	else
+		addEvent(data, Event{name, 'X', thread, start, duration});
+}
+
+/*!
+ * adds \c value to the counter \c name.
+ */
+void Trace::count(const char* name, qint64 value) {
+	const qint64 time = now();
+	auto& data = traceData();
+	const int thread = threadId();
+	const QString counterName = QLatin1String(name);
+	QMutexLocker locker(&data.mutex);
+	auto& total = data.counters[counterName];
+	total += value;
+	if (data.fileName.isEmpty())
+		std::cout << std::string(2 * threadDepth, ' ') << '[' << thread << "] " << name << ": " << total << std::endl;
+	else
+		addEvent(data, Event{counterName, 'C', thread, time, total});
+}
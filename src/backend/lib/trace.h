@@ -11,23 +11,55 @@
 #define TRACE_H
 
 #include "backend/lib/macros.h"
+
+#include <atomic>
 #include <chrono>
 
+/*!
+ * runtime switchable performance tracing.
+ * The tracing is disabled by default and is enabled with \c Trace::start(), e.g. via the command line option \c --trace.
+ * The scopes are recorded with the thread they were executed in and written in the Chrome trace event format
+ * (chrome://tracing, Perfetto) in blocks during the tracing. Without a file name the scopes are printed to stdout.
+ */
+class Trace {
+public:
+	static void start(const QString& fileName = QString());
+	static void stop();
+	static bool isEnabled() {
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	static qint64 now(); // ns since the start of the tracing
+	static void enter();
+	static void leave(const QString& name, qint64 start);
+	static void count(const char* name, qint64 value);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+/*!
+ * records the scope from the construction to the destruction of the tracer, nothing is done if the tracing is disabled.
+ */
 class PerfTracer {
 public:
-	explicit PerfTracer(QString m) {
-		msg = STDSTRING(m);
-		start = std::chrono::high_resolution_clock::now();
-	};
+	explicit PerfTracer(const QString& msg)
+		: m_active(Trace::isEnabled()) {
+		if (m_active) {
+			m_msg = msg;
+			Trace::enter();
+			m_start = Trace::now();
+		}
+	}
 	~PerfTracer() {
-		auto end = std::chrono::high_resolution_clock::now();
-		auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-		std::cout << msg << ": " << diff << " ms" << std::endl;
+		if (m_active)
+			Trace::leave(m_msg, m_start);
 	}
 
 private:
-	std::chrono::high_resolution_clock::time_point start;
-	std::string msg;
+	bool m_active;
+	qint64 m_start{0};
+	QString m_msg;
 };
 
 #define PERFTRACE_ENABLED 1
@@ -39,9 +71,17 @@ private:
 #define PERFTRACE_EXPRESSION_PARSER 1
 
 #ifdef PERFTRACE_ENABLED
-#define PERFTRACE(msg) PerfTracer tracer(msg)
+// the message is only created if the tracing is enabled
+#define PERFTRACE(msg) PerfTracer tracer(Trace::isEnabled() ? QString(msg) : QString())
+// adds value to the counter name, shown as a counter track in the trace
+#define PERFTRACE_COUNTER(name, value)                                                                                                                         \
+	do {                                                                                                                                                       \
+		if (Trace::isEnabled())                                                                                                                                \
+			Trace::count(name, value);                                                                                                                         \
+	} while (false)
 #else
-#define PERFTRACE(msg) DEBUG(msg)
+#define PERFTRACE(msg)
+#define PERFTRACE_COUNTER(name, value)
 #endif
 
 #ifndef HAVE_WINDOWS
@@ -34,8 +34,8 @@
 	a MxN matrix with M rows, N columns). This data is typically
 	used to for 3D plots.
 
-	The values of the matrix are stored as generic values. Each column
-	of the matrix is stored in a QVector<T> objects.
+	The values of the matrix are stored as generic values in one contiguous
+	buffer (see MatrixBuffer), column by column or row by row.
 
 	\ingroup backend
 */
@@ -135,7 +135,11 @@ bool Matrix::exportView() const {
 		} else if (dlg->format() == ExportSpreadsheetDialog::Format::FITS) {
 			const int exportTo = dlg->exportToFits();
 			m_view->exportToFits(path, exportTo);
-		} else {
+		} else if (dlg->format() == ExportSpreadsheetDialog::Format::Binary)
+			m_view->exportToBinary(path, dlg->binaryDataType(), dlg->binaryByteOrder());
+		else if (dlg->format() == ExportSpreadsheetDialog::Format::HDF5)
+			m_view->exportToHDF5(path, dlg->compressionLevel());
+		else {
 			const QString separator = dlg->separator();
 			const QLocale::Language format = dlg->numberFormat();
 			m_view->exportToFile(path, separator, format);
@@ -169,6 +173,9 @@ bool Matrix::printPreview() const {
 // ##############################################################################
 // ##########################  getter methods  ##################################
 // ##############################################################################
+/*!
+ * returns the pointer to the MatrixBuffer with the values of the type given by mode()
+ */
 void* Matrix::data() const {
 	Q_D(const Matrix);
 	return d->data;
@@ -669,25 +676,25 @@ void Matrix::setData(void* data) {
 	Q_D(Matrix);
 	switch (d->mode) {
 	case AbstractColumn::ColumnMode::Double:
-		if (static_cast<QVector<QVector<double>>*>(data)->isEmpty())
+		if (static_cast<MatrixBuffer<double>*>(data)->columnCount() == 0)
 			isEmpty = true;
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		if (static_cast<QVector<QVector<QString>>*>(data)->isEmpty())
+		if (static_cast<MatrixBuffer<QString>*>(data)->columnCount() == 0)
 			isEmpty = true;
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		if (static_cast<QVector<QVector<int>>*>(data)->isEmpty())
+		if (static_cast<MatrixBuffer<int>*>(data)->columnCount() == 0)
 			isEmpty = true;
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		if (static_cast<QVector<QVector<qint64>>*>(data)->isEmpty())
+		if (static_cast<MatrixBuffer<qint64>*>(data)->columnCount() == 0)
 			isEmpty = true;
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		if (static_cast<QVector<QVector<QDateTime>>*>(data)->isEmpty())
+		if (static_cast<MatrixBuffer<QDateTime>*>(data)->columnCount() == 0)
 			isEmpty = true;
 		break;
 	}
@@ -736,25 +743,7 @@ void Matrix::clear() {
 void Matrix::transpose() {
 	WAIT_CURSOR;
 	Q_D(Matrix);
-	switch (d->mode) {
-	case AbstractColumn::ColumnMode::Double:
-		exec(new MatrixTransposeCmd<double>(d));
-		break;
-	case AbstractColumn::ColumnMode::Text:
-		exec(new MatrixTransposeCmd<QString>(d));
-		break;
-	case AbstractColumn::ColumnMode::Integer:
-		exec(new MatrixTransposeCmd<int>(d));
-		break;
-	case AbstractColumn::ColumnMode::BigInt:
-		exec(new MatrixTransposeCmd<qint64>(d));
-		break;
-	case AbstractColumn::ColumnMode::Day:
-	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::DateTime:
-		exec(new MatrixTransposeCmd<QDateTime>(d));
-		break;
-	}
+	exec(new MatrixTransposeCmd(d));
 	RESET_CURSOR;
 }
 
@@ -812,6 +801,59 @@ void Matrix::mirrorVertically() {
 // ######################  Private implementation ###############################
 // ##############################################################################
 
+// deletes the buffer \c data with values of the type given by \c mode
+static void deleteBuffer(void* data, AbstractColumn::ColumnMode mode) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		delete static_cast<MatrixBuffer<double>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		delete static_cast<MatrixBuffer<QString>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		delete static_cast<MatrixBuffer<int>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		delete static_cast<MatrixBuffer<qint64>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		delete static_cast<MatrixBuffer<QDateTime>*>(data);
+		break;
+	}
+}
+
+// returns a new buffer with the numeric values of \c data converted to the type T
+template<typename S, typename T>
+static void* convertedBuffer(const void* data) {
+	const auto* buffer = static_cast<const MatrixBuffer<S>*>(data);
+	auto* result = new MatrixBuffer<T>(buffer->rowCount(), buffer->columnCount());
+	for (int col = 0; col < buffer->columnCount(); ++col)
+		for (int row = 0; row < buffer->rowCount(); ++row)
+			result->ref(row, col) = static_cast<T>(buffer->at(row, col));
+	return result;
+}
+
+template<typename T>
+static void* convertedBuffer(const void* data, AbstractColumn::ColumnMode mode, int rows, int cols) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		return convertedBuffer<double, T>(data);
+	case AbstractColumn::ColumnMode::Integer:
+		return convertedBuffer<int, T>(data);
+	case AbstractColumn::ColumnMode::BigInt:
+		return convertedBuffer<qint64, T>(data);
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		break;
+	}
+
+	return new MatrixBuffer<T>(rows, cols);
+}
+
 MatrixPrivate::MatrixPrivate(Matrix* owner, const AbstractColumn::ColumnMode m)
 	: q(owner)
 	, data(nullptr)
@@ -821,47 +863,67 @@ MatrixPrivate::MatrixPrivate(Matrix* owner, const AbstractColumn::ColumnMode m)
 	, suppressDataChange(false) {
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		data = new QVector<QVector<double>>();
+		data = new MatrixBuffer<double>();
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		data = new QVector<QVector<QString>>();
+		data = new MatrixBuffer<QString>();
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		data = new QVector<QVector<int>>();
+		data = new MatrixBuffer<int>();
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		data = new QVector<QVector<qint64>>();
+		data = new MatrixBuffer<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::DateTime:
-		data = new QVector<QVector<QDateTime>>();
+		data = new MatrixBuffer<QDateTime>();
 		break;
 	}
 }
 
 MatrixPrivate::~MatrixPrivate() {
-	if (data) {
-		switch (mode) {
-		case AbstractColumn::ColumnMode::Double:
-			delete static_cast<QVector<QVector<double>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Text:
-			delete static_cast<QVector<QVector<QString>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			delete static_cast<QVector<QVector<int>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			delete static_cast<QVector<QVector<qint64>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::DateTime:
-			delete static_cast<QVector<QVector<QDateTime>>*>(data);
-			break;
-		}
+	if (data)
+		deleteBuffer(data, mode);
+}
+
+/*!
+	Changes the data type of the values to \c newMode. Numeric values are converted,
+	all other values can't be converted and are reset.
+*/
+void MatrixPrivate::setMode(AbstractColumn::ColumnMode newMode) {
+	const auto isDateTime = [](AbstractColumn::ColumnMode m) {
+		return m == AbstractColumn::ColumnMode::Day || m == AbstractColumn::ColumnMode::Month || m == AbstractColumn::ColumnMode::DateTime;
+	};
+	if (newMode == mode || (isDateTime(newMode) && isDateTime(mode))) {
+		mode = newMode;
+		return;
 	}
+
+	void* newData = nullptr;
+	switch (newMode) {
+	case AbstractColumn::ColumnMode::Double:
+		newData = convertedBuffer<double>(data, mode, rowCount, columnCount);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		newData = convertedBuffer<int>(data, mode, rowCount, columnCount);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		newData = convertedBuffer<qint64>(data, mode, rowCount, columnCount);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		newData = new MatrixBuffer<QString>(rowCount, columnCount);
+		break;
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		newData = new MatrixBuffer<QDateTime>(rowCount, columnCount);
+		break;
+	}
+
+	deleteBuffer(data, mode);
+	data = newData;
+	mode = newMode;
 }
 
 void MatrixPrivate::updateViewHeader() {
@@ -878,39 +940,25 @@ void MatrixPrivate::insertColumns(int before, int count) {
 	Q_EMIT q->columnsAboutToBeInserted(before, count);
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<double>>*>(data)->insert(before + i, QVector<double>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		buffer<double>()->insertColumns(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<QString>>*>(data)->insert(before + i, QVector<QString>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		buffer<QString>()->insertColumns(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<int>>*>(data)->insert(before + i, QVector<int>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		buffer<int>()->insertColumns(before, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<qint64>>*>(data)->insert(before + i, QVector<qint64>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		buffer<qint64>()->insertColumns(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<QDateTime>>*>(data)->insert(before + i, QVector<QDateTime>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		buffer<QDateTime>()->insertColumns(before, count);
 		break;
 	}
 
+	columnWidths.insert(before, count, 0);
 	columnCount += count;
 	Q_EMIT q->columnsInserted(before, count);
 }
@@ -925,26 +973,25 @@ void MatrixPrivate::removeColumns(int first, int count) {
 
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		(static_cast<QVector<QVector<double>>*>(data))->remove(first, count);
+		buffer<double>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		(static_cast<QVector<QVector<QString>>*>(data))->remove(first, count);
+		buffer<QString>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		(static_cast<QVector<QVector<int>>*>(data))->remove(first, count);
+		buffer<int>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		(static_cast<QVector<QVector<qint64>>*>(data))->remove(first, count);
+		buffer<qint64>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		(static_cast<QVector<QVector<QDateTime>>*>(data))->remove(first, count);
+		buffer<QDateTime>()->removeColumns(first, count);
 		break;
 	}
 
-	for (int i = 0; i < count; i++)
-		columnWidths.remove(first);
+	columnWidths.remove(first, count);
 	columnCount -= count;
 	Q_EMIT q->columnsRemoved(first, count);
 }
@@ -959,35 +1006,25 @@ void MatrixPrivate::insertRows(int before, int count) {
 
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<double>>*>(data))->operator[](col).insert(before + i, 0.0);
+		buffer<double>()->insertRows(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<QString>>*>(data))->operator[](col).insert(before + i, QString());
+		buffer<QString>()->insertRows(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<int>>*>(data))->operator[](col).insert(before + i, 0);
+		buffer<int>()->insertRows(before, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<qint64>>*>(data))->operator[](col).insert(before + i, 0);
+		buffer<qint64>()->insertRows(before, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<QDateTime>>*>(data))->operator[](col).insert(before + i, QDateTime());
+		buffer<QDateTime>()->insertRows(before, count);
+		break;
 	}
 
-	for (int i = 0; i < count; i++)
-		rowHeights.insert(before + i, 0);
+	rowHeights.insert(before, count, 0);
 
 	rowCount += count;
 	Q_EMIT q->rowsInserted(before, count);
@@ -1003,31 +1040,25 @@ void MatrixPrivate::removeRows(int first, int count) {
 
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<double>>*>(data))->operator[](col).remove(first, count);
+		buffer<double>()->removeRows(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<QString>>*>(data))->operator[](col).remove(first, count);
+		buffer<QString>()->removeRows(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<int>>*>(data))->operator[](col).remove(first, count);
+		buffer<int>()->removeRows(first, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<qint64>>*>(data))->operator[](col).remove(first, count);
+		buffer<qint64>()->removeRows(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<QDateTime>>*>(data))->operator[](col).remove(first, count);
+		buffer<QDateTime>()->removeRows(first, count);
 		break;
 	}
 
-	for (int i = 0; i < count; i++)
-		rowHeights.remove(first);
+	rowHeights.remove(first, count);
 
 	rowCount -= count;
 	Q_EMIT q->rowsRemoved(first, count);
@@ -1037,21 +1068,21 @@ void MatrixPrivate::removeRows(int first, int count) {
 void MatrixPrivate::clearColumn(int col) {
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		static_cast<QVector<QVector<double>>*>(data)->operator[](col).fill(0.0);
+		buffer<double>()->fillColumn(col, 0.0);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		static_cast<QVector<QVector<QString>>*>(data)->operator[](col).fill(QString());
+		buffer<QString>()->fillColumn(col, QString());
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		static_cast<QVector<QVector<int>>*>(data)->operator[](col).fill(0);
+		buffer<int>()->fillColumn(col, 0);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		static_cast<QVector<QVector<qint64>>*>(data)->operator[](col).fill(0);
+		buffer<qint64>()->fillColumn(col, 0);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		static_cast<QVector<QVector<QDateTime>>*>(data)->operator[](col).fill(QDateTime());
+		buffer<QDateTime>()->fillColumn(col, QDateTime());
 		break;
 	}
 
@@ -1059,6 +1090,59 @@ void MatrixPrivate::clearColumn(int col) {
 		Q_EMIT q->dataChanged(0, col, rowCount - 1, col);
 }
 
+/*!
+	Transpose the matrix. Only the dimensions and the layout of the buffer are swapped, no value is moved.
+	The dimensions are adjusted in two steps so that the buffer and the dimensions are consistent after each signal.
+*/
+void MatrixPrivate::transpose() {
+	const int rows = rowCount;
+	const int cols = columnCount;
+
+	if (cols < rows) {
+		Q_EMIT q->rowsAboutToBeRemoved(cols, rows - cols);
+		rowHeights.remove(cols, rows - cols);
+		rowCount = cols;
+		Q_EMIT q->rowsRemoved(cols, rows - cols);
+	} else if (cols > rows) {
+		Q_EMIT q->columnsAboutToBeRemoved(rows, cols - rows);
+		columnWidths.remove(rows, cols - rows);
+		columnCount = rows;
+		Q_EMIT q->columnsRemoved(rows, cols - rows);
+	}
+
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		buffer<double>()->transpose();
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		buffer<QString>()->transpose();
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		buffer<int>()->transpose();
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		buffer<qint64>()->transpose();
+		break;
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		buffer<QDateTime>()->transpose();
+		break;
+	}
+
+	if (cols < rows) {
+		Q_EMIT q->columnsAboutToBeInserted(cols, rows - cols);
+		columnWidths.insert(cols, rows - cols, 0);
+		columnCount = rows;
+		Q_EMIT q->columnsInserted(cols, rows - cols);
+	} else if (cols > rows) {
+		Q_EMIT q->rowsAboutToBeInserted(rows, cols - rows);
+		rowHeights.insert(rows, cols - rows, 0);
+		rowCount = cols;
+		Q_EMIT q->rowsInserted(rows, cols - rows);
+	}
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
@@ -1112,7 +1196,8 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Double:
 		size = d->rowCount * sizeof(double);
 		for (int i = 0; i < d->columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<double>>*>(d->data)->at(i).constData());
+			const auto column = d->columnCells<double>(i, 0, d->rowCount - 1);
+			data = reinterpret_cast<const char*>(column.constData());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1121,8 +1206,9 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Text:
 		size = d->rowCount * sizeof(QString);
 		for (int i = 0; i < d->columnCount; ++i) {
-			QDEBUG("	string: " << static_cast<QVector<QVector<QString>>*>(d->data)->at(i));
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<QString>>*>(d->data)->at(i).constData());
+			const auto column = d->columnCells<QString>(i, 0, d->rowCount - 1);
+			QDEBUG("	string: " << column);
+			data = reinterpret_cast<const char*>(column.constData());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1131,7 +1217,8 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Integer:
 		size = d->rowCount * sizeof(int);
 		for (int i = 0; i < d->columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<int>>*>(d->data)->at(i).constData());
+			const auto column = d->columnCells<int>(i, 0, d->rowCount - 1);
+			data = reinterpret_cast<const char*>(column.constData());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1140,7 +1227,8 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::BigInt:
 		size = d->rowCount * sizeof(qint64);
 		for (int i = 0; i < d->columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<qint64>>*>(d->data)->at(i).constData());
+			const auto column = d->columnCells<qint64>(i, 0, d->rowCount - 1);
+			data = reinterpret_cast<const char*>(column.constData());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1151,7 +1239,8 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::DateTime:
 		size = d->rowCount * sizeof(QDateTime);
 		for (int i = 0; i < d->columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<QDateTime>>*>(d->data)->at(i).constData());
+			const auto column = d->columnCells<QDateTime>(i, 0, d->rowCount - 1);
+			data = reinterpret_cast<const char*>(column.constData());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1162,6 +1251,14 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	writer->writeEndElement(); // "matrix"
 }
 
+// stores the values \c column read from the project file in the column \c col
+template<typename T>
+static void setLoadedColumn(MatrixPrivate* d, int col, const QVector<T>& column) {
+	auto* buffer = d->buffer<T>();
+	buffer->resize(d->rowCount, std::max(buffer->columnCount(), col + 1));
+	buffer->setColumn(col, 0, column, std::min(static_cast<int>(column.size()), d->rowCount));
+}
+
 bool Matrix::load(XmlStreamReader* reader, bool preview) {
 	DEBUG(Q_FUNC_INFO)
 	if (!readBasicAttributes(reader))
@@ -1170,6 +1267,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 	Q_D(Matrix);
 	QXmlStreamAttributes attribs;
 	QString str;
+	int loadedColumns = 0;
 
 	// read child elements
 	while (!reader->atEnd()) {
@@ -1193,7 +1291,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 			if (str.isEmpty())
 				reader->raiseMissingAttributeWarning(QStringLiteral("mode"));
 			else
-				d->mode = AbstractColumn::ColumnMode(str.toInt());
+				d->setMode(AbstractColumn::ColumnMode(str.toInt()));
 
 			str = attribs.value(QStringLiteral("headerFormat")).toString();
 			if (str.isEmpty())
@@ -1279,7 +1377,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<double> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(double));
-				static_cast<QVector<QVector<double>>*>(d->data)->append(column);
+				setLoadedColumn(d, loadedColumns, column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Text: {
@@ -1288,7 +1386,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				column.resize(count);
 				// TODO: warning (GCC8): writing to an object of type 'class QString' with no trivial copy-assignment; use copy-assignment or
 				// copy-initialization instead memcpy(column.data(), bytes.data(), count*sizeof(QString)); QDEBUG("	string: " << column.data());
-				static_cast<QVector<QVector<QString>>*>(d->data)->append(column);
+				setLoadedColumn(d, loadedColumns, column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Integer: {
@@ -1296,7 +1394,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<int> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(int));
-				static_cast<QVector<QVector<int>>*>(d->data)->append(column);
+				setLoadedColumn(d, loadedColumns, column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::BigInt: {
@@ -1304,7 +1402,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<qint64> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(qint64));
-				static_cast<QVector<QVector<qint64>>*>(d->data)->append(column);
+				setLoadedColumn(d, loadedColumns, column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Day:
@@ -1315,10 +1413,11 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				column.resize(count);
 				// TODO: warning (GCC8): writing to an object of type 'class QDateTime' with no trivial copy-assignment; use copy-assignment or
 				// copy-initialization instead memcpy(column.data(), bytes.data(), count*sizeof(QDateTime));
-				static_cast<QVector<QVector<QDateTime>>*>(d->data)->append(column);
+				setLoadedColumn(d, loadedColumns, column);
 				break;
 			}
 			}
+			++loadedColumns;
 		} else { // unknown element
 			reader->raiseUnknownElementWarning();
 			if (!reader->skipToEndElement())
@@ -1332,6 +1431,31 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 // ##############################################################################
 // ########################  Data Import  #######################################
 // ##############################################################################
+// hands out copies of the first dataContainer.size() columns to the import filters, see finalizeImport()
+template<typename T>
+static void prepareImportColumns(MatrixPrivate* d, std::vector<void*>& dataContainer) {
+	auto* columns = new QVector<QVector<T>>(static_cast<int>(dataContainer.size()));
+	for (int n = 0; n < columns->size(); ++n) {
+		auto& column = (*columns)[n];
+		column = d->buffer<T>()->column(n, 0, d->rowCount - 1);
+		dataContainer[n] = static_cast<void*>(&column);
+	}
+	d->importData = columns;
+}
+
+// copies the imported columns into the buffer
+template<typename T>
+static void finalizeImportColumns(MatrixPrivate* d) {
+	const auto* columns = static_cast<QVector<QVector<T>>*>(d->importData);
+	auto* buffer = d->buffer<T>();
+	for (int n = 0; n < std::min(static_cast<int>(columns->size()), d->columnCount); ++n) {
+		const auto& column = columns->at(n);
+		buffer->setColumn(n, 0, column, std::min(static_cast<int>(column.size()), d->rowCount));
+	}
+	delete columns;
+	d->importData = nullptr;
+}
+
 int Matrix::prepareImport(std::vector<void*>& dataContainer,
 						  AbstractFileFilter::ImportMode mode,
 						  int actualRows,
@@ -1364,7 +1488,7 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer,
 		// catch some cases
 		if ((d->mode == AbstractColumn::ColumnMode::Integer || d->mode == AbstractColumn::ColumnMode::BigInt)
 			&& newColumnMode == AbstractColumn::ColumnMode::Double)
-			d->mode = newColumnMode;
+			d->setMode(newColumnMode);
 
 		columnOffset = columnCount();
 		actualCols += columnOffset;
@@ -1376,52 +1500,32 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer,
 	}
 
 	DEBUG(Q_FUNC_INFO << ", actual rows/cols = " << actualRows << "/" << actualCols)
-	// data() returns a void* which is a pointer to a matrix of any data type (see ColumnPrivate.cpp)
+	// the filters write into separate column vectors, their values are copied into the buffer in finalizeImport()
 	if (initializeDataContainer) {
 		dataContainer.resize(actualCols);
 
 		switch (newColumnMode) { // prepare all columns
 		case AbstractColumn::ColumnMode::Double:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<double>* vector = &(static_cast<QVector<QVector<double>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Double;
+			d->setMode(AbstractColumn::ColumnMode::Double);
+			prepareImportColumns<double>(d, dataContainer);
 			break;
 		case AbstractColumn::ColumnMode::Integer:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<int>* vector = &(static_cast<QVector<QVector<int>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Integer;
+			d->setMode(AbstractColumn::ColumnMode::Integer);
+			prepareImportColumns<int>(d, dataContainer);
 			break;
 		case AbstractColumn::ColumnMode::BigInt:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<qint64>* vector = &(static_cast<QVector<QVector<qint64>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::BigInt;
+			d->setMode(AbstractColumn::ColumnMode::BigInt);
+			prepareImportColumns<qint64>(d, dataContainer);
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<QString>* vector = &(static_cast<QVector<QVector<QString>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Text;
+			d->setMode(AbstractColumn::ColumnMode::Text);
+			prepareImportColumns<QString>(d, dataContainer);
 			break;
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::DateTime:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<QDateTime>* vector = &(static_cast<QVector<QVector<QDateTime>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::DateTime;
+			d->setMode(AbstractColumn::ColumnMode::DateTime);
+			prepareImportColumns<QDateTime>(d, dataContainer);
 			break;
 		}
 	}
@@ -1435,6 +1539,28 @@ void Matrix::finalizeImport(size_t /*columnOffset*/,
 							const QString& /*dateTimeFormat*/,
 							AbstractFileFilter::ImportMode) {
 	DEBUG(Q_FUNC_INFO)
+	Q_D(Matrix);
+	if (d->importData) {
+		switch (d->mode) {
+		case AbstractColumn::ColumnMode::Double:
+			finalizeImportColumns<double>(d);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			finalizeImportColumns<int>(d);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			finalizeImportColumns<qint64>(d);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			finalizeImportColumns<QString>(d);
+			break;
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::DateTime:
+			finalizeImportColumns<QDateTime>(d);
+			break;
+		}
+	}
 
 	setSuppressDataChangedSignal(false);
 	setChanged();
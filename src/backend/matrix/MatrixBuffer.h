@@ -0,0 +1,294 @@
+/*
+	File                 : MatrixBuffer.h
+	Project              : LabPlot
+	Description          : Contiguous storage of the values of a Matrix
+	--------------------------------------------------------------------
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MATRIXBUFFER_H
+#define MATRIXBUFFER_H
+
+#include <QVector>
+
+#include <algorithm>
+
+/*!
+	\class MatrixBuffer
+	\brief Stores all cells of a matrix with values of type \c T in one contiguous buffer.
+
+	The cells are stored either column by column (\c ColumnMajor, the default) or row by row (\c RowMajor).
+	In the column major layout the first cell of column \c col is at the index <tt>col * stride()</tt>
+	and the cells of a column are contiguous, in the row major layout the same holds for the rows.
+	The stride can be larger than the number of cells in a column (row) so that appending rows (columns)
+	only moves the values when the spare capacity is used up. The capacity grows geometrically.
+
+	Transposing only swaps the dimensions and the layout and doesn't move any value.
+
+	\ingroup backend
+*/
+template<typename T>
+class MatrixBuffer {
+public:
+	enum class Layout { ColumnMajor, RowMajor };
+
+	MatrixBuffer() = default;
+	MatrixBuffer(int rows, int columns) {
+		resize(rows, columns);
+	}
+
+	int rowCount() const {
+		return m_rows;
+	}
+	int columnCount() const {
+		return m_columns;
+	}
+	int stride() const {
+		return m_stride;
+	}
+	Layout layout() const {
+		return m_layout;
+	}
+	//! the whole buffer, see index() for the position of a cell
+	const QVector<T>& values() const {
+		return m_values;
+	}
+
+	int index(int row, int col) const {
+		return (m_layout == Layout::ColumnMajor) ? col * m_stride + row : row * m_stride + col;
+	}
+	const T& at(int row, int col) const {
+		return m_values.at(index(row, col));
+	}
+	T& ref(int row, int col) {
+		return m_values[index(row, col)];
+	}
+
+	//! pointer to the contiguous values of column \c col, only available in the column major layout
+	const T* columnData(int col) const {
+		Q_ASSERT(m_layout == Layout::ColumnMajor);
+		return m_values.constData() + col * m_stride;
+	}
+
+	//! stores the values in the layout \c layout, the values are only moved if the layout changes
+	void setLayout(Layout layout) {
+		if (layout == m_layout)
+			return;
+
+		// the inner dimension of the new layout is the outer dimension of the current one
+		const int inner = outerCount();
+		const int outer = innerCount();
+		QVector<T> values(outer * inner);
+		for (int o = 0; o < outer; ++o)
+			for (int i = 0; i < inner; ++i)
+				values[o * inner + i] = m_values.at(i * m_stride + o);
+		m_values = std::move(values);
+		m_stride = inner;
+		m_layout = layout;
+	}
+
+	void transpose() {
+		std::swap(m_rows, m_columns);
+		m_layout = (m_layout == Layout::ColumnMajor) ? Layout::RowMajor : Layout::ColumnMajor;
+	}
+
+	void resize(int rows, int columns) {
+		if (columns > m_columns)
+			insertColumns(m_columns, columns - m_columns);
+		else if (columns < m_columns)
+			removeColumns(columns, m_columns - columns);
+
+		if (rows > m_rows)
+			insertRows(m_rows, rows - m_rows);
+		else if (rows < m_rows)
+			removeRows(rows, m_rows - rows);
+	}
+
+	void insertRows(int before, int count) {
+		if (m_layout == Layout::ColumnMajor)
+			insertInner(before, count);
+		else
+			insertOuter(before, count);
+	}
+	void removeRows(int first, int count) {
+		if (m_layout == Layout::ColumnMajor)
+			removeInner(first, count);
+		else
+			removeOuter(first, count);
+	}
+	void insertColumns(int before, int count) {
+		if (m_layout == Layout::ColumnMajor)
+			insertOuter(before, count);
+		else
+			insertInner(before, count);
+	}
+	void removeColumns(int first, int count) {
+		if (m_layout == Layout::ColumnMajor)
+			removeOuter(first, count);
+		else
+			removeInner(first, count);
+	}
+
+	QVector<T> column(int col, int firstRow, int lastRow) const {
+		if (m_layout == Layout::ColumnMajor)
+			return m_values.mid(index(firstRow, col), lastRow - firstRow + 1);
+
+		QVector<T> result;
+		result.reserve(lastRow - firstRow + 1);
+		for (int row = firstRow; row <= lastRow; ++row)
+			result << at(row, col);
+		return result;
+	}
+	//! sets the first \c count values of \c values in column \c col starting at row \c firstRow
+	void setColumn(int col, int firstRow, const QVector<T>& values, int count) {
+		if (m_layout == Layout::ColumnMajor) {
+			std::copy(values.cbegin(), values.cbegin() + count, m_values.begin() + index(firstRow, col));
+			return;
+		}
+
+		for (int i = 0; i < count; ++i)
+			ref(firstRow + i, col) = values.at(i);
+	}
+
+	QVector<T> row(int row, int firstColumn, int lastColumn) const {
+		if (m_layout == Layout::RowMajor)
+			return m_values.mid(index(row, firstColumn), lastColumn - firstColumn + 1);
+
+		QVector<T> result;
+		result.reserve(lastColumn - firstColumn + 1);
+		for (int col = firstColumn; col <= lastColumn; ++col)
+			result << at(row, col);
+		return result;
+	}
+	//! sets the first \c count values of \c values in row \c row starting at column \c firstColumn
+	void setRow(int row, int firstColumn, const QVector<T>& values, int count) {
+		if (m_layout == Layout::RowMajor) {
+			std::copy(values.cbegin(), values.cbegin() + count, m_values.begin() + index(row, firstColumn));
+			return;
+		}
+
+		for (int i = 0; i < count; ++i)
+			ref(row, firstColumn + i) = values.at(i);
+	}
+
+	void fill(const T& value) {
+		for (int o = 0; o < outerCount(); ++o) {
+			auto first = m_values.begin() + o * m_stride;
+			std::fill(first, first + innerCount(), value);
+		}
+	}
+	void fillColumn(int col, const T& value) {
+		for (int row = 0; row < m_rows; ++row)
+			ref(row, col) = value;
+	}
+
+	//! reverses the order of the columns
+	void mirrorHorizontally() {
+		if (m_layout == Layout::ColumnMajor)
+			reverseOuter();
+		else
+			reverseInner();
+	}
+	//! reverses the order of the rows
+	void mirrorVertically() {
+		if (m_layout == Layout::ColumnMajor)
+			reverseInner();
+		else
+			reverseOuter();
+	}
+
+private:
+	// the inner dimension is contiguous in the buffer, the outer one is strided
+	int innerCount() const {
+		return (m_layout == Layout::ColumnMajor) ? m_rows : m_columns;
+	}
+	int outerCount() const {
+		return (m_layout == Layout::ColumnMajor) ? m_columns : m_rows;
+	}
+	void setInnerCount(int count) {
+		if (m_layout == Layout::ColumnMajor)
+			m_rows = count;
+		else
+			m_columns = count;
+	}
+	void setOuterCount(int count) {
+		if (m_layout == Layout::ColumnMajor)
+			m_columns = count;
+		else
+			m_rows = count;
+	}
+
+	// copies the values into a new buffer with the stride \c stride, leaving \c gap default values before the inner index \c before
+	void restride(int stride, int before, int gap) {
+		const int inner = innerCount();
+		const int outer = outerCount();
+		QVector<T> values(outer * stride);
+		for (int o = 0; o < outer; ++o) {
+			const auto source = m_values.cbegin() + o * m_stride;
+			auto target = values.begin() + o * stride;
+			std::copy(source, source + before, target);
+			std::copy(source + before, source + inner, target + before + gap);
+		}
+		m_values = std::move(values);
+		m_stride = stride;
+	}
+
+	void insertInner(int before, int count) {
+		const int inner = innerCount();
+		if (inner + count > m_stride) // no spare capacity left, grow by at least 50 percent
+			restride(std::max(inner + count, m_stride + m_stride / 2), before, count);
+		else {
+			for (int o = 0; o < outerCount(); ++o) {
+				auto first = m_values.begin() + o * m_stride;
+				std::move_backward(first + before, first + inner, first + inner + count);
+				std::fill(first + before, first + before + count, T());
+			}
+		}
+		setInnerCount(inner + count);
+	}
+	void removeInner(int first, int count) {
+		const int inner = innerCount() - count;
+		for (int o = 0; o < outerCount(); ++o) {
+			auto begin = m_values.begin() + o * m_stride;
+			std::move(begin + first + count, begin + inner + count, begin + first);
+			std::fill(begin + inner, begin + inner + count, T());
+		}
+		setInnerCount(inner);
+
+		// release the memory if most of the buffer is unused
+		if (inner < m_stride / 4)
+			restride(inner, inner, 0);
+	}
+	void insertOuter(int before, int count) {
+		m_values.insert(before * m_stride, count * m_stride, T());
+		setOuterCount(outerCount() + count);
+	}
+	void removeOuter(int first, int count) {
+		m_values.remove(first * m_stride, count * m_stride);
+		setOuterCount(outerCount() - count);
+	}
+
+	void reverseOuter() {
+		const int inner = innerCount();
+		const int outer = outerCount();
+		for (int o = 0; o < outer / 2; ++o) {
+			auto first = m_values.begin() + o * m_stride;
+			std::swap_ranges(first, first + inner, m_values.begin() + (outer - o - 1) * m_stride);
+		}
+	}
+	void reverseInner() {
+		const int inner = innerCount();
+		for (int o = 0; o < outerCount(); ++o) {
+			auto first = m_values.begin() + o * m_stride;
+			std::reverse(first, first + inner);
+		}
+	}
+
+	QVector<T> m_values;
+	int m_rows{0};
+	int m_columns{0};
+	int m_stride{0}; //!< distance between the first cells of two columns (rows) in the column (row) major layout
+	Layout m_layout{Layout::ColumnMajor};
+};
+
+#endif
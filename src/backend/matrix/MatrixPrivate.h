@@ -12,6 +12,8 @@
 #ifndef MATRIXPRIVATE_H
 #define MATRIXPRIVATE_H
 
+#include "MatrixBuffer.h"
+
 class MatrixPrivate {
 public:
 	explicit MatrixPrivate(Matrix*, AbstractColumn::ColumnMode);
@@ -26,13 +28,19 @@ public:
 		return q->name();
 	}
 
+	// storage of the values (must be defined in header)
+	template<typename T>
+	MatrixBuffer<T>* buffer() const {
+		return static_cast<MatrixBuffer<T>*>(data);
+	}
+
 	// get value of cell at row/col (must be defined in header)
 	template<typename T>
 	T cell(int row, int col) const {
 		Q_ASSERT(row >= 0 && row < rowCount);
 		Q_ASSERT(col >= 0 && col < columnCount);
 
-		return (static_cast<QVector<QVector<T>>*>(data))->at(col).at(row);
+		return buffer<T>()->at(row, col);
 	}
 
 	// Set value of cell at row/col (must be defined in header)
@@ -41,7 +49,7 @@ public:
 		Q_ASSERT(row >= 0 && row < rowCount);
 		Q_ASSERT(col >= 0 && col < columnCount);
 
-		static_cast<QVector<QVector<T>>*>(data)->operator[](col)[row] = value;
+		buffer<T>()->ref(row, col) = value;
 
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(row, col, row, col);
@@ -52,13 +60,7 @@ public:
 		Q_ASSERT(first_row >= 0 && first_row < rowCount);
 		Q_ASSERT(last_row >= 0 && last_row < rowCount);
 
-		if (first_row == 0 && last_row == rowCount - 1)
-			return (static_cast<QVector<QVector<T>>*>(data))->at(col);
-
-		QVector<T> result;
-		for (int i = first_row; i <= last_row; i++)
-			result.append(static_cast<QVector<QVector<T>>*>(data)->at(col).at(i));
-		return result;
+		return buffer<T>()->column(col, first_row, last_row);
 	}
 	// set column cells (must be defined in header)
 	template<typename T>
@@ -67,16 +69,7 @@ public:
 		Q_ASSERT(last_row >= 0 && last_row < rowCount);
 		Q_ASSERT(values.count() > last_row - first_row);
 
-		if (first_row == 0 && last_row == rowCount - 1) {
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col) = values;
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col).resize(rowCount); // values may be larger
-			if (!suppressDataChange)
-				Q_EMIT q->dataChanged(first_row, col, last_row, col);
-			return;
-		}
-
-		for (int i = first_row; i <= last_row; i++)
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col)[i] = values.at(i - first_row);
+		buffer<T>()->setColumn(col, first_row, values, last_row - first_row + 1);
 
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(first_row, col, last_row, col);
@@ -87,10 +80,7 @@ public:
 		Q_ASSERT(first_column >= 0 && first_column < columnCount);
 		Q_ASSERT(last_column >= 0 && last_column < columnCount);
 
-		QVector<T> result;
-		for (int i = first_column; i <= last_column; i++)
-			result.append(static_cast<QVector<QVector<T>>*>(data)->operator[](i)[row]);
-		return result;
+		return buffer<T>()->row(row, first_column, last_column);
 	}
 	// set row cells (must be defined in header)
 	template<typename T>
@@ -99,13 +89,14 @@ public:
 		Q_ASSERT(last_column >= 0 && last_column < columnCount);
 		Q_ASSERT(values.count() > last_column - first_column);
 
-		for (int i = first_column; i <= last_column; i++)
-			static_cast<QVector<QVector<T>>*>(data)->operator[](i)[row] = values.at(i - first_column);
+		buffer<T>()->setRow(row, first_column, values, last_column - first_column + 1);
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(row, first_column, row, last_column);
 	}
 
 	void clearColumn(int col);
+	void transpose();
+	void setMode(AbstractColumn::ColumnMode);
 
 	void setRowHeight(int row, int height) {
 		rowHeights[row] = height;
@@ -126,7 +117,8 @@ public:
 	}
 
 	Matrix* q;
-	void* data;
+	void* data; // MatrixBuffer<T> with the values of the type given by mode
+	void* importData{nullptr}; // QVector<QVector<T>> with the columns handed out to the import filters in prepareImport()
 	AbstractColumn::ColumnMode mode; // mode (data type) of values
 
 	int rowCount;
@@ -96,6 +96,22 @@ void MatrixSetFormulaCmd::undo() {
 	redo();
 }
 
+// transpose
+MatrixTransposeCmd::MatrixTransposeCmd(MatrixPrivate* private_obj, QUndoCommand* parent)
+	: QUndoCommand(parent)
+	, m_private_obj(private_obj) {
+	setText(i18n("%1: transpose", m_private_obj->name()));
+}
+
+void MatrixTransposeCmd::redo() {
+	m_private_obj->transpose();
+	m_private_obj->emitDataChanged(0, 0, m_private_obj->rowCount - 1, m_private_obj->columnCount - 1);
+}
+
+void MatrixTransposeCmd::undo() {
+	redo();
+}
+
 // replace values
 MatrixReplaceValuesCmd::MatrixReplaceValuesCmd(MatrixPrivate* private_obj, void* new_values, QUndoCommand* parent)
 	: QUndoCommand(parent)
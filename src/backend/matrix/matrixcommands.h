@@ -297,41 +297,11 @@ private:
 };
 
 //! Transpose the matrix
-template<typename T>
 class MatrixTransposeCmd : public QUndoCommand {
 public:
-	explicit MatrixTransposeCmd(MatrixPrivate* private_obj, QUndoCommand* parent = nullptr)
-		: QUndoCommand(parent)
-		, m_private_obj(private_obj) {
-		setText(i18n("%1: transpose", m_private_obj->name()));
-	}
-	void redo() override {
-		int rows = m_private_obj->rowCount;
-		int cols = m_private_obj->columnCount;
-		int temp_size = qMax(rows, cols);
-		m_private_obj->suppressDataChange = true;
-		if (cols < rows)
-			m_private_obj->insertColumns(cols, temp_size - cols);
-		else if (cols > rows)
-			m_private_obj->insertRows(rows, temp_size - rows);
-
-		for (int i = 1; i < temp_size; i++) {
-			QVector<T> row = m_private_obj->rowCells<T>(i, 0, i - 1);
-			QVector<T> col = m_private_obj->columnCells<T>(i, 0, i - 1);
-			m_private_obj->setRowCells(i, 0, i - 1, col);
-			m_private_obj->setColumnCells(i, 0, i - 1, row);
-		}
-
-		if (cols < rows)
-			m_private_obj->removeRows(cols, temp_size - cols);
-		else if (cols > rows)
-			m_private_obj->removeColumns(rows, temp_size - rows);
-		m_private_obj->suppressDataChange = false;
-		m_private_obj->emitDataChanged(0, 0, m_private_obj->rowCount - 1, m_private_obj->columnCount - 1);
-	}
-	void undo() override {
-		redo();
-	}
+	explicit MatrixTransposeCmd(MatrixPrivate*, QUndoCommand* = nullptr);
+	void redo() override;
+	void undo() override;
 
 private:
 	MatrixPrivate* m_private_obj;
@@ -347,17 +317,11 @@ public:
 		setText(i18n("%1: mirror horizontally", m_private_obj->name()));
 	}
 	void redo() override {
-		int rows = m_private_obj->rowCount;
-		int cols = m_private_obj->columnCount;
-		int middle = cols / 2;
-		m_private_obj->suppressDataChange = true;
-
-		for (int i = 0; i < middle; i++) {
-			QVector<T> temp = m_private_obj->columnCells<T>(i, 0, rows - 1);
-			m_private_obj->setColumnCells(i, 0, rows - 1, m_private_obj->columnCells<T>(cols - i - 1, 0, rows - 1));
-			m_private_obj->setColumnCells(cols - i - 1, 0, rows - 1, temp);
-		}
-		m_private_obj->suppressDataChange = false;
+		const int rows = m_private_obj->rowCount;
+		const int cols = m_private_obj->columnCount;
+
+		m_private_obj->template buffer<T>()->mirrorHorizontally();
+
 		m_private_obj->emitDataChanged(0, 0, rows - 1, cols - 1);
 	}
 	void undo() override {
@@ -378,18 +342,11 @@ public:
 		setText(i18n("%1: mirror vertically", m_private_obj->name()));
 	}
 	void redo() override {
-		int rows = m_private_obj->rowCount;
-		int cols = m_private_obj->columnCount;
-		int middle = rows / 2;
-		m_private_obj->suppressDataChange = true;
-
-		for (int i = 0; i < middle; i++) {
-			QVector<T> temp = m_private_obj->rowCells<T>(i, 0, cols - 1);
-			m_private_obj->setRowCells(i, 0, cols - 1, m_private_obj->rowCells<T>(rows - i - 1, 0, cols - 1));
-			m_private_obj->setRowCells(rows - i - 1, 0, cols - 1, temp);
-		}
+		const int rows = m_private_obj->rowCount;
+		const int cols = m_private_obj->columnCount;
+
+		m_private_obj->template buffer<T>()->mirrorVertically();
 
-		m_private_obj->suppressDataChange = false;
 		m_private_obj->emitDataChanged(0, 0, rows - 1, cols - 1);
 	}
 	void undo() override {
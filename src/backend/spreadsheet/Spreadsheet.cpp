@@ -13,6 +13,7 @@
 #include "Spreadsheet.h"
 #include "SpreadsheetModel.h"
 #include "SpreadsheetPrivate.h"
+#include "SpreadsheetSort.h"
 #include "StatisticsSpreadsheet.h"
 #include "backend/core/AbstractAspect.h"
 #include "backend/core/AspectPrivate.h"
@@ -282,8 +283,15 @@ void Spreadsheet::removeEmptyRows() {
 	WAIT_CURSOR;
 	beginMacro(i18n("%1: remove rows with missing values", name()));
 
-	for (int row = rows.count() - 1; row >= 0; --row)
-		removeRows(rows.at(row), 1);
+	// remove consecutive rows in one step, starting from the end so the indices of the remaining rows don't change
+	int last = rows.count() - 1;
+	while (last >= 0) {
+		int first = last;
+		while (first > 0 && rows.at(first - 1) == rows.at(first) - 1)
+			--first;
+		removeRows(rows.at(first), last - first + 1);
+		last = first - 1;
+	}
 
 	endMacro();
 	RESET_CURSOR;
@@ -729,360 +737,49 @@ int Spreadsheet::colY(int col) {
   If 'leading' is a null pointer, each column is sorted separately.
 */
 void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, bool ascending) {
+	if (leading)
+		sortColumns(QVector<Column*>{leading}, cols, ascending);
+	else
+		sortColumns(QVector<Column*>(), cols, ascending);
+}
+
+/*! Sorts the given list of columns by the values of the columns in 'keys', the first key is the most significant one.
+  If 'keys' is empty, each column is sorted separately.
+  Rows with invalid or empty values in a key column are placed at the end.
+  The permutation of the rows is determined once and applied to all columns, it is the only data kept for undo.
+*/
+void Spreadsheet::sortColumns(const QVector<Column*>& keys, const QVector<Column*>& cols, bool ascending) {
 	DEBUG(Q_FUNC_INFO << ", ascending = " << ascending)
 	if (cols.isEmpty())
 		return;
 
-	// the normal QPair comparison does not work properly with descending sorting
-	// therefore we use our own compare functions
-	// TODO: check this. a < b vs. a.first < b.first
-	class CompareFunctions {
-	public:
-		static bool doubleLess(QPair<double, int> a, QPair<double, int> b) {
-			return a.first < b.first;
-		}
-		static bool doubleGreater(QPair<double, int> a, QPair<double, int> b) {
-			return a.first > b.first;
-		}
-		static bool integerLess(QPair<int, int> a, QPair<int, int> b) {
-			return a.first < b.first;
-		}
-		static bool integerGreater(QPair<int, int> a, QPair<int, int> b) {
-			return a.first > b.first;
-		}
-		static bool bigIntLess(QPair<qint64, int> a, QPair<qint64, int> b) {
-			return a.first < b.first;
-		}
-		static bool bigIntGreater(QPair<qint64, int> a, QPair<qint64, int> b) {
-			return a.first > b.first;
-		}
-		static bool QStringLess(const QPair<QString, int>& a, const QPair<QString, int>& b) {
-			return a < b;
-		}
-		static bool QStringGreater(const QPair<QString, int>& a, const QPair<QString, int>& b) {
-			return a > b;
-		}
-		static bool QDateTimeLess(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a < b;
-		}
-		static bool QDateTimeGreater(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a > b;
-		}
-	};
-
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
 	WAIT_CURSOR;
 	beginMacro(i18n("%1: sort columns", name()));
 
-	if (!leading) { // sort separately
+	if (keys.isEmpty()) { // sort separately
 		DEBUG("	sort separately")
 		for (auto* col : cols) {
-			int rows = col->rowCount();
-			std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-
-			switch (col->columnMode()) {
-			case AbstractColumn::ColumnMode::Double: {
-				QVector<QPair<double, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					if (col->isValid(i))
-						map.append(QPair<double, int>(col->valueAt(i), i));
-				const int filledRows = map.size();
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::Integer: {
-				QVector<QPair<int, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					map.append(QPair<int, int>(col->valueAt(i), i));
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::integerLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::integerGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::BigInt: {
-				QVector<QPair<qint64, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					map.append(QPair<qint64, int>(col->valueAt(i), i));
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::Text: {
-				QVector<QPair<QString, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					if (!col->textAt(i).isEmpty())
-						map.append(QPair<QString, int>(col->textAt(i), i));
-				const int filledRows = map.size();
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::DateTime:
-			case AbstractColumn::ColumnMode::Month:
-			case AbstractColumn::ColumnMode::Day: {
-				QVector<QPair<QDateTime, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					if (col->isValid(i))
-						map.append(QPair<QDateTime, int>(col->dateTimeAt(i), i));
-				const int filledRows = map.size();
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			}
-			// copy the sorted column
-			col->copy(tempCol.get(), 0, 0, rows);
-		}
-	} else { // sort with leading column
-		DEBUG("	sort with leading column")
-		int rows = leading->rowCount();
-
-		switch (leading->columnMode()) {
-		case AbstractColumn::ColumnMode::Double: {
-			QVector<QPair<double, int>> map;
-			QVector<int> invalidIndex;
-
-			for (int i = 0; i < rows; i++)
-				if (leading->isValid(i))
-					map.append(QPair<double, int>(leading->valueAt(i), i));
-				else
-					invalidIndex << i;
-			const int filledRows = map.size();
-			const int invalidRows = invalidIndex.size();
-
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-
-			for (auto* col : cols) {
-				auto columnMode = col->columnMode();
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), columnMode));
-				// put the values in correct order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempInvalidCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < invalidRows; i++) {
-						const int idx = invalidIndex.at(i);
-						// too slow: tempInvalidCol->copy(col, idx, i, 1);
-						tempInvalidCol->setFromColumn(i, col, idx);
-						tempInvalidCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempInvalidCol.get(), 0, filledRows, invalidRows);
-				}
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::Integer: {
-			// TODO: check if still working when invalid integer entries are supported
-			QVector<QPair<int, int>> map;
-
-			for (int i = 0; i < rows; i++)
-				map.append(QPair<int, int>(leading->valueAt(i), i));
-
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::integerLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::integerGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				col->copy(tempCol.get(), 0, 0, rows);
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::BigInt: {
-			QVector<QPair<qint64, int>> map;
-
-			for (int i = 0; i < rows; i++)
-				map.append(QPair<qint64, int>(leading->valueAt(i), i));
-
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
+			const auto permutation = SpreadsheetSort::permutation({col}, col->rowCount(), ascending);
+			if (SpreadsheetSort::isIdentity(permutation))
+				continue;
 
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				col->copy(tempCol.get(), 0, 0, rows);
-			}
-			break;
+			col->permuteRows(permutation);
+			SpreadsheetSort::permuteMasks(col, permutation);
 		}
-		case AbstractColumn::ColumnMode::Text: {
-			QVector<QPair<QString, int>> map;
-			QVector<int> emptyIndex;
-
-			for (int i = 0; i < rows; i++)
-				if (!leading->textAt(i).isEmpty())
-					map.append(QPair<QString, int>(leading->textAt(i), i));
-				else
-					emptyIndex << i;
-			// QDEBUG("	empty indices: " << emptyIndex)
-			const int filledRows = map.size();
-			const int emptyRows = emptyIndex.size();
-
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
+	} else { // sort with leading columns
+		DEBUG("	sort with leading columns")
+		QVector<const Column*> sortKeys;
+		for (auto* key : keys)
+			sortKeys << key;
+
+		const auto permutation = SpreadsheetSort::permutation(sortKeys, keys.constFirst()->rowCount(), ascending);
+		if (!SpreadsheetSort::isIdentity(permutation)) {
+			// the permutation is shared by the undo commands of all columns
 			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempEmptyCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < emptyRows; i++) {
-						const int idx = emptyIndex.at(i);
-						// too slow: tempEmptyCol->copy(col, idx, i, 1);
-						tempEmptyCol->setFromColumn(i, col, idx);
-						tempEmptyCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempEmptyCol.get(), 0, filledRows, emptyRows);
-				}
+				col->permuteRows(permutation);
+				SpreadsheetSort::permuteMasks(col, permutation);
 			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day: {
-			QVector<QPair<QDateTime, int>> map;
-			QVector<int> invalidIndex;
-
-			for (int i = 0; i < rows; i++)
-				if (leading->isValid(i))
-					map.append(QPair<QDateTime, int>(leading->dateTimeAt(i), i));
-				else
-					invalidIndex << i;
-			const int filledRows = map.size();
-			const int invalidRows = invalidIndex.size();
-
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempInvalidCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < invalidRows; i++) {
-						const int idx = invalidIndex.at(i);
-						// too slow: tempInvalidCol->copy(col, idx, i, 1);
-						tempInvalidCol->setFromColumn(i, col, idx);
-						tempInvalidCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempInvalidCol.get(), 0, filledRows, invalidRows);
-				}
-			}
-			break;
-		}
 		}
 	}
 
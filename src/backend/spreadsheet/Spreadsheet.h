@@ -125,6 +125,7 @@ public Q_SLOTS:
 
 	void moveColumn(int from, int to);
 	void sortColumns(Column* leading, const QVector<Column*>&, bool ascending);
+	void sortColumns(const QVector<Column*>& keys, const QVector<Column*>&, bool ascending);
 
 	void toggleStatisticsSpreadsheet(bool);
 
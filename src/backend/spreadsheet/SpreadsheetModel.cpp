@@ -85,6 +85,7 @@ void SpreadsheetModel::suppressSignals(bool value) {
 	else {
 		m_rowCount = m_spreadsheet->rowCount();
 		m_columnCount = m_spreadsheet->columnCount();
+		invalidateCache();
 		updateHorizontalHeader(false);
 		endResetModel();
 	}
@@ -99,6 +100,7 @@ Qt::ItemFlags SpreadsheetModel::flags(const QModelIndex& index) const {
 
 void SpreadsheetModel::setSearchText(const QString& text) {
 	m_searchText = text;
+	m_searchMatches.clear();
 }
 
 QModelIndex SpreadsheetModel::index(const QString& text) const {
@@ -159,24 +161,11 @@ QVariant SpreadsheetModel::data(const QModelIndex& index, int role) const {
 
 		break;
 	case Qt::DisplayRole:
-		if (col_ptr->columnMode() == AbstractColumn::ColumnMode::Double) {
-			double value = col_ptr->valueAt(row);
-			if (std::isnan(value))
-				return {QStringLiteral("-")};
-			else if (std::isinf(value))
-				return {UTF8_QSTRING("∞")};
-			else
-				return {col_ptr->asStringColumn()->textAt(row)};
-		}
-
-		if (!col_ptr->isValid(row))
-			return {QStringLiteral("-")};
-
 		// m_formula_mode is not used at the moment
 		// if (m_formula_mode)
 		//	return QVariant(col_ptr->formula(row));
 
-		return {col_ptr->asStringColumn()->textAt(row)};
+		return {displayText(col_ptr, col, row)};
 	case Qt::ForegroundRole:
 		if (!col_ptr->isValid(row))
 			return {QBrush(Qt::red)};
@@ -185,7 +174,7 @@ QVariant SpreadsheetModel::data(const QModelIndex& index, int role) const {
 		if (m_searchText.isEmpty())
 			return color(col_ptr, row, AbstractColumn::Formatting::Background);
 		else {
-			if (col_ptr->asStringColumn()->textAt(row).indexOf(m_searchText) == -1)
+			if (!searchMatch(col_ptr, col, row))
 				return color(col_ptr, row, AbstractColumn::Formatting::Background);
 			else
 				return {QApplication::palette().color(QPalette::Highlight)};
@@ -317,6 +306,7 @@ void SpreadsheetModel::handleAspectsInserted(int first, int last) {
 	if (first < 0 || first >= children.count() || last >= children.count() || first > last)
 		return;
 
+	invalidateCache();
 	for (int i = first; i <= last; i++) {
 		const auto* col = children.at(i);
 		connect(col, &Column::plotDesignationChanged, this, &SpreadsheetModel::handlePlotDesignationChange);
@@ -375,6 +365,7 @@ void SpreadsheetModel::handleAspectAboutToBeRemoved(const AbstractAspect* aspect
 }
 
 void SpreadsheetModel::handleAspectsRemoved() {
+	invalidateCache();
 	if (m_suppressSignals)
 		return;
 	handleAspectCountChanged();
@@ -449,10 +440,11 @@ void SpreadsheetModel::handlePlotDesignationChange(const AbstractColumn* col) {
 }
 
 void SpreadsheetModel::handleDataChange(const AbstractColumn* col) {
+	int i = m_spreadsheet->indexOfChild<Column>(col);
+	invalidateCache(i);
 	if (m_suppressSignals)
 		return;
 
-	int i = m_spreadsheet->indexOfChild<Column>(col);
 	Q_EMIT dataChanged(index(0, i), index(m_rowCount - 1, i));
 }
 
@@ -483,6 +475,7 @@ void SpreadsheetModel::handleRowsRemoved(int newRowCount) {
 }
 
 void SpreadsheetModel::handleRowCountChanged(int newRowCount) {
+	invalidateCache();
 	if (m_suppressSignals)
 		return;
 	m_rowCount = newRowCount;
@@ -553,21 +546,16 @@ QVariant SpreadsheetModel::color(const AbstractColumn* column, int row, Abstract
 	if (format.type != type || format.colors.isEmpty())
 		return {};
 
+	const int count = format.colors.count();
 	int index = 0;
 	if (column->isNumeric()) {
-		double value = column->valueAt(row);
-		double range = (format.max - format.min) / format.colors.count();
-
+		// direct lookup of the interval [min + i*range, min + (i+1)*range] containing the value
+		const double value = column->valueAt(row);
+		const double range = (format.max - format.min) / count;
 		if (value > format.max)
-			index = format.colors.count() - 1;
-		else {
-			for (int i = 0; i < format.colors.count(); ++i) {
-				if (value <= format.min + (i + 1) * range) {
-					index = i;
-					break;
-				}
-			}
-		}
+			index = count - 1;
+		else if (range > 0. && value > format.min)
+			index = std::min(static_cast<int>(std::ceil((value - format.min) / range)) - 1, count - 1);
 	} else {
 		index = column->dictionaryIndex(row);
 	}
@@ -577,3 +565,82 @@ QVariant SpreadsheetModel::color(const AbstractColumn* column, int row, Abstract
 	else
 		return {QColor(format.colors.constLast())};
 }
+
+/*!
+ * returns the text shown in the cell \p row of the column \p column with the index \p col.
+ * The texts are formatted for blocks of rows and cached until the data or the format of the column is changed.
+ */
+QString SpreadsheetModel::displayText(const Column* column, int col, int row) const {
+	const int block = row / TextCacheBlockSize;
+	const quint64 key = (static_cast<quint64>(col) << 32) | static_cast<quint64>(block);
+	auto* texts = m_textCache.object(key);
+	if (!texts) {
+		const int first = block * TextCacheBlockSize;
+		const int last = std::min(first + TextCacheBlockSize, std::max(m_rowCount, row + 1));
+		const bool isDouble = (column->columnMode() == AbstractColumn::ColumnMode::Double);
+		auto* stringColumn = column->asStringColumn();
+		texts = new QVector<QString>();
+		texts->reserve(last - first);
+		for (int i = first; i < last; ++i) {
+			if (isDouble) {
+				const double value = column->valueAt(i);
+				if (std::isnan(value))
+					texts->append(QStringLiteral("-"));
+				else if (std::isinf(value))
+					texts->append(UTF8_QSTRING("∞"));
+				else
+					texts->append(stringColumn->textAt(i));
+			} else if (!column->isValid(i))
+				texts->append(QStringLiteral("-"));
+			else
+				texts->append(stringColumn->textAt(i));
+		}
+		m_textCache.insert(key, texts);
+	}
+
+	return texts->value(row - block * TextCacheBlockSize);
+}
+
+/*!
+ * returns \c true if the cell \p row of the column \p column with the index \p col contains the current search text.
+ * The matches are determined once for the whole column after the search text or the data was changed.
+ */
+bool SpreadsheetModel::searchMatch(const Column* column, int col, int row) const {
+	if (m_searchMatches.size() != m_columnCount)
+		m_searchMatches.resize(m_columnCount);
+	if (col >= m_searchMatches.size())
+		return false;
+
+	auto& matches = m_searchMatches[col];
+	if (matches.size() != m_rowCount) {
+		matches = QBitArray(m_rowCount);
+		auto* stringColumn = column->asStringColumn();
+		const int rows = std::min(m_rowCount, column->rowCount());
+		for (int i = 0; i < rows; ++i) {
+			if (stringColumn->textAt(i).indexOf(m_searchText) != -1)
+				matches.setBit(i);
+		}
+	}
+
+	return row < matches.size() && matches.testBit(row);
+}
+
+/*!
+ * invalidates the cached texts and search matches of the column with the index \p col, of all columns if \p col is negative.
+ */
+void SpreadsheetModel::invalidateCache(int col) {
+	if (col < 0) {
+		m_textCache.clear();
+		m_searchMatches.clear();
+		return;
+	}
+
+	const auto keys = m_textCache.keys();
+	for (const auto key : keys) {
+		if ((key >> 32) == static_cast<quint64>(col))
+			m_textCache.remove(key);
+	}
+
+	if (col < m_searchMatches.size())
+		m_searchMatches[col] = QBitArray();
+}
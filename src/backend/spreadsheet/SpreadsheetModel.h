@@ -14,6 +14,8 @@
 
 #include "backend/core/AbstractColumn.h"
 #include <QAbstractItemModel>
+#include <QBitArray>
+#include <QCache>
 
 class Column;
 class Spreadsheet;
@@ -91,7 +93,14 @@ private:
 	int m_columnCount{0};
 	QString m_searchText;
 
+	static const int TextCacheBlockSize = 256;
+	mutable QCache<quint64, QVector<QString>> m_textCache{512}; // formatted texts of blocks of rows, the key consists of the column and block index
+	mutable QVector<QBitArray> m_searchMatches; // cells containing m_searchText, determined on demand for every column
+
 	QVariant color(const AbstractColumn*, int row, AbstractColumn::Formatting) const;
+	QString displayText(const Column*, int col, int row) const;
+	bool searchMatch(const Column*, int col, int row) const;
+	void invalidateCache(int col = -1);
 };
 
 #endif
@@ -0,0 +1,602 @@
+/*
+	File                 : SpreadsheetSearch.cpp
+	Project              : LabPlot
+	Description          : Search&Replace engine for the spreadsheet
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "SpreadsheetSearch.h"
+#include "backend/core/column/Column.h"
+#include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <KLocalizedString>
+
+#include <QHash>
+#include <QLocale>
+#include <QRegularExpression>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+
+/*!
+ * \class SpreadsheetSearch
+ * \brief Search&Replace engine for the spreadsheet.
+ *
+ * The engine scans the data containers of the columns directly in parallel chunks
+ * and determines the index of all matching cells that is used to navigate through
+ * the matches and to replace all of them with one undo step. The index is kept
+ * as long as the search settings and the data of the columns are unchanged.
+ *
+ * \ingroup backend
+ */
+
+namespace {
+const int ChunkSize = 65536; // number of rows processed in one task
+const int MaxDictionarySize = 10000; // max. number of distinct text values whose result is remembered
+
+struct Chunk {
+	const Column* column;
+	int columnIndex;
+	int first;
+	int last;
+	QVector<int> rows; // matching rows in [first, last)
+};
+
+bool checkCellText(const QString& cellText, const QString& pattern, SpreadsheetSearch::OperatorText op, Qt::CaseSensitivity cs, const QRegularExpression& re) {
+	bool match = false;
+
+	switch (op) {
+	case SpreadsheetSearch::OperatorText::EqualTo:
+		match = (cellText.compare(pattern, cs) == 0);
+		break;
+	case SpreadsheetSearch::OperatorText::NotEqualTo:
+		match = (cellText.compare(pattern, cs) != 0);
+		break;
+	case SpreadsheetSearch::OperatorText::StartsWith:
+		match = cellText.startsWith(pattern, cs);
+		break;
+	case SpreadsheetSearch::OperatorText::EndsWith:
+		match = cellText.endsWith(pattern, cs);
+		break;
+	case SpreadsheetSearch::OperatorText::Contain:
+		match = (cellText.indexOf(pattern, 0, cs) != -1);
+		break;
+	case SpreadsheetSearch::OperatorText::NotContain:
+		match = (cellText.indexOf(pattern, 0, cs) == -1);
+		break;
+	case SpreadsheetSearch::OperatorText::RegEx:
+		match = re.match(cellText).hasMatch();
+		break;
+	}
+
+	return match;
+}
+
+bool checkCellNumeric(double cellValue, double patternValue1, double patternValue2, SpreadsheetSearch::Operator op) {
+	bool match = false;
+
+	switch (op) {
+	case SpreadsheetSearch::Operator::EqualTo:
+		match = (cellValue == patternValue1);
+		break;
+	case SpreadsheetSearch::Operator::NotEqualTo:
+		match = (cellValue != patternValue1);
+		break;
+	case SpreadsheetSearch::Operator::BetweenIncl:
+		match = (cellValue >= patternValue1 && cellValue <= patternValue2);
+		break;
+	case SpreadsheetSearch::Operator::BetweenExcl:
+		match = (cellValue > patternValue1 && cellValue < patternValue2);
+		break;
+	case SpreadsheetSearch::Operator::GreaterThan:
+		match = (cellValue > patternValue1);
+		break;
+	case SpreadsheetSearch::Operator::GreaterThanEqualTo:
+		match = (cellValue >= patternValue1);
+		break;
+	case SpreadsheetSearch::Operator::LessThan:
+		match = (cellValue < patternValue1);
+		break;
+	case SpreadsheetSearch::Operator::LessThanEqualTo:
+		match = (cellValue <= patternValue1);
+		break;
+	}
+
+	return match;
+}
+
+bool isBetween(SpreadsheetSearch::Operator op) {
+	return (op == SpreadsheetSearch::Operator::BetweenIncl || op == SpreadsheetSearch::Operator::BetweenExcl);
+}
+
+/*!
+ * matches the cells of a column against the search settings. The patterns are parsed only once,
+ * the text values are matched only once per distinct value (dictionary of already checked values).
+ */
+class CellMatcher {
+public:
+	explicit CellMatcher(const SpreadsheetSearch::Settings& settings)
+		: m_settings(settings) {
+		switch (m_settings.type) {
+		case SpreadsheetSearch::DataType::Text:
+			m_valid = true;
+			break;
+		case SpreadsheetSearch::DataType::Numeric: {
+			bool ok;
+			const auto numberLocale = QLocale();
+			m_value1 = numberLocale.toDouble(m_settings.pattern1, &ok);
+			m_valid = ok;
+			if (m_valid && isBetween(m_settings.operatorNumeric)) {
+				m_value2 = numberLocale.toDouble(m_settings.pattern2, &ok);
+				m_valid = ok;
+			}
+			break;
+		}
+		case SpreadsheetSearch::DataType::DateTime:
+			m_valid = m_settings.dateTime1.isValid() && (!isBetween(m_settings.operatorDateTime) || m_settings.dateTime2.isValid());
+			m_value1 = m_settings.dateTime1.toMSecsSinceEpoch();
+			m_value2 = m_settings.dateTime2.toMSecsSinceEpoch();
+			break;
+		}
+
+		if (m_settings.ignoreDataType)
+			m_valid = true;
+	}
+
+	bool isValid() const {
+		return m_valid;
+	}
+
+	void match(Chunk& chunk) const {
+		const auto* column = chunk.column;
+		if (!column->data())
+			return;
+
+		const auto mode = column->columnMode();
+		if (m_settings.ignoreDataType || m_settings.type == SpreadsheetSearch::DataType::Text) {
+			if (mode == AbstractColumn::ColumnMode::Text)
+				matchText(chunk, [column](int row) {
+					return static_cast<const QVector<QString>*>(column->data())->value(row);
+				});
+			else // the text representation of the non-text values, "simple search" only
+				matchText(chunk, [column](int row) {
+					return column->asStringColumn()->textAt(row);
+				});
+			return;
+		}
+
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			matchNumeric(chunk, static_cast<const QVector<double>*>(column->data()));
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			matchNumeric(chunk, static_cast<const QVector<int>*>(column->data()));
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			matchNumeric(chunk, static_cast<const QVector<qint64>*>(column->data()));
+			break;
+		case AbstractColumn::ColumnMode::DateTime: {
+			const auto* data = static_cast<const QVector<QDateTime>*>(column->data());
+			for (int row = chunk.first; row < chunk.last; ++row) {
+				const double value = data->value(row).toMSecsSinceEpoch();
+				if (checkCellNumeric(value, m_value1, m_value2, m_settings.operatorDateTime))
+					chunk.rows << row;
+			}
+			break;
+		}
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+
+private:
+	const SpreadsheetSearch::Settings& m_settings;
+	bool m_valid{false};
+	double m_value1{0.};
+	double m_value2{0.};
+
+	template<typename Getter>
+	void matchText(Chunk& chunk, Getter text) const {
+		const auto& pattern = m_settings.pattern1;
+		const auto op = m_settings.operatorText;
+		const auto cs = m_settings.caseSensitivity;
+
+		// the regular expression is created for every chunk, the matching is done in multiple threads
+		QRegularExpression re;
+		if (op == SpreadsheetSearch::OperatorText::RegEx) {
+			re.setPattern(pattern);
+			if (cs == Qt::CaseInsensitive)
+				re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+		}
+
+		QHash<QString, bool> dictionary;
+		for (int row = chunk.first; row < chunk.last; ++row) {
+			const auto& value = text(row);
+			bool match;
+			const auto it = dictionary.constFind(value);
+			if (it != dictionary.constEnd())
+				match = it.value();
+			else {
+				match = checkCellText(value, pattern, op, cs, re);
+				if (dictionary.size() < MaxDictionarySize)
+					dictionary.insert(value, match);
+			}
+
+			if (match)
+				chunk.rows << row;
+		}
+	}
+
+	template<typename T>
+	void matchNumeric(Chunk& chunk, const QVector<T>* data) const {
+		const int size = data->size();
+		for (int row = chunk.first; row < chunk.last; ++row) {
+			const double value = (row < size) ? static_cast<double>(data->at(row)) : NAN;
+			if (checkCellNumeric(value, m_value1, m_value2, m_settings.operatorNumeric))
+				chunk.rows << row;
+		}
+	}
+};
+
+void replaceData(Column* column, const QVector<QString>& data) {
+	column->replaceTexts(-1, data);
+}
+
+void replaceData(Column* column, const QVector<double>& data) {
+	column->replaceValues(-1, data);
+}
+
+void replaceData(Column* column, const QVector<int>& data) {
+	column->replaceInteger(-1, data);
+}
+
+void replaceData(Column* column, const QVector<qint64>& data) {
+	column->replaceBigInt(-1, data);
+}
+
+void replaceData(Column* column, const QVector<QDateTime>& data) {
+	column->replaceDateTimes(-1, data);
+}
+
+template<typename T>
+int replaceValues(Column* column, const QVector<int>& rows, const T& value, const T& emptyValue) {
+	if (rows.isEmpty())
+		return 0;
+
+	auto data = column->snapshot<T>().data;
+	const int size = data.size();
+	if (size <= rows.last()) {
+		// matches behind the last row of the column (empty cells), extend the column
+		data.resize(rows.last() + 1);
+		std::fill(data.begin() + size, data.end(), emptyValue);
+	}
+
+	for (int row : rows)
+		data[row] = value;
+
+	replaceData(column, data);
+	return rows.size();
+}
+} // namespace
+
+bool SpreadsheetSearch::Settings::operator==(const Settings& other) const {
+	return type == other.type && operatorText == other.operatorText && operatorNumeric == other.operatorNumeric && operatorDateTime == other.operatorDateTime
+		&& caseSensitivity == other.caseSensitivity && ignoreDataType == other.ignoreDataType && pattern1 == other.pattern1 && pattern2 == other.pattern2
+		&& dateTime1 == other.dateTime1 && dateTime2 == other.dateTime2;
+}
+
+SpreadsheetSearch::SpreadsheetSearch(Spreadsheet* spreadsheet)
+	: m_spreadsheet(spreadsheet) {
+}
+
+void SpreadsheetSearch::setSettings(const Settings& settings) {
+	if (settings == m_settings)
+		return;
+
+	m_settings = settings;
+	m_valid = false;
+}
+
+const SpreadsheetSearch::Settings& SpreadsheetSearch::settings() const {
+	return m_settings;
+}
+
+//! returns the total number of the matching cells
+int SpreadsheetSearch::matchCount() {
+	update();
+	int count = 0;
+	for (const auto& rows : qAsConst(m_matches))
+		count += rows.size();
+	return count;
+}
+
+//! returns the sorted indices of the matching rows in the column \c col
+const QVector<int>& SpreadsheetSearch::matches(int col) {
+	update();
+	static const QVector<int> empty;
+	if (col < 0 || col >= m_matches.size())
+		return empty;
+	return m_matches.at(col);
+}
+
+bool SpreadsheetSearch::isMatch(int row, int col) {
+	const auto& rows = matches(col);
+	return std::binary_search(rows.cbegin(), rows.cend(), row);
+}
+
+/*!
+ * determines the first matching cell at or after the cell (\c row, \c col) in the specified order.
+ * Returns \c true and the position of the match in \c row and \c col if a match was found.
+ */
+bool SpreadsheetSearch::findNext(int& row, int& col, Order order) {
+	update();
+	const int colCount = m_matches.size();
+	if (order == Order::ColumnMajor) {
+		for (int c = std::max(col, 0); c < colCount; ++c) {
+			const auto& rows = m_matches.at(c);
+			const auto it = (c == col) ? std::lower_bound(rows.cbegin(), rows.cend(), row) : rows.cbegin();
+			if (it != rows.cend()) {
+				row = *it;
+				col = c;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// row-major: the smallest (row, column) pair among the next matches in every column
+	int nextRow = -1;
+	int nextCol = -1;
+	for (int c = 0; c < colCount; ++c) {
+		const auto& rows = m_matches.at(c);
+		const int startRow = (c < col) ? row + 1 : row;
+		const auto it = std::lower_bound(rows.cbegin(), rows.cend(), startRow);
+		if (it != rows.cend() && (nextRow == -1 || *it < nextRow)) {
+			nextRow = *it;
+			nextCol = c;
+		}
+	}
+
+	if (nextRow == -1)
+		return false;
+
+	row = nextRow;
+	col = nextCol;
+	return true;
+}
+
+/*!
+ * determines the last matching cell at or before the cell (\c row, \c col) in the specified order.
+ * Returns \c true and the position of the match in \c row and \c col if a match was found.
+ */
+bool SpreadsheetSearch::findPrevious(int& row, int& col, Order order) {
+	update();
+	const int colCount = m_matches.size();
+	if (order == Order::ColumnMajor) {
+		for (int c = std::min(col, colCount - 1); c >= 0; --c) {
+			const auto& rows = m_matches.at(c);
+			const auto it = (c == col) ? std::upper_bound(rows.cbegin(), rows.cend(), row) : rows.cend();
+			if (it != rows.cbegin()) {
+				row = *(it - 1);
+				col = c;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// row-major: the largest (row, column) pair among the previous matches in every column
+	int prevRow = -1;
+	int prevCol = -1;
+	for (int c = 0; c < colCount; ++c) {
+		const auto& rows = m_matches.at(c);
+		const int startRow = (c > col) ? row - 1 : row;
+		const auto it = std::upper_bound(rows.cbegin(), rows.cend(), startRow);
+		if (it != rows.cbegin() && *(it - 1) >= prevRow) {
+			prevRow = *(it - 1);
+			prevCol = c;
+		}
+	}
+
+	if (prevRow == -1)
+		return false;
+
+	row = prevRow;
+	col = prevCol;
+	return true;
+}
+
+/*!
+ * re-evaluates the cell (\c row, \c col) after it was modified and updates the index accordingly
+ * without scanning the whole spreadsheet again.
+ */
+void SpreadsheetSearch::updateMatch(int row, int col) {
+	if (!m_valid || col < 0 || col >= m_columns.size())
+		return;
+
+	// only the column \c col is allowed to be modified since the index was determined, rescan otherwise
+	const auto& columns = m_spreadsheet->children<Column>();
+	if (m_spreadsheet->rowCount() != m_rowCount || columns.size() != m_columns.size()) {
+		m_valid = false;
+		return;
+	}
+
+	for (int c = 0; c < columns.size(); ++c) {
+		if (columns.at(c) != m_columns.at(c) || (c != col && columns.at(c)->dataVersion() != m_versions.at(c))) {
+			m_valid = false;
+			return;
+		}
+	}
+
+	auto* column = m_columns.at(col).data();
+	auto& rows = m_matches[col];
+	const auto it = std::lower_bound(rows.begin(), rows.end(), row);
+	const bool found = (it != rows.end() && *it == row);
+	const bool match = isColumnSearchable(column) && matchesCell(column, row);
+	if (match && !found)
+		rows.insert(it, row);
+	else if (!match && found)
+		rows.erase(it);
+
+	m_versions[col] = column->dataVersion();
+}
+
+/*!
+ * replaces the values in all matching cells with \c value (\c dateTime for DateTime columns).
+ * All modifications are done with one undo step. Returns the number of replaced values.
+ */
+int SpreadsheetSearch::replaceAll(const QString& value, const QDateTime& dateTime) {
+	update();
+
+	int count = 0;
+	m_spreadsheet->beginMacro(i18n("%1: replace values", m_spreadsheet->name()));
+
+	for (int col = 0; col < m_matches.size(); ++col) {
+		auto* column = m_columns.at(col).data();
+		const auto& rows = m_matches.at(col);
+		if (!column || rows.isEmpty())
+			continue;
+
+		bool ok = true;
+		const auto numberLocale = QLocale();
+		switch (column->columnMode()) {
+		case AbstractColumn::ColumnMode::Text:
+			count += replaceValues<QString>(column, rows, value, QString());
+			break;
+		case AbstractColumn::ColumnMode::Double: {
+			const double v = numberLocale.toDouble(value, &ok);
+			if (ok)
+				count += replaceValues<double>(column, rows, v, NAN);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Integer: {
+			const int v = numberLocale.toInt(value, &ok);
+			if (ok)
+				count += replaceValues<int>(column, rows, v, 0);
+			break;
+		}
+		case AbstractColumn::ColumnMode::BigInt: {
+			const qint64 v = numberLocale.toLongLong(value, &ok);
+			if (ok)
+				count += replaceValues<qint64>(column, rows, v, 0);
+			break;
+		}
+		case AbstractColumn::ColumnMode::DateTime:
+			if (dateTime.isValid())
+				count += replaceValues<QDateTime>(column, rows, dateTime, QDateTime());
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+
+	m_spreadsheet->endMacro();
+
+	m_valid = false;
+	return count;
+}
+
+// ##############################################################################
+// ############################## private helpers ###############################
+// ##############################################################################
+bool SpreadsheetSearch::isColumnSearchable(const Column* column) const {
+	if (m_settings.ignoreDataType)
+		return true;
+
+	bool valid = false;
+	switch (m_settings.type) {
+	case DataType::Text:
+		valid = (column->columnMode() == AbstractColumn::ColumnMode::Text);
+		break;
+	case DataType::Numeric:
+		valid = column->isNumeric();
+		break;
+	case DataType::DateTime:
+		valid = (column->columnMode() == AbstractColumn::ColumnMode::DateTime);
+		break;
+	}
+
+	return valid;
+}
+
+//! returns \c true if the index was determined for the current data in the spreadsheet
+bool SpreadsheetSearch::isCurrent() const {
+	if (!m_valid || m_spreadsheet->rowCount() != m_rowCount)
+		return false;
+
+	const auto& columns = m_spreadsheet->children<Column>();
+	if (columns.size() != m_columns.size())
+		return false;
+
+	for (int c = 0; c < columns.size(); ++c) {
+		if (columns.at(c) != m_columns.at(c) || columns.at(c)->dataVersion() != m_versions.at(c))
+			return false;
+	}
+
+	return true;
+}
+
+bool SpreadsheetSearch::matchesCell(const Column* column, int row) const {
+	Chunk chunk{column, 0, row, row + 1, {}};
+	CellMatcher matcher(m_settings);
+	if (!matcher.isValid())
+		return false;
+	matcher.match(chunk);
+	return !chunk.rows.isEmpty();
+}
+
+/*!
+ * determines the index of the matching cells if the settings or the data were changed.
+ * The columns are split into chunks of \c ChunkSize rows that are processed in parallel.
+ */
+void SpreadsheetSearch::update() {
+	if (isCurrent())
+		return;
+
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	const auto& columns = m_spreadsheet->children<Column>();
+	const int colCount = columns.size();
+	m_rowCount = m_spreadsheet->rowCount();
+	m_columns.clear();
+	m_versions.clear();
+	m_matches.clear();
+	m_matches.resize(colCount);
+	for (auto* column : columns) {
+		m_columns << column;
+		m_versions << column->dataVersion();
+	}
+	m_valid = true;
+
+	if (m_settings.pattern1.isEmpty())
+		return;
+
+	CellMatcher matcher(m_settings);
+	if (!matcher.isValid())
+		return;
+
+	QVector<Chunk> chunks;
+	for (int c = 0; c < colCount; ++c) {
+		const auto* column = columns.at(c);
+		if (!column->data() || !isColumnSearchable(column))
+			continue;
+
+		for (int first = 0; first < m_rowCount; first += ChunkSize)
+			chunks << Chunk{column, c, first, std::min(first + ChunkSize, m_rowCount), {}};
+	}
+
+	QtConcurrent::blockingMap(chunks, [&matcher](Chunk& chunk) {
+		matcher.match(chunk);
+	});
+
+	// the chunks are ordered by column and row, the rows of every column are sorted
+	for (const auto& chunk : qAsConst(chunks))
+		m_matches[chunk.columnIndex] << chunk.rows;
+}
@@ -0,0 +1,73 @@
+/*
+	File                 : SpreadsheetSearch.h
+	Project              : LabPlot
+	Description          : Search&Replace engine for the spreadsheet
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef SPREADSHEETSEARCH_H
+#define SPREADSHEETSEARCH_H
+
+#include <QDateTime>
+#include <QPointer>
+#include <QVector>
+
+class Column;
+class Spreadsheet;
+
+class SpreadsheetSearch {
+public:
+	enum class DataType { Text, Numeric, DateTime };
+	enum class Operator { EqualTo, NotEqualTo, BetweenIncl, BetweenExcl, GreaterThan, GreaterThanEqualTo, LessThan, LessThanEqualTo };
+	enum class OperatorText { EqualTo, NotEqualTo, StartsWith, EndsWith, Contain, NotContain, RegEx };
+	enum class Order { ColumnMajor, RowMajor };
+
+	struct Settings {
+		DataType type{DataType::Text};
+		OperatorText operatorText{OperatorText::EqualTo};
+		Operator operatorNumeric{Operator::EqualTo};
+		Operator operatorDateTime{Operator::EqualTo};
+		Qt::CaseSensitivity caseSensitivity{Qt::CaseInsensitive};
+		bool ignoreDataType{false}; // match the text representation of all columns ("simple search")
+		QString pattern1;
+		QString pattern2;
+		QDateTime dateTime1;
+		QDateTime dateTime2;
+
+		bool operator==(const Settings&) const;
+	};
+
+	explicit SpreadsheetSearch(Spreadsheet*);
+
+	void setSettings(const Settings&);
+	const Settings& settings() const;
+
+	int matchCount();
+	const QVector<int>& matches(int col);
+	bool isMatch(int row, int col);
+	bool findNext(int& row, int& col, Order);
+	bool findPrevious(int& row, int& col, Order);
+	void updateMatch(int row, int col);
+	int replaceAll(const QString& value, const QDateTime& dateTime = QDateTime());
+
+private:
+	Spreadsheet* m_spreadsheet;
+	Settings m_settings;
+	bool m_valid{false};
+	int m_rowCount{0};
+
+	// the match index: sorted row indices of the matching cells for every column together
+	// with the column and its data version the matches were determined for
+	QVector<QVector<int>> m_matches;
+	QVector<QPointer<Column>> m_columns;
+	QVector<quint64> m_versions;
+
+	bool isColumnSearchable(const Column*) const;
+	bool isCurrent() const;
+	void update();
+	bool matchesCell(const Column*, int row) const;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/*
+	File                 : SpreadsheetSort.cpp
+	Project              : LabPlot
+	Description          : Sort engine for the spreadsheet
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "SpreadsheetSort.h"
+#include "backend/core/column/Column.h"
+#include "backend/lib/Interval.h"
+#include "backend/lib/trace.h"
+
+#include <QDateTime>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/*!
+ * \class SpreadsheetSort
+ * \brief Sort engine for the spreadsheet.
+ *
+ * The engine determines the permutation of the rows that sorts the given key columns.
+ * The data containers of the key columns are read directly, the rows are sorted
+ * with a stable merge sort in parallel chunks. Rows with invalid or empty values
+ * in a key column are placed at the end, in the order of the remaining keys and of
+ * their original position. The permutation is applied to the columns with
+ * Column::permuteRows() and used as the undo data of the sort.
+ *
+ * \ingroup backend
+ */
+
+namespace {
+const int ChunkSize = 65536; // min. number of rows sorted or merged in one task
+
+struct Range {
+	int first;
+	int last;
+};
+
+// splits the rows into the ranges processed in parallel, one range for small data
+QVector<Range> ranges(int size) {
+	const int count = std::max(1, std::min(QThread::idealThreadCount(), size / ChunkSize));
+	QVector<Range> ranges;
+	for (int i = 0; i < count; ++i)
+		ranges << Range{static_cast<int>(static_cast<qint64>(size) * i / count), static_cast<int>(static_cast<qint64>(size) * (i + 1) / count)};
+	return ranges;
+}
+
+/*!
+ * stable sort of \c indices, the chunks are sorted in parallel and merged pairwise in parallel afterwards.
+ */
+template<typename Less>
+void stableSort(QVector<int>& indices, Less less) {
+	auto chunks = ranges(indices.size());
+	int* in = indices.data();
+	if (chunks.size() == 1) {
+		std::stable_sort(in, in + indices.size(), less);
+		return;
+	}
+
+	QtConcurrent::blockingMap(chunks, [in, &less](const Range& range) {
+		std::stable_sort(in + range.first, in + range.last, less);
+	});
+
+	QVector<int> buffer(indices.size());
+	int* out = buffer.data();
+	while (chunks.size() > 1) {
+		// std::merge() takes equal elements from the first range first and keeps the order stable
+		QVector<QPair<Range, Range>> pairs;
+		for (int i = 0; i < chunks.size(); i += 2) {
+			const auto& first = chunks.at(i);
+			const auto second = (i + 1 < chunks.size()) ? chunks.at(i + 1) : Range{first.last, first.last};
+			pairs << qMakePair(first, second);
+		}
+
+		QtConcurrent::blockingMap(pairs, [in, out, &less](const QPair<Range, Range>& pair) {
+			std::merge(in + pair.first.first, in + pair.first.last, in + pair.second.first, in + pair.second.last, out + pair.first.first, less);
+		});
+
+		chunks.clear();
+		for (const auto& pair : qAsConst(pairs))
+			chunks << Range{pair.first.first, pair.second.last};
+		std::swap(in, out);
+	}
+
+	if (in != indices.constData())
+		indices.swap(buffer);
+}
+
+/*!
+ * stable sort of \c indices by the values of one key, \c valid(row) decides whether the row has a valid value.
+ */
+template<typename T, typename Valid>
+void sortByKey(QVector<int>& indices, const T* values, Valid valid, bool ascending) {
+	stableSort(indices, [values, valid, ascending](int a, int b) {
+		const bool validA = valid(a);
+		const bool validB = valid(b);
+		if (validA != validB)
+			return validA; // invalid values are placed at the end
+		if (!validA)
+			return false;
+		return ascending ? values[a] < values[b] : values[b] < values[a];
+	});
+}
+
+void sortByKey(QVector<int>& indices, const Column* column, bool ascending) {
+	if (!column->data())
+		return; // no values, all rows are empty
+
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double: {
+		const auto* data = static_cast<const QVector<double>*>(column->data());
+		const double* values = data->constData();
+		const int size = data->size();
+		sortByKey(
+			indices,
+			values,
+			[values, size](int row) {
+				return row < size && std::isfinite(values[row]);
+			},
+			ascending);
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		const auto* data = static_cast<const QVector<int>*>(column->data());
+		const int size = data->size();
+		sortByKey(
+			indices,
+			data->constData(),
+			[size](int row) {
+				return row < size;
+			},
+			ascending);
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const auto* data = static_cast<const QVector<qint64>*>(column->data());
+		const int size = data->size();
+		sortByKey(
+			indices,
+			data->constData(),
+			[size](int row) {
+				return row < size;
+			},
+			ascending);
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		const auto* data = static_cast<const QVector<QString>*>(column->data());
+		const QString* values = data->constData();
+		const int size = data->size();
+		sortByKey(
+			indices,
+			values,
+			[values, size](int row) {
+				return row < size && !values[row].isEmpty();
+			},
+			ascending);
+		break;
+	}
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		// comparing QDateTime is expensive, the values are converted to msecs since epoch once
+		const auto* data = static_cast<const QVector<QDateTime>*>(column->data());
+		const int size = data->size();
+		QVector<qint64> msecs(size);
+		QVector<char> validRows(size);
+		qint64* msecsData = msecs.data();
+		char* valid = validRows.data();
+		auto chunks = ranges(size);
+		QtConcurrent::blockingMap(chunks, [data, msecsData, valid](const Range& range) {
+			for (int row = range.first; row < range.last; ++row) {
+				const auto& dateTime = data->at(row);
+				valid[row] = dateTime.isValid();
+				msecsData[row] = valid[row] ? dateTime.toMSecsSinceEpoch() : 0;
+			}
+		});
+
+		sortByKey(
+			indices,
+			msecs.constData(),
+			[valid, size](int row) {
+				return row < size && valid[row];
+			},
+			ascending);
+		break;
+	}
+	}
+}
+} // namespace
+
+/*!
+ * returns the permutation of the first \c rows rows that sorts the rows by the values of the columns in \c keys.
+ * The first key is the most significant one, the rows with equal keys keep their order.
+ * Row \c i of the sorted data is the row \c permutation[i] of the original data.
+ */
+QVector<int> SpreadsheetSort::permutation(const QVector<const Column*>& keys, int rows, bool ascending) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	QVector<int> indices(rows);
+	std::iota(indices.begin(), indices.end(), 0);
+
+	// stable sorts from the least to the most significant key result in the lexicographic order of the keys
+	for (int i = keys.size() - 1; i >= 0; --i)
+		sortByKey(indices, keys.at(i), ascending);
+
+	return indices;
+}
+
+bool SpreadsheetSort::isIdentity(const QVector<int>& permutation) {
+	for (int i = 0; i < permutation.size(); ++i) {
+		if (permutation.at(i) != i)
+			return false;
+	}
+	return true;
+}
+
+/*!
+ * moves the masks of the rows of \c column together with the values of the rows.
+ * Nothing is done for columns without masked rows.
+ */
+void SpreadsheetSort::permuteMasks(Column* column, const QVector<int>& permutation) {
+	const auto intervals = column->maskedIntervals();
+	if (intervals.isEmpty())
+		return;
+
+	// new position of the original rows
+	const int count = permutation.size();
+	QVector<int> position(count);
+	for (int i = 0; i < count; ++i)
+		position[permutation.at(i)] = i;
+
+	QVector<int> rows;
+	for (const auto& interval : intervals) {
+		for (int row = interval.start(); row <= interval.end(); ++row)
+			rows << (row < count ? position.at(row) : row);
+	}
+	std::sort(rows.begin(), rows.end());
+
+	column->clearMasks();
+	int first = 0;
+	for (int i = 1; i <= rows.size(); ++i) {
+		if (i == rows.size() || rows.at(i) != rows.at(i - 1) + 1) {
+			column->setMasked(Interval<int>(rows.at(first), rows.at(i - 1)));
+			first = i;
+		}
+	}
+}
@@ -0,0 +1,24 @@
+/*
+	File                 : SpreadsheetSort.h
+	Project              : LabPlot
+	Description          : Sort engine for the spreadsheet
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef SPREADSHEETSORT_H
+#define SPREADSHEETSORT_H
+
+#include <QVector>
+
+class Column;
+
+class SpreadsheetSort {
+public:
+	static QVector<int> permutation(const QVector<const Column*>& keys, int rows, bool ascending);
+	static bool isIdentity(const QVector<int>& permutation);
+	static void permuteMasks(Column*, const QVector<int>& permutation);
+};
+
+#endif
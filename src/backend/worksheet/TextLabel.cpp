@@ -33,7 +33,6 @@
 #include <QTextCharFormat>
 #include <QTextCursor>
 #include <QTextDocument>
-#include <QtConcurrent/QtConcurrentRun>
 
 #include <KConfig>
 #include <KConfigGroup>
@@ -185,7 +184,7 @@ void TextLabel::init() {
 
 	DEBUG(Q_FUNC_INFO << ", default/run time image resolution: " << d->teXImageResolution << '/' << QApplication::primaryScreen()->physicalDotsPerInchX());
 
-	connect(&d->teXImageFutureWatcher, &QFutureWatcher<QByteArray>::finished, this, &TextLabel::updateTeXImage);
+	connect(&d->teXImageFutureWatcher, &QFutureWatcher<TeXRenderer::Result>::finished, this, &TextLabel::updateTeXImage);
 }
 
 // no need to delete the d-pointer here - it inherits from QGraphicsItem
@@ -586,11 +585,13 @@ void TextLabelPrivate::updateText() {
 		format.fontSize = teXFont.pointSize();
 		format.fontFamily = teXFont.family();
 		format.dpi = teXImageResolution;
-		QFuture<QByteArray> future = QtConcurrent::run(TeXRenderer::renderImageLaTeX, textWrapper.text, &teXRenderResult, format);
+		const auto future = TeXRenderer::renderImageLaTeXCached(textWrapper.text, format);
 		teXImageFutureWatcher.setFuture(future);
 
-		// don't need to call retransform() here since it is done in updateTeXImage
-		// when the asynchronous rendering of the image is finished.
+		// the image is already available in the cache, show it immediately.
+		// Otherwise retransform() is done in updateTeXImage when the asynchronous rendering of the image is finished.
+		if (future.isFinished())
+			updateTeXImage();
 		break;
 	}
 	case TextLabel::Mode::Markdown: {
@@ -682,7 +683,12 @@ void TextLabelPrivate::updateTeXImage() {
 			return;
 		zoomFactor = worksheet->zoomFactor();
 	}
-	teXPdfData = teXImageFutureWatcher.result();
+	const auto& result = teXImageFutureWatcher.result();
+	if (!teXImage.isNull() && result.data == teXPdfData)
+		return; // cached image was already shown in updateText()
+
+	teXRenderResult = result;
+	teXPdfData = result.data;
 	teXImage = GuiTools::imageFromPDFData(teXPdfData, zoomFactor);
 	updateBoundingRect();
 	DEBUG(Q_FUNC_INFO << ", TeX renderer successful = " << teXRenderResult.successful);
@@ -42,7 +42,7 @@ public:
 	QColor backgroundColor{Qt::white}; // same as fontColor
 	QImage teXImage;
 	QByteArray teXPdfData;
-	QFutureWatcher<QByteArray> teXImageFutureWatcher;
+	QFutureWatcher<TeXRenderer::Result> teXImageFutureWatcher;
 	TeXRenderer::Result teXRenderResult;
 
 	// see TextLabel::init() for type specific default settings
@@ -933,6 +933,9 @@ void XYCurvePrivate::calculateScenePoints() {
 
 			m_pointVisible.resize(numberOfPoints);
 			q->cSystem->mapLogicalToScene(startIndex, endIndex, m_logicalPoints, m_scenePoints, m_pointVisible);
+#if PERFTRACE_CURVES
+			PERFTRACE_COUNTER("curve points mapped to scene", m_scenePoints.size());
+#endif
 			// for (auto p : m_logicalPoints)
 			//	QDEBUG(Q_FUNC_INFO << ", logical points: " << QString::number(p.x(), 'g', 12) << " = " << QDateTime::fromMSecsSinceEpoch(p.x(), Qt::UTC))
 		}
@@ -1893,7 +1893,7 @@ bool XYFitCurvePrivate::recalculateSpecific(const AbstractColumn* tmpXDataColumn
 				break;
 			}
 		} else { // spreadsheet or curve
-			norm = ((Column*)tmpYDataColumn)->statistics().arithmeticMean * xRange.size(); // integral
+			norm = ((Column*)tmpYDataColumn)->momentStatistics().arithmeticMean * xRange.size(); // integral
 		}
 		runMaximumLikelihood(tmpXDataColumn, norm);
 	}
@@ -12,7 +12,9 @@
 #include "commonfrontend/matrix/MatrixView.h"
 #include "backend/core/column/Column.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/HDF5Filter.h"
 #include "backend/matrix/Matrix.h"
+#include "backend/matrix/MatrixBuffer.h"
 #include "backend/matrix/MatrixModel.h"
 #include "backend/matrix/matrixcommands.h"
 #include "kdefrontend/matrix/MatrixFunctionDialog.h"
@@ -21,6 +23,7 @@
 #include "tools/ColorMapsManager.h"
 
 #include <KLocalizedString>
+#include <KMessageBox>
 
 #include <QAction>
 #include <QActionGroup>
@@ -32,7 +35,6 @@
 #include <QKeyEvent>
 #include <QMenu>
 #include <QMimeData>
-#include <QMutex>
 #include <QPainter>
 #include <QPrinter>
 #include <QProcess>
@@ -617,11 +619,8 @@ void MatrixView::fillWithConstValues() {
 	const double value = QInputDialog::getDouble(this, i18n("Fill the matrix with constant value"), i18n("Value"), 0, -2147483647, 2147483647, 6, &ok);
 	if (ok) {
 		WAIT_CURSOR;
-		auto* newData = static_cast<QVector<QVector<double>>*>(m_matrix->data());
-		for (int col = 0; col < m_matrix->columnCount(); ++col) {
-			for (int row = 0; row < m_matrix->rowCount(); ++row)
-				(*newData)[col][row] = value;
-		}
+		auto* newData = static_cast<MatrixBuffer<double>*>(m_matrix->data());
+		newData->fill(value);
 		m_matrix->setData(newData);
 		RESET_CURSOR;
 	}
@@ -765,38 +764,34 @@ void MatrixView::clearSelectedCells() {
 	RESET_CURSOR;
 }
 
+// colors the rows [start, end) of the image with the values of the matrix buffer \c buffer
+template<typename T>
 class UpdateImageTask : public QRunnable {
 public:
-	UpdateImageTask(int start, int end, QImage& image, const void* data, double min, double max, const QVector<QColor>& colors)
+	UpdateImageTask(int start, int end, QRgb* bits, int width, int bytesPerLine, const MatrixBuffer<T>* buffer, double min, double max, const QVector<QRgb>& colors)
 		: m_start(start)
 		, m_end(end)
+		, m_width(width)
+		, m_bytesPerLine(bytesPerLine)
 		, m_min(min)
 		, m_max(max)
-		, m_data(data)
-		, m_image(image)
+		, m_bits(bits)
+		, m_buffer(buffer)
 		, m_colors(colors) {
 	}
 
 	void run() override {
-		double range = (m_max - m_min) / m_colors.count();
-		const auto* data = static_cast<const QVector<QVector<double>>*>(m_data);
+		const double range = (m_max - m_min) / m_colors.count();
+		const QRgb invalid = qRgb(0, 0, 0);
 		for (int row = m_start; row < m_end; ++row) {
-			m_mutex.lock();
-			QRgb* line = reinterpret_cast<QRgb*>(m_image.scanLine(row));
-			m_mutex.unlock();
-
-			for (int col = 0; col < m_image.width(); ++col) {
-				const double value = (data->operator[](col))[row];
-				if (!std::isnan(value) && !std::isinf(value)) {
+			auto* line = reinterpret_cast<QRgb*>(reinterpret_cast<uchar*>(m_bits) + (size_t)row * m_bytesPerLine);
+			for (int col = 0; col < m_width; ++col) {
+				const double value = m_buffer->at(row, col);
+				if (std::isfinite(value)) {
 					const int index = range != 0 ? (value - m_min) / range : 0;
-					QColor color;
-					if (index < m_colors.count())
-						color = m_colors.at(index);
-					else
-						color = m_colors.constLast();
-					line[col] = qRgb(color.red(), color.green(), color.blue());
+					line[col] = (index < m_colors.count()) ? m_colors.at(index) : m_colors.constLast();
 				} else
-					line[col] = qRgb(0, 0, 0);
+					line[col] = invalid;
 			}
 		}
 	}
@@ -804,26 +799,28 @@ public:
 private:
 	int m_start;
 	int m_end;
+	int m_width;
+	int m_bytesPerLine;
 	double m_min;
 	double m_max;
-	const void* m_data;
-	QMutex m_mutex;
-	QImage& m_image;
-	QVector<QColor> m_colors;
+	QRgb* m_bits;
+	const MatrixBuffer<T>* m_buffer;
+	const QVector<QRgb> m_colors;
 };
 
-void MatrixView::updateImage() {
-	WAIT_CURSOR;
-	m_image = QImage(m_matrix->columnCount(), m_matrix->rowCount(), QImage::Format_ARGB32);
+/*!
+ * colors the pixels of the image \c image with the values of the matrix data \c data in multiple threads
+ */
+template<typename T>
+static void updateMatrixImage(QImage& image, const void* data, const QVector<QColor>& colors) {
+	// the image rows are filled in parallel below
+	const auto* buffer = static_cast<const MatrixBuffer<T>*>(data);
 
-	// find min/max value
+	// find min/max value, the order of the cells doesn't matter here
 	double dmax = -DBL_MAX, dmin = DBL_MAX;
-	const auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
-	const int width = m_matrix->columnCount();
-	const int height = m_matrix->rowCount();
-	for (int col = 0; col < width; ++col) {
-		for (int row = 0; row < height; ++row) {
-			const double value = (data->operator[](col))[row];
+	for (int col = 0; col < buffer->columnCount(); ++col) {
+		for (int row = 0; row < buffer->rowCount(); ++row) {
+			const double value = buffer->at(row, col);
 			if (dmax < value)
 				dmax = value;
 			if (dmin > value)
@@ -831,22 +828,55 @@ void MatrixView::updateImage() {
 		}
 	}
 
-	// update the image
-	auto* manager = ColorMapsManager::instance();
-	QPixmap pix;
-	manager->render(pix, QLatin1String("viridis100")); // dummy render to get the color vector initialized
-	const auto& colors = manager->colors();
+	QVector<QRgb> rgbColors;
+	rgbColors.reserve(colors.count());
+	for (const auto& color : colors)
+		rgbColors << qRgb(color.red(), color.green(), color.blue());
+
+	// the image is detached here once and not in the threads
+	auto* bits = reinterpret_cast<QRgb*>(image.bits());
+	const int height = image.height();
 	auto* pool = QThreadPool::globalInstance();
-	int range = ceil(double(m_image.height()) / pool->maxThreadCount());
+	const int range = std::ceil(double(height) / pool->maxThreadCount());
 	for (int i = 0; i < pool->maxThreadCount(); ++i) {
 		const int start = i * range;
-		int end = (i + 1) * range;
-		if (end > m_image.height())
-			end = m_image.height();
-		auto* task = new UpdateImageTask(start, end, m_image, data, dmin, dmax, colors);
+		const int end = std::min((i + 1) * range, height);
+		if (start >= end)
+			break;
+		auto* task = new UpdateImageTask<T>(start, end, bits, image.width(), image.bytesPerLine(), buffer, dmin, dmax, rgbColors);
 		pool->start(task);
 	}
 	pool->waitForDone();
+}
+
+void MatrixView::updateImage() {
+	WAIT_CURSOR;
+	m_image = QImage(m_matrix->columnCount(), m_matrix->rowCount(), QImage::Format_ARGB32);
+	const int width = m_matrix->columnCount();
+	const int height = m_matrix->rowCount();
+
+	// update the image
+	auto* manager = ColorMapsManager::instance();
+	QPixmap pix;
+	manager->render(pix, QLatin1String("viridis100")); // dummy render to get the color vector initialized
+	const auto& colors = manager->colors();
+	switch (m_matrix->mode()) {
+	case AbstractColumn::ColumnMode::Double:
+		updateMatrixImage<double>(m_image, m_matrix->data(), colors);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		updateMatrixImage<int>(m_image, m_matrix->data(), colors);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		updateMatrixImage<qint64>(m_image, m_matrix->data(), colors);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		m_image.fill(Qt::black);
+		break;
+	}
 
 	if (m_zoomFactor == 1.) {
 		m_imageLabel->resize(width, height);
@@ -1041,7 +1071,7 @@ void MatrixView::print(QPrinter* printer) const {
 
 	QHeaderView* hHeader = m_tableView->horizontalHeader();
 	QHeaderView* vHeader = m_tableView->verticalHeader();
-	auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const auto* data = static_cast<const MatrixBuffer<double>*>(m_matrix->data());
 
 	const int rows = m_matrix->rowCount();
 	const int cols = m_matrix->columnCount();
@@ -1054,18 +1084,17 @@ void MatrixView::print(QPrinter* printer) const {
 	int firstRowStringWidth = vertHeaderWidth;
 	bool tablesNeeded = false;
 	QVector<int> firstRowCeilSizes;
-	firstRowCeilSizes.reserve(data[0].size());
-	firstRowCeilSizes.resize(data[0].size());
+	firstRowCeilSizes.resize(cols);
 	QRect br;
 
-	for (int i = 0; i < data->size(); ++i) {
-		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(i)[0]) + QLatin1Char('\t'));
+	for (int i = 0; i < cols; ++i) {
+		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(0, i)) + QLatin1Char('\t'));
 		firstRowCeilSizes[i] = br.width() > m_tableView->columnWidth(i) ? br.width() : m_tableView->columnWidth(i);
 	}
 	const int width = printer->pageLayout().paintRectPixels(printer->resolution()).width() - 2 * margin;
 	for (int col = 0; col < cols; ++col) {
 		headerStringWidth += m_tableView->columnWidth(col);
-		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(col)[0]) + QLatin1Char('\t'));
+		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(0, col)) + QLatin1Char('\t'));
 		firstRowStringWidth += br.width();
 		if ((headerStringWidth >= width) || (firstRowStringWidth >= width)) {
 			tablesNeeded = true;
@@ -1138,7 +1167,7 @@ void MatrixView::print(QPrinter* printer) const {
 			}
 			for (; j < toJ; j++) {
 				int w = /*m_tableView->columnWidth(j)*/ firstRowCeilSizes[j];
-				cellText = QString::number(data->at(j)[i]) + QLatin1Char('\t');
+				cellText = QString::number(data->at(i, j)) + QLatin1Char('\t');
 				tr = painter.boundingRect(tr, Qt::AlignCenter, cellText);
 				br.setTopLeft(QPoint(right, height));
 				br.setWidth(w);
@@ -1174,14 +1203,14 @@ void MatrixView::exportToFile(const QString& path, const QString& separator, QLo
 	// export values
 	const int cols = m_matrix->columnCount();
 	const int rows = m_matrix->rowCount();
-	const auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const auto* data = static_cast<const MatrixBuffer<double>*>(m_matrix->data());
 	// TODO: use general setting for number locale?
 	QLocale locale(language);
 	for (int row = 0; row < rows; ++row) {
 		for (int col = 0; col < cols; ++col) {
-			out << locale.toString(data->at(col)[row], m_matrix->numericFormat(), m_matrix->precision());
+			out << locale.toString(data->at(row, col), m_matrix->numericFormat(), m_matrix->precision());
 
-			out << data->at(col)[row];
+			out << data->at(row, col);
 			if (col != cols - 1)
 				out << sep;
 		}
@@ -1549,7 +1578,7 @@ void MatrixView::showColumnStatistics() {
 		for (int col = 0; col < m_matrix->columnCount(); ++col) {
 			if (isColumnSelected(col, false)) {
 				QString headerString = m_tableView->model()->headerData(col, Qt::Horizontal).toString();
-				columns << new Column(headerString, static_cast<QVector<QVector<double>>*>(m_matrix->data())->at(col));
+				columns << new Column(headerString, static_cast<MatrixBuffer<double>*>(m_matrix->data())->column(col, 0, m_matrix->rowCount() - 1));
 			}
 		}
 		auto* dlg = new StatisticsDialog(dlgTitle, columns);
@@ -1594,3 +1623,26 @@ void MatrixView::exportToFits(const QString& fileName, const int exportTo) const
 	filter->write(fileName, m_matrix);
 	delete filter;
 }
+
+void MatrixView::exportToBinary(const QString& fileName, BinaryFilter::DataType dataType, QDataStream::ByteOrder byteOrder) const {
+	BinaryFilter filter;
+	filter.setDataType(dataType);
+	filter.setByteOrder(byteOrder);
+	filter.writeInBackground(fileName, m_matrix);
+	const auto& errors = filter.lastErrors();
+	if (!errors.isEmpty()) {
+		RESET_CURSOR;
+		KMessageBox::error(nullptr, errors.join(QLatin1Char('\n')));
+	}
+}
+
+void MatrixView::exportToHDF5(const QString& fileName, int compressionLevel) const {
+	HDF5Filter filter;
+	filter.setCompressionLevel(compressionLevel);
+	filter.writeInBackground(fileName, m_matrix);
+	const auto& errors = filter.lastErrors();
+	if (!errors.isEmpty()) {
+		RESET_CURSOR;
+		KMessageBox::error(nullptr, errors.join(QLatin1Char('\n')));
+	}
+}
@@ -11,6 +11,8 @@
 #ifndef MATRIXVIEW_H
 #define MATRIXVIEW_H
 
+#include "backend/datasources/filters/BinaryFilter.h"
+
 #include <QLocale>
 #include <QWidget>
 
@@ -57,6 +59,8 @@ public:
 					   const bool entire,
 					   const bool captions) const;
 	void exportToFits(const QString& fileName, const int exportTo) const;
+	void exportToBinary(const QString& fileName, BinaryFilter::DataType, QDataStream::ByteOrder) const;
+	void exportToHDF5(const QString& fileName, int compressionLevel) const;
 
 public Q_SLOTS:
 	void createContextMenu(QMenu*);
@@ -18,7 +18,10 @@
 #include "backend/core/datatypes/SimpleCopyThroughFilter.h"
 #include "backend/core/datatypes/String2DateTimeFilter.h"
 #include "backend/core/datatypes/String2DoubleFilter.h"
+#include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/HDF5Filter.h"
+#include "backend/datasources/filters/SQLFilter.h"
 #include "backend/datasources/filters/XLSXFilter.h"
 #include "backend/lib/macros.h"
 #include "backend/lib/trace.h"
@@ -70,12 +73,10 @@
 #include <QPrintPreviewDialog>
 #include <QPrinter>
 #include <QProcess>
+#include <QProgressDialog>
 #include <QRandomGenerator>
 #include <QRegularExpression>
 #include <QScrollBar>
-#include <QSqlDatabase>
-#include <QSqlError>
-#include <QSqlQuery>
 #include <QTableView>
 #include <QTextStream>
 #include <QTimer>
@@ -3481,7 +3482,7 @@ void SpreadsheetView::sortCustom() {
 		col->setSuppressDataChangedSignal(true);
 
 	auto* dlg = new SortDialog(this, sortAll);
-	connect(dlg, &SortDialog::sort, m_spreadsheet, &Spreadsheet::sortColumns);
+	connect(dlg, &SortDialog::sort, m_spreadsheet, QOverload<Column*, const QVector<Column*>&, bool>::of(&Spreadsheet::sortColumns));
 	dlg->setColumns(columnsToSort, leadingColumn);
 
 	int rc = dlg->exec();
@@ -3665,6 +3666,12 @@ bool SpreadsheetView::exportView() {
 		case ExportSpreadsheetDialog::Format::SQLite:
 			exportToSQLite(path);
 			break;
+		case ExportSpreadsheetDialog::Format::Binary:
+			exportToBinary(path, dlg->binaryDataType(), dlg->binaryByteOrder());
+			break;
+		case ExportSpreadsheetDialog::Format::HDF5:
+			exportToHDF5(path, dlg->compressionLevel());
+			break;
 		}
 		RESET_CURSOR;
 	}
@@ -4261,121 +4268,51 @@ void SpreadsheetView::exportToXLSX(const QString& fileName, const bool exportHea
 	delete filter;
 }
 
-void SpreadsheetView::exportToSQLite(const QString& path) const {
-	QFile file(path);
-	if (!file.open(QFile::WriteOnly | QFile::Truncate))
-		return;
-
-	PERFTRACE(QStringLiteral("export spreadsheet to SQLite database"));
-	QApplication::processEvents(QEventLoop::AllEvents, 0);
-
-	// create database
-	const QStringList& drivers = QSqlDatabase::drivers();
-	QString driver;
-	if (drivers.contains(QLatin1String("QSQLITE3")))
-		driver = QLatin1String("QSQLITE3");
-	else
-		driver = QLatin1String("QSQLITE");
-
-	QSqlDatabase db = QSqlDatabase::addDatabase(driver);
-	db.setDatabaseName(path);
-	if (!db.open()) {
+/*!
+ * writes \c spreadsheet to the file \c fileName with \c filter in a separate thread,
+ * shows the progress with the label \c text and the errors afterwards.
+ */
+static void writeInBackground(AbstractFileFilter& filter, const QString& fileName, Spreadsheet* spreadsheet, const QString& text) {
+	QProgressDialog progressDialog(text, QString(), 0, 100);
+	progressDialog.setWindowModality(Qt::ApplicationModal);
+	progressDialog.setMinimumDuration(500);
+	QObject::connect(&filter, &AbstractFileFilter::completed, &progressDialog, &QProgressDialog::setValue);
+
+	filter.writeInBackground(fileName, spreadsheet);
+	const auto& errors = filter.lastErrors();
+	if (!errors.isEmpty()) {
 		RESET_CURSOR;
-		KMessageBox::error(nullptr, i18n("Couldn't create the SQLite database %1.", path));
+		KMessageBox::error(nullptr, errors.join(QLatin1Char('\n')));
 	}
+}
 
-	// create table
-	const int cols = m_spreadsheet->columnCount();
-	QString query = QLatin1String("create table ") + m_spreadsheet->name() + QLatin1String(" (");
-	for (int i = 0; i < cols; ++i) {
-		Column* col = m_spreadsheet->column(i);
-		if (i != 0)
-			query += QLatin1String(", ");
+void SpreadsheetView::exportToBinary(const QString& fileName, BinaryFilter::DataType dataType, QDataStream::ByteOrder byteOrder) const {
+	PERFTRACE(QStringLiteral("export spreadsheet to binary file"));
+	BinaryFilter filter;
+	filter.setDataType(dataType);
+	filter.setByteOrder(byteOrder);
+	writeInBackground(filter, fileName, m_spreadsheet, i18n("Exporting to binary file..."));
+}
 
-		query += QLatin1String("\"") + col->name() + QLatin1String("\" ");
-		switch (col->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-			query += QLatin1String("REAL");
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-		case AbstractColumn::ColumnMode::BigInt:
-			query += QLatin1String("INTEGER");
-			break;
-		case AbstractColumn::ColumnMode::Text:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::DateTime:
-			query += QLatin1String("TEXT");
-			break;
-		}
-	}
-	query += QLatin1Char(')');
-	QSqlQuery q;
-	if (!q.exec(query)) {
-		RESET_CURSOR;
-		KMessageBox::error(nullptr, i18n("Failed to create table in the SQLite database %1.", path) + QLatin1Char('\n') + q.lastError().databaseText());
-		db.close();
-		return;
-	}
+void SpreadsheetView::exportToHDF5(const QString& fileName, int compressionLevel) const {
+	PERFTRACE(QStringLiteral("export spreadsheet to HDF5 file"));
+	HDF5Filter filter;
+	filter.setCompressionLevel(compressionLevel);
+	writeInBackground(filter, fileName, m_spreadsheet, i18n("Exporting to HDF5 file..."));
+}
 
-	int maxRow = maxRowToExport();
-	if (maxRow < 0) {
-		db.close();
+void SpreadsheetView::exportToSQLite(const QString& path) const {
+	QFile file(path);
+	if (!file.open(QFile::WriteOnly | QFile::Truncate))
 		return;
-	}
+	file.close();
 
-	// create bulk insert statement in batches of 10k rows
-	{
-		PERFTRACE(QStringLiteral("Insert the data"));
-		q.exec(QLatin1String("BEGIN TRANSACTION;"));
-
-		// create the first part of the INSERT-statement without the values
-		QString insertQuery = QStringLiteral("INSERT INTO '") + m_spreadsheet->name() + QStringLiteral("' (");
-		for (int i = 0; i < cols; ++i) {
-			if (i != 0)
-				insertQuery += QLatin1String(", ");
-			insertQuery += QLatin1Char('\'') + m_spreadsheet->column(i)->name() + QLatin1Char('\'');
-		}
-		insertQuery += QLatin1String(") VALUES ");
-
-		// add values in chunks of 10k row
-		int chunkSize = 10000;
-		int chunks = std::ceil((double)maxRow / chunkSize);
-		for (int chunk = 0; chunk < chunks; ++chunk) {
-			query = insertQuery;
-			for (int i = 0; i < chunkSize; ++i) {
-				int row = chunk * chunkSize + i;
-				if (row > maxRow)
-					break;
-
-				if (i != 0)
-					query += QLatin1String(",");
-
-				query += QLatin1Char('(');
-				for (int j = 0; j < cols; ++j) {
-					auto* col = m_spreadsheet->column(j);
-					if (j != 0)
-						query += QLatin1String(", ");
-
-					query += QLatin1Char('\'') + col->asStringColumn()->textAt(row) + QLatin1Char('\'');
-				}
-				query += QLatin1String(")");
-			}
-			query += QLatin1Char(';');
-
-			// insert values for the current chunk of data
-			if (!q.exec(query)) {
-				RESET_CURSOR;
-				KMessageBox::error(nullptr, i18n("Failed to insert values into the table."));
-				QDEBUG(Q_FUNC_INFO << ", bulk insert error " << q.lastError().databaseText());
-				db.close();
-				return;
-			}
-		}
-
-	} // end of perf-trace scope
+	PERFTRACE(QStringLiteral("export spreadsheet to SQLite database"));
+	const int maxRow = maxRowToExport();
+	if (maxRow < 0)
+		return;
 
-	// commit the transaction and close the database
-	q.exec(QLatin1String("COMMIT TRANSACTION;"));
-	db.close();
+	SQLFilter filter;
+	filter.setEndRow(maxRow + 1);
+	writeInBackground(filter, path, m_spreadsheet, i18n("Exporting to SQLite database..."));
 }
@@ -14,6 +14,7 @@
 #include <QWidget>
 
 #include "backend/core/AbstractColumn.h"
+#include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/lib/IntervalAttribute.h"
 #include <QLocale>
 
@@ -90,6 +91,8 @@ private:
 	void exportToFits(const QString& path, int exportTo, bool commentsAsUnits) const;
 	void exportToXLSX(const QString& path, bool exportHeaders) const;
 	void exportToSQLite(const QString& path) const;
+	void exportToBinary(const QString& path, BinaryFilter::DataType, QDataStream::ByteOrder) const;
+	void exportToHDF5(const QString& path, int compressionLevel) const;
 	int maxRowToExport() const;
 	bool hasValues(const QVector<Column*>);
 
@@ -12,6 +12,7 @@
 #include "backend/core/AbstractColumn.h"
 #include "backend/core/Settings.h"
 #include "backend/lib/macros.h"
+#include "backend/lib/trace.h"
 
 #include <KAboutData>
 #include <KColorSchemeManager>
@@ -133,12 +134,22 @@ int main(int argc, char* argv[]) {
 	QCommandLineOption presenterOption(QStringLiteral("presenter"), i18n("Start in the presenter mode"));
 	parser.addOption(presenterOption);
 
+	QCommandLineOption traceOption(QStringLiteral("trace"),
+								   i18n("Trace the performance and write the trace to the file (Chrome trace event format) or to stdout if '-' is given"),
+								   QStringLiteral("file"));
+	parser.addOption(traceOption);
+
 	parser.addPositionalArgument(QStringLiteral("+[file]"), i18n("Open a project file."));
 
 	aboutData.setupCommandLine(&parser);
 	parser.process(app);
 	aboutData.processCommandLine(&parser);
 
+	if (parser.isSet(traceOption)) {
+		const QString& traceFileName = parser.value(traceOption);
+		Trace::start(traceFileName == QLatin1String("-") ? QString() : QDir().absoluteFilePath(traceFileName));
+	}
+
 	const QStringList args = parser.positionalArguments();
 	QString filename;
 	if (args.count() > 0)
@@ -237,5 +248,7 @@ int main(int argc, char* argv[]) {
 	if (parser.isSet(presenterOption))
 		window->showPresenter();
 
-	return app.exec();
+	const int result = app.exec();
+	Trace::stop();
+	return result;
 }
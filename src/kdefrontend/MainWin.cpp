@@ -716,6 +716,11 @@ void MainWin::initActions() {
 	actionCollection()->addAction(QLatin1String("new_live_datasource"), m_newLiveDataSourceAction);
 	connect(m_newLiveDataSourceAction, &QAction::triggered, this, &MainWin::newLiveDataSource);
 
+	m_newSqlDataSourceAction = new QAction(QIcon::fromTheme(QLatin1String("network-server-database")), i18n("Live Data Source from SQL Database..."), this);
+	m_newSqlDataSourceAction->setWhatsThis(i18n("Creates a live data source to read the rows added to a table of a SQL database"));
+	actionCollection()->addAction(QLatin1String("new_sql_datasource"), m_newSqlDataSourceAction);
+	connect(m_newSqlDataSourceAction, &QAction::triggered, this, &MainWin::newSqlDataSource);
+
 	// Import/Export
 	m_importFileAction = new QAction(QIcon::fromTheme(QLatin1String("document-import")), i18n("From File..."), this);
 	actionCollection()->setDefaultShortcut(m_importFileAction, Qt::CTRL | Qt::SHIFT | Qt::Key_I);
@@ -943,6 +948,7 @@ void MainWin::initMenus() {
 	m_newMenu->addAction(m_newDatapickerAction);
 	m_newMenu->addSeparator();
 	m_newMenu->addAction(m_newLiveDataSourceAction);
+	m_newMenu->addAction(m_newSqlDataSourceAction);
 
 	// import menu
 	m_importMenu = new QMenu(this);
@@ -2870,6 +2876,19 @@ void MainWin::newLiveDataSource() {
 	delete dlg;
 }
 
+/*!
+  adds a new live data source reading from a SQL database to the current project.
+*/
+void MainWin::newSqlDataSource() {
+	auto* dlg = new ImportSQLDatabaseDialog(this, true);
+	if (dlg->exec() == QDialog::Accepted) {
+		auto* dataSource = new LiveDataSource(i18n("Live data source%1", 1), false);
+		dlg->importToLiveDataSource(dataSource, statusBar());
+		addAspectToProject(dataSource);
+	}
+	delete dlg;
+}
+
 void MainWin::addAspectToProject(AbstractAspect* aspect) {
 	const QModelIndex& index = m_projectExplorer->currentIndex();
 	if (index.isValid()) {
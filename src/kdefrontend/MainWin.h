@@ -155,6 +155,7 @@ private:
 	QAction* m_newWorksheetAction;
 	QAction* m_newNotesAction;
 	QAction* m_newLiveDataSourceAction;
+	QAction* m_newSqlDataSourceAction;
 	QAction* m_newProjectAction;
 	QAction* m_openProjectAction;
 	QAction* m_historyAction;
@@ -274,6 +275,7 @@ private Q_SLOTS:
 	void newNotes();
 	void newDatapicker();
 	void newLiveDataSource();
+	void newSqlDataSource();
 
 	void createContextMenu(QMenu*) const;
 	void createFolderContextMenu(const Folder*, QMenu*) const;
@@ -543,6 +543,8 @@ void ImportFileDialog::checkOkButton() {
 #endif
 		break;
 	}
+	case LiveDataSource::SourceType::Database: // live data from SQL databases is not imported via this dialog
+		break;
 	}
 }
 
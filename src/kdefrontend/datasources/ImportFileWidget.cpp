@@ -135,6 +135,12 @@ ImportFileWidget::ImportFileWidget(QWidget* parent, bool liveDataSource, const Q
 	} else { // Live data source
 		ui.cbFileType->addItem(i18n("ASCII Data"), static_cast<int>(AbstractFileFilter::FileType::Ascii));
 		ui.cbFileType->addItem(i18n("Binary Data"), static_cast<int>(AbstractFileFilter::FileType::Binary));
+#ifdef HAVE_HDF5
+		ui.cbFileType->addItem(i18n("Hierarchical Data Format 5 (HDF5)"), static_cast<int>(AbstractFileFilter::FileType::HDF5));
+#endif
+#ifdef HAVE_NETCDF
+		ui.cbFileType->addItem(i18n("Network Common Data Format (NetCDF)"), static_cast<int>(AbstractFileFilter::FileType::NETCDF));
+#endif
 #ifdef HAVE_ZIP
 		ui.cbFileType->addItem(i18n("ROOT (CERN)"), static_cast<int>(AbstractFileFilter::FileType::ROOT));
 #endif
@@ -636,6 +642,7 @@ void ImportFileWidget::saveSettings(LiveDataSource* source) const {
 		source->setSerialPort(ui.cbSerialPort->currentText());
 		break;
 	case LiveDataSource::SourceType::MQTT:
+	case LiveDataSource::SourceType::Database: // live data from SQL databases is not imported via this dialog
 		break;
 	}
 
@@ -897,6 +904,8 @@ AbstractFileFilter* ImportFileWidget::currentFileFilter() const {
 
 		break;
 	}
+	case AbstractFileFilter::FileType::SQL: // databases are imported in ImportSQLDatabaseWidget
+		break;
 	}
 
 	return m_currentFilter.get();
@@ -1218,6 +1227,8 @@ void ImportFileWidget::fileTypeChanged(int /*index*/) {
 		ui.tabWidget->removeTab(0);
 		ui.tabWidget->setCurrentIndex(0);
 		break;
+	case AbstractFileFilter::FileType::SQL:
+		break;
 	}
 
 	// update header specific options that are available for some filter types
@@ -1254,9 +1265,11 @@ void ImportFileWidget::fileTypeChanged(int /*index*/) {
 			updateContent(file);
 	}
 
-	// for file types other than ASCII and binary we support re-reading the whole file only
+	// for file types other than ASCII, binary, HDF5 and NetCDF we support re-reading the whole file only
 	// select "read whole file" and deactivate the combobox
-	if (m_liveDataSource && (fileType != AbstractFileFilter::FileType::Ascii && fileType != AbstractFileFilter::FileType::Binary)) {
+	if (m_liveDataSource
+		&& (fileType != AbstractFileFilter::FileType::Ascii && fileType != AbstractFileFilter::FileType::Binary && fileType != AbstractFileFilter::FileType::HDF5
+			&& fileType != AbstractFileFilter::FileType::NETCDF)) {
 		ui.cbReadingType->setCurrentIndex(static_cast<int>(LiveDataSource::ReadingType::WholeFile));
 		ui.cbReadingType->setEnabled(false);
 	} else
@@ -1394,6 +1407,7 @@ void ImportFileWidget::initOptionsWidget() {
 		break;
 	case AbstractFileFilter::FileType::Spice:
 	case AbstractFileFilter::FileType::READSTAT:
+	case AbstractFileFilter::FileType::SQL:
 		break;
 	}
 }
@@ -1556,6 +1570,8 @@ QString ImportFileWidget::fileInfoString(const QString& name) const {
 		case AbstractFileFilter::FileType::MATIO:
 			infoStrings << MatioFilter::fileInfoString(fileName);
 			break;
+		case AbstractFileFilter::FileType::SQL:
+			break;
 		}
 
 		infoString += infoStrings.join(QLatin1String("<br>"));
@@ -1725,6 +1741,8 @@ void ImportFileWidget::refreshPreview() {
 #endif
 			break;
 		}
+		case LiveDataSource::SourceType::Database:
+			break;
 		}
 
 		vectorNameList = filter->vectorNames();
@@ -1872,6 +1890,8 @@ void ImportFileWidget::refreshPreview() {
 		tmpTableWidget = m_matioOptionsWidget->previewWidget();
 		break;
 	}
+	case AbstractFileFilter::FileType::SQL:
+		break;
 	}
 	QDEBUG(Q_FUNC_INFO << ", imported strings =" << importedStrings)
 
@@ -1997,6 +2017,7 @@ void ImportFileWidget::updateContent(const QString& fileName) {
 		case AbstractFileFilter::FileType::Spice:
 		case AbstractFileFilter::FileType::READSTAT:
 		case AbstractFileFilter::FileType::VECTOR_BLF:
+		case AbstractFileFilter::FileType::SQL:
 			break;
 		}
 	}
@@ -2245,6 +2266,8 @@ void ImportFileWidget::sourceTypeChanged(int idx) {
 		mqttConnectionChanged();
 #endif
 		break;
+	case LiveDataSource::SourceType::Database: // not available in the file widget
+		break;
 	}
 
 	// deactivate/activate options that are specific to file of pipe sources only
@@ -12,6 +12,7 @@
 #include "backend/core/AspectTreeModel.h"
 #include "backend/core/Settings.h"
 #include "backend/core/Workbook.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -34,14 +35,17 @@
 
 	\ingroup kdefrontend
  */
-ImportSQLDatabaseDialog::ImportSQLDatabaseDialog(MainWin* parent)
+ImportSQLDatabaseDialog::ImportSQLDatabaseDialog(MainWin* parent, bool liveDataSource)
 	: ImportDialog(parent)
-	, importSQLDatabaseWidget(new ImportSQLDatabaseWidget(this)) {
+	, importSQLDatabaseWidget(new ImportSQLDatabaseWidget(this, liveDataSource)) {
 	vLayout->addWidget(importSQLDatabaseWidget);
 
-	setWindowTitle(i18nc("@title:window", "Import Data to Spreadsheet or Matrix"));
+	if (!liveDataSource) {
+		setWindowTitle(i18nc("@title:window", "Import Data to Spreadsheet or Matrix"));
+		setModel();
+	} else
+		setWindowTitle(i18nc("@title:window", "Add New Live Data Source"));
 	setWindowIcon(QIcon::fromTheme(QStringLiteral("document-import-database")));
-	setModel();
 
 	// dialog buttons
 	auto* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
@@ -71,6 +75,31 @@ ImportSQLDatabaseDialog::~ImportSQLDatabaseDialog() {
 	KWindowConfig::saveWindowSize(windowHandle(), conf);
 }
 
+/*!
+  triggers the initial read of the live data source \c source reading from the selected table or custom query
+*/
+void ImportSQLDatabaseDialog::importToLiveDataSource(LiveDataSource* source, QStatusBar* statusBar) const {
+	DEBUG(Q_FUNC_INFO);
+	importSQLDatabaseWidget->saveSettings(source);
+
+	// show a progress bar in the status bar
+	auto* progressBar = new QProgressBar();
+	progressBar->setRange(0, 100);
+	connect(source->filter(), &AbstractFileFilter::completed, progressBar, &QProgressBar::setValue);
+
+	statusBar->clearMessage();
+	statusBar->addWidget(progressBar, 1);
+	WAIT_CURSOR;
+
+	QElapsedTimer timer;
+	timer.start();
+	source->read();
+	statusBar->showMessage(i18n("Live data source created in %1 seconds.", (float)timer.elapsed() / 1000));
+
+	RESET_CURSOR;
+	statusBar->removeWidget(progressBar);
+}
+
 void ImportSQLDatabaseDialog::importTo(QStatusBar* statusBar) const {
 	DEBUG("ImportSQLDatabaseDialog::import()");
 	AbstractAspect* aspect = static_cast<AbstractAspect*>(cbAddTo->currentModelIndex().internalPointer());
@@ -130,8 +159,9 @@ QString ImportSQLDatabaseDialog::selectedObject() const {
 void ImportSQLDatabaseDialog::checkOkButton() {
 	DEBUG("ImportSQLDatabaseDialog::checkOkButton()");
 
-	AbstractAspect* aspect = static_cast<AbstractAspect*>(cbAddTo->currentModelIndex().internalPointer());
-	if (!aspect) {
+	// no target container is selected when a live data source is being added
+	AbstractAspect* aspect = cbAddTo ? static_cast<AbstractAspect*>(cbAddTo->currentModelIndex().internalPointer()) : nullptr;
+	if (cbAddTo && !aspect) {
 		okButton->setEnabled(false);
 		okButton->setToolTip(i18n("Select a data container where the data has to be imported into."));
 		cbPosition->setEnabled(false);
@@ -142,7 +172,8 @@ void ImportSQLDatabaseDialog::checkOkButton() {
 	if (!importSQLDatabaseWidget->isValid()) {
 		okButton->setEnabled(false);
 		okButton->setToolTip(i18n("Select a valid database object (table or query result set) that has to be imported."));
-		cbPosition->setEnabled(false);
+		if (cbPosition)
+			cbPosition->setEnabled(false);
 		return;
 	}
 
@@ -156,5 +187,6 @@ void ImportSQLDatabaseDialog::checkOkButton() {
 
 	okButton->setEnabled(true);
 	okButton->setToolTip(i18n("Close the dialog and import the data."));
-	cbPosition->setEnabled(true);
+	if (cbPosition)
+		cbPosition->setEnabled(true);
 }
@@ -13,6 +13,7 @@
 #include "kdefrontend/datasources/ImportDialog.h"
 
 class ImportSQLDatabaseWidget;
+class LiveDataSource;
 class MainWin;
 class QStatusBar;
 
@@ -20,9 +21,10 @@ class ImportSQLDatabaseDialog : public ImportDialog {
 	Q_OBJECT
 
 public:
-	explicit ImportSQLDatabaseDialog(MainWin*);
+	explicit ImportSQLDatabaseDialog(MainWin*, bool liveDataSource = false);
 	~ImportSQLDatabaseDialog() override;
 
+	void importToLiveDataSource(LiveDataSource*, QStatusBar*) const;
 	void importTo(QStatusBar*) const override;
 	QString selectedObject() const override;
 
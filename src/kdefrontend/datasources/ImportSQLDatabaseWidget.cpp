@@ -13,6 +13,8 @@
 #include "DatabaseManagerWidget.h"
 #include "backend/core/Settings.h"
 #include "backend/datasources/AbstractDataSource.h"
+#include "backend/datasources/LiveDataSource.h"
+#include "backend/datasources/filters/SQLFilter.h"
 #include "backend/lib/macros.h"
 #include "kdefrontend/GuiTools.h"
 
@@ -28,15 +30,15 @@
 
 #include <QFile>
 #include <QSqlError>
+#include <QSqlIndex>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QStandardItem>
 #include <QTimer>
 
-#include <cmath>
-
-ImportSQLDatabaseWidget::ImportSQLDatabaseWidget(QWidget* parent)
-	: QWidget(parent) {
+ImportSQLDatabaseWidget::ImportSQLDatabaseWidget(QWidget* parent, bool liveDataSource)
+	: QWidget(parent)
+	, m_liveDataSource(liveDataSource) {
 	ui.setupUi(this);
 
 	ui.cbImportFrom->addItem(i18n("Table"));
@@ -50,6 +52,15 @@ ImportSQLDatabaseWidget::ImportSQLDatabaseWidget(QWidget* parent)
 	ui.cbDecimalSeparator->addItem(i18n("Comma ','"));
 	ui.cbDateTimeFormat->addItems(AbstractColumn::dateTimeFormats());
 
+	// the key column and the update interval are only relevant for live data sources
+	ui.lKeyColumn->setVisible(liveDataSource);
+	ui.cbKeyColumn->setVisible(liveDataSource);
+	ui.lUpdateInterval->setVisible(liveDataSource);
+	ui.sbUpdateInterval->setVisible(liveDataSource);
+	const QString textKeyColumn = i18n("Column with increasing values, e.g. an auto-incremented ID or a timestamp, used to determine the rows added since the last read.");
+	ui.lKeyColumn->setToolTip(textKeyColumn);
+	ui.cbKeyColumn->setToolTip(textKeyColumn);
+
 	const QString textNumberFormatShort = i18n("This option determines how the imported strings have to be converted to numbers.");
 	const QString textNumberFormat = textNumberFormatShort + QStringLiteral("<br><br>")
 		+ i18n("When point character is used for the decimal separator, the valid number representations are:"
@@ -123,7 +134,7 @@ ImportSQLDatabaseWidget::ImportSQLDatabaseWidget(QWidget* parent)
 												   : m_repository.defaultTheme(KSyntaxHighlighting::Repository::LightTheme));
 #endif
 
-	m_configPath = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation).constFirst() + QStringLiteral("sql_connections");
+	m_configPath = SQLFilter::connectionsConfigPath();
 
 	connect(ui.cbConnection, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ImportSQLDatabaseWidget::connectionChanged);
 	connect(ui.cbImportFrom, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ImportSQLDatabaseWidget::importFromChanged);
@@ -156,6 +167,7 @@ void ImportSQLDatabaseWidget::loadSettings() {
 	ui.cbDecimalSeparator->setCurrentIndex(config.readEntry("DecimalSeparator", index));
 
 	ui.cbDateTimeFormat->setCurrentText(config.readEntry("DateTimeFormat", "yyyy-dd-MM hh:mm:ss:zzz"));
+	ui.sbUpdateInterval->setValue(config.readEntry("UpdateInterval", 1000));
 	QList<int> defaultSizes{100, 100};
 	ui.splitterMain->setSizes(config.readEntry("SplitterMainSizes", defaultSizes));
 	ui.splitterPreview->setSizes(config.readEntry("SplitterPreviewSizes", defaultSizes));
@@ -173,6 +185,8 @@ ImportSQLDatabaseWidget::~ImportSQLDatabaseWidget() {
 	config.writeEntry("ImportFrom", ui.cbImportFrom->currentIndex());
 	config.writeEntry("DecimalSeparator", ui.cbDecimalSeparator->currentIndex());
 	config.writeEntry("DateTimeFormat", ui.cbDateTimeFormat->currentText());
+	if (m_liveDataSource)
+		config.writeEntry("UpdateInterval", ui.sbUpdateInterval->value());
 	config.writeEntry("SplitterMainSizes", ui.splitterMain->sizes());
 	config.writeEntry("SplitterPreviewSizes", ui.splitterPreview->sizes());
 }
@@ -387,6 +401,23 @@ void ImportSQLDatabaseWidget::refreshPreview() {
 
 	ui.twPreview->horizontalHeader()->resizeSections(QHeaderView::ResizeToContents);
 
+	if (m_liveDataSource) {
+		// select the primary key of the table as the key column if it consists of one column only
+		const QString& key = ui.cbKeyColumn->currentText();
+		ui.cbKeyColumn->clear();
+		ui.cbKeyColumn->addItem(i18n("None"), QString());
+		for (const auto& name : qAsConst(m_columnNames))
+			ui.cbKeyColumn->addItem(name, name);
+
+		int index = ui.cbKeyColumn->findText(key);
+		if (index == -1 && !customQuery) {
+			const auto& primaryIndex = m_db.primaryIndex(ui.lwTables->currentItem()->text());
+			if (primaryIndex.count() == 1)
+				index = ui.cbKeyColumn->findText(primaryIndex.fieldName(0));
+		}
+		ui.cbKeyColumn->setCurrentIndex(std::max(index, 0));
+	}
+
 	setValid();
 
 	if (numeric != m_numeric) {
@@ -419,185 +450,73 @@ void ImportSQLDatabaseWidget::read(AbstractDataSource* dataSource, AbstractFileF
 	if (!dataSource)
 		return;
 
-	// execute the current query and determine the start/end rows and columns to read
-	QSqlQuery q;
-	if (!prepareAndExecute(q) || m_actualRows == 0) {
+	WAIT_CURSOR;
+	SQLFilter filter;
+	if (!initFilter(filter)) {
 		RESET_CURSOR;
 		return;
 	}
 
-	// pointers to the actual data containers
-	// columnOffset indexes the "start column" in the datasource. Data will be imported starting from this column.
-	std::vector<void*> dataContainer;
-	const int columnOffset = dataSource->prepareImport(dataContainer, importMode, m_actualRows, m_actualCols, m_actualColumnNames, m_actualColumnModes);
-
-	// number and DateTime formatting
-	const auto& dateTimeFormat = ui.cbDateTimeFormat->currentText();
+	connect(&filter, &SQLFilter::completed, this, &ImportSQLDatabaseWidget::completed);
+	filter.readDataFromDatabase(m_db, dataSource, importMode);
 
-	// TODO: use general setting for decimal separator?
-	QLocale::Language lang;
-	if (ui.cbDecimalSeparator->currentIndex() == 0)
-		lang = QLocale::Language::C;
-	else
-		lang = QLocale::Language::German;
-	const QLocale numberFormat = QLocale(lang);
-
-	// read the data
-	int progressIndex = 0;
-	const qreal progressInterval = 0.01 * m_actualRows; // update on every 1% only
-	int rowIndex = 0;
-	while (q.next()) {
-		if (rowIndex < m_startRow) {
-			++rowIndex;
-			continue;
-		}
-
-		if (rowIndex > m_endRow)
-			break;
-
-		for (int colIndex = m_startCol; colIndex <= m_endCol; ++colIndex) {
-			const auto& valueString = q.value(colIndex).toString();
-			const int col = colIndex - m_startCol;
-			const int row = rowIndex - m_startRow;
-
-			// set the value depending on the data type
-			switch (m_actualColumnModes.at(col)) {
-			case AbstractColumn::ColumnMode::Double: {
-				bool isNumber;
-				const double value = numberFormat.toDouble(valueString, &isNumber);
-				static_cast<QVector<double>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::Integer: {
-				bool isNumber;
-				const int value = numberFormat.toInt(valueString, &isNumber);
-				static_cast<QVector<int>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::BigInt: {
-				bool isNumber;
-				const qint64 value = numberFormat.toLongLong(valueString, &isNumber);
-				static_cast<QVector<qint64>*>(dataContainer[col])->operator[](row) = (isNumber ? value : NAN);
-				break;
-			}
-			case AbstractColumn::ColumnMode::DateTime: {
-				const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-				static_cast<QVector<QDateTime>*>(dataContainer[col])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
-				break;
-			}
-			case AbstractColumn::ColumnMode::Text:
-				static_cast<QVector<QString>*>(dataContainer[col])->operator[](row) = valueString;
-				break;
-			case AbstractColumn::ColumnMode::Month: // never happens
-			case AbstractColumn::ColumnMode::Day:
-				break;
-			}
-		}
-
-		++rowIndex;
-
-		// ask to update the progress bar only if we have more than 1000 lines and only in 1% steps
-		progressIndex++;
-		if (m_actualRows > 1000 && progressIndex > progressInterval) {
-			double value = 100. * rowIndex / m_actualRows;
-			Q_EMIT completed(static_cast<int>(value));
-			progressIndex = 0;
-			QApplication::processEvents(QEventLoop::AllEvents, 0);
-		}
-	}
-	DEBUG("	Read " << rowIndex << " rows");
-
-	dataSource->finalizeImport(columnOffset, 1, m_actualCols, dateTimeFormat, importMode);
+	const auto& errors = filter.lastErrors();
+	if (!errors.isEmpty()) {
+		setInvalid();
+		Q_EMIT error(errors.join(QLatin1Char('\n')));
+	} else
+		Q_EMIT error(QString());
 
-	Q_EMIT error(QString());
 	RESET_CURSOR;
 }
 
-bool ImportSQLDatabaseWidget::prepareAndExecute(QSqlQuery& q) {
-	// when reading from a table, the total number of rows to be read is determined below
-	// via a SELECT COUNT(*) statement and we don't need to navigate back and forth in the resultset.
-	// So, in this case we can use QSqlQuery::setForwardOnly() to reduce the memory consumption
-	const bool customQuery = (ui.cbImportFrom->currentIndex() != 0);
-	if (!customQuery)
-		q.setForwardOnly(true);
-
-	WAIT_CURSOR;
-	q.prepare(currentQuery());
-	if (!q.exec() || !q.isActive()) {
-		RESET_CURSOR;
-		if (!q.lastError().databaseText().isEmpty())
-			Q_EMIT error(i18n("Failed to execute the query") + QStringLiteral(" \n") + q.lastError().databaseText());
-		else
-			Q_EMIT error(i18n("Failed to execute the query"));
-
-		setInvalid();
-		return false;
-	}
+/*!
+ * sets the settings of the live data source \c source reading the rows added to the selected table
+ * or to the result of the custom query periodically.
+ */
+void ImportSQLDatabaseWidget::saveSettings(LiveDataSource* source) const {
+	auto* filter = new SQLFilter;
+	initFilter(*filter);
+	filter->setConnection(ui.cbConnection->currentText());
+	filter->setKeyColumn(ui.cbKeyColumn->currentData().toString());
+
+	source->setFileType(AbstractFileFilter::FileType::SQL);
+	source->setFilter(filter); // pass ownership of the filter to the LiveDataSource
+	source->setSourceType(LiveDataSource::SourceType::Database);
+	source->setComment(ui.cbConnection->currentText());
+
+	source->setReadingType(LiveDataSource::ReadingType::TillEnd);
+	source->setUpdateType(LiveDataSource::UpdateType::TimeInterval);
+	source->setUpdateInterval(ui.sbUpdateInterval->value());
+}
 
-	// determine the number of rows and columns to read
-	m_cols = q.record().count(); // total number of columns
-	m_actualCols = m_cols; // actual number of columns in the resultset to be read
-	m_actualRows = 0; // actual number of rows in the resultset to be read
-	m_startCol = 0;
-	m_endCol = m_cols - 1;
-	m_startRow = 0;
-	m_endRow = 0;
+/*!
+ * sets the table or the custom query to read and the import options in \c filter.
+ * Returns \c false if no table is selected.
+ */
+bool ImportSQLDatabaseWidget::initFilter(SQLFilter& filter) const {
+	const bool customQuery = (ui.cbImportFrom->currentIndex() != 0);
 	if (!customQuery) {
-		// determine the total number of records in the table
-		const QString& tableName = ui.lwTables->currentItem()->text();
-		QSqlQuery countQuery(QStringLiteral("SELECT COUNT(*) FROM ") + tableName);
-		while (countQuery.next())
-			m_actualRows = countQuery.value(0).toInt();
-
-		// columns to read
-		m_startCol = ui.sbStartColumn->value() - 1;
-		if (ui.sbEndColumn->value() != -1) {
-			m_endCol = ui.sbEndColumn->value() - 1;
-			if (m_endCol >= m_cols)
-				m_endCol = m_cols - 1;
-		}
-
-		m_actualCols = m_endCol - m_startCol + 1;
-
-		// determine the names and modes for columns to be read
-		if (m_startCol != 0 || m_endCol != m_cols - 1) {
-			for (int col = m_startCol; col <= m_endCol; ++col) {
-				m_actualColumnModes << m_columnModes.at(col);
-				m_actualColumnNames << m_columnNames.at(col);
-			}
-		} else {
-			// all columns are read
-			m_actualColumnModes = m_columnModes;
-			m_actualColumnNames = m_columnNames;
-		}
-
-		// rows to read
-		m_startRow = ui.sbStartRow->value() - 1;
-		if (ui.sbEndRow->value() != -1) {
-			m_endRow = ui.sbEndRow->value() - 1;
-			if (m_endRow >= m_actualRows)
-				m_endRow = m_actualRows - 1;
+		const auto* item = ui.lwTables->currentItem();
+		if (!item)
+			return false;
+		filter.setTable(item->text());
+		filter.setStartRow(ui.sbStartRow->value());
+		filter.setEndRow(ui.sbEndRow->value());
+		filter.setStartColumn(ui.sbStartColumn->value());
+		filter.setEndColumn(ui.sbEndColumn->value());
+	} else
+		filter.setQuery(ui.teQuery->toPlainText().simplified()); // the rows and columns to import are determined by the custom query
 
-			m_actualRows = m_endRow - m_startRow + 1;
-		} else
-			m_endRow = m_actualRows - 1; // all rows to be read
-	} else {
-		// custom query, navigate to the last record to get the total number of records in the resultset
-		q.last();
-		m_actualRows = q.at() + 1;
-		q.first();
-		q.previous(); // navigate in front of the first record so we also read it below in the whie loop
-
-		m_endRow = m_actualRows - 1; // all rows to be read
-		m_actualColumnModes = m_columnModes;
-		m_actualColumnNames = m_columnNames;
-	}
+	// use the column modes determined in the preview
+	filter.setColumnModes(m_columnModes);
+	filter.setDateTimeFormat(ui.cbDateTimeFormat->currentText());
 
-	DEBUG(Q_FUNC_INFO << " start col: " << m_startCol);
-	DEBUG(Q_FUNC_INFO << " end col: " << m_endCol);
-	DEBUG(Q_FUNC_INFO << " start row: " << m_startRow);
-	DEBUG(Q_FUNC_INFO << " end row: " << m_endRow);
-	QDEBUG(Q_FUNC_INFO << " column names: " << m_actualColumnNames);
+	// TODO: use general setting for decimal separator?
+	if (ui.cbDecimalSeparator->currentIndex() == 0)
+		filter.setNumberFormat(QLocale::Language::C);
+	else
+		filter.setNumberFormat(QLocale::Language::German);
 
 	return true;
 }
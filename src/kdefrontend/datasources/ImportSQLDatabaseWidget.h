@@ -23,16 +23,19 @@ class SyntaxHighlighter;
 }
 #endif
 
+class LiveDataSource;
 class QStandardItemModel;
+class SQLFilter;
 
 class ImportSQLDatabaseWidget : public QWidget {
 	Q_OBJECT
 
 public:
-	explicit ImportSQLDatabaseWidget(QWidget* parent = nullptr);
+	explicit ImportSQLDatabaseWidget(QWidget* parent = nullptr, bool liveDataSource = false);
 	~ImportSQLDatabaseWidget() override;
 
 	void read(AbstractDataSource*, AbstractFileFilter::ImportMode importMode = AbstractFileFilter::ImportMode::Replace);
+	void saveSettings(LiveDataSource*) const;
 	QString selectedTable() const;
 	bool isValid() const;
 	bool isNumericData() const;
@@ -44,20 +47,13 @@ private:
 
 	QStringList m_columnNames; // names for all columns in the table or query resultset
 	QVector<AbstractColumn::ColumnMode> m_columnModes; // modes for all columns in the table or query resultset
-	QVector<AbstractColumn::ColumnMode> m_actualColumnModes; // names for the actual columns to be imported
-	QStringList m_actualColumnNames; // names for the actual columns to be imported
 
 	int m_cols{0}; // total number of columns in the table or in the query resultset
-	int m_startCol{0};
-	int m_endCol{0};
-	int m_startRow{0};
-	int m_endRow{0};
-	int m_actualRows{0}; // actual number of rows in the resultset to be read
-	int m_actualCols{0}; // actual number of columns in the resultset to be read
 
 	QSqlDatabase m_db;
 	QStandardItemModel* m_databaseTreeModel{nullptr};
 	QString m_configPath;
+	bool m_liveDataSource;
 	bool m_initializing{false};
 	bool m_valid{false};
 	bool m_numeric{false};
@@ -66,9 +62,8 @@ private:
 	KSyntaxHighlighting::Repository m_repository;
 #endif
 
-	bool prepareAndExecute(QSqlQuery&);
-	void setValue(int col, int row, QStringView value);
 	void readConnections();
+	bool initFilter(SQLFilter&) const;
 	QString currentQuery(bool preview = false);
 	void setInvalid();
 	void setValid();
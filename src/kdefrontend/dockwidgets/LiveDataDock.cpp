@@ -11,6 +11,7 @@
 */
 
 #include "LiveDataDock.h"
+#include "backend/datasources/filters/SQLFilter.h"
 #include "kdefrontend/GuiTools.h"
 
 #include <QCompleter>
@@ -268,6 +269,11 @@ void LiveDataDock::setLiveDataSource(LiveDataSource* const source) {
 		break;
 	case LiveDataSource::SourceType::MQTT:
 		break;
+	case LiveDataSource::SourceType::Database: {
+		const auto* filter = static_cast<SQLFilter*>(source->filter());
+		ui.leSourceInfo->setText(QStringLiteral("%1: %2").arg(filter->connection(), filter->query().isEmpty() ? filter->table() : filter->query()));
+		break;
+	}
 	}
 
 	if (updateType == LiveDataSource::UpdateType::NewData) {
@@ -13,6 +13,7 @@
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
+#include "backend/matrix/MatrixBuffer.h"
 #include "kdefrontend/widgets/ConstantsWidget.h"
 #include "kdefrontend/widgets/FunctionsWidget.h"
 
@@ -146,7 +147,7 @@ void MatrixFunctionDialog::insertConstant(const QString& constantsName) const {
 /* task class for parallel fill (not used) */
 class GenerateValueTask : public QRunnable {
 public:
-	GenerateValueTask(int startCol, int endCol, QVector<QVector<double>>& matrixData, double xStart, double yStart, double xStep, double yStep, char* func)
+	GenerateValueTask(int startCol, int endCol, MatrixBuffer<double>& matrixData, double xStart, double yStart, double xStep, double yStep, char* func)
 		: m_startCol(startCol)
 		, m_endCol(endCol)
 		, m_matrixData(matrixData)
@@ -158,7 +159,7 @@ public:
 	}
 
 	void run() override {
-		const int rows = m_matrixData[m_startCol].size();
+		const int rows = m_matrixData.rowCount();
 		double x = m_xStart;
 		double y = m_yStart;
 		DEBUG("FILL col" << m_startCol << "-" << m_endCol << " x/y =" << x << '/' << y << " steps =" << m_xStep << '/' << m_yStep << " rows =" << rows)
@@ -170,7 +171,7 @@ public:
 				vars[1].value = y;
 				double z = parse_with_vars(m_func, vars, 2, qPrintable(QLocale().name()));
 				// DEBUG(" z =" << z);
-				m_matrixData[col][row] = z;
+				m_matrixData.ref(row, col) = z;
 				y += m_yStep;
 			}
 
@@ -182,7 +183,7 @@ public:
 private:
 	int m_startCol;
 	int m_endCol;
-	QVector<QVector<double>>& m_matrixData;
+	MatrixBuffer<double>& m_matrixData;
 	double m_xStart;
 	double m_yStart;
 	double m_xStep;
@@ -196,7 +197,7 @@ void MatrixFunctionDialog::generate() {
 	m_matrix->beginMacro(i18n("%1: fill matrix with function values", m_matrix->name()));
 
 	// TODO: data types
-	auto* new_data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	auto* new_data = static_cast<MatrixBuffer<double>*>(m_matrix->data());
 
 	// check if rows or cols == 1
 	double diff = m_matrix->xEnd() - m_matrix->xStart();
@@ -235,14 +236,18 @@ void MatrixFunctionDialog::generate() {
 		}
 		pool->waitForDone();
 	*/
+	// convert the expression and the locale only once and write directly into the matrix buffer
+	const QByteArray expression = ui.teEquation->toPlainText().toLocal8Bit();
+	const QByteArray locale = QLocale().name().toLatin1();
+	const int rows = m_matrix->rowCount();
 	double x = m_matrix->xStart();
 	double y = m_matrix->yStart();
 	parser_var vars[] = {{"x", x}, {"y", y}};
 	for (int col = 0; col < m_matrix->columnCount(); ++col) {
 		vars[0].value = x;
-		for (int row = 0; row < m_matrix->rowCount(); ++row) {
+		for (int row = 0; row < rows; ++row) {
 			vars[1].value = y;
-			(*new_data)[col][row] = parse_with_vars(qPrintable(ui.teEquation->toPlainText()), vars, 2, qPrintable(QLocale().name()));
+			new_data->ref(row, col) = parse_with_vars(expression.constData(), vars, 2, locale.constData());
 			y += yStep;
 		}
 		y = m_matrix->yStart();
@@ -75,6 +75,10 @@ ExportSpreadsheetDialog::ExportSpreadsheetDialog(QWidget* parent)
 	const QStringList& drivers = QSqlDatabase::drivers();
 	if (drivers.contains(QLatin1String("QSQLITE")) || drivers.contains(QLatin1String("QSQLITE3")))
 		ui->cbFormat->addItem(QStringLiteral("SQLite"), static_cast<int>(Format::SQLite));
+	ui->cbFormat->addItem(i18n("Binary"), static_cast<int>(Format::Binary));
+#ifdef HAVE_HDF5
+	ui->cbFormat->addItem(QStringLiteral("HDF5"), static_cast<int>(Format::HDF5));
+#endif
 
 	QStringList separators = AsciiFilter::separatorCharacters();
 	separators.takeAt(0); // remove the first entry "auto"
@@ -84,6 +88,10 @@ ExportSpreadsheetDialog::ExportSpreadsheetDialog(QWidget* parent)
 	ui->cbDecimalSeparator->addItem(i18n("Point '.'"));
 	ui->cbDecimalSeparator->addItem(i18n("Comma ','"));
 
+	ui->cbDataType->addItems(BinaryFilter::dataTypes());
+	ui->cbByteOrder->addItem(i18n("Little endian"), QDataStream::LittleEndian);
+	ui->cbByteOrder->addItem(i18n("Big endian"), QDataStream::BigEndian);
+
 	ui->cbLaTeXExport->addItem(i18n("Export Spreadsheet"));
 	ui->cbLaTeXExport->addItem(i18n("Export Selection"));
 
@@ -125,6 +133,9 @@ ExportSpreadsheetDialog::ExportSpreadsheetDialog(QWidget* parent)
 	ui->chkMatrixVHeader->setChecked(conf.readEntry("MatrixVerticalHeader", true));
 	ui->chkMatrixVHeader->setChecked(conf.readEntry("FITSSpreadsheetColumnsUnits", true));
 	ui->cbExportToFITS->setCurrentIndex(conf.readEntry("FITSTo", 0));
+	ui->cbDataType->setCurrentIndex(conf.readEntry("BinaryDataType", static_cast<int>(BinaryFilter::DataType::REAL64)));
+	ui->cbByteOrder->setCurrentIndex(conf.readEntry("BinaryByteOrder", 0));
+	ui->sbCompressionLevel->setValue(conf.readEntry("HDF5CompressionLevel", 0));
 	m_showOptions = conf.readEntry("ShowOptions", false);
 	ui->gbOptions->setVisible(m_showOptions);
 	m_showOptions ? m_showOptionsButton->setText(i18n("Hide Options")) : m_showOptionsButton->setText(i18n("Show Options"));
@@ -154,6 +165,9 @@ ExportSpreadsheetDialog::~ExportSpreadsheetDialog() {
 	conf.writeEntry("MatrixHorizontalHeader", ui->chkMatrixHHeader->isChecked());
 	conf.writeEntry("FITSTo", ui->cbExportToFITS->currentIndex());
 	conf.writeEntry("FITSSpreadsheetColumnsUnits", ui->chkColumnsAsUnits->isChecked());
+	conf.writeEntry("BinaryDataType", ui->cbDataType->currentIndex());
+	conf.writeEntry("BinaryByteOrder", ui->cbByteOrder->currentIndex());
+	conf.writeEntry("HDF5CompressionLevel", ui->sbCompressionLevel->value());
 
 	KWindowConfig::saveWindowSize(windowHandle(), conf);
 }
@@ -274,6 +288,18 @@ bool ExportSpreadsheetDialog::commentsAsUnitsFits() const {
 	return ui->chkColumnsAsUnits->isChecked();
 }
 
+BinaryFilter::DataType ExportSpreadsheetDialog::binaryDataType() const {
+	return static_cast<BinaryFilter::DataType>(ui->cbDataType->currentIndex());
+}
+
+QDataStream::ByteOrder ExportSpreadsheetDialog::binaryByteOrder() const {
+	return static_cast<QDataStream::ByteOrder>(ui->cbByteOrder->currentData().toInt());
+}
+
+int ExportSpreadsheetDialog::compressionLevel() const {
+	return ui->sbCompressionLevel->value();
+}
+
 QString ExportSpreadsheetDialog::separator() const {
 	return ui->cbSeparator->currentText();
 }
@@ -362,11 +388,12 @@ void ExportSpreadsheetDialog::selectFile() {
 	case Format::ASCII:
 		extensions = i18n("Text files (*.txt *.dat *.csv)");
 		break;
-	/*
 	case Format::Binary:
 		extensions = i18n("Binary files (*.*)");
 		break;
-	*/
+	case Format::HDF5:
+		extensions = i18n("HDF5 files (*.h5 *.hdf5)");
+		break;
 	case Format::LaTeX:
 		extensions = i18n("LaTeX files (*.tex)");
 		break;
@@ -398,25 +425,49 @@ void ExportSpreadsheetDialog::selectFile() {
 	called when the output format was changed. Adjusts the extension for the specified file.
  */
 void ExportSpreadsheetDialog::formatChanged(int index) {
-	QStringList extensions;
-	extensions << QStringLiteral(".txt") << QStringLiteral(".tex");
-#ifdef HAVE_FITS
-	extensions << QStringLiteral(".fits");
-#endif
-#ifdef HAVE_QXLSX
-	extensions << QStringLiteral(".xlsx");
-#endif
-	extensions << QStringLiteral(".db");
+	const auto format = Format(ui->cbFormat->itemData(index).toInt());
+	QString extension;
+	switch (format) {
+	case Format::ASCII:
+		extension = QStringLiteral(".txt");
+		break;
+	case Format::LaTeX:
+		extension = QStringLiteral(".tex");
+		break;
+	case Format::FITS:
+		extension = QStringLiteral(".fits");
+		break;
+	case Format::XLSX:
+		extension = QStringLiteral(".xlsx");
+		break;
+	case Format::SQLite:
+		extension = QStringLiteral(".db");
+		break;
+	case Format::Binary:
+		extension = QStringLiteral(".bin");
+		break;
+	case Format::HDF5:
+		extension = QStringLiteral(".h5");
+		break;
+	}
+
 	QString path = ui->leFileName->text();
 	int i = path.indexOf(QLatin1Char('.'));
 	if (index != -1) {
 		if (i == -1)
-			path = path + extensions.at(index);
+			path = path + extension;
 		else
-			path = path.left(i) + extensions.at(index);
+			path = path.left(i) + extension;
 	}
 
-	const auto format = Format(ui->cbFormat->itemData(ui->cbFormat->currentIndex()).toInt());
+	// options of the binary formats, shown below for the corresponding format only
+	ui->lDataType->hide();
+	ui->cbDataType->hide();
+	ui->lByteOrder->hide();
+	ui->cbByteOrder->hide();
+	ui->lCompressionLevel->hide();
+	ui->sbCompressionLevel->hide();
+
 	switch (format) {
 	case Format::LaTeX:
 		ui->cbSeparator->hide();
@@ -542,6 +593,46 @@ void ExportSpreadsheetDialog::formatChanged(int index) {
 		ui->lColumnAsUnits->hide();
 		ui->chkColumnsAsUnits->hide();
 		break;
+	case Format::Binary:
+	case Format::HDF5:
+		ui->cbSeparator->hide();
+		ui->lSeparator->hide();
+		ui->lDecimalSeparator->hide();
+		ui->cbDecimalSeparator->hide();
+
+		ui->chkCaptions->hide();
+		ui->chkEmptyRows->hide();
+		ui->chkGridLines->hide();
+		ui->lEmptyRows->hide();
+		ui->lExportArea->hide();
+		ui->lGridLines->hide();
+		ui->lCaptions->hide();
+		ui->cbLaTeXExport->hide();
+		ui->lMatrixHHeader->hide();
+		ui->lMatrixVHeader->hide();
+		ui->chkMatrixHHeader->hide();
+		ui->chkMatrixVHeader->hide();
+
+		ui->lHeader->hide();
+		ui->chkHeaders->hide();
+		ui->chkExportHeader->hide();
+		ui->lExportHeader->hide();
+
+		ui->cbExportToFITS->hide();
+		ui->lExportToFITS->hide();
+		ui->lColumnAsUnits->hide();
+		ui->chkColumnsAsUnits->hide();
+
+		if (format == Format::Binary) {
+			ui->lDataType->show();
+			ui->cbDataType->show();
+			ui->lByteOrder->show();
+			ui->cbByteOrder->show();
+		} else {
+			ui->lCompressionLevel->show();
+			ui->sbCompressionLevel->show();
+		}
+		break;
 	case Format::ASCII:
 		ui->cbSeparator->show();
 		ui->lSeparator->show();
@@ -570,12 +661,12 @@ void ExportSpreadsheetDialog::formatChanged(int index) {
 		ui->chkColumnsAsUnits->hide();
 	}
 
-	if (!m_matrixMode && !(format == Format::FITS || format == Format::SQLite)) {
+	if (!m_matrixMode && !(format == Format::FITS || format == Format::SQLite || format == Format::Binary || format == Format::HDF5)) {
 		ui->chkExportHeader->show();
 		ui->lExportHeader->show();
 	}
 
-	setFormat(static_cast<Format>(index));
+	setFormat(format);
 	ui->leFileName->setText(path);
 }
 
@@ -10,6 +10,8 @@
 #ifndef EXPORTSPREADSHEETDIALOG_H
 #define EXPORTSPREADSHEETDIALOG_H
 
+#include "backend/datasources/filters/BinaryFilter.h"
+
 #include <QDialog>
 #include <QLocale>
 
@@ -45,10 +47,13 @@ public:
 	QLocale::Language numberFormat() const;
 	int exportToFits() const;
 	bool commentsAsUnitsFits() const;
+	BinaryFilter::DataType binaryDataType() const;
+	QDataStream::ByteOrder binaryByteOrder() const;
+	int compressionLevel() const;
 	void setExportTo(const QStringList& to);
 	void setExportToImage(bool possible);
 
-	enum class Format { ASCII, LaTeX, FITS, XLSX, SQLite };
+	enum class Format { ASCII, LaTeX, FITS, XLSX, SQLite, Binary, HDF5 };
 
 	Format format() const;
 
@@ -28,7 +28,8 @@ static const QString defaultDateTimeFormat = QStringLiteral("yyyy-MM-dd hh:mm:ss
 
 SearchReplaceWidget::SearchReplaceWidget(Spreadsheet* spreadsheet, QWidget* parent)
 	: QWidget(parent)
-	, m_spreadsheet(spreadsheet) {
+	, m_spreadsheet(spreadsheet)
+	, m_search(new SpreadsheetSearch(spreadsheet)) {
 	m_view = static_cast<SpreadsheetView*>(spreadsheet->view());
 
 	auto* layout = new QVBoxLayout(this);
@@ -38,6 +39,8 @@ SearchReplaceWidget::SearchReplaceWidget(Spreadsheet* spreadsheet, QWidget* pare
 }
 
 SearchReplaceWidget::~SearchReplaceWidget() {
+	delete m_search;
+
 	// save the current settings,
 	// save everything except of the patterns, they will be set when the widget is opened again
 	KConfigGroup conf = Settings::group(QLatin1String("SearchReplaceWidget"));
@@ -596,8 +599,6 @@ bool SearchReplaceWidget::findNextSimple(bool proceed) {
 		return true;
 	}
 
-	const auto cs = uiSearch.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
 	// spreadsheet size and the start cell
 	const int colCount = m_spreadsheet->columnCount();
 	const int rowCount = m_spreadsheet->rowCount();
@@ -621,34 +622,14 @@ bool SearchReplaceWidget::findNextSimple(bool proceed) {
 		}
 	}
 
-	// all settings are determined -> search the next cell matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool startCol = true;
-	bool startRow = true;
-
 	// search in the column-major order ignoring the data type
 	// and iterpreting everything as text
-	for (int col = 0; col < colCount; ++col) {
-		if (startCol && col < curCol)
-			continue;
-
-		auto* column = columns.at(col)->asStringColumn();
-
-		for (int row = 0; row < rowCount; ++row) {
-			if (startRow && row < curRow)
-				continue;
-
-			if (column->textAt(row).contains(pattern, cs)) {
-				m_patternFound = true;
-				m_view->goToCell(row, col);
-				GuiTools::highlight(uiSearch.cbFind->lineEdit(), false);
-				return true;
-			}
-
-			startRow = false;
-		}
-
-		startCol = false;
+	m_search->setSettings(simpleSearchSettings());
+	if (m_search->findNext(curRow, curCol, Order::ColumnMajor)) {
+		m_patternFound = true;
+		m_view->goToCell(curRow, curCol);
+		GuiTools::highlight(uiSearch.cbFind->lineEdit(), false);
+		return true;
 	}
 
 	GuiTools::highlight(uiSearch.cbFind->lineEdit(), !m_patternFound);
@@ -669,10 +650,7 @@ bool SearchReplaceWidget::findPreviousSimple(bool proceed) {
 		return true;
 	}
 
-	const auto cs = uiSearch.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
 	// spreadsheet size and the start cell
-	const int colCount = m_spreadsheet->columnCount();
 	const int rowCount = m_spreadsheet->rowCount();
 	int curRow = m_view->firstSelectedRow();
 	int curCol = m_view->firstSelectedColumn();
@@ -694,32 +672,12 @@ bool SearchReplaceWidget::findPreviousSimple(bool proceed) {
 		}
 	}
 
-	// all settings are determined -> search the next cell matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool startCol = true;
-	bool startRow = true;
-
-	for (int col = colCount; col >= 0; --col) {
-		if (startCol && col > curCol)
-			continue;
-
-		auto* column = columns.at(col)->asStringColumn();
-
-		for (int row = rowCount; row >= 0; --row) {
-			if (startRow && row > curRow)
-				continue;
-
-			if (column->textAt(row).contains(pattern, cs)) {
-				m_patternFound = true;
-				m_view->goToCell(row, col);
-				GuiTools::highlight(uiSearch.cbFind->lineEdit(), false);
-				return true;
-			}
-
-			startRow = false;
-		}
-
-		startCol = false;
+	m_search->setSettings(simpleSearchSettings());
+	if (m_search->findPrevious(curRow, curCol, Order::ColumnMajor)) {
+		m_patternFound = true;
+		m_view->goToCell(curRow, curCol);
+		GuiTools::highlight(uiSearch.cbFind->lineEdit(), false);
+		return true;
 	}
 
 	GuiTools::highlight(uiSearch.cbFind->lineEdit(), !m_patternFound);
@@ -731,14 +689,13 @@ bool SearchReplaceWidget::findPreviousSimple(bool proceed) {
 // ****  advanced and data type specific find functions  ****
 // **********************************************************
 bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
-	// search pattern(s)
-	const auto type = static_cast<DataType>(uiSearchReplace.cbDataType->currentIndex());
-	QString pattern1;
-	QString pattern2;
+	const auto settings = searchSettings();
+	const auto type = settings.type;
+
+	// history and the replace value
 	QString replaceValue;
 	switch (type) {
 	case DataType::Text:
-		pattern1 = uiSearchReplace.cbValueText->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbValueText);
 		if (findAndReplace) {
 			replaceValue = uiSearchReplace.cbReplaceText->currentText();
@@ -746,8 +703,6 @@ bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
 		}
 		break;
 	case DataType::Numeric:
-		pattern1 = uiSearchReplace.cbValue1->currentText();
-		pattern2 = uiSearchReplace.cbValue2->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbValue1);
 		addCurrentTextToHistory(uiSearchReplace.cbValue2);
 		if (findAndReplace) {
@@ -756,14 +711,12 @@ bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
 		}
 		break;
 	case DataType::DateTime:
-		pattern1 = uiSearchReplace.dteValue1->text();
-		pattern2 = uiSearchReplace.dteValue2->text();
 		if (findAndReplace)
 			replaceValue = uiSearchReplace.dteReplace->text();
 		break;
 	}
 
-	if (pattern1.isEmpty()) {
+	if (settings.pattern1.isEmpty()) {
 		highlight(type, false);
 		return true;
 	}
@@ -771,11 +724,6 @@ bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
 	if (findAndReplace && replaceValue.isEmpty())
 		return false;
 
-	// settings
-	const auto opText = static_cast<OperatorText>(uiSearchReplace.cbOperatorText->currentData().toInt());
-	const auto opNumeric = static_cast<Operator>(uiSearchReplace.cbOperator->currentData().toInt());
-	const auto opDateTime = static_cast<Operator>(uiSearchReplace.cbOperatorDateTime->currentData().toInt());
-	const auto cs = uiSearchReplace.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
 	const bool columnMajor = (uiSearchReplace.cbOrder->currentIndex() == 0);
 
 	// spreadsheet size and the start cell
@@ -819,71 +767,16 @@ bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
 	}
 
 	// all settings are determined -> search the next cell matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool startCol = true;
-	bool startRow = true;
-	bool match = false;
-
-	if (columnMajor) {
-		for (int col = 0; col < colCount; ++col) {
-			if (startCol && col < curCol)
-				continue;
-
-			auto* column = columns.at(col);
-			if (!checkColumnType(column, type)) {
-				startRow = false;
-				continue;
-			}
-
-			for (int row = 0; row < rowCount; ++row) {
-				if (startRow && row < curRow)
-					continue;
-
-				match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-				if (match) {
-					m_patternFound = true;
-					m_view->goToCell(row, col);
-					if (findAndReplace)
-						setValue(column, type, row, replaceValue);
-					highlight(type, false);
-					return true;
-				}
-
-				startRow = false;
-			}
-
-			startCol = false;
-		}
-	} else { // row-major
-		for (int row = 0; row < rowCount; ++row) {
-			if (startRow && row < curRow)
-				continue;
-
-			for (int col = 0; col < colCount; ++col) {
-				if (startCol && col < curCol)
-					continue;
-
-				auto* column = columns.at(col);
-				if (!checkColumnType(column, type)) {
-					startCol = false;
-					continue;
-				}
-
-				match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-				if (match) {
-					m_patternFound = true;
-					m_view->goToCell(row, col);
-					if (findAndReplace)
-						setValue(column, type, row, replaceValue);
-					highlight(type, false);
-					return true;
-				}
-
-				startCol = false;
-			}
-
-			startRow = false;
+	m_search->setSettings(settings);
+	if (m_search->findNext(curRow, curCol, columnMajor ? Order::ColumnMajor : Order::RowMajor)) {
+		m_patternFound = true;
+		m_view->goToCell(curRow, curCol);
+		if (findAndReplace) {
+			setValue(m_spreadsheet->column(curCol), type, curRow, replaceValue);
+			m_search->updateMatch(curRow, curCol);
 		}
+		highlight(type, false);
+		return true;
 	}
 
 	highlight(type, !m_patternFound);
@@ -891,37 +784,27 @@ bool SearchReplaceWidget::findNext(bool proceed, bool findAndReplace) {
 }
 
 bool SearchReplaceWidget::findPrevious(bool proceed) {
-	// search pattern(s)
-	const auto type = static_cast<DataType>(uiSearchReplace.cbDataType->currentIndex());
-	QString pattern1;
-	QString pattern2;
+	const auto settings = searchSettings();
+	const auto type = settings.type;
+
+	// history
 	switch (type) {
 	case DataType::Text:
-		pattern1 = uiSearchReplace.cbValueText->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbValueText);
 		break;
 	case DataType::Numeric:
-		pattern1 = uiSearchReplace.cbValue1->currentText();
-		pattern2 = uiSearchReplace.cbValue2->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbValue1);
 		addCurrentTextToHistory(uiSearchReplace.cbValue2);
 		break;
 	case DataType::DateTime:
-		pattern1 = uiSearchReplace.dteValue1->text();
-		pattern2 = uiSearchReplace.dteValue2->text();
 		break;
 	}
 
-	if (pattern1.isEmpty()) {
+	if (settings.pattern1.isEmpty()) {
 		highlight(type, false);
 		return true;
 	}
 
-	// settings
-	const auto opText = static_cast<OperatorText>(uiSearchReplace.cbOperatorText->currentData().toInt());
-	const auto opNumeric = static_cast<Operator>(uiSearchReplace.cbOperator->currentData().toInt());
-	const auto opDateTime = static_cast<Operator>(uiSearchReplace.cbOperatorDateTime->currentData().toInt());
-	const auto cs = uiSearchReplace.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
 	const bool columnMajor = (uiSearchReplace.cbOrder->currentIndex() == 0);
 
 	// spreadsheet size and the start cell
@@ -964,68 +847,13 @@ bool SearchReplaceWidget::findPrevious(bool proceed) {
 		}
 	}
 
-	// all settings are determined -> search the next cell matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool startCol = true;
-	bool startRow = true;
-	bool match = false;
-
-	if (columnMajor) {
-		for (int col = colCount - 1; col >= 0; --col) {
-			if (startCol && col > curCol)
-				continue;
-
-			auto* column = columns.at(col);
-			if (!checkColumnType(column, type)) {
-				startCol = false;
-				continue;
-			}
-
-			for (int row = rowCount - 1; row >= 0; --row) {
-				if (startRow && row > curRow)
-					continue;
-
-				match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-				if (match) {
-					m_patternFound = true;
-					m_view->goToCell(row, col);
-					highlight(type, false);
-					return true;
-				}
-
-				startRow = false;
-			}
-
-			startCol = false;
-		}
-	} else { // row-major
-		for (int row = rowCount - 1; row >= 0; --row) {
-			if (startRow && row > curRow)
-				continue;
-
-			for (int col = colCount - 1; col >= 0; --col) {
-				if (startCol && col > curCol)
-					continue;
-
-				auto* column = columns.at(col);
-				if (!checkColumnType(column, type)) {
-					startCol = false;
-					continue;
-				}
-
-				match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-				if (match) {
-					m_patternFound = true;
-					m_view->goToCell(row, col);
-					highlight(type, false);
-					return true;
-				}
-
-				startCol = false;
-			}
-
-			startRow = false;
-		}
+	// all settings are determined -> search the previous cell matching the specified pattern(s)
+	m_search->setSettings(settings);
+	if (m_search->findPrevious(curRow, curCol, columnMajor ? Order::ColumnMajor : Order::RowMajor)) {
+		m_patternFound = true;
+		m_view->goToCell(curRow, curCol);
+		highlight(type, false);
+		return true;
 	}
 
 	highlight(type, !m_patternFound);
@@ -1033,55 +861,23 @@ bool SearchReplaceWidget::findPrevious(bool proceed) {
 }
 
 void SearchReplaceWidget::findAll() {
-	const auto type = static_cast<DataType>(uiSearchReplace.cbDataType->currentIndex());
-	QString pattern1;
-	QString pattern2;
-	switch (type) {
-	case DataType::Text:
-		pattern1 = uiSearchReplace.cbValueText->currentText();
-		break;
-	case DataType::Numeric:
-		pattern1 = uiSearchReplace.cbValue1->currentText();
-		pattern2 = uiSearchReplace.cbValue2->currentText();
-		break;
-	case DataType::DateTime:
-		pattern1 = uiSearchReplace.dteValue1->text();
-		pattern1 = uiSearchReplace.dteValue2->text();
-		break;
-	}
-
-	if (pattern1.isEmpty()) {
-		highlight(type, false);
+	const auto settings = searchSettings();
+	if (settings.pattern1.isEmpty()) {
+		highlight(settings.type, false);
 		return;
 	}
 
 	// clear the previous selection
 	m_view->clearSelection();
 
-	// settings
-	const auto opText = static_cast<OperatorText>(uiSearchReplace.cbOperatorText->currentData().toInt());
-	const auto opNumeric = static_cast<Operator>(uiSearchReplace.cbOperator->currentData().toInt());
-	const auto opDateTime = static_cast<Operator>(uiSearchReplace.cbOperatorDateTime->currentData().toInt());
-	const auto cs = uiSearchReplace.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
-	const int colCount = m_spreadsheet->columnCount();
-	const int rowCount = m_spreadsheet->rowCount();
-
 	// all settings are determined -> select all cells matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool match = false;
+	m_search->setSettings(settings);
 	int matchCount = 0;
-
+	const int colCount = m_spreadsheet->columnCount();
 	for (int col = 0; col < colCount; ++col) {
-		auto* column = columns.at(col);
-		if (!checkColumnType(column, type))
-			continue;
-
-		for (int row = 0; row < rowCount; ++row) {
-			match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-			if (match) {
-				m_view->selectCell(row, col);
-				++matchCount;
-			}
+		for (int row : m_search->matches(col)) {
+			m_view->selectCell(row, col);
+			++matchCount;
 		}
 	}
 
@@ -1100,30 +896,24 @@ void SearchReplaceWidget::replaceNext() {
 }
 
 void SearchReplaceWidget::replaceAll() {
-	const auto type = static_cast<DataType>(uiSearchReplace.cbDataType->currentIndex());
-	QString pattern1;
-	QString pattern2;
+	const auto settings = searchSettings();
+	const auto type = settings.type;
 	QString replaceValue;
 	switch (type) {
 	case DataType::Text:
-		pattern1 = uiSearchReplace.cbValueText->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbReplaceText);
 		replaceValue = uiSearchReplace.cbReplaceText->currentText();
 		break;
 	case DataType::Numeric:
-		pattern1 = uiSearchReplace.cbValue1->currentText();
-		pattern2 = uiSearchReplace.cbValue2->currentText();
 		addCurrentTextToHistory(uiSearchReplace.cbReplace);
 		replaceValue = uiSearchReplace.cbReplace->currentText();
 		break;
 	case DataType::DateTime:
-		pattern1 = uiSearchReplace.dteValue1->text();
-		pattern2 = uiSearchReplace.dteValue2->text();
 		replaceValue = uiSearchReplace.dteReplace->text();
 		break;
 	}
 
-	if (pattern1.isEmpty()) {
+	if (settings.pattern1.isEmpty()) {
 		highlight(type, false);
 		return;
 	}
@@ -1134,35 +924,9 @@ void SearchReplaceWidget::replaceAll() {
 	// clear the previous selection
 	m_view->clearSelection();
 
-	// settings
-	const auto opText = static_cast<OperatorText>(uiSearchReplace.cbOperatorText->currentData().toInt());
-	const auto opNumeric = static_cast<Operator>(uiSearchReplace.cbOperator->currentData().toInt());
-	const auto opDateTime = static_cast<Operator>(uiSearchReplace.cbOperatorDateTime->currentData().toInt());
-	const auto cs = uiSearchReplace.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
-	const int colCount = m_spreadsheet->columnCount();
-	const int rowCount = m_spreadsheet->rowCount();
-
-	// all settings are determined -> select all cells matching the specified pattern(s)
-	const auto& columns = m_spreadsheet->children<Column>();
-	bool match = false;
-	int matchCount = 0;
-	m_spreadsheet->beginMacro(i18n("%1: replace values", m_spreadsheet->name()));
-
-	for (int col = 0; col < colCount; ++col) {
-		auto* column = columns.at(col);
-		if (!checkColumnType(column, type))
-			continue;
-
-		for (int row = 0; row < rowCount; ++row) {
-			match = checkColumnRow(column, type, row, opText, opNumeric, opDateTime, pattern1, pattern2, cs);
-			if (match) {
-				setValue(column, type, row, replaceValue);
-				++matchCount;
-			}
-		}
-	}
-
-	m_spreadsheet->endMacro();
+	// all settings are determined -> replace the values in all cells matching the specified pattern(s)
+	m_search->setSettings(settings);
+	const int matchCount = m_search->replaceAll(replaceValue, uiSearchReplace.dteReplace->dateTime());
 
 	if (matchCount > 0)
 		showMessage(i18np("%1 replacement made", "%1 replacements made", matchCount));
@@ -1173,201 +937,46 @@ void SearchReplaceWidget::replaceAll() {
 // **********************************************************
 // ************ find/replace helper functions **************
 // **********************************************************
-bool SearchReplaceWidget::checkColumnType(Column* column, DataType type) {
-	bool valid = false;
-
-	switch (type) {
-	case DataType::Text:
-		valid = (column->columnMode() == AbstractColumn::ColumnMode::Text);
-		break;
-	case DataType::Numeric:
-		valid = column->isNumeric();
-		break;
-	case DataType::DateTime:
-		valid = (column->columnMode() == AbstractColumn::ColumnMode::DateTime);
-		break;
-	}
-
-	return valid;
+/*!
+ * returns the settings for the simple search where all cells are interpreted as text.
+ */
+SpreadsheetSearch::Settings SearchReplaceWidget::simpleSearchSettings() const {
+	SpreadsheetSearch::Settings settings;
+	settings.ignoreDataType = true;
+	settings.operatorText = OperatorText::Contain;
+	settings.caseSensitivity = uiSearch.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	settings.pattern1 = uiSearch.cbFind->currentText();
+	return settings;
 }
 
-bool SearchReplaceWidget::checkColumnRow(Column* column,
-										 DataType type,
-										 int row,
-										 OperatorText opText,
-										 Operator opNumeric,
-										 Operator opDateTime,
-										 const QString& pattern1,
-										 const QString pattern2,
-										 Qt::CaseSensitivity cs) {
-	bool match = false;
-	switch (type) {
+/*!
+ * returns the settings for the data type specific search as defined in the search&replace widget.
+ */
+SpreadsheetSearch::Settings SearchReplaceWidget::searchSettings() const {
+	SpreadsheetSearch::Settings settings;
+	settings.type = static_cast<DataType>(uiSearchReplace.cbDataType->currentIndex());
+	settings.operatorText = static_cast<OperatorText>(uiSearchReplace.cbOperatorText->currentData().toInt());
+	settings.operatorNumeric = static_cast<Operator>(uiSearchReplace.cbOperator->currentData().toInt());
+	settings.operatorDateTime = static_cast<Operator>(uiSearchReplace.cbOperatorDateTime->currentData().toInt());
+	settings.caseSensitivity = uiSearchReplace.tbMatchCase->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+	switch (settings.type) {
 	case DataType::Text:
-		match = checkCellText(column->textAt(row), pattern1, opText, cs);
+		settings.pattern1 = uiSearchReplace.cbValueText->currentText();
 		break;
 	case DataType::Numeric:
-		match = checkCellNumeric(column->valueAt(row), pattern1, pattern2, opNumeric);
+		settings.pattern1 = uiSearchReplace.cbValue1->currentText();
+		settings.pattern2 = uiSearchReplace.cbValue2->currentText();
 		break;
 	case DataType::DateTime:
-		match = checkCellDateTime(column->dateTimeAt(row), uiSearchReplace.dteValue1->dateTime(), uiSearchReplace.dteValue2->dateTime(), opDateTime);
-		break;
-	}
-
-	return match;
-}
-
-bool SearchReplaceWidget::checkCellText(const QString& cellText, const QString& pattern, OperatorText op, Qt::CaseSensitivity cs) {
-	bool match = false;
-
-	switch (op) {
-	case OperatorText::EqualTo: {
-		match = (cellText.compare(pattern, cs) == 0);
-		break;
-	}
-	case OperatorText::NotEqualTo: {
-		match = (cellText.compare(pattern, cs) != 0);
-		break;
-	}
-	case OperatorText::StartsWith: {
-		match = cellText.startsWith(pattern, cs);
-		break;
-	}
-	case OperatorText::EndsWith: {
-		match = cellText.endsWith(pattern, cs);
-		break;
-	}
-	case OperatorText::Contain: {
-		match = (cellText.indexOf(pattern, cs) != -1);
-		break;
-	}
-	case OperatorText::NotContain: {
-		match = (cellText.indexOf(pattern, cs) == -1);
-		break;
-	}
-	case OperatorText::RegEx: {
-		QRegularExpression re(pattern);
-		if (cs == Qt::CaseInsensitive)
-			re.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-		match = re.match(cellText).hasMatch();
-		break;
-	}
-	}
-
-	return match;
-}
-
-bool SearchReplaceWidget::checkCellNumeric(double cellValue, const QString& pattern1, const QString& pattern2, Operator op) {
-	if (pattern1.isEmpty())
-		return false;
-
-	if ((op == Operator::BetweenIncl || op == Operator::BetweenExcl) && pattern2.isEmpty())
-		return false;
-
-	bool ok;
-	const auto numberLocale = QLocale();
-
-	const double patternValue1 = numberLocale.toDouble(pattern1, &ok);
-	if (!ok)
-		return false;
-
-	double patternValue2 = 0.;
-	if (op == Operator::BetweenIncl || op == Operator::BetweenExcl) {
-		patternValue2 = numberLocale.toDouble(pattern2, &ok);
-		if (!ok)
-			return false;
-	}
-
-	bool match = false;
-
-	switch (op) {
-	case Operator::EqualTo: {
-		match = (cellValue == patternValue1);
-		break;
-	}
-	case Operator::NotEqualTo: {
-		match = (cellValue != patternValue1);
-		break;
-	}
-	case Operator::BetweenIncl: {
-		match = (cellValue >= patternValue1 && cellValue <= patternValue2);
-		break;
-	}
-	case Operator::BetweenExcl: {
-		match = (cellValue > patternValue1 && cellValue < patternValue2);
-		break;
-	}
-	case Operator::GreaterThan: {
-		match = (cellValue > patternValue1);
-		break;
-	}
-	case Operator::GreaterThanEqualTo: {
-		match = (cellValue >= patternValue1);
-		break;
-	}
-	case Operator::LessThan: {
-		match = (cellValue < patternValue1);
-		break;
-	}
-	case Operator::LessThanEqualTo: {
-		match = (cellValue <= patternValue1);
-		break;
-	}
-	}
-
-	return match;
-}
-
-bool SearchReplaceWidget::checkCellDateTime(const QDateTime& cellValueDateTime,
-											const QDateTime& patternDateTimeValue1,
-											const QDateTime& patternDateTimeValue2,
-											Operator op) {
-	if (!patternDateTimeValue1.isValid())
-		return false;
-
-	if ((op == Operator::BetweenIncl || op == Operator::BetweenExcl) && !patternDateTimeValue2.isValid())
-		return false;
-
-	const double cellValue = cellValueDateTime.toMSecsSinceEpoch();
-	const double patternValue1 = patternDateTimeValue1.toMSecsSinceEpoch();
-	const double patternValue2 = patternDateTimeValue2.toMSecsSinceEpoch();
-	bool match = false;
-
-	switch (op) {
-	case Operator::EqualTo: {
-		match = (cellValue == patternValue1);
-		break;
-	}
-	case Operator::NotEqualTo: {
-		match = (cellValue != patternValue1);
-		break;
-	}
-	case Operator::BetweenIncl: {
-		match = (cellValue >= patternValue1 && cellValue <= patternValue2);
+		settings.pattern1 = uiSearchReplace.dteValue1->text();
+		settings.pattern2 = uiSearchReplace.dteValue2->text();
+		settings.dateTime1 = uiSearchReplace.dteValue1->dateTime();
+		settings.dateTime2 = uiSearchReplace.dteValue2->dateTime();
 		break;
 	}
-	case Operator::BetweenExcl: {
-		match = (cellValue > patternValue1 && cellValue < patternValue2);
-		break;
-	}
-	case Operator::GreaterThan: {
-		match = (cellValue > patternValue1);
-		break;
-	}
-	case Operator::GreaterThanEqualTo: {
-		match = (cellValue >= patternValue1);
-		break;
-	}
-	case Operator::LessThan: {
-		match = (cellValue < patternValue1);
-		break;
-	}
-	case Operator::LessThanEqualTo: {
-		match = (cellValue <= patternValue1);
-		break;
-	}
-	}
 
-	return match;
+	return settings;
 }
 
 void SearchReplaceWidget::setValue(Column* column, DataType type, int row, const QString& replaceValue) {
@@ -11,6 +11,7 @@
 #define SEARCHREPLACEWIDGET_H
 
 #include "backend/core/AbstractColumn.h"
+#include "backend/spreadsheet/SpreadsheetSearch.h"
 #include "ui_searchreplacewidget.h"
 #include "ui_searchwidget.h"
 #include <QWidget>
@@ -28,10 +29,10 @@ public:
 	explicit SearchReplaceWidget(Spreadsheet*, QWidget* parent = nullptr);
 	~SearchReplaceWidget() override;
 
-	enum class DataType { Text, Numeric, DateTime };
-	enum class Operator { EqualTo, NotEqualTo, BetweenIncl, BetweenExcl, GreaterThan, GreaterThanEqualTo, LessThan, LessThanEqualTo };
-	enum class OperatorText { EqualTo, NotEqualTo, StartsWith, EndsWith, Contain, NotContain, RegEx };
-	enum class Order { ColumnMajor, RowMajor };
+	using DataType = SpreadsheetSearch::DataType;
+	using Operator = SpreadsheetSearch::Operator;
+	using OperatorText = SpreadsheetSearch::OperatorText;
+	using Order = SpreadsheetSearch::Order;
 
 	void setReplaceEnabled(bool enabled);
 	void setInitialPattern(AbstractColumn::ColumnMode, const QString&);
@@ -47,24 +48,14 @@ private:
 	bool m_replaceEnabled{false};
 	Spreadsheet* m_spreadsheet{nullptr};
 	SpreadsheetView* m_view{nullptr};
+	SpreadsheetSearch* m_search{nullptr};
 	KMessageWidget* m_messageWidget{nullptr};
 
 	void initSearchWidget();
 	void initSearchReplaceWidget();
 
-	bool checkColumnType(Column*, DataType);
-	bool checkColumnRow(Column*,
-						DataType,
-						int row,
-						OperatorText opText,
-						Operator opNumeric,
-						Operator opDateTime,
-						const QString& pattern1,
-						const QString pattern2,
-						Qt::CaseSensitivity cs);
-	bool checkCellText(const QString& value, const QString& pattern, OperatorText, Qt::CaseSensitivity);
-	bool checkCellNumeric(double value, const QString& pattern1, const QString& pattern2, Operator);
-	bool checkCellDateTime(const QDateTime& value, const QDateTime& pattern1, const QDateTime& pattern2, Operator);
+	SpreadsheetSearch::Settings simpleSearchSettings() const;
+	SpreadsheetSearch::Settings searchSettings() const;
 	void setValue(Column*, DataType, int row, const QString& value);
 	void highlight(DataType, bool invalid);
 	void showMessage(const QString&);
@@ -16,14 +16,24 @@
 #include <KConfigGroup>
 #include <KLocalizedString>
 
+#include <QApplication>
+#include <QCache>
 #include <QColor>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
+#include <QFutureInterface>
 #include <QImage>
+#include <QMutex>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
 
 #ifdef HAVE_POPPLER
 #include <poppler-qt5.h>
@@ -37,6 +47,153 @@
 
 	\ingroup tools
 */
+
+namespace {
+// rendered images in memory, the cost is the size in kB
+QCache<QString, QByteArray> memoryCache(50 * 1024);
+QMutex cacheMutex;
+
+// limits of the disk cache, the size in bytes and the age in days
+constexpr qint64 diskCacheMaxSize = 100 * 1024 * 1024;
+constexpr int diskCacheMaxAge = 30;
+
+void insertIntoMemoryCache(const QString& key, const QByteArray& data) {
+	QMutexLocker locker(&cacheMutex);
+	memoryCache.insert(key, new QByteArray(data), qMax(1, static_cast<int>(data.size() / 1024)));
+}
+}
+
+// renderings in progress, identical labels share the same rendering. Only accessed in the main thread.
+QHash<QString, QFuture<TeXRenderer::Result>> TeXRenderer::pendingRenderings;
+
+QThreadPool* TeXRenderer::renderPool() {
+	static QThreadPool* pool = nullptr;
+	if (!pool) {
+		pool = new QThreadPool(qApp);
+		pool->setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+	}
+	return pool;
+}
+
+/*!
+ * returns the name of the file in the disk cache for the rendering with the key \p key.
+ * The outdated files are removed from the disk cache when it is used for the first time.
+ */
+QString TeXRenderer::diskCacheFileName(const QString& key) {
+	static const QString path = [] {
+		const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/latex/");
+		QDir().mkpath(dir);
+		QtConcurrent::run(renderPool(), &TeXRenderer::cleanupDiskCache, dir, diskCacheMaxSize, diskCacheMaxAge);
+		return dir;
+	}();
+	return path + key + QStringLiteral(".pdf");
+}
+
+/*!
+ * removes the files in the disk cache directory \p path that were not used during the last \p maxAge days.
+ * If the remaining files are larger than \p maxSize bytes, the least recently used files are removed, too.
+ */
+void TeXRenderer::cleanupDiskCache(const QString& path, qint64 maxSize, int maxAge) {
+	const auto oldest = QDateTime::currentDateTime().addDays(-maxAge);
+	const auto files = QDir(path).entryInfoList(QStringList{QStringLiteral("*.pdf")}, QDir::Files, QDir::Time); // most recently used first
+	qint64 size = 0;
+	for (const auto& info : files) {
+		size += info.size();
+		if (size > maxSize || info.lastModified() < oldest)
+			QFile::remove(info.absoluteFilePath());
+	}
+}
+
+/*!
+ * renders \p teXString asynchronously. The rendered images are cached in memory and on disk, the key consists of
+ * the LaTeX source, the engine and the formatting. If the image is available in the cache, the returned future is already finished.
+ * The disk cache is limited in size and age, see cleanupDiskCache().
+ * The renderings of cache misses are executed in a thread pool with a limited number of threads, identical
+ * renderings requested while the first one is still running share the same future.
+ *
+ * Must be called in the main thread.
+ */
+QFuture<TeXRenderer::Result> TeXRenderer::renderImageLaTeXCached(const QString& teXString, const TeXRenderer::Formatting& format) {
+	const QString key = cacheKey(teXString, format);
+
+	Result res;
+	{
+		QMutexLocker locker(&cacheMutex);
+		const auto* data = memoryCache.object(key);
+		if (data)
+			res.data = *data;
+	}
+
+	if (res.data.isEmpty()) {
+		QFile file(diskCacheFileName(key));
+		if (file.open(QIODevice::ReadOnly)) {
+			res.data = file.readAll();
+			if (!res.data.isEmpty()) {
+				insertIntoMemoryCache(key, res.data);
+				file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime); // mark as recently used
+			}
+		}
+	}
+
+	if (!res.data.isEmpty()) {
+		res.successful = true;
+		QFutureInterface<Result> fi(QFutureInterfaceBase::Started);
+		fi.reportFinished(&res);
+		return fi.future();
+	}
+
+	// the same image is already being rendered
+	auto it = pendingRenderings.begin();
+	while (it != pendingRenderings.end()) {
+		if (!it.value().isFinished()) {
+			if (it.key() == key)
+				return it.value();
+			++it;
+		} else
+			it = pendingRenderings.erase(it);
+	}
+
+	auto future = QtConcurrent::run(renderPool(), &TeXRenderer::renderAndCache, key, teXString, format);
+	pendingRenderings.insert(key, future);
+	return future;
+}
+
+/*!
+ * renders \p teXString and stores the image in the memory and disk cache under the key \p key.
+ * Executed in the render thread pool.
+ */
+TeXRenderer::Result TeXRenderer::renderAndCache(const QString& key, const QString& teXString, const TeXRenderer::Formatting& format) {
+	Result res;
+	const auto data = renderImageLaTeX(teXString, &res, format);
+	if (!res.successful || data.isEmpty())
+		return res;
+
+	res.data = data;
+	insertIntoMemoryCache(key, data);
+
+	QSaveFile file(diskCacheFileName(key));
+	if (file.open(QIODevice::WriteOnly)) {
+		file.write(data);
+		file.commit();
+	}
+
+	return res;
+}
+
+QString TeXRenderer::cacheKey(const QString& teXString, const TeXRenderer::Formatting& format) {
+	const auto& group = Settings::group(QStringLiteral("Settings_Worksheet"));
+	const auto& engine = group.readEntry("LaTeXEngine", "pdflatex");
+
+	const QStringList parts{teXString,
+							engine,
+							format.fontFamily,
+							QString::number(format.fontSize),
+							format.fontColor.name(QColor::HexArgb),
+							format.backgroundColor.name(QColor::HexArgb),
+							QString::number(format.dpi)};
+	return QString::fromLatin1(QCryptographicHash::hash(parts.join(QChar::Null).toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
 QByteArray TeXRenderer::renderImageLaTeX(const QString& teXString, Result* res, const TeXRenderer::Formatting& format) {
 	const QColor& fontColor = format.fontColor;
 	const QColor& backgroundColor = format.backgroundColor;
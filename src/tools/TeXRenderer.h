@@ -11,10 +11,13 @@
 #define TEXRENDERER_H
 
 #include <QColor>
+#include <QFuture>
+#include <QHash>
 
 class QString;
 class QImage;
 class QTemporaryFile;
+class QThreadPool;
 
 class TeXRenderer {
 public:
@@ -32,14 +35,27 @@ public:
 		}
 		bool successful;
 		QString errorMessage;
+		QByteArray data; // rendered image, only set by renderImageLaTeXCached()
 	};
 
+	static QFuture<Result> renderImageLaTeXCached(const QString&, const TeXRenderer::Formatting&);
 	static QByteArray renderImageLaTeX(const QString&, Result*, const TeXRenderer::Formatting&);
 	static bool executeLatexProcess(const QString engine, const QString& baseName, const QTemporaryFile& file, const QString& resultFileExtension, Result* res);
 	static QByteArray imageFromPDF(const QTemporaryFile&, const QString& engine, Result*);
 	static QByteArray imageFromDVI(const QTemporaryFile&, const int dpi, Result*);
 	static bool enabled();
 	static bool executableExists(const QString&);
+
+private:
+	static QString cacheKey(const QString&, const TeXRenderer::Formatting&);
+	static QString diskCacheFileName(const QString& key);
+	static void cleanupDiskCache(const QString& path, qint64 maxSize, int maxAge);
+	static QThreadPool* renderPool();
+	static Result renderAndCache(const QString& key, const QString&, const TeXRenderer::Formatting&);
+
+	static QHash<QString, QFuture<Result>> pendingRenderings;
+
+	friend class TextLabelTest;
 };
 
 #endif
@@ -13,11 +13,18 @@
 #include "ColumnTest.h"
 #include "backend/core/Project.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnBlocks.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/core/column/ColumnStore.h"
+#include "backend/core/column/ColumnUndoStorage.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
 #include <QUndoStack>
 
 #define SETUP_C1_C2_COLUMNS(c1Vector, c2Vector)                                                                                                                \
@@ -1739,4 +1746,664 @@ void ColumnTest::testRowCountValueLabelsDateTime() {
 			 3);
 }
 
+void ColumnTest::testAppendRowsProperties() {
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Double);
+	c.replaceValues(-1, {1., 2., 3.});
+	QCOMPARE(c.properties(), AbstractColumn::Properties::MonotonicIncreasing);
+	QCOMPARE(c.minimum(), 1.);
+	QCOMPARE(c.maximum(), 3.);
+
+	// append new values directly in the data as done by the live data sources
+	c.insertRows(3, 2);
+	auto* data = static_cast<QVector<double>*>(c.data());
+	(*data)[3] = 4.;
+	(*data)[4] = 5.;
+	c.setChanged(3);
+	QCOMPARE(c.properties(), AbstractColumn::Properties::MonotonicIncreasing);
+	QCOMPARE(c.minimum(), 1.);
+	QCOMPARE(c.maximum(), 5.);
+
+	c.insertRows(5, 1);
+	data = static_cast<QVector<double>*>(c.data());
+	(*data)[5] = -1.;
+	c.setChanged(5);
+	QCOMPARE(c.properties(), AbstractColumn::Properties::NonMonotonic);
+	QCOMPARE(c.minimum(), -1.);
+	QCOMPARE(c.maximum(), 5.);
+	QCOMPARE(c.statistics().size, 6);
+	QCOMPARE(c.statistics().arithmeticMean, 14. / 6.);
+
+	// changed values at the beginning invalidate everything
+	(*data)[0] = 10.;
+	c.setChanged(0);
+	QCOMPARE(c.maximum(), 10.);
+}
+
+void ColumnTest::testAppendRowsMinMaxInteger() {
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Integer);
+	c.replaceInteger(-1, {3, 2});
+	QCOMPARE(c.properties(), AbstractColumn::Properties::MonotonicDecreasing);
+	QCOMPARE(c.minimum(), 2.);
+
+	// the new rows are used with their initial value 0 before the new values are written
+	c.insertRows(2, 1);
+	QCOMPARE(c.minimum(), 0.);
+	QCOMPARE(c.properties(), AbstractColumn::Properties::MonotonicDecreasing);
+
+	auto* data = static_cast<QVector<int>*>(c.data());
+	(*data)[2] = 5;
+	c.setChanged(2);
+	QCOMPARE(c.minimum(), 2.);
+	QCOMPARE(c.maximum(), 5.);
+	QCOMPARE(c.properties(), AbstractColumn::Properties::NonMonotonic);
+}
+
+/*!
+ * the count, the means and the moments are extended with the appended rows, the median is determined on request.
+ */
+void ColumnTest::testAppendRowsStatistics() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.close();
+
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Double);
+	c.replaceValues(-1, {1., 2., 3.});
+
+	Trace::start(file.fileName());
+	const auto& moments = c.momentStatistics();
+	QCOMPARE(moments.size, 3);
+	QCOMPARE(moments.arithmeticMean, 2.);
+	QCOMPARE(moments.variance, 1.);
+	QVERIFY(std::isnan(moments.median));
+
+	// append as done by the live data sources
+	c.insertRows(3, 2);
+	auto* data = static_cast<QVector<double>*>(c.data());
+	(*data)[3] = 4.;
+	(*data)[4] = 10.;
+	c.setChanged(3);
+	QCOMPARE(c.momentStatistics().size, 5);
+	QCOMPARE(c.momentStatistics().arithmeticMean, 4.);
+	QCOMPARE(c.momentStatistics().variance, 12.5);
+	QCOMPARE(c.maximum(), 10.);
+
+	// appended via replaceValues()
+	c.replaceValues(5, {NAN, -2.});
+	QCOMPARE(c.momentStatistics().size, 6);
+	QCOMPARE(c.momentStatistics().arithmeticMean, 3.);
+	QCOMPARE(c.minimum(), -2.);
+	Trace::stop();
+
+	// the measures based on the order of the values
+	QCOMPARE(c.statistics().median, 2.5);
+	QCOMPARE(c.statistics().arithmeticMean, 3.);
+
+	// the same values as with the statistics of all rows
+	Column d(QStringLiteral("Test"), Column::ColumnMode::Double);
+	d.replaceValues(-1, {1., 2., 3., 4., 10., NAN, -2.});
+	QCOMPARE(c.statistics().variance, d.statistics().variance);
+	QCOMPARE(c.statistics().geometricMean, d.statistics().geometricMean);
+	QCOMPARE(c.statistics().skewness, d.statistics().skewness);
+	QCOMPARE(c.statistics().kurtosis, d.statistics().kurtosis);
+
+	// the moments were determined once, the appended rows were added to them
+	QVERIFY(file.open());
+	const auto events = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("traceEvents")).toArray();
+	int calculations = 0;
+	for (const auto& value : events) {
+		const auto event = value.toObject();
+		if (event.value(QLatin1String("ph")).toString() == QLatin1String("X")
+			&& event.value(QLatin1String("name")).toString() == QLatin1String("calculate column moments"))
+			++calculations;
+	}
+	QCOMPARE(calculations, 1);
+}
+
+void ColumnTest::testSnapshot() {
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Double);
+	c.replaceValues(-1, {1., 2., 3.});
+
+	const auto s = c.snapshot<double>();
+	QCOMPARE(s.data.size(), 3);
+	QVERIFY(c.isSnapshotCurrent(s.version));
+
+	// modify and append, the snapshot must not change
+	c.setValueAt(0, 10.);
+	c.setValueAt(3, 4.);
+	QVERIFY(!c.isSnapshotCurrent(s.version));
+	QVERIFY(c.dataVersion() > s.version);
+
+	QCOMPARE(s.data.size(), 3);
+	QCOMPARE(s.data.at(0), 1.);
+	QCOMPARE(s.data.at(2), 3.);
+	QCOMPARE(c.rowCount(), 4);
+	QCOMPARE(c.valueAt(0), 10.);
+	QCOMPARE(c.valueAt(3), 4.);
+}
+
+void ColumnTest::testSnapshotWrongMode() {
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Integer);
+	c.replaceInteger(-1, {1, 2, 3});
+
+	QVERIFY(c.snapshot<double>().data.isEmpty());
+	QCOMPARE(c.snapshot<int>().data.size(), 3);
+}
+
+void ColumnTest::testUndoReplaceValues() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Test"), Column::ColumnMode::Double);
+	project.addChild(c);
+	c->replaceValues(-1, {1., 2., 3., 4., 5.});
+
+	// change one value and remove the last row
+	c->replaceValues(-1, {1., 2., 30., 4.});
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->valueAt(2), 30.);
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(c->valueAt(i), i + 1.);
+
+	c->undoStack()->redo();
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->valueAt(1), 2.);
+	QCOMPARE(c->valueAt(2), 30.);
+	QCOMPARE(c->valueAt(3), 4.);
+
+	// replace a range and add rows
+	c->replaceValues(3, {40., 50., 60.});
+	QCOMPARE(c->rowCount(), 6);
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->valueAt(3), 4.);
+
+	c->undoStack()->redo();
+	QCOMPARE(c->rowCount(), 6);
+	QCOMPARE(c->valueAt(3), 40.);
+	QCOMPARE(c->valueAt(5), 60.);
+}
+
+void ColumnTest::testUndoValuesDeltaSpill() {
+	auto& storage = ColumnUndoStorage::instance();
+	const qint64 budget = storage.memoryBudget();
+
+	QVector<QString> data{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")};
+	const QVector<QString> newData{QStringLiteral("a"), QStringLiteral("x")};
+
+	// only the changed and the removed rows are stored
+	storage.setMemoryBudget(-1);
+	ColumnValuesDelta<QString> delta;
+	delta.record(data, -1, newData);
+	QCOMPARE(delta.changedRows(), 2);
+	QVERIFY(!delta.isSpilled());
+
+	// the data is spilled to disk if the budget is exceeded
+	storage.setMemoryBudget(0);
+	QVERIFY(delta.isSpilled());
+	QCOMPARE(delta.memorySize(), 0);
+
+	data = newData;
+	delta.apply(data);
+	QCOMPARE(data.size(), 3);
+	QCOMPARE(data.at(1), QStringLiteral("b"));
+	QCOMPARE(data.at(2), QStringLiteral("c"));
+
+	delta.apply(data);
+	QCOMPARE(data, newData);
+
+	storage.setMemoryBudget(budget);
+}
+
+void ColumnTest::testUndoCopy() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Test"), Column::ColumnMode::Integer);
+	project.addChild(c);
+	c->replaceInteger(-1, {1, 2, 3, 4, 5});
+	Column source(QStringLiteral("Source"), Column::ColumnMode::Integer);
+	source.setIntegers({10, 20, 30});
+
+	// copy two values into the middle of the column, the rows behind them are kept
+	QVERIFY(c->copy(&source, 1, 2, 2));
+	QCOMPARE(c->rowCount(), 5);
+	QCOMPARE(c->integerAt(1), 2);
+	QCOMPARE(c->integerAt(2), 20);
+	QCOMPARE(c->integerAt(3), 30);
+	QCOMPARE(c->integerAt(4), 5);
+
+	c->undoStack()->undo();
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(c->integerAt(i), i + 1);
+
+	// copy the complete column
+	QVERIFY(c->copy(&source));
+	QCOMPARE(c->rowCount(), 3);
+	QCOMPARE(c->integerAt(0), 10);
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), 5);
+	QCOMPARE(c->integerAt(4), 5);
+
+	c->undoStack()->redo();
+	QCOMPARE(c->rowCount(), 3);
+	QCOMPARE(c->integerAt(2), 30);
+}
+
+/*!
+ * insert and remove rows in the middle of text and datetime columns, the rows are moved in one step.
+ */
+void ColumnTest::testInsertRemoveRowsTextDateTime() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Text"), Column::ColumnMode::Text);
+	project.addChild(c);
+	c->replaceTexts(-1, {QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d")});
+
+	c->insertRows(1, 3);
+	QCOMPARE(c->rowCount(), 7);
+	QCOMPARE(c->textAt(0), QStringLiteral("a"));
+	QCOMPARE(c->textAt(1), QString());
+	QCOMPARE(c->textAt(3), QString());
+	QCOMPARE(c->textAt(4), QStringLiteral("b"));
+	QCOMPARE(c->textAt(6), QStringLiteral("d"));
+
+	c->removeRows(3, 3);
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->textAt(2), QString());
+	QCOMPARE(c->textAt(3), QStringLiteral("d"));
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), 7);
+	QCOMPARE(c->textAt(4), QStringLiteral("b"));
+	QCOMPARE(c->textAt(5), QStringLiteral("c"));
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->textAt(1), QStringLiteral("b"));
+
+	auto* d = new Column(QStringLiteral("DateTime"), Column::ColumnMode::DateTime);
+	project.addChild(d);
+	const auto& dateTime = QDateTime::fromMSecsSinceEpoch(0, Qt::UTC);
+	d->replaceDateTimes(-1, {dateTime, dateTime.addDays(1), dateTime.addDays(2)});
+
+	d->insertRows(1, 2);
+	QCOMPARE(d->rowCount(), 5);
+	QCOMPARE(d->dateTimeAt(1).isValid(), false);
+	QCOMPARE(d->dateTimeAt(3), dateTime.addDays(1));
+
+	d->removeRows(0, 3);
+	QCOMPARE(d->rowCount(), 2);
+	QCOMPARE(d->dateTimeAt(0), dateTime.addDays(1));
+	QCOMPARE(d->dateTimeAt(1), dateTime.addDays(2));
+}
+
+/*!
+ * append, insert and remove rows of a column with the chunked storage, the values are the same as with the contiguous storage.
+ */
+void ColumnTest::testChunkedStorage() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Double"), Column::ColumnMode::Double);
+	project.addChild(c);
+	const int rows = 3 * ColumnBlocks<double>::BlockSize + 5;
+	QVector<double> values(rows);
+	for (int i = 0; i < rows; ++i)
+		values[i] = i;
+	c->replaceValues(-1, values);
+
+	c->setChunkedStorage(true);
+	QVERIFY(c->chunkedStorage());
+	QCOMPARE(c->rowCount(), rows);
+	QCOMPARE(c->valueAt(0), 0.);
+	QCOMPARE(c->valueAt(ColumnBlocks<double>::BlockSize), (double)ColumnBlocks<double>::BlockSize);
+	QCOMPARE(c->valueAt(rows - 1), rows - 1.);
+	QCOMPARE(c->minimum(), 0.);
+	QCOMPARE(c->maximum(), rows - 1.);
+	QCOMPARE(c->properties(), AbstractColumn::Properties::MonotonicIncreasing);
+
+	// append
+	c->replaceValues(rows, {-1., (double)rows});
+	QVERIFY(c->chunkedStorage());
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(rows), -1.);
+	QCOMPARE(c->minimum(), -1.);
+	QCOMPARE(c->maximum(), (double)rows);
+
+	c->undoStack()->undo();
+	QVERIFY(c->chunkedStorage());
+	QCOMPARE(c->rowCount(), rows);
+	c->undoStack()->redo();
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(rows + 1), (double)rows);
+
+	// insert in the middle of a block
+	const int before = ColumnBlocks<double>::BlockSize + 10;
+	c->insertRows(before, 3);
+	QVERIFY(c->chunkedStorage());
+	QCOMPARE(c->rowCount(), rows + 5);
+	QCOMPARE(c->valueAt(before - 1), before - 1.);
+	QVERIFY(std::isnan(c->valueAt(before)));
+	QVERIFY(std::isnan(c->valueAt(before + 2)));
+	QCOMPARE(c->valueAt(before + 3), (double)before);
+	QCOMPARE(c->valueAt(rows + 4), (double)rows);
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(before), (double)before);
+
+	// remove rows across the block boundaries
+	c->removeRows(10, 2 * ColumnBlocks<double>::BlockSize);
+	QVERIFY(c->chunkedStorage());
+	QCOMPARE(c->rowCount(), rows + 2 - 2 * ColumnBlocks<double>::BlockSize);
+	QCOMPARE(c->valueAt(9), 9.);
+	QCOMPARE(c->valueAt(10), 10. + 2 * ColumnBlocks<double>::BlockSize);
+
+	// write directly into the blocks
+	const int count = c->rowCount();
+	const auto& chunks = c->dataChunks(0, count);
+	QVERIFY(chunks.size() > 1);
+	int row = 0;
+	for (const auto& chunk : chunks) {
+		QCOMPARE(chunk.firstRow, row);
+		std::fill_n(static_cast<double*>(chunk.values), chunk.size, 1.);
+		row += chunk.size;
+	}
+	QCOMPARE(row, count);
+	c->setChanged();
+	QCOMPARE(c->valueAt(count - 1), 1.);
+	QCOMPARE(c->statistics().arithmeticMean, 1.);
+
+	// data() returns to the contiguous storage
+	const auto* data = static_cast<QVector<double>*>(c->data());
+	QVERIFY(!c->chunkedStorage());
+	QCOMPARE(data->size(), count);
+	QCOMPARE(data->at(count - 1), 1.);
+}
+
+/*!
+ * text column with the chunked storage, the dictionary and the snapshot are determined without returning to the contiguous storage.
+ */
+void ColumnTest::testChunkedStorageText() {
+	Column c(QStringLiteral("Text"), Column::ColumnMode::Text);
+	c.setChunkedStorage(true);
+	c.replaceTexts(0, {QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("a")});
+	QVERIFY(c.chunkedStorage());
+	QCOMPARE(c.rowCount(), 3);
+	QCOMPARE(c.textAt(1), QStringLiteral("b"));
+
+	c.setTextAt(4, QStringLiteral("c"));
+	QCOMPARE(c.rowCount(), 5);
+	QCOMPARE(c.textAt(3), QString());
+	QCOMPARE(c.textAt(4), QStringLiteral("c"));
+	QCOMPARE(c.frequencies().value(QStringLiteral("a")), 2);
+
+	const auto& snapshot = c.snapshot<QString>();
+	QVERIFY(c.chunkedStorage());
+	QCOMPARE(snapshot.data.size(), 5);
+	QCOMPARE(snapshot.data.at(4), QStringLiteral("c"));
+}
+
+/*!
+ * append, insert and remove rows of a column with the out-of-core storage across the page boundaries,
+ * the values and the statistics are the same as with the storage in the memory.
+ */
+void ColumnTest::testOutOfCoreStorage() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Double"), Column::ColumnMode::Double);
+	project.addChild(c);
+	const int rows = ColumnStore::PageRows + 5;
+	QVector<double> values(rows);
+	for (int i = 0; i < rows; ++i)
+		values[i] = i;
+	c->replaceValues(-1, values);
+
+	QVERIFY(c->setOutOfCoreStorage(true));
+	QVERIFY(c->outOfCoreStorage());
+	QVERIFY(c->store());
+	QVERIFY(QFile::exists(c->store()->fileName()));
+	QCOMPARE(c->store()->rowCount(), (qint64)rows);
+	QCOMPARE(c->rowCount(), rows);
+	QCOMPARE(c->valueAt(ColumnStore::PageRows), (double)ColumnStore::PageRows);
+	QCOMPARE(c->valueAt(rows - 1), rows - 1.);
+	QCOMPARE(c->minimum(), 0.);
+	QCOMPARE(c->maximum(), rows - 1.);
+
+	// the statistics are determined streaming over the pages
+	const auto& stats = c->statistics();
+	QCOMPARE(stats.size, rows);
+	QCOMPARE(stats.arithmeticMean, (rows - 1) / 2.);
+	QVERIFY(std::abs(stats.variance - (double)rows * (rows + 1) / 12.) < 1e-6 * stats.variance);
+	QVERIFY(std::abs(stats.skewness) < 1e-6);
+
+	// append
+	c->replaceValues(rows, {-1., (double)rows});
+	QVERIFY(c->outOfCoreStorage());
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(rows), -1.);
+	QCOMPARE(c->minimum(), -1.);
+
+	c->undoStack()->undo();
+	QVERIFY(c->outOfCoreStorage());
+	QCOMPARE(c->rowCount(), rows);
+	c->undoStack()->redo();
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(rows + 1), (double)rows);
+
+	// insert in front of the page boundary, the values behind it are moved to the next page
+	const int before = ColumnStore::PageRows - 1;
+	c->insertRows(before, 3);
+	QVERIFY(c->outOfCoreStorage());
+	QCOMPARE(c->rowCount(), rows + 5);
+	QCOMPARE(c->valueAt(before - 1), before - 1.);
+	QVERIFY(std::isnan(c->valueAt(before)));
+	QVERIFY(std::isnan(c->valueAt(before + 2)));
+	QCOMPARE(c->valueAt(before + 3), (double)before);
+	QCOMPARE(c->valueAt(rows + 4), (double)rows);
+
+	c->undoStack()->undo();
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(before), (double)before);
+
+	// remove rows across the page boundary
+	c->removeRows(10, ColumnStore::PageRows);
+	QVERIFY(c->outOfCoreStorage());
+	QCOMPARE(c->rowCount(), rows + 2 - ColumnStore::PageRows);
+	QCOMPARE(c->valueAt(9), 9.);
+	QCOMPARE(c->valueAt(10), 10. + ColumnStore::PageRows);
+
+	c->undoStack()->undo();
+	QVERIFY(c->outOfCoreStorage());
+	QCOMPARE(c->rowCount(), rows + 2);
+	QCOMPARE(c->valueAt(ColumnStore::PageRows), (double)ColumnStore::PageRows);
+
+	// data() returns to the storage in the memory
+	const auto* data = static_cast<QVector<double>*>(c->data());
+	QVERIFY(!c->outOfCoreStorage());
+	QVERIFY(!c->store());
+	QCOMPARE(data->size(), rows + 2);
+	QCOMPARE(data->at(ColumnStore::PageRows), (double)ColumnStore::PageRows);
+	QCOMPARE(data->at(rows), -1.);
+}
+
+/*!
+ * the row count of a store is not limited to INT_MAX, the rows of the column are.
+ */
+void ColumnTest::testOutOfCoreStorageRowCount() {
+	auto* store = new ColumnStore(AbstractColumn::ColumnMode::BigInt);
+	QVERIFY(store->isValid());
+	const qint64 rows = qint64(INT_MAX) + 10;
+	if (!store->resize(rows, false)) {
+		delete store;
+		QSKIP("The file system doesn't support files of this size.");
+	}
+
+	// only the accessed pages are mapped
+	store->setValue<qint64>(0, 1);
+	store->setValue<qint64>(rows - 1, rows);
+	QCOMPARE(store->value<qint64>(rows - 1), rows);
+
+	Column c(QStringLiteral("BigInt"), Column::ColumnMode::BigInt);
+	c.setStore(store);
+	QVERIFY(c.outOfCoreStorage());
+	QCOMPARE(c.store()->rowCount(), rows);
+	QCOMPARE(c.rowCount(), INT_MAX);
+	QCOMPARE(c.bigIntAt(0), (qint64)1);
+
+	// a store with a different mode is deleted
+	Column d(QStringLiteral("Double"), Column::ColumnMode::Double);
+	d.setStore(new ColumnStore(AbstractColumn::ColumnMode::Integer));
+	QVERIFY(!d.outOfCoreStorage());
+}
+
+void ColumnTest::testModeConversionNumeric() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Test"), Column::ColumnMode::Double);
+	project.addChild(c);
+	c->replaceValues(-1, {1.4, 2.5, -3.6, NAN, 1e10});
+
+	c->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(c->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(c->rowCount(), 5);
+	QCOMPARE(c->bigIntAt(0), 1LL);
+	QCOMPARE(c->bigIntAt(1), 3LL);
+	QCOMPARE(c->bigIntAt(2), -4LL);
+	QCOMPARE(c->bigIntAt(3), 0LL);
+	QCOMPARE(c->bigIntAt(4), 10000000000LL);
+	QCOMPARE(c->maximum(), 1e10);
+
+	c->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(c->integerAt(2), -4);
+
+	c->setColumnMode(AbstractColumn::ColumnMode::Double);
+	QCOMPARE(c->valueAt(1), 3.);
+	QCOMPARE(c->valueAt(3), 0.);
+
+	// the original values are restored on undo
+	c->undoStack()->undo();
+	c->undoStack()->undo();
+	c->undoStack()->undo();
+	QCOMPARE(c->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(c->valueAt(0), 1.4);
+	QVERIFY(std::isnan(c->valueAt(3)));
+}
+
+void ColumnTest::testModeConversionText() {
+	const QLocale locale;
+	QLocale::setDefault(QLocale::C); // . as decimal separator
+
+	// big enough to be converted in parallel
+	const int rows = 100000;
+	QVector<QString> texts;
+	texts.reserve(rows);
+	for (int i = 0; i < rows; ++i)
+		texts << (i % 10 == 0 ? QStringLiteral("abc") : QString::number(i + 0.5));
+
+	Column c(QStringLiteral("Test"), Column::ColumnMode::Text);
+	c.replaceTexts(-1, texts);
+	c.setColumnMode(AbstractColumn::ColumnMode::Double);
+	QCOMPARE(c.rowCount(), rows);
+	for (int i = 0; i < rows; ++i) {
+		if (i % 10 == 0)
+			QVERIFY(std::isnan(c.valueAt(i)));
+		else
+			QCOMPARE(c.valueAt(i), i + 0.5);
+	}
+
+	Column d(QStringLiteral("Test"), Column::ColumnMode::Text);
+	d.replaceTexts(-1, {QStringLiteral("1"), QStringLiteral("-20"), QStringLiteral("x"), QString()});
+	d.setColumnMode(AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(d.integerAt(0), 1);
+	QCOMPARE(d.integerAt(1), -20);
+	QCOMPARE(d.integerAt(2), 0);
+	QCOMPARE(d.integerAt(3), 0);
+
+	QLocale::setDefault(locale);
+}
+
+void ColumnTest::testModeConversionDateTime() {
+	const auto& dateTime = QDateTime::fromMSecsSinceEpoch(0, Qt::UTC);
+	Column c(QStringLiteral("Test"), Column::ColumnMode::DateTime);
+	c.replaceDateTimes(-1, {dateTime, dateTime.addMSecs(1500), QDateTime()});
+
+	c.setColumnMode(AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(c.bigIntAt(0), 0LL);
+	QCOMPARE(c.bigIntAt(1), 1500LL);
+	QCOMPARE(c.bigIntAt(2), 0LL);
+
+	c.setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(c.dateTimeAt(0), dateTime);
+	QCOMPARE(c.dateTimeAt(1), dateTime.addMSecs(1500));
+	QCOMPARE(c.dateTimeAt(2), dateTime);
+}
+
+// ##############################################################################
+// ################################  tracing  ###################################
+// ##############################################################################
+
+/*!
+ * the scopes and counters are written in the Chrome trace event format, nothing is recorded after the tracing was stopped.
+ */
+void ColumnTest::testTraceStatisticsCache() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.close();
+
+	Column column(QStringLiteral("column"));
+	column.replaceValues(-1, QVector<double>{1., 2., 3.});
+
+	QVERIFY(!Trace::isEnabled());
+	Trace::start(file.fileName());
+	QVERIFY(Trace::isEnabled());
+	{
+		PERFTRACE(QStringLiteral("statistics"));
+		column.statistics(); // calculated
+		column.statistics(); // cached
+		column.statistics(); // cached
+	}
+	Trace::stop();
+	QVERIFY(!Trace::isEnabled());
+	column.statistics(); // not traced
+
+	QVERIFY(file.open());
+	const auto events = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("traceEvents")).toArray();
+	int scopes = 0;
+	int cacheHits = 0;
+	for (const auto& value : events) {
+		const auto event = value.toObject();
+		const auto phase = event.value(QLatin1String("ph")).toString();
+		const auto name = event.value(QLatin1String("name")).toString();
+		if (phase == QLatin1String("X") && name == QLatin1String("statistics")) {
+			++scopes;
+			QVERIFY(event.value(QLatin1String("dur")).toDouble() >= 0.);
+		} else if (phase == QLatin1String("C") && name == QLatin1String("column statistics cache hits"))
+			cacheHits = event.value(QLatin1String("args")).toObject().value(name).toInt();
+	}
+	QCOMPARE(scopes, 1);
+	QCOMPARE(cacheHits, 2);
+}
+
+/*!
+ * the events are written to the file during the tracing, all events are available after the tracing was stopped.
+ */
+void ColumnTest::testTraceManyEvents() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.close();
+
+	const int count = 100000; // more events than buffered in memory
+	Trace::start(file.fileName());
+	for (int i = 0; i < count; ++i) {
+		PERFTRACE(QStringLiteral("scope"));
+	}
+	Trace::stop();
+
+	QVERIFY(file.open());
+	const auto events = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("traceEvents")).toArray();
+	int scopes = 0;
+	for (const auto& value : events) {
+		const auto event = value.toObject();
+		if (event.value(QLatin1String("ph")).toString() == QLatin1String("X") && event.value(QLatin1String("name")).toString() == QLatin1String("scope"))
+			++scopes;
+	}
+	QCOMPARE(scopes, count);
+}
+
 QTEST_MAIN(ColumnTest)
@@ -122,6 +122,40 @@ private Q_SLOTS:
 
 	void testRowCountValueLabels();
 	void testRowCountValueLabelsDateTime();
+
+	// cached values on appended rows
+	void testAppendRowsProperties();
+	void testAppendRowsMinMaxInteger();
+	void testAppendRowsStatistics();
+
+	// data snapshots
+	void testSnapshot();
+	void testSnapshotWrongMode();
+
+	// undo data
+	void testUndoReplaceValues();
+	void testUndoValuesDeltaSpill();
+	void testUndoCopy();
+
+	// insert and remove rows
+	void testInsertRemoveRowsTextDateTime();
+
+	// chunked storage
+	void testChunkedStorage();
+	void testChunkedStorageText();
+
+	// out-of-core storage
+	void testOutOfCoreStorage();
+	void testOutOfCoreStorageRowCount();
+
+	// column mode conversion
+	void testModeConversionNumeric();
+	void testModeConversionText();
+	void testModeConversionDateTime();
+
+	// tracing
+	void testTraceStatisticsCache();
+	void testTraceManyEvents();
 };
 
 #endif // COLUMNTEST_H
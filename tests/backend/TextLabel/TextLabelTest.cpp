@@ -14,6 +14,13 @@
 #include "backend/worksheet/TextLabel.h"
 #include "backend/worksheet/TextLabelPrivate.h"
 #include "kdefrontend/widgets/LabelWidget.h"
+#include "tools/TeXRenderer.h"
+
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QUuid>
+#include <QtConcurrent/QtConcurrentRun>
 
 struct TextProperties {
 	QColor fontColor;
@@ -309,4 +316,108 @@ void TextLabelTest::multiLabelEditColorChangeSelection() {
 	}
 }
 
+// ##############################################################################
+// ############################## LaTeX rendering ###############################
+// ##############################################################################
+
+namespace {
+TeXRenderer::Formatting teXFormatting() {
+	TeXRenderer::Formatting format;
+	format.fontColor = Qt::black;
+	format.backgroundColor = Qt::white;
+	format.fontSize = 12;
+	format.fontFamily = QStringLiteral("Computer Modern");
+	format.dpi = 300;
+	return format;
+}
+}
+
+// the image is read from the disk cache without rendering it
+void TextLabelTest::teXRendererCacheHit() {
+	QStandardPaths::setTestModeEnabled(true);
+	const auto format = teXFormatting();
+	const QString teXString = QStringLiteral("$x^2$ ") + QUuid::createUuid().toString();
+	const QByteArray image("cached image");
+
+	const QString fileName = TeXRenderer::diskCacheFileName(TeXRenderer::cacheKey(teXString, format));
+	QFile file(fileName);
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write(image);
+	file.close();
+
+	auto future = TeXRenderer::renderImageLaTeXCached(teXString, format);
+	QVERIFY(future.isFinished());
+	QVERIFY(future.result().successful);
+	QCOMPARE(future.result().data, image);
+	QVERIFY(!TeXRenderer::pendingRenderings.contains(TeXRenderer::cacheKey(teXString, format)));
+
+	// the second request is served from the memory cache
+	QFile::remove(fileName);
+	future = TeXRenderer::renderImageLaTeXCached(teXString, format);
+	QVERIFY(future.isFinished());
+	QCOMPARE(future.result().data, image);
+}
+
+// identical requests share the rendering in progress
+void TextLabelTest::teXRendererPendingRendering() {
+	QStandardPaths::setTestModeEnabled(true);
+	const auto format = teXFormatting();
+	const QString teXString = QStringLiteral("$y^2$ ") + QUuid::createUuid().toString();
+	const QString otherTeXString = QStringLiteral("$z^2$ ") + QUuid::createUuid().toString();
+
+	// block the render pool so the renderings can't finish during the requests
+	auto* pool = TeXRenderer::renderPool();
+	const int maxThreadCount = pool->maxThreadCount();
+	pool->setMaxThreadCount(1);
+	QSemaphore semaphore;
+	auto blocker = QtConcurrent::run(pool, [&semaphore]() {
+		semaphore.acquire();
+	});
+
+	const auto future1 = TeXRenderer::renderImageLaTeXCached(teXString, format);
+	const auto future2 = TeXRenderer::renderImageLaTeXCached(teXString, format);
+	const auto future3 = TeXRenderer::renderImageLaTeXCached(otherTeXString, format);
+	QVERIFY(!future1.isFinished());
+	QVERIFY(!future2.isFinished());
+	QVERIFY(!future3.isFinished());
+	QVERIFY(TeXRenderer::pendingRenderings.contains(TeXRenderer::cacheKey(teXString, format)));
+	QVERIFY(TeXRenderer::pendingRenderings.contains(TeXRenderer::cacheKey(otherTeXString, format)));
+	QCOMPARE(TeXRenderer::pendingRenderings.count(TeXRenderer::cacheKey(teXString, format)), 1);
+
+	semaphore.release();
+	blocker.waitForFinished();
+	future1.waitForFinished();
+	future3.waitForFinished();
+	QVERIFY(future2.isFinished()); // shares the rendering of future1
+	pool->setMaxThreadCount(maxThreadCount);
+}
+
+// outdated and least recently used files are removed from the disk cache
+void TextLabelTest::teXRendererDiskCacheCleanup() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+
+	const auto now = QDateTime::currentDateTime();
+	const QVector<QDateTime> times{now.addDays(-40), now.addSecs(-60), now};
+	QStringList fileNames;
+	for (int i = 0; i < times.size(); ++i) {
+		fileNames << dir.path() + QStringLiteral("/file%1.pdf").arg(i);
+		QFile file(fileNames.constLast());
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write(QByteArray(1000, 'x'));
+		QVERIFY(file.setFileTime(times.at(i), QFileDevice::FileModificationTime));
+	}
+
+	// the file not used for 40 days is removed
+	TeXRenderer::cleanupDiskCache(dir.path(), 1000000, 30);
+	QVERIFY(!QFile::exists(fileNames.at(0)));
+	QVERIFY(QFile::exists(fileNames.at(1)));
+	QVERIFY(QFile::exists(fileNames.at(2)));
+
+	// only the most recently used file fits into the size limit
+	TeXRenderer::cleanupDiskCache(dir.path(), 1500, 30);
+	QVERIFY(!QFile::exists(fileNames.at(1)));
+	QVERIFY(QFile::exists(fileNames.at(2)));
+}
+
 QTEST_MAIN(TextLabelTest)
@@ -22,6 +22,11 @@ private Q_SLOTS:
 	void multiLabelEditColorChange();
 	void multiLabelEditTextChange();
 	void multiLabelEditColorChangeSelection();
+
+	// LaTeX rendering
+	void teXRendererCacheHit();
+	void teXRendererPendingRendering();
+	void teXRendererDiskCacheCleanup();
 };
 
 #endif
@@ -0,0 +1,945 @@
+/*
+	File                 : BenchmarkTest.cpp
+	Project              : LabPlot
+	Description          : Benchmarks of the core hot paths
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "BenchmarkTest.h"
+#include "backend/core/Project.h"
+#include "backend/core/column/Column.h"
+#include "backend/datasources/filters/AsciiFilter.h"
+#include "backend/datasources/filters/BinaryFilter.h"
+#include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/HDF5Filter.h"
+#include "backend/datasources/filters/JsonFilter.h"
+#include "backend/datasources/filters/MatioFilter.h"
+#include "backend/datasources/filters/NetCDFFilter.h"
+#include "backend/datasources/filters/OdsFilter.h"
+#include "backend/datasources/filters/ROOTFilter.h"
+#include "backend/datasources/filters/ReadStatFilter.h"
+#include "backend/datasources/filters/SQLFilter.h"
+#include "backend/datasources/filters/SpiceFilter.h"
+#include "backend/datasources/filters/XLSXFilter.h"
+#include "backend/gsl/ExpressionParser.h"
+#include "backend/lib/macros.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/worksheet/Worksheet.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
+#include "backend/worksheet/plots/cartesian/XYCurve.h"
+
+extern "C" {
+#include "backend/nsl/nsl_conv.h"
+#include "backend/nsl/nsl_corr.h"
+#include "backend/nsl/nsl_dft.h"
+#include "backend/nsl/nsl_diff.h"
+#include "backend/nsl/nsl_filter.h"
+#include "backend/nsl/nsl_geom_linesim.h"
+#include "backend/nsl/nsl_int.h"
+#include "backend/nsl/nsl_smooth.h"
+}
+#include "backend/nsl/nsl_stats.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPixmap>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QXmlStreamWriter>
+
+#ifdef HAVE_HDF5
+#include <hdf5.h>
+#endif
+#ifdef HAVE_NETCDF
+#include <netcdf.h>
+#endif
+#ifdef HAVE_FITS
+extern "C" {
+#include "fitsio.h"
+}
+#endif
+#ifdef HAVE_QXLSX
+#include "xlsxdocument.h"
+#endif
+
+/*!
+ * Benchmarks of the core hot paths with synthetic data of several sizes.
+ *
+ * Every benchmark is run LABPLOT_BENCHMARK_REPETITIONS times (default 5), the median and
+ * the minimal time are reported. The environment variables control the output:
+ * - LABPLOT_BENCHMARK_OUTPUT: file the results are written to as JSON
+ * - LABPLOT_BENCHMARK_BASELINE: JSON file of a previous run, a benchmark fails if its median
+ *   exceeds the median in the baseline by more than LABPLOT_BENCHMARK_TOLERANCE (relative, default 0.2)
+ *
+ * The import filters without synthetic data read the small data files of the filter tests. Their times are
+ * dominated by opening the files and are not compared with the baseline.
+ */
+
+namespace {
+const double MinRegression = 1.; // ms, smaller differences are considered as noise
+
+// random walk with a fixed seed, the same data is generated in every run
+QVector<double> randomData(int size) {
+	QRandomGenerator generator(12345);
+	QVector<double> data(size);
+	double value = 0.;
+	for (auto& d : data) {
+		value += generator.generateDouble() - 0.5;
+		d = value;
+	}
+	return data;
+}
+
+QVector<double> indexData(int size) {
+	QVector<double> data(size);
+	for (int i = 0; i < size; ++i)
+		data[i] = i;
+	return data;
+}
+
+// spreadsheet with an index column and a random walk
+Spreadsheet* createSpreadsheet(int size) {
+	auto* sheet = new Spreadsheet(QStringLiteral("data"), false);
+	sheet->setColumnCount(2);
+	sheet->setRowCount(size);
+	sheet->column(0)->replaceValues(0, indexData(size));
+	sheet->column(1)->replaceValues(0, randomData(size));
+	return sheet;
+}
+
+// project with the data of the given size plotted in a worksheet
+XYCurve* createPlot(Project& project, int size) {
+	auto* sheet = createSpreadsheet(size);
+	project.addChild(sheet);
+
+	auto* worksheet = new Worksheet(QStringLiteral("worksheet"));
+	project.addChild(worksheet);
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	worksheet->addChild(plot);
+	plot->setType(CartesianPlot::Type::TwoAxes);
+
+	auto* curve = new XYCurve(QStringLiteral("curve"));
+	plot->addChild(curve);
+	curve->setXColumn(sheet->column(0));
+	curve->setYColumn(sheet->column(1));
+	return curve;
+}
+
+// values of the synthetic files with three columns: index, random walk and its negative, stored row by row
+QVector<double> tableData(int size) {
+	const auto data = randomData(size);
+	QVector<double> values(3 * size);
+	for (int i = 0; i < size; ++i) {
+		values[3 * i] = i;
+		values[3 * i + 1] = data.at(i);
+		values[3 * i + 2] = -data.at(i);
+	}
+	return values;
+}
+
+#ifdef HAVE_HDF5
+// 2D data set "/data" with \c size rows and three columns
+void writeHDF5File(const QString& fileName, int size) {
+	const auto values = tableData(size);
+	const hsize_t dims[2] = {(hsize_t)size, 3};
+	hid_t file = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	hid_t space = H5Screate_simple(2, dims, nullptr);
+	hid_t dataset = H5Dcreate2(file, "/data", H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.constData());
+	H5Dclose(dataset);
+	H5Sclose(space);
+	H5Fclose(file);
+}
+#endif
+
+#ifdef HAVE_NETCDF
+// 2D variable "data" with \c size rows and three columns
+void writeNetCDFFile(const QString& fileName, int size) {
+	const auto values = tableData(size);
+	int ncid, dimids[2], varid;
+	nc_create(qPrintable(fileName), NC_CLOBBER | NC_64BIT_OFFSET, &ncid);
+	nc_def_dim(ncid, "rows", size, &dimids[0]);
+	nc_def_dim(ncid, "cols", 3, &dimids[1]);
+	nc_def_var(ncid, "data", NC_DOUBLE, 2, dimids, &varid);
+	nc_enddef(ncid);
+	nc_put_var_double(ncid, varid, values.constData());
+	nc_close(ncid);
+}
+#endif
+
+#ifdef HAVE_FITS
+// image with \c size rows and three columns in the primary HDU
+void writeFITSFile(const QString& fileName, int size) {
+	auto values = tableData(size);
+	fitsfile* file;
+	int status = 0;
+	long naxes[2] = {3, size};
+	fits_create_file(&file, qPrintable(QLatin1Char('!') + fileName), &status); // '!' overwrites an existing file
+	fits_create_img(file, DOUBLE_IMG, 2, naxes, &status);
+	fits_write_img(file, TDOUBLE, 1, values.size(), values.data(), &status);
+	fits_close_file(file, &status);
+}
+#endif
+
+#ifdef HAVE_QXLSX
+// "Sheet1" with \c size rows and three columns
+void writeXLSXFile(const QString& fileName, int size) {
+	const auto values = tableData(size);
+	QXlsx::Document document;
+	for (int i = 0; i < size; ++i)
+		for (int j = 0; j < 3; ++j)
+			document.write(i + 1, j + 1, values.at(3 * i + j));
+	document.saveAs(fileName);
+}
+#endif
+}
+
+void BenchmarkTest::initTestCase() {
+	CommonTest::initTestCase();
+
+	bool ok;
+	const int repetitions = qEnvironmentVariableIntValue("LABPLOT_BENCHMARK_REPETITIONS", &ok);
+	if (ok && repetitions > 0)
+		m_repetitions = repetitions;
+
+	const double tolerance = qEnvironmentVariable("LABPLOT_BENCHMARK_TOLERANCE").toDouble(&ok);
+	if (ok && tolerance >= 0.)
+		m_tolerance = tolerance;
+
+	const QString baselineFileName = qEnvironmentVariable("LABPLOT_BENCHMARK_BASELINE");
+	if (!baselineFileName.isEmpty()) {
+		QFile file(baselineFileName);
+		QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(QStringLiteral("failed to open the baseline ") + baselineFileName));
+		const auto benchmarks = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("benchmarks")).toArray();
+		for (const auto& benchmark : benchmarks) {
+			const auto object = benchmark.toObject();
+			m_baseline[object.value(QLatin1String("name")).toString()] = object.value(QLatin1String("median")).toDouble();
+		}
+		WARN("Comparing with " << m_baseline.size() << " benchmarks in " << STDSTRING(baselineFileName))
+	}
+}
+
+void BenchmarkTest::cleanupTestCase() {
+	const QString fileName = qEnvironmentVariable("LABPLOT_BENCHMARK_OUTPUT");
+	if (fileName.isEmpty())
+		return;
+
+	QJsonArray benchmarks;
+	for (const auto& result : qAsConst(m_results)) {
+		QJsonObject benchmark;
+		benchmark[QLatin1String("name")] = result.name;
+		benchmark[QLatin1String("median")] = result.median;
+		benchmark[QLatin1String("min")] = result.min;
+		benchmark[QLatin1String("repetitions")] = result.repetitions;
+		benchmark[QLatin1String("baseline")] = result.baseline;
+		benchmarks << benchmark;
+	}
+
+	QJsonObject root;
+	root[QLatin1String("date")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+	root[QLatin1String("qt")] = QLatin1String(qVersion());
+	root[QLatin1String("threads")] = QThread::idealThreadCount();
+	root[QLatin1String("unit")] = QLatin1String("ms");
+	root[QLatin1String("benchmarks")] = benchmarks;
+
+	QFile file(fileName);
+	QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(QStringLiteral("failed to write the results to ") + fileName));
+	file.write(QJsonDocument(root).toJson());
+	WARN("Results written to " << STDSTRING(fileName))
+}
+
+/*!
+ * adds the data rows for the sizes of the synthetic data.
+ */
+void BenchmarkTest::addSizes(const QVector<int>& sizes) {
+	QTest::addColumn<int>("size");
+	for (int size : sizes)
+		QTest::addRow("%d", size) << size;
+}
+
+/*!
+ * runs \c run for the configured number of repetitions, \c prepare is called before every run and is not measured.
+ * The result is stored under the name of the test function and the data tag and compared with the baseline
+ * if \c compareWithBaseline is \c true.
+ */
+void BenchmarkTest::measure(const std::function<void()>& run, const std::function<void()>& prepare, bool compareWithBaseline) {
+	QVector<double> times;
+	QElapsedTimer timer;
+	for (int i = 0; i < m_repetitions; ++i) {
+		if (prepare)
+			prepare();
+		timer.start();
+		run();
+		times << timer.nsecsElapsed() / 1.e6;
+	}
+	std::sort(times.begin(), times.end());
+
+	Result result;
+	result.name = QLatin1String(QTest::currentTestFunction());
+	if (QTest::currentDataTag())
+		result.name += QLatin1Char(':') + QLatin1String(QTest::currentDataTag());
+	result.median = times.at(times.size() / 2);
+	result.min = times.constFirst();
+	result.repetitions = m_repetitions;
+	result.baseline = compareWithBaseline;
+	m_results << result;
+	WARN(STDSTRING(result.name) << ": median = " << result.median << " ms, min = " << result.min << " ms")
+
+	if (!compareWithBaseline)
+		return;
+
+	const auto it = m_baseline.constFind(result.name);
+	if (it != m_baseline.constEnd()) {
+		const double baseline = it.value();
+		QVERIFY2(result.median <= baseline * (1. + m_tolerance) || result.median - baseline < MinRegression,
+				 qPrintable(QStringLiteral("regression: %1 ms, baseline %2 ms").arg(result.median).arg(baseline)));
+	}
+}
+
+// ##############################################################################
+// #################################  column  ###################################
+// ##############################################################################
+
+void BenchmarkTest::columnStatistics_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::columnStatistics() {
+	QFETCH(int, size);
+	Column column(QStringLiteral("column"));
+	column.replaceValues(-1, randomData(size));
+
+	measure(
+		[&column]() {
+			column.statistics();
+		},
+		[&column]() {
+			column.invalidateProperties();
+		});
+}
+
+// ##############################################################################
+// ################################  plotting  ##################################
+// ##############################################################################
+
+void BenchmarkTest::curveRetransform_data() {
+	addSizes({1000, 100000, 1000000});
+}
+
+void BenchmarkTest::curveRetransform() {
+	QFETCH(int, size);
+	Project project;
+	auto* curve = createPlot(project, size);
+
+	measure([curve]() {
+		curve->retransform();
+	});
+}
+
+void BenchmarkTest::plotAutoScale_data() {
+	addSizes({1000, 100000, 1000000});
+}
+
+void BenchmarkTest::plotAutoScale() {
+	QFETCH(int, size);
+	Project project;
+	auto* curve = createPlot(project, size);
+	auto* plot = static_cast<CartesianPlot*>(curve->parentAspect());
+
+	measure(
+		[plot]() {
+			plot->scaleAuto(-1, -1);
+		},
+		[plot, curve]() {
+			// the data ranges are determined again
+			const_cast<AbstractColumn*>(curve->xColumn())->invalidateProperties();
+			const_cast<AbstractColumn*>(curve->yColumn())->invalidateProperties();
+			plot->setRangeDirty(Dimension::X, 0, true);
+			plot->setRangeDirty(Dimension::Y, 0, true);
+		});
+}
+
+// ##############################################################################
+// ##############################  expressions  #################################
+// ##############################################################################
+
+void BenchmarkTest::expressionEvaluation_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::expressionEvaluation() {
+	QFETCH(int, size);
+	const QString expr = QStringLiteral("sin(x)^2 + cos(x)*exp(-x/100)");
+	const QStringList vars{QStringLiteral("x")};
+	QVector<double> x = indexData(size);
+	const QVector<QVector<double>*> xVectors{&x};
+	QVector<double> y(size);
+
+	measure([&]() {
+		ExpressionParser::evaluateCartesian(expr, vars, xVectors, &y);
+	});
+	QCOMPARE(y.at(0), 1.);
+}
+
+// ##############################################################################
+// ############################  import filters  ################################
+// ##############################################################################
+
+void BenchmarkTest::asciiImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::asciiImport() {
+	QFETCH(int, size);
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	{
+		const auto data = randomData(size);
+		QTextStream out(&file);
+		out << "x\ty\tz\n";
+		for (int i = 0; i < size; ++i)
+			out << i << '\t' << data.at(i) << '\t' << -data.at(i) << '\n';
+	}
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	AsciiFilter filter;
+	measure([&]() {
+		filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+}
+
+void BenchmarkTest::binaryImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::binaryImport() {
+	QFETCH(int, size);
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	{
+		const auto data = randomData(size);
+		QDataStream out(&file);
+		for (int i = 0; i < size; ++i)
+			out << static_cast<double>(i) << data.at(i) << -data.at(i);
+	}
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	filter.setDataType(BinaryFilter::DataType::REAL64);
+	filter.setByteOrder(QDataStream::ByteOrder::BigEndian);
+	filter.setVectors(3);
+	measure([&]() {
+		filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+}
+
+void BenchmarkTest::jsonImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::jsonImport() {
+	QFETCH(int, size);
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	{
+		const auto data = randomData(size);
+		QTextStream out(&file);
+		out << "[\n";
+		for (int i = 0; i < size; ++i)
+			out << (i > 0 ? ",\n" : "") << '[' << i << ", " << data.at(i) << ", " << -data.at(i) << ']';
+		out << "\n]\n";
+	}
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+	filter.setDataRowType(QJsonValue::Array);
+	measure([&]() {
+		filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+}
+
+void BenchmarkTest::sqlImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::sqlImport() {
+	QFETCH(int, size);
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.close();
+
+	const QString connection = QStringLiteral("BenchmarkTest");
+	{
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+		db.setDatabaseName(file.fileName());
+		QVERIFY(db.open());
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("CREATE TABLE data (x INTEGER, y REAL, z REAL)")));
+		const auto data = randomData(size);
+		db.transaction();
+		QVERIFY(q.prepare(QStringLiteral("INSERT INTO data VALUES (?, ?, ?)")));
+		for (int i = 0; i < size; ++i) {
+			q.addBindValue(i);
+			q.addBindValue(data.at(i));
+			q.addBindValue(-data.at(i));
+			q.exec();
+		}
+		db.commit();
+		db.close();
+	}
+	QSqlDatabase::removeDatabase(connection);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	SQLFilter filter;
+	filter.setTable(QStringLiteral("data"));
+	measure([&]() {
+		filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+}
+
+void BenchmarkTest::sqlExport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::sqlExport() {
+	QFETCH(int, size);
+	std::unique_ptr<Spreadsheet> spreadsheet(createSpreadsheet(size));
+
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.close();
+
+	SQLFilter filter;
+	measure(
+		[&]() {
+			filter.write(file.fileName(), spreadsheet.get());
+		},
+		[&]() {
+			// the table is created on every run
+			file.open();
+			file.resize(0);
+			file.close();
+		});
+	QCOMPARE(filter.lastErrors().size(), 0);
+}
+
+void BenchmarkTest::hdf5Import_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::hdf5Import() {
+#ifdef HAVE_HDF5
+	QFETCH(int, size);
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("data.h5"));
+	writeHDF5File(fileName, size);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	HDF5Filter filter;
+	filter.setCurrentDataSetName(QLatin1String("/data"));
+	measure([&]() {
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+#else
+	QSKIP("HDF5 support not available");
+#endif
+}
+
+void BenchmarkTest::netcdfImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::netcdfImport() {
+#ifdef HAVE_NETCDF
+	QFETCH(int, size);
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("data.nc"));
+	writeNetCDFFile(fileName, size);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	NetCDFFilter filter;
+	filter.setCurrentVarName(QLatin1String("data"));
+	measure([&]() {
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+#else
+	QSKIP("NetCDF support not available");
+#endif
+}
+
+void BenchmarkTest::fitsImport_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::fitsImport() {
+#ifdef HAVE_FITS
+	QFETCH(int, size);
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("data.fits"));
+	writeFITSFile(fileName, size);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	FITSFilter filter;
+	measure([&]() {
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+#else
+	QSKIP("FITS support not available");
+#endif
+}
+
+void BenchmarkTest::xlsxImport_data() {
+	addSizes({1000, 10000, 100000});
+}
+
+void BenchmarkTest::xlsxImport() {
+#ifdef HAVE_QXLSX
+	QFETCH(int, size);
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("data.xlsx"));
+	writeXLSXFile(fileName, size);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	XLSXFilter filter;
+	filter.setCurrentSheet(QStringLiteral("Sheet1"));
+	filter.setCurrentRange(QStringLiteral("A1:C%1").arg(size));
+	measure([&]() {
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	});
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), size);
+#else
+	QSKIP("XLSX support not available");
+#endif
+}
+
+void BenchmarkTest::matioImport() {
+#ifdef HAVE_MATIO
+	const QString& fileName = QFINDTESTDATA(QLatin1String("../import_export/Matio/data/testmatrix_7.4_GLNX86.mat"));
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	MatioFilter filter;
+	filter.setCurrentVarName(QLatin1String("testmatrix"));
+	measure(
+		[&]() {
+			filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+		},
+		nullptr,
+		false);
+#else
+	QSKIP("Matio support not available");
+#endif
+}
+
+void BenchmarkTest::readStatImport() {
+#ifdef HAVE_READSTAT
+	const QString& fileName = QFINDTESTDATA(QLatin1String("../import_export/ReadStat/data/iris.sav"));
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	ReadStatFilter filter;
+	measure(
+		[&]() {
+			filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+		},
+		nullptr,
+		false);
+#else
+	QSKIP("ReadStat support not available");
+#endif
+}
+
+void BenchmarkTest::rootImport() {
+#ifdef HAVE_ZIP
+	const QString& fileName = QFINDTESTDATA(QLatin1String("../import_export/ROOT/data/advanced_zlib.root"));
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	ROOTFilter filter;
+	filter.setStartRow(1);
+	filter.setCurrentObject(QStringLiteral("Hist:variableBinHist;2"));
+	filter.setColumns({{QStringLiteral("center")}, {QStringLiteral("content")}, {QStringLiteral("error")}});
+	measure(
+		[&]() {
+			filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+		},
+		nullptr,
+		false);
+#else
+	QSKIP("ROOT support not available");
+#endif
+}
+
+void BenchmarkTest::odsImport() {
+#ifdef HAVE_ORCUS
+	const QString& fileName = QFINDTESTDATA(QLatin1String("../import_export/Ods/data/ranges-formula.ods"));
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	OdsFilter filter;
+	filter.setSelectedSheetNames(QStringList() << QStringLiteral("Sheet1"));
+	measure(
+		[&]() {
+			filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+		},
+		nullptr,
+		false);
+#else
+	QSKIP("ODS support not available");
+#endif
+}
+
+void BenchmarkTest::spiceImport() {
+	const QString& fileName = QFINDTESTDATA(QLatin1String("../import_export/Spice/data/ngspice/dc_binary.raw"));
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	SpiceFilter filter;
+	measure(
+		[&]() {
+			filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+		},
+		nullptr,
+		false);
+}
+
+// ##############################################################################
+// ################################  project  ###################################
+// ##############################################################################
+
+void BenchmarkTest::projectSave_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::projectSave() {
+	QFETCH(int, size);
+	Project project;
+	createPlot(project, size);
+
+	measure([&project]() {
+		QBuffer buffer;
+		buffer.open(QIODevice::WriteOnly);
+		QXmlStreamWriter writer(&buffer);
+		project.save(QPixmap(), &writer);
+	});
+}
+
+void BenchmarkTest::projectLoad_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::projectLoad() {
+	QFETCH(int, size);
+	QTemporaryFile file(QStringLiteral("XXXXXX_benchmark.lml"));
+	QVERIFY(file.open());
+	{
+		Project project;
+		createPlot(project, size);
+		QXmlStreamWriter writer(&file);
+		project.save(QPixmap(), &writer);
+	}
+	file.close();
+
+	measure([&file]() {
+		Project project;
+		QVERIFY(project.load(file.fileName()));
+	});
+}
+
+// ##############################################################################
+// ##################################  nsl  #####################################
+// ##############################################################################
+
+void BenchmarkTest::nslDFT_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslDFT() {
+	QFETCH(int, size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work]() {
+			nsl_dft_transform(work.data(), 1, work.size(), 0, nsl_dft_result_magnitude);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslSmooth_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslSmooth() {
+	QFETCH(int, size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work]() {
+			nsl_smooth_savgol(work.data(), work.size(), 15, 3, nsl_smooth_pad_interp);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslDiff_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslDiff() {
+	QFETCH(int, size);
+	const auto x = indexData(size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work, &x]() {
+			nsl_diff_first_deriv(x.constData(), work.data(), work.size(), 2);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslIntegration_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslIntegration() {
+	QFETCH(int, size);
+	const auto x = indexData(size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work, &x]() {
+			nsl_int_trapezoid(x.constData(), work.data(), work.size(), 0);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslFilter_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslFilter() {
+	QFETCH(int, size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work]() {
+			nsl_filter_fourier(work.data(), work.size(), nsl_filter_type_low_pass, nsl_filter_form_butterworth, 2, work.size() / 10, 0);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslConvolution_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslConvolution() {
+	QFETCH(int, size);
+	auto data = randomData(size);
+	QVector<double> response(101);
+	nsl_conv_standard_kernel(response.data(), response.size(), nsl_conv_kernel_gaussian);
+	QVector<double> out(size + response.size() - 1);
+
+	measure([&]() {
+		nsl_conv_convolution(data.data(),
+							 data.size(),
+							 response.data(),
+							 response.size(),
+							 nsl_conv_type_linear,
+							 nsl_conv_method_auto,
+							 nsl_conv_norm_none,
+							 nsl_conv_wrap_none,
+							 out.data());
+	});
+}
+
+void BenchmarkTest::nslCorrelation_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslCorrelation() {
+	QFETCH(int, size);
+	auto data = randomData(size);
+	auto response = data.mid(0, 1000);
+	QVector<double> out(size + response.size() - 1);
+
+	measure([&]() {
+		nsl_corr_correlation(data.data(), data.size(), response.data(), response.size(), nsl_corr_type_linear, nsl_corr_norm_none, out.data());
+	});
+}
+
+void BenchmarkTest::nslQuantile_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslQuantile() {
+	QFETCH(int, size);
+	const auto data = randomData(size);
+	QVector<double> work;
+
+	measure(
+		[&work]() {
+			nsl_stats_quantile(work.data(), 1, work.size(), 0.25, nsl_stats_quantile_type7);
+		},
+		[&work, &data]() {
+			work = data;
+			work.detach();
+		});
+}
+
+void BenchmarkTest::nslLineSimplification_data() {
+	addSizes({10000, 100000, 1000000});
+}
+
+void BenchmarkTest::nslLineSimplification() {
+	QFETCH(int, size);
+	const auto x = indexData(size);
+	const auto y = randomData(size);
+	QVector<size_t> index(size);
+
+	measure([&]() {
+		nsl_geom_linesim_douglas_peucker_auto(x.constData(), y.constData(), x.size(), index.data());
+	});
+}
+
+QTEST_MAIN(BenchmarkTest)
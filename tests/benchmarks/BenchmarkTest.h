@@ -0,0 +1,110 @@
+/*
+	File                 : BenchmarkTest.h
+	Project              : LabPlot
+	Description          : Benchmarks of the core hot paths
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef BENCHMARKTEST_H
+#define BENCHMARKTEST_H
+
+#include "../CommonTest.h"
+
+#include <QHash>
+
+#include <functional>
+
+class BenchmarkTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+	void cleanupTestCase();
+
+	// column
+	void columnStatistics_data();
+	void columnStatistics();
+
+	// plotting
+	void curveRetransform_data();
+	void curveRetransform();
+	void plotAutoScale_data();
+	void plotAutoScale();
+
+	// expressions
+	void expressionEvaluation_data();
+	void expressionEvaluation();
+
+	// import filters with synthetic data
+	void asciiImport_data();
+	void asciiImport();
+	void binaryImport_data();
+	void binaryImport();
+	void jsonImport_data();
+	void jsonImport();
+	void sqlImport_data();
+	void sqlImport();
+	void sqlExport_data();
+	void sqlExport();
+	void hdf5Import_data();
+	void hdf5Import();
+	void netcdfImport_data();
+	void netcdfImport();
+	void fitsImport_data();
+	void fitsImport();
+	void xlsxImport_data();
+	void xlsxImport();
+
+	// import filters with the small data files of the filter tests, not compared with the baseline
+	void matioImport();
+	void readStatImport();
+	void rootImport();
+	void odsImport();
+	void spiceImport();
+
+	// project
+	void projectSave_data();
+	void projectSave();
+	void projectLoad_data();
+	void projectLoad();
+
+	// nsl
+	void nslDFT_data();
+	void nslDFT();
+	void nslSmooth_data();
+	void nslSmooth();
+	void nslDiff_data();
+	void nslDiff();
+	void nslIntegration_data();
+	void nslIntegration();
+	void nslFilter_data();
+	void nslFilter();
+	void nslConvolution_data();
+	void nslConvolution();
+	void nslCorrelation_data();
+	void nslCorrelation();
+	void nslQuantile_data();
+	void nslQuantile();
+	void nslLineSimplification_data();
+	void nslLineSimplification();
+
+private:
+	struct Result {
+		QString name;
+		double median{0.}; // ms
+		double min{0.}; // ms
+		int repetitions{0};
+		bool baseline{true}; // compared with the baseline
+	};
+
+	void addSizes(const QVector<int>& sizes);
+	void measure(const std::function<void()>& run, const std::function<void()>& prepare = nullptr, bool compareWithBaseline = true);
+
+	int m_repetitions{5};
+	double m_tolerance{0.2};
+	QHash<QString, double> m_baseline; // median of the benchmarks in the baseline
+	QVector<Result> m_results;
+};
+#endif
@@ -10,11 +10,15 @@
 */
 
 #include "AsciiFilterTest.h"
+#include "backend/core/Workbook.h"
+#include "backend/datasources/BatchImport.h"
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QTemporaryDir>
+
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
 
@@ -1284,6 +1288,89 @@ void AsciiFilterTest::testMatrixHeader() {
 	QCOMPARE(matrix.cell<double>(4, 2), -0.284112);
 }
 
+// ##############################################################################
+// ########################  batch import of multiple files  ###################
+// ##############################################################################
+namespace {
+/*!
+ * writes \c count files with the columns "index" and "value" and 100 rows each, the index continues over the files.
+ */
+QStringList writeBatchFiles(const QTemporaryDir& dir, int count) {
+	QStringList fileNames;
+	for (int i = 0; i < count; ++i) {
+		const QString& fileName = dir.filePath(QStringLiteral("file%1.csv").arg(i));
+		QFile file(fileName);
+		if (!file.open(QIODevice::WriteOnly))
+			return {};
+
+		QTextStream out(&file);
+		out << "index,value\n";
+		for (int row = 0; row < 100; ++row)
+			out << i * 100 + row << "," << 0.5 * (i * 100 + row) << "\n";
+		fileNames << fileName;
+	}
+	return fileNames;
+}
+
+AbstractFileFilter* createBatchFilter() {
+	auto* filter = new AsciiFilter;
+	filter->setSeparatingCharacter(QStringLiteral(","));
+	filter->setHeaderEnabled(true);
+	filter->setHeaderLine(1);
+	return filter;
+}
+}
+
+void AsciiFilterTest::testBatchImportSpreadsheet() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const auto& fileNames = writeBatchFiles(dir, 8);
+	QCOMPARE(fileNames.size(), 8);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BatchImport import(&createBatchFilter);
+	import.setMaxThreadCount(4);
+	QVERIFY(import.importToSpreadsheet(fileNames, &spreadsheet, AbstractFileFilter::ImportMode::Replace));
+	QCOMPARE(import.lastErrors().size(), 0);
+
+	// the rows of all files one after another in the order of the file names
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 800);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("index"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("value"));
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	for (int row = 0; row < 800; ++row) {
+		QCOMPARE(spreadsheet.column(0)->integerAt(row), row);
+		QCOMPARE(spreadsheet.column(1)->valueAt(row), 0.5 * row);
+	}
+}
+
+void AsciiFilterTest::testBatchImportWorkbook() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	auto fileNames = writeBatchFiles(dir, 4);
+	QCOMPARE(fileNames.size(), 4);
+	fileNames << dir.filePath(QStringLiteral("missing.csv")); // not existing file is skipped
+
+	Workbook workbook(QStringLiteral("test"));
+	BatchImport import(&createBatchFilter);
+	QVERIFY(import.importToWorkbook(fileNames, &workbook));
+	QCOMPARE(import.lastErrors().isEmpty(), false);
+
+	// one spreadsheet per file
+	const auto& sheets = workbook.children<Spreadsheet>();
+	QCOMPARE(sheets.size(), 4);
+	for (int i = 0; i < sheets.size(); ++i) {
+		const auto* sheet = sheets.at(i);
+		QCOMPARE(sheet->name(), QStringLiteral("file%1").arg(i));
+		QCOMPARE(sheet->columnCount(), 2);
+		QCOMPARE(sheet->rowCount(), 100);
+		QCOMPARE(sheet->column(0)->integerAt(0), i * 100);
+		QCOMPARE(sheet->column(1)->valueAt(99), 0.5 * (i * 100 + 99));
+	}
+}
+
 // BENCHMARKS
 
 void AsciiFilterTest::benchDoubleImport_data() {
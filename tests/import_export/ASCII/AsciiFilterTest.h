@@ -89,6 +89,10 @@ private Q_SLOTS:
 	// matrix import
 	void testMatrixHeader();
 
+	// batch import of multiple files
+	void testBatchImportSpreadsheet();
+	void testBatchImportWorkbook();
+
 	// benchmarks
 
 	void benchDoubleImport_data();
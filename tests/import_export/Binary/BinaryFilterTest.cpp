@@ -9,6 +9,7 @@
 */
 
 #include "BinaryFilterTest.h"
+#include "backend/core/column/ColumnStore.h"
 #include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
@@ -289,6 +290,196 @@ void BinaryFilterTest::importDoubleMatrixBE() {
 	QCOMPARE(spreadsheet.column(39)->valueAt(39), 0.909297426825682);
 }
 
+/*!
+ * read a range of rows, the rows before the start row are skipped without reading them.
+ */
+void BinaryFilterTest::importInt8RowRange() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/int8.bin"));
+	filter.setDataType(BinaryFilter::DataType::INT8);
+	filter.setStartRow(4);
+	filter.setEndRow(5);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 0);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 29);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 0);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 38);
+
+	// until the end of the file
+	filter.setStartRow(999);
+	filter.setEndRow(-1);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 99);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), -59);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 100);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), -50);
+}
+
+/*!
+ * read a range of rows in the middle of the file, the end row is larger than the number of rows behind the start row.
+ */
+void BinaryFilterTest::importInt8RowRangeMiddle() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/int8.bin"));
+	filter.setDataType(BinaryFilter::DataType::INT8);
+	filter.setStartRow(600);
+	filter.setEndRow(900);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 301);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 59);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), -26);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 60);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), -36);
+	QCOMPARE(spreadsheet.column(0)->valueAt(300), 89);
+	QCOMPARE(spreadsheet.column(1)->valueAt(300), 89);
+
+	// the end row is beyond the end of the file
+	filter.setEndRow(2000);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.rowCount(), 401);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 59);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), -26);
+	QCOMPARE(spreadsheet.column(0)->valueAt(400), 100);
+	QCOMPARE(spreadsheet.column(1)->valueAt(400), -50);
+}
+
+/*!
+ * the index column is not part of the file and doesn't change the size of the rows read from it.
+ */
+void BinaryFilterTest::importInt8Index() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/int8.bin"));
+	filter.setDataType(BinaryFilter::DataType::INT8);
+	filter.setCreateIndexEnabled(true);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 1000);
+
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(0)->integerAt(999), 1000);
+	QCOMPARE(spreadsheet.column(1)->valueAt(4), 0);
+	QCOMPARE(spreadsheet.column(2)->valueAt(4), 38);
+	QCOMPARE(spreadsheet.column(1)->valueAt(999), 100);
+	QCOMPARE(spreadsheet.column(2)->valueAt(999), -50);
+}
+
+/*!
+ * the values are written into the memory mapped column stores, the values are the same as with the import into the memory.
+ */
+void BinaryFilterTest::importInt8OutOfCore() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	BinaryFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/int8.bin"));
+	filter.setDataType(BinaryFilter::DataType::INT8);
+	filter.setCreateIndexEnabled(true);
+	filter.setOutOfCoreEnabled(true);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 1000);
+	for (int i = 0; i < 3; ++i) {
+		QVERIFY(spreadsheet.column(i)->outOfCoreStorage());
+		QCOMPARE(spreadsheet.column(i)->store()->rowCount(), (qint64)1000);
+	}
+
+	// the index is a big integer column, the number of rows isn't limited
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(0), (qint64)1);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(999), (qint64)1000);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->valueAt(4), 0);
+	QCOMPARE(spreadsheet.column(2)->valueAt(4), 38);
+	QCOMPARE(spreadsheet.column(1)->valueAt(999), 100);
+	QCOMPARE(spreadsheet.column(2)->valueAt(999), -50);
+	QCOMPARE(spreadsheet.column(0)->maximum(), 1000.);
+
+	// the end row is beyond the end of the file, the stores are shrunk to the rows read
+	filter.setCreateIndexEnabled(false);
+	filter.setStartRow(600);
+	filter.setEndRow(2000);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 401);
+	QVERIFY(spreadsheet.column(0)->outOfCoreStorage());
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 59);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), -26);
+	QCOMPARE(spreadsheet.column(0)->valueAt(400), 100);
+	QCOMPARE(spreadsheet.column(1)->valueAt(400), -50);
+}
+
+void BinaryFilterTest::exportDoubleLE() {
+	QTemporaryFile file;
+	if (!file.open())
+		return;
+	file.close();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	spreadsheet.setColumnCount(3);
+	spreadsheet.setRowCount(1000);
+	spreadsheet.column(0)->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	spreadsheet.column(1)->setColumnMode(AbstractColumn::ColumnMode::Text); // not exported
+	for (int i = 0; i < 1000; i++) {
+		spreadsheet.column(0)->setIntegerAt(i, i);
+		spreadsheet.column(1)->setTextAt(i, QStringLiteral("text"));
+		spreadsheet.column(2)->setValueAt(i, i / 3.);
+	}
+
+	BinaryFilter filter;
+	filter.setDataType(BinaryFilter::DataType::REAL64);
+	filter.setByteOrder(QDataStream::ByteOrder::LittleEndian);
+	filter.write(file.fileName(), &spreadsheet);
+
+	// read the data back
+	Spreadsheet spreadsheet2(QStringLiteral("test2"), false);
+	filter.setVectors(2);
+	filter.readDataFromFile(file.fileName(), &spreadsheet2, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet2.columnCount(), 2);
+	QCOMPARE(spreadsheet2.rowCount(), 1000);
+	QCOMPARE(spreadsheet2.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet2.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	for (int i = 0; i < 1000; i++) {
+		QCOMPARE(spreadsheet2.column(0)->valueAt(i), (double)i);
+		QCOMPARE(spreadsheet2.column(1)->valueAt(i), i / 3.);
+	}
+}
+
+/*!
+ * the export to a file that can't be created is reported in the errors of the filter
+ */
+void BinaryFilterTest::exportError() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	spreadsheet.setColumnCount(1);
+	spreadsheet.setRowCount(10);
+
+	BinaryFilter filter;
+	filter.writeInBackground(dir.filePath(QStringLiteral("missing/test.bin")), &spreadsheet);
+	QCOMPARE(filter.lastErrors().size(), 1);
+
+	filter.writeInBackground(dir.filePath(QStringLiteral("test.bin")), &spreadsheet);
+	QVERIFY(filter.lastErrors().isEmpty());
+	QCOMPARE(QFileInfo(dir.filePath(QStringLiteral("test.bin"))).size(), qint64(10 * BinaryFilter::dataSize(filter.dataType())));
+}
+
 /////////////////////////////////////////////////////////////////
 
 // INT data
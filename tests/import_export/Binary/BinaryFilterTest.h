@@ -29,6 +29,14 @@ private Q_SLOTS:
 
 	void importDoubleMatrixBE();
 
+	void importInt8RowRange();
+	void importInt8RowRangeMiddle();
+	void importInt8Index();
+	void importInt8OutOfCore();
+
+	void exportDoubleLE();
+	void exportError();
+
 	void benchIntImport_data();
 	// this is called multiple times (warm-up of BENCHMARK)
 	// see https://stackoverflow.com/questions/36916962/qtest-executes-test-case-twic
@@ -949,6 +949,107 @@ BO_ 541 MSG2: 8 Vector__XXX
 	}
 }
 
+
+// Every message gets its own time column, the columns only contain the values of the messages with the signals
+void BLFFilterTest::testSeparateTime() {
+	QTemporaryFile blfFileName(QStringLiteral("XXXXXX.blf"));
+	QVERIFY(blfFileName.open());
+	QVector<Vector::BLF::CanMessage2*> messages{
+		createCANMessage(234, 5, {0x01, 0x02}),
+		createCANMessage(123, 6, {0xFF, 0xA2}),
+		createCANMessage(123, 8, {0x23, 0xE2}),
+		createCANMessage(234, 10, {0xD3, 0xB2}),
+		createCANMessage(234, 12, {0xE1, 0xC7}),
+		createCANMessage(234, 14, {0xD1, 0xC7}),
+	}; // time is in nanoseconds
+	createBLFFile(blfFileName.fileName(), messages);
+
+	QTemporaryFile dbcFile(QStringLiteral("XXXXXX.dbc"));
+	QVERIFY(dbcFile.open());
+	const auto dbcContent = R"(BO_ 234 MSG1: 8 Vector__XXX
+ SG_ Msg1Sig1 : 7|8@0+ (1,0) [-3276.8|-3276.7] "C" Vector__XXX
+ SG_ Msg1Sig2 : 15|8@0+ (1,0) [-3276.8|-3276.7] "km/h" Vector__XXX
+BO_ 123 MSG2: 8 Vector__XXX
+ SG_ Msg2Sig1 : 7|8@0+ (1,0) [-3276.8|-3276.7] "mm" Vector__XXX
+ SG_ Msg2Sig2 : 15|8@0+ (1,0) [-3276.8|-3276.7] "m" Vector__XXX
+)";
+	createDBCFile(dbcFile.fileName(), dbcContent);
+
+	// Start Test
+
+	VectorBLFFilter filter;
+	filter.setConvertTimeToSeconds(true);
+	filter.setTimeHandlingMode(CANFilter::TimeHandling::Separate);
+	QCOMPARE(filter.isValid(blfFileName.fileName()), true);
+
+	// Valid blf and valid dbc
+	filter.setDBCFile(dbcFile.fileName());
+	Spreadsheet s(QStringLiteral("TestSpreadsheet"), false);
+	filter.readDataFromFile(blfFileName.fileName(), &s);
+	QCOMPARE(s.columnCount(), 6); // time + Msg1Sig1 + Msg1Sig2 + time + Msg2Sig1 + Msg2Sig2
+	QCOMPARE(s.rowCount(), 4);
+
+	{
+		const auto* c = s.column(0);
+		QCOMPARE(c->name(), QStringLiteral("MSG1_Time_s"));
+		QCOMPARE(c->rowCount(), 4);
+
+		QVector<double> refData{5e-9, 10e-9, 12e-9, 14e-9};
+		for (int i = 0; i < c->rowCount(); i++)
+			QCOMPARE(c->valueAt(i), refData.at(i));
+	}
+
+	{
+		const auto* c = s.column(1);
+		QCOMPARE(c->name(), QStringLiteral("MSG1_Msg1Sig1_C"));
+		QCOMPARE(c->rowCount(), 4);
+
+		QVector<double> refData{0x01, 0xD3, 0xE1, 0xD1};
+		for (int i = 0; i < c->rowCount(); i++)
+			QCOMPARE(c->valueAt(i), refData.at(i));
+	}
+
+	{
+		const auto* c = s.column(2);
+		QCOMPARE(c->name(), QStringLiteral("MSG1_Msg1Sig2_km/h"));
+		QCOMPARE(c->rowCount(), 4);
+
+		QVector<double> refData{0x02, 0xB2, 0xC7, 0xC7};
+		for (int i = 0; i < c->rowCount(); i++)
+			QCOMPARE(c->valueAt(i), refData.at(i));
+	}
+
+	{
+		const auto* c = s.column(3);
+		QCOMPARE(c->name(), QStringLiteral("MSG2_Time_s"));
+		QCOMPARE(c->rowCount(), 4); // padded with NaN to the number of rows of MSG1
+		QCOMPARE(c->valueAt(0), 6e-9);
+		QCOMPARE(c->valueAt(1), 8e-9);
+		QVERIFY(std::isnan(c->valueAt(2)));
+		QVERIFY(std::isnan(c->valueAt(3)));
+	}
+
+	{
+		const auto* c = s.column(4);
+		QCOMPARE(c->name(), QStringLiteral("MSG2_Msg2Sig1_mm"));
+		QCOMPARE(c->rowCount(), 4);
+		QCOMPARE(c->valueAt(0), (double)0xFF);
+		QCOMPARE(c->valueAt(1), (double)0x23);
+		QVERIFY(std::isnan(c->valueAt(2)));
+		QVERIFY(std::isnan(c->valueAt(3)));
+	}
+
+	{
+		const auto* c = s.column(5);
+		QCOMPARE(c->name(), QStringLiteral("MSG2_Msg2Sig2_m"));
+		QCOMPARE(c->rowCount(), 4);
+		QCOMPARE(c->valueAt(0), (double)0xA2);
+		QCOMPARE(c->valueAt(1), (double)0xE2);
+		QVERIFY(std::isnan(c->valueAt(2)));
+		QVERIFY(std::isnan(c->valueAt(3)));
+	}
+}
+
 #endif
 
 QTEST_MAIN(BLFFilterTest)
@@ -38,6 +38,8 @@ private Q_SLOTS:
 	void testUsePreviousValueLittleEndian();
 	void testBigNumberNotByteAlignedLittleEndian();
 
+	void testSeparateTime();
+
 private:
 	// Helper functions
 	void createDBCFile(const QString& filename, const std::string& content);
@@ -83,6 +83,64 @@ void FITSFilterTest::importFile2() {
 	QCOMPARE(spreadsheet.column(48)->valueAt(3), 0.3466465);
 }
 
+/*!
+ * numeric columns of a binary table are imported with their native type, undefined values are imported as NaN
+ */
+void FITSFilterTest::importBinaryTable() {
+	QTemporaryFile file;
+	QVERIFY(file.open()); // needed to generate file name
+	file.close();
+	const QString fileName = file.fileName() + QLatin1String(".fits");
+
+	const int rows = 1000;
+	int status = 0;
+	fitsfile* fptr;
+	fits_create_file(&fptr, qPrintable(fileName), &status);
+	char* types[] = {const_cast<char*>("x"), const_cast<char*>("i"), const_cast<char*>("k"), const_cast<char*>("name")};
+	char* forms[] = {const_cast<char*>("1D"), const_cast<char*>("1J"), const_cast<char*>("1K"), const_cast<char*>("8A")};
+	fits_create_tbl(fptr, BINARY_TBL, rows, 4, types, forms, nullptr, const_cast<char*>("data"), &status);
+
+	std::vector<double> x(rows);
+	std::vector<int> i(rows);
+	std::vector<LONGLONG> k(rows);
+	std::vector<QByteArray> names(rows);
+	std::vector<char*> namePointers(rows);
+	for (int row = 0; row < rows; ++row) {
+		x[row] = row / 10.;
+		i[row] = -row;
+		k[row] = 10000000000LL + row;
+		names[row] = QByteArray("row") + QByteArray::number(row);
+		namePointers[row] = names[row].data();
+	}
+	x[5] = NAN;
+	fits_write_col(fptr, TDOUBLE, 1, 1, 1, rows, x.data(), &status);
+	fits_write_col(fptr, TINT, 2, 1, 1, rows, i.data(), &status);
+	fits_write_col(fptr, TLONGLONG, 3, 1, 1, rows, k.data(), &status);
+	fits_write_col(fptr, TSTRING, 4, 1, 1, rows, namePointers.data(), &status);
+	fits_close_file(fptr, &status);
+	QCOMPARE(status, 0);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	FITSFilter filter;
+	filter.readDataFromFile(fileName + QLatin1String("[data]"), &spreadsheet);
+	QFile::remove(fileName);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), rows);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 0.1);
+	QVERIFY(std::isnan(spreadsheet.column(0)->valueAt(5)));
+	QCOMPARE(spreadsheet.column(0)->valueAt(rows - 1), 99.9);
+	QCOMPARE(spreadsheet.column(1)->integerAt(rows - 1), -(rows - 1));
+	QCOMPARE(spreadsheet.column(2)->bigIntAt(rows - 1), 10000000000LL + rows - 1);
+	QCOMPARE(spreadsheet.column(3)->textAt(0), QStringLiteral("row0"));
+	QCOMPARE(spreadsheet.column(3)->textAt(rows - 1), QStringLiteral("row999"));
+}
+
 // BENCHMARKS
 
 void FITSFilterTest::benchDoubleImport_data() {
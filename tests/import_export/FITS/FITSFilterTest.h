@@ -19,6 +19,7 @@ class FITSFilterTest : public CommonTest {
 private Q_SLOTS:
 	void importFile1();
 	void importFile2();
+	void importBinaryTable();
 
 	void benchDoubleImport_data();
 	// this is called multiple times (warm-up of BENCHMARK)
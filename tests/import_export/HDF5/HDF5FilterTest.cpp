@@ -8,15 +8,20 @@
 */
 
 #include "HDF5FilterTest.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/datasources/filters/HDF5Filter.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
+#include <QTemporaryDir>
 
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
+
+#include <numeric>
+
 extern "C" {
 #include <hdf5.h>
 }
@@ -264,8 +269,321 @@ void HDF5FilterTest::testImportVLENPortion() {
 	QCOMPARE(spreadsheet.column(0)->valueAt(3), 5);
 }
 
+void HDF5FilterTest::testImport1DPortion() {
+	QTemporaryFile file;
+	if (!file.open()) // needed to generate file name
+		return;
+	file.close();
+	const QString fileName = file.fileName() + QStringLiteral(".h5");
+
+	// create 1D data sets with 10 rows
+	hid_t file_id = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	hsize_t dims[1] = {10};
+	hid_t dataspace_id = H5Screate_simple(1, dims, nullptr);
+	double doubleData[10];
+	qint64 bigIntData[10];
+	for (int i = 0; i < 10; i++) {
+		doubleData[i] = i + 0.5;
+		bigIntData[i] = 10000000000 + i;
+	}
+	hid_t dataset_id = H5Dcreate(file_id, "/double", H5T_IEEE_F64LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, doubleData);
+	H5Dclose(dataset_id);
+	dataset_id = H5Dcreate(file_id, "/bigint", H5T_STD_I64LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(dataset_id, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, bigIntData);
+	H5Dclose(dataset_id);
+	H5Sclose(dataspace_id);
+	H5Fclose(file_id);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	HDF5Filter filter;
+	filter.setCurrentDataSetName(QLatin1String("/double"));
+	filter.setStartRow(3);
+	filter.setEndRow(6);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 1);
+	QCOMPARE(spreadsheet.rowCount(), 4);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 2.5);
+	QCOMPARE(spreadsheet.column(0)->valueAt(3), 5.5);
+
+	// preview
+	bool ok = true;
+	const auto preview = filter.readCurrentDataSet(fileName, nullptr, ok, AbstractFileFilter::ImportMode::Replace, 2);
+	QVERIFY(ok);
+	QCOMPARE(preview.size(), 2);
+	QCOMPARE(preview.at(0).at(0), QStringLiteral("2.5"));
+	QCOMPARE(preview.at(1).at(0), QStringLiteral("3.5"));
+
+	HDF5Filter filter2;
+	filter2.setCurrentDataSetName(QLatin1String("/bigint"));
+	filter2.setStartRow(8);
+	filter2.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 1);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(0), 10000000007);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(2), 10000000009);
+
+	QFile::remove(fileName);
+}
+
+void HDF5FilterTest::testImportUnsignedInt() {
+	QTemporaryFile file;
+	if (!file.open()) // needed to generate file name
+		return;
+	file.close();
+	const QString fileName = file.fileName() + QStringLiteral(".h5");
+
+	// unsigned 32bit values bigger than INT_MAX
+	hid_t file_id = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	hsize_t dims[2] = {3, 2};
+	hid_t dataspace_id = H5Screate_simple(1, dims, nullptr);
+	const quint32 data[6] = {1, 3000000000, 4294967295, 7, 8, 9};
+	hid_t dataset_id = H5Dcreate(file_id, "/uint1d", H5T_STD_U32LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(dataset_id, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+	H5Dclose(dataset_id);
+	H5Sclose(dataspace_id);
+	dataspace_id = H5Screate_simple(2, dims, nullptr);
+	dataset_id = H5Dcreate(file_id, "/uint2d", H5T_STD_U32LE, dataspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	H5Dwrite(dataset_id, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+	H5Dclose(dataset_id);
+	H5Sclose(dataspace_id);
+	H5Fclose(file_id);
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	HDF5Filter filter;
+	filter.setCurrentDataSetName(QLatin1String("/uint1d"));
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 1);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(0), 1);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(1), 3000000000);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(2), 4294967295);
+
+	HDF5Filter filter2;
+	filter2.setCurrentDataSetName(QLatin1String("/uint2d"));
+	filter2.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(1)->bigIntAt(0), 3000000000);
+	QCOMPARE(spreadsheet.column(0)->bigIntAt(1), 4294967295);
+
+	QFile::remove(fileName);
+}
+
+void HDF5FilterTest::testExport() {
+	QTemporaryFile file;
+	if (!file.open()) // needed to generate file name
+		return;
+	file.close();
+	const QString fileName = file.fileName() + QStringLiteral(".h5");
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	spreadsheet.setColumnCount(2);
+	spreadsheet.setRowCount(100000);
+	spreadsheet.column(0)->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	for (int i = 0; i < 100000; i++) {
+		spreadsheet.column(0)->setIntegerAt(i, i);
+		spreadsheet.column(1)->setValueAt(i, i / 3.);
+	}
+
+	HDF5Filter filter;
+	filter.setCompressionLevel(6);
+	filter.write(fileName, &spreadsheet);
+
+	// read the data back, all columns are written to one 2D double data set
+	Spreadsheet spreadsheet2(QStringLiteral("test2"), false);
+	HDF5Filter filter2;
+	filter2.setCurrentDataSetName(QLatin1String("/test"));
+	filter2.readDataFromFile(fileName, &spreadsheet2, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet2.columnCount(), 2);
+	QCOMPARE(spreadsheet2.rowCount(), 100000);
+	QCOMPARE(spreadsheet2.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet2.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet2.column(0)->valueAt(0), 0.);
+	QCOMPARE(spreadsheet2.column(1)->valueAt(0), 0.);
+	QCOMPARE(spreadsheet2.column(0)->valueAt(99999), 99999.);
+	QCOMPARE(spreadsheet2.column(1)->valueAt(99999), 99999 / 3.);
+
+	QFile::remove(fileName);
+}
+
+void HDF5FilterTest::testExportMatrix() {
+	QTemporaryFile file;
+	if (!file.open()) // needed to generate file name
+		return;
+	file.close();
+	const QString fileName = file.fileName() + QStringLiteral(".h5");
+
+	// the constructor also adds the default rows and columns, set the dimensions explicitly
+	Matrix matrix(QStringLiteral("matrix"), false, AbstractColumn::ColumnMode::Integer);
+	matrix.setDimensions(3, 4);
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 4; j++)
+			matrix.setCell(i, j, 10 * i + j);
+
+	HDF5Filter filter;
+	filter.write(fileName, &matrix);
+
+	Matrix matrix2(QStringLiteral("matrix2"));
+	HDF5Filter filter2;
+	filter2.setCurrentDataSetName(QLatin1String("/matrix"));
+	filter2.readDataFromFile(fileName, &matrix2, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(matrix2.rowCount(), 3);
+	QCOMPARE(matrix2.columnCount(), 4);
+	QCOMPARE(matrix2.mode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(matrix2.cell<int>(0, 0), 0);
+	QCOMPARE(matrix2.cell<int>(1, 2), 12);
+	QCOMPARE(matrix2.cell<int>(2, 3), 23);
+
+	QFile::remove(fileName);
+}
+
 // BENCHMARKS
 
+// ##############################################################################
+// #################################  live data  ################################
+// ##############################################################################
+
+namespace {
+// writes the one-dimensional data set "/data" with the values 1, ..., rows
+void writeLiveDataSet(const QString& fileName, int rows) {
+	hid_t file = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	const hsize_t dims[1] = {(hsize_t)rows};
+	hid_t dataspace = H5Screate_simple(1, dims, nullptr);
+	hid_t dataset = H5Dcreate(file, "/data", H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	QVector<double> values(rows);
+	std::iota(values.begin(), values.end(), 1.);
+	H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.constData());
+	H5Dclose(dataset);
+	H5Sclose(dataspace);
+	H5Fclose(file);
+}
+}
+
+/*!
+ * the data set grows between two reads, only the new rows are appended
+ */
+void HDF5FilterTest::testLiveAppend() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.h5"));
+	writeLiveDataSet(fileName, 3);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::HDF5);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new HDF5Filter;
+	filter->setCurrentDataSetName(QStringLiteral("/data"));
+	filter->setStartRow(2);
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.columnCount(), 1);
+	QCOMPARE(source.rowCount(), 2);
+	QCOMPARE(source.column(0)->valueAt(0), 2.);
+	QCOMPARE(source.column(0)->valueAt(1), 3.);
+
+	writeLiveDataSet(fileName, 6);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 2.);
+
+	// no new data
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+
+	// the row range of the filter is not changed by the live reading, it's saved in the project
+	QCOMPARE(filter->startRow(), 2);
+	QCOMPARE(filter->endRow(), -1);
+}
+
+/*!
+ * the data set grows between two reads, only the last N values are kept
+ */
+void HDF5FilterTest::testLiveKeepNValues() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.h5"));
+	writeLiveDataSet(fileName, 3);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::HDF5);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	source.setKeepNValues(5);
+	auto* filter = new HDF5Filter;
+	filter->setCurrentDataSetName(QStringLiteral("/data"));
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.rowCount(), 3);
+	QCOMPARE(source.column(0)->valueAt(2), 3.);
+
+	writeLiveDataSet(fileName, 8);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 4.);
+
+	writeLiveDataSet(fileName, 10);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 6.);
+
+	QCOMPARE(filter->startRow(), 1);
+}
+
+/*!
+ * the file is replaced by a file with a smaller data set between two reads, the data set is read again completely
+ */
+void HDF5FilterTest::testLiveTruncated() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.h5"));
+	writeLiveDataSet(fileName, 6);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::HDF5);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new HDF5Filter;
+	filter->setCurrentDataSetName(QStringLiteral("/data"));
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.rowCount(), 6);
+
+	writeLiveDataSet(fileName, 2);
+	source.read();
+	QCOMPARE(source.rowCount(), 2);
+	QCOMPARE(source.column(0)->valueAt(0), 1.);
+	QCOMPARE(source.column(0)->valueAt(1), 2.);
+
+	// the new data is appended again
+	writeLiveDataSet(fileName, 4);
+	source.read();
+	QCOMPARE(source.rowCount(), 4);
+	for (int i = 0; i < 4; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 1.);
+}
+
 void HDF5FilterTest::benchDoubleImport_data() {
 	QTest::addColumn<size_t>("lineCount");
 	// can't transfer file name since needed in clean up
@@ -23,6 +23,15 @@ private Q_SLOTS:
 	void testImportIntPortion();
 	void testImportVLEN();
 	void testImportVLENPortion();
+	void testImport1DPortion();
+	void testImportUnsignedInt();
+
+	void testExport();
+	void testExportMatrix();
+
+	void testLiveAppend();
+	void testLiveKeepNValues();
+	void testLiveTruncated();
 
 	void benchDoubleImport_data();
 	// this is called multiple times (warm-up of BENCHMARK)
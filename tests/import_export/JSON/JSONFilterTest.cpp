@@ -13,6 +13,8 @@
 
 #include <KLocalizedString>
 
+#include <cmath>
+
 void JSONFilterTest::initTestCase() {
 	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
 	// TODO: redesign/remove this
@@ -275,4 +277,61 @@ void JSONFilterTest::testObjectImport04() {
 	QCOMPARE(spreadsheet.column(5)->integerAt(1), 127830);
 }
 
+/*!
+ * import newline delimited JSON, the column modes are determined from the first values that are not null
+ */
+void JSONFilterTest::testLinesImport() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/lines.ndjson"));
+	AbstractFileFilter::ImportMode mode = AbstractFileFilter::ImportMode::Replace;
+	filter.setDataRowType(QJsonValue::Object);
+	filter.setStartColumn(1);
+	filter.setEndColumn(3);
+	filter.setEndRow(3);
+	filter.readDataFromFile(fileName, &spreadsheet, mode);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	// the members of the objects are sorted by their names
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("name"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("x"));
+	QCOMPARE(spreadsheet.column(2)->name(), QLatin1String("y"));
+
+	QCOMPARE(spreadsheet.column(0)->textAt(0), QStringLiteral("a"));
+	QCOMPARE(spreadsheet.column(0)->textAt(1), QStringLiteral("b"));
+	QCOMPARE(spreadsheet.column(0)->textAt(2), QStringLiteral("c"));
+
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 1.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 2.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(2), 3.);
+
+	QVERIFY(std::isnan(spreadsheet.column(2)->valueAt(0)));
+	QCOMPARE(spreadsheet.column(2)->valueAt(1), 0.5);
+	QCOMPARE(spreadsheet.column(2)->valueAt(2), 1.5);
+
+	// all records, the members are looked up by their names in the records with a missing and an additional member
+	filter.setEndRow(-1);
+	filter.readDataFromFile(fileName, &spreadsheet, mode);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 5);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("name"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("x"));
+	QCOMPARE(spreadsheet.column(2)->name(), QLatin1String("y"));
+
+	QCOMPARE(spreadsheet.column(0)->textAt(3), QStringLiteral("d"));
+	QVERIFY(std::isnan(spreadsheet.column(1)->valueAt(3)));
+	QCOMPARE(spreadsheet.column(2)->valueAt(3), 2.5);
+
+	QCOMPARE(spreadsheet.column(0)->textAt(4), QStringLiteral("e"));
+	QCOMPARE(spreadsheet.column(1)->valueAt(4), 5.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(4), 3.5);
+}
+
 QTEST_MAIN(JSONFilterTest)
@@ -23,6 +23,7 @@ private Q_SLOTS:
 	void testObjectImport02();
 	void testObjectImport03();
 	void testObjectImport04();
+	void testLinesImport();
 };
 
 #endif
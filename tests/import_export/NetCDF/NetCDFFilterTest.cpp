@@ -9,12 +9,17 @@
 */
 
 #include "NetCDFFilterTest.h"
+#include "backend/datasources/LiveDataSource.h"
 #include "backend/datasources/filters/NetCDFFilter.h"
 #include "backend/lib/macros.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QTemporaryDir>
+
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
+
+#include <numeric>
 extern "C" {
 #include <netcdf.h>
 }
@@ -113,6 +118,140 @@ void NetCDFFilterTest::importFile3() {
 	QCOMPARE(spreadsheet.column(0)->valueAt(9999), 444);
 }
 
+// ##############################################################################
+// #################################  live data  ################################
+// ##############################################################################
+
+namespace {
+// writes the variable "data" with the values 1, ..., rows along the unlimited dimension "time"
+void writeLiveVariable(const QString& fileName, int rows) {
+	int ncid, dimid, varid;
+	nc_create(qPrintable(fileName), NC_CLOBBER, &ncid);
+	nc_def_dim(ncid, "time", NC_UNLIMITED, &dimid);
+	nc_def_var(ncid, "data", NC_DOUBLE, 1, &dimid, &varid);
+	nc_enddef(ncid);
+	QVector<double> values(rows);
+	std::iota(values.begin(), values.end(), 1.);
+	const size_t start[1] = {0};
+	const size_t count[1] = {(size_t)rows};
+	nc_put_vara_double(ncid, varid, start, count, values.constData());
+	nc_close(ncid);
+}
+}
+
+/*!
+ * records are added to the variable between two reads, only the new records are appended
+ */
+void NetCDFFilterTest::testLiveAppend() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.nc"));
+	writeLiveVariable(fileName, 3);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::NETCDF);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new NetCDFFilter;
+	filter->setCurrentVarName(QStringLiteral("data"));
+	filter->setStartRow(2);
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.columnCount(), 1);
+	QCOMPARE(source.rowCount(), 2);
+	QCOMPARE(source.column(0)->valueAt(0), 2.);
+	QCOMPARE(source.column(0)->valueAt(1), 3.);
+
+	writeLiveVariable(fileName, 6);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 2.);
+
+	// no new data
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+
+	// the row range of the filter is not changed by the live reading, it's saved in the project
+	QCOMPARE(filter->startRow(), 2);
+	QCOMPARE(filter->endRow(), -1);
+}
+
+/*!
+ * records are added to the variable between two reads, only the last N values are kept
+ */
+void NetCDFFilterTest::testLiveKeepNValues() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.nc"));
+	writeLiveVariable(fileName, 3);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::NETCDF);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	source.setKeepNValues(5);
+	auto* filter = new NetCDFFilter;
+	filter->setCurrentVarName(QStringLiteral("data"));
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.rowCount(), 3);
+	QCOMPARE(source.column(0)->valueAt(2), 3.);
+
+	writeLiveVariable(fileName, 8);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 4.);
+
+	writeLiveVariable(fileName, 10);
+	source.read();
+	QCOMPARE(source.rowCount(), 5);
+	for (int i = 0; i < 5; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 6.);
+
+	QCOMPARE(filter->startRow(), 1);
+}
+
+/*!
+ * the file is replaced by a file with a smaller variable between two reads, the variable is read again completely
+ */
+void NetCDFFilterTest::testLiveTruncated() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("live.nc"));
+	writeLiveVariable(fileName, 6);
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::FileOrPipe);
+	source.setFileType(AbstractFileFilter::FileType::NETCDF);
+	source.setFileName(fileName);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new NetCDFFilter;
+	filter->setCurrentVarName(QStringLiteral("data"));
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(source.rowCount(), 6);
+
+	writeLiveVariable(fileName, 2);
+	source.read();
+	QCOMPARE(source.rowCount(), 2);
+	QCOMPARE(source.column(0)->valueAt(0), 1.);
+	QCOMPARE(source.column(0)->valueAt(1), 2.);
+
+	// the new data is appended again
+	writeLiveVariable(fileName, 4);
+	source.read();
+	QCOMPARE(source.rowCount(), 4);
+	for (int i = 0; i < 4; ++i)
+		QCOMPARE(source.column(0)->valueAt(i), i + 1.);
+}
+
 // BENCHMARKS
 
 void NetCDFFilterTest::benchDoubleImport_data() {
@@ -21,6 +21,10 @@ private Q_SLOTS:
 	void importFile2(); // HDF5
 	void importFile3(); // simple file
 
+	void testLiveAppend();
+	void testLiveKeepNValues();
+	void testLiveTruncated();
+
 	void benchDoubleImport_data();
 	// this is called multiple times (warm-up of BENCHMARK)
 	// see https://stackoverflow.com/questions/36916962/qtest-executes-test-case-twic
@@ -14,6 +14,8 @@
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QTreeWidgetItem>
+
 void OdsFilterTest::importFile3SheetsRangesFormula() {
 	const QString& fileName = QFINDTESTDATA(QLatin1String("data/ranges-formula.ods"));
 
@@ -346,4 +348,24 @@ void OdsFilterTest::importFileSheetWithHeader() {
 	QCOMPARE(spreadsheet.column(2)->valueAt(3), 70); // formula
 }
 
+void OdsFilterTest::previewSheet() {
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/start-end.ods"));
+
+	OdsFilter filter;
+	QTreeWidgetItem root;
+	filter.parse(fileName, &root);
+	QCOMPARE(root.child(0)->childCount(), 1);
+	QCOMPARE(root.child(0)->child(0)->text(0), QLatin1String("Sheet2"));
+
+	// the data range is determined from the rows read for the preview only
+	const auto lines = filter.preview(QStringLiteral("Sheet2"), 1);
+	QCOMPARE(lines.size(), 2);
+	QCOMPARE(lines.at(0).size(), 4);
+	QCOMPARE(lines.at(0).at(0), QLocale().toString(1.));
+	QCOMPARE(lines.at(0).at(1), QLocale().toString(2.2));
+	QCOMPARE(lines.at(0).at(3), QString());
+	QCOMPARE(lines.at(1).at(0), QLocale().toString(3.));
+	QCOMPARE(lines.at(1).at(3), QLocale().toString(12.3)); // formula
+}
+
 QTEST_MAIN(OdsFilterTest)
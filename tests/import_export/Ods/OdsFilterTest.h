@@ -23,5 +23,6 @@ private Q_SLOTS:
 	void importFileSheetStartEndRow(); // check giving start and end row
 	void importFileSheetStartEndColumn(); // check giving start and end column
 	void importFileSheetWithHeader(); // check importing header from first row
+	void previewSheet(); // check that the preview only reads the requested lines
 };
 #endif
@@ -94,6 +94,33 @@ void ROOTFilterTest::importFile2() {
 	QCOMPARE(spreadsheet.column(2)->valueAt(100), 0);
 }
 
+/*!
+ * all leaves are read in one pass, also several times the same leaf
+ */
+void ROOTFilterTest::importTreeLeaves() {
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/advanced_zlib.root"));
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	ROOTFilter filter;
+	filter.setStartRow(0);
+	filter.setEndRow(9);
+	filter.setCurrentObject(QStringLiteral("Tree:tree"));
+	QVector<QStringList> columns{{QStringLiteral("structTest"), QStringLiteral("double")},
+								{QStringLiteral("doubleTest")},
+								{QStringLiteral("structTest"), QStringLiteral("double")}};
+	filter.setColumns(columns);
+	filter.readDataFromFile(fileName, &spreadsheet);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 10);
+
+	for (int i = 0; i < 10; ++i) {
+		QCOMPARE(spreadsheet.column(0)->valueAt(i), (9. - i) * (9. - i));
+		QCOMPARE(spreadsheet.column(1)->valueAt(i), static_cast<double>(i));
+		QCOMPARE(spreadsheet.column(2)->valueAt(i), (9. - i) * (9. - i));
+	}
+}
+
 // BENCHMARKS
 
 /*
@@ -19,6 +19,7 @@ class ROOTFilterTest : public CommonTest {
 private Q_SLOTS:
 	void importFile1();
 	void importFile2();
+	void importTreeLeaves();
 
 	/*	TODO:
 	 *	void benchDoubleImport_data();
@@ -13,6 +13,7 @@
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
+#include <QThread>
 
 void ReadStatFilterTest::initTestCase() {
 	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
@@ -345,4 +346,69 @@ void ReadStatFilterTest::testXPTImport() {
 	// no value label
 }
 
+void ReadStatFilterTest::testSASImportRange() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	ReadStatFilter filter;
+	filter.setStartRow(141);
+	filter.setEndRow(150);
+	filter.setStartColumn(2);
+	filter.setEndColumn(5);
+
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/iris.sas7bdat"));
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), 10);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("sepalwidth"));
+	QCOMPARE(spreadsheet.column(3)->name(), QLatin1String("species"));
+
+	// last row of the file
+	QCOMPARE(spreadsheet.column(0)->valueAt(9), 3.);
+	FuzzyCompare(spreadsheet.column(1)->valueAt(9), 5.1, 1.e-7);
+	FuzzyCompare(spreadsheet.column(2)->valueAt(9), 1.8, 1.e-7);
+	QCOMPARE(spreadsheet.column(3)->textAt(0), QLatin1String("virginica"));
+	QCOMPARE(spreadsheet.column(3)->textAt(9), QLatin1String("virginica"));
+}
+
+/*!
+ * several files are parsed at the same time by different filters.
+ */
+void ReadStatFilterTest::testConcurrentPreview() {
+	const QStringList fileNames{QFINDTESTDATA(QLatin1String("data/iris.dta")),
+								QFINDTESTDATA(QLatin1String("data/iris.sas7bdat")),
+								QFINDTESTDATA(QLatin1String("data/iris.sav"))};
+
+	// reference previews read one after the other
+	QVector<QVector<QStringList>> expected;
+	for (const auto& fileName : fileNames) {
+		ReadStatFilter filter;
+		expected << filter.preview(fileName, 100);
+	}
+
+	std::vector<std::unique_ptr<ReadStatFilter>> filters;
+	QVector<QVector<QStringList>> results(fileNames.size());
+	std::vector<std::unique_ptr<QThread>> threads;
+	for (int i = 0; i < fileNames.size(); ++i) {
+		filters.push_back(std::make_unique<ReadStatFilter>());
+		auto* filter = filters.back().get();
+		auto& result = results[i];
+		const auto& fileName = fileNames.at(i);
+		threads.push_back(std::unique_ptr<QThread>(QThread::create([filter, &result, fileName] {
+			result = filter->preview(fileName, 100);
+		})));
+	}
+	for (auto& thread : threads)
+		thread->start();
+	for (auto& thread : threads)
+		QVERIFY(thread->wait(60000));
+
+	for (int i = 0; i < fileNames.size(); ++i) {
+		QCOMPARE(results.at(i).size(), 100);
+		QCOMPARE(results.at(i), expected.at(i));
+		QCOMPARE(filters.at(i)->vectorNames().size(), 5);
+	}
+}
+
 QTEST_MAIN(ReadStatFilterTest)
@@ -24,6 +24,9 @@ private Q_SLOTS:
 	void testSAVImport();
 	void testPORImport();
 	void testXPTImport();
+
+	void testSASImportRange();
+	void testConcurrentPreview();
 };
 
 #endif
@@ -8,12 +8,18 @@
 */
 
 #include "ImportSqlDatabaseTest.h"
+#include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/datasources/LiveDataSource.h"
+#include "backend/datasources/filters/SQLFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "kdefrontend/datasources/ImportSQLDatabaseWidget.h"
 
 #include <KConfig>
 #include <KConfigGroup>
 
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
 void ImportSqlDatabaseTest::initTestCase() {
 	// prepare the database connection
 	QString m_configPath(QStandardPaths::standardLocations(QStandardPaths::AppDataLocation).constFirst() + QStringLiteral("sql_connections"));
@@ -312,4 +318,364 @@ void ImportSqlDatabaseTest::testQuery() {
 	QCOMPARE(spreadsheet.column(0)->textAt(14), QLatin1String("The Best of Beethoven"));
 }
 
+// ##############################################################################
+// ##################################  SQLFilter ################################
+// ##############################################################################
+/*!
+ * read the full table with the filter, the column modes are determined from the field types
+ */
+void ImportSqlDatabaseTest::testFilterTable() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+
+	SQLFilter filter;
+	filter.setTable(QStringLiteral("albums"));
+	filter.readDataFromFile(QFINDTESTDATA(QLatin1String("data/chinook.db")), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(filter.lastErrors().size(), 0);
+
+	QCOMPARE(spreadsheet.rowCount(), 347);
+	QCOMPARE(spreadsheet.columnCount(), 3);
+
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("AlbumId"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("Title"));
+	QCOMPARE(spreadsheet.column(2)->name(), QLatin1String("ArtistId"));
+
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Integer);
+
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(1)->textAt(0), QLatin1String("For Those About To Rock We Salute You"));
+	QCOMPARE(spreadsheet.column(2)->integerAt(0), 1);
+
+	QCOMPARE(spreadsheet.column(0)->integerAt(346), 347);
+	QCOMPARE(spreadsheet.column(1)->textAt(346), QLatin1String("Koyaanisqatsi (Soundtrack from the Motion Picture)"));
+	QCOMPARE(spreadsheet.column(2)->integerAt(346), 275);
+}
+
+/*!
+ * read the records from 10 to 120 in pages of 50 rows using the key column
+ */
+void ImportSqlDatabaseTest::testFilterKeyset() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+
+	SQLFilter filter;
+	filter.setTable(QStringLiteral("albums"));
+	filter.setKeyColumn(QStringLiteral("AlbumId"));
+	filter.setBatchSize(50);
+	filter.setStartRow(10);
+	filter.setEndRow(120);
+	filter.readDataFromFile(QFINDTESTDATA(QLatin1String("data/chinook.db")), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(filter.lastErrors().size(), 0);
+
+	QCOMPARE(spreadsheet.rowCount(), 111);
+	QCOMPARE(spreadsheet.columnCount(), 3);
+
+	// first row in the spreadsheet
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 10);
+	QCOMPARE(spreadsheet.column(1)->textAt(0), QLatin1String("Audioslave"));
+	QCOMPARE(spreadsheet.column(2)->integerAt(0), 8);
+
+	// all rows are read once and in the order of the key
+	for (int i = 0; i < spreadsheet.rowCount(); ++i)
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), 10 + i);
+}
+
+/*!
+ * poll a database table with a live data source, only the new rows are read on every update
+ */
+void ImportSqlDatabaseTest::testFilterLiveDatabase() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString dbName = dir.filePath(QStringLiteral("live.db"));
+	const QString connection = QStringLiteral("LiveDataSourceTest");
+
+	// create the table with the first 10 rows
+	{
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+		db.setDatabaseName(dbName);
+		QVERIFY(db.open());
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("CREATE TABLE data (id INTEGER PRIMARY KEY, value REAL)")));
+		QVERIFY(q.prepare(QStringLiteral("INSERT INTO data (id, value) VALUES (?, ?)")));
+		for (int i = 1; i <= 10; ++i) {
+			q.addBindValue(i);
+			q.addBindValue(0.5 * i);
+			QVERIFY(q.exec());
+		}
+	}
+
+	{
+		KConfig config(SQLFilter::connectionsConfigPath(), KConfig::SimpleConfig);
+		KConfigGroup group = config.group(connection);
+		group.writeEntry("Driver", QStringLiteral("QSQLITE"));
+		group.writeEntry("DatabaseName", dbName);
+	}
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::Database);
+	source.setFileType(AbstractFileFilter::FileType::SQL);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new SQLFilter;
+	filter->setConnection(connection);
+	filter->setTable(QStringLiteral("data"));
+	filter->setKeyColumn(QStringLiteral("id"));
+	filter->setEndRow(5); // ignored for live data sources, but kept
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(filter->endRow(), 5);
+	QCOMPARE(source.rowCount(), 10);
+	QCOMPARE(source.columnCount(), 2);
+	QCOMPARE(source.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(source.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(source.column(1)->valueAt(9), 5.);
+
+	// add 5 rows and read again
+	{
+		auto db = QSqlDatabase::database(connection);
+		QSqlQuery q(db);
+		QVERIFY(q.prepare(QStringLiteral("INSERT INTO data (id, value) VALUES (?, ?)")));
+		for (int i = 11; i <= 15; ++i) {
+			q.addBindValue(i);
+			q.addBindValue(0.5 * i);
+			QVERIFY(q.exec());
+		}
+	}
+
+	source.read();
+	QCOMPARE(source.rowCount(), 15);
+	QCOMPARE(source.column(0)->integerAt(10), 11);
+	QCOMPARE(source.column(0)->integerAt(14), 15);
+	QCOMPARE(source.column(1)->valueAt(14), 7.5);
+
+	// no new rows
+	source.read();
+	QCOMPARE(source.rowCount(), 15);
+
+	// a new key not fitting into int changes the integer column to BigInt
+	{
+		auto db = QSqlDatabase::database(connection);
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("INSERT INTO data (id, value) VALUES (10000000000, 8.0)")));
+	}
+
+	source.read();
+	QCOMPARE(source.rowCount(), 16);
+	QCOMPARE(source.column(0)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(source.column(0)->bigIntAt(14), 15LL);
+	QCOMPARE(source.column(0)->bigIntAt(15), 10000000000LL);
+
+	QSqlDatabase::removeDatabase(connection);
+}
+
+/*!
+ * poll a database table without a key column, the new rows are determined in the order of the primary key
+ */
+void ImportSqlDatabaseTest::testFilterLiveDatabasePrimaryKey() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString dbName = dir.filePath(QStringLiteral("live.db"));
+	const QString connection = QStringLiteral("LiveDataSourcePrimaryKeyTest");
+
+	// the rows are inserted in a different order than the order of the primary key
+	{
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+		db.setDatabaseName(dbName);
+		QVERIFY(db.open());
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("CREATE TABLE data (id INTEGER PRIMARY KEY, value REAL)")));
+		QVERIFY(q.exec(QStringLiteral("CREATE TABLE nokey (value REAL)")));
+		QVERIFY(q.exec(QStringLiteral("INSERT INTO data (id, value) VALUES (3, 1.5), (1, 0.5), (2, 1.0)")));
+		QVERIFY(q.exec(QStringLiteral("INSERT INTO nokey (value) VALUES (1.0)")));
+	}
+
+	{
+		KConfig config(SQLFilter::connectionsConfigPath(), KConfig::SimpleConfig);
+		KConfigGroup group = config.group(connection);
+		group.writeEntry("Driver", QStringLiteral("QSQLITE"));
+		group.writeEntry("DatabaseName", dbName);
+	}
+
+	LiveDataSource source(QStringLiteral("live"), false);
+	source.setSourceType(LiveDataSource::SourceType::Database);
+	source.setFileType(AbstractFileFilter::FileType::SQL);
+	source.setReadingType(LiveDataSource::ReadingType::TillEnd);
+	auto* filter = new SQLFilter;
+	filter->setConnection(connection);
+	filter->setTable(QStringLiteral("data"));
+	filter->setStartRow(2);
+	source.setFilter(filter);
+
+	source.read();
+	QCOMPARE(filter->lastErrors().size(), 0);
+	QCOMPARE(source.rowCount(), 2);
+	QCOMPARE(source.column(0)->integerAt(0), 2);
+	QCOMPARE(source.column(0)->integerAt(1), 3);
+
+	// the mode of the value column is changed, the new values are converted
+	source.column(1)->setColumnMode(AbstractColumn::ColumnMode::Text);
+	{
+		auto db = QSqlDatabase::database(connection);
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("INSERT INTO data (id, value) VALUES (5, 2.5), (4, 2.0)")));
+	}
+
+	source.read();
+	QCOMPARE(filter->lastErrors().size(), 0);
+	QCOMPARE(source.rowCount(), 4);
+	QCOMPARE(source.column(0)->integerAt(2), 4);
+	QCOMPARE(source.column(0)->integerAt(3), 5);
+	QCOMPARE(source.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(source.column(1)->valueAt(3), 2.5);
+
+	// the new rows of a table without a primary key can't be determined
+	filter->setTable(QStringLiteral("nokey"));
+	QCOMPARE(filter->readFromLiveDatabase(&source, 4), 4);
+	QCOMPARE(filter->lastErrors().size(), 1);
+
+	QSqlDatabase::removeDatabase(connection);
+}
+
+/*!
+ * write a spreadsheet with columns of different modes into a SQLite database and read it back
+ */
+void ImportSqlDatabaseTest::testFilterWrite() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	spreadsheet.setColumnCount(5);
+	spreadsheet.setRowCount(1500); // more rows than in one INSERT statement
+	auto* c0 = spreadsheet.column(0);
+	auto* c1 = spreadsheet.column(1);
+	auto* c2 = spreadsheet.column(2);
+	auto* c3 = spreadsheet.column(3);
+	auto* c4 = spreadsheet.column(4);
+	c0->setName(QStringLiteral("x"));
+	c1->setName(QStringLiteral("y"));
+	c2->setName(QStringLiteral("label"));
+	c3->setName(QStringLiteral("time"));
+	c4->setName(QStringLiteral("big"));
+	c0->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	c2->setColumnMode(AbstractColumn::ColumnMode::Text);
+	c3->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+	c4->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+
+	const QDateTime start = QDateTime::fromString(QStringLiteral("2023-01-01 00:00:00"), QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+	for (int i = 0; i < spreadsheet.rowCount(); ++i) {
+		c0->setIntegerAt(i, i);
+		c1->setValueAt(i, 0.5 * i);
+		c2->setTextAt(i, QStringLiteral("row %1").arg(i));
+		c3->setDateTimeAt(i, start.addSecs(i));
+		c4->setBigIntAt(i, i);
+	}
+	c1->setValueAt(1, NAN); // written as NULL
+	c4->setBigIntAt(1200, 10000000000LL); // the first value not fitting into int is in a later batch
+
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("export.db"));
+
+	SQLFilter filter;
+	filter.setCommitInterval(1000);
+	filter.write(fileName, &spreadsheet);
+	QCOMPARE(filter.lastErrors().size(), 0);
+
+	// check the types of the values in the database
+	{
+		const QString connection = QStringLiteral("WriteTest");
+		auto db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection);
+		db.setDatabaseName(fileName);
+		QVERIFY(db.open());
+		QSqlQuery q(db);
+		QVERIFY(q.exec(QStringLiteral("SELECT typeof(x), typeof(y), typeof(label), typeof(time), COUNT(*) FROM test WHERE x = 2")));
+		QVERIFY(q.next());
+		QCOMPARE(q.value(0).toString(), QLatin1String("integer"));
+		QCOMPARE(q.value(1).toString(), QLatin1String("real"));
+		QCOMPARE(q.value(2).toString(), QLatin1String("text"));
+		QCOMPARE(q.value(3).toString(), QLatin1String("text"));
+		QVERIFY(q.exec(QStringLiteral("SELECT typeof(y) FROM test WHERE x = 1")));
+		QVERIFY(q.next());
+		QCOMPARE(q.value(0).toString(), QLatin1String("null"));
+		db.close();
+	}
+	QSqlDatabase::removeDatabase(QStringLiteral("WriteTest"));
+
+	// read the table back
+	Spreadsheet result(QStringLiteral("result"), false);
+	SQLFilter readFilter;
+	readFilter.setTable(QStringLiteral("test"));
+	readFilter.setDateTimeFormat(static_cast<DateTime2StringFilter*>(c3->outputFilter())->format());
+	readFilter.setBatchSize(1000);
+	readFilter.readDataFromFile(fileName, &result, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(readFilter.lastErrors().size(), 0);
+
+	QCOMPARE(result.rowCount(), 1500);
+	QCOMPARE(result.columnCount(), 5);
+	QCOMPARE(result.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(result.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(result.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(result.column(3)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(result.column(4)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+
+	QCOMPARE(result.column(0)->integerAt(1499), 1499);
+	QVERIFY(std::isnan(result.column(1)->valueAt(1)));
+	QCOMPARE(result.column(1)->valueAt(1499), 749.5);
+	QCOMPARE(result.column(2)->textAt(1499), QLatin1String("row 1499"));
+	QCOMPARE(result.column(3)->dateTimeAt(1499), start.addSecs(1499));
+	QCOMPARE(result.column(4)->bigIntAt(0), 0LL);
+	QCOMPARE(result.column(4)->bigIntAt(1200), 10000000000LL);
+	QCOMPARE(result.column(4)->bigIntAt(1499), 1499LL);
+}
+
+/*!
+ * write a spreadsheet with text and date/time columns in a separate thread, the progress is reported
+ */
+void ImportSqlDatabaseTest::testFilterWriteInBackground() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	spreadsheet.setColumnCount(3);
+	spreadsheet.setRowCount(2000);
+	auto* c0 = spreadsheet.column(0);
+	auto* c1 = spreadsheet.column(1);
+	auto* c2 = spreadsheet.column(2);
+	c0->setName(QStringLiteral("x"));
+	c1->setName(QStringLiteral("label"));
+	c2->setName(QStringLiteral("time"));
+	c1->setColumnMode(AbstractColumn::ColumnMode::Text);
+	c2->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+
+	const QDateTime start = QDateTime::fromString(QStringLiteral("2023-01-01 00:00:00"), QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+	for (int i = 0; i < spreadsheet.rowCount(); ++i) {
+		c0->setValueAt(i, 0.5 * i);
+		c1->setTextAt(i, QStringLiteral("row %1").arg(i));
+		c2->setDateTimeAt(i, start.addSecs(i));
+	}
+
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QStringLiteral("export.db"));
+
+	SQLFilter filter;
+	filter.setEndRow(1500);
+	int progress = 0;
+	connect(&filter, &SQLFilter::completed, [&progress](int value) {
+		progress = value;
+	});
+	filter.writeInBackground(fileName, &spreadsheet);
+	QCOMPARE(filter.lastErrors().size(), 0);
+	QCOMPARE(progress, 100);
+
+	Spreadsheet result(QStringLiteral("result"), false);
+	SQLFilter readFilter;
+	readFilter.setTable(QStringLiteral("test"));
+	readFilter.setDateTimeFormat(static_cast<DateTime2StringFilter*>(c2->outputFilter())->format());
+	readFilter.readDataFromFile(fileName, &result, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(readFilter.lastErrors().size(), 0);
+
+	QCOMPARE(result.rowCount(), 1500);
+	QCOMPARE(result.columnCount(), 3);
+	QCOMPARE(result.column(1)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(result.column(2)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(result.column(0)->valueAt(1499), 749.5);
+	QCOMPARE(result.column(1)->textAt(1499), QLatin1String("row 1499"));
+	QCOMPARE(result.column(2)->dateTimeAt(1499), start.addSecs(1499));
+}
+
 QTEST_MAIN(ImportSqlDatabaseTest)
@@ -31,5 +31,13 @@ private Q_SLOTS:
 
 	// import the result of a custom query
 	void testQuery();
+
+	// SQLFilter
+	void testFilterTable();
+	void testFilterKeyset();
+	void testFilterLiveDatabase();
+	void testFilterLiveDatabasePrimaryKey();
+	void testFilterWrite();
+	void testFilterWriteInBackground();
 };
 #endif
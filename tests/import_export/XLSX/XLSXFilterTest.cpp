@@ -268,4 +268,40 @@ void XLSXFilterTest::importFileDatetime() {
 	QCOMPARE(spreadsheet.column(4)->valueAt(3), 0.01);
 }
 
+void XLSXFilterTest::importFileStringsFormula() {
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/strings-formula.xlsx"));
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	XLSXFilter filter;
+	filter.setCurrentSheet(QStringLiteral("Data"));
+	filter.setCurrentRange(QStringLiteral("A1:D4"));
+	filter.setFirstRowAsColumnNames(true);
+	filter.readDataFromFile(fileName, &spreadsheet);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.column(0)->name(), QStringLiteral("name"));
+	QCOMPARE(spreadsheet.column(1)->name(), QStringLiteral("value"));
+	QCOMPARE(spreadsheet.column(2)->name(), QStringLiteral("sum"));
+	QCOMPARE(spreadsheet.column(3)->name(), QStringLiteral("date"));
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+
+	// shared, rich text and inline strings
+	QCOMPARE(spreadsheet.column(0)->textAt(0), QStringLiteral("alpha"));
+	QCOMPARE(spreadsheet.column(0)->textAt(1), QStringLiteral("beta"));
+	QCOMPARE(spreadsheet.column(0)->textAt(2), QStringLiteral("gamma"));
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 1.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 2.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(2), 0.);
+	// cached results of the formulas
+	QCOMPARE(spreadsheet.column(2)->valueAt(0), 3.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(1), 5.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(2), 8.);
+	QCOMPARE(spreadsheet.column(3)->dateTimeAt(0).date(), QDate(2023, 1, 1));
+	QCOMPARE(spreadsheet.column(3)->dateTimeAt(1).date(), QDate(2023, 1, 2));
+	QCOMPARE(spreadsheet.column(3)->dateTimeAt(2).date(), QDate(2023, 1, 3));
+}
+
 QTEST_MAIN(XLSXFilterTest)
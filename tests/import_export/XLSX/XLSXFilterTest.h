@@ -23,5 +23,6 @@ private Q_SLOTS:
 	void importFile3ColsStartEndColumn();
 	void importFileEmptyCells();
 	void importFileDatetime();
+	void importFileStringsFormula();
 };
 #endif
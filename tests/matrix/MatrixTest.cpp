@@ -12,6 +12,125 @@
 #include "backend/matrix/Matrix.h"
 #include "commonfrontend/matrix/MatrixView.h"
 
-// TODO
+void MatrixTest::testTranspose() {
+	Matrix matrix(QStringLiteral("matrix"));
+	matrix.setDimensions(3, 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			matrix.setCell(row, col, 10. * row + col);
+
+	matrix.transpose();
+
+	QCOMPARE(matrix.rowCount(), 2);
+	QCOMPARE(matrix.columnCount(), 3);
+	for (int row = 0; row < 2; ++row)
+		for (int col = 0; col < 3; ++col)
+			QCOMPARE(matrix.cell<double>(row, col), 10. * col + row);
+
+	// transpose back
+	matrix.transpose();
+
+	QCOMPARE(matrix.rowCount(), 3);
+	QCOMPARE(matrix.columnCount(), 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			QCOMPARE(matrix.cell<double>(row, col), 10. * row + col);
+}
+
+void MatrixTest::testTransposeSquare() {
+	Matrix matrix(QStringLiteral("matrix"), false, AbstractColumn::ColumnMode::Integer);
+	matrix.setDimensions(2, 2);
+	matrix.setCell(0, 0, 1);
+	matrix.setCell(0, 1, 2);
+	matrix.setCell(1, 0, 3);
+	matrix.setCell(1, 1, 4);
+
+	matrix.transpose();
+
+	QCOMPARE(matrix.rowCount(), 2);
+	QCOMPARE(matrix.columnCount(), 2);
+	QCOMPARE(matrix.cell<int>(0, 0), 1);
+	QCOMPARE(matrix.cell<int>(0, 1), 3);
+	QCOMPARE(matrix.cell<int>(1, 0), 2);
+	QCOMPARE(matrix.cell<int>(1, 1), 4);
+}
+
+void MatrixTest::testMirrorHorizontally() {
+	Matrix matrix(QStringLiteral("matrix"));
+	matrix.setDimensions(2, 3);
+	for (int row = 0; row < 2; ++row)
+		for (int col = 0; col < 3; ++col)
+			matrix.setCell(row, col, 10. * row + col);
+
+	matrix.mirrorHorizontally();
+
+	for (int row = 0; row < 2; ++row)
+		for (int col = 0; col < 3; ++col)
+			QCOMPARE(matrix.cell<double>(row, col), 10. * row + (2 - col));
+}
+
+void MatrixTest::testMirrorVertically() {
+	Matrix matrix(QStringLiteral("matrix"));
+	matrix.setDimensions(3, 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			matrix.setCell(row, col, 10. * row + col);
+
+	matrix.mirrorVertically();
+
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			QCOMPARE(matrix.cell<double>(row, col), 10. * (2 - row) + col);
+}
+
+void MatrixTest::testInsertRemove() {
+	Matrix matrix(QStringLiteral("matrix"), false, AbstractColumn::ColumnMode::Integer);
+	matrix.setDimensions(3, 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			matrix.setCell(row, col, 10 * row + col);
+
+	// insert rows in the middle and remove the first column
+	matrix.insertRows(1, 2);
+	matrix.removeColumns(0, 1);
+	matrix.appendColumns(1);
+
+	QCOMPARE(matrix.rowCount(), 5);
+	QCOMPARE(matrix.columnCount(), 2);
+	const QVector<int> values{1, 0, 0, 11, 21};
+	for (int row = 0; row < 5; ++row) {
+		QCOMPARE(matrix.cell<int>(row, 0), values.at(row));
+		QCOMPARE(matrix.cell<int>(row, 1), 0);
+	}
+
+	// remove the inserted rows again
+	matrix.removeRows(1, 2);
+	QCOMPARE(matrix.rowCount(), 3);
+	QCOMPARE(matrix.cell<int>(0, 0), 1);
+	QCOMPARE(matrix.cell<int>(1, 0), 11);
+	QCOMPARE(matrix.cell<int>(2, 0), 21);
+}
+
+void MatrixTest::testTransposeInsert() {
+	Matrix matrix(QStringLiteral("matrix"));
+	matrix.setDimensions(2, 3);
+	for (int row = 0; row < 2; ++row)
+		for (int col = 0; col < 3; ++col)
+			matrix.setCell(row, col, 10. * row + col);
+
+	// the values are stored row by row after the transposition
+	matrix.transpose();
+	matrix.appendRows(1);
+	matrix.insertColumns(0, 1);
+
+	QCOMPARE(matrix.rowCount(), 4);
+	QCOMPARE(matrix.columnCount(), 3);
+	for (int row = 0; row < 4; ++row) {
+		QCOMPARE(matrix.cell<double>(row, 0), 0.);
+		for (int col = 1; col < 3; ++col)
+			QCOMPARE(matrix.cell<double>(row, col), row < 3 ? 10. * (col - 1) + row : 0.);
+	}
+	QCOMPARE(matrix.rowCells<double>(1, 0, 2), (QVector<double>{0., 1., 11.}));
+}
 
 QTEST_MAIN(MatrixTest)
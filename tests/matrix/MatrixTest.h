@@ -17,6 +17,12 @@ class MatrixTest : public CommonTest {
 	Q_OBJECT
 
 private Q_SLOTS:
+	void testTranspose();
+	void testTransposeSquare();
+	void testMirrorHorizontally();
+	void testMirrorVertically();
+	void testInsertRemove();
+	void testTransposeInsert();
 
 	// TODO: see Spreadsheet for things to test
 };
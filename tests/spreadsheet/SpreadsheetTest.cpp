@@ -15,6 +15,7 @@
 #include "backend/datasources/filters/VectorBLFFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/spreadsheet/SpreadsheetModel.h"
+#include "backend/spreadsheet/SpreadsheetSearch.h"
 #include "backend/spreadsheet/StatisticsSpreadsheet.h"
 #include "commonfrontend/ProjectExplorer.h"
 #include "commonfrontend/spreadsheet/SpreadsheetView.h"
@@ -1137,6 +1138,67 @@ void SpreadsheetTest::testSortDateTime2() {
 
 // performance
 
+/*
+ * check sorting with two key columns, the masks are moved with the rows and the sort is undone and redone
+ */
+void SpreadsheetTest::testSortMultipleKeys() {
+	Project project;
+	auto* sheet = new Spreadsheet(QStringLiteral("test"), false);
+	project.addChild(sheet);
+	sheet->setColumnCount(3);
+	sheet->setRowCount(5);
+
+	auto* col0{sheet->column(0)};
+	auto* col1{sheet->column(1)};
+	auto* col2{sheet->column(2)};
+	col0->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	col0->replaceInteger(0, {2, 1, 2, 1, 2});
+	col1->replaceValues(0, {0.5, 3., GSL_NAN, 1., 0.1});
+	col2->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col2->replaceTexts(0, {QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d"), QStringLiteral("e")});
+	col2->setMasked(2);
+
+	// sort
+	sheet->sortColumns(QVector<Column*>{col0, col1}, {col0, col1, col2}, true);
+
+	// values
+	QCOMPARE(col0->integerAt(0), 1);
+	QCOMPARE(col0->integerAt(1), 1);
+	QCOMPARE(col0->integerAt(2), 2);
+	QCOMPARE(col0->integerAt(3), 2);
+	QCOMPARE(col0->integerAt(4), 2);
+	QCOMPARE(col1->valueAt(0), 1.);
+	QCOMPARE(col1->valueAt(1), 3.);
+	QCOMPARE(col1->valueAt(2), 0.1);
+	QCOMPARE(col1->valueAt(3), 0.5);
+	QCOMPARE((bool)std::isnan(col1->valueAt(4)), true);
+	QCOMPARE(col2->textAt(0), QLatin1String("d"));
+	QCOMPARE(col2->textAt(1), QLatin1String("b"));
+	QCOMPARE(col2->textAt(2), QLatin1String("e"));
+	QCOMPARE(col2->textAt(3), QLatin1String("a"));
+	QCOMPARE(col2->textAt(4), QLatin1String("c"));
+	QCOMPARE(col2->isMasked(2), false);
+	QCOMPARE(col2->isMasked(4), true);
+
+	// undo
+	project.undoStack()->undo();
+	QCOMPARE(col0->integerAt(0), 2);
+	QCOMPARE(col0->integerAt(1), 1);
+	QCOMPARE(col1->valueAt(0), 0.5);
+	QCOMPARE((bool)std::isnan(col1->valueAt(2)), true);
+	QCOMPARE(col2->textAt(0), QLatin1String("a"));
+	QCOMPARE(col2->textAt(4), QLatin1String("e"));
+	QCOMPARE(col2->isMasked(2), true);
+	QCOMPARE(col2->isMasked(4), false);
+
+	// redo
+	project.undoStack()->redo();
+	QCOMPARE(col1->valueAt(0), 1.);
+	QCOMPARE(col2->textAt(0), QLatin1String("d"));
+	QCOMPARE(col2->textAt(4), QLatin1String("c"));
+	QCOMPARE(col2->isMasked(4), true);
+}
+
 /*
  * check performance of sorting double values in single column
  */
@@ -2241,6 +2303,69 @@ void SpreadsheetTest::testSearchReplaceAll() {
 	QCOMPARE(columns.at(2)->textAt(2), QLatin1String("test"));
 }
 
+/*!
+ * match index of the search engine, navigation and replace of all matches with one undo step
+ */
+void SpreadsheetTest::testSearchMatchIndex() {
+	Project project;
+	auto* sheet = createSearchReplaceSpreadsheet();
+	project.addChild(sheet);
+
+	SpreadsheetSearch search(sheet);
+	SpreadsheetSearch::Settings settings;
+	settings.type = SpreadsheetSearch::DataType::Numeric;
+	settings.operatorNumeric = SpreadsheetSearch::Operator::GreaterThan;
+	settings.pattern1 = QLatin1String("1");
+	search.setSettings(settings);
+
+	// integer column: 1, 2, 4, 2 and double column: 4, 3, 2, 1
+	QCOMPARE(search.matchCount(), 6);
+	QCOMPARE(search.matches(0).size(), 0);
+	QCOMPARE(search.matches(1), QVector<int>({1, 2, 3}));
+	QCOMPARE(search.matches(3), QVector<int>({0, 1, 2}));
+
+	// navigation in the row-major order
+	int row = 0;
+	int col = 0;
+	QVERIFY(search.findNext(row, col, SpreadsheetSearch::Order::RowMajor));
+	QCOMPARE(row, 0);
+	QCOMPARE(col, 3);
+
+	row = 3;
+	col = 0;
+	QVERIFY(search.findPrevious(row, col, SpreadsheetSearch::Order::RowMajor));
+	QCOMPARE(row, 2);
+	QCOMPARE(col, 3);
+
+	// navigation in the column-major order
+	row = 3;
+	col = 1;
+	QVERIFY(search.findNext(row, col, SpreadsheetSearch::Order::ColumnMajor));
+	QCOMPARE(row, 3);
+	QCOMPARE(col, 1);
+
+	row = 3;
+	col = 3;
+	QVERIFY(!search.findNext(row, col, SpreadsheetSearch::Order::ColumnMajor));
+
+	// modified data is taken into account
+	const auto& columns = sheet->children<Column>();
+	columns.at(3)->setValueAt(3, 10.);
+	QCOMPARE(search.matches(3), QVector<int>({0, 1, 2, 3}));
+
+	// replace all matches, one undo step
+	QCOMPARE(search.replaceAll(QLatin1String("0")), 7);
+	QCOMPARE(search.matchCount(), 0);
+	QCOMPARE(columns.at(1)->integerAt(0), 1);
+	QCOMPARE(columns.at(1)->integerAt(2), 0);
+	QCOMPARE(columns.at(3)->valueAt(3), 0.);
+
+	sheet->undoStack()->undo();
+	QCOMPARE(columns.at(1)->integerAt(2), 4);
+	QCOMPARE(columns.at(3)->valueAt(3), 10.);
+	QCOMPARE(search.matchCount(), 7);
+}
+
 // **********************************************************
 // ********************** size changes  *********************
 // **********************************************************
@@ -3451,4 +3576,37 @@ void SpreadsheetTest::testClearColumns() {
 	}
 }
 
+void SpreadsheetTest::testModelDisplayText() {
+	Project project;
+	auto* sheet = new Spreadsheet(QStringLiteral("test"), false);
+	project.addChild(sheet);
+	auto* model = new SpreadsheetModel(sheet);
+
+	sheet->setColumnCount(1);
+	sheet->setRowCount(1000);
+
+	auto* c0 = sheet->column(0);
+	for (int i = 0; i < 1000; i++)
+		c0->setValueAt(i, i);
+
+	// the first access formats the whole block, the following accesses are served from the cache
+	QCOMPARE(model->data(model->index(0, 0), Qt::DisplayRole).toString(), c0->asStringColumn()->textAt(0));
+	QCOMPARE(model->data(model->index(999, 0), Qt::DisplayRole).toString(), c0->asStringColumn()->textAt(999));
+
+	// a modification of the data has to be reflected in the displayed text
+	c0->setValueAt(1, 5.5);
+	QCOMPARE(model->data(model->index(1, 0), Qt::DisplayRole).toString(), c0->asStringColumn()->textAt(1));
+
+	c0->setValueAt(2, NAN);
+	QCOMPARE(model->data(model->index(2, 0), Qt::DisplayRole).toString(), QStringLiteral("-"));
+
+	sheet->undoStack()->undo();
+	QCOMPARE(model->data(model->index(2, 0), Qt::DisplayRole).toString(), c0->asStringColumn()->textAt(2));
+
+	// new rows are shown once the row count was changed
+	sheet->setRowCount(1001);
+	c0->setValueAt(1000, 1000);
+	QCOMPARE(model->data(model->index(1000, 0), Qt::DisplayRole).toString(), c0->asStringColumn()->textAt(1000));
+}
+
 QTEST_MAIN(SpreadsheetTest)
@@ -59,6 +59,7 @@ private Q_SLOTS:
 	void testSortText2();
 	void testSortDateTime1();
 	void testSortDateTime2();
+	void testSortMultipleKeys();
 
 	void testSortPerformanceNumeric1();
 	void testSortPerformanceNumeric2();
@@ -85,6 +86,7 @@ private Q_SLOTS:
 	void testSearchReplaceNumeric();
 	void testSearchReplaceText();
 	void testSearchReplaceAll();
+	void testSearchMatchIndex();
 
 	// size changes
 	void testInsertRows();
@@ -122,6 +124,8 @@ private Q_SLOTS:
 
 	void testClearColumns();
 
+	void testModelDisplayText();
+
 private:
 	Spreadsheet* createSearchReplaceSpreadsheet();
 };